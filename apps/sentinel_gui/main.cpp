@@ -9,6 +9,7 @@ This version modularizes startup logic for maintainability and clarity.
 #include <QQmlEngine>
 #include "marketdata/model/TradeData.h"
 #include "UnifiedGridRenderer.h"
+#include "MultiSymbolHeatmapGrid.h"
 #include "CoordinateSystem.h"
 #include "models/TimeAxisModel.hpp"
 #include "models/PriceAxisModel.hpp"
@@ -16,6 +17,7 @@ This version modularizes startup logic for maintainability and clarity.
 #include <QSysInfo>
 #include "SentinelLogging.hpp" // Sentinel categorized logging
 #include "themes/ThemeManager.hpp" // Theme system
+#include "render/PresentationPolicy.hpp"
 
 // --- Hardware backend/environment setup ---
 void configureGraphicsBackend() {
@@ -31,15 +33,15 @@ void configureGraphicsBackend() {
 }
 
 // --- Surface format configuration ---
-void configureSurfaceFormat() {
+void configureSurfaceFormat(const PresentationPolicy& policy) {
     QSurfaceFormat fmt;
     fmt.setRenderableType(QSurfaceFormat::OpenGL);
     fmt.setVersion(3, 3);
     fmt.setProfile(QSurfaceFormat::CoreProfile);
     fmt.setSwapBehavior(QSurfaceFormat::DoubleBuffer);
-    fmt.setSwapInterval(0); // disable vsync for realtime charts
-    fmt.setSamples(4);
+    policy.applyTo(fmt); // vsync/uncapped/adaptive and MSAA from [render] in config.ini
     QSurfaceFormat::setDefaultFormat(fmt);
+    sLog_App("Presentation:" << policy.describe());
 }
 
 // --- Qt metatype and QML component registration ---
@@ -50,6 +52,7 @@ void registerMetaTypesAndQml() {
 
     sLog_App("Registering pure grid-only QML components...");
     qmlRegisterType<UnifiedGridRenderer>("Sentinel.Charts", 1, 0, "UnifiedGridRenderer");
+    qmlRegisterType<MultiSymbolHeatmapGrid>("Sentinel.Charts", 1, 0, "MultiSymbolHeatmapGrid");
     qmlRegisterType<CoordinateSystem>("Sentinel.Charts", 1, 0, "CoordinateSystem");
     qmlRegisterType<TimeAxisModel>("Sentinel.Charts", 1, 0, "TimeAxisModel");
     qmlRegisterType<PriceAxisModel>("Sentinel.Charts", 1, 0, "PriceAxisModel");
@@ -65,7 +68,7 @@ int main(int argc, char *argv[])
     sLog_App("[Sentinel GPU Trading Terminal Starting...]");
 
     configureGraphicsBackend();
-    configureSurfaceFormat();
+    configureSurfaceFormat(PresentationPolicy::fromConfig());
 
     QApplication app(argc, argv);
 
@@ -0,0 +1,72 @@
+/*
+Sentinel — FenwickTree
+Role: Binary indexed tree over a fixed number of slots: point add, prefix/range sum and prefix search in O(log n).
+Inputs/Outputs: Takes per-slot deltas; answers sums over [0, count) and the first count whose sum reaches a target.
+Threading: Not thread-safe; the owner serializes access (LiveOrderBook does so under its book mutex).
+Performance: One T per slot plus one; no allocation after assign().
+Integration: Backs LiveOrderBook's cumulative depth queries.
+Observability: No internal logging.
+Related: TradeData.h (LiveOrderBook), DataCache.cpp.
+Assumptions: lowerBound() requires non-negative slot values; floating-point sums drift by rounding as deltas accumulate.
+*/
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <vector>
+
+template <typename T>
+class FenwickTree {
+public:
+    FenwickTree() = default;
+    explicit FenwickTree(size_t size) { assign(size); }
+
+    // Resets to size zero-valued slots
+    void assign(size_t size) {
+        m_tree.assign(size + 1, T{});
+    }
+
+    size_t size() const { return m_tree.empty() ? 0 : m_tree.size() - 1; }
+
+    void add(size_t index, T delta) {
+        for (size_t i = index + 1; i < m_tree.size(); i += lowBit(i)) {
+            m_tree[i] += delta;
+        }
+    }
+
+    // Sum of slots [0, count); count is clamped to size()
+    T prefix(size_t count) const {
+        T sum{};
+        for (size_t i = std::min(count, size()); i > 0; i -= lowBit(i)) {
+            sum += m_tree[i];
+        }
+        return sum;
+    }
+
+    // Sum of slots [first, last)
+    T range(size_t first, size_t last) const {
+        return last > first ? prefix(last) - prefix(first) : T{};
+    }
+
+    T total() const { return prefix(size()); }
+
+    // Smallest count with prefix(count) >= target; size() + 1 when the total falls short
+    size_t lowerBound(T target) const {
+        if (!(target > T{})) return 0;
+        size_t position = 0;
+        for (size_t step = std::bit_floor(size()); step > 0; step >>= 1) {
+            const size_t next = position + step;
+            if (next < m_tree.size() && m_tree[next] < target) {
+                position = next;
+                target -= m_tree[next];
+            }
+        }
+        return position + 1;
+    }
+
+private:
+    static size_t lowBit(size_t i) { return i & (~i + 1); }
+
+    std::vector<T> m_tree;  // 1-based; m_tree[0] unused
+};
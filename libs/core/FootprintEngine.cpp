@@ -0,0 +1,215 @@
+/*
+Sentinel — FootprintEngine
+Role: Implements footprint bar rings, dense/overflow cell lookup and row-aggregated range queries.
+Inputs/Outputs: Folds each trade into the newest bar of every timeframe ring, on its symbol's tick grid.
+Threading: All public methods take m_mutex.
+Performance: Dense cells are a single slab per ring, cleared only when a bar slot is recycled.
+Integration: See FootprintEngine.h.
+Observability: sLog_App when a symbol is registered or its tick changes.
+Related: FootprintEngine.h, TimeBarRing.h.
+Assumptions: Timeframes are fixed for the engine's lifetime.
+*/
+#include "FootprintEngine.h"
+#include "SentinelLogging.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+    constexpr int32_t kHalfWindow = FootprintEngine::kDenseWindowTicks / 2;
+    constexpr int64_t kMaxRowsPerBar = 4096;  // Bounds query scratch space
+
+    inline int32_t floorDiv(int32_t a, int32_t b) {
+        return a / b - ((a % b != 0) && ((a < 0) != (b < 0)));
+    }
+}
+
+FootprintEngine::FootprintEngine(std::vector<int64_t> timeframes, size_t barsPerTimeframe)
+    : m_timeframes(std::move(timeframes))
+    , m_capacity(std::max<size_t>(barsPerTimeframe, 1)) {
+    TimeBars::normalize(m_timeframes);
+}
+
+size_t FootprintEngine::BarRing::barFor(int64_t timestamp_ms, Tick tick) {
+    // Recycle the slot: reset header, clear dense window, keep overflow buckets allocated
+    return TimeBarRing<Bar>::barFor(timestamp_ms, [&](Bar& bar, const Bar*) {
+        bar.anchorTick = tick;
+        bar.minTick = tick;
+        bar.maxTick = tick;
+        bar.pocTick = tick;
+        bar.pocVolume = 0.0;
+        bar.overflow.clear();
+        std::fill_n(denseCells(static_cast<size_t>(&bar - bars.data())), kDenseWindowTicks, Cell{});
+    });
+}
+
+FootprintEngine::Cell& FootprintEngine::cellFor(BarRing& ring, size_t physicalIndex, Tick tick) {
+    Bar& bar = ring.bars[physicalIndex];
+    const int32_t offset = tick - bar.anchorTick + kHalfWindow;
+    if (offset >= 0 && offset < kDenseWindowTicks) {
+        return ring.denseCells(physicalIndex)[offset];
+    }
+    return bar.overflow[tick];
+}
+
+const FootprintEngine::SymbolState* FootprintEngine::findState(const std::string& symbol) const {
+    auto it = m_symbols.find(symbol);
+    return it != m_symbols.end() ? &it->second : nullptr;
+}
+
+void FootprintEngine::setTickSize(const std::string& symbol, double tickSize) {
+    if (symbol.empty() || !(tickSize > 0.0)) return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto [it, inserted] = m_symbols.try_emplace(symbol);
+    SymbolState& state = it->second;
+    if (!inserted && state.tickSize == tickSize) return;
+
+    if (inserted) {
+        state.rings.resize(m_timeframes.size());
+        for (size_t i = 0; i < m_timeframes.size(); ++i) {
+            state.rings[i].reset(m_timeframes[i], m_capacity);
+            state.rings[i].cells.resize(m_capacity * kDenseWindowTicks);
+        }
+        sLog_App("FootprintEngine: tracking" << QString::fromStdString(symbol)
+                 << "tick:" << tickSize << "timeframes:" << m_timeframes.size()
+                 << "bars/timeframe:" << m_capacity);
+    } else {
+        // Bars hold tick indices on the old grid; start over rather than mislabel prices
+        for (auto& ring : state.rings) {
+            ring.head = 0;
+            ring.count = 0;
+        }
+        sLog_App("FootprintEngine:" << QString::fromStdString(symbol)
+                 << "tick" << state.tickSize << "->" << tickSize << ", bars restarted");
+    }
+    state.tickSize = tickSize;
+    state.version = ++m_sequence;
+}
+
+double FootprintEngine::getTickSize(const std::string& symbol) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const SymbolState* state = findState(symbol);
+    return state ? state->tickSize : 0.0;
+}
+
+void FootprintEngine::onTrade(const Trade& trade) {
+    if (trade.product_id.empty() || trade.size <= 0.0 || trade.price <= 0.0) return;
+    const bool isBuy = trade.side == AggressorSide::Buy;
+    const bool isSell = trade.side == AggressorSide::Sell;
+    if (!isBuy && !isSell) return;
+
+    const int64_t ts = std::chrono::duration_cast<std::chrono::milliseconds>(
+        trade.timestamp.time_since_epoch()).count();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_symbols.find(trade.product_id);
+    if (it == m_symbols.end()) return;  // No book tick yet
+    SymbolState& state = it->second;
+    const Tick tick = static_cast<Tick>(std::llround(trade.price / state.tickSize));
+
+    for (auto& ring : state.rings) {
+        const size_t slot = ring.barFor(ts, tick);
+        Bar& bar = ring.bars[slot];
+        Cell& cell = cellFor(ring, slot, tick);
+        if (isBuy) {
+            cell.askVolume += trade.size;
+        } else {
+            cell.bidVolume += trade.size;
+        }
+        bar.minTick = std::min(bar.minTick, tick);
+        bar.maxTick = std::max(bar.maxTick, tick);
+
+        const double cellVolume = cell.bidVolume + cell.askVolume;
+        if (cellVolume > bar.pocVolume) {
+            bar.pocVolume = cellVolume;
+            bar.pocTick = tick;
+        }
+    }
+    state.version = ++m_sequence;
+}
+
+void FootprintEngine::copyCells(const std::string& symbol, int64_t timeframe_ms,
+                                int64_t start_ms, int64_t end_ms,
+                                double priceMin, double priceMax, int ticksPerRow,
+                                std::vector<FootprintCell>& out) const {
+    out.clear();
+    if (priceMax <= priceMin || end_ms <= start_ms) return;
+    ticksPerRow = std::max(1, ticksPerRow);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const SymbolState* state = findState(symbol);
+    if (!state) return;
+
+    const size_t tf = TimeBars::indexOf(m_timeframes, timeframe_ms);
+    if (tf == TimeBars::npos) return;
+    const BarRing& ring = state->rings[tf];
+    const double tickSize = state->tickSize;
+
+    const Tick visibleMinTick = static_cast<Tick>(std::floor(priceMin / tickSize));
+    const Tick visibleMaxTick = static_cast<Tick>(std::ceil(priceMax / tickSize));
+
+    std::vector<Cell> rows;
+    for (size_t i = ring.firstEndingAfter(start_ms); i < ring.count; ++i) {
+        const size_t slot = ring.physical(i);
+        const Bar& bar = ring.bars[slot];
+        if (bar.startTime_ms > end_ms) break;
+
+        const Tick firstTick = std::max(bar.minTick, visibleMinTick);
+        const Tick lastTick = std::min(bar.maxTick, visibleMaxTick);
+        if (firstTick > lastTick) continue;
+
+        const int32_t firstRow = floorDiv(firstTick, ticksPerRow);
+        const int32_t lastRow = floorDiv(lastTick, ticksPerRow);
+        const int64_t rowCount = static_cast<int64_t>(lastRow) - firstRow + 1;
+        if (rowCount > kMaxRowsPerBar) continue;  // Caller asked for too fine a row size
+        rows.assign(static_cast<size_t>(rowCount), Cell{});
+
+        // Dense window part
+        const Cell* dense = ring.denseCells(slot);
+        const Tick denseFirst = std::max(firstTick, bar.anchorTick - kHalfWindow);
+        const Tick denseLast = std::min(lastTick, bar.anchorTick + kHalfWindow - 1);
+        for (Tick t = denseFirst; t <= denseLast; ++t) {
+            const Cell& c = dense[t - bar.anchorTick + kHalfWindow];
+            if (c.bidVolume == 0.0 && c.askVolume == 0.0) continue;
+            Cell& row = rows[static_cast<size_t>(floorDiv(t, ticksPerRow) - firstRow)];
+            row.bidVolume += c.bidVolume;
+            row.askVolume += c.askVolume;
+        }
+        // Sparse overflow part
+        for (const auto& [t, c] : bar.overflow) {
+            if (t < firstTick || t > lastTick) continue;
+            Cell& row = rows[static_cast<size_t>(floorDiv(t, ticksPerRow) - firstRow)];
+            row.bidVolume += c.bidVolume;
+            row.askVolume += c.askVolume;
+        }
+
+        const int32_t pocRow = floorDiv(bar.pocTick, ticksPerRow);
+        const double rowHeight = tickSize * ticksPerRow;
+        for (int64_t r = 0; r < rowCount; ++r) {
+            const Cell& row = rows[static_cast<size_t>(r)];
+            if (row.bidVolume == 0.0 && row.askVolume == 0.0) continue;
+            FootprintCell cell;
+            cell.timeStart_ms = bar.startTime_ms;
+            cell.timeEnd_ms = bar.startTime_ms + ring.timeframe_ms;
+            // Tick t covers [t - 0.5, t + 0.5) * tickSize
+            cell.priceMin = (static_cast<double>(firstRow + r) * ticksPerRow - 0.5) * tickSize;
+            cell.priceMax = cell.priceMin + rowHeight;
+            cell.bidVolume = row.bidVolume;
+            cell.askVolume = row.askVolume;
+            cell.isPoc = (firstRow + r) == pocRow;
+            out.push_back(cell);
+        }
+    }
+}
+
+uint64_t FootprintEngine::getVersion(const std::string& symbol) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const SymbolState* state = findState(symbol);
+    return state ? state->version : 0;
+}
+
+void FootprintEngine::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_symbols.clear();
+}
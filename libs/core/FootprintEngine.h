@@ -0,0 +1,109 @@
+/*
+Sentinel — FootprintEngine
+Role: Aggregates trades into footprint bars: bid/ask volume per (time bar, price tick) cell.
+Inputs/Outputs: Takes trades and each symbol's book tick size; produces FootprintCell rows for the visible time/price window.
+Threading: Thread-safe; trade ingestion (DataProcessor worker) and queries (render thread) share one std::mutex.
+Performance: O(1) per trade. Each bar owns a dense tick window anchored near the first trade; trades outside it go to a small sparse overflow map.
+Integration: Owned by DataProcessor; cells are copied into GridSliceBatch for FootprintStrategy.
+Observability: Logs symbol registration and tick changes via sLog_App.
+Related: FootprintEngine.cpp, TimeBarRing.h, OrderFlowEngine.h, FootprintStrategy.hpp, TradeData.h.
+Assumptions: Trades arrive roughly in time order; late trades fold into the newest bar. A symbol's trades are dropped until its tick is set.
+*/
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "TimeBarRing.h"
+#include "marketdata/model/TradeData.h"
+
+// One footprint cell as handed to the renderer (possibly aggregated over several ticks)
+struct FootprintCell {
+    int64_t timeStart_ms = 0;
+    int64_t timeEnd_ms = 0;
+    double priceMin = 0.0;
+    double priceMax = 0.0;
+    double bidVolume = 0.0;   // Sell aggressors hitting the bid
+    double askVolume = 0.0;   // Buy aggressors lifting the offer
+    bool isPoc = false;       // Highest-volume row of its bar
+
+    double totalVolume() const { return bidVolume + askVolume; }
+    double delta() const { return askVolume - bidVolume; }
+};
+
+class FootprintEngine {
+public:
+    static constexpr int32_t kDenseWindowTicks = 256;  // Dense cells per bar, centered on the anchor tick
+
+    explicit FootprintEngine(std::vector<int64_t> timeframes = {1000, 5000, 15000, 60000},
+                             size_t barsPerTimeframe = 512);
+
+    // Price grid of a symbol, taken from its book. Registers the symbol on first call; a different
+    // tick restarts that symbol's bars since cells are keyed by tick index.
+    void setTickSize(const std::string& symbol, double tickSize);
+    double getTickSize(const std::string& symbol) const;  // 0 until set
+
+    // Event ingestion (O(1) per timeframe); ignored for symbols without a tick size
+    void onTrade(const Trade& trade);
+
+    // Query interface: cells overlapping the window, rows of ticksPerRow ticks, oldest bar first
+    void copyCells(const std::string& symbol, int64_t timeframe_ms,
+                   int64_t start_ms, int64_t end_ms,
+                   double priceMin, double priceMax, int ticksPerRow,
+                   std::vector<FootprintCell>& out) const;
+
+    size_t getBarsPerTimeframe() const { return m_capacity; }
+    const std::vector<int64_t>& getTimeframes() const { return m_timeframes; }
+    int64_t nearestTimeframe(int64_t timeframe_ms) const { return TimeBars::nearest(m_timeframes, timeframe_ms); }
+
+    // Changes only when this symbol's bars do; 0 for an untracked symbol. Drawn from one engine-wide
+    // sequence, so a value is never handed out twice, even across clear().
+    uint64_t getVersion(const std::string& symbol) const;
+
+    void clear();
+
+private:
+    using Tick = int32_t;
+
+    struct Cell {
+        double bidVolume = 0.0;
+        double askVolume = 0.0;
+    };
+
+    struct Bar {
+        int64_t startTime_ms = 0;
+        Tick anchorTick = 0;                      // Dense window covers [anchor - W/2, anchor + W/2)
+        Tick minTick = 0;
+        Tick maxTick = 0;
+        Tick pocTick = 0;
+        double pocVolume = 0.0;
+        std::unordered_map<Tick, Cell> overflow;  // Trades outside the dense window
+    };
+
+    // Bar ring for one (symbol, timeframe); dense cells of every slot live in one slab
+    struct BarRing : TimeBarRing<Bar> {
+        std::vector<Cell> cells;  // bars.size() * kDenseWindowTicks
+
+        Cell* denseCells(size_t physicalIndex) { return &cells[physicalIndex * kDenseWindowTicks]; }
+        const Cell* denseCells(size_t physicalIndex) const { return &cells[physicalIndex * kDenseWindowTicks]; }
+        size_t barFor(int64_t timestamp_ms, Tick tick);
+    };
+
+    struct SymbolState {
+        double tickSize = 0.0;
+        uint64_t version = 0;
+        std::vector<BarRing> rings;  // One per timeframe, same order as m_timeframes
+    };
+
+    const SymbolState* findState(const std::string& symbol) const;
+    static Cell& cellFor(BarRing& ring, size_t physicalIndex, Tick tick);
+
+    std::vector<int64_t> m_timeframes;
+    size_t m_capacity;
+
+    std::unordered_map<std::string, SymbolState> m_symbols;
+    uint64_t m_sequence = 0;  // Source of per-symbol versions
+    mutable std::mutex m_mutex;
+};
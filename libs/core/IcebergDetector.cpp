@@ -0,0 +1,236 @@
+/*
+Sentinel — IcebergDetector
+Role: Implements per-level trade/refill correlation and the fixed event ring.
+Inputs/Outputs: Correlates trades and displayed-size changes at the same tick; records refills as hidden size.
+Threading: All public methods take m_mutex.
+Performance: Open addressing with a bounded probe; on overflow the stalest slot in the probe window is evicted.
+Integration: See IcebergDetector.h.
+Observability: sLog_App when a symbol's book grid is configured.
+Related: IcebergDetector.h.
+Assumptions: Two refill signals are used: displayed size coming back after trades consumed it, and
+             trades executing more than was displayed since the last checkpoint.
+*/
+#include "IcebergDetector.h"
+#include "SentinelLogging.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+    constexpr double kQtyEpsilon = 1e-12;
+    constexpr double kMinRefillRatio = 0.5;  // Refill must restore at least half the checkpoint size
+
+    inline uint64_t levelKey(uint32_t idx, bool isBid) {
+        return ((static_cast<uint64_t>(idx) << 1) | (isBid ? 1u : 0u)) + 1;
+    }
+
+    inline size_t hashKey(uint64_t key) {
+        return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 40);
+    }
+}
+
+IcebergDetector::IcebergDetector()
+    : IcebergDetector(Config{}) {
+}
+
+IcebergDetector::IcebergDetector(Config config)
+    : m_config(config) {
+    static_assert((kTableSize & (kTableSize - 1)) == 0, "kTableSize must be a power of two");
+}
+
+IcebergDetector::SymbolState& IcebergDetector::stateFor(const std::string& symbol) {
+    auto it = m_symbols.find(symbol);
+    if (it != m_symbols.end()) return it->second;
+    auto& state = m_symbols[symbol];
+    state.table.resize(kTableSize);
+    return state;
+}
+
+void IcebergDetector::configureBook(const std::string& symbol, double minPrice, double tickSize) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    SymbolState& state = stateFor(symbol);
+    if (state.minPrice == minPrice && state.tickSize == tickSize) return;
+
+    // Grid changed: indices no longer refer to the same prices
+    state.minPrice = minPrice;
+    state.tickSize = tickSize;
+    std::fill(state.table.begin(), state.table.end(), LevelSlot{});
+    sLog_App("IcebergDetector: book grid for" << QString::fromStdString(symbol)
+             << "min:" << minPrice << "tick:" << tickSize);
+}
+
+IcebergDetector::LevelSlot& IcebergDetector::slotFor(SymbolState& state, uint32_t idx, bool isBid, int64_t now_ms) {
+    const uint64_t key = levelKey(idx, isBid);
+    const size_t mask = kTableSize - 1;
+    const size_t home = hashKey(key) & mask;
+
+    LevelSlot* stalest = nullptr;
+    for (size_t probe = 0; probe < kMaxProbe; ++probe) {
+        LevelSlot& slot = state.table[(home + probe) & mask];
+        if (slot.key == key) return slot;
+        if (slot.key == 0) {
+            slot.key = key;
+            slot.lastTouch_ms = now_ms;
+            return slot;
+        }
+        if (!stalest || slot.lastTouch_ms < stalest->lastTouch_ms) stalest = &slot;
+    }
+
+    *stalest = LevelSlot{};
+    stalest->key = key;
+    stalest->lastTouch_ms = now_ms;
+    return *stalest;
+}
+
+void IcebergDetector::checkpoint(LevelSlot& slot) {
+    slot.checkpointQty = slot.displayed;
+    slot.traded = 0.0;
+    slot.drop = 0.0;
+}
+
+void IcebergDetector::resetRefills(LevelSlot& slot) {
+    // Pulled without being traded: not an iceberg (anymore)
+    slot.refills = 0;
+    slot.hidden = 0.0;
+    slot.firstRefill_ms = 0;
+    slot.eventSeq = 0;
+    slot.pendingEmpty_ms = 0;
+}
+
+void IcebergDetector::expirePendingEmpty(LevelSlot& slot, int64_t now_ms) const {
+    if (slot.pendingEmpty_ms != 0 && now_ms - slot.pendingEmpty_ms > m_config.fillWindow_ms) {
+        resetRefills(slot);
+    }
+}
+
+bool IcebergDetector::registerRefill(SymbolState& state, LevelSlot& slot, uint32_t idx, bool isBid,
+                                     double hiddenQty, int64_t now_ms) {
+    if (hiddenQty <= std::max(m_config.minHiddenQty, kQtyEpsilon)) return false;
+
+    ++slot.refills;
+    slot.hidden += hiddenQty;
+    if (slot.firstRefill_ms == 0) slot.firstRefill_ms = now_ms;
+    if (slot.refills < m_config.minRefills) return false;
+
+    // Update this level's event in place while it is still in the ring
+    const bool inRing = slot.eventSeq != 0 &&
+                        slot.eventSeq + kEventCapacity > state.eventCount;
+    if (!inRing) {
+        slot.eventSeq = ++state.eventCount;
+    }
+    IcebergEvent& ev = state.events[(slot.eventSeq - 1) % kEventCapacity];
+    ev.price = state.minPrice + static_cast<double>(idx) * state.tickSize;
+    ev.isBid = isBid;
+    ev.firstSeen_ms = slot.firstRefill_ms;
+    ev.lastRefill_ms = now_ms;
+    ev.refillCount = slot.refills;
+    ev.hiddenEstimate = slot.hidden;
+    ev.displayedQty = slot.displayed;
+    state.lastEventSeq = slot.eventSeq;
+    return true;
+}
+
+size_t IcebergDetector::onBookDeltas(const std::string& symbol, int64_t timestamp_ms,
+                                     const std::vector<BookDelta>& deltas) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_symbols.find(symbol);
+    if (it == m_symbols.end() || it->second.tickSize <= 0.0) return 0;
+    SymbolState& state = it->second;
+
+    size_t events = 0;
+    for (const BookDelta& d : deltas) {
+        LevelSlot& slot = slotFor(state, d.idx, d.isBid, timestamp_ms);
+        expirePendingEmpty(slot, timestamp_ms);
+        const double qty = std::max(0.0, static_cast<double>(d.qty));
+        const double prev = slot.displayed;
+        const bool recentTrade = slot.traded > kQtyEpsilon &&
+                                 timestamp_ms - slot.lastTrade_ms <= m_config.correlationWindow_ms;
+
+        if (qty < prev) {
+            slot.drop += prev - qty;
+            if (qty <= kQtyEpsilon && !recentTrade && slot.pendingEmpty_ms == 0) {
+                // The print for this size may still be on its way: hold the verdict for the fill window
+                slot.pendingEmpty_ms = timestamp_ms;
+            }
+            slot.displayed = qty;
+        } else if (qty > prev) {
+            // Shown again while no print claimed the emptied size: it was pulled, not filled
+            if (slot.pendingEmpty_ms != 0) resetRefills(slot);
+            slot.displayed = qty;
+            const bool consumed = slot.drop > kQtyEpsilon;
+            const bool restored = qty >= slot.checkpointQty * kMinRefillRatio;
+            if (recentTrade && consumed && restored) {
+                const double hiddenQty = std::min(qty - prev, slot.traded);
+                if (registerRefill(state, slot, d.idx, d.isBid, hiddenQty, timestamp_ms)) ++events;
+            }
+            checkpoint(slot);
+        }
+        slot.lastTouch_ms = timestamp_ms;
+    }
+    return events;
+}
+
+size_t IcebergDetector::onTrade(const Trade& trade) {
+    if (trade.product_id.empty() || trade.size <= 0.0) return 0;
+    if (trade.side != AggressorSide::Buy && trade.side != AggressorSide::Sell) return 0;
+
+    const int64_t ts = std::chrono::duration_cast<std::chrono::milliseconds>(
+        trade.timestamp.time_since_epoch()).count();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_symbols.find(trade.product_id);
+    if (it == m_symbols.end() || it->second.tickSize <= 0.0) return 0;
+    SymbolState& state = it->second;
+
+    const double rawIdx = std::round((trade.price - state.minPrice) / state.tickSize);
+    if (rawIdx < 0.0 || rawIdx > static_cast<double>(UINT32_MAX)) return 0;
+    const uint32_t idx = static_cast<uint32_t>(rawIdx);
+    const bool restingBid = trade.side == AggressorSide::Sell;  // Sellers hit resting bids
+
+    LevelSlot& slot = slotFor(state, idx, restingBid, ts);
+    expirePendingEmpty(slot, ts);
+    if (slot.pendingEmpty_ms != 0 && slot.displayed <= kQtyEpsilon) {
+        slot.pendingEmpty_ms = 0;  // The emptied size was traded away after all
+    }
+    slot.traded += trade.size;
+    slot.lastTrade_ms = ts;
+    slot.lastTouch_ms = ts;
+
+    // Executed more than was displayed since the checkpoint: the excess was hidden
+    const double excess = slot.traded - std::max(slot.checkpointQty, slot.drop);
+    if (slot.checkpointQty > kQtyEpsilon && excess > kQtyEpsilon) {
+        const bool reported = registerRefill(state, slot, idx, restingBid, excess, ts);
+        checkpoint(slot);
+        return reported ? 1 : 0;
+    }
+    return 0;
+}
+
+void IcebergDetector::copyEvents(const std::string& symbol, int64_t start_ms, int64_t end_ms,
+                                 std::vector<IcebergEvent>& out) const {
+    out.clear();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_symbols.find(symbol);
+    if (it == m_symbols.end()) return;
+    const SymbolState& state = it->second;
+
+    const uint64_t available = std::min<uint64_t>(state.eventCount, kEventCapacity);
+    for (uint64_t seq = state.eventCount - available; seq < state.eventCount; ++seq) {
+        const IcebergEvent& ev = state.events[seq % kEventCapacity];
+        if (ev.lastRefill_ms < start_ms || ev.firstSeen_ms > end_ms) continue;
+        out.push_back(ev);
+    }
+}
+
+bool IcebergDetector::lastEvent(const std::string& symbol, IcebergEvent& out) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_symbols.find(symbol);
+    if (it == m_symbols.end() || it->second.lastEventSeq == 0) return false;
+    out = it->second.events[(it->second.lastEventSeq - 1) % kEventCapacity];
+    return true;
+}
+
+void IcebergDetector::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_symbols.clear();
+}
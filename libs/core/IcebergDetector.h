@@ -0,0 +1,102 @@
+/*
+Sentinel — IcebergDetector
+Role: Detects price levels that keep refilling after being traded through (iceberg / hidden-size orders).
+Inputs/Outputs: Takes BookDeltas and trades per symbol; produces IcebergEvent records with an estimated hidden size.
+Threading: Thread-safe; ingestion (DataProcessor worker) and queries (render thread) share one std::mutex.
+Performance: O(1) per event. Per-level state lives in a fixed open-addressed table; events live in a fixed ring.
+Integration: Owned by DataProcessor; events are copied into GridSliceBatch for IcebergOverlayStrategy.
+Observability: Logs book configuration via sLog_App; detections are surfaced by DataProcessor.
+Related: IcebergDetector.cpp, TradeData.h (BookDelta, LiveOrderBook), IcebergOverlayStrategy.hpp.
+Assumptions: BookDelta indices use the LiveOrderBook grid configured via configureBook(). A level that empties
+             is held for fillWindow_ms so a trade print arriving after the book update can still claim it.
+*/
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "marketdata/model/TradeData.h"
+
+// One suspected iceberg level; updated in place on every further refill
+struct IcebergEvent {
+    double price = 0.0;
+    bool isBid = true;              // Resting side of the iceberg
+    int64_t firstSeen_ms = 0;       // First detected refill
+    int64_t lastRefill_ms = 0;      // Most recent refill
+    uint32_t refillCount = 0;
+    double hiddenEstimate = 0.0;    // Executed volume beyond what was ever displayed
+    double displayedQty = 0.0;      // Visible size at the last refill
+};
+
+class IcebergDetector {
+public:
+    struct Config {
+        int64_t correlationWindow_ms = 2000;  // Trade → refill must happen within this window
+        uint32_t minRefills = 2;              // Refills before a level is reported
+        double minHiddenQty = 0.0;            // Ignore refills smaller than this
+        int64_t fillWindow_ms = 250;          // An emptied level waits this long for its trade print before counting as pulled
+    };
+
+    static constexpr size_t kTableSize = 4096;   // Tracked levels per symbol (power of two)
+    static constexpr size_t kMaxProbe = 8;       // Linear-probe window before evicting the stalest slot
+    static constexpr size_t kEventCapacity = 1024;
+
+    IcebergDetector();
+    explicit IcebergDetector(Config config);
+
+    // Price grid of the symbol's LiveOrderBook (BookDelta::idx → price)
+    void configureBook(const std::string& symbol, double minPrice, double tickSize);
+
+    // Event ingestion; both return the number of events created or updated
+    size_t onBookDeltas(const std::string& symbol, int64_t timestamp_ms, const std::vector<BookDelta>& deltas);
+    size_t onTrade(const Trade& trade);
+
+    // Events whose [firstSeen, lastRefill] overlaps [start, end], oldest first
+    void copyEvents(const std::string& symbol, int64_t start_ms, int64_t end_ms,
+                    std::vector<IcebergEvent>& out) const;
+    // Most recently created/updated event (valid only if the last ingest returned > 0)
+    bool lastEvent(const std::string& symbol, IcebergEvent& out) const;
+
+    void clear();
+
+private:
+    struct LevelSlot {
+        uint64_t key = 0;             // 0 = empty; otherwise (idx << 1 | isBid) + 1
+        double displayed = 0.0;       // Last displayed quantity
+        double checkpointQty = 0.0;   // Displayed quantity at the last refill checkpoint
+        double traded = 0.0;          // Volume traded here since the checkpoint
+        double drop = 0.0;            // Displayed decreases since the checkpoint
+        int64_t lastTrade_ms = 0;
+        int64_t lastTouch_ms = 0;
+        uint32_t refills = 0;
+        double hidden = 0.0;
+        int64_t firstRefill_ms = 0;
+        uint64_t eventSeq = 0;        // Sequence of this level's event in the ring (0 = none)
+        int64_t pendingEmpty_ms = 0;  // Emptied with no trade yet; classified once a print arrives or the window ends
+    };
+
+    struct SymbolState {
+        double minPrice = 0.0;
+        double tickSize = 0.0;
+        std::vector<LevelSlot> table;             // kTableSize
+        std::array<IcebergEvent, kEventCapacity> events{};
+        uint64_t eventCount = 0;                  // Total events ever created (ring head = count % cap)
+        uint64_t lastEventSeq = 0;
+    };
+
+    SymbolState& stateFor(const std::string& symbol);
+    LevelSlot& slotFor(SymbolState& state, uint32_t idx, bool isBid, int64_t now_ms);
+    bool registerRefill(SymbolState& state, LevelSlot& slot, uint32_t idx, bool isBid,
+                        double hiddenQty, int64_t now_ms);
+    static void checkpoint(LevelSlot& slot);
+    static void resetRefills(LevelSlot& slot);
+    // Settles a held empty observation as a pull once its fill window has passed
+    void expirePendingEmpty(LevelSlot& slot, int64_t now_ms) const;
+
+    Config m_config;
+    std::unordered_map<std::string, SymbolState> m_symbols;
+    mutable std::mutex m_mutex;
+};
@@ -0,0 +1,260 @@
+/*
+Sentinel — LiquidityPullEngine
+Role: Implements per-level add/cancel/fill attribution near the touch and the pending-cancel FIFO.
+Inputs/Outputs: Size increases count as adds; decreases are matched against trades at the same level, the rest become pulls.
+Threading: All public methods take m_mutex.
+Performance: Slot lookup is idx & mask with an index tag; pending cancels expire in arrival order.
+Integration: See LiquidityPullEngine.h.
+Observability: sLog_App when a symbol's book grid is configured.
+Related: LiquidityPullEngine.h.
+Assumptions: The first delta seen at a level only establishes its size; levels further than kRingSize / 2 ticks from the best are ignored.
+*/
+#include "LiquidityPullEngine.h"
+#include "SentinelLogging.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+    constexpr double kQtyEpsilon = 1e-12;
+    constexpr uint32_t kTrackedTicks = static_cast<uint32_t>(LiquidityPullEngine::kRingSize / 2);
+
+    double sum(const std::vector<double>& values) {
+        double total = 0.0;
+        for (double v : values) total += v;
+        return total;
+    }
+
+    // Distance from the same-side best level; levels through the (stale) best count as at the touch
+    uint32_t distanceFromBest(uint32_t idx, uint32_t best, bool isBid) {
+        if (isBid) return idx >= best ? 0 : best - idx;
+        return idx <= best ? 0 : idx - best;
+    }
+}
+
+double PullStats::Side::totalCancelled() const { return sum(cancelled); }
+double PullStats::Side::totalFilled() const { return sum(filled); }
+
+double PullStats::Side::pullRatio() const {
+    const double c = totalCancelled();
+    const double f = totalFilled();
+    return (c + f) > 0.0 ? c / (c + f) : 0.0;
+}
+
+size_t PullStats::lifetimeBucket(int64_t lifetime_ms) {
+    auto it = std::upper_bound(kLifetimeEdges_ms.begin(), kLifetimeEdges_ms.end(), lifetime_ms);
+    return static_cast<size_t>(it - kLifetimeEdges_ms.begin());
+}
+
+LiquidityPullEngine::LiquidityPullEngine()
+    : LiquidityPullEngine(Config{}) {
+}
+
+LiquidityPullEngine::LiquidityPullEngine(Config config)
+    : m_config(config) {
+    static_assert((kRingSize & (kRingSize - 1)) == 0, "kRingSize must be a power of two");
+    m_config.nearTouchTicks = std::clamp<uint32_t>(m_config.nearTouchTicks, 1, kTrackedTicks);
+}
+
+LiquidityPullEngine::SymbolState& LiquidityPullEngine::stateFor(const std::string& symbol) {
+    auto it = m_symbols.find(symbol);
+    if (it != m_symbols.end()) return it->second;
+    auto& state = m_symbols[symbol];
+    state.bidRing.resize(kRingSize);
+    state.askRing.resize(kRingSize);
+    state.pending.resize(kPendingCapacity);
+    for (auto* side : {&state.stats.bid, &state.stats.ask}) {
+        side->added.assign(m_config.nearTouchTicks, 0.0);
+        side->cancelled.assign(m_config.nearTouchTicks, 0.0);
+        side->filled.assign(m_config.nearTouchTicks, 0.0);
+    }
+    return state;
+}
+
+void LiquidityPullEngine::configureBook(const std::string& symbol, double minPrice, double tickSize) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    SymbolState& state = stateFor(symbol);
+    if (state.minPrice == minPrice && state.tickSize == tickSize) return;
+
+    // Grid changed: drop level state and pending cancels, keep accumulated stats
+    state.minPrice = minPrice;
+    state.tickSize = tickSize;
+    std::fill(state.bidRing.begin(), state.bidRing.end(), LevelSlot{});
+    std::fill(state.askRing.begin(), state.askRing.end(), LevelSlot{});
+    state.pendingHead = 0;
+    state.pendingCount = 0;
+    sLog_App("LiquidityPullEngine: book grid for" << QString::fromStdString(symbol)
+             << "min:" << minPrice << "tick:" << tickSize
+             << "near-touch ticks:" << m_config.nearTouchTicks);
+}
+
+void LiquidityPullEngine::finalizePending(SymbolState& state, LevelSlot& slot, bool isBid,
+                                          std::vector<PullEvent>* outPulls, size_t& pulls) {
+    if (slot.pendingQty > kQtyEpsilon) {
+        PullStats::Side& side = isBid ? state.stats.bid : state.stats.ask;
+        side.cancelled[slot.pendingDistance] += slot.pendingQty;
+        side.cancelledByLifetime[PullStats::lifetimeBucket(slot.pendingLifetime_ms)] += slot.pendingQty;
+        if (outPulls) {
+            PullEvent ev;
+            ev.timestamp_ms = slot.pending_ms;
+            ev.price = state.minPrice + static_cast<double>(slot.idx) * state.tickSize;
+            ev.isBid = isBid;
+            ev.quantity = slot.pendingQty;
+            ev.lifetime_ms = slot.pendingLifetime_ms;
+            ev.distanceTicks = slot.pendingDistance;
+            outPulls->push_back(ev);
+        }
+        ++pulls;
+    }
+    slot.pendingQty = 0.0;
+    slot.pending_ms = 0;
+}
+
+size_t LiquidityPullEngine::flushExpired(SymbolState& state, int64_t now_ms, std::vector<PullEvent>* outPulls) {
+    size_t pulls = 0;
+    while (state.pendingCount > 0) {
+        const PendingEntry& entry = state.pending[state.pendingHead];
+        if (now_ms - entry.pending_ms < m_config.fillWindow_ms) break;
+
+        auto& ring = entry.isBid ? state.bidRing : state.askRing;
+        LevelSlot& slot = ring[entry.idx & (kRingSize - 1)];
+        // Stale entries (slot reused or already finalized) are skipped
+        if (slot.idx == entry.idx && slot.pending_ms == entry.pending_ms && slot.pendingQty > 0.0) {
+            finalizePending(state, slot, entry.isBid, outPulls, pulls);
+        }
+        state.pendingHead = (state.pendingHead + 1) % kPendingCapacity;
+        --state.pendingCount;
+    }
+    return pulls;
+}
+
+void LiquidityPullEngine::applyDelta(SymbolState& state, const BookDelta& delta, uint32_t best, int64_t now_ms,
+                                     std::vector<PullEvent>* outPulls, size_t& pulls) {
+    if (best == kNoLevel) return;
+    const uint32_t distance = distanceFromBest(delta.idx, best, delta.isBid);
+    if (distance >= kTrackedTicks) return;
+
+    auto& ring = delta.isBid ? state.bidRing : state.askRing;
+    LevelSlot& slot = ring[delta.idx & (kRingSize - 1)];
+    const double qty = std::max(0.0, static_cast<double>(delta.qty));
+
+    if (slot.idx != delta.idx) {
+        // Slot held another level (book moved): settle it, then start tracking this one
+        finalizePending(state, slot, delta.isBid, outPulls, pulls);
+        slot = LevelSlot{};
+        slot.idx = delta.idx;
+        slot.quantity = qty;
+        slot.lastAdd_ms = now_ms;
+        return;
+    }
+
+    const double prev = slot.quantity;
+    slot.quantity = qty;
+    const bool nearTouch = distance < m_config.nearTouchTicks;
+    PullStats::Side& side = delta.isBid ? state.stats.bid : state.stats.ask;
+
+    if (qty > prev) {
+        if (nearTouch) side.added[distance] += qty - prev;
+        slot.lastAdd_ms = now_ms;
+        return;
+    }
+    if (qty >= prev) return;
+
+    double removed = prev - qty;
+
+    // Trades that arrived before this update claim the decrease first
+    if (slot.tradeCredit > 0.0) {
+        if (now_ms - slot.tradeCredit_ms <= m_config.fillWindow_ms) {
+            const double fill = std::min(removed, slot.tradeCredit);
+            slot.tradeCredit -= fill;
+            removed -= fill;
+            if (nearTouch) side.filled[distance] += fill;
+        } else {
+            slot.tradeCredit = 0.0;
+        }
+    }
+    if (removed <= kQtyEpsilon || !nearTouch) return;
+
+    // Hold the rest until the fill window passes
+    if (slot.pendingQty <= 0.0) {
+        if (state.pendingCount == kPendingCapacity) {
+            // FIFO full: settle the oldest entry early
+            flushExpired(state, state.pending[state.pendingHead].pending_ms + m_config.fillWindow_ms, outPulls);
+        }
+        slot.pending_ms = now_ms;
+        slot.pendingLifetime_ms = now_ms - slot.lastAdd_ms;
+        slot.pendingDistance = distance;
+        PendingEntry& entry = state.pending[(state.pendingHead + state.pendingCount) % kPendingCapacity];
+        entry.idx = delta.idx;
+        entry.isBid = delta.isBid;
+        entry.pending_ms = now_ms;
+        ++state.pendingCount;
+    }
+    slot.pendingQty += removed;
+}
+
+size_t LiquidityPullEngine::onBookDeltas(const std::string& symbol, int64_t timestamp_ms,
+                                         const std::vector<BookDelta>& deltas,
+                                         uint32_t bestBidIdx, uint32_t bestAskIdx,
+                                         std::vector<PullEvent>* outPulls) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_symbols.find(symbol);
+    if (it == m_symbols.end() || it->second.tickSize <= 0.0) return 0;
+    SymbolState& state = it->second;
+
+    size_t pulls = 0;
+    for (const BookDelta& d : deltas) {
+        applyDelta(state, d, d.isBid ? bestBidIdx : bestAskIdx, timestamp_ms, outPulls, pulls);
+    }
+    return pulls + flushExpired(state, timestamp_ms, outPulls);
+}
+
+void LiquidityPullEngine::onTrade(const Trade& trade) {
+    if (trade.product_id.empty() || trade.size <= 0.0) return;
+    if (trade.side != AggressorSide::Buy && trade.side != AggressorSide::Sell) return;
+
+    const int64_t ts = std::chrono::duration_cast<std::chrono::milliseconds>(
+        trade.timestamp.time_since_epoch()).count();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_symbols.find(trade.product_id);
+    if (it == m_symbols.end() || it->second.tickSize <= 0.0) return;
+    SymbolState& state = it->second;
+
+    const double rawIdx = std::round((trade.price - state.minPrice) / state.tickSize);
+    if (rawIdx < 0.0 || rawIdx >= static_cast<double>(kNoLevel)) return;
+    const uint32_t idx = static_cast<uint32_t>(rawIdx);
+    const bool restingBid = trade.side == AggressorSide::Sell;  // Sellers hit resting bids
+
+    auto& ring = restingBid ? state.bidRing : state.askRing;
+    LevelSlot& slot = ring[idx & (kRingSize - 1)];
+    if (slot.idx != idx) return;  // Level not tracked
+
+    double size = trade.size;
+    // A decrease already seen within the window was a fill, not a pull
+    if (slot.pendingQty > 0.0 && ts - slot.pending_ms <= m_config.fillWindow_ms) {
+        const double fill = std::min(size, slot.pendingQty);
+        slot.pendingQty -= fill;
+        size -= fill;
+        PullStats::Side& side = restingBid ? state.stats.bid : state.stats.ask;
+        side.filled[slot.pendingDistance] += fill;
+    }
+    if (size > kQtyEpsilon) {
+        if (ts - slot.tradeCredit_ms > m_config.fillWindow_ms) slot.tradeCredit = 0.0;
+        slot.tradeCredit += size;
+        slot.tradeCredit_ms = ts;
+    }
+}
+
+bool LiquidityPullEngine::getStats(const std::string& symbol, PullStats& out) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_symbols.find(symbol);
+    if (it == m_symbols.end()) return false;
+    out = it->second.stats;
+    return true;
+}
+
+void LiquidityPullEngine::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_symbols.clear();
+}
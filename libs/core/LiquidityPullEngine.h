@@ -0,0 +1,123 @@
+/*
+Sentinel — LiquidityPullEngine
+Role: Streams add / cancel / fill attribution for resting size near the touch to surface pulled (spoof-like) liquidity.
+Inputs/Outputs: Takes BookDeltas with the current BBO and trades per symbol; produces PullEvents and per-distance PullStats.
+Threading: Thread-safe; ingestion (DataProcessor worker) and stats queries share one std::mutex.
+Performance: O(1) per delta and per trade. Levels live in fixed per-side rings indexed by tick; pending cancels in a fixed FIFO.
+Integration: Owned by DataProcessor; finalized pulls are folded into LiquidityTimeSeriesEngine for the Pulled display mode.
+Observability: Logs book configuration via sLog_App.
+Related: LiquidityPullEngine.cpp, LiquidityTimeSeriesEngine.h, TradeData.h (BookDelta, LiveOrderBook).
+Assumptions: A size decrease is held for fillWindow_ms so trades arriving after the book update can still claim it as a fill.
+*/
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "marketdata/model/TradeData.h"
+
+// Resting size removed near the touch without trading against it
+struct PullEvent {
+    int64_t timestamp_ms = 0;      // When the size was removed
+    double price = 0.0;
+    bool isBid = true;
+    double quantity = 0.0;
+    int64_t lifetime_ms = 0;       // Time since the level last grew
+    uint32_t distanceTicks = 0;    // Distance from the same-side best level at removal
+};
+
+struct PullStats {
+    static constexpr size_t kLifetimeBuckets = 8;
+    // Upper bucket edges (ms); the last bucket is open-ended
+    static constexpr std::array<int64_t, kLifetimeBuckets - 1> kLifetimeEdges_ms = {10, 50, 100, 250, 500, 1000, 5000};
+
+    struct Side {
+        std::vector<double> added;      // Index = distance from best in ticks
+        std::vector<double> cancelled;
+        std::vector<double> filled;
+        std::array<double, kLifetimeBuckets> cancelledByLifetime{};  // Cancelled quantity per lifetime bucket
+
+        double totalCancelled() const;
+        double totalFilled() const;
+        // Share of removed size that was cancelled rather than traded (0 when nothing was removed)
+        double pullRatio() const;
+    };
+
+    Side bid;
+    Side ask;
+
+    static size_t lifetimeBucket(int64_t lifetime_ms);
+};
+
+class LiquidityPullEngine {
+public:
+    struct Config {
+        uint32_t nearTouchTicks = 20;    // Attribution window from the best level, per side
+        int64_t fillWindow_ms = 250;     // Trade ↔ book-update correlation window
+    };
+
+    static constexpr uint32_t kNoLevel = UINT32_MAX;
+    static constexpr size_t kRingSize = 2048;          // Tracked levels per side (power of two)
+    static constexpr size_t kPendingCapacity = 4096;   // Decreases awaiting fill attribution
+
+    LiquidityPullEngine();
+    explicit LiquidityPullEngine(Config config);
+
+    // Price grid of the symbol's LiveOrderBook (BookDelta::idx → price)
+    void configureBook(const std::string& symbol, double minPrice, double tickSize);
+
+    // Event ingestion. Best indices are LiveOrderBook grid indices (kNoLevel if unknown).
+    // Pulls whose fill window expired are appended to outPulls; returns their count.
+    size_t onBookDeltas(const std::string& symbol, int64_t timestamp_ms, const std::vector<BookDelta>& deltas,
+                        uint32_t bestBidIdx, uint32_t bestAskIdx, std::vector<PullEvent>* outPulls);
+    void onTrade(const Trade& trade);
+
+    bool getStats(const std::string& symbol, PullStats& out) const;
+    uint32_t getNearTouchTicks() const { return m_config.nearTouchTicks; }
+
+    void clear();
+
+private:
+    struct LevelSlot {
+        uint32_t idx = kNoLevel;        // Grid index occupying this slot
+        double quantity = 0.0;
+        int64_t lastAdd_ms = 0;
+        double tradeCredit = 0.0;       // Traded here before the matching book decrease arrived
+        int64_t tradeCredit_ms = 0;
+        double pendingQty = 0.0;        // Decrease not yet attributed
+        int64_t pending_ms = 0;
+        int64_t pendingLifetime_ms = 0;
+        uint32_t pendingDistance = 0;
+    };
+
+    struct PendingEntry {
+        uint32_t idx = 0;
+        bool isBid = true;
+        int64_t pending_ms = 0;
+    };
+
+    struct SymbolState {
+        double minPrice = 0.0;
+        double tickSize = 0.0;
+        std::vector<LevelSlot> bidRing;     // kRingSize, slot = idx & (kRingSize - 1)
+        std::vector<LevelSlot> askRing;
+        std::vector<PendingEntry> pending;  // kPendingCapacity FIFO
+        size_t pendingHead = 0;
+        size_t pendingCount = 0;
+        PullStats stats;
+    };
+
+    SymbolState& stateFor(const std::string& symbol);
+    void applyDelta(SymbolState& state, const BookDelta& delta, uint32_t best, int64_t now_ms,
+                    std::vector<PullEvent>* outPulls, size_t& pulls);
+    void finalizePending(SymbolState& state, LevelSlot& slot, bool isBid,
+                         std::vector<PullEvent>* outPulls, size_t& pulls);
+    size_t flushExpired(SymbolState& state, int64_t now_ms, std::vector<PullEvent>* outPulls);
+
+    Config m_config;
+    std::unordered_map<std::string, SymbolState> m_symbols;
+    mutable std::mutex m_mutex;
+};
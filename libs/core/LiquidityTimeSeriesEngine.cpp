@@ -12,27 +12,192 @@ Assumptions: Time bucketing logic correctly assigns updates to their respective
 #include "LiquidityTimeSeriesEngine.h"
 #include "SentinelLogging.hpp"
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <set>
 #include <fstream>
 
+namespace {
+    // Shared by per-level metrics and their prefix sums, which carry the same field names
+    template <typename Values>
+    double displayValue(const Values& values, int displayMode) {
+        switch (static_cast<LiquidityTimeSeriesEngine::LiquidityDisplayMode>(displayMode)) {
+            case LiquidityTimeSeriesEngine::LiquidityDisplayMode::Average: 
+                return values.avgLiquidity;
+            case LiquidityTimeSeriesEngine::LiquidityDisplayMode::Maximum: 
+                return values.maxLiquidity;
+            case LiquidityTimeSeriesEngine::LiquidityDisplayMode::Resting: 
+                return values.restingLiquidity;
+            case LiquidityTimeSeriesEngine::LiquidityDisplayMode::Total: 
+                return values.totalLiquidity;
+            case LiquidityTimeSeriesEngine::LiquidityDisplayMode::Pulled:
+                return values.pulledLiquidity;
+            default: 
+                return values.avgLiquidity;
+        }
+    }
+
+    int64_t floorDiv(int64_t a, int64_t b) {
+        return a / b - ((a % b != 0) && ((a < 0) != (b < 0)));
+    }
+
+    // Bucket b of k ticks is centred on tick b·k and holds the ticks that round to it (halves round up)
+    int64_t bucketOf(int64_t tick, int64_t ticksPerBucket) {
+        return floorDiv(2 * tick + ticksPerBucket, 2 * ticksPerBucket);
+    }
+
+    // Whole base ticks per display bucket at a resolution (at least one)
+    int64_t ticksPer(double resolution, double tickSize) {
+        return std::max<int64_t>(1, std::llround(resolution / tickSize));
+    }
+
+    // Queues a building-slice level for takeCurrentSliceChanges once; a pending reset re-reads everything anyway
+    void noteChanged(LiquidityTimeSlice& slice, LiquidityTimeSlice::PriceLevelMetrics& metrics, Tick tick, bool isBid) {
+        if (slice.pendingReset || metrics.changeQueued) return;
+        metrics.changeQueued = true;
+        slice.pendingChanges.emplace_back(tick, isBid);
+    }
+
+    // Late pulls held beside the prefix sums before one O(width) fold; bounds the extra work per range read
+    constexpr size_t kMaxPendingPulls = 32;
+
+    bool isEmpty(const LiquidityTimeSlice::PriceLevelMetrics& metrics) {
+        return metrics.snapshotCount == 0 && metrics.pulledLiquidity == 0.0;
+    }
+
+    // Folds src into dst when two storage ticks land on one; additive values add, presence spans widen
+    void mergeMetrics(LiquidityTimeSlice::PriceLevelMetrics& dst, const LiquidityTimeSlice::PriceLevelMetrics& src) {
+        if (isEmpty(src)) return;
+        if (isEmpty(dst)) {
+            dst = src;
+            return;
+        }
+        dst.totalLiquidity += src.totalLiquidity;
+        dst.avgLiquidity += src.avgLiquidity;
+        dst.maxLiquidity += src.maxLiquidity;
+        dst.minLiquidity += src.minLiquidity;
+        dst.restingLiquidity += src.restingLiquidity;
+        dst.pulledLiquidity += src.pulledLiquidity;
+        dst.snapshotCount = std::max(dst.snapshotCount, src.snapshotCount);
+        dst.firstSeen_ms = std::min(dst.firstSeen_ms, src.firstSeen_ms);
+        dst.lastSeen_ms = std::max(dst.lastSeen_ms, src.lastSeen_ms);
+        dst.lastSeenSeq = std::max(dst.lastSeenSeq, src.lastSeenSeq);
+    }
+}
+
 // LiquidityTimeSlice implementation - O(1) tick-based access
 double LiquidityTimeSlice::getDisplayValue(double price, bool isBid, int displayMode) const {
     const auto* metrics = getMetrics(price, isBid);
     if (!metrics) return 0.0;
-    
-    switch (static_cast<LiquidityTimeSeriesEngine::LiquidityDisplayMode>(displayMode)) {
-        case LiquidityTimeSeriesEngine::LiquidityDisplayMode::Average: 
-            return metrics->avgLiquidity;
-        case LiquidityTimeSeriesEngine::LiquidityDisplayMode::Maximum: 
-            return metrics->maxLiquidity;
-        case LiquidityTimeSeriesEngine::LiquidityDisplayMode::Resting: 
-            return metrics->restingLiquidity;
-        case LiquidityTimeSeriesEngine::LiquidityDisplayMode::Total: 
-            return metrics->totalLiquidity;
-        default: 
-            return metrics->avgLiquidity;
+    return displayValue(*metrics, displayMode);
+}
+
+double LiquidityTimeSlice::getRangeValue(Tick firstTick, Tick lastTick, bool isBid, int displayMode) const {
+    const auto& metrics = isBid ? bidMetrics : askMetrics;
+    if (metrics.empty()) return 0.0;
+    const int64_t first = std::max<int64_t>(firstTick, minTick) - minTick;
+    const int64_t last = std::min<int64_t>(lastTick, static_cast<int64_t>(minTick) + static_cast<int64_t>(metrics.size()) - 1) - minTick;
+    if (first > last) return 0.0;
+
+    const auto& prefix = isBid ? bidPrefix : askPrefix;
+    if (prefix.size() == metrics.size() + 1) {
+        double value = displayValue(prefix[static_cast<size_t>(last) + 1], displayMode) -
+                       displayValue(prefix[static_cast<size_t>(first)], displayMode);
+        if (displayMode == static_cast<int>(LiquidityTimeSeriesEngine::LiquidityDisplayMode::Pulled)) {
+            for (const auto& [index, quantity] : isBid ? bidPendingPulls : askPendingPulls) {
+                if (index >= first && index <= last) value += quantity;
+            }
+        }
+        return value;
+    }
+    double sum = 0.0;
+    for (int64_t i = first; i <= last; ++i) {
+        sum += displayValue(metrics[static_cast<size_t>(i)], displayMode);
+    }
+    return sum;
+}
+
+void LiquidityTimeSlice::collectBuckets(double resolution, double priceMin, double priceMax, int displayMode,
+                                        std::vector<LiquidityBucket>& out) const {
+    if (tickSize <= 0.0 || priceMax < priceMin || (bidMetrics.empty() && askMetrics.empty())) return;
+
+    const int64_t ticksPerBucket = ticksPer(resolution, tickSize);
+    const double bucketSize = static_cast<double>(ticksPerBucket) * tickSize;
+    const int64_t firstTick = std::max<int64_t>(minTick, static_cast<int64_t>(std::floor(priceMin / tickSize)));
+    const int64_t lastTick = std::min<int64_t>(maxTick, static_cast<int64_t>(std::ceil(priceMax / tickSize)));
+    if (firstTick > lastTick) return;
+
+    const int64_t firstBucket = bucketOf(firstTick, ticksPerBucket);
+    const int64_t lastBucket = bucketOf(lastTick, ticksPerBucket);
+    for (const bool isBid : {true, false}) {
+        for (int64_t bucket = firstBucket; bucket <= lastBucket; ++bucket) {
+            const int64_t centre = bucket * ticksPerBucket;
+            const int64_t from = floorDiv(2 * centre - ticksPerBucket + 1, 2);
+            const int64_t to = floorDiv(2 * centre + ticksPerBucket - 1, 2);
+            const double value = getRangeValue(static_cast<Tick>(from), static_cast<Tick>(to), isBid, displayMode);
+            if (value > 0.0) {
+                out.push_back({static_cast<double>(centre) * tickSize, bucketSize, value, isBid, bucket});
+            }
+        }
+    }
+}
+
+bool LiquidityTimeSlice::bucketAt(Tick tick, bool isBid, double resolution, int displayMode,
+                                  LiquidityBucket& out) const {
+    if (tickSize <= 0.0) return false;
+    const int64_t ticksPerBucket = ticksPer(resolution, tickSize);
+    const int64_t bucket = bucketOf(tick, ticksPerBucket);
+    const int64_t centre = bucket * ticksPerBucket;
+    const int64_t from = floorDiv(2 * centre - ticksPerBucket + 1, 2);
+    const int64_t to = floorDiv(2 * centre + ticksPerBucket - 1, 2);
+    const double value = getRangeValue(static_cast<Tick>(from), static_cast<Tick>(to), isBid, displayMode);
+    if (value <= 0.0) return false;
+    out = {static_cast<double>(centre) * tickSize, static_cast<double>(ticksPerBucket) * tickSize, value, isBid, bucket};
+    return true;
+}
+
+int64_t LiquidityTimeSlice::bucketIndex(Tick tick, double resolution) const {
+    return tickSize > 0.0 ? bucketOf(tick, ticksPer(resolution, tickSize)) : tick;
+}
+
+void LiquidityTimeSlice::buildPrefixSums() {
+    for (const bool isBid : {true, false}) {
+        const auto& metrics = isBid ? bidMetrics : askMetrics;
+        auto& prefix = isBid ? bidPrefix : askPrefix;
+        prefix.assign(metrics.empty() ? 0 : metrics.size() + 1, PrefixSums{});
+        for (size_t i = 0; i < metrics.size(); ++i) {
+            PrefixSums& next = prefix[i + 1];
+            next = prefix[i];
+            next.avgLiquidity += metrics[i].avgLiquidity;
+            next.maxLiquidity += metrics[i].maxLiquidity;
+            next.restingLiquidity += metrics[i].restingLiquidity;
+            next.totalLiquidity += metrics[i].totalLiquidity;
+            next.pulledLiquidity += metrics[i].pulledLiquidity;
+        }
     }
+    bidPendingPulls.clear();  // Already in the metrics summed above
+    askPendingPulls.clear();
+}
+
+void LiquidityTimeSlice::addPendingPull(size_t index, bool isBid, double quantity) {
+    auto& pending = isBid ? bidPendingPulls : askPendingPulls;
+    pending.emplace_back(static_cast<uint32_t>(index), quantity);
+    if (pending.size() >= kMaxPendingPulls) foldPendingPulls(isBid);
+}
+
+void LiquidityTimeSlice::foldPendingPulls(bool isBid) {
+    auto& pending = isBid ? bidPendingPulls : askPendingPulls;
+    auto& prefix = isBid ? bidPrefix : askPrefix;
+    if (pending.empty()) return;
+    // One sweep from the lowest pulled index: each prefix entry gains every pull below it
+    std::sort(pending.begin(), pending.end());
+    double carried = 0.0;
+    size_t next = 0;
+    for (size_t i = pending.front().first; i + 1 < prefix.size(); ++i) {
+        while (next < pending.size() && pending[next].first == i) carried += pending[next++].second;
+        prefix[i + 1].pulledLiquidity += carried;
+    }
+    pending.clear();
 }
 
 // LiquidityTimeSeriesEngine implementation
@@ -41,13 +206,14 @@ LiquidityTimeSeriesEngine::LiquidityTimeSeriesEngine(QObject* parent)
 {
     // Initialize empty deques for all timeframes
     for (int64_t timeframe : m_timeframes) {
-        m_timeSlices[timeframe] = std::deque<LiquidityTimeSlice>();
+        m_timeSlices[timeframe] = std::deque<LiquidityTimeSlicePtr>();
     }
     
     sLog_App("LiquidityTimeSeriesEngine: Initialized with " << m_timeframes.size() << " timeframes");
     sLog_App("  Base resolution: " << m_baseTimeframe_ms << "ms");
-    sLog_App("  Price resolution: $" << m_priceResolution);
-    sLog_App("  Max history per timeframe: " << m_maxHistorySlices << " slices");
+    sLog_App("  Base tick: $" << m_baseTickSize << ", display resolution: $" << m_priceResolution);
+    sLog_App("  Max history per timeframe: " << m_maxHistorySlices << " slices, "
+             << (m_maxHistoryBytes >> 20) << " MB");
 }
 
 void LiquidityTimeSeriesEngine::addOrderBookSnapshot(const OrderBook& book) {
@@ -77,6 +243,64 @@ void LiquidityTimeSeriesEngine::addDenseSnapshot(const LiveOrderBook::DenseBookS
     cleanupOldData();
 }
 
+void LiquidityTimeSeriesEngine::addBucketedSnapshot(const LiveOrderBook::BucketSnapshotView& view) {
+    OrderBookSnapshot snapshot;
+    snapshot.timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(view.timestamp.time_since_epoch()).count();
+
+    // Bucket prices already sit on the resolution grid; quantizing again only folds coarser views down
+    for (const auto& [price, qty] : view.bidBuckets) {
+        snapshot.bids[quantizePrice(price)] += qty;
+    }
+    for (const auto& [price, qty] : view.askBuckets) {
+        snapshot.asks[quantizePrice(price)] += qty;
+    }
+
+    m_snapshots.push_back(snapshot);
+    updateAllTimeframes(snapshot);
+    cleanupOldData();
+}
+
+void LiquidityTimeSeriesEngine::addPulledLiquidity(int64_t timestamp_ms, double price, bool isBid, double quantity) {
+    if (quantity <= 0.0) return;
+
+    for (int64_t timeframe_ms : m_timeframes) {
+        // Pulls are reported after a short fill window, so the slice is the current one or one of the newest finalized
+        LiquidityTimeSlice* slice = nullptr;
+        bool isCurrent = false;
+        auto current_it = m_currentSlices.find(timeframe_ms);
+        if (current_it != m_currentSlices.end() &&
+            timestamp_ms >= current_it->second.startTime_ms && timestamp_ms < current_it->second.endTime_ms) {
+            slice = &current_it->second;
+            isCurrent = true;
+        } else {
+            auto& slices = m_timeSlices[timeframe_ms];
+            for (auto it = slices.rbegin(); it != slices.rend() && (*it)->endTime_ms > timestamp_ms; ++it) {
+                if (timestamp_ms >= (*it)->startTime_ms) {
+                    slice = &mutableSlice(*it);
+                    break;
+                }
+            }
+        }
+        if (!slice) continue;
+        // Older history may sit on a different storage grid than the current base tick
+        const Tick tick = slice->priceToTick(price);
+        if (tick < slice->minTick || tick > slice->maxTick) continue;
+
+        auto& metrics = isBid ? slice->bidMetrics : slice->askMetrics;
+        const size_t index = static_cast<size_t>(tick - slice->minTick);
+        if (index < metrics.size()) {
+            metrics[index].pulledLiquidity += quantity;
+            if (isCurrent) {
+                noteChanged(*slice, metrics[index], tick, isBid);
+            } else {
+                ++slice->revision;
+                // Finalized: the prefix sums catch up in batches instead of an O(width) pass per pull
+                if (!(isBid ? slice->bidPrefix : slice->askPrefix).empty()) slice->addPendingPull(index, isBid, quantity);
+            }
+        }
+    }
+}
+
 void LiquidityTimeSeriesEngine::addOrderBookSnapshot(const OrderBook& book, double minPrice, double maxPrice) {
     if (book.product_id.empty()) return;
     
@@ -129,36 +353,93 @@ const LiquidityTimeSlice* LiquidityTimeSeriesEngine::getTimeSlice(int64_t timefr
     
     // Find slice containing this timestamp
     for (const auto& slice : tf_it->second) {
-        if (timestamp_ms >= slice.startTime_ms && timestamp_ms < slice.endTime_ms) {
-            return &slice;
+        if (timestamp_ms >= slice->startTime_ms && timestamp_ms < slice->endTime_ms) {
+            return slice.get();
         }
     }
     return nullptr;
 }
 
-std::vector<const LiquidityTimeSlice*> LiquidityTimeSeriesEngine::getVisibleSlices(
+std::vector<LiquidityTimeSlicePtr> LiquidityTimeSeriesEngine::getFinalizedSlices(
     int64_t timeframe_ms, int64_t viewStart_ms, int64_t viewEnd_ms) const {
-    
-    std::vector<const LiquidityTimeSlice*> visible;
+    std::vector<LiquidityTimeSlicePtr> visible;
     auto tf_it = m_timeSlices.find(timeframe_ms);
     if (tf_it == m_timeSlices.end()) return visible;
-    
+
     for (const auto& slice : tf_it->second) {
-        if (slice.endTime_ms >= viewStart_ms && slice.startTime_ms <= viewEnd_ms) {
-            visible.push_back(&slice);
+        if (slice->endTime_ms >= viewStart_ms && slice->startTime_ms <= viewEnd_ms) {
+            visible.push_back(slice);
         }
     }
-    
-    // Also include current slice if it overlaps with viewport
+    return visible;
+}
+
+const LiquidityTimeSlice* LiquidityTimeSeriesEngine::getCurrentSlice(int64_t timeframe_ms) const {
     auto current_it = m_currentSlices.find(timeframe_ms);
-    if (current_it != m_currentSlices.end()) {
-        const auto& currentSlice = current_it->second;
-        if (currentSlice.endTime_ms >= viewStart_ms && currentSlice.startTime_ms <= viewEnd_ms) {
-            visible.push_back(&currentSlice);
+    if (current_it == m_currentSlices.end() || current_it->second.startTime_ms == 0) return nullptr;
+    return &current_it->second;
+}
+
+bool LiquidityTimeSeriesEngine::takeCurrentSliceChanges(int64_t timeframe_ms, std::vector<std::pair<Tick, bool>>& out) {
+    out.clear();
+    auto current_it = m_currentSlices.find(timeframe_ms);
+    if (current_it == m_currentSlices.end()) return false;
+    LiquidityTimeSlice& slice = current_it->second;
+    if (slice.pendingReset) {
+        // The caller re-reads the whole slice; start queuing from here
+        for (auto* side : {&slice.bidMetrics, &slice.askMetrics}) {
+            for (auto& metrics : *side) metrics.changeQueued = false;
         }
+        slice.pendingChanges.clear();
+        slice.pendingReset = false;
+        return false;
     }
-    
-    return visible;
+    for (const auto& [tick, isBid] : slice.pendingChanges) {
+        auto& metrics = isBid ? slice.bidMetrics : slice.askMetrics;
+        metrics[static_cast<size_t>(tick - slice.minTick)].changeQueued = false;
+    }
+    out.swap(slice.pendingChanges);
+    return true;
+}
+
+void LiquidityTimeSeriesEngine::visitSlices(
+    size_t maxSlicesPerTimeframe,
+    const std::function<void(int64_t, const LiquidityTimeSlicePtr&, bool)>& visitor) const {
+    for (int64_t timeframe_ms : m_timeframes) {
+        auto tf_it = m_timeSlices.find(timeframe_ms);
+        if (tf_it != m_timeSlices.end()) {
+            const auto& slices = tf_it->second;
+            const size_t first = slices.size() > maxSlicesPerTimeframe ? slices.size() - maxSlicesPerTimeframe : 0;
+            for (size_t i = first; i < slices.size(); ++i) {
+                visitor(timeframe_ms, slices[i], false);
+            }
+        }
+        auto current_it = m_currentSlices.find(timeframe_ms);
+        if (current_it != m_currentSlices.end() && current_it->second.startTime_ms != 0) {
+            visitor(timeframe_ms, std::make_shared<const LiquidityTimeSlice>(current_it->second), true);
+        }
+    }
+}
+
+bool LiquidityTimeSeriesEngine::restoreSlice(int64_t timeframe_ms, LiquidityTimeSlice slice, bool wasCurrent) {
+    if (std::find(m_timeframes.begin(), m_timeframes.end(), timeframe_ms) == m_timeframes.end()) return false;
+
+    auto& slices = m_timeSlices[timeframe_ms];
+    if (!slices.empty() && slice.startTime_ms < slices.back()->endTime_ms) return false;
+    auto current_it = m_currentSlices.find(timeframe_ms);
+    if (current_it != m_currentSlices.end() && current_it->second.startTime_ms != 0 &&
+        slice.endTime_ms > current_it->second.startTime_ms) {
+        return false;  // Live data already covers this time
+    }
+
+    // The session that was building it is gone; close it out as-is
+    if (wasCurrent) {
+        finalizeLiquiditySlice(slice);
+    } else {
+        slice.buildPrefixSums();  // Not checkpointed; derived from the metrics
+    }
+    appendFinalizedSlice(timeframe_ms, std::move(slice));
+    return true;
 }
 
 void LiquidityTimeSeriesEngine::addTimeframe(int64_t duration_ms) {
@@ -167,7 +448,7 @@ void LiquidityTimeSeriesEngine::addTimeframe(int64_t duration_ms) {
         std::sort(m_timeframes.begin(), m_timeframes.end());
         
         // Initialize empty deque for this timeframe
-        m_timeSlices[duration_ms] = std::deque<LiquidityTimeSlice>();
+        m_timeSlices[duration_ms] = std::deque<LiquidityTimeSlicePtr>();
         
         // Rebuild historical data for new timeframe from base snapshots
         rebuildTimeframe(duration_ms);
@@ -181,6 +462,7 @@ void LiquidityTimeSeriesEngine::removeTimeframe(int64_t duration_ms) {
     if (it != m_timeframes.end()) {
         m_timeframes.erase(it);
         m_timeSlices.erase(duration_ms);
+        m_historyBytes.erase(duration_ms);
         m_currentSlices.erase(duration_ms);
         
         sLog_App("Removed timeframe: " << duration_ms << "ms");
@@ -191,6 +473,17 @@ std::vector<int64_t> LiquidityTimeSeriesEngine::getAvailableTimeframes() const {
     return m_timeframes;
 }
 
+std::vector<int64_t> LiquidityTimeSeriesEngine::getPopulatedTimeframes() const {
+    std::vector<int64_t> populated;
+    for (int64_t timeframe : m_timeframes) {
+        auto tf_it = m_timeSlices.find(timeframe);
+        if (tf_it != m_timeSlices.end() && !tf_it->second.empty()) {
+            populated.push_back(timeframe);
+        }
+    }
+    return populated;
+}
+
 int64_t LiquidityTimeSeriesEngine::suggestTimeframe(int64_t viewStart_ms, int64_t viewEnd_ms, int maxSlices) const {
     if (viewStart_ms >= viewEnd_ms || maxSlices <= 0) {
         return m_baseTimeframe_ms;  // Fallback to base timeframe
@@ -247,6 +540,23 @@ int64_t LiquidityTimeSeriesEngine::suggestTimeframe(int64_t viewStart_ms, int64_
     return m_baseTimeframe_ms;  // Ultimate fallback
 }
 
+void LiquidityTimeSeriesEngine::setPriceResolution(double resolution) {
+    if (resolution <= 0.0) return;
+    m_priceResolution = resolution;
+    if (resolution < m_baseTickSize * (1.0 - 1e-9)) {
+        setBaseTickSize(resolution);
+    }
+}
+
+void LiquidityTimeSeriesEngine::setBaseTickSize(double tickSize) {
+    if (tickSize <= 0.0 || tickSize == m_baseTickSize) return;
+    m_baseTickSize = tickSize;
+    for (auto& [timeframe, slice] : m_currentSlices) {
+        rebaseSlice(slice, tickSize);
+    }
+    sLog_App("Base tick changed to $" << tickSize << " (finalized history keeps its grid)");
+}
+
 void LiquidityTimeSeriesEngine::setDisplayMode(LiquidityDisplayMode mode) {
     if (m_displayMode != mode) {
         m_displayMode = mode;
@@ -255,7 +565,8 @@ void LiquidityTimeSeriesEngine::setDisplayMode(LiquidityDisplayMode mode) {
         sLog_App("Display mode changed to: " << 
                  (mode == LiquidityDisplayMode::Average ? "Average" :
                   mode == LiquidityDisplayMode::Maximum ? "Maximum" :
-                  mode == LiquidityDisplayMode::Resting ? "Resting" : "Total"));
+                  mode == LiquidityDisplayMode::Resting ? "Resting" :
+                  mode == LiquidityDisplayMode::Pulled ? "Pulled" : "Total"));
     }
 }
 
@@ -319,10 +630,9 @@ void LiquidityTimeSeriesEngine::updateTimeframe(int64_t timeframe_ms, const Orde
     if (currentSlice.startTime_ms == 0 || sliceStart != currentSlice.startTime_ms) {
         // Finalize previous slice if it exists
         if (currentSlice.startTime_ms != 0) {
+            // Moved, not copied: from here on the slice is shared read-only with every consumer
             finalizeLiquiditySlice(currentSlice);
-            m_timeSlices[timeframe_ms].push_back(currentSlice);
-            
-            emit timeSliceReady(timeframe_ms, currentSlice);
+            appendFinalizedSlice(timeframe_ms, std::move(currentSlice));
         }
         
         // Start new slice
@@ -374,7 +684,7 @@ void LiquidityTimeSeriesEngine::addSnapshotToSlice(LiquidityTimeSlice& slice, co
         // First snapshot in slice
         slice.minTick = minSnapshotTick;
         slice.maxTick = maxSnapshotTick;
-        slice.tickSize = m_priceResolution;
+        slice.tickSize = m_baseTickSize;
         size_t range = static_cast<size_t>(maxSnapshotTick - minSnapshotTick + 1);
         slice.bidMetrics.resize(range);
         slice.askMetrics.resize(range);
@@ -410,6 +720,7 @@ void LiquidityTimeSeriesEngine::addSnapshotToSlice(LiquidityTimeSlice& slice, co
         if (index < slice.bidMetrics.size()) {
             updatePriceLevelMetrics(slice.bidMetrics[index], size, snapshot.timestamp_ms, slice);
             slice.bidMetrics[index].lastSeenSeq = m_globalSequence;
+            noteChanged(slice, slice.bidMetrics[index], tick, true);
         }
     }
     
@@ -420,6 +731,7 @@ void LiquidityTimeSeriesEngine::addSnapshotToSlice(LiquidityTimeSlice& slice, co
         if (index < slice.askMetrics.size()) {
             updatePriceLevelMetrics(slice.askMetrics[index], size, snapshot.timestamp_ms, slice);
             slice.askMetrics[index].lastSeenSeq = m_globalSequence;
+            noteChanged(slice, slice.askMetrics[index], tick, false);
         }
     }
     
@@ -499,6 +811,9 @@ void LiquidityTimeSeriesEngine::finalizeLiquiditySlice(LiquidityTimeSlice& slice
         }
     }
     
+    slice.buildPrefixSums();
+    std::vector<std::pair<Tick, bool>>().swap(slice.pendingChanges);  // Nobody drains a finalized slice
+    
     // Debug logging for first few slices
     static int sliceCount = 0;
     if (++sliceCount <= 5) {
@@ -510,36 +825,101 @@ void LiquidityTimeSeriesEngine::finalizeLiquiditySlice(LiquidityTimeSlice& slice
     }
 }
 
+void LiquidityTimeSeriesEngine::rebaseSlice(LiquidityTimeSlice& slice, double tickSize) const {
+    if (slice.tickSize == tickSize) return;
+    if (slice.bidMetrics.empty() && slice.askMetrics.empty()) {
+        slice.tickSize = tickSize;
+        return;
+    }
+
+    auto toTick = [&](Tick oldTick) {
+        return static_cast<Tick>(std::round(slice.tickToPrice(oldTick) / tickSize));
+    };
+    const Tick newMin = toTick(slice.minTick);
+    const Tick newMax = toTick(slice.maxTick);
+    const size_t range = static_cast<size_t>(newMax - newMin + 1);
+    for (auto* side : {&slice.bidMetrics, &slice.askMetrics}) {
+        if (side->empty()) continue;
+        std::vector<LiquidityTimeSlice::PriceLevelMetrics> moved(range);
+        for (size_t i = 0; i < side->size(); ++i) {
+            const Tick tick = toTick(slice.minTick + static_cast<Tick>(i));
+            mergeMetrics(moved[static_cast<size_t>(tick - newMin)], (*side)[i]);
+        }
+        *side = std::move(moved);
+    }
+    slice.minTick = newMin;
+    slice.maxTick = newMax;
+    slice.tickSize = tickSize;
+    slice.pendingReset = true;  // Queued ticks refer to the old grid
+    if (!slice.bidPrefix.empty() || !slice.askPrefix.empty()) slice.buildPrefixSums();
+}
+
+LiquidityTimeSlice& LiquidityTimeSeriesEngine::mutableSlice(LiquidityTimeSlicePtr& slice) {
+    // Slices are allocated non-const, so the cast is sound; it only reopens one no consumer holds
+    // (a consumer's copy keeps use_count above one, and new copies are only handed out on this thread)
+    if (slice.use_count() > 1) {
+        slice = std::make_shared<LiquidityTimeSlice>(*slice);
+    } else {
+        std::atomic_thread_fence(std::memory_order_acquire);  // Pairs with the release of a reader's last reference
+    }
+    return const_cast<LiquidityTimeSlice&>(*slice);
+}
+
 void LiquidityTimeSeriesEngine::rebuildTimeframe(int64_t timeframe_ms) {
     if (m_snapshots.empty()) return;
     
-    auto& slices = m_timeSlices[timeframe_ms];
-    slices.clear();
-    
-    // Group snapshots by time buckets
-    std::map<int64_t, std::vector<OrderBookSnapshot>> buckets;
+    m_timeSlices[timeframe_ms].clear();
+    m_historyBytes[timeframe_ms] = 0;
     
+    // Snapshots are kept in arrival order: group them in one pass, closing a slice when the bucket changes
+    // (the same rule updateTimeframe applies live)
+    LiquidityTimeSlice slice{};
     for (const auto& snapshot : m_snapshots) {
-        int64_t bucketStart = (snapshot.timestamp_ms / timeframe_ms) * timeframe_ms;
-        buckets[bucketStart].push_back(snapshot);
-    }
-    
-    // Create slices from buckets
-    for (const auto& [bucketStart, snapshots] : buckets) {
-        LiquidityTimeSlice slice;
-        slice.startTime_ms = bucketStart;
-        slice.endTime_ms = bucketStart + timeframe_ms;
-        slice.duration_ms = timeframe_ms;
-        
-        for (const auto& snapshot : snapshots) {
-            addSnapshotToSlice(slice, snapshot);
+        const int64_t bucketStart = (snapshot.timestamp_ms / timeframe_ms) * timeframe_ms;
+        if (slice.startTime_ms != bucketStart) {
+            if (slice.startTime_ms != 0) {
+                finalizeLiquiditySlice(slice);
+                appendFinalizedSlice(timeframe_ms, std::move(slice));
+            }
+            slice = LiquidityTimeSlice();
+            slice.startTime_ms = bucketStart;
+            slice.endTime_ms = bucketStart + timeframe_ms;
+            slice.duration_ms = timeframe_ms;
         }
-        
-        finalizeLiquiditySlice(slice);
-        slices.push_back(slice);
+        addSnapshotToSlice(slice, snapshot);
     }
+    finalizeLiquiditySlice(slice);
+    appendFinalizedSlice(timeframe_ms, std::move(slice));
     
-    sLog_App("Rebuilt timeframe " << timeframe_ms << "ms: " << slices.size() << " slices");
+    sLog_App("Rebuilt timeframe " << timeframe_ms << "ms: " << m_timeSlices[timeframe_ms].size() << " slices");
+}
+
+void LiquidityTimeSeriesEngine::appendFinalizedSlice(int64_t timeframe_ms, LiquidityTimeSlice&& slice) {
+    m_historyBytes[timeframe_ms] += slice.historyBytes();
+    m_timeSlices[timeframe_ms].push_back(std::make_shared<LiquidityTimeSlice>(std::move(slice)));
+    trimHistory(timeframe_ms);
+}
+
+void LiquidityTimeSeriesEngine::trimHistory(int64_t timeframe_ms) {
+    auto& slices = m_timeSlices[timeframe_ms];
+    size_t& bytes = m_historyBytes[timeframe_ms];
+    // Late-pull clones keep their width, so the charge taken on append is still what each slice holds
+    while (slices.size() > m_maxHistorySlices || (bytes > m_maxHistoryBytes && slices.size() > 1)) {
+        bytes -= slices.front()->historyBytes();
+        slices.pop_front();
+    }
+}
+
+void LiquidityTimeSeriesEngine::setMaxHistoryBytes(size_t bytes) {
+    m_maxHistoryBytes = bytes;
+    for (const auto& [timeframe, slices] : m_timeSlices) {
+        trimHistory(timeframe);
+    }
+}
+
+size_t LiquidityTimeSeriesEngine::getHistoryBytes(int64_t timeframe_ms) const {
+    auto it = m_historyBytes.find(timeframe_ms);
+    return it != m_historyBytes.end() ? it->second : 0;
 }
 
 void LiquidityTimeSeriesEngine::cleanupOldData() {
@@ -552,13 +932,11 @@ void LiquidityTimeSeriesEngine::cleanupOldData() {
     }
     
     // Cleanup old slices
-    for (auto& [timeframe, slices] : m_timeSlices) {
-        while (slices.size() > m_maxHistorySlices) {
-            slices.pop_front();
-        }
+    for (const auto& [timeframe, slices] : m_timeSlices) {
+        trimHistory(timeframe);
     }
 }
 
 double LiquidityTimeSeriesEngine::quantizePrice(double price) const {
-    return std::round(price / m_priceResolution) * m_priceResolution;
+    return std::round(price / m_baseTickSize) * m_baseTickSize;
 }
\ No newline at end of file
@@ -14,7 +14,9 @@ Assumptions: Order book updates are processed to update the time-sliced liquidit
 #include <QObject>
 #include <QTimer>
 #include <deque>
+#include <functional>
 #include <map>
+#include <memory>
 #include <vector>
 #include "marketdata/model/TradeData.h"
 
@@ -25,12 +27,16 @@ Assumptions: Order book updates are processed to update the time-sliced liquidit
  * - Captures 100ms order book snapshots
  * - Aggregates them into configurable timeframes (250ms, 500ms, 1s, 2s, 5s, etc.)
  * - Provides anti-spoofing detection via persistence ratio
- * - Supports multiple display modes (average, resting, peak, total liquidity)
+ * - Supports multiple display modes (average, resting, peak, total, pulled liquidity)
  * 
  * Key Features:
  * - Dynamic timeframe management
  * - Real-time "current" slice building
- * - Memory-bounded with automatic cleanup
+ * - Memory-bounded with automatic cleanup: each timeframe keeps at most m_maxHistorySlices finalized slices
+ *   and at most m_maxHistoryBytes of their metrics and prefix sums (see LiquidityTimeSlice::historyBytes),
+ *   dropping the oldest first. A slice costs ~240 bytes per tick of width (two sides of metrics plus prefix
+ *   sums), so a 4000-tick slice is ~1 MB and the default budget caps all 7 timeframes at ~900 MB.
+ * - Slices stored on a base tick grid; any coarser price resolution is read from per-slice prefix sums
  * - High-performance data structures for GPU rendering
  */
 
@@ -60,6 +66,7 @@ struct LiquidityTimeSlice {
     int64_t startTime_ms;
     int64_t endTime_ms;
     int64_t duration_ms;
+    uint64_t revision = 0;  // Bumped by each late pull after finalization; consumers re-read a slice whose revision moved
     
     // Tick-based price range for this slice
     Tick minTick = 0;      // Lowest price tick seen in this slice
@@ -74,11 +81,13 @@ struct LiquidityTimeSlice {
         double minLiquidity = 0.0;           // Minimum liquidity (could be 0)
         double restingLiquidity = 0.0;       // Liquidity that stayed for full duration
         int snapshotCount = 0;               // How many snapshots included this price
+        double pulledLiquidity = 0.0;        // Size cancelled near the touch without trading (full-rate deltas)
         int64_t firstSeen_ms = 0;            // When this price level first appeared
         int64_t lastSeen_ms = 0;             // When this price level last had liquidity
         
         // Version stamp for O(1) presence detection
         uint32_t lastSeenSeq = 0;            // Global sequence number of last snapshot containing this level
+        bool changeQueued = false;           // Building slice: already listed in pendingChanges
         
         // Anti-spoofing detection
         bool wasConsistent() const {
@@ -96,6 +105,27 @@ struct LiquidityTimeSlice {
     std::vector<PriceLevelMetrics> bidMetrics;  // Index = (tick - minTick)
     std::vector<PriceLevelMetrics> askMetrics;  // Index = (tick - minTick)
     
+    // Running sums over price of each display value; entry i covers ticks [minTick, minTick + i).
+    // Built when the slice is finalized so any coarser bucket reads in O(1); empty while the slice is building.
+    struct PrefixSums {
+        double avgLiquidity = 0.0;
+        double maxLiquidity = 0.0;
+        double restingLiquidity = 0.0;
+        double totalLiquidity = 0.0;
+        double pulledLiquidity = 0.0;
+    };
+    std::vector<PrefixSums> bidPrefix;  // bidMetrics.size() + 1 entries once built
+    std::vector<PrefixSums> askPrefix;
+    // Late pulls on a finalized slice not yet folded into pulledLiquidity of the prefix sums, as (index, quantity).
+    // getRangeValue adds them on read; they are folded in one pass once enough accumulate.
+    std::vector<std::pair<uint32_t, double>> bidPendingPulls;
+    std::vector<std::pair<uint32_t, double>> askPendingPulls;
+
+    // Building slice only: (tick, isBid) levels whose display values changed since the last
+    // LiquidityTimeSeriesEngine::takeCurrentSliceChanges; pendingReset = re-read everything (new slice or grid)
+    std::vector<std::pair<Tick, bool>> pendingChanges;
+    bool pendingReset = true;
+    
     // Tick-based access methods
     Tick priceToTick(double price) const {
         return static_cast<Tick>(std::round(price / tickSize));
@@ -117,6 +147,43 @@ struct LiquidityTimeSlice {
     
     // Get display value for rendering (O(1) access)
     double getDisplayValue(double price, bool isBid, int displayMode) const;
+    
+    // Display value summed over ticks [firstTick, lastTick], clamped to the slice.
+    // O(1) once finalized, O(lastTick - firstTick) while still building.
+    double getRangeValue(Tick firstTick, Tick lastTick, bool isBid, int displayMode) const;
+    
+    // Appends the non-zero buckets overlapping [priceMin, priceMax] at the given resolution, bids then asks,
+    // ascending price. Resolution rounds to a whole number of ticks (at least one). O(buckets) once finalized.
+    void collectBuckets(double resolution, double priceMin, double priceMax, int displayMode,
+                        std::vector<struct LiquidityBucket>& out) const;
+    // The bucket collectBuckets would emit for the one holding tick; false when its value is zero
+    bool bucketAt(Tick tick, bool isBid, double resolution, int displayMode, struct LiquidityBucket& out) const;
+    // Number of the bucket holding tick at that resolution, as in LiquidityBucket::index (floor bucketing:
+    // buckets are centred on multiples of their size, halves round up, negative ticks included)
+    int64_t bucketIndex(Tick tick, double resolution) const;
+    
+    void buildPrefixSums();
+    // Bytes the slice's per-tick storage holds once finalized (metrics and prefix sums); fixed from then on,
+    // so the engine can charge it on append and refund it on trim
+    size_t historyBytes() const {
+        return (bidMetrics.size() + askMetrics.size()) * sizeof(PriceLevelMetrics) +
+               (bidPrefix.size() + askPrefix.size()) * sizeof(PrefixSums);
+    }
+    // Records a late pull at a metrics index of a finalized slice; amortized O(1) per pull
+    void addPendingPull(size_t index, bool isBid, double quantity);
+    void foldPendingPulls(bool isBid);
+};
+
+// Finalized slices are immutable and shared: consumers on any thread hold them without copying
+using LiquidityTimeSlicePtr = std::shared_ptr<const LiquidityTimeSlice>;
+
+// One display cell of a slice read at a coarser price resolution than it was stored at
+struct LiquidityBucket {
+    double price = 0.0;       // Bucket centre; a multiple of size
+    double size = 0.0;        // Bucket height in price (whole ticks of the slice)
+    double value = 0.0;       // Display value summed over the bucket's ticks
+    bool isBid = false;
+    int64_t index = 0;        // Bucket number at its resolution: price = index * size (see bucketIndex)
 };
 
 class LiquidityTimeSeriesEngine : public QObject {
@@ -127,7 +194,8 @@ public:
         Average = 0,    // Average liquidity during interval
         Maximum = 1,    // Peak liquidity seen
         Resting = 2,    // Only liquidity that persisted full duration (anti-spoof)
-        Total = 3       // Sum of all liquidity seen
+        Total = 3,      // Sum of all liquidity seen
+        Pulled = 4      // Size added then cancelled near the touch (from LiquidityPullEngine)
     };
     Q_ENUM(LiquidityDisplayMode)
 
@@ -138,8 +206,9 @@ private:
     // Dynamic timeframe configuration
     std::vector<int64_t> m_timeframes = {100, 250, 500, 1000, 2000, 5000, 10000}; // ms
     
-    // Aggregated time slices for each timeframe
-    std::map<int64_t, std::deque<LiquidityTimeSlice>> m_timeSlices;
+    // Aggregated time slices for each timeframe (finalized, shared with consumers)
+    std::map<int64_t, std::deque<LiquidityTimeSlicePtr>> m_timeSlices;
+    std::map<int64_t, size_t> m_historyBytes;   // Sum of historyBytes() over each timeframe's m_timeSlices
     
     //  TIMEFRAME SUGGESTION TRACKING: Only log when suggestion changes
     mutable int64_t m_lastSuggestedTimeframe = 0;
@@ -155,8 +224,10 @@ private:
     
     // Configuration
     int64_t m_baseTimeframe_ms = 100;           // Snapshot interval
-    size_t m_maxHistorySlices = 5000;           // Keep 5000 slices per timeframe
-    double m_priceResolution = 1.0;             // $1 price buckets
+    size_t m_maxHistorySlices = 5000;           // Keep 5000 slices per timeframe...
+    size_t m_maxHistoryBytes = size_t{128} << 20;  // ...within 128 MB of slice storage per timeframe
+    double m_baseTickSize = 0.25;               // Storage grid: every preset bucket ($0.25 .. $25) is a whole multiple
+    double m_priceResolution = 1.0;             // $1 display buckets, derived from the base grid per read
     size_t m_depthLimit = 2000;                 //  PERFORMANCE FIX: Max bids/asks to process
     LiquidityDisplayMode m_displayMode = LiquidityDisplayMode::Average;
 
@@ -168,17 +239,35 @@ public:
     void addOrderBookSnapshot(const OrderBook& book, double minPrice, double maxPrice);
     // Dense ingestion path (Phase 1)
     void addDenseSnapshot(const LiveOrderBook::DenseBookSnapshotView& view);
+    // Pre-aggregated buckets from a LiveOrderBook bucket view; no per-level quantization when bucketSize == base tick
+    void addBucketedSnapshot(const LiveOrderBook::BucketSnapshotView& view);
+    // Pulled size attributed at full delta rate; folded into the slice containing timestamp_ms
+    void addPulledLiquidity(int64_t timestamp_ms, double price, bool isBid, double quantity);
     
-    // Query interface
+    // Query interface (raw pointers are borrowed until the engine's next write; hold getFinalizedSlices handles instead)
     const LiquidityTimeSlice* getTimeSlice(int64_t timeframe_ms, int64_t timestamp_ms) const;
-    std::vector<const LiquidityTimeSlice*> getVisibleSlices(int64_t timeframe_ms, 
-                                                           int64_t viewStart_ms, 
-                                                           int64_t viewEnd_ms) const;
+    // Shared handles to the finalized slices overlapping the window, oldest first; never change once returned
+    std::vector<LiquidityTimeSlicePtr> getFinalizedSlices(int64_t timeframe_ms, int64_t viewStart_ms, int64_t viewEnd_ms) const;
+    // The still-building slice for a timeframe (changes on every snapshot); nullptr before the first snapshot
+    const LiquidityTimeSlice* getCurrentSlice(int64_t timeframe_ms) const;
+    // Levels of that slice whose display values changed since the previous call (single consumer), as (tick, isBid).
+    // Returns false, out empty, when the caller has to re-read the whole slice: a new slice started or it changed grid.
+    bool takeCurrentSliceChanges(int64_t timeframe_ms, std::vector<std::pair<Tick, bool>>& out);
+    
+    // Checkpointing: visits each timeframe's newest finalized slices (oldest first, at most maxSlicesPerTimeframe),
+    // then a copy of its in-progress slice with isCurrent = true. Handles stay valid on any thread.
+    void visitSlices(size_t maxSlicesPerTimeframe,
+                     const std::function<void(int64_t timeframe_ms, const LiquidityTimeSlicePtr& slice, bool isCurrent)>& visitor) const;
+    // Appends a checkpointed slice to a timeframe's history; a slice that was in progress is finalized first.
+    // Returns false for unknown timeframes or slices not newer than the existing history.
+    bool restoreSlice(int64_t timeframe_ms, LiquidityTimeSlice slice, bool wasCurrent);
     
     // Timeframe management
     void addTimeframe(int64_t duration_ms);
     void removeTimeframe(int64_t duration_ms);
     std::vector<int64_t> getAvailableTimeframes() const;
+    // Timeframes with at least one finalized slice, finest first
+    std::vector<int64_t> getPopulatedTimeframes() const;
     
     //  OPTIMIZATION: Suggest optimal timeframe based on viewport size
     int64_t suggestTimeframe(int64_t viewStart_ms, int64_t viewEnd_ms, int maxSlices = 4000) const;
@@ -186,11 +275,18 @@ public:
     // Configuration
     void setDisplayMode(LiquidityDisplayMode mode);
     LiquidityDisplayMode getDisplayMode() const { return m_displayMode; }
-    void setPriceResolution(double resolution) { m_priceResolution = resolution; }
+    // Display resolution only: history is re-bucketed on read. A resolution finer than the base tick
+    // also lowers the base so slices built from then on can show it.
+    void setPriceResolution(double resolution);
     double getPriceResolution() const { return m_priceResolution; }
+    // Storage grid for new slices; in-progress slices move onto it, finalized history keeps its own tick
+    void setBaseTickSize(double tickSize);
+    double getBaseTickSize() const { return m_baseTickSize; }
+    // Per-timeframe budget for finalized slice storage; the newest slice is always kept
+    void setMaxHistoryBytes(size_t bytes);
+    size_t getHistoryBytes(int64_t timeframe_ms) const;
 
 signals:
-    void timeSliceReady(int64_t timeframe_ms, const LiquidityTimeSlice& slice);
     void displayModeChanged(LiquidityDisplayMode mode);
 
 private:
@@ -204,20 +300,26 @@ private:
                                 const LiquidityTimeSlice& slice);
     void updateDisappearingLevels(LiquidityTimeSlice& slice, const OrderBookSnapshot& snapshot);
     void finalizeLiquiditySlice(LiquidityTimeSlice& slice);
+    void rebaseSlice(LiquidityTimeSlice& slice, double tickSize) const;
+    // Write access to a finalized slice for late pulls: clones it first if a consumer still holds it
+    LiquidityTimeSlice& mutableSlice(LiquidityTimeSlicePtr& slice);
     
     // Timeframe management
     void rebuildTimeframe(int64_t timeframe_ms);
+    // Publishes a finalized slice to a timeframe's history, then trims that history to its slice and byte budgets
+    void appendFinalizedSlice(int64_t timeframe_ms, LiquidityTimeSlice&& slice);
+    void trimHistory(int64_t timeframe_ms);
     
     // Cleanup
     void cleanupOldData();
     
-    // Tick-based utilities
+    // Tick-based utilities (storage grid)
     Tick priceToTick(double price) const {
-        return static_cast<Tick>(std::round(price / m_priceResolution));
+        return static_cast<Tick>(std::round(price / m_baseTickSize));
     }
     
     double tickToPrice(Tick tick) const {
-        return static_cast<double>(tick) * m_priceResolution;
+        return static_cast<double>(tick) * m_baseTickSize;
     }
     
     // Legacy compatibility
@@ -0,0 +1,39 @@
+/*
+Sentinel — MarketImpactEngine
+Role: Implements per-symbol conflation and the two-sided ladder sweep.
+Inputs/Outputs: See MarketImpactEngine.h.
+Threading: Single-threaded; LiveOrderBook serializes its own reads.
+Performance: One book lock per publish; no per-update work beyond a hash lookup.
+Integration: See MarketImpactEngine.h.
+Observability: No internal logging.
+Related: MarketImpactEngine.h, DataCache.cpp (LiveOrderBook::estimateMarketImpact).
+Assumptions: Touch prices come from the book's maintained best indices, read under the same lock as the fills.
+*/
+#include "MarketImpactEngine.h"
+
+void MarketImpactEngine::onBookUpdated(const std::string& symbol) {
+    m_symbols[symbol].dirty = true;
+}
+
+bool MarketImpactEngine::poll(const std::string& symbol, const LiveOrderBook& book, int64_t now_ms, ImpactCurve& out) {
+    auto it = m_symbols.find(symbol);
+    if (it == m_symbols.end() || !it->second.dirty) return false;
+    if (book.isStale()) return false;  // Checkpointed levels; stays dirty until the live snapshot lands
+
+    SymbolState& state = it->second;
+    if (state.published && now_ms - state.lastPublish_ms < m_config.publishInterval_ms) return false;
+
+    compute(book, out);
+    state.dirty = false;
+    state.published = true;
+    state.lastPublish_ms = now_ms;
+    out.revision = ++state.revision;
+    return true;
+}
+
+void MarketImpactEngine::compute(const LiveOrderBook& book, ImpactCurve& out) const {
+    // One locked read: the touch and both ladders describe the same book state
+    const BookGrid grid = book.estimateMarketImpact(m_config.notionalLadder, out.buys, out.sells);
+    out.bestBid = grid.bestBidIndex == BookGrid::kNoLevel ? 0.0 : grid.priceAt(grid.bestBidIndex);
+    out.bestAsk = grid.bestAskIndex == BookGrid::kNoLevel ? 0.0 : grid.priceAt(grid.bestAskIndex);
+}
@@ -0,0 +1,64 @@
+/*
+Sentinel — MarketImpactEngine
+Role: Turns a live book into a "cost to trade X" ladder: VWAP, worst level and slippage for market buys and sells per notional size.
+Inputs/Outputs: Takes book-change notifications per symbol and the symbol's LiveOrderBook; produces conflated ImpactCurves.
+Threading: Not thread-safe; owned and polled by one thread (OrderBookDock on the GUI thread). Book reads lock the book itself.
+Performance: Book changes only mark a flag; a publish is O(ladder · log ticks) through the book's notional/quantity Fenwick trees.
+Integration: OrderBookDock marks symbols dirty from liveOrderBookUpdated and polls at display rate.
+Observability: No internal logging.
+Related: MarketImpactEngine.cpp, TradeData.h (LiveOrderBook::estimateMarketImpact, MarketFill), FenwickTree.h.
+Assumptions: Fills sweep resting size only (no hidden liquidity, fees or latency); partial fills report filledNotional < requested.
+*/
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "marketdata/model/TradeData.h"
+
+struct ImpactCurve {
+    double bestBid = 0.0;            // 0 when the side is empty
+    double bestAsk = 0.0;
+    std::vector<MarketFill> buys;    // One per ladder rung, ascending notional
+    std::vector<MarketFill> sells;
+    uint64_t revision = 0;           // Bumped per publish for the symbol
+};
+
+class MarketImpactEngine {
+public:
+    struct Config {
+        std::vector<double> notionalLadder = {10'000.0, 50'000.0, 100'000.0, 500'000.0, 1'000'000.0};
+        int64_t publishInterval_ms = 100;  // Minimum spacing between publishes per symbol
+    };
+
+    MarketImpactEngine() = default;
+    explicit MarketImpactEngine(Config config) : m_config(std::move(config)) {}
+
+    // O(1): records that the symbol's book changed since its last publish
+    void onBookUpdated(const std::string& symbol);
+
+    // Recomputes when the book changed and publishInterval_ms has passed since the last publish; false otherwise,
+    // including while the book is stale (restored from a checkpoint)
+    bool poll(const std::string& symbol, const LiveOrderBook& book, int64_t now_ms, ImpactCurve& out);
+
+    // Unconditional sweep of both sides over the ladder (revision is left untouched)
+    void compute(const LiveOrderBook& book, ImpactCurve& out) const;
+
+    const std::vector<double>& notionalLadder() const { return m_config.notionalLadder; }
+    int64_t publishInterval() const { return m_config.publishInterval_ms; }
+
+    void forget(const std::string& symbol) { m_symbols.erase(symbol); }
+
+private:
+    struct SymbolState {
+        bool dirty = false;
+        bool published = false;
+        int64_t lastPublish_ms = 0;
+        uint64_t revision = 0;
+    };
+
+    Config m_config;
+    std::unordered_map<std::string, SymbolState> m_symbols;
+};
@@ -0,0 +1,104 @@
+/*
+Sentinel — OccupancyBitset
+Role: Fixed-size set of populated slots with next/previous-set search that skips empty 64-slot words.
+Inputs/Outputs: Takes set/reset per slot; answers the nearest populated slot at or after / strictly before a position.
+Threading: Not thread-safe; the owner serializes access (LiveOrderBook does so under its book mutex).
+Performance: One bit per slot plus one summary bit per word; searches touch O(distance / 4096) summary words.
+Integration: Lets LiveOrderBook find the next best level when the touch empties without walking the dense grid.
+Observability: No internal logging.
+Related: TradeData.h (LiveOrderBook), DataCache.cpp, FenwickTree.h.
+Assumptions: Positions passed to set()/reset() are below size().
+*/
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class OccupancyBitset {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    OccupancyBitset() = default;
+    explicit OccupancyBitset(size_t size) { assign(size); }
+
+    // Resets to size empty slots
+    void assign(size_t size) {
+        m_size = size;
+        m_words.assign((size + 63) / 64, 0);
+        m_summary.assign((m_words.size() + 63) / 64, 0);
+    }
+
+    size_t size() const { return m_size; }
+
+    bool test(size_t index) const { return (m_words[index >> 6] >> (index & 63)) & 1; }
+
+    void set(size_t index) {
+        const size_t word = index >> 6;
+        m_words[word] |= bit(index);
+        m_summary[word >> 6] |= bit(word);
+    }
+
+    void reset(size_t index) {
+        const size_t word = index >> 6;
+        m_words[word] &= ~bit(index);
+        if (m_words[word] == 0) m_summary[word >> 6] &= ~bit(word);
+    }
+
+    // First populated slot >= from; npos when there is none
+    size_t nextSet(size_t from) const {
+        if (from >= m_size) return npos;
+        size_t word = from >> 6;
+        if (const uint64_t bits = m_words[word] & (~uint64_t{0} << (from & 63))) {
+            return (word << 6) + std::countr_zero(bits);
+        }
+        word = nextWord(word + 1);
+        return word == npos ? npos : (word << 6) + std::countr_zero(m_words[word]);
+    }
+
+    // Last populated slot < before; npos when there is none
+    size_t prevSet(size_t before) const {
+        if (before == 0 || m_size == 0) return npos;
+        const size_t last = (before < m_size ? before : m_size) - 1;
+        size_t word = last >> 6;
+        if (const uint64_t bits = m_words[word] & upTo(last)) {
+            return (word << 6) + 63 - std::countl_zero(bits);
+        }
+        if (word == 0) return npos;
+        word = prevWord(word - 1);
+        return word == npos ? npos : (word << 6) + 63 - std::countl_zero(m_words[word]);
+    }
+
+private:
+    static uint64_t bit(size_t index) { return uint64_t{1} << (index & 63); }
+    // Bits 0..(index & 63) inclusive
+    static uint64_t upTo(size_t index) { return ~uint64_t{0} >> (63 - (index & 63)); }
+
+    // First non-empty word >= from
+    size_t nextWord(size_t from) const {
+        if (from >= m_words.size()) return npos;
+        size_t group = from >> 6;
+        uint64_t bits = m_summary[group] & (~uint64_t{0} << (from & 63));
+        while (bits == 0) {
+            if (++group >= m_summary.size()) return npos;
+            bits = m_summary[group];
+        }
+        return (group << 6) + std::countr_zero(bits);
+    }
+
+    // Last non-empty word <= from
+    size_t prevWord(size_t from) const {
+        size_t group = from >> 6;
+        uint64_t bits = m_summary[group] & upTo(from);
+        while (bits == 0) {
+            if (group == 0) return npos;
+            bits = m_summary[--group];
+        }
+        return (group << 6) + 63 - std::countl_zero(bits);
+    }
+
+    size_t m_size = 0;
+    std::vector<uint64_t> m_words;    // Bit i of word w: slot w * 64 + i is populated
+    std::vector<uint64_t> m_summary;  // Bit i of group g: word g * 64 + i is non-zero
+};
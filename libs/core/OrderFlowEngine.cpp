@@ -0,0 +1,130 @@
+/*
+Sentinel — OrderFlowEngine
+Role: Implements per-symbol, per-timeframe order-flow ring updates and range queries.
+Inputs/Outputs: Folds each trade/top-of-book event into the newest bar of every timeframe ring.
+Threading: All public methods take m_mutex; critical sections are a handful of arithmetic ops.
+Performance: Bars are recycled in place by TimeBarRing; range queries binary-search the time-ordered ring.
+Integration: See OrderFlowEngine.h.
+Observability: sLog_App on first event for a new symbol.
+Related: OrderFlowEngine.h.
+Assumptions: Timeframes are positive and fixed for the engine's lifetime.
+*/
+#include "OrderFlowEngine.h"
+#include "SentinelLogging.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+OrderFlowEngine::OrderFlowEngine(std::vector<int64_t> timeframes, size_t barsPerTimeframe)
+    : m_timeframes(std::move(timeframes))
+    , m_capacity(std::max<size_t>(barsPerTimeframe, 1)) {
+    TimeBars::normalize(m_timeframes);
+}
+
+OrderFlowBar& OrderFlowEngine::barFor(BarRing& ring, int64_t timestamp_ms, double cvd) {
+    const size_t slot = ring.barFor(timestamp_ms, [&](OrderFlowBar& bar, const OrderFlowBar* previous) {
+        const double carriedImbalance = previous ? previous->bookImbalance : 0.0;
+        bar = OrderFlowBar{};
+        bar.duration_ms = ring.timeframe_ms;
+        bar.cvdOpen = cvd;
+        bar.cvdClose = cvd;
+        bar.bookImbalance = carriedImbalance;
+    });
+    return ring.bars[slot];
+}
+
+OrderFlowEngine::SymbolState& OrderFlowEngine::stateFor(const std::string& symbol) {
+    auto it = m_symbols.find(symbol);
+    if (it != m_symbols.end()) return it->second;
+
+    SymbolState state;
+    state.rings.resize(m_timeframes.size());
+    for (size_t i = 0; i < m_timeframes.size(); ++i) {
+        state.rings[i].reset(m_timeframes[i], m_capacity);
+    }
+    sLog_App("OrderFlowEngine: tracking" << QString::fromStdString(symbol)
+             << "timeframes:" << m_timeframes.size() << "bars/timeframe:" << m_capacity);
+    return m_symbols.emplace(symbol, std::move(state)).first->second;
+}
+
+const OrderFlowEngine::SymbolState* OrderFlowEngine::findState(const std::string& symbol) const {
+    auto it = m_symbols.find(symbol);
+    return it != m_symbols.end() ? &it->second : nullptr;
+}
+
+void OrderFlowEngine::onTrade(const Trade& trade) {
+    if (trade.product_id.empty() || trade.size <= 0.0) return;
+
+    const int64_t ts = std::chrono::duration_cast<std::chrono::milliseconds>(
+        trade.timestamp.time_since_epoch()).count();
+    const bool isBuy = trade.side == AggressorSide::Buy;
+    const bool isSell = trade.side == AggressorSide::Sell;
+    if (!isBuy && !isSell) return;  // Unknown aggressor carries no delta
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    SymbolState& state = stateFor(trade.product_id);
+
+    const double cvdBefore = state.cvd;
+    state.cvd += isBuy ? trade.size : -trade.size;
+
+    for (auto& ring : state.rings) {
+        OrderFlowBar& bar = barFor(ring, ts, cvdBefore);
+        if (isBuy) {
+            bar.buyVolume += trade.size;
+            ++bar.buyCount;
+        } else {
+            bar.sellVolume += trade.size;
+            ++bar.sellCount;
+        }
+        bar.cvdClose = state.cvd;
+    }
+}
+
+void OrderFlowEngine::onTopOfBook(const std::string& symbol, int64_t timestamp_ms,
+                                  double bestBidQty, double bestAskQty) {
+    const double total = bestBidQty + bestAskQty;
+    if (symbol.empty() || total <= 0.0) return;
+
+    const double imbalance = (bestBidQty - bestAskQty) / total;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    SymbolState& state = stateFor(symbol);
+
+    for (auto& ring : state.rings) {
+        OrderFlowBar& bar = barFor(ring, timestamp_ms, state.cvd);
+        bar.bookImbalance = imbalance;
+        bar.bookImbalanceSum += imbalance;
+        ++bar.bookSamples;
+    }
+}
+
+void OrderFlowEngine::copyBars(const std::string& symbol, int64_t timeframe_ms,
+                               int64_t start_ms, int64_t end_ms,
+                               std::vector<OrderFlowBar>& out) const {
+    out.clear();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const SymbolState* state = findState(symbol);
+    if (!state) return;
+
+    const size_t tf = TimeBars::indexOf(m_timeframes, timeframe_ms);
+    if (tf == TimeBars::npos) return;
+    const BarRing& ring = state->rings[tf];
+
+    for (size_t i = ring.firstEndingAfter(start_ms); i < ring.count; ++i) {
+        const OrderFlowBar& bar = ring.at(i);
+        if (bar.startTime_ms > end_ms) break;
+        out.push_back(bar);
+    }
+}
+
+double OrderFlowEngine::getCumulativeDelta(const std::string& symbol) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const SymbolState* state = findState(symbol);
+    return state ? state->cvd : 0.0;
+}
+
+void OrderFlowEngine::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_symbols.clear();
+}
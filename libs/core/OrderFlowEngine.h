@@ -0,0 +1,92 @@
+/*
+Sentinel — OrderFlowEngine
+Role: Streaming order-flow analytics: CVD, buy/sell volume, trade-count and top-of-book imbalance.
+Inputs/Outputs: Takes trades and top-of-book quantities per symbol; produces per-timeframe OrderFlowBar rings.
+Threading: Thread-safe; writers (DataProcessor worker) and readers (render thread) share one std::mutex.
+Performance: O(1) per event; every symbol's rings are preallocated on first sight, no per-event allocation.
+Integration: Owned by DataProcessor; bars are copied into GridSliceBatch for OrderFlowOverlayStrategy.
+Observability: Logs new symbol registration via sLog_App.
+Related: OrderFlowEngine.cpp, TimeBarRing.h, DataProcessor.hpp, OrderFlowOverlayStrategy.hpp, TradeData.h.
+Assumptions: Events arrive roughly in time order; late events fold into the newest bar.
+*/
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "TimeBarRing.h"
+#include "marketdata/model/TradeData.h"
+
+// Order-flow aggregate for one time bucket
+struct OrderFlowBar {
+    int64_t startTime_ms = 0;
+    int64_t duration_ms = 0;
+
+    double buyVolume = 0.0;     // Aggressive buy (lifted offer) volume
+    double sellVolume = 0.0;    // Aggressive sell (hit bid) volume
+    uint32_t buyCount = 0;
+    uint32_t sellCount = 0;
+
+    double cvdOpen = 0.0;       // Cumulative volume delta at bar open
+    double cvdClose = 0.0;      // Cumulative volume delta at last event
+
+    double bookImbalance = 0.0;     // Last top-of-book imbalance in [-1, 1]
+    double bookImbalanceSum = 0.0;  // For the per-bar average
+    uint32_t bookSamples = 0;
+
+    double delta() const { return buyVolume - sellVolume; }
+    double totalVolume() const { return buyVolume + sellVolume; }
+
+    // (buys - sells) / trades in [-1, 1]
+    double tradeCountImbalance() const {
+        const uint32_t n = buyCount + sellCount;
+        return n > 0 ? (static_cast<double>(buyCount) - static_cast<double>(sellCount)) / n : 0.0;
+    }
+
+    double avgBookImbalance() const {
+        return bookSamples > 0 ? bookImbalanceSum / bookSamples : bookImbalance;
+    }
+};
+
+class OrderFlowEngine {
+public:
+    explicit OrderFlowEngine(std::vector<int64_t> timeframes = {100, 250, 500, 1000, 2000, 5000, 10000},
+                             size_t barsPerTimeframe = 2048);
+
+    // Event ingestion (O(1))
+    void onTrade(const Trade& trade);
+    void onTopOfBook(const std::string& symbol, int64_t timestamp_ms, double bestBidQty, double bestAskQty);
+
+    // Query interface - copies bars overlapping [start, end] oldest → newest
+    void copyBars(const std::string& symbol, int64_t timeframe_ms,
+                  int64_t start_ms, int64_t end_ms,
+                  std::vector<OrderFlowBar>& out) const;
+    double getCumulativeDelta(const std::string& symbol) const;
+
+    const std::vector<int64_t>& getTimeframes() const { return m_timeframes; }
+    int64_t nearestTimeframe(int64_t timeframe_ms) const { return TimeBars::nearest(m_timeframes, timeframe_ms); }
+    size_t getCapacity() const { return m_capacity; }
+
+    void clear();
+
+private:
+    // Fixed-capacity ring of bars for one (symbol, timeframe)
+    using BarRing = TimeBarRing<OrderFlowBar>;
+    static OrderFlowBar& barFor(BarRing& ring, int64_t timestamp_ms, double cvd);
+
+    struct SymbolState {
+        double cvd = 0.0;
+        std::vector<BarRing> rings;  // One per timeframe, same order as m_timeframes
+    };
+
+    SymbolState& stateFor(const std::string& symbol);
+    const SymbolState* findState(const std::string& symbol) const;
+
+    std::vector<int64_t> m_timeframes;
+    size_t m_capacity;
+
+    std::unordered_map<std::string, SymbolState> m_symbols;
+    mutable std::mutex m_mutex;
+};
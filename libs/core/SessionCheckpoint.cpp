@@ -0,0 +1,433 @@
+/*
+Sentinel — SessionCheckpoint
+Role: Implements the checkpoint file format: header + length-prefixed records (book, trades, slice).
+Inputs/Outputs: See SessionCheckpoint.h.
+Threading: See SessionCheckpoint.h.
+Performance: Records are encoded into one buffer and written once; restore parses the mapped file in place.
+Integration: See SessionCheckpoint.h.
+Observability: sLog_App summary per write/restore; sLog_Warning on rejected files.
+Related: SessionCheckpoint.h, DataCache.cpp, LiquidityTimeSeriesEngine.cpp.
+Assumptions: Little-endian hosts (the file is a cache, not an interchange format); unknown record kinds are skipped.
+*/
+#include "SessionCheckpoint.h"
+#include "LiquidityTimeSeriesEngine.h"
+#include "marketdata/cache/DataCache.hpp"
+#include "SentinelLogging.hpp"
+#include <QElapsedTimer>
+#include <QFile>
+#include <QSaveFile>
+#include <QString>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    constexpr char kMagic[8] = {'S', 'N', 'T', 'L', 'C', 'K', 'P', 'T'};
+
+    enum class RecordKind : uint32_t { Book = 1, Trades = 2, Slice = 3 };
+
+    // A slice wider than this is corrupt: its metrics are dense, so the width alone would size the allocation
+    constexpr size_t kMaxSliceTicks = size_t{1} << 22;
+    // Same bound for a book grid; a full-depth BTC book at $0.01 is ~5M ticks
+    constexpr size_t kMaxBookLevels = size_t{1} << 24;
+
+    int64_t toMs(std::chrono::system_clock::time_point t) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(t.time_since_epoch()).count();
+    }
+    std::chrono::system_clock::time_point fromMs(int64_t ms) {
+        return std::chrono::system_clock::time_point(std::chrono::milliseconds(ms));
+    }
+
+    class Writer {
+    public:
+        template <typename T>
+        void put(T value) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            const auto* p = reinterpret_cast<const char*>(&value);
+            m_buffer.insert(m_buffer.end(), p, p + sizeof(T));
+        }
+        void putString(const std::string& s) {
+            put(static_cast<uint32_t>(s.size()));
+            m_buffer.insert(m_buffer.end(), s.begin(), s.end());
+        }
+        // Records are length-prefixed so readers can skip kinds they do not know
+        size_t beginRecord(RecordKind kind) {
+            put(static_cast<uint32_t>(kind));
+            const size_t lengthAt = m_buffer.size();
+            put(uint64_t{0});
+            return lengthAt;
+        }
+        void endRecord(size_t lengthAt) {
+            const uint64_t length = m_buffer.size() - lengthAt - sizeof(uint64_t);
+            std::memcpy(m_buffer.data() + lengthAt, &length, sizeof(length));
+        }
+        const std::vector<char>& buffer() const { return m_buffer; }
+
+    private:
+        std::vector<char> m_buffer;
+    };
+
+    class Reader {
+    public:
+        Reader(const uchar* data, size_t size) : m_data(data), m_size(size) {}
+
+        template <typename T>
+        bool get(T& value) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            if (m_size - m_pos < sizeof(T)) return false;
+            std::memcpy(&value, m_data + m_pos, sizeof(T));
+            m_pos += sizeof(T);
+            return true;
+        }
+        bool getString(std::string& s) {
+            uint32_t length = 0;
+            if (!get(length) || m_size - m_pos < length) return false;
+            s.assign(reinterpret_cast<const char*>(m_data + m_pos), length);
+            m_pos += length;
+            return true;
+        }
+        bool skip(size_t bytes) {
+            if (m_size - m_pos < bytes) return false;
+            m_pos += bytes;
+            return true;
+        }
+        size_t position() const { return m_pos; }
+        size_t remaining() const { return m_size - m_pos; }
+        bool atEnd() const { return m_pos == m_size; }
+
+    private:
+        const uchar* m_data;
+        size_t m_size;
+        size_t m_pos = 0;
+    };
+
+    // Populated slice level; float payload is plenty for display values
+    struct PackedLevel {
+        uint32_t offset;           // tick - minTick
+        int32_t snapshotCount;
+        float total, avg, max, min, resting, pulled;
+        int32_t firstSeenRel_ms;   // Relative to slice start
+        int32_t lastSeenRel_ms;
+    };
+    static_assert(std::is_trivially_copyable_v<PackedLevel>);
+
+    void writeSlice(Writer& out, int64_t timeframe_ms, const LiquidityTimeSlice& slice, bool isCurrent) {
+        const size_t record = out.beginRecord(RecordKind::Slice);
+        out.put(timeframe_ms);
+        out.put(static_cast<uint8_t>(isCurrent));
+        out.put(slice.startTime_ms);
+        out.put(slice.endTime_ms);
+        out.put(slice.duration_ms);
+        out.put(slice.minTick);
+        out.put(slice.maxTick);
+        out.put(slice.tickSize);
+        for (const auto* side : {&slice.bidMetrics, &slice.askMetrics}) {
+            uint32_t populated = 0;
+            for (const auto& m : *side) populated += m.snapshotCount > 0 ? 1 : 0;
+            out.put(populated);
+            for (size_t i = 0; i < side->size(); ++i) {
+                const auto& m = (*side)[i];
+                if (m.snapshotCount <= 0) continue;
+                out.put(PackedLevel{static_cast<uint32_t>(i), m.snapshotCount,
+                                    static_cast<float>(m.totalLiquidity), static_cast<float>(m.avgLiquidity),
+                                    static_cast<float>(m.maxLiquidity), static_cast<float>(m.minLiquidity),
+                                    static_cast<float>(m.restingLiquidity), static_cast<float>(m.pulledLiquidity),
+                                    static_cast<int32_t>(m.firstSeen_ms - slice.startTime_ms),
+                                    static_cast<int32_t>(m.lastSeen_ms - slice.startTime_ms)});
+            }
+        }
+        out.endRecord(record);
+    }
+
+    bool readSlice(Reader& in, int64_t& timeframe_ms, bool& isCurrent, LiquidityTimeSlice& slice) {
+        uint8_t current = 0;
+        if (!in.get(timeframe_ms) || !in.get(current) || !in.get(slice.startTime_ms) || !in.get(slice.endTime_ms) ||
+            !in.get(slice.duration_ms) || !in.get(slice.minTick) || !in.get(slice.maxTick) || !in.get(slice.tickSize)) {
+            return false;
+        }
+        isCurrent = current != 0;
+        if (slice.maxTick < slice.minTick ||
+            static_cast<uint64_t>(slice.maxTick) - static_cast<uint64_t>(slice.minTick) >= kMaxSliceTicks) {
+            return false;
+        }
+        const size_t width = static_cast<size_t>(slice.maxTick - slice.minTick) + 1;
+        for (auto* side : {&slice.bidMetrics, &slice.askMetrics}) {
+            uint32_t populated = 0;
+            if (!in.get(populated) || populated > width ||
+                static_cast<uint64_t>(populated) * sizeof(PackedLevel) > in.remaining()) {
+                return false;
+            }
+            side->assign(populated > 0 ? width : 0, LiquidityTimeSlice::PriceLevelMetrics{});
+            for (uint32_t i = 0; i < populated; ++i) {
+                PackedLevel p{};
+                if (!in.get(p) || p.offset >= width) return false;
+                auto& m = (*side)[p.offset];
+                m.snapshotCount = p.snapshotCount;
+                m.totalLiquidity = p.total;
+                m.avgLiquidity = p.avg;
+                m.maxLiquidity = p.max;
+                m.minLiquidity = p.min;
+                m.restingLiquidity = p.resting;
+                m.pulledLiquidity = p.pulled;
+                m.firstSeen_ms = slice.startTime_ms + p.firstSeenRel_ms;
+                m.lastSeen_ms = slice.startTime_ms + p.lastSeenRel_ms;
+            }
+        }
+        return true;
+    }
+}
+
+SessionCheckpoint::Snapshot SessionCheckpoint::capture(const DataCache& cache, const LiquidityTimeSeriesEngine* engine,
+                                                       const Options& options) {
+    Snapshot snapshot;
+    snapshot.createdAt_ms = toMs(std::chrono::system_clock::now());
+
+    std::vector<std::pair<uint32_t, double>> bidBuf;
+    std::vector<std::pair<uint32_t, double>> askBuf;
+    for (const auto& symbol : cache.liveBookSymbols()) {
+        const LiveOrderBook& book = cache.getDirectLiveOrderBook(symbol);
+        const auto view = book.captureDenseNonZero(bidBuf, askBuf, options.maxLevelsPerSide);
+        if (view.bidLevels.empty() && view.askLevels.empty()) continue;
+        // Geometry from the same locked capture as the indices; the book may regrid between separate reads
+        snapshot.books.push_back({symbol, view.minPrice, view.maxPrice, view.tickSize,
+                                  toMs(view.timestamp),
+                                  {view.bidLevels.begin(), view.bidLevels.end()},
+                                  {view.askLevels.begin(), view.askLevels.end()}});
+    }
+
+    for (const auto& symbol : cache.tradeSymbols()) {
+        auto trades = cache.recentTrades(symbol);
+        if (trades.empty()) continue;
+        // The ring snapshot is in slot order; restore replays in time order
+        std::stable_sort(trades.begin(), trades.end(),
+                         [](const Trade& a, const Trade& b) { return a.timestamp < b.timestamp; });
+        snapshot.trades.push_back(std::move(trades));
+    }
+
+    if (engine) {
+        const int64_t cutoff = snapshot.createdAt_ms - options.historyWindow_ms;
+        engine->visitSlices(options.maxSlicesPerTimeframe,
+                            [&](int64_t timeframe_ms, const LiquidityTimeSlicePtr& slice, bool isCurrent) {
+            if (slice->endTime_ms < cutoff) return;
+            snapshot.slices.push_back({timeframe_ms, slice, isCurrent});
+        });
+    }
+    return snapshot;
+}
+
+SessionCheckpoint::Result SessionCheckpoint::write(const std::string& path, const DataCache& cache,
+                                                   const LiquidityTimeSeriesEngine* engine, const Options& options) {
+    return write(path, capture(cache, engine, options));
+}
+
+SessionCheckpoint::Result SessionCheckpoint::write(const std::string& path, const Snapshot& snapshot) {
+    QElapsedTimer timer;
+    timer.start();
+    Result result;
+    result.createdAt_ms = snapshot.createdAt_ms;
+
+    Writer out;
+    for (char c : kMagic) out.put(c);
+    out.put(kFormatVersion);
+    out.put(uint32_t{0});
+    out.put(result.createdAt_ms);
+
+    for (const auto& book : snapshot.books) {
+        const size_t record = out.beginRecord(RecordKind::Book);
+        out.putString(book.symbol);
+        out.put(book.minPrice);
+        out.put(book.maxPrice);
+        out.put(book.tickSize);
+        out.put(book.timestamp_ms);
+        out.put(static_cast<uint32_t>(book.bids.size()));
+        out.put(static_cast<uint32_t>(book.asks.size()));
+        for (const auto& [idx, qty] : book.bids) { out.put(idx); out.put(qty); }
+        for (const auto& [idx, qty] : book.asks) { out.put(idx); out.put(qty); }
+        out.endRecord(record);
+        ++result.books;
+    }
+
+    for (const auto& trades : snapshot.trades) {
+        const size_t record = out.beginRecord(RecordKind::Trades);
+        out.putString(trades.front().product_id);
+        out.put(static_cast<uint32_t>(trades.size()));
+        for (const auto& t : trades) {
+            out.put(toMs(t.timestamp));
+            out.put(t.price);
+            out.put(t.size);
+            out.put(static_cast<uint8_t>(t.side));
+            out.putString(t.trade_id);
+        }
+        out.endRecord(record);
+        result.trades += trades.size();
+    }
+
+    for (const auto& entry : snapshot.slices) {
+        writeSlice(out, entry.timeframe_ms, *entry.slice, entry.isCurrent);
+        ++result.slices;
+    }
+
+    QSaveFile file(QString::fromStdString(path));
+    if (!file.open(QIODevice::WriteOnly)) {
+        sLog_Warning("SessionCheckpoint: cannot write" << QString::fromStdString(path) << file.errorString());
+        return result;
+    }
+    const auto& buffer = out.buffer();
+    if (file.write(buffer.data(), static_cast<qint64>(buffer.size())) != static_cast<qint64>(buffer.size()) ||
+        !file.commit()) {
+        sLog_Warning("SessionCheckpoint: write failed for" << QString::fromStdString(path) << file.errorString());
+        return result;
+    }
+
+    result.ok = true;
+    result.bytes = buffer.size();
+    sLog_App("SessionCheckpoint: wrote" << result.books << "books," << result.trades << "trades,"
+             << result.slices << "slices (" << result.bytes / 1024 << "KiB) in" << timer.elapsed() << "ms");
+    return result;
+}
+
+SessionCheckpoint::Result SessionCheckpoint::restore(const std::string& path, DataCache& cache,
+                                                     LiquidityTimeSeriesEngine* engine, const Options& options) {
+    QElapsedTimer timer;
+    timer.start();
+    Result result;
+
+    QFile file(QString::fromStdString(path));
+    if (!file.exists()) return result;
+    if (!file.open(QIODevice::ReadOnly) || file.size() <= 0) {
+        sLog_Warning("SessionCheckpoint: cannot open" << QString::fromStdString(path));
+        return result;
+    }
+    const size_t size = static_cast<size_t>(file.size());
+    const uchar* data = file.map(0, file.size());
+    if (!data) {
+        sLog_Warning("SessionCheckpoint: cannot map" << QString::fromStdString(path));
+        return result;
+    }
+
+    // Parse everything before touching the cache/engine so a corrupt tail changes nothing
+    struct BookRecord {
+        std::string symbol;
+        double minPrice = 0.0, maxPrice = 0.0, tickSize = 0.0;
+        int64_t timestamp_ms = 0;
+        std::vector<BookLevelUpdate> levels;
+    };
+    struct SliceRecord {
+        int64_t timeframe_ms = 0;
+        bool isCurrent = false;
+        LiquidityTimeSlice slice;
+    };
+    std::vector<BookRecord> books;
+    std::vector<Trade> trades;
+    std::vector<SliceRecord> slices;
+
+    Reader in(data, size);
+    char magic[8] = {};
+    uint32_t version = 0;
+    uint32_t reserved = 0;
+    bool valid = true;
+    for (char& c : magic) valid = valid && in.get(c);
+    valid = valid && std::memcmp(magic, kMagic, sizeof(kMagic)) == 0 && in.get(version) && version == kFormatVersion &&
+            in.get(reserved) && in.get(result.createdAt_ms);
+
+    while (valid && !in.atEnd()) {
+        uint32_t kind = 0;
+        uint64_t length = 0;
+        if (!in.get(kind) || !in.get(length)) { valid = false; break; }
+        const size_t recordEnd = in.position() + static_cast<size_t>(length);
+        if (length > size - in.position()) { valid = false; break; }
+
+        if (kind == static_cast<uint32_t>(RecordKind::Book)) {
+            BookRecord book;
+            uint32_t bidCount = 0, askCount = 0;
+            valid = in.getString(book.symbol) && in.get(book.minPrice) && in.get(book.maxPrice) &&
+                    in.get(book.tickSize) && in.get(book.timestamp_ms) && in.get(bidCount) && in.get(askCount);
+            const uint64_t levelCount = uint64_t{bidCount} + askCount;
+            valid = valid && levelCount * (sizeof(uint32_t) + sizeof(double)) <= in.remaining();
+            // The restored book is sized from this geometry, so a corrupt grid drops the record (the rest of
+            // the file is still well-formed and the remaining bytes are skipped below)
+            const double gridLevels = (book.maxPrice - book.minPrice) / book.tickSize + 1.0;
+            bool inGrid = valid && std::isfinite(book.minPrice) && std::isfinite(book.maxPrice) &&
+                          std::isfinite(book.tickSize) && book.tickSize > 0.0 && book.maxPrice > book.minPrice &&
+                          gridLevels <= static_cast<double>(kMaxBookLevels);
+            if (inGrid) book.levels.reserve(static_cast<size_t>(levelCount));
+            for (uint64_t i = 0; inGrid && i < levelCount; ++i) {
+                uint32_t idx = 0;
+                double qty = 0.0;
+                valid = in.get(idx) && in.get(qty);
+                inGrid = valid && idx < static_cast<uint64_t>(gridLevels);
+                book.levels.push_back(BookLevelUpdate{i < bidCount, book.minPrice + idx * book.tickSize, qty});
+            }
+            if (inGrid) {
+                books.push_back(std::move(book));
+            } else if (valid) {
+                sLog_Warning("SessionCheckpoint: dropping book record with a corrupt grid for"
+                             << QString::fromStdString(book.symbol));
+            }
+        } else if (kind == static_cast<uint32_t>(RecordKind::Trades)) {
+            std::string symbol;
+            uint32_t count = 0;
+            valid = in.getString(symbol) && in.get(count);
+            for (uint32_t i = 0; valid && i < count; ++i) {
+                Trade t;
+                int64_t ts = 0;
+                uint8_t side = 0;
+                valid = in.get(ts) && in.get(t.price) && in.get(t.size) && in.get(side) && in.getString(t.trade_id);
+                t.timestamp = fromMs(ts);
+                t.product_id = symbol;
+                t.side = side <= static_cast<uint8_t>(AggressorSide::Unknown) ? static_cast<AggressorSide>(side)
+                                                                              : AggressorSide::Unknown;
+                trades.push_back(std::move(t));
+            }
+        } else if (kind == static_cast<uint32_t>(RecordKind::Slice)) {
+            SliceRecord record;
+            valid = readSlice(in, record.timeframe_ms, record.isCurrent, record.slice);
+            if (valid) slices.push_back(std::move(record));
+        }
+        // Every record must end exactly where its length says; unknown kinds are skipped
+        valid = valid && in.position() <= recordEnd && in.skip(recordEnd - in.position());
+    }
+    file.unmap(const_cast<uchar*>(data));
+
+    if (!valid) {
+        sLog_Warning("SessionCheckpoint: ignoring invalid or truncated checkpoint" << QString::fromStdString(path));
+        return result;
+    }
+
+    const int64_t now_ms = toMs(std::chrono::system_clock::now());
+    for (const auto& book : books) {
+        if (!options.restoreBooks || now_ms - book.timestamp_ms > options.maxBookAge_ms) continue;
+        if (cache.restoreLiveOrderBook(book.symbol, book.minPrice, book.maxPrice, book.tickSize,
+                                       book.levels, fromMs(book.timestamp_ms))) {
+            ++result.books;
+        }
+    }
+
+    // Decided once per symbol: a symbol whose live trades are already flowing keeps them
+    std::unordered_map<std::string, bool> restoreTrades;
+    for (const auto& t : trades) {
+        auto [it, inserted] = restoreTrades.try_emplace(t.product_id, false);
+        if (inserted) it->second = cache.recentTrades(t.product_id).empty();
+        if (!it->second) continue;
+        cache.addTrade(t);
+        ++result.trades;
+    }
+
+    if (engine) {
+        for (auto& record : slices) {
+            if (engine->restoreSlice(record.timeframe_ms, std::move(record.slice), record.isCurrent)) {
+                ++result.slices;
+            }
+        }
+    }
+
+    result.ok = true;
+    result.bytes = size;
+    sLog_App("SessionCheckpoint: restored" << result.books << "books," << result.trades << "trades,"
+             << result.slices << "slices from a checkpoint" << (now_ms - result.createdAt_ms) / 1000
+             << "s old in" << timer.elapsed() << "ms");
+    return result;
+}
@@ -0,0 +1,79 @@
+/*
+Sentinel — SessionCheckpoint
+Role: Saves and restores warm-start state (live books, recent trades, heatmap slices) as one compact binary file.
+Inputs/Outputs: DataCache + LiquidityTimeSeriesEngine → checkpoint file; checkpoint file → DataCache + LiquidityTimeSeriesEngine.
+Threading: capture() and restore() run on the thread that owns the LiquidityTimeSeriesEngine (DataProcessor);
+           write(path, Snapshot) runs on any thread. DataCache access uses its own locks.
+Performance: capture copies book levels and takes shared slice handles; encoding and I/O happen in write.
+             Sparse encoding (non-zero book levels, populated slice levels as float32); restore reads through a memory map.
+Integration: DataProcessor captures periodically and on stop and writes on a worker; it restores once before live data starts.
+Observability: Logs counts, size and elapsed time of each write/restore via sLog_App; corrupt files are logged and ignored.
+Related: SessionCheckpoint.cpp, DataCache.hpp, LiquidityTimeSeriesEngine.h, DataProcessor.hpp.
+Assumptions: A live snapshot always wins: restored books (opt-in) stay stale until the next snapshot replaces them,
+             and restored slices never overwrite time already covered by live data.
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "marketdata/model/TradeData.h"
+
+class DataCache;
+class LiquidityTimeSeriesEngine;
+struct LiquidityTimeSlice;
+
+class SessionCheckpoint {
+public:
+    struct Options {
+        size_t maxLevelsPerSide = 5000;          // Book levels kept per side, best first
+        size_t maxSlicesPerTimeframe = 300;      // Newest finalized slices kept per timeframe
+        int64_t historyWindow_ms = 120000;       // ...and only those ending within this window
+        int64_t maxBookAge_ms = 10 * 60 * 1000;  // Older books are not restored (slices still are)
+        bool restoreBooks = false;               // Restored books are stale until replaced; off = history only
+    };
+
+    // Everything a write needs, taken on the engine thread
+    struct Snapshot {
+        struct Book {
+            std::string symbol;
+            double minPrice = 0.0, maxPrice = 0.0, tickSize = 0.0;
+            int64_t timestamp_ms = 0;
+            std::vector<std::pair<uint32_t, double>> bids;  // (grid index, quantity), best first
+            std::vector<std::pair<uint32_t, double>> asks;
+        };
+        struct Slice {
+            int64_t timeframe_ms = 0;
+            std::shared_ptr<const LiquidityTimeSlice> slice;
+            bool isCurrent = false;
+        };
+        int64_t createdAt_ms = 0;
+        std::vector<Book> books;
+        std::vector<std::vector<Trade>> trades;  // One time-ordered run per symbol
+        std::vector<Slice> slices;
+    };
+
+    struct Result {
+        bool ok = false;
+        size_t books = 0;
+        size_t trades = 0;
+        size_t slices = 0;
+        size_t bytes = 0;
+        int64_t createdAt_ms = 0;
+    };
+
+    static constexpr uint32_t kFormatVersion = 1;
+
+    // Engine thread: copies book levels and recent trades, takes handles to the slices within the history window
+    static Snapshot capture(const DataCache& cache, const LiquidityTimeSeriesEngine* engine, const Options& options);
+    // Any thread: encodes and writes atomically (temp file + rename)
+    static Result write(const std::string& path, const Snapshot& snapshot);
+    // capture + write in one call; engine may be null
+    static Result write(const std::string& path, const DataCache& cache,
+                        const LiquidityTimeSeriesEngine* engine, const Options& options);
+    // Restores into empty state only; missing, foreign-version or truncated files return ok = false and change nothing
+    static Result restore(const std::string& path, DataCache& cache,
+                          LiquidityTimeSeriesEngine* engine, const Options& options);
+};
@@ -0,0 +1,99 @@
+/*
+Sentinel — TimeBarRing
+Role: Fixed-capacity ring of time-bucketed bars plus the timeframe-set helpers shared by the bar engines.
+Inputs/Outputs: Takes event timestamps; returns the slot of the newest bar, opening a new one when the bucket advances.
+Threading: Not thread-safe; the owning engine serializes access under its own mutex.
+Performance: O(1) per event, bars are recycled in place; range queries binary-search the time-ordered ring.
+Integration: Used by OrderFlowEngine (OrderFlowBar rings) and FootprintEngine (footprint bar rings).
+Observability: No internal logging.
+Related: OrderFlowEngine.h, FootprintEngine.h.
+Assumptions: Bar exposes int64_t startTime_ms; timeframes are positive; late events fold into the newest bar.
+*/
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace TimeBars {
+
+inline constexpr size_t npos = static_cast<size_t>(-1);
+
+// Drops non-positive entries, sorts ascending and removes duplicates
+inline void normalize(std::vector<int64_t>& timeframes) {
+    timeframes.erase(std::remove_if(timeframes.begin(), timeframes.end(),
+                                    [](int64_t tf) { return tf <= 0; }),
+                     timeframes.end());
+    std::sort(timeframes.begin(), timeframes.end());
+    timeframes.erase(std::unique(timeframes.begin(), timeframes.end()), timeframes.end());
+}
+
+// Closest configured timeframe (ties go to the finer one); 0 when none are configured
+inline int64_t nearest(const std::vector<int64_t>& timeframes, int64_t timeframe_ms) {
+    if (timeframes.empty()) return 0;
+    auto it = std::lower_bound(timeframes.begin(), timeframes.end(), timeframe_ms);
+    if (it == timeframes.end()) return timeframes.back();
+    if (it == timeframes.begin()) return *it;
+    auto prev = it - 1;
+    return (timeframe_ms - *prev) <= (*it - timeframe_ms) ? *prev : *it;
+}
+
+// Position of an exact timeframe in a normalized set; npos when absent
+inline size_t indexOf(const std::vector<int64_t>& timeframes, int64_t timeframe_ms) {
+    auto it = std::lower_bound(timeframes.begin(), timeframes.end(), timeframe_ms);
+    return (it != timeframes.end() && *it == timeframe_ms) ? static_cast<size_t>(it - timeframes.begin()) : npos;
+}
+
+}  // namespace TimeBars
+
+template <typename Bar>
+struct TimeBarRing {
+    int64_t timeframe_ms = 0;
+    std::vector<Bar> bars;  // Preallocated to capacity
+    size_t head = 0;        // Slot of the newest bar
+    size_t count = 0;
+
+    void reset(int64_t timeframe, size_t capacity) {
+        timeframe_ms = timeframe;
+        bars.assign(std::max<size_t>(capacity, 1), Bar{});
+        head = 0;
+        count = 0;
+    }
+
+    size_t physical(size_t logical) const {  // 0 = oldest
+        return (head + bars.size() - count + 1 + logical) % bars.size();
+    }
+    const Bar& at(size_t logical) const { return bars[physical(logical)]; }
+
+    // Slot of the bar covering timestamp_ms. When the bucket advances the oldest slot is recycled:
+    // open(bar, previous) resets it, then its start is stamped. previous is the former newest bar
+    // (nullptr for the first) and aliases bar when capacity is 1, so read it before writing.
+    template <typename Open>
+    size_t barFor(int64_t timestamp_ms, Open&& open) {
+        const int64_t bucketStart = (timestamp_ms / timeframe_ms) * timeframe_ms;
+        if (count > 0 && bucketStart <= bars[head].startTime_ms) {
+            return head;  // Same bucket (or a late event)
+        }
+
+        const Bar* previous = count > 0 ? &bars[head] : nullptr;
+        if (count > 0) {
+            head = (head + 1) % bars.size();
+        }
+        count = std::min(count + 1, bars.size());
+        open(bars[head], previous);
+        bars[head].startTime_ms = bucketStart;
+        return head;
+    }
+
+    // Logical index of the first bar ending after start_ms (count when none)
+    size_t firstEndingAfter(int64_t start_ms) const {
+        size_t lo = 0, hi = count;
+        while (lo < hi) {
+            const size_t mid = (lo + hi) / 2;
+            if (at(mid).startTime_ms + timeframe_ms <= start_ms) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+};
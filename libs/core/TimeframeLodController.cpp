@@ -0,0 +1,64 @@
+/*
+Sentinel — TimeframeLodController
+Role: Implements the hysteresis bands around the target column count.
+Inputs/Outputs: See TimeframeLodController.h.
+Threading: Single-threaded.
+Performance: Linear scans over a ladder of a handful of timeframes.
+Integration: See TimeframeLodController.h.
+Observability: No internal logging.
+Related: TimeframeLodController.h.
+Assumptions: A timeframe leaves the ladder only when its history is dropped; the controller then re-picks from scratch.
+*/
+#include "TimeframeLodController.h"
+#include <algorithm>
+#include <iterator>
+
+int64_t TimeframeLodController::finestFitting(int64_t span_ms, const std::vector<int64_t>& ladder, double maxColumns) {
+    if (ladder.empty()) return 0;
+    for (int64_t timeframe : ladder) {
+        if (static_cast<double>(span_ms) / static_cast<double>(timeframe) <= maxColumns) return timeframe;
+    }
+    return ladder.back();
+}
+
+void TimeframeLodController::setManual(int64_t timeframe_ms) {
+    if (timeframe_ms <= 0) return;
+    m_current = timeframe_ms;
+    m_manual = true;
+}
+
+int64_t TimeframeLodController::update(int64_t span_ms, const std::vector<int64_t>& ladder) {
+    if (span_ms <= 0) return m_current;
+
+    const double target = static_cast<double>(m_config.targetColumns);
+    const double upper = target * (1.0 + m_config.hysteresis);
+    const double lower = target * (1.0 - m_config.hysteresis);
+
+    // A manual pick may not have data yet, so it is judged on its own rather than against the ladder
+    if (m_manual && columns(span_ms, m_current) > upper) {
+        m_manual = false;
+    }
+
+    if (!m_manual && !ladder.empty()) {
+        const auto it = std::find(ladder.begin(), ladder.end(), m_current);
+        if (it == ladder.end()) {
+            m_current = finestFitting(span_ms, ladder, target);
+        } else if (columns(span_ms, m_current) > upper) {
+            m_current = finestFitting(span_ms, ladder, target);  // Zoomed out past the band: go coarser
+        } else if (it != ladder.begin() && columns(span_ms, *std::prev(it)) <= lower) {
+            m_current = finestFitting(span_ms, ladder, target);  // Finer one now fits with margin
+        }
+    }
+
+    updateNeighbours(ladder);
+    return m_current;
+}
+
+void TimeframeLodController::updateNeighbours(const std::vector<int64_t>& ladder) {
+    m_coarser = 0;
+    m_finer = 0;
+    for (int64_t timeframe : ladder) {
+        if (timeframe < m_current) m_finer = timeframe;
+        if (timeframe > m_current && m_coarser == 0) m_coarser = timeframe;
+    }
+}
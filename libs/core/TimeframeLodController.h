@@ -0,0 +1,55 @@
+/*
+Sentinel — TimeframeLodController
+Role: Picks the heatmap timeframe (level of detail) for a viewport span with hysteresis, and names the neighbours worth prefetching.
+Inputs/Outputs: Takes the visible span and the ascending ladder of timeframes that have data; returns the active timeframe.
+Threading: Not thread-safe; owned and driven by DataProcessor on its worker thread.
+Performance: O(ladder) per update; no allocation.
+Integration: DataProcessor::updateVisibleCells asks it for the timeframe, then prefetches cells for coarser()/finer().
+Observability: No internal logging; DataProcessor logs switches.
+Related: TimeframeLodController.cpp, LiquidityTimeSeriesEngine.h, DataProcessor.hpp.
+Assumptions: The ladder is sorted finest to coarsest and contains no duplicates.
+*/
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+class TimeframeLodController {
+public:
+    struct Config {
+        int targetColumns = 2000;   // Columns the viewport should hold at the chosen timeframe
+        double hysteresis = 0.25;   // Band half-width as a fraction of targetColumns
+    };
+
+    TimeframeLodController() = default;
+    explicit TimeframeLodController(Config config) : m_config(config) {}
+
+    // Keeps the current timeframe while the span stays inside its band; otherwise jumps to the
+    // finest timeframe that fits targetColumns. Returns 0 until the ladder has an entry.
+    int64_t update(int64_t span_ms, const std::vector<int64_t>& ladder);
+
+    // User-selected timeframe: held until the span needs more than the upper band's columns at it
+    void setManual(int64_t timeframe_ms);
+    void clearManual() { m_manual = false; }
+    bool isManual() const { return m_manual; }
+
+    int64_t current() const { return m_current; }
+    // Neighbours of current() on the last ladder; 0 when there is none
+    int64_t coarser() const { return m_coarser; }
+    int64_t finer() const { return m_finer; }
+
+    // Finest ladder entry showing at most maxColumns over span_ms (the coarsest when none does)
+    static int64_t finestFitting(int64_t span_ms, const std::vector<int64_t>& ladder, double maxColumns);
+
+private:
+    double columns(int64_t span_ms, int64_t timeframe_ms) const {
+        return static_cast<double>(span_ms) / static_cast<double>(timeframe_ms);
+    }
+    void updateNeighbours(const std::vector<int64_t>& ladder);
+
+    Config m_config;
+    int64_t m_current = 0;
+    int64_t m_coarser = 0;
+    int64_t m_finer = 0;
+    bool m_manual = false;
+};
@@ -0,0 +1,168 @@
+/*
+Sentinel — TradeHistoryStore
+Role: Implements block append/eviction, block-list publication and the range copy.
+Inputs/Outputs: See TradeHistoryStore.h.
+Threading: Producer methods touch m_symbols without locking; m_publishMutex covers only the published pointers.
+Performance: A trade writes four column slots and one release store; publication happens once per block or eviction.
+Integration: See TradeHistoryStore.h.
+Observability: sLog_App on first trade for a new symbol.
+Related: TradeHistoryStore.h.
+Assumptions: Retention is enforced at block granularity, so up to one block beyond the limits may be retained.
+*/
+#include "TradeHistoryStore.h"
+#include "SentinelLogging.hpp"
+#include <chrono>
+
+TradeHistoryStore::TradeHistoryStore()
+    : TradeHistoryStore(Retention{}) {}
+
+TradeHistoryStore::TradeHistoryStore(Retention retention)
+    : m_retention(retention) {}
+
+TradeHistoryStore::~TradeHistoryStore() = default;
+
+TradeHistoryStore::SymbolHistory& TradeHistoryStore::historyFor(const std::string& symbol) {
+    auto it = m_symbols.find(symbol);
+    if (it != m_symbols.end()) return it->second;
+
+    sLog_App("TradeHistoryStore: tracking" << QString::fromStdString(symbol)
+             << "retention:" << m_retention.maxAge_ms / 1000 << "s /"
+             << m_retention.maxBytesPerSymbol / (1024 * 1024) << "MB");
+    return m_symbols.emplace(symbol, SymbolHistory{}).first->second;
+}
+
+void TradeHistoryStore::onTrade(const Trade& trade) {
+    if (trade.product_id.empty() || trade.size <= 0.0 || trade.price <= 0.0) return;
+    int64_t ts = std::chrono::duration_cast<std::chrono::milliseconds>(
+        trade.timestamp.time_since_epoch()).count();
+
+    SymbolHistory& history = historyFor(trade.product_id);
+    bool blocksChanged = false;
+
+    size_t n = history.blocks.empty() ? 0 : history.blocks.back()->m_count.load(std::memory_order_relaxed);
+    if (n > 0) {
+        ts = std::max(ts, history.blocks.back()->m_time[n - 1]);  // Keep columns sorted
+    }
+    if (history.blocks.empty() || n == kChunkTrades) {
+        history.blocks.push_back(std::make_shared<Block>());
+        n = 0;
+        blocksChanged = true;
+    }
+
+    // Fill the slot, then publish it: readers never look past the count they load
+    Block& block = *history.blocks.back();
+    block.m_time[n] = ts;
+    block.m_price[n] = trade.price;
+    block.m_size[n] = static_cast<float>(trade.size);
+    block.m_side[n] = static_cast<uint8_t>(trade.side);
+    block.m_count.store(n + 1, std::memory_order_release);
+
+    blocksChanged |= evict(history);
+    if (blocksChanged) {
+        ++history.epoch;
+        publish(trade.product_id, history);
+    }
+    m_version.fetch_add(1, std::memory_order_release);
+}
+
+bool TradeHistoryStore::evict(SymbolHistory& history) {
+    bool evicted = false;
+    // Never evict the block being written
+    while (history.blocks.size() > 1) {
+        const Block& oldest = *history.blocks.front();
+        const Block& newest = *history.blocks.back();
+        const size_t newestCount = newest.m_count.load(std::memory_order_relaxed);
+        const bool tooOld = newestCount > 0 &&
+                            newest.m_time[newestCount - 1] - oldest.m_time[kChunkTrades - 1] > m_retention.maxAge_ms;
+        const bool tooBig = history.blocks.size() * kChunkBytes > m_retention.maxBytesPerSymbol;
+        if (!tooOld && !tooBig) break;
+
+        // Readers holding an older Blocks keep the evicted block alive until they drop it
+        history.blocks.pop_front();
+        evicted = true;
+    }
+    return evicted;
+}
+
+void TradeHistoryStore::publish(const std::string& symbol, const SymbolHistory& history) {
+    auto blocks = std::make_shared<Blocks>();
+    blocks->epoch = history.epoch;
+    blocks->blocks.assign(history.blocks.begin(), history.blocks.end());
+
+    std::lock_guard<std::mutex> lock(m_publishMutex);
+    m_published[symbol] = std::move(blocks);
+}
+
+std::shared_ptr<const TradeHistoryStore::Blocks> TradeHistoryStore::snapshot(const std::string& symbol) const {
+    std::lock_guard<std::mutex> lock(m_publishMutex);
+    auto it = m_published.find(symbol);
+    return it == m_published.end() ? nullptr : it->second;
+}
+
+size_t TradeHistoryStore::copyRange(const std::string& symbol, int64_t start_ms, int64_t end_ms,
+                                    double priceMin, double priceMax, double minSize, size_t maxPrints,
+                                    std::vector<TradePrint>& out) const {
+    out.clear();
+    if (end_ms < start_ms || maxPrints == 0) return 0;
+    const auto blocks = snapshot(symbol);
+    if (!blocks) return 0;
+
+    blocks->forEachInRange(start_ms, end_ms, [&](int64_t time, double price, double size, AggressorSide side) {
+        if (size < minSize || price < priceMin || price > priceMax) return;
+        out.push_back(TradePrint{time, price, size, side});
+    });
+    const size_t matches = out.size();
+
+    if (out.size() > maxPrints) {
+        // Keep the largest prints, then restore time order
+        std::nth_element(out.begin(), out.begin() + static_cast<std::ptrdiff_t>(maxPrints), out.end(),
+                         [](const TradePrint& a, const TradePrint& b) { return a.size > b.size; });
+        out.resize(maxPrints);
+        std::sort(out.begin(), out.end(), [](const TradePrint& a, const TradePrint& b) { return a.time_ms < b.time_ms; });
+    }
+    return matches;
+}
+
+void TradeHistoryStore::setRetention(Retention retention) {
+    {
+        std::lock_guard<std::mutex> lock(m_publishMutex);
+        m_retention = retention;
+    }
+    for (auto& [symbol, history] : m_symbols) {
+        if (evict(history)) {
+            ++history.epoch;
+            publish(symbol, history);
+        }
+    }
+    m_version.fetch_add(1, std::memory_order_release);
+}
+
+TradeHistoryStore::Retention TradeHistoryStore::getRetention() const {
+    std::lock_guard<std::mutex> lock(m_publishMutex);
+    return m_retention;
+}
+
+size_t TradeHistoryStore::tradeCount(const std::string& symbol) const {
+    const auto blocks = snapshot(symbol);
+    return blocks ? blocks->tradeCount() : 0;
+}
+
+size_t TradeHistoryStore::bytesUsed(const std::string& symbol) const {
+    const auto blocks = snapshot(symbol);
+    return blocks ? blocks->blocks.size() * kChunkBytes : 0;
+}
+
+int64_t TradeHistoryStore::oldestTime(const std::string& symbol) const {
+    const auto blocks = snapshot(symbol);
+    if (!blocks || blocks->blocks.empty() || blocks->blocks.front()->count() == 0) return 0;
+    return blocks->blocks.front()->time(0);
+}
+
+void TradeHistoryStore::clear() {
+    m_symbols.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_publishMutex);
+        m_published.clear();
+    }
+    m_version.fetch_add(1, std::memory_order_release);
+}
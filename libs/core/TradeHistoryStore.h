@@ -0,0 +1,140 @@
+/*
+Sentinel — TradeHistoryStore
+Role: Per-symbol columnar trade history (time, price, size, side arrays in fixed-size blocks) with time-range queries.
+Inputs/Outputs: Takes trades per symbol; publishes immutable, epoch-tagged block lists for readers.
+Threading: Single producer (onTrade/setRetention/clear on one thread, the GUI thread in the app); any number of readers
+           (render thread). The tail block is an SPSC append buffer: columns are written first, then the block's
+           count is published with release ordering, so readers see a consistent prefix without locking.
+           Block lists are swapped under a mutex held only for a shared_ptr copy, once per block, not per trade.
+Performance: O(1) append; O(log blocks + log block) to locate a range; eviction drops whole blocks from the list.
+Integration: Owned by UnifiedGridRenderer; the render thread hands the symbol's Blocks to TradeBubbleStrategy.
+Observability: Logs new symbol registration via sLog_App.
+Related: TradeHistoryStore.cpp, FootprintEngine.h, UnifiedGridRenderer.h, TradeBubbleStrategy.hpp.
+Assumptions: Trades arrive roughly in time order; a late trade is stamped with the newest stored time so every
+             block stays sorted for binary search.
+*/
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "marketdata/model/TradeData.h"
+
+// One stored print as handed to consumers
+struct TradePrint {
+    int64_t time_ms = 0;
+    double price = 0.0;
+    double size = 0.0;
+    AggressorSide side = AggressorSide::Unknown;
+};
+
+class TradeHistoryStore {
+public:
+    static constexpr size_t kChunkTrades = 4096;
+    static constexpr size_t kBytesPerTrade = sizeof(int64_t) + sizeof(double) + sizeof(float) + sizeof(uint8_t);
+    static constexpr size_t kChunkBytes = kChunkTrades * kBytesPerTrade;
+
+    struct Retention {
+        int64_t maxAge_ms = 4 * 60 * 60 * 1000;          // Relative to the symbol's newest trade
+        size_t maxBytesPerSymbol = 64 * 1024 * 1024;
+    };
+
+    // Fixed-capacity column block. Entries below count() never change after they are published.
+    class Block {
+    public:
+        size_t count() const { return m_count.load(std::memory_order_acquire); }
+        int64_t time(size_t i) const { return m_time[i]; }
+        double price(size_t i) const { return m_price[i]; }
+        double size(size_t i) const { return m_size[i]; }
+        AggressorSide side(size_t i) const { return static_cast<AggressorSide>(m_side[i]); }
+
+    private:
+        friend class TradeHistoryStore;
+        int64_t m_time[kChunkTrades];
+        double m_price[kChunkTrades];
+        float m_size[kChunkTrades];
+        uint8_t m_side[kChunkTrades];
+        std::atomic<size_t> m_count{0};
+    };
+
+    // Immutable block list for one symbol, oldest first. The epoch changes whenever blocks are added or evicted.
+    struct Blocks {
+        uint64_t epoch = 0;
+        std::vector<std::shared_ptr<const Block>> blocks;
+
+        size_t tradeCount() const {
+            size_t total = 0;
+            for (const auto& block : blocks) total += block->count();
+            return total;
+        }
+
+        // Calls fn(time_ms, price, size, side) for every print with time in [start_ms, end_ms], oldest first
+        template <typename Fn>
+        void forEachInRange(int64_t start_ms, int64_t end_ms, Fn&& fn) const {
+            auto it = std::partition_point(blocks.begin(), blocks.end(), [start_ms](const auto& block) {
+                const size_t n = block->count();
+                return n > 0 && block->time(n - 1) < start_ms;
+            });
+            for (; it != blocks.end(); ++it) {
+                const Block& block = **it;
+                const size_t n = block.count();
+                if (n == 0 || block.time(0) > end_ms) break;
+                const int64_t* first = std::lower_bound(block.m_time, block.m_time + n, start_ms);
+                const int64_t* last = std::upper_bound(first, block.m_time + n, end_ms);
+                for (size_t i = static_cast<size_t>(first - block.m_time); i < static_cast<size_t>(last - block.m_time); ++i) {
+                    fn(block.m_time[i], block.m_price[i], static_cast<double>(block.m_size[i]), block.side(i));
+                }
+            }
+        }
+    };
+
+    TradeHistoryStore();
+    explicit TradeHistoryStore(Retention retention);
+    ~TradeHistoryStore();
+
+    // Producer side
+    void onTrade(const Trade& trade);
+    void setRetention(Retention retention);
+    void clear();
+
+    // Reader side (any thread)
+    std::shared_ptr<const Blocks> snapshot(const std::string& symbol) const;
+
+    // Prints with time in [start_ms, end_ms] and price in [priceMin, priceMax] whose size >= minSize, oldest first.
+    // When more than maxPrints match, the largest maxPrints are kept (still time-ordered). Returns matches found.
+    size_t copyRange(const std::string& symbol, int64_t start_ms, int64_t end_ms,
+                     double priceMin, double priceMax, double minSize, size_t maxPrints,
+                     std::vector<TradePrint>& out) const;
+
+    Retention getRetention() const;
+    size_t tradeCount(const std::string& symbol) const;
+    size_t bytesUsed(const std::string& symbol) const;
+    int64_t oldestTime(const std::string& symbol) const;  // 0 when empty
+
+    // Bumped on every ingested trade or eviction; lets consumers skip unchanged work
+    uint64_t getVersion() const { return m_version.load(std::memory_order_acquire); }
+
+private:
+    // Producer-owned state; readers only ever see published Blocks
+    struct SymbolHistory {
+        std::deque<std::shared_ptr<Block>> blocks;
+        uint64_t epoch = 0;
+    };
+
+    SymbolHistory& historyFor(const std::string& symbol);
+    bool evict(SymbolHistory& history);
+    void publish(const std::string& symbol, const SymbolHistory& history);
+
+    Retention m_retention;
+    std::unordered_map<std::string, SymbolHistory> m_symbols;
+    std::atomic<uint64_t> m_version{0};
+
+    mutable std::mutex m_publishMutex;  // Guards m_published and m_retention copies only
+    std::unordered_map<std::string, std::shared_ptr<const Blocks>> m_published;
+};
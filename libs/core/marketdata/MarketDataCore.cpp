@@ -30,6 +30,8 @@ namespace {
             std::chrono::steady_clock::now().time_since_epoch()).count();
     }
     static constexpr int64_t kHeartbeatStaleThresholdMs = 10000;
+    // A resubscribed product that has not received its snapshot by then is resubscribed again
+    static constexpr std::chrono::milliseconds kResyncSnapshotTimeout{5000};
 }
 
 MarketDataCore::MarketDataCore(Authenticator& auth,
@@ -40,6 +42,7 @@ MarketDataCore::MarketDataCore(Authenticator& auth,
 {
     qRegisterMetaType<BookDelta>("BookDelta");
     qRegisterMetaType<std::vector<BookDelta>>("BookDeltaVector");
+    qRegisterMetaType<BookGrid>("BookGrid");
 
     // Configure SSL context
     m_sslCtx.set_default_verify_paths();
@@ -52,11 +55,10 @@ MarketDataCore::MarketDataCore(Authenticator& auth,
         m_connected.store(up);
         if (up) {
             // Reset sequencing and heartbeat tracking on fresh connect
-            m_lastSeqByProduct.clear();
             m_lastHeartbeatMs.store(steadyClockMs());
             {
                 std::lock_guard<std::mutex> lock(m_seqMutex);
-                m_lastSeqByProduct.clear();
+                m_sequence.reset();
             }
             QPointer<MarketDataCore> self(this);
             QMetaObject::invokeMethod(this, [self]{ if (!self) return; emit self->connectionStatusChanged(true); }, Qt::QueuedConnection);
@@ -68,6 +70,28 @@ MarketDataCore::MarketDataCore(Authenticator& auth,
         }
     });
     m_transport->onError([this](std::string err){ emitError(QString::fromStdString(err)); });
+
+    // Secondary venues publish through the same signals, keyed per venue
+    m_feeds.setSinks(
+        [this](const std::string& venue, const std::string& symbol, const std::vector<BookDelta>& deltas,
+               const BookGrid& grid) {
+            QPointer<MarketDataCore> self(this);
+            QString key = QString::fromStdString(feed::venueKey(symbol, venue));
+            QMetaObject::invokeMethod(this, [self, key, payload = deltas, grid]() {
+                if (!self) return;
+                emit self->liveOrderBookUpdated(key, payload, grid);
+            }, Qt::QueuedConnection);
+        },
+        [this](const std::string& venue, const Trade& trade) {
+            Trade venueTrade = trade;
+            venueTrade.product_id = feed::venueKey(trade.product_id, venue);
+            m_sink.onTrade(venueTrade);
+            QPointer<MarketDataCore> self(this);
+            QMetaObject::invokeMethod(this, [self, venueTrade]() {
+                if (!self) return;
+                emit self->tradeReceived(venueTrade);
+            }, Qt::QueuedConnection);
+        });
     m_transport->onMessage([this](std::string payload){
         try {
             auto j = nlohmann::json::parse(payload);
@@ -108,9 +132,14 @@ void MarketDataCore::subscribeToSymbols(const std::vector<std::string>& symbols)
     }
     if (!new_symbols.empty()) {
         sendSubscriptionMessage("subscribe", new_symbols);
+        m_feeds.subscribe(new_symbols);
     }
 }
 
+void MarketDataCore::addFeedHandler(std::unique_ptr<IFeedHandler> handler) {
+    m_feeds.addHandler(std::move(handler));
+}
+
 void MarketDataCore::unsubscribeFromSymbols(const std::vector<std::string>& symbols) {
     std::vector<std::string> removed_symbols;
     for (const auto& s : symbols) {
@@ -144,6 +173,7 @@ void MarketDataCore::start() {
         if (m_transport) {
             m_transport->connect(m_host, m_port, m_target);
         }
+        m_feeds.start();
     }
 }
 
@@ -151,6 +181,8 @@ void MarketDataCore::stop() {
     if (m_running.exchange(false)) {
         sLog_App("Stopping MarketDataCore...");
 
+        m_feeds.stop();
+
         // Cancel reconnect timer
         m_reconnectTimer.cancel();
 
@@ -258,6 +290,21 @@ void MarketDataCore::dispatch(const nlohmann::json& message) {
     std::string channel = message.value("channel", "");
     // Consider any incoming message as liveness to avoid premature reconnection before first heartbeat arrives
     m_lastHeartbeatMs.store(steadyClockMs());
+
+    // Connection-wide sequence continuity: a skipped number means some message was lost
+    if (message.contains("sequence_num") && message["sequence_num"].is_number_unsigned()) {
+        const uint64_t seq = message["sequence_num"].get<uint64_t>();
+        bool gap = false;
+        {
+            std::lock_guard<std::mutex> lock(m_seqMutex);
+            gap = m_sequence.observeMessage(seq);
+            if (gap) m_sequence.markAllLiveForResync();
+        }
+        if (gap) {
+            sLog_Warning(QString("Sequence gap before %1; resyncing live order books").arg(seq));
+            requestBookResyncs();
+        }
+    }
     if (channel == ch::kHeartbeats) {
         handleHeartbeats(message);
         return;
@@ -379,18 +426,17 @@ void MarketDataCore::handleOrderBookData(const nlohmann::json& message,
         std::string eventType = event.value("type", "");
         std::string product_id = event.value("product_id", "");
         
-        // For l2_data, Coinbase guarantees delivery; do not enforce sequence gating.
-
         if (eventType == "snapshot") {
-            handleOrderBookSnapshot(event, product_id, exchange_timestamp);
+            handleOrderBookSnapshot(event, product_id, seq, exchange_timestamp);
         } else if (eventType == "update") {
-            handleOrderBookUpdate(event, product_id, exchange_timestamp);
+            handleOrderBookUpdate(event, product_id, seq, exchange_timestamp);
         }
     }
 }
 
 void MarketDataCore::handleOrderBookSnapshot(const nlohmann::json& event,
                                            const std::string& product_id,
+                                           uint64_t seq,
                                            const std::chrono::system_clock::time_point& exchange_timestamp) {
     if (!event.contains("updates") || product_id.empty()) return;
     
@@ -420,14 +466,31 @@ void MarketDataCore::handleOrderBookSnapshot(const nlohmann::json& event,
     
     // Initialize the live order book with the sparse snapshot data
     m_cache.initializeLiveOrderBook(product_id, sparse_bids, sparse_asks, exchange_timestamp);
+    m_feeds.onPrimarySnapshot(product_id);
     
     std::string logMessage = Cpp20Utils::formatOrderBookLog(
         product_id, sparse_bids.size(), sparse_asks.size());
     sLog_Data(QString::fromStdString(logMessage));
+
+    // Updates buffered while this product resynced: replay those newer than the snapshot
+    std::vector<SequenceTracker::BufferedUpdate> replay;
+    {
+        std::lock_guard<std::mutex> lock(m_seqMutex);
+        const bool wasResyncing = m_sequence.isResyncing(product_id);
+        replay = m_sequence.onSnapshot(product_id, seq);
+        if (wasResyncing) {
+            sLog_Data(QString("Resync complete for %1: replaying %2 buffered updates")
+                      .arg(QString::fromStdString(product_id)).arg(replay.size()));
+        }
+    }
+    for (const auto& update : replay) {
+        applyOrderBookLevels(product_id, update.levels, update.exchange_timestamp);
+    }
 }
 
 void MarketDataCore::handleOrderBookUpdate(const nlohmann::json& event,
                                          const std::string& product_id,
+                                         uint64_t seq,
                                          const std::chrono::system_clock::time_point& exchange_timestamp) {
     if (!event.contains("updates") || product_id.empty()) return;
     
@@ -457,14 +520,37 @@ void MarketDataCore::handleOrderBookUpdate(const nlohmann::json& event,
         levelUpdates.push_back(BookLevelUpdate{isBid, price, quantity});
     }
 
+    switch (checkAndTrackSequence(product_id, seq)) {
+        case SequenceTracker::Decision::Apply:
+            applyOrderBookLevels(product_id, levelUpdates, exchange_timestamp);
+            break;
+        case SequenceTracker::Decision::Buffer: {
+            std::lock_guard<std::mutex> lock(m_seqMutex);
+            m_sequence.buffer(product_id, SequenceTracker::BufferedUpdate{seq, exchange_timestamp, levelUpdates});
+            break;
+        }
+        case SequenceTracker::Decision::Drop:
+            sLog_Warning(QString("Out-of-order l2 update %1 for %2; resyncing")
+                         .arg(seq).arg(QString::fromStdString(product_id)));
+            requestBookResyncs();
+            break;
+    }
+}
+
+void MarketDataCore::applyOrderBookLevels(const std::string& product_id,
+                                          const std::vector<BookLevelUpdate>& levelUpdates,
+                                          const std::chrono::system_clock::time_point& exchange_timestamp) {
     thread_local std::vector<BookDelta> deltas;
+    BookGrid grid;
     if (!levelUpdates.empty()) {
-        m_cache.applyLiveOrderBookUpdates(product_id,
-                                          std::span<const BookLevelUpdate>(levelUpdates.data(), levelUpdates.size()),
-                                          exchange_timestamp,
-                                          deltas);
+        grid = m_cache.applyLiveOrderBookUpdates(product_id,
+                                                 std::span<const BookLevelUpdate>(levelUpdates.data(), levelUpdates.size()),
+                                                 exchange_timestamp,
+                                                 deltas);
+        m_feeds.onPrimaryDeltas(product_id, deltas, grid);
     } else {
         deltas.clear();
+        grid = m_cache.getDirectLiveOrderBook(product_id).grid();
     }
     const int updateCount = static_cast<int>(deltas.size());
     
@@ -474,9 +560,9 @@ void MarketDataCore::handleOrderBookUpdate(const nlohmann::json& event,
     {
         QPointer<MarketDataCore> self(this);
         QString productIdQ = QString::fromStdString(product_id);
-        QMetaObject::invokeMethod(this, [self, productIdQ, deltasMove = std::move(deltasPayload)]() mutable {
+        QMetaObject::invokeMethod(this, [self, productIdQ, deltasMove = std::move(deltasPayload), grid]() mutable {
             if (!self) return;
-            emit self->liveOrderBookUpdated(productIdQ, deltasMove);
+            emit self->liveOrderBookUpdated(productIdQ, deltasMove, grid);
         }, Qt::QueuedConnection);
     }
     
@@ -509,6 +595,8 @@ void MarketDataCore::startHeartbeatWatchdog() {
         m_heartbeatTimer.expires_after(std::chrono::seconds(2));
         m_heartbeatTimer.async_wait([this](beast::error_code ec){
             if (ec || !m_running.load()) return;
+            // Resubscribes whose snapshot never arrived are retried here
+            requestBookResyncs();
             const int64_t nowMs = steadyClockMs();
             const int64_t lastMs = m_lastHeartbeatMs.load();
             if (lastMs > 0 && (nowMs - lastMs) > kHeartbeatStaleThresholdMs) {
@@ -536,19 +624,32 @@ void MarketDataCore::triggerImmediateReconnect(const char* reason) {
     });
 }
 
-int MarketDataCore::checkAndTrackSequence(const std::string& product_id, uint64_t seq, bool isSnapshot) {
-    // For Advanced Trade l2_data, delivery is guaranteed; treat sequence as informational only.
-    // Keep latest observed sequence per product for diagnostics, but never gate processing.
+SequenceTracker::Decision MarketDataCore::checkAndTrackSequence(const std::string& product_id, uint64_t seq) {
+    // Messages without a sequence number cannot be ordered; apply them as before
+    if (seq == 0) return SequenceTracker::Decision::Apply;
     std::lock_guard<std::mutex> lock(m_seqMutex);
-    if (isSnapshot) {
-        m_lastSeqByProduct[product_id] = seq;
-        return 0;
-    }
-    auto it = m_lastSeqByProduct.find(product_id);
-    if (it == m_lastSeqByProduct.end() || seq >= it->second) {
-        m_lastSeqByProduct[product_id] = seq;
+    return m_sequence.onUpdate(product_id, seq);
+}
+
+void MarketDataCore::requestBookResyncs() {
+    std::vector<std::string> products;
+    {
+        std::lock_guard<std::mutex> lock(m_seqMutex);
+        products = m_sequence.takeResyncRequests(std::chrono::steady_clock::now(), kResyncSnapshotTimeout);
     }
-    return 0;
+    if (products.empty()) return;
+
+    // Resubscribe only the affected products' level2 stream; the socket and other products stay up
+    net::post(m_strand, [this, products = std::move(products)]() {
+        if (!m_connected.load() || !m_transport) return;  // Reconnect replays every subscription anyway
+        const std::string jwt = m_auth.createJwt();
+        for (const auto& product : products) {
+            sLog_Warning(QString("Resyncing order book for %1").arg(QString::fromStdString(product)));
+            for (const auto& frame : m_subscriptions.buildL2ResyncMsgs(product, jwt)) {
+                m_transport->send(frame);
+            }
+        }
+    });
 }
 
 void MarketDataCore::sendHeartbeatSubscribe() {
@@ -28,7 +28,9 @@ Assumptions: The provided Authenticator and DataCache instances will outlive thi
 #include "cache/DataCache.hpp"
 #include "sinks/DataCacheSinkAdapter.hpp"
 #include "ws/SubscriptionManager.hpp"
+#include "ws/SequenceTracker.hpp"
 #include "ws/BeastWsTransport.hpp"
+#include "feeds/FeedAggregator.hpp"
 #include "model/TradeData.h"
 
 namespace net = boost::asio;
@@ -50,6 +52,11 @@ public:
     void subscribeToSymbols(const std::vector<std::string>& symbols);
     void unsubscribeFromSymbols(const std::vector<std::string>& symbols);
 
+    // Additional venues. Each handler runs on its own I/O thread; its books and trades are published
+    // through the signals below under venue-qualified ids ("BTC-USD@SIM", see feed::venueKey).
+    void addFeedHandler(std::unique_ptr<IFeedHandler> handler);
+    FeedAggregator& feeds() { return m_feeds; }
+
     // Non-copyable, non-movable (manages thread)
     MarketDataCore(const MarketDataCore&) = delete;
     MarketDataCore& operator=(const MarketDataCore&) = delete;
@@ -58,7 +65,8 @@ public:
 
 signals:
     void tradeReceived(const Trade& trade);
-    void liveOrderBookUpdated(const QString& productId, const std::vector<BookDelta>& deltas);
+    // grid: the geometry the deltas index, stamped when the batch was applied
+    void liveOrderBookUpdated(const QString& productId, const std::vector<BookDelta>& deltas, const BookGrid& grid);
     void connectionStatusChanged(bool connected);
     void errorOccurred(const QString& error);
 
@@ -82,17 +90,24 @@ private:
                            const std::chrono::system_clock::time_point& arrival_time);
     void handleOrderBookSnapshot(const nlohmann::json& event,
                                const std::string& product_id,
+                               uint64_t seq,
                                const std::chrono::system_clock::time_point& exchange_timestamp);
     void handleOrderBookUpdate(const nlohmann::json& event,
                              const std::string& product_id,
+                             uint64_t seq,
                              const std::chrono::system_clock::time_point& exchange_timestamp);
+    void applyOrderBookLevels(const std::string& product_id,
+                              const std::vector<BookLevelUpdate>& levelUpdates,
+                              const std::chrono::system_clock::time_point& exchange_timestamp);
 
     // Reliability helpers
     void handleHeartbeats(const nlohmann::json& message);
     void startHeartbeatWatchdog();
     void triggerImmediateReconnect(const char* reason);
-    // Tracks sequence numbers for diagnostics. Returns 0 (no gating enforced).
-    int checkAndTrackSequence(const std::string& product_id, uint64_t seq, bool isSnapshot);
+    // Per-product l2 sequencing: Apply, Buffer (product is resyncing) or Drop (stale; resync requested)
+    SequenceTracker::Decision checkAndTrackSequence(const std::string& product_id, uint64_t seq);
+    // Resubscribes flagged or overdue products' level2 stream only (no socket teardown)
+    void requestBookResyncs();
     void sendHeartbeatSubscribe();
 
     // Members
@@ -110,6 +125,7 @@ private:
     DataCache&                      m_cache;
     DataCacheSinkAdapter            m_sink{m_cache};
     SubscriptionManager             m_subscriptions;
+    FeedAggregator                  m_feeds{m_cache};
 
     net::io_context                 m_ioc;
     ssl::context                    m_sslCtx{ssl::context::tlsv12_client};
@@ -128,7 +144,7 @@ private:
     // Thread-safe counters (no more static!)
     std::atomic<int>                m_tradeLogCount{0};
     std::atomic<int>                m_orderBookLogCount{0};
-    std::unordered_map<std::string, uint64_t> m_lastSeqByProduct; // l2 sequence tracking (guarded by m_seqMutex)
+    SequenceTracker                 m_sequence;             // l2 gap detection and resync (guarded by m_seqMutex)
     std::mutex                      m_seqMutex;
     std::atomic<int64_t>            m_lastHeartbeatMs{0};
     
@@ -12,6 +12,9 @@ Assumptions: Assumes order book updates can be applied incrementally to the stor
 #include "DataCache.hpp"
 #include "SentinelLogging.hpp"
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
 #include <mutex>
 #include <span>
 #include <QString>
@@ -104,34 +107,106 @@ OrderBook DataCache::book(const std::string& symbol) const {
 
 void LiveOrderBook::initialize(double min_price, double max_price, double tick_size) {
     std::lock_guard<std::mutex> lock(m_mutex);
+    initializeLocked(min_price, max_price, tick_size);
+    m_stale.store(false, std::memory_order_release);
+}
 
+void LiveOrderBook::initializeLocked(double min_price, double max_price, double tick_size) {
     m_min_price = min_price;
     m_max_price = max_price;
     m_tick_size = tick_size;
+    ++m_gridEpoch;  // Indices handed out before this point refer to the previous grid
 
     if (m_tick_size <= 0) return; // Avoid division by zero
 
     size_t size = static_cast<size_t>((max_price - min_price) / tick_size) + 1;
 
-    m_bids.resize(size, 0.0);
-    m_asks.resize(size, 0.0);
+    // assign, not resize: a re-initialized book must not keep levels from the previous snapshot/grid
+    m_bids.assign(size, 0.0);
+    m_asks.assign(size, 0.0);
+    m_bidDepth.assign(size);
+    m_askDepth.assign(size);
+    m_bidNotional = {};  // Released, not re-sized: rebuilt on the next sweep estimate, if any
+    m_askNotional = {};
+    m_notionalIndexed = false;
+    m_bidOccupied.assign(size);
+    m_askOccupied.assign(size);
 
     m_nonZeroBidCount = 0;
     m_nonZeroAskCount = 0;
+    m_bestBidIndex = kNoLevel;
+    m_bestAskIndex = kNoLevel;
     m_totalBidVolume = 0.0;
     m_totalAskVolume = 0.0;
+    for (auto& view : m_bucketViews) {
+        rebuildBucketViewLocked(view);
+    }
 
     sLog_App(QString("O(1) LiveOrderBook initialized for %1 with size %2 (%3 -> %4 @ %5)")
               .arg(QString::fromStdString(m_productId)).arg(size)
               .arg(m_min_price).arg(m_max_price).arg(m_tick_size));
 }
 
+void LiveOrderBook::regrid(double min_price, double max_price) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    regridLocked(min_price, max_price);
+}
+
+bool LiveOrderBook::recenterIfNearEdge(double marginFraction) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!isNearEdgeLocked(marginFraction)) return false;
+
+    const double bid = m_bestBidIndex == kNoLevel ? 0.0 : priceAtLocked(m_bestBidIndex);
+    const double ask = m_bestAskIndex == kNoLevel ? 0.0 : priceAtLocked(m_bestAskIndex);
+    const double mid = (bid > 0.0 && ask > 0.0) ? 0.5 * (bid + ask) : std::max(bid, ask);
+    const double width = m_max_price - m_min_price;
+    const double minPrice = std::max(m_tick_size, std::floor((mid - 0.5 * width) / m_tick_size) * m_tick_size);
+    regridLocked(minPrice, minPrice + width);
+    return true;
+}
+
+bool LiveOrderBook::isNearEdge(double marginFraction) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return isNearEdgeLocked(marginFraction);
+}
+
+bool LiveOrderBook::isNearEdgeLocked(double marginFraction) const {
+    if (m_tick_size <= 0.0 || (m_bestBidIndex == kNoLevel && m_bestAskIndex == kNoLevel)) return false;
+
+    const double bid = m_bestBidIndex == kNoLevel ? 0.0 : priceAtLocked(m_bestBidIndex);
+    const double ask = m_bestAskIndex == kNoLevel ? 0.0 : priceAtLocked(m_bestAskIndex);
+    const double mid = (bid > 0.0 && ask > 0.0) ? 0.5 * (bid + ask) : std::max(bid, ask);
+    const double margin = (m_max_price - m_min_price) * marginFraction;
+    return mid <= m_min_price + margin || mid >= m_max_price - margin;
+}
+
+void LiveOrderBook::regridLocked(double min_price, double max_price) {
+    if (m_tick_size <= 0.0) return;
+
+    // Populated levels only, found through the occupancy bitsets rather than a walk over both grids
+    std::vector<BookLevelUpdate> levels;
+    levels.reserve(m_nonZeroBidCount + m_nonZeroAskCount);
+    for (size_t i = m_bidOccupied.nextSet(0); i != OccupancyBitset::npos; i = m_bidOccupied.nextSet(i + 1)) {
+        levels.push_back(BookLevelUpdate{true, priceAtLocked(i), m_bids[i]});
+    }
+    for (size_t i = m_askOccupied.nextSet(0); i != OccupancyBitset::npos; i = m_askOccupied.nextSet(i + 1)) {
+        levels.push_back(BookLevelUpdate{false, priceAtLocked(i), m_asks[i]});
+    }
+
+    initializeLocked(min_price, max_price, m_tick_size);
+    for (const auto& level : levels) {
+        applyLevelLocked(level.isBid, level.price, level.quantity, nullptr);
+    }
+}
+
 void LiveOrderBook::applyUpdates(std::span<const BookLevelUpdate> updates,
                                  std::chrono::system_clock::time_point exchange_timestamp,
-                                 std::vector<BookDelta>* outDeltas) {
+                                 std::vector<BookDelta>* outDeltas,
+                                 BookGrid* outGrid) {
     std::lock_guard<std::mutex> lock(m_mutex);
 
     if (updates.empty()) {
+        if (outGrid) *outGrid = gridLocked();
         return;
     }
 
@@ -145,6 +220,70 @@ void LiveOrderBook::applyUpdates(std::span<const BookLevelUpdate> updates,
     for (const auto& update : updates) {
         applyLevelLocked(update.isBid, update.price, update.quantity, outDeltas);
     }
+    if (outGrid) *outGrid = gridLocked();
+}
+
+std::vector<double> LiveOrderBook::getBids() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_bids;
+}
+
+std::vector<double> LiveOrderBook::getAsks() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_asks;
+}
+
+BookGrid LiveOrderBook::grid() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return gridLocked();
+}
+
+BookGrid LiveOrderBook::gridLocked() const {
+    BookGrid grid;
+    grid.minPrice = m_min_price;
+    grid.maxPrice = m_max_price;
+    grid.tickSize = m_tick_size;
+    grid.levels = m_bids.size();
+    grid.epoch = m_gridEpoch;
+    grid.bestBidIndex = m_bestBidIndex;
+    grid.bestAskIndex = m_bestAskIndex;
+    grid.timestamp = m_lastUpdate;
+    return grid;
+}
+
+double LiveOrderBook::getMinPrice() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_min_price;
+}
+
+double LiveOrderBook::getMaxPrice() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_max_price;
+}
+
+double LiveOrderBook::getTickSize() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_tick_size;
+}
+
+double LiveOrderBook::index_to_price(size_t index) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return priceAtLocked(index);
+}
+
+void LiveOrderBook::setProductId(const std::string& productId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_productId = productId;
+}
+
+std::string LiveOrderBook::getProductId() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_productId;
+}
+
+std::chrono::system_clock::time_point LiveOrderBook::getLastUpdate() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lastUpdate;
 }
 
 size_t LiveOrderBook::getBidCount() const {
@@ -172,6 +311,288 @@ bool LiveOrderBook::isEmpty() const {
     return m_nonZeroBidCount == 0 && m_nonZeroAskCount == 0;
 }
 
+size_t LiveOrderBook::getBestBidIndex() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_bestBidIndex;
+}
+
+size_t LiveOrderBook::getBestAskIndex() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_bestAskIndex;
+}
+
+double LiveOrderBook::cumulativeBidDepth(double price) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return bidDepthLocked(price);
+}
+
+double LiveOrderBook::cumulativeAskDepth(double price) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return askDepthLocked(price);
+}
+
+void LiveOrderBook::sampleCumulativeDepth(double priceMin, double priceMax, size_t samples,
+                                          std::vector<double>& bidDepth, std::vector<double>& askDepth) const {
+    bidDepth.assign(samples, 0.0);
+    askDepth.assign(samples, 0.0);
+    if (samples == 0) return;
+
+    const double step = samples > 1 ? (priceMax - priceMin) / static_cast<double>(samples - 1) : 0.0;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (size_t i = 0; i < samples; ++i) {
+        const double price = priceMin + step * static_cast<double>(i);
+        bidDepth[i] = bidDepthLocked(price);
+        askDepth[i] = askDepthLocked(price);
+    }
+}
+
+// Tolerances absorb representation error so a price sitting on a tick counts that tick
+double LiveOrderBook::bidDepthLocked(double price) const {
+    const size_t size = m_bidDepth.size();
+    if (size == 0 || m_tick_size <= 0.0) return 0.0;
+
+    const double first = std::ceil((price - m_min_price) / m_tick_size - 1e-9);
+    const size_t firstIndex = first <= 0.0 ? 0 : static_cast<size_t>(std::min(first, static_cast<double>(size)));
+    // Clamp: float rounding in the incremental sums can leave a tiny negative residue
+    return std::max(0.0, m_bidDepth.prefix(size - firstIndex));
+}
+
+double LiveOrderBook::askDepthLocked(double price) const {
+    const size_t size = m_askDepth.size();
+    if (size == 0 || m_tick_size <= 0.0) return 0.0;
+
+    const double last = std::floor((price - m_min_price) / m_tick_size + 1e-9);
+    if (last < 0.0) return 0.0;
+    const size_t count = static_cast<size_t>(std::min(last + 1.0, static_cast<double>(size)));
+    return std::max(0.0, m_askDepth.prefix(count));
+}
+
+void LiveOrderBook::estimateMarketFills(bool buy, std::span<const double> notionals,
+                                        std::vector<MarketFill>& out) const {
+    out.clear();
+    out.reserve(notionals.size());
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (double notional : notionals) {
+        out.push_back(estimateFillLocked(buy, notional));
+    }
+}
+
+BookGrid LiveOrderBook::estimateMarketImpact(std::span<const double> notionals,
+                                             std::vector<MarketFill>& buys, std::vector<MarketFill>& sells) const {
+    buys.clear();
+    sells.clear();
+    buys.reserve(notionals.size());
+    sells.reserve(notionals.size());
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (double notional : notionals) {
+        buys.push_back(estimateFillLocked(true, notional));
+        sells.push_back(estimateFillLocked(false, notional));
+    }
+    return gridLocked();
+}
+
+void LiveOrderBook::ensureNotionalIndexLocked() const {
+    if (m_notionalIndexed) return;
+    m_bidNotional.assign(m_bids.size());
+    m_askNotional.assign(m_asks.size());
+    for (size_t i = m_bidOccupied.nextSet(0); i != OccupancyBitset::npos; i = m_bidOccupied.nextSet(i + 1)) {
+        m_bidNotional.add(depthSlot(true, i), m_bids[i] * priceAtLocked(i));
+    }
+    for (size_t i = m_askOccupied.nextSet(0); i != OccupancyBitset::npos; i = m_askOccupied.nextSet(i + 1)) {
+        m_askNotional.add(depthSlot(false, i), m_asks[i] * priceAtLocked(i));
+    }
+    m_notionalIndexed = true;
+}
+
+MarketFill LiveOrderBook::estimateFillLocked(bool buy, double notional) const {
+    ensureNotionalIndexLocked();
+    MarketFill fill;
+    fill.requestedNotional = notional;
+
+    const bool isBid = !buy;  // A buy sweeps the asks
+    const auto& quantities = isBid ? m_bidDepth : m_askDepth;
+    const auto& notionals = isBid ? m_bidNotional : m_askNotional;
+    const size_t best = isBid ? m_bestBidIndex : m_bestAskIndex;
+    const double available = notionals.total();
+    if (notional <= 0.0 || best == kNoLevel || available <= 0.0) {
+        return fill;
+    }
+
+    // Shave the full-book target so rounding residue in emptied slots cannot push the search past the last level
+    const double target = notional < available ? notional : available * (1.0 - 1e-9);
+    const size_t last = std::min(notionals.lowerBound(target), notionals.size()) - 1;  // Slot where the sweep stops
+    const size_t lastIndex = depthSlot(isBid, last);
+    const double lastPrice = priceAtLocked(lastIndex);
+
+    // Whole levels before the stopping slot, then the remainder at its price
+    const double throughNotional = notionals.prefix(last);
+    const double filledNotional = std::min(notional, available);
+    fill.filledNotional = filledNotional;
+    const double remainder = std::max(0.0, filledNotional - throughNotional);
+    fill.quantity = quantities.prefix(last) + (lastPrice > 0.0 ? remainder / lastPrice : 0.0);
+    fill.worstPrice = lastPrice;
+    if (fill.quantity > 0.0) {
+        fill.vwap = filledNotional / fill.quantity;
+        const double touch = priceAtLocked(best);
+        fill.slippageBps = (buy ? fill.vwap - touch : touch - fill.vwap) / touch * 10000.0;
+    }
+    return fill;
+}
+
+namespace {
+    constexpr double kFullDepthSpan = 0.25;           // ± share of the mid a full-depth book covers
+    constexpr double kWindowSpan = 0.02;              // ± share of the mid a windowed book covers...
+    constexpr size_t kMaxWindowLevels = size_t{1} << 18;  // ...capped at this many ticks (~12 MB with depth trees)
+    constexpr double kWindowRecenterMargin = 0.2;     // Windowed books follow the mid once it nears an edge
+
+    // Coarsest power-of-ten tick (at most $0.01, ~1e5 ticks per price decade) every snapshot price sits on
+    double inferTickSize(double mid, const std::vector<OrderBookLevel>& bids, const std::vector<OrderBookLevel>& asks) {
+        double tick = std::clamp(std::pow(10.0, std::floor(std::log10(mid)) - 5.0), 1e-8, 0.01);
+        auto onGrid = [&tick](const std::vector<OrderBookLevel>& levels) {
+            const size_t checked = std::min<size_t>(levels.size(), 64);
+            for (size_t i = 0; i < checked; ++i) {
+                const double ticks = levels[i].price / tick;
+                if (std::abs(ticks - std::round(ticks)) > 1e-6 * std::max(1.0, std::abs(ticks)) + 1e-9) return false;
+            }
+            return true;
+        };
+        while (tick > 1e-8 && !(onGrid(bids) && onGrid(asks))) tick /= 10.0;
+        return tick;
+    }
+
+    struct GridExtent {
+        double minPrice = 0.0;
+        double maxPrice = 0.0;
+    };
+
+    GridExtent gridAround(double mid, double tickSize, bool windowed) {
+        const double halfSpan = windowed
+            ? std::min(mid * kWindowSpan, 0.5 * static_cast<double>(kMaxWindowLevels - 1) * tickSize)
+            : mid * kFullDepthSpan;
+        const double minPrice = std::max(tickSize, std::floor((mid - halfSpan) / tickSize) * tickSize);
+        return {minPrice, minPrice + 2.0 * halfSpan};
+    }
+
+    double midOf(const BookGrid& grid) {
+        const double bid = grid.bestBidIndex == BookGrid::kNoLevel ? 0.0 : grid.priceAt(grid.bestBidIndex);
+        const double ask = grid.bestAskIndex == BookGrid::kNoLevel ? 0.0 : grid.priceAt(grid.bestAskIndex);
+        return (bid > 0.0 && ask > 0.0) ? 0.5 * (bid + ask) : std::max(bid, ask);
+    }
+
+    bool sameBucketSize(double a, double b) {
+        return std::abs(a - b) <= 1e-9 * std::max(std::abs(a), std::abs(b));
+    }
+
+    int64_t floorDiv(int64_t numerator, int64_t denominator) {
+        const int64_t quotient = numerator / denominator;
+        return (numerator % denominator != 0 && (numerator < 0) != (denominator < 0)) ? quotient - 1 : quotient;
+    }
+}
+
+int64_t LiveOrderBook::BucketView::keyOf(size_t index) const {
+    // round((offset + index) / ticksPerBucket), halves away from zero like std::round on positive prices
+    return floorDiv(2 * (gridOffsetTicks + static_cast<int64_t>(index)) + ticksPerBucket, 2 * ticksPerBucket);
+}
+
+bool LiveOrderBook::addBucketView(double bucketSize) {
+    if (!(bucketSize > 0.0)) return false;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (findBucketViewLocked(bucketSize)) return true;
+    BucketView view;
+    view.bucketSize = bucketSize;
+    rebuildBucketViewLocked(view);
+    m_bucketViews.push_back(std::move(view));
+    return true;
+}
+
+void LiveOrderBook::removeBucketView(double bucketSize) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::erase_if(m_bucketViews, [bucketSize](const BucketView& view) { return sameBucketSize(view.bucketSize, bucketSize); });
+}
+
+bool LiveOrderBook::hasBucketView(double bucketSize) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const BucketView* view = findBucketViewLocked(bucketSize);
+    return view && view->usable;
+}
+
+const LiveOrderBook::BucketView* LiveOrderBook::findBucketViewLocked(double bucketSize) const {
+    for (const auto& view : m_bucketViews) {
+        if (sameBucketSize(view.bucketSize, bucketSize)) return &view;
+    }
+    return nullptr;
+}
+
+// O(grid) — only on addBucketView and initialize; level changes after that are incremental
+void LiveOrderBook::rebuildBucketViewLocked(BucketView& view) const {
+    view.bids.clear();
+    view.asks.clear();
+    view.bidLevels.clear();
+    view.askLevels.clear();
+    view.usable = false;
+    if (m_tick_size <= 0.0 || m_bids.empty()) return;
+
+    const double ratio = view.bucketSize / m_tick_size;
+    const int64_t ticksPerBucket = std::llround(ratio);
+    if (ticksPerBucket < 1 || std::abs(ratio - static_cast<double>(ticksPerBucket)) > 1e-6 * ratio) return;
+
+    view.ticksPerBucket = ticksPerBucket;
+    view.gridOffsetTicks = std::llround(m_min_price / m_tick_size);
+    view.firstKey = 0;
+    view.firstKey = view.keyOf(0);
+    const size_t buckets = view.bucketOf(m_bids.size() - 1) + 1;
+    view.bids.assign(buckets, 0.0);
+    view.asks.assign(buckets, 0.0);
+    view.bidLevels.assign(buckets, 0);
+    view.askLevels.assign(buckets, 0);
+    if (m_nonZeroBidCount == 0 && m_nonZeroAskCount == 0) {
+        view.usable = true;
+        return;
+    }
+    for (size_t i = 0; i < m_bids.size(); ++i) {
+        const size_t bucket = view.bucketOf(i);
+        if (m_bids[i] > 0.0) { view.bids[bucket] += m_bids[i]; ++view.bidLevels[bucket]; }
+        if (m_asks[i] > 0.0) { view.asks[bucket] += m_asks[i]; ++view.askLevels[bucket]; }
+    }
+    view.usable = true;
+}
+
+bool LiveOrderBook::captureBuckets(double bucketSize,
+                                   std::vector<std::pair<double, double>>& bidBuffer,
+                                   std::vector<std::pair<double, double>>& askBuffer,
+                                   size_t maxPerSide,
+                                   BucketSnapshotView& out) const {
+    bidBuffer.clear();
+    askBuffer.clear();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const BucketView* view = findBucketViewLocked(bucketSize);
+    if (!view || !view->usable) return false;
+
+    auto bucketPrice = [view](size_t bucket) {
+        return static_cast<double>(view->firstKey + static_cast<int64_t>(bucket)) * view->bucketSize;
+    };
+
+    // Nothing beyond the best level is populated, so each side starts at its touch bucket
+    if (m_bestBidIndex != kNoLevel) {
+        for (size_t b = view->bucketOf(m_bestBidIndex) + 1; b-- > 0 && bidBuffer.size() < maxPerSide; ) {
+            if (view->bidLevels[b] > 0) bidBuffer.emplace_back(bucketPrice(b), view->bids[b]);
+        }
+    }
+    if (m_bestAskIndex != kNoLevel) {
+        for (size_t b = view->bucketOf(m_bestAskIndex); b < view->asks.size() && askBuffer.size() < maxPerSide; ++b) {
+            if (view->askLevels[b] > 0) askBuffer.emplace_back(bucketPrice(b), view->asks[b]);
+        }
+    }
+
+    out.bucketSize = view->bucketSize;
+    out.bestBidQuantity = m_bestBidIndex == kNoLevel ? 0.0 : m_bids[m_bestBidIndex];
+    out.bestAskQuantity = m_bestAskIndex == kNoLevel ? 0.0 : m_asks[m_bestAskIndex];
+    out.timestamp = m_lastUpdate;
+    out.bidBuckets = std::span<const std::pair<double, double>>(bidBuffer.data(), bidBuffer.size());
+    out.askBuckets = std::span<const std::pair<double, double>>(askBuffer.data(), askBuffer.size());
+    return true;
+}
+
 void LiveOrderBook::applyLevelLocked(bool isBid,
                                      double price,
                                      double quantity,
@@ -208,14 +629,45 @@ void LiveOrderBook::applyLevelLocked(bool isBid,
     }
 
     if (wasNonZero != isNonZero) {
+        auto& occupied = isBid ? m_bidOccupied : m_askOccupied;
         if (isNonZero) {
             ++nonZeroLevels;
-        } else if (nonZeroLevels > 0) {
-            --nonZeroLevels;
+            occupied.set(index);
+        } else {
+            if (nonZeroLevels > 0) --nonZeroLevels;
+            occupied.reset(index);
         }
     }
 
     slot = newValue;
+    const size_t depthIndex = depthSlot(isBid, index);
+    (isBid ? m_bidDepth : m_askDepth).add(depthIndex, newValue - previous);
+    if (m_notionalIndexed) {
+        (isBid ? m_bidNotional : m_askNotional).add(depthIndex, (newValue - previous) * priceAtLocked(index));
+    }
+
+    for (auto& view : m_bucketViews) {
+        if (!view.usable) continue;
+        const size_t bucket = view.bucketOf(index);
+        uint32_t& populated = (isBid ? view.bidLevels : view.askLevels)[bucket];
+        double& bucketQuantity = (isBid ? view.bids : view.asks)[bucket];
+        if (wasNonZero != isNonZero) {
+            populated = isNonZero ? populated + 1 : populated - 1;
+        }
+        bucketQuantity = populated == 0 ? 0.0 : bucketQuantity + (newValue - previous);
+    }
+
+    // Best level: O(1) on improvement; when the best level empties, the occupancy bitset skips
+    // empty 64-level words instead of walking the dense grid away from the touch
+    size_t& best = isBid ? m_bestBidIndex : m_bestAskIndex;
+    if (isNonZero) {
+        if (best == kNoLevel || (isBid ? index > best : index < best)) {
+            best = index;
+        }
+    } else if (index == best) {
+        const size_t next = isBid ? m_bidOccupied.prevSet(index) : m_askOccupied.nextSet(index + 1);
+        best = next == OccupancyBitset::npos ? kNoLevel : next;
+    }
 
     if (totalVolume < 0.0) {
         totalVolume = 0.0;
@@ -236,14 +688,26 @@ void DataCache::initializeLiveOrderBook(const std::string& symbol, const std::ve
     auto& liveBook = m_liveBooks[symbol];
     liveBook.setProductId(symbol);
 
-    // TODO: dynamically set the price range based on the current price
-    // Use reasonable price ranges to avoid massive memory waste
-    if (symbol == "BTC-USD") {
-        // BTC: ±$25k around $100k = [75k, 125k] = 5M entries instead of 20M
-        liveBook.initialize(75000.0, 125000.0, 0.01);
-    } else {
-        // Default reasonable range for other crypto pairs
-        liveBook.initialize(75000.0, 125000.0, 0.01);
+    // No levels to size from: the historical BTC grid, [75k, 125k] at $0.01
+    double minPrice = 75000.0;
+    double maxPrice = 125000.0;
+    double tickSize = 0.01;
+    const double bestBid = bids.empty() ? 0.0 : std::max_element(bids.begin(), bids.end(),
+        [](const OrderBookLevel& a, const OrderBookLevel& b) { return a.price < b.price; })->price;
+    const double bestAsk = asks.empty() ? 0.0 : std::min_element(asks.begin(), asks.end(),
+        [](const OrderBookLevel& a, const OrderBookLevel& b) { return a.price < b.price; })->price;
+    const double mid = (bestBid > 0.0 && bestAsk > 0.0) ? 0.5 * (bestBid + bestAsk) : std::max(bestBid, bestAsk);
+    if (mid > 0.0) {
+        // Sized from the snapshot: BTC at $100k full depth is still [75k, 125k] = 5M ticks, while a
+        // windowed book holds at most kMaxWindowLevels ticks around the mid
+        tickSize = inferTickSize(mid, bids, asks);
+        const GridExtent grid = gridAround(mid, tickSize, isWindowedLocked(symbol));
+        minPrice = grid.minPrice;
+        maxPrice = grid.maxPrice;
+    }
+    liveBook.initialize(minPrice, maxPrice, tickSize);
+    for (const BookBucketView& view : m_bookBucketViews) {
+        liveBook.addBucketView(view.bucketSize);
     }
 
     // Apply the snapshot levels to the new book structure - Use exchange timestamp
@@ -261,24 +725,45 @@ void DataCache::initializeLiveOrderBook(const std::string& symbol, const std::ve
     sLog_Data(QString(" DataCache: Initialized O(1) LiveOrderBook for %1").arg(QString::fromStdString(symbol)));
 }
 
-void DataCache::applyLiveOrderBookUpdates(const std::string& symbol,
-                                          std::span<const BookLevelUpdate> updates,
-                                          std::chrono::system_clock::time_point exchange_timestamp,
-                                          std::vector<BookDelta>& outDeltas) {
+BookGrid DataCache::applyLiveOrderBookUpdates(const std::string& symbol,
+                                              std::span<const BookLevelUpdate> updates,
+                                              std::chrono::system_clock::time_point exchange_timestamp,
+                                              std::vector<BookDelta>& outDeltas) {
+    BookGrid grid;
+    {
+        // Shared: a batch that keeps the grid only touches the book's own storage under its mutex,
+        // so venues and products update in parallel
+        std::shared_lock<std::shared_mutex> lock(m_mxLiveBooks);
+        auto it = m_liveBooks.find(symbol);
+        if (it == m_liveBooks.end()) {
+            // If book doesn't exist, we can't initialize it without a snapshot.
+            // The first message for a product MUST be a snapshot.
+            static std::atomic<int> missing_count{0};
+            const int hits = ++missing_count;
+            if (hits % 100 == 1) { // Log every 100th time
+                 sLog_Data(QString(" Dropping update for uninitialized live book '%1'. Waiting for snapshot. [Hit #%2]")
+                            .arg(QString::fromStdString(symbol)).arg(hits));
+            }
+            outDeltas.clear();
+            return grid;
+        }
+        if (!isWindowedLocked(symbol) || !it->second.isNearEdge(kWindowRecenterMargin)) {
+            it->second.applyUpdates(updates, exchange_timestamp, &outDeltas, &grid);  // Pass exchange timestamp
+            return grid;
+        }
+    }
+
+    // A re-centre reallocates the grid, so it runs under the exclusive lock like a snapshot does
     std::unique_lock<std::shared_mutex> lock(m_mxLiveBooks);
-    
     auto it = m_liveBooks.find(symbol);
-    if (it != m_liveBooks.end()) {
-        it->second.applyUpdates(updates, exchange_timestamp, &outDeltas);  // Pass exchange timestamp
-    } else {
-        // If book doesn't exist, we can't initialize it without a snapshot.
-        // The first message for a product MUST be a snapshot.
-        static int missing_count = 0;
-        if (++missing_count % 100 == 1) { // Log every 100th time
-             sLog_Data(QString(" Dropping update for uninitialized live book '%1'. Waiting for snapshot. [Hit #%2]")
-                        .arg(QString::fromStdString(symbol)).arg(missing_count));
-        }
+    if (it == m_liveBooks.end()) {
+        outDeltas.clear();
+        return grid;
     }
+    // Before the batch, so every delta it produces already refers to the moved grid
+    if (isWindowedLocked(symbol)) it->second.recenterIfNearEdge(kWindowRecenterMargin);
+    it->second.applyUpdates(updates, exchange_timestamp, &outDeltas, &grid);
+    return grid;
 }
 
 std::shared_ptr<const OrderBook> DataCache::getLiveOrderBook(const std::string& symbol) const {
@@ -289,28 +774,13 @@ std::shared_ptr<const OrderBook> DataCache::getLiveOrderBook(const std::string&
         const auto& liveBook = it->second;
         auto book = std::make_shared<OrderBook>();
         book->product_id = liveBook.getProductId();
-        book->timestamp = liveBook.getLastUpdate();  // Use exchange timestamp, not system time!
-
-        // Convert dense LiveOrderBook to sparse OrderBook format
-        const auto& denseBids = liveBook.getBids();
-        const auto& denseAsks = liveBook.getAsks();
-        
-        // Convert bids (scan from highest to lowest price)
-        for (size_t i = denseBids.size(); i-- > 0; ) {
-            if (denseBids[i] > 0.0) {
-                double price = liveBook.getMinPrice() + (static_cast<double>(i) * liveBook.getTickSize());
-                book->bids.push_back(OrderBookLevel{price, denseBids[i]});
-            }
-        }
-        
-        // Convert asks (scan from lowest to highest price)
-        for (size_t i = 0; i < denseAsks.size(); ++i) {
-            if (denseAsks[i] > 0.0) {
-                double price = liveBook.getMinPrice() + (static_cast<double>(i) * liveBook.getTickSize());
-                book->asks.push_back(OrderBookLevel{price, denseAsks[i]});
-            }
-        }
-        
+
+        // Convert dense LiveOrderBook to sparse OrderBook format: bids highest first, asks lowest first,
+        // levels and timestamp from one locked read
+        const BookGrid grid = liveBook.captureLevels(std::numeric_limits<double>::lowest(),
+                                                     std::numeric_limits<double>::max(),
+                                                     book->bids, book->asks);
+        book->timestamp = grid.timestamp;  // Use exchange timestamp, not system time!
         return book;
     }
     
@@ -330,6 +800,111 @@ const LiveOrderBook& DataCache::getDirectLiveOrderBook(const std::string& symbol
     return empty;
 } 
 
+void DataCache::addBookBucketView(double bucketSize) {
+    if (!(bucketSize > 0.0)) return;
+    std::lock_guard<std::mutex> viewsLock(m_mxBucketViews);
+    {
+        std::unique_lock<std::shared_mutex> lock(m_mxLiveBooks);
+        auto it = std::find_if(m_bookBucketViews.begin(), m_bookBucketViews.end(),
+                               [bucketSize](const BookBucketView& view) { return sameBucketSize(view.bucketSize, bucketSize); });
+        if (it != m_bookBucketViews.end()) {
+            ++it->refs;
+            return;
+        }
+        // Books initialized from here on pick the view up themselves
+        m_bookBucketViews.push_back({bucketSize, 1});
+    }
+    // O(grid) per book, each under its own mutex: the map lock stays shared so updates keep flowing
+    std::shared_lock<std::shared_mutex> lock(m_mxLiveBooks);
+    for (auto& [symbol, book] : m_liveBooks) {
+        book.addBucketView(bucketSize);
+    }
+}
+
+void DataCache::removeBookBucketView(double bucketSize) {
+    if (!(bucketSize > 0.0)) return;
+    std::lock_guard<std::mutex> viewsLock(m_mxBucketViews);
+    {
+        std::unique_lock<std::shared_mutex> lock(m_mxLiveBooks);
+        auto it = std::find_if(m_bookBucketViews.begin(), m_bookBucketViews.end(),
+                               [bucketSize](const BookBucketView& view) { return sameBucketSize(view.bucketSize, bucketSize); });
+        if (it == m_bookBucketViews.end() || --it->refs > 0) return;
+        m_bookBucketViews.erase(it);
+    }
+    std::shared_lock<std::shared_mutex> lock(m_mxLiveBooks);
+    for (auto& [symbol, book] : m_liveBooks) {
+        book.removeBucketView(bucketSize);
+    }
+}
+
+void DataCache::setPrimaryBookSymbol(const std::string& symbol) {
+    std::vector<std::pair<std::string, bool>> resized;  // (book, windowed)
+    {
+        std::unique_lock<std::shared_mutex> lock(m_mxLiveBooks);
+        if (symbol == m_primaryBookSymbol) return;
+        const std::string previous = std::exchange(m_primaryBookSymbol, symbol);
+        if (previous.empty()) {
+            // Every book was full depth until now
+            for (const auto& [key, book] : m_liveBooks) {
+                if (key != symbol) resized.emplace_back(key, true);
+            }
+        } else {
+            resized.emplace_back(previous, true);
+        }
+        resized.emplace_back(symbol, false);
+    }
+
+    // Books that already exist move to their new extent around the current mid, levels kept. O(grid) each,
+    // one book at a time under its own mutex; the regrid bumps the book's epoch, so delta batches stamped
+    // before it still map against the grid they were produced on. The map lock stays shared: feeds keep flowing.
+    std::shared_lock<std::shared_mutex> lock(m_mxLiveBooks);
+    for (const auto& [key, windowed] : resized) {
+        auto it = m_liveBooks.find(key);
+        if (key.empty() || it == m_liveBooks.end()) continue;
+        LiveOrderBook& book = it->second;
+        const BookGrid current = book.grid();
+        const double mid = midOf(current);
+        if (mid <= 0.0 || current.tickSize <= 0.0) continue;
+        const GridExtent grid = gridAround(mid, current.tickSize, windowed);
+        book.regrid(grid.minPrice, grid.maxPrice);
+    }
+}
+
+std::vector<std::string> DataCache::liveBookSymbols() const {
+    std::shared_lock<std::shared_mutex> lock(m_mxLiveBooks);
+    std::vector<std::string> symbols;
+    symbols.reserve(m_liveBooks.size());
+    for (const auto& [symbol, book] : m_liveBooks) symbols.push_back(symbol);
+    return symbols;
+}
+
+std::vector<std::string> DataCache::tradeSymbols() const {
+    std::shared_lock<std::shared_mutex> lock(m_mxTrades);
+    std::vector<std::string> symbols;
+    symbols.reserve(m_trades.size());
+    for (const auto& [symbol, ring] : m_trades) symbols.push_back(symbol);
+    return symbols;
+}
+
+bool DataCache::restoreLiveOrderBook(const std::string& symbol,
+                                     double minPrice, double maxPrice, double tickSize,
+                                     std::span<const BookLevelUpdate> levels,
+                                     std::chrono::system_clock::time_point exchange_timestamp) {
+    // Same grid as the checkpointed book, so restored indices line up with deltas consumers already hold.
+    // The book stays stale until the next live snapshot re-initializes it and replaces every restored level.
+    std::unique_lock<std::shared_mutex> lock(m_mxLiveBooks);
+    auto& liveBook = m_liveBooks[symbol];
+    if (!liveBook.isEmpty()) return false;  // The live snapshot got here first
+    liveBook.setProductId(symbol);
+    liveBook.initialize(minPrice, maxPrice, tickSize);
+    for (const BookBucketView& view : m_bookBucketViews) {
+        liveBook.addBucketView(view.bucketSize);
+    }
+    liveBook.applyUpdates(levels, exchange_timestamp, nullptr);
+    liveBook.markStale();
+    return true;
+}
+
 // LiveOrderBook: captureDenseNonZero implementation
 LiveOrderBook::DenseBookSnapshotView LiveOrderBook::captureDenseNonZero(
     std::vector<std::pair<uint32_t, double>>& bidBuffer,
@@ -342,8 +917,10 @@ LiveOrderBook::DenseBookSnapshotView LiveOrderBook::captureDenseNonZero(
     bidBuffer.reserve(std::min(maxPerSide, m_bids.size()));
     askBuffer.reserve(std::min(maxPerSide, m_asks.size()));
 
-    // Collect non-zero bids from high to low (best bid downward)
-    for (size_t i = m_bids.size(); i-- > 0 && bidBuffer.size() < maxPerSide; ) {
+    // Collect non-zero bids from high to low (best bid downward). Nothing above the best bid
+    // is populated, so the scan starts there instead of at the top of the 5M-level grid.
+    const size_t bidStart = m_bestBidIndex == kNoLevel ? 0 : std::min(m_bestBidIndex + 1, m_bids.size());
+    for (size_t i = bidStart; i-- > 0 && bidBuffer.size() < maxPerSide; ) {
         double qty = m_bids[i];
         if (qty > 0.0) {
             bidBuffer.emplace_back(static_cast<uint32_t>(i), qty);
@@ -351,7 +928,8 @@ LiveOrderBook::DenseBookSnapshotView LiveOrderBook::captureDenseNonZero(
     }
 
     // Collect non-zero asks from low to high (best ask upward)
-    for (size_t i = 0; i < m_asks.size() && askBuffer.size() < maxPerSide; ++i) {
+    const size_t askStart = m_bestAskIndex == kNoLevel ? m_asks.size() : m_bestAskIndex;
+    for (size_t i = askStart; i < m_asks.size() && askBuffer.size() < maxPerSide; ++i) {
         double qty = m_asks[i];
         if (qty > 0.0) {
             askBuffer.emplace_back(static_cast<uint32_t>(i), qty);
@@ -360,9 +938,36 @@ LiveOrderBook::DenseBookSnapshotView LiveOrderBook::captureDenseNonZero(
 
     DenseBookSnapshotView view;
     view.minPrice = m_min_price;
+    view.maxPrice = m_max_price;
     view.tickSize = m_tick_size;
+    view.epoch = m_gridEpoch;
     view.timestamp = m_lastUpdate; // exchange timestamp
     view.bidLevels = std::span<const std::pair<uint32_t, double>>(bidBuffer.data(), bidBuffer.size());
     view.askLevels = std::span<const std::pair<uint32_t, double>>(askBuffer.data(), askBuffer.size());
     return view;
 }
+
+BookGrid LiveOrderBook::captureLevels(double priceMin, double priceMax,
+                                      std::vector<OrderBookLevel>& bids, std::vector<OrderBookLevel>& asks) const {
+    bids.clear();
+    asks.clear();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_tick_size <= 0.0 || m_bids.empty() || priceMax < priceMin) return gridLocked();
+
+    // Clamp the price range to grid indices; tolerances keep a price sitting on a tick inside
+    const double size = static_cast<double>(m_bids.size());
+    const double first = std::clamp(std::ceil((priceMin - m_min_price) / m_tick_size - 1e-9), 0.0, size);
+    const double last = std::clamp(std::floor((priceMax - m_min_price) / m_tick_size + 1e-9), -1.0, size - 1.0);
+    if (last < first) return gridLocked();
+    const size_t lo = static_cast<size_t>(first);
+    const size_t hi = static_cast<size_t>(last);
+
+    // Populated levels only, walked through the occupancy bitsets
+    for (size_t i = m_bidOccupied.prevSet(hi + 1); i != OccupancyBitset::npos && i >= lo; i = m_bidOccupied.prevSet(i)) {
+        bids.push_back(OrderBookLevel{priceAtLocked(i), m_bids[i]});
+    }
+    for (size_t i = m_askOccupied.nextSet(lo); i != OccupancyBitset::npos && i <= hi; i = m_askOccupied.nextSet(i + 1)) {
+        asks.push_back(OrderBookLevel{priceAtLocked(i), m_asks[i]});
+    }
+    return gridLocked();
+}
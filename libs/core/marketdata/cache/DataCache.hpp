@@ -15,6 +15,7 @@ Assumptions: Manages data for multiple independent products, identified by strin
 // ─────────────────────────────────────────────────────────────
 #include <unordered_map>
 #include <vector>
+#include <mutex>
 #include <shared_mutex>
 #include <memory>
 #include <span>
@@ -63,16 +64,38 @@ public:
                                  const std::vector<OrderBookLevel>& bids,
                                  const std::vector<OrderBookLevel>& asks,
                                  std::chrono::system_clock::time_point exchange_timestamp);
-    void applyLiveOrderBookUpdates(const std::string& symbol,
-                                   std::span<const BookLevelUpdate> updates,
-                                   std::chrono::system_clock::time_point exchange_timestamp,
-                                   std::vector<BookDelta>& outDeltas);
+    // Returns the grid outDeltas index (and the touch after the batch); consumers map the batch through it,
+    // never through the book's current geometry, which may have moved on by the time they run
+    BookGrid applyLiveOrderBookUpdates(const std::string& symbol,
+                                       std::span<const BookLevelUpdate> updates,
+                                       std::chrono::system_clock::time_point exchange_timestamp,
+                                       std::vector<BookDelta>& outDeltas);
     
     // Remove in cleanup - kept for backwards compatibility during transition
     [[nodiscard]] std::shared_ptr<const OrderBook> getLiveOrderBook(const std::string& symbol) const;
     
-    // Direct dense access (no conversion)
+    // Direct dense access (no conversion). The reference outlives the map lock, but its grid can be rebuilt at any
+    // time: read through the book's locked accessors (grid(), captureDenseNonZero, captureLevels), never cache geometry.
     [[nodiscard]] const LiveOrderBook& getDirectLiveOrderBook(const std::string& symbol) const;
+
+    // Coarse bucket view (LiveOrderBook::addBucketView) on every live book, current and future.
+    // Reference counted: each add is paired with a remove, and the view leaves every book with the last one.
+    void addBookBucketView(double bucketSize);
+    void removeBookBucketView(double bucketSize);
+
+    // The charted product's book spans ±25% of its mid; every other book (grid tiles, SYMBOL@VENUE)
+    // gets a narrow window that follows the mid. Empty = every book is full depth.
+    void setPrimaryBookSymbol(const std::string& symbol);
+
+    // Checkpoint support: enumerate stored products and rebuild a book on an explicit grid.
+    // restoreLiveOrderBook leaves a book that already holds live levels untouched and returns false;
+    // a restored book is marked stale (LiveOrderBook::isStale) until its first live snapshot.
+    [[nodiscard]] std::vector<std::string> liveBookSymbols() const;
+    [[nodiscard]] std::vector<std::string> tradeSymbols() const;
+    bool restoreLiveOrderBook(const std::string& symbol,
+                              double minPrice, double maxPrice, double tickSize,
+                              std::span<const BookLevelUpdate> levels,
+                              std::chrono::system_clock::time_point exchange_timestamp);
     
 
 private:
@@ -84,4 +107,14 @@ private:
     std::unordered_map<std::string, TradeRing>    m_trades;
     std::unordered_map<std::string, OrderBook>    m_books;
     std::unordered_map<std::string, LiveOrderBook> m_liveBooks; //  NEW: Stateful order books
+    struct BookBucketView {
+        double bucketSize = 0.0;
+        int refs = 0;
+    };
+    mutable std::mutex m_mxBucketViews;             // Serializes add/removeBookBucketView; taken before m_mxLiveBooks
+    std::vector<BookBucketView> m_bookBucketViews;  // Guarded by m_mxLiveBooks
+    std::string m_primaryBookSymbol;                                // Guarded by m_mxLiveBooks
+    bool isWindowedLocked(const std::string& symbol) const {
+        return !m_primaryBookSymbol.empty() && symbol != m_primaryBookSymbol;
+    }
 }; 
@@ -0,0 +1,266 @@
+/*
+Sentinel — ConsolidatedBook
+Role: Implements paged atomic level storage, venue grid mapping, and the per-venue best → consolidated best fold.
+Inputs/Outputs: See ConsolidatedBook.hpp.
+Threading: Every mutation holds m_writeMutex; readers only perform atomic loads.
+Performance: A delta touches one venue slot and re-sums at most kMaxVenues contributions for its tick (plus the few
+             finer venue levels sharing it).
+Integration: See ConsolidatedBook.hpp.
+Observability: Warns once per venue whose tick is finer than the consolidated grid.
+Related: ConsolidatedBook.hpp, FeedAggregator.cpp.
+Assumptions: Re-summing a tick from venue contributions (instead of adding differences) keeps totals free of drift.
+*/
+#include "ConsolidatedBook.hpp"
+#include "SentinelLogging.hpp"
+#include <algorithm>
+#include <cmath>
+#include <QString>
+
+template <typename T>
+void ConsolidatedBook::PagedLevels<T>::init(size_t pageCount) {
+    directory = std::make_unique<std::atomic<Page*>[]>(pageCount);
+    for (size_t i = 0; i < pageCount; ++i) {
+        directory[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+T ConsolidatedBook::PagedLevels<T>::load(size_t index) const {
+    const Page* p = page(index >> kPageShift);
+    return p ? p->values[index & kPageMask].load(std::memory_order_relaxed) : T{};
+}
+
+template <typename T>
+void ConsolidatedBook::PagedLevels<T>::store(size_t index, T value) {
+    Page* p = directory[index >> kPageShift].load(std::memory_order_relaxed);
+    if (!p) {
+        if (value == T{}) return;  // Untouched pages read as zero already
+        owned.push_back(std::make_unique<Page>());
+        p = owned.back().get();
+        directory[index >> kPageShift].store(p, std::memory_order_release);
+    }
+    p->values[index & kPageMask].store(value, std::memory_order_relaxed);
+}
+
+ConsolidatedBook::ConsolidatedBook(double minPrice, double tickSize, size_t levelCount)
+    : m_minPrice(minPrice)
+    , m_tickSize(tickSize > 0.0 ? tickSize : 1.0)
+    , m_levelCount(levelCount)
+    , m_pageCount((levelCount + kPageSize - 1) >> kPageShift) {
+    m_bidTotals.init(m_pageCount);
+    m_askTotals.init(m_pageCount);
+}
+
+ConsolidatedBook::~ConsolidatedBook() = default;
+
+size_t ConsolidatedBook::indexOf(double price) const {
+    const long long index = std::llround((price - m_minPrice) / m_tickSize);
+    if (index < 0 || static_cast<size_t>(index) >= m_levelCount) return kNoLevel;
+    return static_cast<size_t>(index);
+}
+
+double ConsolidatedBook::quantityAt(bool isBid, size_t index) const {
+    if (index >= m_levelCount) return 0.0;
+    return (isBid ? m_bidTotals : m_askTotals).load(index);
+}
+
+double ConsolidatedBook::venueQuantityAt(size_t slot, bool isBid, size_t index) const {
+    if (slot >= venueCount() || index >= m_levelCount) return 0.0;
+    const VenueState& venue = *m_venues[slot];
+    return (isBid ? venue.bids : venue.asks).load(index);
+}
+
+int ConsolidatedBook::venueSlot(const std::string& venue) const {
+    const size_t count = venueCount();
+    for (size_t i = 0; i < count; ++i) {
+        if (m_venueNames[i] == venue) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+size_t ConsolidatedBook::topLevels(bool isBid, size_t maxLevels,
+                                   std::vector<std::pair<uint32_t, double>>& out) const {
+    out.clear();
+    const size_t best = isBid ? bestBidIndex() : bestAskIndex();
+    if (best == kNoLevel || best >= m_levelCount) return 0;
+
+    const PagedLevels<double>& totals = isBid ? m_bidTotals : m_askTotals;
+    size_t i = best;
+    while (out.size() < maxLevels) {
+        const auto* page = totals.page(i >> kPageShift);
+        if (!page) {
+            // Skip the whole untouched page
+            if (isBid) {
+                if ((i >> kPageShift) == 0) break;
+                i = ((i >> kPageShift) << kPageShift) - 1;
+            } else {
+                i = ((i >> kPageShift) + 1) << kPageShift;
+                if (i >= m_levelCount) break;
+            }
+            continue;
+        }
+        const double qty = page->values[i & kPageMask].load(std::memory_order_relaxed);
+        if (qty > 0.0) out.emplace_back(static_cast<uint32_t>(i), qty);
+        if (isBid) {
+            if (i == 0) break;
+            --i;
+        } else {
+            if (++i >= m_levelCount) break;
+        }
+    }
+    return out.size();
+}
+
+void ConsolidatedBook::applySnapshot(const std::string& venue, double venueMinPrice, double venueTickSize,
+                                     std::span<const BookDelta> levels, size_t venueBestBid, size_t venueBestAsk) {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    const int slot = slotForLocked(venue);
+    if (slot < 0) return;
+
+    VenueState& state = *m_venues[slot];
+    clearVenueLocked(static_cast<size_t>(slot));
+    state.minPrice = venueMinPrice;
+    state.tickSize = venueTickSize > 0.0 ? venueTickSize : m_tickSize;
+    state.sameTick = std::abs(state.tickSize - m_tickSize) < m_tickSize * 1e-9;
+    state.indexOffset = std::llround((venueMinPrice - m_minPrice) / m_tickSize);
+    if (state.tickSize < m_tickSize * (1.0 - 1e-9)) {
+        sLog_Warning("ConsolidatedBook: venue" << QString::fromStdString(venue) << "tick" << state.tickSize
+                     << "is finer than the consolidated tick" << m_tickSize << "- levels will snap");
+    }
+
+    for (const auto& level : levels) {
+        applyVenueLevelLocked(static_cast<size_t>(slot), level.isBid, level.idx, level.qty);
+    }
+    updateVenueBestLocked(static_cast<size_t>(slot), venueBestBid, venueBestAsk);
+    publishBestLocked();
+    m_version.fetch_add(1, std::memory_order_release);
+}
+
+void ConsolidatedBook::applyDeltas(const std::string& venue, std::span<const BookDelta> deltas,
+                                   size_t venueBestBid, size_t venueBestAsk) {
+    std::lock_guard<std::mutex> lock(m_writeMutex);
+    const int slot = venueSlot(venue);
+    if (slot < 0) return;
+
+    for (const auto& delta : deltas) {
+        applyVenueLevelLocked(static_cast<size_t>(slot), delta.isBid, delta.idx, delta.qty);
+    }
+    updateVenueBestLocked(static_cast<size_t>(slot), venueBestBid, venueBestAsk);
+    publishBestLocked();
+    m_version.fetch_add(1, std::memory_order_release);
+}
+
+bool ConsolidatedBook::venueGridMatches(const std::string& venue, double venueMinPrice, double venueTickSize) const {
+    const int slot = venueSlot(venue);
+    if (slot < 0) return false;
+    const VenueState& state = *m_venues[slot];
+    return state.minPrice == venueMinPrice && state.tickSize == venueTickSize;
+}
+
+int ConsolidatedBook::slotForLocked(const std::string& venue) {
+    const int existing = venueSlot(venue);
+    if (existing >= 0) return existing;
+
+    const size_t slot = m_venueCount.load(std::memory_order_relaxed);
+    if (slot >= kMaxVenues) {
+        sLog_Warning("ConsolidatedBook: venue limit reached, ignoring" << QString::fromStdString(venue));
+        return -1;
+    }
+    auto state = std::make_unique<VenueState>();
+    state->bids.init(m_pageCount);
+    state->asks.init(m_pageCount);
+    m_venues[slot] = std::move(state);
+    m_venueNames[slot] = venue;
+    m_venueCount.store(slot + 1, std::memory_order_release);
+    return static_cast<int>(slot);
+}
+
+size_t ConsolidatedBook::toConsolidatedLocked(const VenueState& venue, size_t venueIndex) const {
+    if (venueIndex == LiveOrderBook::kNoLevel) return kNoLevel;
+    if (venue.sameTick) {
+        const int64_t index = static_cast<int64_t>(venueIndex) + venue.indexOffset;
+        return (index < 0 || static_cast<size_t>(index) >= m_levelCount) ? kNoLevel : static_cast<size_t>(index);
+    }
+    return indexOf(venue.minPrice + static_cast<double>(venueIndex) * venue.tickSize);
+}
+
+void ConsolidatedBook::applyVenueLevelLocked(size_t slot, bool isBid, size_t venueIndex, float quantity) {
+    VenueState& state = *m_venues[slot];
+    const size_t index = toConsolidatedLocked(state, venueIndex);
+    if (index == kNoLevel) return;
+    if (state.sameTick) {
+        setLevelLocked(slot, isBid, index, quantity);
+        return;
+    }
+
+    // Several finer venue levels snap to this tick: keep each one, so a write or delete leaves its siblings intact
+    auto& snapped = isBid ? state.snappedBids : state.snappedAsks;
+    auto& sources = snapped[index];
+    auto it = std::find_if(sources.begin(), sources.end(),
+                           [venueIndex](const auto& source) { return source.first == venueIndex; });
+    if (quantity > 0.0f) {
+        if (it != sources.end()) {
+            it->second = quantity;
+        } else {
+            sources.emplace_back(venueIndex, quantity);
+        }
+    } else if (it != sources.end()) {
+        *it = sources.back();
+        sources.pop_back();
+    }
+    double sum = 0.0;
+    for (const auto& source : sources) sum += source.second;
+    if (sources.empty()) snapped.erase(index);
+    setLevelLocked(slot, isBid, index, static_cast<float>(sum));
+}
+
+void ConsolidatedBook::setLevelLocked(size_t slot, bool isBid, size_t index, float quantity) {
+    auto& contribution = isBid ? m_venues[slot]->bids : m_venues[slot]->asks;
+    contribution.store(index, quantity > 0.0f ? quantity : 0.0f);
+
+    double total = 0.0;
+    const size_t count = m_venueCount.load(std::memory_order_relaxed);
+    for (size_t v = 0; v < count; ++v) {
+        total += (isBid ? m_venues[v]->bids : m_venues[v]->asks).load(index);
+    }
+    (isBid ? m_bidTotals : m_askTotals).store(index, total);
+}
+
+void ConsolidatedBook::clearVenueLocked(size_t slot) {
+    VenueState& state = *m_venues[slot];
+    for (const bool isBid : {true, false}) {
+        auto& contribution = isBid ? state.bids : state.asks;
+        for (size_t p = 0; p < m_pageCount; ++p) {
+            const auto* page = contribution.page(p);
+            if (!page) continue;
+            for (size_t i = 0; i < kPageSize; ++i) {
+                if (page->values[i].load(std::memory_order_relaxed) > 0.0f) {
+                    setLevelLocked(slot, isBid, (p << kPageShift) + i, 0.0f);
+                }
+            }
+        }
+    }
+    state.snappedBids.clear();
+    state.snappedAsks.clear();
+    state.bestBid = kNoLevel;
+    state.bestAsk = kNoLevel;
+}
+
+void ConsolidatedBook::updateVenueBestLocked(size_t slot, size_t venueBestBid, size_t venueBestAsk) {
+    VenueState& state = *m_venues[slot];
+    state.bestBid = toConsolidatedLocked(state, venueBestBid);
+    state.bestAsk = toConsolidatedLocked(state, venueBestAsk);
+}
+
+void ConsolidatedBook::publishBestLocked() {
+    size_t bestBid = kNoLevel;
+    size_t bestAsk = kNoLevel;
+    const size_t count = m_venueCount.load(std::memory_order_relaxed);
+    for (size_t v = 0; v < count; ++v) {
+        const VenueState& state = *m_venues[v];
+        if (state.bestBid != kNoLevel && (bestBid == kNoLevel || state.bestBid > bestBid)) bestBid = state.bestBid;
+        if (state.bestAsk != kNoLevel && (bestAsk == kNoLevel || state.bestAsk < bestAsk)) bestAsk = state.bestAsk;
+    }
+    m_bestBid.store(bestBid, std::memory_order_release);
+    m_bestAsk.store(bestAsk, std::memory_order_release);
+}
@@ -0,0 +1,133 @@
+/*
+Sentinel — ConsolidatedBook
+Role: Cross-venue book of one symbol: per-tick quantity summed over venues plus each venue's contribution.
+Inputs/Outputs: Per-venue snapshots and BookDelta batches (venue grid indices) → consolidated per-tick levels and best bid/ask.
+Threading: Writers (venue handler threads) serialize on one mutex per symbol; readers (render, DataProcessor) never lock.
+Performance: O(venues) per delta and for best bid/ask (from each venue's own best); storage is paged, so only touched price ranges allocate.
+Integration: Owned by FeedAggregator, one per symbol; created from the first venue snapshot's price grid.
+Observability: version() increments once per applied batch so readers can skip unchanged frames.
+Related: ConsolidatedBook.cpp, FeedAggregator.hpp, TradeData.h (BookDelta, LiveOrderBook).
+Assumptions: Venues quote on the consolidated tick or a multiple of it; finer-tick levels snap to the nearest consolidated
+             tick, where each venue's snapped levels are kept apart and summed.
+*/
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "../model/TradeData.h"
+
+class ConsolidatedBook {
+public:
+    static constexpr size_t kNoLevel = SIZE_MAX;
+    static constexpr size_t kMaxVenues = 8;
+
+    ConsolidatedBook(double minPrice, double tickSize, size_t levelCount);
+    ~ConsolidatedBook();
+
+    ConsolidatedBook(const ConsolidatedBook&) = delete;
+    ConsolidatedBook& operator=(const ConsolidatedBook&) = delete;
+
+    // ---- Writer side (any thread; serialized internally) ----
+
+    // Replaces a venue's whole contribution. venueMinPrice/venueTickSize describe the grid its deltas index into.
+    // Best indices are the venue book's own (LiveOrderBook::kNoLevel when a side is empty).
+    void applySnapshot(const std::string& venue, double venueMinPrice, double venueTickSize,
+                       std::span<const BookDelta> levels, size_t venueBestBid, size_t venueBestAsk);
+    // Incremental levels for a venue already seen via applySnapshot(); unknown venues are ignored
+    void applyDeltas(const std::string& venue, std::span<const BookDelta> deltas,
+                     size_t venueBestBid, size_t venueBestAsk);
+    // False when the venue's book moved to another grid since its last snapshot (it needs a new applySnapshot()).
+    // Call from the thread that writes that venue.
+    bool venueGridMatches(const std::string& venue, double venueMinPrice, double venueTickSize) const;
+
+    // ---- Reader side (lock-free) ----
+
+    double minPrice() const { return m_minPrice; }
+    double tickSize() const { return m_tickSize; }
+    size_t levelCount() const { return m_levelCount; }
+    double priceAt(size_t index) const { return m_minPrice + static_cast<double>(index) * m_tickSize; }
+    size_t indexOf(double price) const;   // kNoLevel outside the grid
+
+    size_t bestBidIndex() const { return m_bestBid.load(std::memory_order_acquire); }
+    size_t bestAskIndex() const { return m_bestAsk.load(std::memory_order_acquire); }
+
+    // Summed quantity over all venues at a consolidated tick
+    double quantityAt(bool isBid, size_t index) const;
+    // One venue's quantity at a consolidated tick (slot from venueSlot())
+    double venueQuantityAt(size_t slot, bool isBid, size_t index) const;
+
+    size_t venueCount() const { return m_venueCount.load(std::memory_order_acquire); }
+    const std::string& venueName(size_t slot) const { return m_venueNames[slot]; }
+    int venueSlot(const std::string& venue) const;   // -1 if the venue never sent a snapshot
+
+    // Up to maxLevels populated levels walking away from the best, as (consolidated index, summed quantity)
+    size_t topLevels(bool isBid, size_t maxLevels, std::vector<std::pair<uint32_t, double>>& out) const;
+
+    uint64_t version() const { return m_version.load(std::memory_order_acquire); }
+
+private:
+    static constexpr size_t kPageShift = 12;
+    static constexpr size_t kPageSize = size_t{1} << kPageShift;
+    static constexpr size_t kPageMask = kPageSize - 1;
+
+    // Fixed-size blocks of atomics. Directories are sized once; pages are published by pointer and never freed
+    // before the book, so a reader holding a page pointer always sees valid memory.
+    template <typename T>
+    struct PagedLevels {
+        struct Page {
+            std::array<std::atomic<T>, kPageSize> values{};
+        };
+        std::unique_ptr<std::atomic<Page*>[]> directory;
+        std::vector<std::unique_ptr<Page>> owned;   // Writer only
+
+        void init(size_t pageCount);
+        T load(size_t index) const;
+        void store(size_t index, T value);          // Writer only; allocates the page on first touch
+        const Page* page(size_t pageIndex) const { return directory[pageIndex].load(std::memory_order_acquire); }
+    };
+
+    struct VenueState {
+        PagedLevels<float> bids;
+        PagedLevels<float> asks;
+        double minPrice = 0.0;
+        double tickSize = 0.0;
+        int64_t indexOffset = 0;    // Consolidated index = venue index + offset, when the ticks match
+        bool sameTick = false;
+        size_t bestBid = kNoLevel;  // Consolidated grid
+        size_t bestAsk = kNoLevel;
+        // Finer-tick venues only (writer side): consolidated index → the venue levels (index, qty) snapped into it
+        std::unordered_map<size_t, std::vector<std::pair<size_t, float>>> snappedBids;
+        std::unordered_map<size_t, std::vector<std::pair<size_t, float>>> snappedAsks;
+    };
+
+    int slotForLocked(const std::string& venue);
+    size_t toConsolidatedLocked(const VenueState& venue, size_t venueIndex) const;
+    void applyVenueLevelLocked(size_t slot, bool isBid, size_t venueIndex, float quantity);
+    void setLevelLocked(size_t slot, bool isBid, size_t index, float quantity);
+    void clearVenueLocked(size_t slot);
+    void updateVenueBestLocked(size_t slot, size_t venueBestBid, size_t venueBestAsk);
+    void publishBestLocked();
+
+    const double m_minPrice;
+    const double m_tickSize;
+    const size_t m_levelCount;
+    const size_t m_pageCount;
+
+    PagedLevels<double> m_bidTotals;
+    PagedLevels<double> m_askTotals;
+    std::array<std::unique_ptr<VenueState>, kMaxVenues> m_venues;
+    std::array<std::string, kMaxVenues> m_venueNames;   // Written before m_venueCount publishes the slot
+
+    std::mutex m_writeMutex;
+    std::atomic<size_t> m_venueCount{0};
+    std::atomic<size_t> m_bestBid{kNoLevel};
+    std::atomic<size_t> m_bestAsk{kNoLevel};
+    std::atomic<uint64_t> m_version{0};
+};
@@ -0,0 +1,240 @@
+/*
+Sentinel — FeedAggregator
+Role: Implements handler wiring, per-venue book maintenance in DataCache, and the price merge across venues.
+Inputs/Outputs: VenueBookUpdate → initializeLiveOrderBook / applyLiveOrderBookUpdates under the venue key → deltas sink.
+Threading: onBook() runs concurrently on every handler thread; only per-book locks are taken on that path.
+Performance: Merge collects at most maxLevelsPerSide levels per venue, then sorts and folds equal prices.
+Integration: See FeedAggregator.hpp.
+Observability: sLog_App on registration/start/stop.
+Related: FeedAggregator.hpp, ConsolidatedBook.cpp, DataCache.cpp.
+Assumptions: Equal prices across venues are those within half of the finer venue tick.
+*/
+#include "FeedAggregator.hpp"
+#include "../cache/DataCache.hpp"
+#include "SentinelLogging.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <QString>
+
+FeedAggregator::FeedAggregator(DataCache& cache)
+    : m_cache(cache) {
+}
+
+FeedAggregator::~FeedAggregator() {
+    stop();
+}
+
+void FeedAggregator::setSinks(BookDeltaSink onDeltas, TradeSink onTrade) {
+    m_onDeltas = std::move(onDeltas);
+    m_onTrade = std::move(onTrade);
+}
+
+void FeedAggregator::wire(IFeedHandler& handler) {
+    FeedCallbacks callbacks;
+    callbacks.onBook = [this](const VenueBookUpdate& update) { onBook(update); };
+    callbacks.onTrade = [this, venue = handler.venue()](const Trade& trade) {
+        if (m_onTrade) m_onTrade(venue, trade);
+    };
+    callbacks.onStatus = [](const std::string& venue, bool connected) {
+        sLog_App("Feed venue" << QString::fromStdString(venue) << (connected ? "up" : "down"));
+    };
+    handler.setCallbacks(std::move(callbacks));
+}
+
+void FeedAggregator::addHandler(std::unique_ptr<IFeedHandler> handler) {
+    if (!handler) return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    wire(*handler);
+    sLog_App("FeedAggregator: registered venue" << QString::fromStdString(handler->venue()));
+    if (m_running) {
+        handler->subscribe(m_symbols);
+        handler->start();
+    }
+    m_handlers.push_back(std::move(handler));
+}
+
+std::vector<std::string> FeedAggregator::venues() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<std::string> out;
+    out.reserve(m_handlers.size());
+    for (const auto& h : m_handlers) out.push_back(h->venue());
+    return out;
+}
+
+void FeedAggregator::start() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_running) return;
+    m_running = true;
+    for (auto& h : m_handlers) {
+        h->subscribe(m_symbols);
+        h->start();
+    }
+}
+
+void FeedAggregator::stop() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_running) return;
+    m_running = false;
+    for (auto& h : m_handlers) {
+        h->stop();
+    }
+}
+
+void FeedAggregator::subscribe(const std::vector<std::string>& symbols) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& s : symbols) {
+        if (std::find(m_symbols.begin(), m_symbols.end(), s) == m_symbols.end()) {
+            m_symbols.push_back(s);
+        }
+    }
+    for (auto& h : m_handlers) {
+        h->subscribe(symbols);
+    }
+}
+
+void FeedAggregator::onBook(const VenueBookUpdate& update) {
+    if (update.product_id.empty()) return;
+    const std::string key = feed::venueKey(update.product_id, update.venue);
+
+    if (update.isSnapshot) {
+        std::vector<OrderBookLevel> bids;
+        std::vector<OrderBookLevel> asks;
+        for (const auto& level : update.levels) {
+            if (level.quantity <= 0.0) continue;
+            (level.isBid ? bids : asks).push_back(OrderBookLevel{level.price, level.quantity});
+        }
+        m_cache.initializeLiveOrderBook(key, bids, asks, update.exchange_timestamp);
+        syncSnapshot(update.product_id, update.venue, key);
+        return;
+    }
+
+    thread_local std::vector<BookDelta> deltas;
+    deltas.clear();
+    const BookGrid grid = m_cache.applyLiveOrderBookUpdates(
+        key, std::span<const BookLevelUpdate>(update.levels.data(), update.levels.size()),
+        update.exchange_timestamp, deltas);
+    syncDeltas(update.product_id, update.venue, key, deltas, grid);
+    if (!deltas.empty() && m_onDeltas) {
+        m_onDeltas(update.venue, update.product_id, deltas, grid);
+    }
+}
+
+void FeedAggregator::mergeByPrice(const std::string& symbol, size_t maxLevelsPerSide,
+                                  std::vector<MergedLevel>& bids, std::vector<MergedLevel>& asks) const {
+    bids.clear();
+    asks.clear();
+
+    std::vector<std::string> keys{symbol};  // Primary feed's book
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& h : m_handlers) keys.push_back(feed::venueKey(symbol, h->venue()));
+    }
+
+    thread_local std::vector<std::pair<uint32_t, double>> bidBuf;
+    thread_local std::vector<std::pair<uint32_t, double>> askBuf;
+    double finestTick = 0.0;
+    for (const auto& key : keys) {
+        const auto view = m_cache.getDirectLiveOrderBook(key).captureDenseNonZero(bidBuf, askBuf, maxLevelsPerSide);
+        if (view.tickSize <= 0.0) continue;
+        finestTick = finestTick > 0.0 ? std::min(finestTick, view.tickSize) : view.tickSize;
+        for (const auto& [idx, qty] : view.bidLevels) {
+            bids.push_back(MergedLevel{view.minPrice + idx * view.tickSize, qty, 1});
+        }
+        for (const auto& [idx, qty] : view.askLevels) {
+            asks.push_back(MergedLevel{view.minPrice + idx * view.tickSize, qty, 1});
+        }
+    }
+
+    const double epsilon = finestTick * 0.5;
+    auto fold = [epsilon, maxLevelsPerSide](std::vector<MergedLevel>& side, bool descending) {
+        std::sort(side.begin(), side.end(), [descending](const MergedLevel& a, const MergedLevel& b) {
+            return descending ? a.price > b.price : a.price < b.price;
+        });
+        size_t out = 0;
+        for (size_t i = 0; i < side.size(); ++i) {
+            if (out > 0 && std::abs(side[out - 1].price - side[i].price) < epsilon) {
+                side[out - 1].quantity += side[i].quantity;
+                side[out - 1].venueCount += side[i].venueCount;
+            } else {
+                if (out == maxLevelsPerSide) break;
+                side[out++] = side[i];
+            }
+        }
+        side.resize(out);
+    };
+    fold(bids, true);
+    fold(asks, false);
+}
+
+const ConsolidatedBook* FeedAggregator::consolidated(const std::string& symbol) const {
+    std::lock_guard<std::mutex> lock(m_consolidatedMutex);
+    auto it = m_consolidated.find(symbol);
+    return it == m_consolidated.end() ? nullptr : it->second.get();
+}
+
+void FeedAggregator::onPrimarySnapshot(const std::string& symbol) {
+    syncSnapshot(symbol, kPrimaryVenue, symbol);
+}
+
+void FeedAggregator::onPrimaryDeltas(const std::string& symbol, const std::vector<BookDelta>& deltas,
+                                     const BookGrid& grid) {
+    syncDeltas(symbol, kPrimaryVenue, symbol, deltas, grid);
+}
+
+void FeedAggregator::syncSnapshot(const std::string& symbol, const std::string& venue, const std::string& bookKey) {
+    const LiveOrderBook& book = m_cache.getDirectLiveOrderBook(bookKey);
+    const BookGrid grid = book.grid();
+    if (grid.tickSize <= 0.0) return;
+
+    ConsolidatedBook* consolidatedBook = nullptr;
+    {
+        // The first snapshot of a symbol fixes the consolidated grid. Venue books may be narrow windows that
+        // follow the mid, so the grid spans ±50% of the book's centre; pages only allocate where levels land.
+        std::lock_guard<std::mutex> lock(m_consolidatedMutex);
+        auto& slot = m_consolidated[symbol];
+        if (!slot) {
+            const double tick = grid.tickSize;
+            const double centre = 0.5 * (grid.minPrice + grid.maxPrice);
+            const double minPrice = std::max(tick, std::floor(centre * 0.5 / tick) * tick);
+            const size_t levels = std::max(grid.levels, static_cast<size_t>(std::llround(centre / tick)) + 1);
+            slot = std::make_unique<ConsolidatedBook>(std::min(minPrice, grid.minPrice), tick, levels);
+        }
+        consolidatedBook = slot.get();
+    }
+
+    // One full-depth capture per snapshot; steady-state updates only carry deltas. Levels, grid and best
+    // levels (the front of each side) all come from this one locked capture.
+    thread_local std::vector<std::pair<uint32_t, double>> bidBuf;
+    thread_local std::vector<std::pair<uint32_t, double>> askBuf;
+    thread_local std::vector<BookDelta> levels;
+    const auto view = book.captureDenseNonZero(bidBuf, askBuf, SIZE_MAX);
+    levels.clear();
+    levels.reserve(view.bidLevels.size() + view.askLevels.size());
+    for (const auto& [idx, qty] : view.bidLevels) levels.push_back({idx, static_cast<float>(qty), true});
+    for (const auto& [idx, qty] : view.askLevels) levels.push_back({idx, static_cast<float>(qty), false});
+
+    consolidatedBook->applySnapshot(venue, view.minPrice, view.tickSize, levels,
+                                    view.bidLevels.empty() ? LiveOrderBook::kNoLevel : view.bidLevels.front().first,
+                                    view.askLevels.empty() ? LiveOrderBook::kNoLevel : view.askLevels.front().first);
+}
+
+void FeedAggregator::syncDeltas(const std::string& symbol, const std::string& venue, const std::string& bookKey,
+                                const std::vector<BookDelta>& deltas, const BookGrid& grid) {
+    if (deltas.empty()) return;
+    ConsolidatedBook* consolidatedBook = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_consolidatedMutex);
+        auto it = m_consolidated.find(symbol);
+        if (it == m_consolidated.end()) return;
+        consolidatedBook = it->second.get();
+    }
+    // The batch's own grid, not the book's current one: a regrid since then must not remap these indices
+    if (!consolidatedBook->venueGridMatches(venue, grid.minPrice, grid.tickSize)) {
+        // The book moved to another grid since the venue's last snapshot: take the whole book again
+        syncSnapshot(symbol, venue, bookKey);
+        return;
+    }
+    consolidatedBook->applyDeltas(venue, deltas, grid.bestBidIndex, grid.bestAskIndex);
+}
@@ -0,0 +1,85 @@
+/*
+Sentinel — FeedAggregator
+Role: Runs a set of venue feed handlers and keeps one LiveOrderBook per venue and symbol in DataCache.
+Inputs/Outputs: Normalized VenueBookUpdates/Trades from handlers → DataCache books keyed "SYMBOL@VENUE" + sinks.
+Threading: Each handler's callbacks run on that handler's own thread; books are locked per book, never globally.
+Performance: Venue updates apply in parallel; each batch also updates the symbol's ConsolidatedBook in O(deltas × venues).
+Integration: Owned by MarketDataCore, which forwards the sinks as its usual Qt signals.
+Observability: Logs handler registration and lifecycle via sLog_App.
+Related: IFeedHandler.hpp, ConsolidatedBook.hpp, SyntheticFeedHandler.hpp, DataCache.hpp, MarketDataCore.hpp.
+Assumptions: Books stored under the bare symbol (the primary Coinbase feed) take part in merges as venue "".
+*/
+#pragma once
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ConsolidatedBook.hpp"
+#include "IFeedHandler.hpp"
+
+class DataCache;
+
+class FeedAggregator {
+public:
+    // grid is the one the batch's indices refer to (DataCache::applyLiveOrderBookUpdates)
+    using BookDeltaSink = std::function<void(const std::string& venue, const std::string& symbol,
+                                             const std::vector<BookDelta>& deltas, const BookGrid& grid)>;
+    using TradeSink = std::function<void(const std::string& venue, const Trade& trade)>;
+
+    struct MergedLevel {
+        double price = 0.0;
+        double quantity = 0.0;
+        uint32_t venueCount = 0;   // Venues quoting this price
+    };
+
+    explicit FeedAggregator(DataCache& cache);
+    ~FeedAggregator();
+
+    FeedAggregator(const FeedAggregator&) = delete;
+    FeedAggregator& operator=(const FeedAggregator&) = delete;
+
+    // Sinks are called on the handler threads; set them before start()
+    void setSinks(BookDeltaSink onDeltas, TradeSink onTrade);
+
+    // Handlers added while running start immediately with the current subscriptions
+    void addHandler(std::unique_ptr<IFeedHandler> handler);
+    std::vector<std::string> venues() const;
+
+    void start();
+    void stop();
+    void subscribe(const std::vector<std::string>& symbols);
+
+    // Top levels per side summed by price across the primary book and every venue, best first
+    void mergeByPrice(const std::string& symbol, size_t maxLevelsPerSide,
+                      std::vector<MergedLevel>& bids, std::vector<MergedLevel>& asks) const;
+
+    // Incrementally maintained cross-venue book; nullptr until the symbol's first snapshot.
+    // The pointer stays valid for the aggregator's lifetime and is safe to read from any thread.
+    const ConsolidatedBook* consolidated(const std::string& symbol) const;
+
+    // Primary feed (books stored under the bare symbol) joins the consolidated book as venue kPrimaryVenue
+    static constexpr const char* kPrimaryVenue = "";
+    void onPrimarySnapshot(const std::string& symbol);
+    void onPrimaryDeltas(const std::string& symbol, const std::vector<BookDelta>& deltas, const BookGrid& grid);
+
+private:
+    void onBook(const VenueBookUpdate& update);
+    void wire(IFeedHandler& handler);
+    void syncSnapshot(const std::string& symbol, const std::string& venue, const std::string& bookKey);
+    void syncDeltas(const std::string& symbol, const std::string& venue, const std::string& bookKey,
+                    const std::vector<BookDelta>& deltas, const BookGrid& grid);
+
+    DataCache& m_cache;
+    BookDeltaSink m_onDeltas;
+    TradeSink m_onTrade;
+
+    mutable std::mutex m_mutex;   // Guards the handler list and subscriptions, not the data path
+    std::vector<std::unique_ptr<IFeedHandler>> m_handlers;
+    std::vector<std::string> m_symbols;
+    bool m_running = false;
+
+    mutable std::mutex m_consolidatedMutex;   // Guards map lookup/insert only; books are never erased
+    std::unordered_map<std::string, std::unique_ptr<ConsolidatedBook>> m_consolidated;
+};
@@ -0,0 +1,64 @@
+/*
+Sentinel — IFeedHandler
+Role: Venue-neutral feed interface; each venue handler normalizes its wire format into Trade / BookLevelUpdate.
+Inputs/Outputs: Takes product subscriptions; calls back with Trades and VenueBookUpdates tagged with the venue.
+Threading: Every handler owns its own I/O context and thread; callbacks run on that thread.
+Performance: Handlers never share an executor, so venues are parsed and applied in parallel.
+Integration: Handlers are registered with FeedAggregator, which keeps one LiveOrderBook per venue and symbol.
+Observability: Implementations log connection/lifecycle via SentinelLogging.
+Related: FeedAggregator.hpp, SyntheticFeedHandler.hpp, TradeData.h.
+Assumptions: The first book update a handler delivers for a product is a snapshot.
+*/
+#pragma once
+#include <chrono>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../model/TradeData.h"
+
+// One normalized book message from a venue
+struct VenueBookUpdate {
+    std::string venue;
+    std::string product_id;          // Venue-neutral symbol, e.g. "BTC-USD"
+    bool isSnapshot = false;         // Replaces the venue's book for this product
+    std::chrono::system_clock::time_point exchange_timestamp;
+    std::vector<BookLevelUpdate> levels;
+};
+
+struct FeedCallbacks {
+    std::function<void(const Trade&)> onTrade;                 // trade.product_id is venue-neutral
+    std::function<void(const VenueBookUpdate&)> onBook;
+    std::function<void(const std::string& venue, bool connected)> onStatus;
+};
+
+class IFeedHandler {
+public:
+    virtual ~IFeedHandler() = default;
+
+    virtual const std::string& venue() const = 0;
+
+    // Must be set before start()
+    virtual void setCallbacks(FeedCallbacks callbacks) = 0;
+
+    virtual void start() = 0;
+    virtual void stop() = 0;
+
+    // Additive; symbols use the venue-neutral "BASE-QUOTE" form
+    virtual void subscribe(const std::vector<std::string>& symbols) = 0;
+};
+
+namespace feed {
+    // Cache/signal key for one venue's book of a symbol, e.g. "BTC-USD@SIM"
+    inline std::string venueKey(std::string_view symbol, std::string_view venue) {
+        std::string key;
+        key.reserve(symbol.size() + venue.size() + 1);
+        key.append(symbol).append(1, '@').append(venue);
+        return key;
+    }
+
+    inline std::string_view symbolOf(std::string_view key) {
+        const auto at = key.find('@');
+        return at == std::string_view::npos ? key : key.substr(0, at);
+    }
+}
@@ -0,0 +1,271 @@
+/*
+Sentinel — SyntheticFeedHandler
+Role: Implements the random-walk book generator, CSV replay, and the handler's private I/O thread.
+Inputs/Outputs: Timer ticks → snapshot / update VenueBookUpdates and Trades via FeedCallbacks.
+Threading: Timer handlers run on m_thread; subscribe() may be called from any thread (m_symbolsMutex).
+Performance: Generation allocates one levels vector per update; replay groups same-timestamp lines per message.
+Integration: See SyntheticFeedHandler.hpp.
+Observability: sLog_App on start/stop and replay load.
+Related: SyntheticFeedHandler.hpp, FeedAggregator.cpp.
+Assumptions: The mid moves at most one tick per step; the crossed level is cleared and the vacated one refilled.
+*/
+#include "SyntheticFeedHandler.hpp"
+#include "SentinelLogging.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <QString>
+
+namespace {
+    bool parseSide(const std::string& s) {
+        return s == "b" || s == "B" || s == "bid" || s == "buy" || s == "BUY";
+    }
+}
+
+SyntheticFeedHandler::SyntheticFeedHandler(Config config)
+    : m_config(std::move(config))
+    , m_rng(m_config.seed) {
+    m_config.depthLevels = std::max(1, m_config.depthLevels);
+    m_config.levelsPerUpdate = std::max(0, m_config.levelsPerUpdate);
+}
+
+SyntheticFeedHandler::~SyntheticFeedHandler() {
+    stop();
+}
+
+void SyntheticFeedHandler::start() {
+    if (m_running.exchange(true)) return;
+
+    if (!m_config.replayPath.empty() && m_replay.empty()) {
+        loadReplay();
+    }
+    m_replayWallStart = std::chrono::steady_clock::now();
+
+    m_workGuard.emplace(m_ioc.get_executor());
+    m_ioc.restart();
+    m_thread = std::thread([this]() { m_ioc.run(); });
+    boost::asio::post(m_ioc, [this]() { scheduleTick(); });
+
+    sLog_App("SyntheticFeedHandler" << QString::fromStdString(m_config.venue) << "started"
+             << (m_replay.empty() ? "(generator)" : "(replay)"));
+    if (m_callbacks.onStatus) m_callbacks.onStatus(m_config.venue, true);
+}
+
+void SyntheticFeedHandler::stop() {
+    if (!m_running.exchange(false)) return;
+
+    m_workGuard.reset();
+    m_ioc.stop();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    sLog_App("SyntheticFeedHandler" << QString::fromStdString(m_config.venue) << "stopped");
+    if (m_callbacks.onStatus) m_callbacks.onStatus(m_config.venue, false);
+}
+
+void SyntheticFeedHandler::subscribe(const std::vector<std::string>& symbols) {
+    std::lock_guard<std::mutex> lock(m_symbolsMutex);
+    for (const auto& s : symbols) {
+        if (std::find(m_symbols.begin(), m_symbols.end(), s) == m_symbols.end()) {
+            m_symbols.push_back(s);
+        }
+    }
+}
+
+void SyntheticFeedHandler::scheduleTick() {
+    m_timer.expires_after(m_config.interval);
+    m_timer.async_wait([this](const boost::system::error_code& ec) {
+        if (ec || !m_running.load()) return;
+
+        if (!m_replay.empty()) {
+            int64_t replay_ms = std::numeric_limits<int64_t>::max();
+            if (m_config.replaySpeed > 0.0) {
+                const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - m_replayWallStart).count();
+                replay_ms = m_replayStart_ms + static_cast<int64_t>(elapsed * m_config.replaySpeed);
+            }
+            if (!replayUntil(replay_ms)) {
+                sLog_App("SyntheticFeedHandler" << QString::fromStdString(m_config.venue) << "replay finished");
+                return;
+            }
+        } else {
+            step();
+        }
+        scheduleTick();
+    });
+}
+
+double SyntheticFeedHandler::randomQty() {
+    std::lognormal_distribution<double> dist(0.0, 1.0);
+    return std::round(dist(m_rng) * 0.5 * 1e4) / 1e4 + 0.0001;
+}
+
+void SyntheticFeedHandler::step() {
+    std::vector<std::string> symbols;
+    {
+        std::lock_guard<std::mutex> lock(m_symbolsMutex);
+        symbols = m_symbols;
+    }
+    const auto now = std::chrono::system_clock::now();
+    for (const auto& symbol : symbols) {
+        auto [it, inserted] = m_states.try_emplace(symbol);
+        if (inserted) {
+            const auto start = m_config.startPrices.find(symbol);
+            const double price = start != m_config.startPrices.end() ? start->second : m_config.startPrice;
+            it->second.tickSize = std::clamp(std::pow(10.0, std::floor(std::log10(price)) - 5.0),
+                                             1e-8, m_config.tickSize);
+            it->second.midTick = std::llround(price / it->second.tickSize);
+        }
+        generate(symbol, it->second, now);
+    }
+}
+
+void SyntheticFeedHandler::generate(const std::string& symbol, SymbolState& state,
+                                    std::chrono::system_clock::time_point now) {
+    const double tick = state.tickSize;
+    const int depth = m_config.depthLevels;
+    auto priceAt = [tick](int64_t t) { return static_cast<double>(t) * tick; };
+
+    VenueBookUpdate update;
+    update.venue = m_config.venue;
+    update.product_id = symbol;
+    update.exchange_timestamp = now;
+
+    if (!state.snapshotSent) {
+        update.isSnapshot = true;
+        update.levels.reserve(static_cast<size_t>(depth) * 2);
+        for (int d = 1; d <= depth; ++d) {
+            update.levels.push_back(BookLevelUpdate{true, priceAt(state.midTick - d), randomQty()});
+            update.levels.push_back(BookLevelUpdate{false, priceAt(state.midTick + d), randomQty()});
+        }
+        emitBook(update);
+        state.snapshotSent = true;
+        return;
+    }
+
+    update.levels.reserve(static_cast<size_t>(m_config.levelsPerUpdate) + 4);
+    std::uniform_int_distribution<int> walk(-1, 1);
+    const int move = state.midTick > depth + 1 ? walk(m_rng) : 1;
+    if (move > 0) {
+        update.levels.push_back(BookLevelUpdate{false, priceAt(state.midTick + 1), 0.0});
+        ++state.midTick;
+        update.levels.push_back(BookLevelUpdate{true, priceAt(state.midTick - 1), randomQty()});
+        update.levels.push_back(BookLevelUpdate{false, priceAt(state.midTick + depth), randomQty()});
+    } else if (move < 0) {
+        update.levels.push_back(BookLevelUpdate{true, priceAt(state.midTick - 1), 0.0});
+        --state.midTick;
+        update.levels.push_back(BookLevelUpdate{false, priceAt(state.midTick + 1), randomQty()});
+        update.levels.push_back(BookLevelUpdate{true, priceAt(state.midTick - depth), randomQty()});
+    }
+
+    std::bernoulli_distribution sideDist(0.5);
+    std::bernoulli_distribution cancelDist(0.1);
+    std::uniform_int_distribution<int> distanceDist(1, depth);
+    for (int i = 0; i < m_config.levelsPerUpdate; ++i) {
+        const bool isBid = sideDist(m_rng);
+        const int d = distanceDist(m_rng);
+        const double qty = cancelDist(m_rng) ? 0.0 : randomQty();
+        update.levels.push_back(BookLevelUpdate{isBid, priceAt(isBid ? state.midTick - d : state.midTick + d), qty});
+    }
+    emitBook(update);
+
+    std::bernoulli_distribution tradeDist(std::clamp(m_config.tradeProbability, 0.0, 1.0));
+    if (tradeDist(m_rng) && m_callbacks.onTrade) {
+        const bool buy = sideDist(m_rng);
+        Trade trade;
+        trade.timestamp = now;
+        trade.product_id = symbol;
+        trade.trade_id = m_config.venue + "-" + std::to_string(++m_tradeCounter);
+        trade.side = buy ? AggressorSide::Buy : AggressorSide::Sell;
+        trade.price = priceAt(buy ? state.midTick + 1 : state.midTick - 1);
+        trade.size = randomQty() * 0.1;
+        m_callbacks.onTrade(trade);
+    }
+}
+
+void SyntheticFeedHandler::emitBook(VenueBookUpdate& update) {
+    if (m_callbacks.onBook && !update.levels.empty()) {
+        m_callbacks.onBook(update);
+    }
+}
+
+size_t SyntheticFeedHandler::loadReplay() {
+    m_replay.clear();
+    m_replayPos = 0;
+    std::ifstream in(m_config.replayPath);
+    if (!in) {
+        sLog_Warning("SyntheticFeedHandler: cannot open replay file" << QString::fromStdString(m_config.replayPath));
+        return 0;
+    }
+
+    std::string line;
+    std::string field;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream ss(line);
+        std::vector<std::string> fields;
+        while (std::getline(ss, field, ',')) fields.push_back(field);
+        if (fields.size() < 6 || fields[2].empty()) continue;
+
+        ReplayLine r;
+        try {
+            r.ts_ms = std::stoll(fields[0]);
+            r.price = std::stod(fields[4]);
+            r.quantity = std::stod(fields[5]);
+        } catch (const std::exception&) {
+            continue;  // Header or malformed line
+        }
+        r.product_id = fields[1];
+        r.kind = fields[2][0];
+        r.isBid = parseSide(fields[3]);
+        m_replay.push_back(std::move(r));
+    }
+    std::stable_sort(m_replay.begin(), m_replay.end(),
+                     [](const ReplayLine& a, const ReplayLine& b) { return a.ts_ms < b.ts_ms; });
+    m_replayStart_ms = m_replay.empty() ? 0 : m_replay.front().ts_ms;
+
+    sLog_App("SyntheticFeedHandler: loaded" << m_replay.size() << "replay lines from"
+             << QString::fromStdString(m_config.replayPath));
+    return m_replay.size();
+}
+
+bool SyntheticFeedHandler::replayUntil(int64_t replay_ms) {
+    while (m_replayPos < m_replay.size() && m_replay[m_replayPos].ts_ms <= replay_ms) {
+        const ReplayLine& first = m_replay[m_replayPos];
+        const auto ts = std::chrono::system_clock::time_point(std::chrono::milliseconds(first.ts_ms));
+
+        if (first.kind == 'T') {
+            if (m_callbacks.onTrade) {
+                Trade trade;
+                trade.timestamp = ts;
+                trade.product_id = first.product_id;
+                trade.trade_id = m_config.venue + "-r" + std::to_string(m_replayPos);
+                trade.side = first.isBid ? AggressorSide::Buy : AggressorSide::Sell;
+                trade.price = first.price;
+                trade.size = first.quantity;
+                m_callbacks.onTrade(trade);
+            }
+            ++m_replayPos;
+            continue;
+        }
+
+        // Consecutive book lines of one product, kind and timestamp form one message
+        VenueBookUpdate update;
+        update.venue = m_config.venue;
+        update.product_id = first.product_id;
+        update.isSnapshot = first.kind == 'S';
+        update.exchange_timestamp = ts;
+        const int64_t groupTs = first.ts_ms;
+        const char groupKind = first.kind;
+        while (m_replayPos < m_replay.size()) {
+            const ReplayLine& r = m_replay[m_replayPos];
+            if (r.ts_ms != groupTs || r.kind != groupKind || r.product_id != update.product_id) break;
+            update.levels.push_back(BookLevelUpdate{r.isBid, r.price, r.quantity});
+            ++m_replayPos;
+        }
+        emitBook(update);
+    }
+    return m_replayPos < m_replay.size();
+}
@@ -0,0 +1,108 @@
+/*
+Sentinel — SyntheticFeedHandler
+Role: Local venue that generates (or replays from CSV) book and trade flow without a network connection.
+Inputs/Outputs: Takes subscriptions; emits a snapshot per symbol, then incremental VenueBookUpdates and Trades.
+Threading: Owns an io_context and thread like any venue handler; step() may also be driven directly by tests.
+Performance: O(levelsPerUpdate) per tick per symbol; replay lines are parsed once at start().
+Integration: Registered with FeedAggregator (e.g. from config) to exercise the multi-venue merge path offline.
+Observability: Logs start/stop and replay loading via sLog_App.
+Related: IFeedHandler.hpp, FeedAggregator.hpp.
+Assumptions: The random walk never takes the bid side below one tick. Replay CSV lines are "ts_ms,product_id,kind,side,price,quantity" with kind S (snapshot), B (book), T (trade).
+*/
+#pragma once
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "IFeedHandler.hpp"
+
+class SyntheticFeedHandler : public IFeedHandler {
+public:
+    struct Config {
+        std::string venue = "SIM";
+        double startPrice = 100000.0;                // Symbols missing from startPrices
+        double tickSize = 0.01;                      // Coarsest tick; low-priced symbols get ~1e5 ticks per decade
+        std::unordered_map<std::string, double> startPrices{
+            {"BTC-USD", 100000.0}, {"ETH-USD", 3000.0}, {"SOL-USD", 150.0},
+            {"XRP-USD", 0.5}, {"DOGE-USD", 0.15}, {"ADA-USD", 0.4},
+            {"AVAX-USD", 30.0}, {"LTC-USD", 80.0}, {"LINK-USD", 15.0}};
+        int depthLevels = 200;                       // Levels per side in the snapshot
+        int levelsPerUpdate = 8;                     // Random level changes per tick
+        double tradeProbability = 0.3;               // Per symbol per tick
+        std::chrono::milliseconds interval{50};
+        uint32_t seed = 42;
+        std::string replayPath;                      // Replays this file instead of generating when set
+        double replaySpeed = 1.0;                    // 0 = as fast as possible
+    };
+
+    explicit SyntheticFeedHandler(Config config);
+    ~SyntheticFeedHandler() override;
+
+    SyntheticFeedHandler(const SyntheticFeedHandler&) = delete;
+    SyntheticFeedHandler& operator=(const SyntheticFeedHandler&) = delete;
+
+    const std::string& venue() const override { return m_config.venue; }
+    void setCallbacks(FeedCallbacks callbacks) override { m_callbacks = std::move(callbacks); }
+    void start() override;
+    void stop() override;
+    void subscribe(const std::vector<std::string>& symbols) override;
+
+    // One generator tick for every subscribed symbol, on the calling thread
+    void step();
+
+    // Replay: loads the file and returns the number of parsed lines (also done by start())
+    size_t loadReplay();
+    // Replay: delivers every line due at replay time now_ms; returns false when the file is exhausted
+    bool replayUntil(int64_t replay_ms);
+
+private:
+    struct SymbolState {
+        int64_t midTick = 0;
+        double tickSize = 0.01;
+        bool snapshotSent = false;
+    };
+
+    struct ReplayLine {
+        int64_t ts_ms = 0;
+        std::string product_id;
+        char kind = 'B';
+        bool isBid = true;          // Book side, or buy aggressor for trades
+        double price = 0.0;
+        double quantity = 0.0;
+    };
+
+    void scheduleTick();
+    void generate(const std::string& symbol, SymbolState& state, std::chrono::system_clock::time_point now);
+    void emitBook(VenueBookUpdate& update);
+    double randomQty();
+
+    Config m_config;
+    FeedCallbacks m_callbacks;
+
+    std::mutex m_symbolsMutex;
+    std::vector<std::string> m_symbols;
+    std::unordered_map<std::string, SymbolState> m_states;   // Generator thread only
+    std::mt19937 m_rng;
+    uint64_t m_tradeCounter = 0;
+
+    std::vector<ReplayLine> m_replay;
+    size_t m_replayPos = 0;
+    int64_t m_replayStart_ms = 0;                           // First line's timestamp
+    std::chrono::steady_clock::time_point m_replayWallStart;
+
+    boost::asio::io_context m_ioc;
+    boost::asio::steady_timer m_timer{m_ioc};
+    std::optional<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>> m_workGuard;
+    std::thread m_thread;
+    std::atomic<bool> m_running{false};
+};
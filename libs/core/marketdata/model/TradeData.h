@@ -1,13 +1,17 @@
 #ifndef TRADEDATA_H
 #define TRADEDATA_H
 
+#include <cmath>
 #include <chrono>
 #include <string>
 #include <vector>
 #include <span>
 #include <cstdint>
 #include <mutex>
+#include <atomic>
 #include <utility>
+#include "FenwickTree.h"
+#include "OccupancyBitset.h"
 
 // An enumeration to represent the side of a trade in a type-safe way
 // This is better than using raw strings like "buy" or "sell"
@@ -150,22 +154,63 @@ struct BookLevelUpdate {
     double quantity;
 };
 
+// Estimated result of sweeping the book with a market order of a given notional
+struct MarketFill {
+    double requestedNotional = 0.0;
+    double filledNotional = 0.0;  // Below requestedNotional when the side runs out of depth
+    double quantity = 0.0;
+    double vwap = 0.0;            // Average fill price (0 when nothing fills)
+    double worstPrice = 0.0;      // Deepest level touched
+    double slippageBps = 0.0;     // VWAP vs the touch on the traded side; positive = cost
+};
+
+// Grid geometry and touch of a LiveOrderBook, read under one lock. epoch changes whenever the grid is rebuilt
+// (snapshot, re-centre, regrid), so BookDelta indices only map to prices through the grid they were produced on.
+struct BookGrid {
+    static constexpr size_t kNoLevel = SIZE_MAX;
+    double minPrice = 0.0;
+    double maxPrice = 0.0;
+    double tickSize = 0.0;
+    size_t levels = 0;
+    uint64_t epoch = 0;
+    size_t bestBidIndex = kNoLevel;
+    size_t bestAskIndex = kNoLevel;
+    std::chrono::system_clock::time_point timestamp;  // Exchange time of the last applied batch
+
+    double priceAt(size_t index) const { return minPrice + static_cast<double>(index) * tickSize; }
+};
+
 class LiveOrderBook {
 public:
     LiveOrderBook() = default;
     explicit LiveOrderBook(const std::string& product_id) : m_productId(product_id) {}
 
-    // Initialize the fixed-size order book
+    // Initialize the fixed-size order book (a live snapshot; clears the stale mark)
     void initialize(double min_price, double max_price, double tick_size);
 
-    // Apply incremental updates (l2update messages) - captures deltas without scanning
+    // Restored from a checkpoint and not yet replaced by a live snapshot, so levels may be minutes old.
+    // Live sampling and depth/impact queries skip stale books.
+    void markStale() { m_stale.store(true, std::memory_order_release); }
+    bool isStale() const { return m_stale.load(std::memory_order_acquire); }
+
+    // Moves the grid to [min_price, max_price] at the current tick and re-applies the levels that still fit.
+    // O(grid + populated levels); indices change, so delta consumers see it as a new grid.
+    void regrid(double min_price, double max_price);
+    // Windowed books: re-centres the grid on the mid, keeping its width, once the mid gets within
+    // marginFraction of the grid width from either edge. True when the grid moved.
+    bool recenterIfNearEdge(double marginFraction);
+    bool isNearEdge(double marginFraction) const;
+
+    // Apply incremental updates (l2update messages) - captures deltas without scanning.
+    // outGrid receives the grid the deltas index and the touch after the batch, read under the same lock.
     void applyUpdates(std::span<const BookLevelUpdate> updates,
                       std::chrono::system_clock::time_point exchange_timestamp,
-                      std::vector<BookDelta>* outDeltas);
+                      std::vector<BookDelta>* outDeltas,
+                      BookGrid* outGrid = nullptr);
 
-    // Get dense data for heatmap rendering
-    const std::vector<double>& getBids() const { return m_bids; }
-    const std::vector<double>& getAsks() const { return m_asks; }
+    // Copies of the dense grid, O(grid); live paths read through captureDenseNonZero/captureLevels instead
+    std::vector<double> getBids() const;
+    std::vector<double> getAsks() const;
 
     // Statistics
     size_t getBidCount() const;
@@ -174,27 +219,77 @@ public:
     double getAskVolume() const;
     bool isEmpty() const;
 
-    // Configuration Accessors
-    double getMinPrice() const { return m_min_price; }
-    double getMaxPrice() const { return m_max_price; }
-    double getTickSize() const { return m_tick_size; }
+    // Best populated level indices (kNoLevel when a side is empty); maintained in applyLevelLocked,
+    // which finds the next level through the occupancy bitsets when the touch empties
+    static constexpr size_t kNoLevel = BookGrid::kNoLevel;
+    size_t getBestBidIndex() const;
+    size_t getBestAskIndex() const;
+
+    // Cumulative depth from a Fenwick index over tick quantities (maintained in applyLevelLocked): O(log n) per price.
+    // Bid size resting at or above price / ask size resting at or below price.
+    double cumulativeBidDepth(double price) const;
+    double cumulativeAskDepth(double price) const;
+    // Cumulative depth at `samples` prices spread evenly over [priceMin, priceMax], ascending, under one lock
+    void sampleCumulativeDepth(double priceMin, double priceMax, size_t samples,
+                               std::vector<double>& bidDepth, std::vector<double>& askDepth) const;
+    // Market order sweeps (buy = lift asks, sell = hit bids) for each notional, under one lock: O(log n) per size.
+    // The first estimate after a (re)grid also indexes the book's notional, O(grid + populated levels · log n).
+    void estimateMarketFills(bool buy, std::span<const double> notionals, std::vector<MarketFill>& out) const;
+    // Both sweeps plus the grid and touch they were priced against, all under one lock
+    BookGrid estimateMarketImpact(std::span<const double> notionals,
+                                  std::vector<MarketFill>& buys, std::vector<MarketFill>& sells) const;
+
+    // Coarse price-bucket views kept in step by applyLevelLocked: O(views) per level change.
+    // Bucket k holds the levels whose price rounds to k * bucketSize (LiquidityTimeSeriesEngine's quantization).
+    // A view is usable while bucketSize is a whole number of ticks; initialize() rebuilds views on the new grid.
+    bool addBucketView(double bucketSize);
+    void removeBucketView(double bucketSize);
+    bool hasBucketView(double bucketSize) const;
+
+    struct BucketSnapshotView {
+        double bucketSize = 0.0;
+        double bestBidQuantity = 0.0;  // Raw top-of-book sizes (0 when a side is empty)
+        double bestAskQuantity = 0.0;
+        std::chrono::system_clock::time_point timestamp;
+        std::span<const std::pair<double, double>> bidBuckets;  // (bucket price, quantity), best first
+        std::span<const std::pair<double, double>> askBuckets;
+    };
 
-    // Helper to convert an index back to a price for consumers
-    inline double index_to_price(size_t index) const {
-        return m_min_price + (index * m_tick_size);
-    }
+    // Non-empty buckets of one view, best first, up to maxPerSide per side; false when no usable view has that size
+    bool captureBuckets(double bucketSize,
+                        std::vector<std::pair<double, double>>& bidBuffer,
+                        std::vector<std::pair<double, double>>& askBuffer,
+                        size_t maxPerSide,
+                        BucketSnapshotView& out) const;
+
+    // Configuration Accessors. Each call locks on its own and a windowed book can re-centre between two calls:
+    // read grid() when geometry and indices have to agree.
+    BookGrid grid() const;
+    double getMinPrice() const;
+    double getMaxPrice() const;
+    double getTickSize() const;
+
+    // Helper to convert an index back to a price for consumers (on the current grid)
+    double index_to_price(size_t index) const;
 
     // Thread-safe access
-    void setProductId(const std::string& productId) { m_productId = productId; }
-    std::string getProductId() const { return m_productId; }
+    void setProductId(const std::string& productId);
+    std::string getProductId() const;
     
     // Exchange timestamp access
-    std::chrono::system_clock::time_point getLastUpdate() const { return m_lastUpdate; }
+    std::chrono::system_clock::time_point getLastUpdate() const;
+
+    // Populated levels priced within [priceMin, priceMax], bids best (highest) first, asks best (lowest) first,
+    // under one lock. Returns the grid they were read on.
+    BookGrid captureLevels(double priceMin, double priceMax,
+                           std::vector<OrderBookLevel>& bids, std::vector<OrderBookLevel>& asks) const;
 
     // Thread-safe dense snapshot capture of non-zero levels (bounded)
     struct DenseBookSnapshotView {
         double minPrice = 0.0;
+        double maxPrice = 0.0;
         double tickSize = 1.0;
+        uint64_t epoch = 0;     // BookGrid::epoch the indices belong to
         std::chrono::system_clock::time_point timestamp;
         std::span<const std::pair<uint32_t, double>> bidLevels; // (index, quantity)
         std::span<const std::pair<uint32_t, double>> askLevels; // (index, quantity)
@@ -208,37 +303,85 @@ public:
 private:
     // Helper to convert a price to a vector index
     inline size_t price_to_index(double price) const {
-        return static_cast<size_t>((price - m_min_price) / m_tick_size);
+        // Round, not truncate: 99999.99 / 0.01 lands just below its tick in binary floating point
+        return static_cast<size_t>(std::llround((price - m_min_price) / m_tick_size));
     }
+    double priceAtLocked(size_t index) const {
+        return m_min_price + (static_cast<double>(index) * m_tick_size);
+    }
+
+    BookGrid gridLocked() const;
+    bool isNearEdgeLocked(double marginFraction) const;
 
+    void initializeLocked(double min_price, double max_price, double tick_size);
+    void regridLocked(double min_price, double max_price);
     void applyLevelLocked(bool isBid,
                            double price,
                            double quantity,
                            std::vector<BookDelta>* outDeltas);
+    double bidDepthLocked(double price) const;
+    double askDepthLocked(double price) const;
+    MarketFill estimateFillLocked(bool buy, double notional) const;
+    // Builds the notional trees from the populated levels on the first sweep estimate after a (re)grid
+    void ensureNotionalIndexLocked() const;
+
+    struct BucketView {
+        double bucketSize = 0.0;
+        bool usable = false;               // bucketSize fits the current grid
+        int64_t ticksPerBucket = 1;
+        int64_t gridOffsetTicks = 0;       // min_price in ticks
+        int64_t firstKey = 0;              // Bucket key of grid index 0
+        std::vector<double> bids;          // Summed quantity per bucket
+        std::vector<double> asks;
+        std::vector<uint32_t> bidLevels;   // Populated ticks per bucket; an emptied bucket is reset to exactly 0
+        std::vector<uint32_t> askLevels;
+
+        int64_t keyOf(size_t index) const;
+        size_t bucketOf(size_t index) const { return static_cast<size_t>(keyOf(index) - firstKey); }
+    };
+    void rebuildBucketViewLocked(BucketView& view) const;
+    const BucketView* findBucketViewLocked(double bucketSize) const;
+    // Depth trees run from the touch outward: asks by ascending price, bids by descending price
+    size_t depthSlot(bool isBid, size_t index) const { return isBid ? m_bids.size() - 1 - index : index; }
 
     std::string m_productId;
 
     // Vectors for O(1) price level management
     std::vector<double> m_bids;
     std::vector<double> m_asks;
+    FenwickTree<double> m_bidDepth;     // Quantity per depthSlot
+    FenwickTree<double> m_askDepth;
+    // Price x quantity per depthSlot, only for books someone prices sweeps on (the chart symbol): built lazily
+    // under m_mutex by the const estimate paths, then maintained in applyLevelLocked until the next grid change
+    mutable FenwickTree<double> m_bidNotional;
+    mutable FenwickTree<double> m_askNotional;
+    mutable bool m_notionalIndexed = false;
+    OccupancyBitset m_bidOccupied;      // Populated grid indices
+    OccupancyBitset m_askOccupied;
+    std::vector<BucketView> m_bucketViews;
 
     // Book structure configuration
     double m_min_price = 0.0;
     double m_max_price = 0.0;
     double m_tick_size = 0.0;
+    uint64_t m_gridEpoch = 0;           // Bumped by initializeLocked
 
     size_t m_nonZeroBidCount = 0;
     size_t m_nonZeroAskCount = 0;
+    size_t m_bestBidIndex = kNoLevel;
+    size_t m_bestAskIndex = kNoLevel;
     double m_totalBidVolume = 0.0;
     double m_totalAskVolume = 0.0;
 
     std::chrono::system_clock::time_point m_lastUpdate;
+    std::atomic<bool> m_stale{false};
     mutable std::mutex m_mutex; // Thread safety for concurrent access
 };
 
 #include <QMetaType>
 Q_DECLARE_METATYPE(Trade)
 Q_DECLARE_METATYPE(BookDelta)
+Q_DECLARE_METATYPE(BookGrid)
 Q_DECLARE_METATYPE(std::vector<BookDelta>)
 
 #endif // TRADEDATA_H 
@@ -0,0 +1,140 @@
+#pragma once
+/*
+Sentinel — SequenceTracker
+Role: Detects l2_data sequence gaps/reorders and runs the per-product resync state machine (live → resyncing → live).
+Inputs/Outputs: Message sequence numbers, snapshot/update events → apply/buffer/drop decisions and the products needing resync.
+Threading: Not thread-safe; MarketDataCore guards it with m_seqMutex.
+Performance: O(1) per observation; buffered updates are moved out once when the snapshot lands.
+Integration: MarketDataCore::checkAndTrackSequence and handleOrderBook*; resync frames come from SubscriptionManager.
+Observability: Gap/reorder counters for diagnostics; callers log each resync they start.
+Related: MarketDataCore.hpp, SubscriptionManager.hpp, TradeData.h (BookLevelUpdate).
+Assumptions: Coinbase sequence_num counts every message on the connection, so a missing number cannot be pinned to one
+             product and marks every live book suspect; a number going backwards is attributed to its own product.
+*/
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../model/TradeData.h"
+
+class SequenceTracker {
+public:
+    enum class Decision { Apply, Buffer, Drop };
+
+    struct BufferedUpdate {
+        uint64_t seq = 0;
+        std::chrono::system_clock::time_point exchange_timestamp;
+        std::vector<BookLevelUpdate> levels;
+    };
+
+    static constexpr size_t kMaxBufferedUpdates = 20000;   // Per product; oldest are dropped beyond this
+
+    // Connection-wide continuity, once per received message. Returns true when numbers were skipped.
+    bool observeMessage(uint64_t seq) {
+        const bool gap = m_haveConnectionSeq && seq > m_lastConnectionSeq + 1;
+        if (gap) ++m_gapCount;
+        if (!m_haveConnectionSeq || seq > m_lastConnectionSeq) {
+            m_lastConnectionSeq = seq;
+            m_haveConnectionSeq = true;
+        }
+        return gap;
+    }
+
+    // Fresh connection: every subscription sends a new snapshot, so all product state is discarded
+    void reset() {
+        m_haveConnectionSeq = false;
+        m_lastConnectionSeq = 0;
+        m_products.clear();
+    }
+
+    // l2 update for a product. A stale (backwards) sequence returns Drop and leaves the product needing resync.
+    Decision onUpdate(const std::string& product, uint64_t seq) {
+        auto& state = m_products[product];
+        if (state.resyncing) return Decision::Buffer;
+        if (state.live && seq < state.lastSeq) {
+            ++m_reorderCount;
+            state.needsResync = true;
+            return Decision::Drop;
+        }
+        state.lastSeq = seq;
+        return Decision::Apply;
+    }
+
+    void buffer(const std::string& product, BufferedUpdate update) {
+        auto& pending = m_products[product].pending;
+        if (pending.size() >= kMaxBufferedUpdates) {
+            pending.pop_front();
+        }
+        pending.push_back(std::move(update));
+    }
+
+    // Snapshot arrived: the product is live again. Returns the buffered updates newer than the snapshot, in order.
+    std::vector<BufferedUpdate> onSnapshot(const std::string& product, uint64_t seq) {
+        auto& state = m_products[product];
+        std::vector<BufferedUpdate> replay;
+        replay.reserve(state.pending.size());
+        for (auto& update : state.pending) {
+            if (update.seq > seq) replay.push_back(std::move(update));
+        }
+        state.pending.clear();
+        state.live = true;
+        state.resyncing = false;
+        state.needsResync = false;
+        state.lastSeq = replay.empty() ? seq : replay.back().seq;
+        return replay;
+    }
+
+    // Marks live products suspect after a connection-level gap
+    void markAllLiveForResync() {
+        for (auto& [product, state] : m_products) {
+            if (state.live && !state.resyncing) state.needsResync = true;
+        }
+    }
+
+    // Products flagged for resync, or whose resync has waited longer than timeout for its snapshot.
+    // Returned products switch to resyncing (updates buffer) with the resync clock restarted.
+    std::vector<std::string> takeResyncRequests(std::chrono::steady_clock::time_point now,
+                                                std::chrono::milliseconds timeout) {
+        std::vector<std::string> out;
+        for (auto& [product, state] : m_products) {
+            const bool overdue = state.resyncing && now - state.resyncStarted > timeout;
+            if (state.needsResync || overdue) {
+                state.needsResync = false;
+                state.resyncing = true;
+                state.resyncStarted = now;
+                if (!overdue) state.pending.clear();
+                out.push_back(product);
+            }
+        }
+        return out;
+    }
+
+    bool isResyncing(const std::string& product) const {
+        auto it = m_products.find(product);
+        return it != m_products.end() && it->second.resyncing;
+    }
+    size_t pendingCount(const std::string& product) const {
+        auto it = m_products.find(product);
+        return it == m_products.end() ? 0 : it->second.pending.size();
+    }
+    uint64_t gapCount() const { return m_gapCount; }
+    uint64_t reorderCount() const { return m_reorderCount; }
+
+private:
+    struct ProductState {
+        uint64_t lastSeq = 0;
+        bool live = false;            // A snapshot has been applied
+        bool needsResync = false;
+        bool resyncing = false;       // Resubscribed; buffering until the snapshot
+        std::chrono::steady_clock::time_point resyncStarted;
+        std::deque<BufferedUpdate> pending;
+    };
+
+    std::unordered_map<std::string, ProductState> m_products;
+    uint64_t m_lastConnectionSeq = 0;
+    bool m_haveConnectionSeq = false;
+    uint64_t m_gapCount = 0;
+    uint64_t m_reorderCount = 0;
+};
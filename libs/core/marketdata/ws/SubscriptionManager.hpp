@@ -18,6 +18,22 @@ public:
         return buildMsgs("unsubscribe", jwt);
     }
 
+    // Single-product level2 resubscribe: the fresh subscription delivers a new snapshot without touching the socket
+    // or the other products' streams
+    std::vector<std::string> buildL2ResyncMsgs(const std::string& product, const std::string& jwt) const {
+        std::vector<std::string> out;
+        if (product.empty()) return out;
+        for (const char* type : {"unsubscribe", "subscribe"}) {
+            nlohmann::json msg;
+            msg["type"] = type;
+            msg["product_ids"] = nlohmann::json::array({product});
+            msg["channel"] = ch::kL2Subscribe;
+            msg["jwt"] = jwt;
+            out.emplace_back(msg.dump());
+        }
+        return out;
+    }
+
 private:
     std::vector<std::string> m_desired;
 
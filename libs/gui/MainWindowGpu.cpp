@@ -24,6 +24,9 @@ Assumptions: MarketDataCore becomes available from the client after subscribe()
 #include "ChartModeController.h"
 #include "MainWindowGpu.h"
 #include "UnifiedGridRenderer.h"
+#include "MultiSymbolHeatmapGrid.h"
+#include "render/HeatmapTileProcessor.hpp"
+#include "../core/marketdata/feeds/SyntheticFeedHandler.hpp"
 #include "render/DataProcessor.hpp"
 #include "SentinelLogging.hpp"
 #include "widgets/HeatmapDock.hpp"
@@ -43,6 +46,7 @@ Assumptions: MarketDataCore becomes available from the client after subscribe()
 #include <QTimer>
 #include <QSGRendererInterface>
 #include <QSettings>  // For config extraction
+#include <QStandardPaths>
 #include <QPushButton>
 #include <QGroupBox>
 #include <QVBoxLayout>
@@ -111,6 +115,15 @@ void MainWindowGPU::initializeDataComponents() {
     m_dataCache = std::make_unique<DataCache>();
 
     m_marketDataCore = std::make_unique<MarketDataCore>(*m_authenticator, *m_dataCache);
+
+    // Optional local venue for offline multi-venue work ([feeds] synthetic=true, replayFile=...)
+    if (config.value("feeds/synthetic", false).toBool()) {
+        SyntheticFeedHandler::Config simConfig;
+        simConfig.venue = config.value("feeds/syntheticVenue", "SIM").toString().toStdString();
+        simConfig.replayPath = config.value("feeds/replayFile", "").toString().toStdString();
+        simConfig.replaySpeed = config.value("feeds/replaySpeed", 1.0).toDouble();
+        m_marketDataCore->addFeedHandler(std::make_unique<SyntheticFeedHandler>(simConfig));
+    }
     m_marketDataCore->start();
 }
 
@@ -248,6 +261,10 @@ void MainWindowGPU::onSubscribe() {
     sLog_App("Subscribing to: " << symbol);
     updateSymbolInContext(symbol);
     propagateSymbolChange(symbol);
+    // Subscriptions are additive (grid tiles stream too), so pin the main chart to this symbol
+    if (auto unifiedGridRenderer = getUnifiedGridRenderer()) {
+        unifiedGridRenderer->setChartSymbol(symbol);
+    }
     if (m_marketDataCore) {
         m_marketDataCore->subscribeToSymbols({symbol.toStdString()});
     }
@@ -416,6 +433,24 @@ void MainWindowGPU::connectMarketDataSignals() {
     }
     
     unifiedGridRenderer->setDataCache(m_dataCache.get());
+    unifiedGridRenderer->setFeedAggregator(&m_marketDataCore->feeds());
+    // Warm restart from the previous session's heatmap history and trades, opt-in: [checkpoint] enabled=true,
+    // optional path= (default: the per-user app data directory) and restoreBooks=true for stale-marked books
+    QSettings config("config.ini", QSettings::IniFormat);
+    if (config.value("checkpoint/enabled", false).toBool()) {
+        QString checkpointPath = config.value("checkpoint/path").toString();
+        if (checkpointPath.isEmpty()) {
+            const QString dataDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+            QDir().mkpath(dataDir);
+            checkpointPath = QDir(dataDir).filePath("session.ckpt");
+        }
+        unifiedGridRenderer->setCheckpointPath(checkpointPath, config.value("checkpoint/restoreBooks", false).toBool());
+    }
+    unifiedGridRenderer->setTradeHistoryRetention(config.value("trades/historyMinutes", 240).toLongLong() * 60 * 1000,
+                                                  config.value("trades/historyMB", 64).toLongLong() * 1024 * 1024);
+    unifiedGridRenderer->setPresentationPolicy(PresentationPolicy::fromConfig());
+    // [feeds] consolidatedHeatmap=true draws the heatmap from every venue's book merged by price
+    unifiedGridRenderer->setConsolidatedBook(config.value("feeds/consolidatedHeatmap", false).toBool());
 
     auto dataProcessor = unifiedGridRenderer->getDataProcessor();
     if (dataProcessor) {
@@ -429,6 +464,25 @@ void MainWindowGPU::connectMarketDataSignals() {
     
     connect(m_marketDataCore.get(), &MarketDataCore::connectionStatusChanged,
             this, &MainWindowGPU::onConnectionStatusChanged);  // Extracted slot
+    
+    // Multi-symbol grid: one shared tile processor samples every tile's book
+    if (auto grid = getMultiSymbolGrid()) {
+        grid->setDataCache(m_dataCache.get());
+        connect(m_marketDataCore.get(), &MarketDataCore::liveOrderBookUpdated,
+                grid->tileProcessor(), &HeatmapTileProcessor::onLiveOrderBookUpdated, Qt::QueuedConnection);
+        
+        auto subscribeGridSymbols = [this, grid]() {
+            if (!grid->active() || !m_marketDataCore) return;
+            std::vector<std::string> symbols;
+            for (const QString& symbol : grid->symbols()) {
+                symbols.push_back(symbol.toStdString());
+            }
+            m_marketDataCore->subscribeToSymbols(symbols);
+        };
+        connect(grid, &MultiSymbolHeatmapGrid::activeChanged, this, subscribeGridSymbols);
+        connect(grid, &MultiSymbolHeatmapGrid::symbolsChanged, this, subscribeGridSymbols);
+        subscribeGridSymbols();
+    }
 }
 
 void MainWindowGPU::onConnectionStatusChanged(bool connected) {  // Extracted for clarity
@@ -507,3 +561,7 @@ void MainWindowGPU::resetLayoutToDefault() {
 UnifiedGridRenderer* MainWindowGPU::getUnifiedGridRenderer() const {
     return m_qquickView->rootObject() ? m_qquickView->rootObject()->findChild<UnifiedGridRenderer*>("unifiedGridRenderer") : nullptr;
 }
+
+MultiSymbolHeatmapGrid* MainWindowGPU::getMultiSymbolGrid() const {
+    return m_qquickView->rootObject() ? m_qquickView->rootObject()->findChild<MultiSymbolHeatmapGrid*>("multiSymbolGrid") : nullptr;
+}
@@ -40,6 +40,7 @@ Assumptions: The hosted QML scene exposes a 'unifiedGridRenderer' object.
 // Forward declarations
 class ChartModeController;
 class UnifiedGridRenderer;
+class MultiSymbolHeatmapGrid;
 class HeatmapDock;
 class StatusDock;
 class StatusBar;
@@ -90,6 +91,7 @@ private:
     void propagateSymbolChange(const QString& symbol);
     bool validateComponents();
     UnifiedGridRenderer* getUnifiedGridRenderer() const;
+    MultiSymbolHeatmapGrid* getMultiSymbolGrid() const;
     QString graphicsApiName(QSGRendererInterface::GraphicsApi api);
     
     /**
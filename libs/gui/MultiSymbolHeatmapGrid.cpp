@@ -0,0 +1,281 @@
+/*
+Sentinel — MultiSymbolHeatmapGrid
+Role: Implements tile layout, processor thread lifecycle, and the single-texture atlas node.
+Inputs/Outputs: Property changes → HeatmapTileProcessor::configure; published atlas frames → textured quads.
+Threading: Setters run on the GUI thread; updatePaintNode runs on the render thread and only reads published frames.
+Performance: Each tile is two quads (its column ring unwrapped oldest → newest) into the same texture; only tiles
+             whose image changed since the last frame are blitted into the node's atlas.
+Integration: See MultiSymbolHeatmapGrid.h.
+Observability: sLog_App on construction/teardown.
+Related: MultiSymbolHeatmapGrid.h, render/HeatmapTileProcessor.cpp.
+Assumptions: The atlas is small (tiles × columns × rows texels), so it is re-uploaded whole on each new frame.
+*/
+#include "MultiSymbolHeatmapGrid.h"
+#include "render/HeatmapTileProcessor.hpp"
+#include "themes/ThemeManager.hpp"
+#include "SentinelLogging.hpp"
+#include <QMetaObject>
+#include <QQuickWindow>
+#include <QSGGeometry>
+#include <QSGGeometryNode>
+#include <QSGTexture>
+#include <QSGTextureMaterial>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+    // Owns the atlas texture so it is released on the render thread together with the node
+    class AtlasNode : public QSGGeometryNode {
+    public:
+        AtlasNode() {
+            auto* geometry = new QSGGeometry(QSGGeometry::defaultAttributes_TexturedPoint2D(), 0);
+            geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+            setGeometry(geometry);
+            setFlag(QSGNode::OwnsGeometry);
+            auto* material = new QSGTextureMaterial();
+            material->setFiltering(QSGTexture::Nearest);  // Columns/rows stay crisp when scaled up
+            setMaterial(material);
+            setFlag(QSGNode::OwnsMaterial);
+        }
+        ~AtlasNode() override { delete m_texture; }
+
+        void setTexture(QSGTexture* texture) {
+            static_cast<QSGTextureMaterial*>(material())->setTexture(texture);
+            delete m_texture;
+            m_texture = texture;
+            markDirty(QSGNode::DirtyMaterial);
+        }
+
+        // Copies the tiles whose image changed since the last frame into the node's atlas; true if any did
+        bool blitChangedTiles(const HeatmapAtlasFrame& frame) {
+            if (atlas.size() != frame.atlasSize) {
+                atlas = QImage(frame.atlasSize, QImage::Format_ARGB32_Premultiplied);
+                atlas.fill(Qt::transparent);
+                tileKeys.clear();
+            }
+            tileKeys.resize(frame.tileImages.size(), 0);
+            bool changed = false;
+            for (size_t i = 0; i < frame.tileImages.size(); ++i) {
+                const QImage& image = frame.tileImages[i];
+                if (image.isNull() || image.cacheKey() == tileKeys[i]) continue;
+                tileKeys[i] = image.cacheKey();
+                const QRect& rect = frame.tiles[i].atlasRect;
+                const size_t rowBytes = static_cast<size_t>(rect.width()) * sizeof(QRgb);
+                for (int r = 0; r < rect.height(); ++r) {
+                    std::memcpy(reinterpret_cast<QRgb*>(atlas.scanLine(rect.y() + r)) + rect.x(),
+                                image.constScanLine(r), rowBytes);
+                }
+                changed = true;
+            }
+            return changed;
+        }
+
+        uint64_t version = 0;
+        QImage atlas;
+        std::vector<qint64> tileKeys;  // QImage::cacheKey of each tile as last blitted
+
+    private:
+        QSGTexture* m_texture = nullptr;
+    };
+
+    void addQuad(QSGGeometry::TexturedPoint2D*& v, const QRectF& screen, const QRectF& uv) {
+        const float x0 = static_cast<float>(screen.left()), x1 = static_cast<float>(screen.right());
+        const float y0 = static_cast<float>(screen.top()), y1 = static_cast<float>(screen.bottom());
+        const float u0 = static_cast<float>(uv.left()), u1 = static_cast<float>(uv.right());
+        const float t0 = static_cast<float>(uv.top()), t1 = static_cast<float>(uv.bottom());
+        (v++)->set(x0, y0, u0, t0);
+        (v++)->set(x1, y0, u1, t0);
+        (v++)->set(x0, y1, u0, t1);
+        (v++)->set(x1, y0, u1, t0);
+        (v++)->set(x1, y1, u1, t1);
+        (v++)->set(x0, y1, u0, t1);
+    }
+}
+
+MultiSymbolHeatmapGrid::MultiSymbolHeatmapGrid(QQuickItem* parent)
+    : QQuickItem(parent) {
+    setFlag(ItemHasContents, true);
+
+    // One processor thread for every tile, however many symbols are shown
+    m_processorThread = std::make_unique<QThread>();
+    m_processorThread->setObjectName(QStringLiteral("HeatmapTileProcessor"));
+    m_processor = std::make_unique<HeatmapTileProcessor>();
+    m_processor->moveToThread(m_processorThread.get());
+    connect(m_processor.get(), &HeatmapTileProcessor::frameReady,
+            this, &QQuickItem::update, Qt::QueuedConnection);
+    m_processorThread->start();
+
+    sLog_App("MultiSymbolHeatmapGrid: Initialized");
+}
+
+MultiSymbolHeatmapGrid::~MultiSymbolHeatmapGrid() {
+    if (m_processorThread && m_processorThread->isRunning()) {
+        QMetaObject::invokeMethod(m_processor.get(), &HeatmapTileProcessor::stop, Qt::BlockingQueuedConnection);
+        m_processorThread->quit();
+        if (!m_processorThread->wait(5000)) {
+            sLog_App("MultiSymbolHeatmapGrid: tile thread did not finish in time, terminating...");
+            m_processorThread->terminate();
+            m_processorThread->wait(1000);
+        }
+    }
+    m_processor.reset();
+    m_processorThread.reset();
+    sLog_App("MultiSymbolHeatmapGrid destroyed");
+}
+
+void MultiSymbolHeatmapGrid::setDataCache(DataCache* cache) {
+    // The processor only reads the cache from its timer, which starts after this
+    m_processor->setDataCache(cache);
+    if (m_active) {
+        QMetaObject::invokeMethod(m_processor.get(), &HeatmapTileProcessor::start, Qt::QueuedConnection);
+    }
+}
+
+void MultiSymbolHeatmapGrid::setSymbols(const QStringList& symbols) {
+    if (m_symbols == symbols) return;
+    m_symbols = symbols;
+    emit symbolsChanged();
+    emit layoutChanged();
+    reconfigure();
+}
+
+void MultiSymbolHeatmapGrid::setGridColumns(int columns) {
+    columns = std::max(1, columns);
+    if (m_gridColumns == columns) return;
+    m_gridColumns = columns;
+    emit gridColumnsChanged();
+    emit layoutChanged();
+    reconfigure();
+}
+
+void MultiSymbolHeatmapGrid::setHistorySeconds(int seconds) {
+    seconds = std::max(1, seconds);
+    if (m_historySeconds == seconds) return;
+    m_historySeconds = seconds;
+    emit historySecondsChanged();
+    reconfigure();
+}
+
+void MultiSymbolHeatmapGrid::setBandPercent(double percent) {
+    if (m_bandPercent == percent || percent <= 0.0) return;
+    m_bandPercent = percent;
+    emit bandPercentChanged();
+    reconfigure();
+}
+
+void MultiSymbolHeatmapGrid::setActive(bool active) {
+    if (m_active == active) return;
+    m_active = active;
+    emit activeChanged();
+    // Hidden grids cost nothing: the sampling timer only runs while active
+    if (m_active) {
+        QMetaObject::invokeMethod(m_processor.get(), &HeatmapTileProcessor::start, Qt::QueuedConnection);
+    } else {
+        QMetaObject::invokeMethod(m_processor.get(), &HeatmapTileProcessor::stop, Qt::QueuedConnection);
+    }
+}
+
+int MultiSymbolHeatmapGrid::gridRows() const {
+    const int count = static_cast<int>(m_symbols.size());
+    return std::max(1, (count + m_gridColumns - 1) / m_gridColumns);
+}
+
+double MultiSymbolHeatmapGrid::tileWidth() const {
+    return std::max(0.0, (width() - kTileGap * (m_gridColumns - 1)) / m_gridColumns);
+}
+
+double MultiSymbolHeatmapGrid::tileHeight() const {
+    const int rows = gridRows();
+    return std::max(0.0, (height() - kTileGap * (rows - 1)) / rows);
+}
+
+void MultiSymbolHeatmapGrid::geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry) {
+    QQuickItem::geometryChange(newGeometry, oldGeometry);
+    if (newGeometry.size() != oldGeometry.size()) {
+        emit layoutChanged();
+        reconfigure();
+    }
+}
+
+void MultiSymbolHeatmapGrid::reconfigure() {
+    // Tile pixel size drives each tile's LOD (column period and row count)
+    const int tileW = static_cast<int>(tileWidth());
+    const int tileH = static_cast<int>(tileHeight());
+    QMetaObject::invokeMethod(m_processor.get(), [processor = m_processor.get(), symbols = m_symbols,
+                                                  columns = m_gridColumns, tileW, tileH,
+                                                  history = m_historySeconds, band = m_bandPercent]() {
+        processor->configure(symbols, columns, tileW, tileH, history, band);
+    }, Qt::QueuedConnection);
+}
+
+QSGNode* MultiSymbolHeatmapGrid::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData*) {
+    // Runs while the GUI thread is blocked, so ThemeManager is safe to read; the ramp itself is immutable
+    const ThemeManager& themes = ThemeManager::instance();
+    if (!m_colorRamp || themes.themeRevision() != m_themeRevision) {
+        m_themeRevision = themes.themeRevision();
+        m_colorRamp = ColorRamp::fromTheme(themes.activeTheme());
+        QMetaObject::invokeMethod(m_processor.get(), [processor = m_processor.get(), ramp = m_colorRamp]() {
+            processor->setColorRamp(ramp);
+        }, Qt::QueuedConnection);
+    }
+
+    auto frame = m_processor->publishedFrame();
+    if (!frame || frame->atlasSize.isEmpty() || frame->tiles.empty() || !window()) {
+        delete oldNode;
+        return nullptr;
+    }
+
+    auto* node = static_cast<AtlasNode*>(oldNode);
+    if (!node) node = new AtlasNode();
+
+    if (node->version != frame->version) {
+        if (node->blitChangedTiles(*frame)) {
+            node->setTexture(window()->createTextureFromImage(node->atlas));
+        }
+        node->version = frame->version;
+    }
+
+    // allocate() discards contents, so size the buffer before writing: one quad, plus one while the ring has wrapped
+    int quads = 0;
+    for (const HeatmapTileInfo& tile : frame->tiles) {
+        if (tile.hasData) quads += tile.head + 1 < tile.atlasRect.width() ? 2 : 1;
+    }
+    QSGGeometry* geometry = node->geometry();
+    geometry->allocate(quads * 6);
+    auto* v = geometry->vertexDataAsTexturedPoint2D();
+
+    const double atlasW = frame->atlasSize.width();
+    const double atlasH = frame->atlasSize.height();
+    const double tileW = tileWidth();
+    const double tileH = tileHeight();
+    for (size_t i = 0; i < frame->tiles.size(); ++i) {
+        const HeatmapTileInfo& tile = frame->tiles[i];
+        if (!tile.hasData) continue;
+
+        const int cellX = static_cast<int>(i) % m_gridColumns;
+        const int cellY = static_cast<int>(i) / m_gridColumns;
+        const double x = cellX * (tileW + kTileGap);
+        const double y = cellY * (tileH + kTileGap);
+        const int columns = tile.atlasRect.width();
+        const double columnW = tileW / columns;
+        const double v0 = tile.atlasRect.top() / atlasH;
+        const double v1 = (tile.atlasRect.top() + tile.atlasRect.height()) / atlasH;
+
+        // Ring unwrap: columns after head are older and go left, [0, head] are newer and go right
+        const int olderCount = columns - 1 - tile.head;
+        const int newerCount = tile.head + 1;
+        if (olderCount > 0) {
+            const double u0 = (tile.atlasRect.left() + tile.head + 1) / atlasW;
+            const double u1 = (tile.atlasRect.left() + columns) / atlasW;
+            addQuad(v, QRectF(x, y, olderCount * columnW, tileH), QRectF(QPointF(u0, v0), QPointF(u1, v1)));
+        }
+        const double u0 = tile.atlasRect.left() / atlasW;
+        const double u1 = (tile.atlasRect.left() + newerCount) / atlasW;
+        addQuad(v, QRectF(x + olderCount * columnW, y, newerCount * columnW, tileH),
+                QRectF(QPointF(u0, v0), QPointF(u1, v1)));
+    }
+
+    node->markDirty(QSGNode::DirtyGeometry);
+    return node;
+}
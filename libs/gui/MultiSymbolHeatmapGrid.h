@@ -0,0 +1,84 @@
+/*
+Sentinel — MultiSymbolHeatmapGrid
+Role: A QML scene item that shows N small liquidity heatmaps (e.g. 3×3 symbols) side by side.
+Inputs/Outputs: Takes a symbol list and grid shape; draws every tile from one shared atlas texture.
+Threading: GUI thread owns the item; one HeatmapTileProcessor thread samples all tiles; render thread uploads.
+Performance: One processing thread, one texture and one geometry node regardless of the tile count.
+Integration: Used in DepthChartView.qml; MainWindowGPU wires DataCache and liveOrderBookUpdated to tileProcessor().
+Observability: Logs lifecycle via sLog_App; tile configuration is logged by the processor.
+Related: MultiSymbolHeatmapGrid.cpp, render/HeatmapTileProcessor.hpp, UnifiedGridRenderer.h.
+Assumptions: Symbols shown here are subscribed by the host window (symbolsChanged → subscribe).
+*/
+#pragma once
+#include <QQuickItem>
+#include <QStringList>
+#include <QThread>
+#include <memory>
+
+class ColorRamp;
+class DataCache;
+class HeatmapTileProcessor;
+
+class MultiSymbolHeatmapGrid : public QQuickItem {
+    Q_OBJECT
+    QML_ELEMENT
+
+    Q_PROPERTY(QStringList symbols READ symbols WRITE setSymbols NOTIFY symbolsChanged)
+    Q_PROPERTY(int gridColumns READ gridColumns WRITE setGridColumns NOTIFY gridColumnsChanged)
+    Q_PROPERTY(int historySeconds READ historySeconds WRITE setHistorySeconds NOTIFY historySecondsChanged)
+    Q_PROPERTY(double bandPercent READ bandPercent WRITE setBandPercent NOTIFY bandPercentChanged)
+    Q_PROPERTY(bool active READ active WRITE setActive NOTIFY activeChanged)
+    Q_PROPERTY(double tileWidth READ tileWidth NOTIFY layoutChanged)
+    Q_PROPERTY(double tileHeight READ tileHeight NOTIFY layoutChanged)
+
+public:
+    static constexpr double kTileGap = 2.0;
+
+    explicit MultiSymbolHeatmapGrid(QQuickItem* parent = nullptr);
+    ~MultiSymbolHeatmapGrid() override;
+
+    void setDataCache(DataCache* cache);
+    HeatmapTileProcessor* tileProcessor() const { return m_processor.get(); }
+
+    QStringList symbols() const { return m_symbols; }
+    void setSymbols(const QStringList& symbols);
+    int gridColumns() const { return m_gridColumns; }
+    void setGridColumns(int columns);
+    int historySeconds() const { return m_historySeconds; }
+    void setHistorySeconds(int seconds);
+    double bandPercent() const { return m_bandPercent; }
+    void setBandPercent(double percent);
+    bool active() const { return m_active; }
+    void setActive(bool active);
+
+    int gridRows() const;
+    double tileWidth() const;
+    double tileHeight() const;
+
+signals:
+    void symbolsChanged();
+    void gridColumnsChanged();
+    void historySecondsChanged();
+    void bandPercentChanged();
+    void activeChanged();
+    void layoutChanged();
+
+protected:
+    QSGNode* updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData*) override;
+    void geometryChange(const QRectF& newGeometry, const QRectF& oldGeometry) override;
+
+private:
+    void reconfigure();
+
+    QStringList m_symbols;
+    int m_gridColumns = 3;
+    int m_historySeconds = 120;
+    double m_bandPercent = 0.5;
+    bool m_active = false;
+    // Theme palettes handed to the tile processor; rebuilt when ThemeManager's revision changes (render thread)
+    std::shared_ptr<const ColorRamp> m_colorRamp;
+    quint64 m_themeRevision = 0;
+
+    std::unique_ptr<QThread> m_processorThread;
+    std::unique_ptr<HeatmapTileProcessor> m_processor;
+};
@@ -20,19 +20,30 @@ Assumptions: The render strategies are compatible and can be layered together.
 #include <QMetaObject>
 #include <QMetaType>
 #include <QDateTime>
-// #include <algorithm>
-// #include <cmath>
+#include <QQuickWindow>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+#include <rhi/qrhi.h>
+#endif
 
 // New modular architecture includes
 #include "render/GridTypes.hpp"
 #include "render/GridViewState.hpp"
 #include "render/GridSceneNode.hpp" 
 #include "render/DataProcessor.hpp"
+#include "render/RenderDiagnostics.hpp"
+#include "themes/ThemeManager.hpp"
 #include "render/IRenderStrategy.hpp"
 #include "render/strategies/HeatmapStrategy.hpp"
 #include "render/strategies/TradeFlowStrategy.hpp"
 #include "render/strategies/TradeBubbleStrategy.hpp"
 #include "render/strategies/CandleStrategy.hpp"
+#include "render/strategies/OrderFlowOverlayStrategy.hpp"
+#include "render/strategies/FootprintStrategy.hpp"
+#include "render/strategies/IcebergOverlayStrategy.hpp"
+#include "render/strategies/OrderBookDepthStrategy.hpp"
 
 UnifiedGridRenderer::UnifiedGridRenderer(QQuickItem* parent)
     : QQuickItem(parent)
@@ -51,6 +62,7 @@ UnifiedGridRenderer::UnifiedGridRenderer(QQuickItem* parent)
 
 UnifiedGridRenderer::~UnifiedGridRenderer() {
     sLog_App("UnifiedGridRenderer destructor - cleaning up...");
+    trackWindow(nullptr);  // Render-thread timing hooks reference m_diagnostics
     
     if (m_dataProcessor) {
         m_dataProcessor->stopProcessing();
@@ -75,14 +87,15 @@ UnifiedGridRenderer::~UnifiedGridRenderer() {
 }
 
 void UnifiedGridRenderer::onTradeReceived(const Trade& trade) {
-    // Store recent trades for bubble rendering (keep last 1000 trades)
+    // Store the print for bubble rendering (history is bounded by the store's retention)
     {
         std::lock_guard<std::mutex> lock(m_dataMutex);
-        m_recentTrades.push_back(trade);
-        if (m_recentTrades.size() > 1000) {
-            m_recentTrades.erase(m_recentTrades.begin(), m_recentTrades.begin() + 100); // Remove oldest 100
+        if (!m_chartSymbol.empty() && trade.product_id != m_chartSymbol) {
+            return;
         }
+        m_tradeSymbol = trade.product_id;
     }
+    m_tradeHistory.onTrade(trade);
     
     if (m_dataProcessor) {
         QMetaObject::invokeMethod(m_dataProcessor.get(), "onTradeReceived", 
@@ -109,7 +122,8 @@ void UnifiedGridRenderer::onViewportChanged() {
     if (!m_viewState || !m_dataProcessor) return;
     // Trigger data processor to recalculate visible cells for new viewport
     QMetaObject::invokeMethod(m_dataProcessor.get(), "updateVisibleCells", Qt::QueuedConnection);
-    // Mark transform dirty for rendering update
+    // World-space layers re-map to the new viewport on the next frame
+    m_viewportDirty.store(true);
     m_transformDirty.store(true);
     update();
 }
@@ -126,7 +140,8 @@ void UnifiedGridRenderer::geometryChange(const QRectF &newGeometry, const QRectF
             m_viewState->setViewportSize(newGeometry.width(), newGeometry.height());
         }
 
-        // Size change only affects transform, not geometry topology
+        // Size change only affects the world → pixel mapping, not geometry topology
+        m_viewportDirty.store(true);
         m_transformDirty.store(true);
         update();
     }
@@ -147,7 +162,7 @@ void UnifiedGridRenderer::updateVisibleCells() {
     // Non-blocking: consume latest snapshot, request async recompute if needed
     if (m_dataProcessor) {
         // Try to grab the latest published cells without blocking the worker
-        auto snapshot = m_dataProcessor->getPublishedCellsSnapshot();
+        auto snapshot = m_dataProcessor->getPublishedCellsSnapshot(&m_cellCoverage);
         if (snapshot) {
             m_visibleCells.assign(snapshot->begin(), snapshot->end());
         }
@@ -275,6 +290,48 @@ void UnifiedGridRenderer::setShowTradeFlowLayer(bool show) {
     }
 }
 
+void UnifiedGridRenderer::setShowOrderFlowLayer(bool show) {
+    if (m_showOrderFlowLayer != show) {
+        m_showOrderFlowLayer = show;
+        m_geometryDirty.store(true);
+        update();
+        emit showOrderFlowLayerChanged();
+    }
+}
+
+void UnifiedGridRenderer::setShowFootprintLayer(bool show) {
+    if (m_showFootprintLayer != show) {
+        m_showFootprintLayer = show;
+        m_geometryDirty.store(true);
+        update();
+        emit showFootprintLayerChanged();
+    }
+}
+
+void UnifiedGridRenderer::setShowIcebergLayer(bool show) {
+    if (m_showIcebergLayer != show) {
+        m_showIcebergLayer = show;
+        m_geometryDirty.store(true);
+        update();
+        emit showIcebergLayerChanged();
+    }
+}
+
+void UnifiedGridRenderer::setLiquidityDisplayMode(int mode) {
+    if (m_liquidityDisplayMode != mode) {
+        m_liquidityDisplayMode = mode;
+        // Cell rebuild happens on the processor thread
+        if (m_dataProcessor) {
+            QMetaObject::invokeMethod(m_dataProcessor.get(), [this, mode]() {
+                m_dataProcessor->setDisplayMode(mode);
+            }, Qt::QueuedConnection);
+        }
+        m_geometryDirty.store(true);
+        update();
+        emit liquidityDisplayModeChanged();
+    }
+}
+
 void UnifiedGridRenderer::clearData() {
     // Delegate to DataProcessor
     if (m_dataProcessor) {
@@ -291,12 +348,26 @@ void UnifiedGridRenderer::clearData() {
 
 void UnifiedGridRenderer::setPriceResolution(double resolution) {
     if (m_dataProcessor && resolution > 0) {
-        m_dataProcessor->setPriceResolution(resolution);
+        // Re-bucketing the cached cells happens on the processor thread
+        QMetaObject::invokeMethod(m_dataProcessor.get(), [processor = m_dataProcessor.get(), resolution]() {
+            processor->setPriceResolution(resolution);
+        }, Qt::QueuedConnection);
         m_geometryDirty.store(true);
         update();
     }
 }
 
+void UnifiedGridRenderer::setConsolidatedBook(bool enabled) {
+    if (m_consolidatedBook == enabled) return;
+    m_consolidatedBook = enabled;
+    if (m_dataProcessor) {
+        QMetaObject::invokeMethod(m_dataProcessor.get(), [processor = m_dataProcessor.get(), enabled]() {
+            processor->setConsolidatedBook(enabled);
+        }, Qt::QueuedConnection);
+    }
+    emit consolidatedBookChanged();
+}
+
 void UnifiedGridRenderer::setGridMode(int mode) {
     double priceRes[] = {2.5, 5.0, 10.0};
     int timeRes[] = {50, 100, 250};
@@ -309,17 +380,20 @@ void UnifiedGridRenderer::setGridMode(int mode) {
 void UnifiedGridRenderer::setTimeframe(int timeframe_ms) {
     if (m_currentTimeframe_ms != timeframe_ms) {
         m_currentTimeframe_ms = timeframe_ms;
-        m_manualTimeframeSet = true;
-        m_manualTimeframeTimer.start();
-        if (m_dataProcessor) m_dataProcessor->addTimeframe(timeframe_ms);
+        // Manual pick: the processor's LOD controller holds it until the viewport outgrows it
+        if (m_dataProcessor) {
+            QMetaObject::invokeMethod(m_dataProcessor.get(), [processor = m_dataProcessor.get(), timeframe_ms]() {
+                processor->setTimeframe(timeframe_ms);
+            }, Qt::QueuedConnection);
+        }
         m_geometryDirty.store(true);
         update();
         emit timeframeChanged();
     }
 }
 
-void UnifiedGridRenderer::zoomIn() { if (m_viewState) { m_viewState->handleZoomWithViewport(0.1, QPointF(width()/2, height()/2), QSizeF(width(), height())); m_transformDirty.store(true); m_appendPending.store(true); update(); } }
-void UnifiedGridRenderer::zoomOut() { if (m_viewState) { m_viewState->handleZoomWithViewport(-0.1, QPointF(width()/2, height()/2), QSizeF(width(), height())); m_transformDirty.store(true); m_appendPending.store(true); update(); } }
+void UnifiedGridRenderer::zoomIn() { if (m_viewState) { m_viewState->handleZoomWithViewport(0.1, QPointF(width()/2, height()/2), QSizeF(width(), height())); m_transformDirty.store(true); update(); } }
+void UnifiedGridRenderer::zoomOut() { if (m_viewState) { m_viewState->handleZoomWithViewport(-0.1, QPointF(width()/2, height()/2), QSizeF(width(), height())); m_transformDirty.store(true); update(); } }
 void UnifiedGridRenderer::resetZoom() { if (m_viewState) { m_viewState->resetZoom(); m_transformDirty.store(true); update(); } }
 void UnifiedGridRenderer::panLeft() { if (m_viewState) { m_viewState->panLeft(); m_transformDirty.store(true); update(); } }
 void UnifiedGridRenderer::panRight() { if (m_viewState) { m_viewState->panRight(); m_transformDirty.store(true); update(); } }
@@ -381,15 +455,15 @@ void UnifiedGridRenderer::init() {
     // Connect signals with QueuedConnection for thread safety  
     connect(m_dataProcessor.get(), &DataProcessor::dataUpdated, 
             this, [this]() { 
-                // If a pan sync is pending, clear the visual offset now (GUI thread)
-                if (m_panSyncPending && m_viewState) {
-                    m_viewState->clearPanVisualOffset();
-                    m_panSyncPending = false;
-                    m_transformDirty.store(true);
-                }
                 // Non-blocking refresh: new data arrived, append cells
                 m_appendPending.store(true);
-                update();
+                scheduleDataRepaint();
+            }, Qt::QueuedConnection);
+    connect(m_dataProcessor.get(), &DataProcessor::liveColumnUpdated,
+            this, [this]() {
+                // Only the still-building column moved; finalized layers stay as they are
+                m_liveDirty.store(true);
+                scheduleDataRepaint();
             }, Qt::QueuedConnection);
     connect(m_dataProcessor.get(), &DataProcessor::viewportInitialized,
             this, &UnifiedGridRenderer::viewportChanged, Qt::QueuedConnection);
@@ -408,10 +482,20 @@ void UnifiedGridRenderer::init() {
         m_dataProcessor->setGridViewState(m_viewState.get());
     }, Qt::QueuedConnection);
     
+    m_diagnostics = std::make_unique<RenderDiagnostics>();
+    m_frameCapTimer.setSingleShot(true);
+    m_frameCapTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_frameCapTimer, &QTimer::timeout, this, [this]() { update(); });
+    connect(this, &QQuickItem::windowChanged, this, &UnifiedGridRenderer::trackWindow);
+    
     m_heatmapStrategy = std::make_unique<HeatmapStrategy>();
     m_tradeFlowStrategy = std::make_unique<TradeFlowStrategy>();
     m_tradeBubbleStrategy = std::make_unique<TradeBubbleStrategy>();
     m_candleStrategy = std::make_unique<CandleStrategy>();
+    m_orderFlowStrategy = std::make_unique<OrderFlowOverlayStrategy>();
+    m_footprintStrategy = std::make_unique<FootprintStrategy>();
+    m_icebergStrategy = std::make_unique<IcebergOverlayStrategy>();
+    m_depthStrategy = std::make_unique<OrderBookDepthStrategy>();
     
     // Initialize bubble strategy with default configuration
     auto* bubbleStrategy = static_cast<TradeBubbleStrategy*>(m_tradeBubbleStrategy.get());
@@ -422,6 +506,13 @@ void UnifiedGridRenderer::init() {
     connect(m_viewState.get(), &GridViewState::viewportChanged, this, &UnifiedGridRenderer::viewportChanged);
     connect(m_viewState.get(), &GridViewState::viewportChanged, this, &UnifiedGridRenderer::onViewportChanged);
     connect(m_viewState.get(), &GridViewState::panVisualOffsetChanged, this, &UnifiedGridRenderer::panVisualOffsetChanged);
+    connect(m_viewState.get(), &GridViewState::panPrefetchRequested, this,
+            [processor = m_dataProcessor.get()](qint64 timeStart, qint64 timeEnd, double priceMin, double priceMax) {
+                // Cells for the region a drag is heading into are built on the processor thread
+                QMetaObject::invokeMethod(processor, [=]() {
+                    processor->prefetchRegion(timeStart, timeEnd, priceMin, priceMax);
+                }, Qt::QueuedConnection);
+            });
     connect(m_viewState.get(), &GridViewState::autoScrollEnabledChanged, this, &UnifiedGridRenderer::autoScrollEnabledChanged);
     
     QMetaObject::invokeMethod(
@@ -442,12 +533,110 @@ void UnifiedGridRenderer::setDataCache(DataCache* cache) {
     }
 }
 
+void UnifiedGridRenderer::setFeedAggregator(const FeedAggregator* feeds) {
+    if (m_dataProcessor) {
+        QMetaObject::invokeMethod(m_dataProcessor.get(), [processor = m_dataProcessor.get(), feeds]() {
+            processor->setFeedAggregator(feeds);
+        }, Qt::QueuedConnection);
+    }
+}
+
+void UnifiedGridRenderer::setChartSymbol(const QString& symbol) {
+    {
+        std::lock_guard<std::mutex> lock(m_dataMutex);
+        m_chartSymbol = symbol.toStdString();
+    }
+    if (m_dataProcessor) {
+        QMetaObject::invokeMethod(m_dataProcessor.get(), [processor = m_dataProcessor.get(), symbol]() {
+            processor->setChartSymbol(symbol);
+        }, Qt::QueuedConnection);
+    }
+}
+
+void UnifiedGridRenderer::setTradeHistoryRetention(qint64 maxAge_ms, qint64 maxBytesPerSymbol) {
+    TradeHistoryStore::Retention retention;
+    retention.maxAge_ms = std::max<qint64>(maxAge_ms, 1000);
+    retention.maxBytesPerSymbol = static_cast<size_t>(std::max<qint64>(maxBytesPerSymbol, TradeHistoryStore::kChunkBytes));
+    m_tradeHistory.setRetention(retention);
+}
+
+void UnifiedGridRenderer::setPresentationPolicy(const PresentationPolicy& policy) {
+    m_presentationPolicy = policy;
+    sLog_App("UnifiedGridRenderer presentation:" << policy.describe());
+}
+
+void UnifiedGridRenderer::scheduleDataRepaint() {
+    // Interaction repaints stay immediate; only data-driven frames are coalesced to the cap
+    const qint64 minInterval = m_presentationPolicy.minFrameInterval_ms();
+    if (minInterval <= 0) {
+        update();
+        return;
+    }
+    if (m_frameCapTimer.isActive()) return;  // A capped repaint is already queued
+
+    const qint64 now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    const qint64 sinceLast = now - m_lastPaintMs.load(std::memory_order_relaxed);
+    if (sinceLast >= minInterval) {
+        update();
+    } else {
+        m_frameCapTimer.start(static_cast<int>(minInterval - sinceLast));
+    }
+}
+
+void UnifiedGridRenderer::trackWindow(QQuickWindow* window) {
+    if (m_trackedWindow) {
+        disconnect(m_trackedWindow, nullptr, this, nullptr);
+    }
+    m_trackedWindow = window;
+    if (!window || !m_diagnostics) return;
+
+    // Render-loop stage marks; all of these signals are emitted on the render thread
+    RenderDiagnostics* diagnostics = m_diagnostics.get();
+    connect(window, &QQuickWindow::beforeSynchronizing, this, [diagnostics]() {
+        diagnostics->markSyncBegin();
+    }, Qt::DirectConnection);
+    connect(window, &QQuickWindow::afterSynchronizing, this, [diagnostics]() {
+        diagnostics->markSyncEnd();
+    }, Qt::DirectConnection);
+    connect(window, &QQuickWindow::beforeRendering, this, [diagnostics]() {
+        diagnostics->markRenderBegin();
+    }, Qt::DirectConnection);
+    connect(window, &QQuickWindow::afterRendering, this, [diagnostics, window]() {
+        diagnostics->markRenderEnd();
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+        // Timestamps complete a frame or two late; requires QQuickGraphicsConfiguration::setTimestamps(true)
+        if (QRhiSwapChain* swapChain = window->swapChain()) {
+            if (QRhiCommandBuffer* cb = swapChain->currentFrameCommandBuffer()) {
+                const double gpuSeconds = cb->lastCompletedGpuTime();
+                if (gpuSeconds > 0.0) diagnostics->recordGpuTime(gpuSeconds * 1000.0);
+            }
+        }
+#else
+        Q_UNUSED(window)
+#endif
+    }, Qt::DirectConnection);
+    connect(window, &QQuickWindow::afterFrameEnd, this, [diagnostics]() {
+        diagnostics->markFrameEnd();
+    }, Qt::DirectConnection);
+}
+
+void UnifiedGridRenderer::setCheckpointPath(const QString& path, bool restoreBooks) {
+    if (m_dataProcessor) {
+        QMetaObject::invokeMethod(m_dataProcessor.get(), [processor = m_dataProcessor.get(), path, restoreBooks]() {
+            processor->setCheckpointPath(path, restoreBooks);
+        }, Qt::QueuedConnection);
+    }
+}
+
 IRenderStrategy* UnifiedGridRenderer::getCurrentStrategy() const {
     switch (m_renderMode) {
         case RenderMode::LiquidityHeatmap:
-        case RenderMode::OrderBookDepth:  // Similar to heatmap
             return m_heatmapStrategy.get();
             
+        case RenderMode::OrderBookDepth:
+            return m_depthStrategy.get();
+            
         case RenderMode::TradeFlow:
             return m_tradeFlowStrategy.get();
             
@@ -468,6 +657,189 @@ namespace {
         }
         return Viewport{0, 0, 0.0, 0.0, w, h};
     }
+
+    // Overlay bars should be at least this wide on screen
+    constexpr double kMinOverlayBarPx = 6.0;
+    constexpr double kMinFootprintBarPx = 24.0;
+    constexpr double kMinFootprintRowPx = 3.0;
+    // Trade density bins are at least this many pixels on each side
+    constexpr double kMinTradeDensityBinPx = 3.0;
+
+    // Smallest 1-2-5 multiple of ticks giving rows at least minRowPx tall
+    inline int niceTicksPerRow(double pxPerTick, double minRowPx) {
+        if (pxPerTick <= 0.0) return 1;
+        const double raw = minRowPx / pxPerTick;
+        if (raw <= 1.0) return 1;
+        double magnitude = std::pow(10.0, std::floor(std::log10(raw)));
+        for (double step : {1.0, 2.0, 5.0, 10.0}) {
+            if (step * magnitude >= raw) return static_cast<int>(step * magnitude);
+        }
+        return static_cast<int>(10.0 * magnitude);
+    }
+}
+
+void UnifiedGridRenderer::refreshFootprintCells(const Viewport& vp) {
+    FootprintEngine* engine = m_dataProcessor ? m_dataProcessor->getFootprintEngine() : nullptr;
+    const std::string symbol = engine ? m_dataProcessor->getActiveSymbol() : std::string();
+    const double tickSize = engine ? engine->getTickSize(symbol) : 0.0;
+    if (tickSize <= 0.0 || vp.timeEnd_ms <= vp.timeStart_ms || vp.priceMax <= vp.priceMin) {
+        m_footprintCells.reset();
+        m_footprintQuery = {};
+        return;
+    }
+
+    const int64_t span = vp.timeEnd_ms - vp.timeStart_ms;
+    const double pxPerTick = vp.height * tickSize / (vp.priceMax - vp.priceMin);
+
+    FootprintQuery query;
+    query.symbol = symbol;
+    query.version = engine->getVersion(symbol);
+    query.timeframe_ms = engine->nearestTimeframe(static_cast<int64_t>(span / std::max(1.0, vp.width / kMinFootprintBarPx)));
+    query.timeStart = vp.timeStart_ms;
+    query.timeEnd = vp.timeEnd_ms;
+    query.priceMin = vp.priceMin;
+    query.priceMax = vp.priceMax;
+    query.ticksPerRow = niceTicksPerRow(pxPerTick, kMinFootprintRowPx);
+
+    if (query == m_footprintQuery) return;  // Nothing traded and view unchanged
+    m_footprintQuery = query;
+    auto cells = std::make_shared<std::vector<FootprintCell>>();
+    m_dataProcessor->copyFootprintCells(query.symbol, query.timeframe_ms, query.timeStart, query.timeEnd,
+                                        query.priceMin, query.priceMax, query.ticksPerRow, *cells);
+    m_footprintCells = std::move(cells);
+}
+
+void UnifiedGridRenderer::refreshTradeDensityCells(const Viewport& vp) {
+    FootprintEngine* engine = m_dataProcessor ? m_dataProcessor->getTradeDensityEngine() : nullptr;
+    const std::string symbol = engine ? m_dataProcessor->getActiveSymbol() : std::string();
+    const double tickSize = engine ? engine->getTickSize(symbol) : 0.0;
+    if (tickSize <= 0.0 || engine->getTimeframes().empty() || vp.timeEnd_ms <= vp.timeStart_ms || vp.priceMax <= vp.priceMin) {
+        m_tradeDensityCells.reset();
+        m_tradeDensityQuery = {};
+        return;
+    }
+
+    const int64_t span = vp.timeEnd_ms - vp.timeStart_ms;
+    const double pxPerTick = vp.height * tickSize / (vp.priceMax - vp.priceMin);
+
+    // Finest ring that gives bins of a few pixels and still reaches back to the left edge of the view
+    const int64_t nowMs = QDateTime::currentMSecsSinceEpoch();
+    const int64_t reach = std::max<int64_t>(span, nowMs - vp.timeStart_ms);
+    int64_t timeframe = engine->nearestTimeframe(static_cast<int64_t>(span / std::max(1.0, vp.width / kMinTradeDensityBinPx)));
+    for (int64_t tf : engine->getTimeframes()) {
+        if (tf < timeframe) continue;
+        timeframe = tf;
+        if (tf * static_cast<int64_t>(engine->getBarsPerTimeframe()) >= reach) break;
+    }
+
+    FootprintQuery query;
+    query.symbol = symbol;
+    query.version = engine->getVersion(symbol);
+    query.timeframe_ms = timeframe;
+    query.timeStart = vp.timeStart_ms;
+    query.timeEnd = vp.timeEnd_ms;
+    query.priceMin = vp.priceMin;
+    query.priceMax = vp.priceMax;
+    query.ticksPerRow = niceTicksPerRow(pxPerTick, kMinTradeDensityBinPx);
+
+    if (query == m_tradeDensityQuery) return;  // Nothing traded and view unchanged
+    m_tradeDensityQuery = query;
+    auto cells = std::make_shared<std::vector<FootprintCell>>();
+    m_dataProcessor->copyTradeDensityCells(query.symbol, query.timeframe_ms, query.timeStart, query.timeEnd,
+                                           query.priceMin, query.priceMax, query.ticksPerRow, *cells);
+    m_tradeDensityCells = std::move(cells);
+}
+
+void UnifiedGridRenderer::refreshColorRamp() {
+    // Runs in updatePaintNode while the GUI thread is blocked, so ThemeManager is safe to read
+    const ThemeManager& themes = ThemeManager::instance();
+    if (m_colorRamp && themes.themeRevision() == m_themeRevision) return;
+
+    m_themeRevision = themes.themeRevision();
+    m_colorRamp = ColorRamp::fromTheme(themes.activeTheme());
+    for (IRenderStrategy* strategy : {m_heatmapStrategy.get(), m_tradeFlowStrategy.get(), m_tradeBubbleStrategy.get(),
+                                      m_candleStrategy.get(), m_orderFlowStrategy.get(), m_footprintStrategy.get(),
+                                      m_icebergStrategy.get(), m_depthStrategy.get()}) {
+        if (strategy) strategy->setColorRamp(m_colorRamp);
+    }
+    m_materialDirty.store(true);
+}
+
+qint64 UnifiedGridRenderer::updateSceneLayers(GridSceneNode* sceneNode, GridSceneNode::LayerRefresh refresh) {
+    Viewport vp = buildViewport(m_viewState.get(), static_cast<double>(width()), static_cast<double>(height()));
+    // create a new GridSliceBatch with the visible cells, intensity scale, min volume filter, max cells, and viewport
+    GridSliceBatch batch{m_visibleCells, {}, m_intensityScale, m_minVolumeFilter, m_maxCells, vp, m_cellCoverage};
+
+    if (m_showTradeBubbleLayer) {
+        std::string symbol;
+        {
+            std::lock_guard<std::mutex> lock(m_dataMutex);
+            symbol = m_chartSymbol.empty() ? m_tradeSymbol : m_chartSymbol;
+        }
+        // Hand the strategy the published block list; no prints are copied on this thread
+        batch.tradeBlocks = m_tradeHistory.snapshot(symbol);
+    }
+
+    if (m_showOrderFlowLayer && m_dataProcessor && vp.timeEnd_ms > vp.timeStart_ms) {
+        const int64_t span = vp.timeEnd_ms - vp.timeStart_ms;
+        const int64_t targetTf = static_cast<int64_t>(span / std::max(1.0, vp.width / kMinOverlayBarPx));
+        m_dataProcessor->copyOrderFlowBars(targetTf, vp.timeStart_ms, vp.timeEnd_ms, batch.orderFlowBars);
+    }
+
+    if (m_showFootprintLayer) {
+        refreshFootprintCells(vp);
+        batch.footprintCells = m_footprintCells;
+        static_cast<FootprintStrategy*>(m_footprintStrategy.get())->setWindow(window());
+    }
+    static_cast<HeatmapStrategy*>(m_heatmapStrategy.get())->setWindow(window());
+
+    if (m_showTradeFlowLayer) {
+        refreshTradeDensityCells(vp);
+        batch.tradeDensityCells = m_tradeDensityCells;
+    }
+
+    if (m_showIcebergLayer && m_dataProcessor) {
+        m_dataProcessor->copyIcebergEvents(vp.timeStart_ms, vp.timeEnd_ms, batch.icebergEvents);
+    }
+
+    QElapsedTimer contentTimer; contentTimer.start();
+    sceneNode->updateLayeredContent(batch,
+                                   m_heatmapStrategy.get(), m_showHeatmapLayer,
+                                   m_tradeBubbleStrategy.get(), m_showTradeBubbleLayer,
+                                   m_tradeFlowStrategy.get(), m_showTradeFlowLayer,
+                                   refresh);
+    sceneNode->updateOverlayLayer(GridSceneNode::OverlayLayer::Iceberg, batch,
+                                  m_icebergStrategy.get(), m_showIcebergLayer);
+    sceneNode->updateOverlayLayer(GridSceneNode::OverlayLayer::Footprint, batch,
+                                  m_footprintStrategy.get(), m_showFootprintLayer);
+    sceneNode->updateOverlayLayer(GridSceneNode::OverlayLayer::OrderFlow, batch,
+                                  m_orderFlowStrategy.get(), m_showOrderFlowLayer);
+    updateDepthLayer(sceneNode, vp);
+    return contentTimer.nsecsElapsed() / 1000;
+}
+
+void UnifiedGridRenderer::updateDepthLayer(GridSceneNode* sceneNode, const Viewport& vp) {
+    const bool show = m_renderMode == RenderMode::OrderBookDepth && m_dataProcessor;
+    GridSliceBatch batch;
+    batch.viewport = vp;
+    if (show && vp.height >= 1.0 && vp.priceMax > vp.priceMin) {
+        // One sample per pixel row, taken at the row's center price
+        const int rows = static_cast<int>(std::ceil(vp.height));
+        const double halfRow = 0.5 * (vp.priceMax - vp.priceMin) / vp.height;
+        m_dataProcessor->copyDepthCurve(vp.priceMin + halfRow, vp.priceMax - halfRow, rows, batch.depthCurve);
+    }
+    sceneNode->updateOverlayLayer(GridSceneNode::OverlayLayer::Depth, batch, m_depthStrategy.get(), show);
+}
+
+void UnifiedGridRenderer::updateLiveColumn(GridSceneNode* sceneNode) {
+    std::shared_ptr<const LiveColumn> column;
+    if (m_showHeatmapLayer && m_dataProcessor) {
+        column = m_dataProcessor->getPublishedLiveColumn();
+    }
+    Viewport vp = buildViewport(m_viewState.get(), static_cast<double>(width()), static_cast<double>(height()));
+    auto* heatmap = static_cast<HeatmapStrategy*>(m_heatmapStrategy.get());
+    heatmap->setWindow(window());
+    heatmap->updateLiveLayer(sceneNode->liveHeatmapLayer(), std::move(column), vp, m_intensityScale, m_minVolumeFilter);
 }
 
 QSGNode* UnifiedGridRenderer::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* data) {
@@ -478,6 +850,9 @@ QSGNode* UnifiedGridRenderer::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeD
 
     QElapsedTimer timer;
     timer.start();
+    if (m_diagnostics) m_diagnostics->startFrame();
+    m_lastPaintMs.store(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count(), std::memory_order_relaxed);
 
     auto* sceneNode = static_cast<GridSceneNode*>(oldNode); // cast the old node to a GridSceneNode
     bool isNewNode = !sceneNode; // check if the node is new
@@ -488,6 +863,9 @@ QSGNode* UnifiedGridRenderer::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeD
     qint64 cacheUs = 0; // cache time in microseconds
     qint64 contentUs = 0; // content time in microseconds
     size_t cellsCount = 0; // number of cells
+    bool layersRebuilt = false;
+
+    refreshColorRamp();
     
     // TODO: REMOVE COMMENTS AFTER IMPLEMENTING THE 4 DIRTY FLAGS SYSTEM
     //  FOUR DIRTY FLAGS SYSTEM - No mutex needed, atomic exchange
@@ -499,16 +877,8 @@ QSGNode* UnifiedGridRenderer::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeD
         updateVisibleCells();
         cacheUs = cacheTimer.nsecsElapsed() / 1000;
 
-        Viewport vp = buildViewport(m_viewState.get(), static_cast<double>(width()), static_cast<double>(height()));
-        // create a new GridSliceBatch with the visible cells, recent trades, intensity scale, min volume filter, max cells, and viewport
-        GridSliceBatch batch{m_visibleCells, m_recentTrades, m_intensityScale, m_minVolumeFilter, m_maxCells, vp};
-
-        QElapsedTimer contentTimer; contentTimer.start();
-        sceneNode->updateLayeredContent(batch,
-                                       m_heatmapStrategy.get(), m_showHeatmapLayer,
-                                       m_tradeBubbleStrategy.get(), m_showTradeBubbleLayer,
-                                       m_tradeFlowStrategy.get(), m_showTradeFlowLayer);
-        contentUs = contentTimer.nsecsElapsed() / 1000;
+        contentUs = updateSceneLayers(sceneNode);
+        layersRebuilt = true;
 
         if (m_showVolumeProfile) {
             updateVolumeProfile();
@@ -523,27 +893,33 @@ QSGNode* UnifiedGridRenderer::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeD
         updateVisibleCells();
         cacheUs = cacheTimer.nsecsElapsed() / 1000;
 
-        Viewport vp2 = buildViewport(m_viewState.get(), static_cast<double>(width()), static_cast<double>(height()));
-        GridSliceBatch batch2{m_visibleCells, m_recentTrades, m_intensityScale, m_minVolumeFilter, m_maxCells, vp2};
-
-        QElapsedTimer contentTimer2; contentTimer2.start();
-        sceneNode->updateLayeredContent(batch2,
-                                       m_heatmapStrategy.get(), m_showHeatmapLayer,
-                                       m_tradeBubbleStrategy.get(), m_showTradeBubbleLayer,
-                                       m_tradeFlowStrategy.get(), m_showTradeFlowLayer);
-        contentUs = contentTimer2.nsecsElapsed() / 1000;
+        contentUs = updateSceneLayers(sceneNode);
+        layersRebuilt = true;
         cellsCount = m_visibleCells.size();
     }
 
-    if (m_materialDirty.exchange(false)) {
+    const bool materialDirty = m_materialDirty.exchange(false);
+    const bool viewportDirty = m_viewportDirty.exchange(false);
+    if (materialDirty && !layersRebuilt) {
         sLog_RenderN(10, "MATERIAL UPDATE (intensity/palette)");
-        updateVisibleCells();
-        Viewport vp3 = buildViewport(m_viewState.get(), static_cast<double>(width()), static_cast<double>(height()));
-        GridSliceBatch batch3{m_visibleCells, m_recentTrades, m_intensityScale, m_minVolumeFilter, m_maxCells, vp3};
-        sceneNode->updateLayeredContent(batch3,
-                                       m_heatmapStrategy.get(), m_showHeatmapLayer,
-                                       m_tradeBubbleStrategy.get(), m_showTradeBubbleLayer,
-                                       m_tradeFlowStrategy.get(), m_showTradeFlowLayer);
+        // Heatmap recolors through its material uniform/texture; vertex-colored layers still rebuild
+        auto* heatmap = static_cast<HeatmapStrategy*>(m_heatmapStrategy.get());
+        heatmap->setWindow(window());
+        heatmap->applyMaterialState(sceneNode->heatmapLayer(), m_intensityScale);
+        contentUs = updateSceneLayers(sceneNode, GridSceneNode::LayerRefresh::Material);
+    } else if (viewportDirty && !layersRebuilt) {
+        sLog_RenderN(10, "VIEWPORT UPDATE (world-space layers re-mapped)");
+        contentUs = updateSceneLayers(sceneNode, GridSceneNode::LayerRefresh::Viewport);
+    }
+
+    // Cheap when nothing changed: same-layout revisions only rewrite the changed slots' vertex values
+    const bool liveDirty = m_liveDirty.exchange(false);
+    if (liveDirty || layersRebuilt || materialDirty || viewportDirty) {
+        updateLiveColumn(sceneNode);
+    }
+    // The depth pane tracks the live book; the layer rebuilds above already refreshed it
+    if (liveDirty && !layersRebuilt && !materialDirty && !viewportDirty && m_renderMode == RenderMode::OrderBookDepth) {
+        updateDepthLayer(sceneNode, buildViewport(m_viewState.get(), static_cast<double>(width()), static_cast<double>(height())));
     }
 
     if (m_transformDirty.exchange(false) || isNewNode) {
@@ -561,6 +937,7 @@ QSGNode* UnifiedGridRenderer::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeD
                        << "cache=" << cacheUs << "microseconds"
                        << "content=" << contentUs << "microseconds"
                        << "cells=" << cellsCount);
+    if (m_diagnostics) m_diagnostics->endFrame();
 
     // DIAGNOSTIC: Check if we have cells but they're not distributed properly
     if (cellsCount > 0 && cellsCount % 100 == 0) {
@@ -584,7 +961,12 @@ QSGNode* UnifiedGridRenderer::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeD
 void UnifiedGridRenderer::addTrade(const Trade& trade) { onTradeReceived(trade); }
 void UnifiedGridRenderer::setViewport(qint64 timeStart, qint64 timeEnd, double priceMin, double priceMax) { onViewChanged(timeStart, timeEnd, priceMin, priceMax); }
 void UnifiedGridRenderer::setGridResolution(int timeResMs, double priceRes) { setPriceResolution(priceRes); }
-void UnifiedGridRenderer::togglePerformanceOverlay() { /* No-op: SentinelMonitor removed */ }
+void UnifiedGridRenderer::togglePerformanceOverlay() {
+    if (!m_diagnostics) return;
+    m_diagnostics->toggleOverlay();
+    emit performanceOverlayChanged();
+}
+bool UnifiedGridRenderer::performanceOverlayVisible() const { return m_diagnostics && m_diagnostics->isOverlayEnabled(); }
 
 // ===== QML PROPERTY GETTERS =====
 // Read-only property access for QML bindings
@@ -602,10 +984,13 @@ QPointF UnifiedGridRenderer::getPanVisualOffset() const { return m_viewState ? m
 // Debug and monitoring methods for QML
 QString UnifiedGridRenderer::getGridDebugInfo() const { return QString("Cells:%1 Size:%2x%3").arg(m_visibleCells.size()).arg(width()).arg(height()); }
 QString UnifiedGridRenderer::getDetailedGridDebug() const { return getGridDebugInfo() + QString("DataProcessor:%1").arg(m_dataProcessor ? "YES" : "NO"); }
-QString UnifiedGridRenderer::getPerformanceStats() const { return "N/A (SentinelMonitor removed)"; }
-double UnifiedGridRenderer::getCurrentFPS() const { return 0.0; }
-double UnifiedGridRenderer::getAverageRenderTime() const { return 0.0; }
-double UnifiedGridRenderer::getCacheHitRate() const { return 0.0; }
+QString UnifiedGridRenderer::getPerformanceStats() const {
+    if (!m_diagnostics) return m_presentationPolicy.describe();
+    return QString("%1 | %2").arg(m_diagnostics->getPerformanceStats(), m_presentationPolicy.describe());
+}
+double UnifiedGridRenderer::getCurrentFPS() const { return m_diagnostics ? m_diagnostics->getCurrentFPS() : 0.0; }
+double UnifiedGridRenderer::getAverageRenderTime() const { return m_diagnostics ? m_diagnostics->getAverageRenderTime() : 0.0; }
+double UnifiedGridRenderer::getCacheHitRate() const { return m_diagnostics ? m_diagnostics->getCacheHitRate() : 0.0; }
 
 // ===== QT EVENT HANDLERS =====
 // Mouse and wheel event handling for user interaction
@@ -633,8 +1018,8 @@ void UnifiedGridRenderer::mouseReleaseEvent(QMouseEvent* event) {
         if (m_dataProcessor) {
             QMetaObject::invokeMethod(m_dataProcessor.get(), "updateVisibleCells", Qt::QueuedConnection);
         }
-        // Keep visual pan until resync arrives to avoid snap-back
-        m_panSyncPending = true;
+        // The committed viewport re-maps world-space layers this frame, so drop the drag offset now
+        m_viewState->clearPanVisualOffset();
         m_transformDirty.store(true);
         update();
     }
@@ -643,6 +1028,6 @@ void UnifiedGridRenderer::mouseReleaseEvent(QMouseEvent* event) {
 void UnifiedGridRenderer::wheelEvent(QWheelEvent* event) { 
     if (m_viewState && isVisible() && m_viewState->isTimeWindowValid()) { 
         m_viewState->handleZoomWithSensitivity(event->angleDelta().y(), event->position(), QSizeF(width(), height())); 
-        m_transformDirty.store(true); m_appendPending.store(true); update(); event->accept(); 
+        m_transformDirty.store(true); update(); event->accept(); 
     } else event->ignore(); 
 }
@@ -19,6 +19,7 @@ Assumptions: CoordinateSystem and ChartModeController properties are set from QM
 #include <QMouseEvent>
 #include <QWheelEvent>
 #include <QElapsedTimer>
+#include <QPointer>
 #include <vector>
 #include <memory>
 #include <atomic>
@@ -26,11 +27,15 @@ Assumptions: CoordinateSystem and ChartModeController properties are set from QM
 #include "../core/marketdata/model/TradeData.h"
 #include "render/GridTypes.hpp"
 #include "render/GridViewState.hpp"
+#include "render/PresentationPolicy.hpp"
+#include "render/GridSceneNode.hpp"
 
 // Forward declarations for new modular architecture
-class GridSceneNode;
 class DataProcessor;
 class IRenderStrategy;
+class RenderDiagnostics;
+class ColorRamp;
+class QQuickWindow;
 
 /**
  *  UNIFIED GRID RENDERER - SLIM QML ADAPTER
@@ -50,6 +55,8 @@ class UnifiedGridRenderer : public QQuickItem {
     
     Q_PROPERTY(double minVolumeFilter READ minVolumeFilter WRITE setMinVolumeFilter NOTIFY minVolumeFilterChanged)
     Q_PROPERTY(double currentPriceResolution READ getCurrentPriceResolution NOTIFY priceResolutionChanged)
+    // LiquidityTimeSeriesEngine::LiquidityDisplayMode (0 = Average … 4 = Pulled)
+    Q_PROPERTY(int liquidityDisplayMode READ liquidityDisplayMode WRITE setLiquidityDisplayMode NOTIFY liquidityDisplayModeChanged)
     
     // Trade Bubble Properties
     Q_PROPERTY(double minBubbleRadius READ minBubbleRadius WRITE setMinBubbleRadius NOTIFY minBubbleRadiusChanged)
@@ -60,6 +67,11 @@ class UnifiedGridRenderer : public QQuickItem {
     Q_PROPERTY(bool showHeatmapLayer READ showHeatmapLayer WRITE setShowHeatmapLayer NOTIFY showHeatmapLayerChanged)
     Q_PROPERTY(bool showTradeBubbleLayer READ showTradeBubbleLayer WRITE setShowTradeBubbleLayer NOTIFY showTradeBubbleLayerChanged)
     Q_PROPERTY(bool showTradeFlowLayer READ showTradeFlowLayer WRITE setShowTradeFlowLayer NOTIFY showTradeFlowLayerChanged)
+    Q_PROPERTY(bool showOrderFlowLayer READ showOrderFlowLayer WRITE setShowOrderFlowLayer NOTIFY showOrderFlowLayerChanged)
+    Q_PROPERTY(bool showFootprintLayer READ showFootprintLayer WRITE setShowFootprintLayer NOTIFY showFootprintLayerChanged)
+    Q_PROPERTY(bool showIcebergLayer READ showIcebergLayer WRITE setShowIcebergLayer NOTIFY showIcebergLayerChanged)
+    // Heatmap from the symbol's own book (false) or every venue's book merged by price (true)
+    Q_PROPERTY(bool consolidatedBook READ consolidatedBook WRITE setConsolidatedBook NOTIFY consolidatedBookChanged)
     
     Q_PROPERTY(qint64 visibleTimeStart READ getVisibleTimeStart NOTIFY viewportChanged)
     Q_PROPERTY(qint64 visibleTimeEnd READ getVisibleTimeEnd NOTIFY viewportChanged)
@@ -69,6 +81,7 @@ class UnifiedGridRenderer : public QQuickItem {
     Q_PROPERTY(int timeframeMs READ getCurrentTimeframe WRITE setTimeframe NOTIFY timeframeChanged)
     
     Q_PROPERTY(QPointF panVisualOffset READ getPanVisualOffset NOTIFY panVisualOffsetChanged)
+    Q_PROPERTY(bool performanceOverlayVisible READ performanceOverlayVisible NOTIFY performanceOverlayChanged)
 
 public:
     enum class RenderMode {
@@ -76,7 +89,7 @@ public:
         TradeFlow,           // Trade dots with density
         TradeBubbles,        // Size-relative bubbles on heatmap
         VolumeCandles,       // Volume-weighted candles
-        OrderBookDepth       // Depth chart style
+        OrderBookDepth       // Heatmap plus a live cumulative depth pane
     };
     Q_ENUM(RenderMode)
 
@@ -98,9 +111,11 @@ private:
     bool m_showHeatmapLayer = true;      // Base heatmap layer
     bool m_showTradeBubbleLayer = true;  // Trade bubble overlay
     bool m_showTradeFlowLayer = false;   // Trade flow overlay
-    
-    bool m_manualTimeframeSet = false;  // Disable auto-suggestion when user manually sets timeframe
-    QElapsedTimer m_manualTimeframeTimer;  // Reset auto-suggestion after delay
+    bool m_showOrderFlowLayer = false;   // CVD / delta / imbalance pane
+    bool m_showFootprintLayer = false;   // Bid x ask volume per bar/price row
+    bool m_showIcebergLayer = false;     // Suspected iceberg / refilling levels
+    int m_liquidityDisplayMode = 0;      // Heatmap value source (LiquidityDisplayMode)
+    bool m_consolidatedBook = false;     // Heatmap book source (see DataProcessor::setConsolidatedBook)
     
     // Thread safety
     mutable std::mutex m_dataMutex;
@@ -111,17 +126,21 @@ private:
     std::atomic<bool> m_appendPending{false};    // New data arrived (COMMON - append cells)
     std::atomic<bool> m_transformDirty{false};   // Pan/zoom/follow (VERY COMMON - transform only)
     std::atomic<bool> m_materialDirty{false};    // Visual params changed (OCCASIONAL - uniforms/material)
+    std::atomic<bool> m_viewportDirty{false};    // Committed viewport changed (COMMON - re-map world-space layers)
+    std::atomic<bool> m_liveDirty{false};        // Live column revised (VERY COMMON - patch values in place)
         
     // Rendering data
     std::vector<CellInstance> m_visibleCells;
+    Viewport m_cellCoverage;  // World region m_visibleCells were generated for
     // Snapshot buffer swapped from DataProcessor on dataUpdated()/updatePaintNode
     std::shared_ptr<const std::vector<CellInstance>> m_publishedCells;
-    std::vector<Trade> m_recentTrades;  // Recent trades for bubble rendering
+    TradeHistoryStore m_tradeHistory;   // Session prints per symbol (written on the GUI thread, read lock-free on render)
+    std::string m_chartSymbol;          // Empty = accept every symbol (guarded by m_dataMutex)
+    std::string m_tradeSymbol;          // Symbol of the latest accepted trade (guarded by m_dataMutex)
     std::vector<std::pair<double, double>> m_volumeProfile;
     
     QSGTransformNode* m_rootTransformNode = nullptr;
     bool m_needsDataRefresh = false;
-    bool m_panSyncPending = false;  // hold visual pan until DP resync snapshot applied to avoid snap-back -- TODO: See if this is needed
     
     // V1 state (removed - now delegated to DataProcessor)
 
@@ -136,6 +155,7 @@ public:
     int maxCells() const { return m_maxCells; }
     int64_t currentTimeframe() const { return m_currentTimeframe_ms; }
     double minVolumeFilter() const { return m_minVolumeFilter; }
+    int liquidityDisplayMode() const { return m_liquidityDisplayMode; }
     bool autoScrollEnabled() const { return m_viewState ? m_viewState->isAutoScrollEnabled() : false; }
     
     // Trade Bubble accessors
@@ -147,6 +167,10 @@ public:
     bool showHeatmapLayer() const { return m_showHeatmapLayer; }
     bool showTradeBubbleLayer() const { return m_showTradeBubbleLayer; }
     bool showTradeFlowLayer() const { return m_showTradeFlowLayer; }
+    bool showOrderFlowLayer() const { return m_showOrderFlowLayer; }
+    bool showFootprintLayer() const { return m_showFootprintLayer; }
+    bool showIcebergLayer() const { return m_showIcebergLayer; }
+    bool consolidatedBook() const { return m_consolidatedBook; }
     
     //  VIEWPORT BOUNDS: Getters for QML properties
     qint64 getVisibleTimeStart() const;
@@ -184,6 +208,7 @@ public:
     
     //  PERFORMANCE MONITORING API
     Q_INVOKABLE void togglePerformanceOverlay();
+    bool performanceOverlayVisible() const;
     Q_INVOKABLE QString getPerformanceStats() const;
     Q_INVOKABLE double getCurrentFPS() const;
     Q_INVOKABLE double getAverageRenderTime() const;
@@ -194,6 +219,16 @@ public:
     Q_INVOKABLE void setTimeframe(int timeframe_ms);
     
     void setDataCache(class DataCache* cache); // Forward declaration - implemented in .cpp
+    // Restricts trades and books to one symbol when several are streamed (empty = accept all)
+    void setChartSymbol(const QString& symbol);
+    // Cross-venue books for the consolidated heatmap source; call before the feeds start
+    void setFeedAggregator(const class FeedAggregator* feeds);
+    // Session checkpoint file for warm restart (empty = disabled); call after setDataCache()
+    void setCheckpointPath(const QString& path, bool restoreBooks = false);
+    // Trade history kept for the bubble layer, per symbol, by age and memory
+    void setTradeHistoryRetention(qint64 maxAge_ms, qint64 maxBytesPerSymbol);
+    // Adaptive mode coalesces data-driven repaints to the policy's frame cap
+    void setPresentationPolicy(const PresentationPolicy& policy);
     
     //  PAN/ZOOM CONTROLS
     Q_INVOKABLE void zoomIn();
@@ -234,9 +269,15 @@ signals:
     void showHeatmapLayerChanged();
     void showTradeBubbleLayerChanged();
     void showTradeFlowLayerChanged();
+    void showOrderFlowLayerChanged();
+    void showFootprintLayerChanged();
+    void showIcebergLayerChanged();
+    void consolidatedBookChanged();
+    void liquidityDisplayModeChanged();
     void viewportChanged();
     void timeframeChanged();
     void panVisualOffsetChanged();
+    void performanceOverlayChanged();
 
 protected:
     QSGNode* updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData* data) override;
@@ -262,8 +303,22 @@ private:
     void setShowHeatmapLayer(bool show);
     void setShowTradeBubbleLayer(bool show);
     void setShowTradeFlowLayer(bool show);
+    void setShowOrderFlowLayer(bool show);
+    void setShowFootprintLayer(bool show);
+    void setShowIcebergLayer(bool show);
+    void setConsolidatedBook(bool enabled);
+    void setLiquidityDisplayMode(int mode);
     void updateVisibleCells();
+    qint64 updateSceneLayers(GridSceneNode* sceneNode,
+                             GridSceneNode::LayerRefresh refresh = GridSceneNode::LayerRefresh::Rebuild);
+    void refreshColorRamp();
+    void updateLiveColumn(GridSceneNode* sceneNode);
+    void updateDepthLayer(GridSceneNode* sceneNode, const Viewport& vp);
+    void refreshFootprintCells(const Viewport& vp);
+    void refreshTradeDensityCells(const Viewport& vp);
     void updateVolumeProfile();
+    void scheduleDataRepaint();
+    void trackWindow(QQuickWindow* window);
     
     class DataCache* m_dataCache = nullptr;
 
@@ -274,6 +329,41 @@ private:
     std::unique_ptr<IRenderStrategy> m_tradeFlowStrategy;  
     std::unique_ptr<IRenderStrategy> m_tradeBubbleStrategy;
     std::unique_ptr<IRenderStrategy> m_candleStrategy;
+    std::unique_ptr<IRenderStrategy> m_orderFlowStrategy;
+    std::unique_ptr<IRenderStrategy> m_footprintStrategy;
+    std::unique_ptr<IRenderStrategy> m_icebergStrategy;
+    std::unique_ptr<IRenderStrategy> m_depthStrategy;
+    
+    // Frame pacing and render-loop timing
+    PresentationPolicy m_presentationPolicy;
+    QTimer m_frameCapTimer;                       // Deferred repaint when Adaptive coalesces data updates
+    std::atomic<qint64> m_lastPaintMs{0};         // Written on the render thread, read on GUI
+    std::unique_ptr<RenderDiagnostics> m_diagnostics;
+    QPointer<QQuickWindow> m_trackedWindow;
+    
+    // Theme palettes shared by all strategies; rebuilt when ThemeManager's revision changes
+    std::shared_ptr<const ColorRamp> m_colorRamp;
+    quint64 m_themeRevision = 0;
+    
+    // Footprint rows are re-copied only when the symbol's bars or the query change (render thread only);
+    // frames hand the published rows to the batch by pointer
+    struct FootprintQuery {
+        std::string symbol;
+        uint64_t version = 0;
+        int64_t timeframe_ms = 0;
+        int64_t timeStart = 0;
+        int64_t timeEnd = 0;
+        double priceMin = 0.0;
+        double priceMax = 0.0;
+        int ticksPerRow = 0;
+        bool operator==(const FootprintQuery&) const = default;
+    };
+    FootprintQuery m_footprintQuery;
+    std::shared_ptr<const std::vector<FootprintCell>> m_footprintCells;
+    // Same re-copy gating for the TradeFlow density bins
+    FootprintQuery m_tradeDensityQuery;
+    std::shared_ptr<const std::vector<FootprintCell>> m_tradeDensityCells;
+    
 
     IRenderStrategy* getCurrentStrategy() const;
     
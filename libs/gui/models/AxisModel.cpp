@@ -76,10 +76,120 @@ QHash<int, QByteArray> AxisModel::roleNames() const {
 void AxisModel::onViewportChanged() {
     if (!m_viewState || !isViewportValid()) return;
     
-    // Recalculate ticks
-    beginResetModel();
+    refreshTicks();
+}
+
+void AxisModel::refreshTicks() {
+    if (!isViewportValid()) return;
+    
+    m_pendingStep = 0.0;
+    m_pendingFormatKey = 0;
     calculateTicks();
-    endResetModel();
+    publishTicks(std::move(m_pendingTicks));
+    m_pendingTicks.clear();
+}
+
+void AxisModel::setTickStep(double step, int formatKey) {
+    m_pendingStep = step;
+    m_pendingFormatKey = formatKey;
+    if (step != m_tickStep || formatKey != m_tickFormatKey) {
+        // Labels depend on step/format - stale entries would be wrong
+        m_labelCache.clear();
+    }
+}
+
+qint64 AxisModel::tickIndex(double value) const {
+    // Ticks lie on a regular grid; compare by grid index so accumulated
+    // floating-point drift in value doesn't break the diff.
+    return static_cast<qint64>(std::llround(value / m_tickStep));
+}
+
+void AxisModel::publishTicks(std::vector<TickInfo>&& next) {
+    const bool sameGrid = m_pendingStep > 0.0 &&
+                          m_pendingStep == m_tickStep &&
+                          m_pendingFormatKey == m_tickFormatKey;
+    
+    if (!sameGrid || m_ticks.empty() || next.empty()) {
+        beginResetModel();
+        m_ticks = std::move(next);
+        m_tickStep = m_pendingStep;
+        m_tickFormatKey = m_pendingFormatKey;
+        endResetModel();
+        return;
+    }
+    
+    const qint64 nextFirst = tickIndex(next.front().value);
+    const qint64 nextLast = tickIndex(next.back().value);
+    
+    // Drop rows that scrolled off the back
+    int keepEnd = static_cast<int>(m_ticks.size());
+    while (keepEnd > 0 && tickIndex(m_ticks[keepEnd - 1].value) > nextLast) --keepEnd;
+    if (keepEnd < static_cast<int>(m_ticks.size())) {
+        beginRemoveRows(QModelIndex(), keepEnd, static_cast<int>(m_ticks.size()) - 1);
+        m_ticks.erase(m_ticks.begin() + keepEnd, m_ticks.end());
+        endRemoveRows();
+    }
+    
+    // Drop rows that scrolled off the front
+    int keepBegin = 0;
+    while (keepBegin < static_cast<int>(m_ticks.size()) && tickIndex(m_ticks[keepBegin].value) < nextFirst) ++keepBegin;
+    if (keepBegin > 0) {
+        beginRemoveRows(QModelIndex(), 0, keepBegin - 1);
+        m_ticks.erase(m_ticks.begin(), m_ticks.begin() + keepBegin);
+        endRemoveRows();
+    }
+    
+    if (m_ticks.empty()) {
+        // No overlap left (large jump) - plain reset is cheaper than two passes
+        beginResetModel();
+        m_ticks = std::move(next);
+        endResetModel();
+        return;
+    }
+    
+    const qint64 keptFirst = tickIndex(m_ticks.front().value);
+    const qint64 keptLast = tickIndex(m_ticks.back().value);
+    
+    auto firstKept = std::find_if(next.begin(), next.end(),
+        [&](const TickInfo& t) { return tickIndex(t.value) >= keptFirst; });
+    auto pastKept = std::find_if(firstKept, next.end(),
+        [&](const TickInfo& t) { return tickIndex(t.value) > keptLast; });
+    
+    // Existing rows keep their label; only the position moves
+    const int overlap = static_cast<int>(std::distance(firstKept, pastKept));
+    if (overlap == static_cast<int>(m_ticks.size())) {
+        for (int i = 0; i < overlap; ++i) {
+            m_ticks[i].position = (firstKept + i)->position;
+        }
+        emit dataChanged(index(0), index(overlap - 1), {PositionRole});
+    } else {
+        // Grid holes (ticks culled at the edges) - fall back to a reset
+        beginResetModel();
+        m_ticks = std::move(next);
+        endResetModel();
+        return;
+    }
+    
+    // Ticks that scrolled on at the front
+    const int frontCount = static_cast<int>(std::distance(next.begin(), firstKept));
+    if (frontCount > 0) {
+        beginInsertRows(QModelIndex(), 0, frontCount - 1);
+        m_ticks.insert(m_ticks.begin(),
+                       std::make_move_iterator(next.begin()),
+                       std::make_move_iterator(firstKept));
+        endInsertRows();
+    }
+    
+    // Ticks that scrolled on at the back
+    const int backCount = static_cast<int>(std::distance(pastKept, next.end()));
+    if (backCount > 0) {
+        const int first = static_cast<int>(m_ticks.size());
+        beginInsertRows(QModelIndex(), first, first + backCount - 1);
+        m_ticks.insert(m_ticks.end(),
+                       std::make_move_iterator(pastKept),
+                       std::make_move_iterator(next.end()));
+        endInsertRows();
+    }
 }
 
 double AxisModel::calculateNiceStep(double range, int targetTicks) const {
@@ -128,11 +238,11 @@ bool AxisModel::isViewportValid() const {
 }
 
 void AxisModel::clearTicks() {
-    m_ticks.clear();
+    m_pendingTicks.clear();
 }
 
 void AxisModel::addTick(double value, double position, const QString& label, bool isMajorTick) {
-    m_ticks.emplace_back(value, position, label, isMajorTick);
+    m_pendingTicks.emplace_back(value, position, label, isMajorTick);
 }
 
 double AxisModel::valueToScreenPosition(double value) const {
@@ -2,6 +2,7 @@
 #include <QAbstractListModel>
 #include <QObject>
 #include <QPointF>
+#include <QHash>
 #include <vector>
 
 class GridViewState;
@@ -15,6 +16,11 @@ class GridViewState;
  * 
  * The model automatically updates when the viewport changes by connecting to
  * GridViewState::viewportChanged() signal.
+ *
+ * Updates are incremental: while the tick step (and label format) is unchanged,
+ * a pan only removes ticks that scrolled off, inserts ticks that scrolled on and
+ * emits dataChanged(PositionRole) for the rest. A full model reset happens only
+ * when the step or format changes. Labels are cached by tick value.
  */
 class AxisModel : public QAbstractListModel {
     Q_OBJECT
@@ -69,12 +75,42 @@ protected:
     void addTick(double value, double position, const QString& label, bool isMajorTick = true);
     virtual double valueToScreenPosition(double value) const;
     
+    // Incremental update: subclasses call setTickStep() from calculateTicks();
+    // refreshTicks() diffs the new tick set against the published one.
+    void setTickStep(double step, int formatKey = 0);
+    void refreshTicks();
+    
+    // Label cache keyed by tick value (cleared whenever step/format changes)
+    template<typename FormatFn>
+    QString cachedLabel(qint64 key, FormatFn&& format) {
+        auto it = m_labelCache.constFind(key);
+        if (it != m_labelCache.constEnd()) return it.value();
+        if (m_labelCache.size() >= kMaxCachedLabels) m_labelCache.clear();
+        QString label = format();
+        m_labelCache.insert(key, label);
+        return label;
+    }
+    
 private slots:
     void onViewportChanged();
 
+private:
+    void publishTicks(std::vector<TickInfo>&& next);
+    qint64 tickIndex(double value) const;
+    
+    static constexpr int kMaxCachedLabels = 512;
+
 protected:
     GridViewState* m_viewState = nullptr;
-    std::vector<TickInfo> m_ticks;
+    std::vector<TickInfo> m_ticks;        // Published rows (what QML sees)
+    std::vector<TickInfo> m_pendingTicks; // Filled by calculateTicks()
+    QHash<qint64, QString> m_labelCache;
+    
+    // Step/format of the published vs. pending tick set
+    double m_tickStep = 0.0;
+    int m_tickFormatKey = 0;
+    double m_pendingStep = 0.0;
+    int m_pendingFormatKey = 0;
     
     // Viewport dimensions
     double m_viewportWidth = 800.0;
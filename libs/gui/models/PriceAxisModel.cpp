@@ -1,6 +1,6 @@
 #include "PriceAxisModel.hpp"
 #include "../render/GridViewState.hpp"
-#include <QDebug>
+#include "SentinelLogging.hpp"
 #include <cmath>
 
 PriceAxisModel::PriceAxisModel(QObject* parent)
@@ -8,11 +8,7 @@ PriceAxisModel::PriceAxisModel(QObject* parent)
 }
 
 void PriceAxisModel::recalculateTicks() {
-    if (isViewportValid()) {
-        beginResetModel();
-        calculateTicks();
-        endResetModel();
-    }
+    refreshTicks();
 }
 
 void PriceAxisModel::calculateTicks() {
@@ -40,6 +36,7 @@ void PriceAxisModel::calculateTicks() {
         }
     }
     if (step <= 0) return;
+    setTickStep(step, getDecimalPlaces(priceRange));
     
     // Find first tick at or below priceMin
     double firstTick = std::floor(priceMin / step) * step;
@@ -52,32 +49,35 @@ void PriceAxisModel::calculateTicks() {
         
         // Check if tick is within visible area
         if (screenY >= 0 && screenY <= getViewportHeight()) {
-            QString label = formatLabel(price);
+            // Key by cents so float drift in the loop still hits the cache
+            const qint64 key = static_cast<qint64>(std::llround(price * 100.0));
+            QString label = cachedLabel(key, [&] { return formatLabel(price); });
             bool isMajor = true; // All price ticks are major for now
             
             addTick(price, screenY, label, isMajor);
         }
     }
     
-    qDebug() << "PriceAxisModel: Generated" << m_ticks.size() 
-             << "price ticks for range $" << priceMin << "-$" << priceMax 
-             << "step=$" << step;
+    sLog_DebugN(100, "PriceAxisModel: Generated" << m_pendingTicks.size()
+                << "price ticks for range $" << priceMin << "-$" << priceMax
+                << "step=$" << step);
 }
 
 QString PriceAxisModel::formatLabel(double value) const {
     // Determine appropriate decimal places based on the price range
-    double priceRange = getViewportEnd() - getViewportStart();
+    int decimals = getDecimalPlaces(getViewportEnd() - getViewportStart());
     
-    if (priceRange > 1000) {
+    if (decimals == 0) {
         // Large prices - no decimals
         return QString("$%1").arg(static_cast<int>(std::round(value)));
-    } else if (priceRange > 100) {
-        // Medium prices - 1 decimal
-        return QString("$%1").arg(value, 0, 'f', 1);
-    } else {
-        // Small prices - 2 decimals
-        return QString("$%1").arg(value, 0, 'f', 2);
     }
+    return QString("$%1").arg(value, 0, 'f', decimals);
+}
+
+int PriceAxisModel::getDecimalPlaces(double priceRange) const {
+    if (priceRange > 1000) return 0;  // Large ranges - whole dollars
+    if (priceRange > 100) return 1;   // Medium ranges - dimes
+    return 2;                         // Small ranges - cents
 }
 
 double PriceAxisModel::getViewportStart() const {
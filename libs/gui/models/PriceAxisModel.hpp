@@ -26,5 +26,5 @@ protected:
     
 private:
     double calculateNicePriceStep(double range, int targetTicks) const;
-    int getDecimalPlaces(double step) const;
+    int getDecimalPlaces(double priceRange) const;
 };
\ No newline at end of file
@@ -1,6 +1,6 @@
 #include "TimeAxisModel.hpp"
 #include "../render/GridViewState.hpp"
-#include <QDebug>
+#include "SentinelLogging.hpp"
 #include <cmath>
 #include <algorithm>
 
@@ -34,11 +34,7 @@ TimeAxisModel::TimeAxisModel(QObject* parent)
 }
 
 void TimeAxisModel::recalculateTicks() {
-    if (isViewportValid()) {
-        beginResetModel();
-        calculateTicks();
-        endResetModel();
-    }
+    refreshTicks();
 }
 
 void TimeAxisModel::calculateTicks() {
@@ -58,6 +54,7 @@ void TimeAxisModel::calculateTicks() {
     
     qint64 step = calculateNiceTimeStep(timeRange, targetTicks);
     if (step <= 0) return;
+    setTickStep(static_cast<double>(step));
     
     // Find first tick at or before timeStart
     qint64 firstTick = (timeStart / step) * step;
@@ -70,15 +67,15 @@ void TimeAxisModel::calculateTicks() {
         
         // Check if tick is within visible area
         if (screenX >= 0 && screenX <= getViewportWidth()) {
-            QString label = formatTimeLabel(timestamp, step);
+            QString label = cachedLabel(timestamp, [&] { return formatTimeLabel(timestamp, step); });
             bool isMajor = true; // All time ticks are major for now
             
             addTick(static_cast<double>(timestamp), screenX, label, isMajor);
         }
     }
     
-    qDebug() << "TimeAxisModel: Generated" << m_ticks.size() 
-             << "time ticks for range" << timeRange << "ms, step=" << step << "ms";
+    sLog_DebugN(100, "TimeAxisModel: Generated" << m_pendingTicks.size()
+                << "time ticks for range" << timeRange << "ms, step=" << step << "ms");
 }
 
 QString TimeAxisModel::formatLabel(double value) const {
@@ -30,6 +30,9 @@ Rectangle {
     // 🔬 VISUAL DEBUG: Grid line toggle (Ctrl+G to toggle)
     property bool showTimeGrid: true
     
+    // Multi-symbol grid: small heatmaps for several books over the main chart
+    property bool multiSymbolMode: false
+    
     //  SIGNAL CONNECTIONS: Update axes when viewport or timeframe changes
     Connections {
         target: unifiedGridRenderer
@@ -71,6 +74,54 @@ Rectangle {
         }
     }
     
+    // Multi-symbol heatmap grid (one shared tile processor + one atlas texture for all tiles)
+    Rectangle {
+        anchors.fill: unifiedGridRenderer
+        color: "black"
+        visible: root.multiSymbolMode
+        z: 4
+        
+        // Keep pan/zoom from reaching the chart hidden underneath
+        MouseArea {
+            anchors.fill: parent
+            acceptedButtons: Qt.AllButtons
+            onWheel: function(wheel) { wheel.accepted = true }
+        }
+        
+        MultiSymbolHeatmapGrid {
+            id: multiSymbolGrid
+            objectName: "multiSymbolGrid"
+            anchors.fill: parent
+            active: root.multiSymbolMode
+            symbols: ["BTC-USD", "ETH-USD", "SOL-USD", "XRP-USD", "DOGE-USD", "ADA-USD", "AVAX-USD", "LTC-USD", "LINK-USD"]
+            gridColumns: 3
+            historySeconds: 120
+            bandPercent: 0.5
+        }
+        
+        Repeater {
+            model: multiSymbolGrid.symbols
+            Rectangle {
+                x: (index % multiSymbolGrid.gridColumns) * (multiSymbolGrid.tileWidth + 2)
+                y: Math.floor(index / multiSymbolGrid.gridColumns) * (multiSymbolGrid.tileHeight + 2)
+                width: multiSymbolGrid.tileWidth
+                height: multiSymbolGrid.tileHeight
+                color: "transparent"
+                border.color: "#333333"
+                
+                Text {
+                    anchors.left: parent.left
+                    anchors.top: parent.top
+                    anchors.margins: 4
+                    text: modelData
+                    color: "#FFD700"
+                    font.pixelSize: 11
+                    font.bold: true
+                }
+            }
+        }
+    }
+    
     // 🔬 VERTICAL GRID LINES: Visual confirmation of time column alignment
     Item {
         id: gridLines
@@ -304,6 +355,22 @@ Rectangle {
                 }
                 Text { text: "Heatmap"; color: "white"; font.pixelSize: 9 }
             }
+
+            Row {
+                spacing: 8
+                Rectangle {
+                    width: 16; height: 16
+                    border.color: "white"
+                    color: unifiedGridRenderer.consolidatedBook ? "#00FF00" : "transparent"
+                    radius: 2
+                    
+                    MouseArea {
+                        anchors.fill: parent
+                        onClicked: unifiedGridRenderer.consolidatedBook = !unifiedGridRenderer.consolidatedBook
+                    }
+                }
+                Text { text: "All Venues"; color: "white"; font.pixelSize: 9 }
+            }
             
             Row {
                 spacing: 8
@@ -336,6 +403,87 @@ Rectangle {
                 }
                 Text { text: "Trade Flow"; color: "white"; font.pixelSize: 9 }
             }
+            
+            Row {
+                spacing: 8
+                Rectangle {
+                    width: 16; height: 16
+                    border.color: "white"
+                    color: unifiedGridRenderer.showOrderFlowLayer ? "#FFC800" : "transparent"
+                    radius: 2
+                    
+                    MouseArea {
+                        anchors.fill: parent
+                        onClicked: unifiedGridRenderer.showOrderFlowLayer = !unifiedGridRenderer.showOrderFlowLayer
+                    }
+                }
+                Text { text: "Order Flow (CVD)"; color: "white"; font.pixelSize: 9 }
+            }
+            
+            Row {
+                spacing: 8
+                Rectangle {
+                    width: 16; height: 16
+                    border.color: "white"
+                    color: unifiedGridRenderer.showFootprintLayer ? "#C080FF" : "transparent"
+                    radius: 2
+                    
+                    MouseArea {
+                        anchors.fill: parent
+                        onClicked: unifiedGridRenderer.showFootprintLayer = !unifiedGridRenderer.showFootprintLayer
+                    }
+                }
+                Text { text: "Footprint"; color: "white"; font.pixelSize: 9 }
+            }
+            
+            Row {
+                spacing: 8
+                Rectangle {
+                    width: 16; height: 16
+                    border.color: "white"
+                    color: unifiedGridRenderer.showIcebergLayer ? "#00DCFF" : "transparent"
+                    radius: 2
+                    
+                    MouseArea {
+                        anchors.fill: parent
+                        onClicked: unifiedGridRenderer.showIcebergLayer = !unifiedGridRenderer.showIcebergLayer
+                    }
+                }
+                Text { text: "Icebergs"; color: "white"; font.pixelSize: 9 }
+            }
+            
+            Row {
+                spacing: 8
+                Rectangle {
+                    width: 16; height: 16
+                    border.color: "white"
+                    color: unifiedGridRenderer.liquidityDisplayMode === 4 ? "#FF5090" : "transparent"
+                    radius: 2
+                    
+                    MouseArea {
+                        anchors.fill: parent
+                        // 4 = LiquidityDisplayMode::Pulled, 0 = Average
+                        onClicked: unifiedGridRenderer.liquidityDisplayMode = unifiedGridRenderer.liquidityDisplayMode === 4 ? 0 : 4
+                    }
+                }
+                Text { text: "Pulled Liquidity"; color: "white"; font.pixelSize: 9 }
+            }
+            
+            Row {
+                spacing: 8
+                Rectangle {
+                    width: 16; height: 16
+                    border.color: "white"
+                    color: root.multiSymbolMode ? "#FFD700" : "transparent"
+                    radius: 2
+                    
+                    MouseArea {
+                        anchors.fill: parent
+                        onClicked: root.multiSymbolMode = !root.multiSymbolMode
+                    }
+                }
+                Text { text: "Multi-Symbol Grid"; color: "white"; font.pixelSize: 9 }
+            }
         }
         
         // Trade Bubble Controls (only visible when bubble layer is active)
@@ -388,6 +536,27 @@ Rectangle {
         }
     }
 
+    // Performance overlay (P): FPS plus sync/build/render/swap/GPU frame breakdown
+    Text {
+        id: performanceOverlay
+        anchors.left: parent.left
+        anchors.bottom: parent.bottom
+        anchors.margins: 10
+        z: 10
+        visible: unifiedGridRenderer.performanceOverlayVisible
+        color: "#00FF00"
+        font.pixelSize: 10
+        font.family: "monospace"
+
+        Timer {
+            interval: 500
+            repeat: true
+            running: performanceOverlay.visible
+            triggeredOnStart: true
+            onTriggered: performanceOverlay.text = unifiedGridRenderer.getPerformanceStats()
+        }
+    }
+
     // Keyboard Shortcuts
     focus: true
     Keys.onPressed: function(event) {
@@ -402,6 +571,7 @@ Rectangle {
             case Qt.Key_Right: unifiedGridRenderer.panRight(); event.accepted = true; break;
             case Qt.Key_Up: unifiedGridRenderer.panUp(); event.accepted = true; break;
             case Qt.Key_Down: unifiedGridRenderer.panDown(); event.accepted = true; break;
+            case Qt.Key_P: unifiedGridRenderer.togglePerformanceOverlay(); event.accepted = true; break;
             case Qt.Key_G: 
                 if (event.modifiers & Qt.ControlModifier) {
                     root.showTimeGrid = !root.showTimeGrid;
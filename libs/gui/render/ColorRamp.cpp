@@ -0,0 +1,66 @@
+/*
+Sentinel — ColorRamp
+Role: Implements piecewise-linear sampling of theme stops into lookup tables and ramp images.
+Inputs/Outputs: ITheme stops in; RGBA8 tables and QImage rows out.
+Threading: Construction only; see ColorRamp.hpp.
+Performance: kSize x palette count entries, built once per theme change.
+Integration: See ColorRamp.hpp.
+Observability: No internal logging.
+Related: ColorRamp.hpp.
+Assumptions: Empty stop lists produce a transparent palette.
+*/
+#include "ColorRamp.hpp"
+#include "../themes/DarkTheme.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    uint8_t lerpChannel(int a, int b, double t) {
+        return static_cast<uint8_t>(std::clamp(static_cast<int>(std::lround(a + (b - a) * t)), 0, 255));
+    }
+}
+
+std::shared_ptr<const ColorRamp> ColorRamp::fromTheme(const ITheme* theme) {
+    static const DarkTheme kFallback;
+    const ITheme& source = theme ? *theme : kFallback;
+
+    auto ramp = std::make_shared<ColorRamp>();
+    for (size_t p = 0; p < ramp->m_rows.size(); ++p) {
+        const std::vector<RampStop> stops = source.rampStops(static_cast<RampPalette>(p));
+        auto& row = ramp->m_rows[p];
+        if (stops.empty()) continue;
+
+        size_t segment = 0;
+        for (int i = 0; i < kSize; ++i) {
+            const double t = static_cast<double>(i) / (kSize - 1);
+            while (segment + 1 < stops.size() && stops[segment + 1].position < t) ++segment;
+
+            const RampStop& lo = stops[segment];
+            const RampStop& hi = stops[std::min(segment + 1, stops.size() - 1)];
+            const double span = hi.position - lo.position;
+            const double f = span > 0.0 ? std::clamp((t - lo.position) / span, 0.0, 1.0) : 0.0;
+            row[i] = Rgba{lerpChannel(lo.color.red(), hi.color.red(), f),
+                          lerpChannel(lo.color.green(), hi.color.green(), f),
+                          lerpChannel(lo.color.blue(), hi.color.blue(), f),
+                          lerpChannel(lo.color.alpha(), hi.color.alpha(), f)};
+        }
+    }
+    return ramp;
+}
+
+QImage ColorRamp::pairImage(RampPalette first, RampPalette second) const {
+    QImage image(kSize, 2, QImage::Format_RGBA8888_Premultiplied);
+    const RampPalette rows[2] = {first, second};
+    for (int y = 0; y < 2; ++y) {
+        auto* out = image.scanLine(y);
+        const auto& row = m_rows[static_cast<size_t>(rows[y])];
+        for (int x = 0; x < kSize; ++x) {
+            const Rgba& c = row[x];
+            out[x * 4 + 0] = static_cast<uint8_t>((c.r * c.a + 127) / 255);
+            out[x * 4 + 1] = static_cast<uint8_t>((c.g * c.a + 127) / 255);
+            out[x * 4 + 2] = static_cast<uint8_t>((c.b * c.a + 127) / 255);
+            out[x * 4 + 3] = c.a;
+        }
+    }
+    return image;
+}
@@ -0,0 +1,45 @@
+/*
+Sentinel — ColorRamp
+Role: Precomputed per-palette color lookup tables sampled by normalized intensity, built from the active theme.
+Inputs/Outputs: Takes ITheme ramp stops; serves RGBA8 entries and two-row ramp images for shader sampling.
+Threading: Built on the GUI thread (or while it is blocked in sync); immutable afterwards and shared by strategies.
+Performance: Replaces per-cell min/log/HSV color math with a single table index per vertex.
+Integration: UnifiedGridRenderer rebuilds it on theme changes and hands it to every IRenderStrategy.
+Observability: No internal logging.
+Related: ColorRamp.cpp, ITheme.hpp, DarkTheme.cpp, HeatmapMaterial.hpp, IRenderStrategy.hpp.
+Assumptions: Stops are sorted by position; entries store straight (non-premultiplied) alpha.
+*/
+#pragma once
+#include "../themes/ITheme.hpp"
+#include <QColor>
+#include <QImage>
+#include <array>
+#include <cstdint>
+#include <memory>
+
+class ColorRamp {
+public:
+    static constexpr int kSize = 1024;
+
+    struct Rgba {
+        uint8_t r = 0, g = 0, b = 0, a = 0;
+    };
+
+    // Falls back to DarkTheme's palettes when no theme is active
+    static std::shared_ptr<const ColorRamp> fromTheme(const ITheme* theme);
+
+    const Rgba& sample(RampPalette palette, double intensity) const {
+        const double t = intensity <= 0.0 ? 0.0 : (intensity >= 1.0 ? 1.0 : intensity);
+        return m_rows[static_cast<size_t>(palette)][static_cast<size_t>(t * (kSize - 1) + 0.5)];
+    }
+    QColor color(RampPalette palette, double intensity) const {
+        const Rgba& c = sample(palette, intensity);
+        return QColor(c.r, c.g, c.b, c.a);
+    }
+
+    // kSize x 2 premultiplied image: row 0 = first, row 1 = second (one texture for a bid/ask pair)
+    QImage pairImage(RampPalette first, RampPalette second) const;
+
+private:
+    std::array<std::array<Rgba, kSize>, static_cast<size_t>(RampPalette::Count)> m_rows{};
+};
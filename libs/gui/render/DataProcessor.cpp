@@ -15,9 +15,12 @@ Assumptions: The processing interval is a good balance between latency and effic
 #include <QMetaObject>
 #include <QMetaType>
 #include <QDateTime>
+#include <QThread>
 #include <cmath>
 #include "SentinelLogging.hpp"
 #include "../../core/marketdata/cache/DataCache.hpp"
+#include "../../core/marketdata/feeds/FeedAggregator.hpp"
+#include "../../core/SessionCheckpoint.h"
 #include "../CoordinateSystem.h"
 #include <QColor>
 #include <chrono>
@@ -25,10 +28,15 @@ Assumptions: The processing interval is a good balance between latency and effic
 #include <climits>
 #include <cmath>
 #include <algorithm>
+#include <atomic>
 
 namespace {
 constexpr bool kTraceCellDebug = false;
 constexpr bool kTraceCoordinateDebug = false;
+
+// Trade density pyramid: 1s bins for 24 minutes, 10s for 4 hours, 1m for a full day (~18 MB per symbol)
+const std::vector<int64_t> kTradeDensityTimeframes = {1000, 10000, 60000};
+constexpr size_t kTradeDensityBars = 1440;
 }
 
 DataProcessor::DataProcessor(QObject* parent)
@@ -36,8 +44,15 @@ DataProcessor::DataProcessor(QObject* parent)
     
     m_snapshotTimer = new QTimer(this);
     connect(m_snapshotTimer, &QTimer::timeout, this, &DataProcessor::captureOrderBookSnapshot);
+    m_checkpointTimer = new QTimer(this);
+    connect(m_checkpointTimer, &QTimer::timeout, this, &DataProcessor::writeCheckpoint);
     
     m_liquidityEngine = new LiquidityTimeSeriesEngine(this);
+    m_orderFlowEngine = std::make_unique<OrderFlowEngine>();
+    m_footprintEngine = std::make_unique<FootprintEngine>();
+    m_tradeDensityEngine = std::make_unique<FootprintEngine>(kTradeDensityTimeframes, kTradeDensityBars);
+    m_icebergDetector = std::make_unique<IcebergDetector>();
+    m_pullEngine = std::make_unique<LiquidityPullEngine>();
     
     sLog_App("DataProcessor: Initialized for V2 architecture");
 }
@@ -48,6 +63,8 @@ DataProcessor::~DataProcessor() {
         sLog_App("DataProcessor destructor - stopProcessing() not called yet");
     }
     stopProcessing();
+    if (m_checkpointWriter.joinable()) m_checkpointWriter.join();
+    if (m_dataCache && m_bookBucketView > 0.0) m_dataCache->removeBookBucketView(m_bookBucketView);
     // This log will always appear, even if stopProcessing() returned early
     sLog_App("DataProcessor destructor complete");
 }
@@ -76,6 +93,16 @@ void DataProcessor::stopProcessing() {
     if (m_snapshotTimer) {
         m_snapshotTimer->stop();
     }
+    if (m_checkpointTimer) {
+        m_checkpointTimer->stop();
+    }
+    
+    // Final checkpoint runs on the processor thread, which owns the liquidity engine
+    if (QThread::currentThread() == thread()) {
+        writeFinalCheckpoint();
+    } else if (thread()->isRunning()) {
+        QMetaObject::invokeMethod(this, &DataProcessor::writeFinalCheckpoint, Qt::BlockingQueuedConnection);
+    }
     
     // Disconnect all signals to prevent callbacks during shutdown
     disconnect(this, nullptr, nullptr, nullptr);
@@ -97,9 +124,22 @@ void DataProcessor::onTradeReceived(const Trade& trade) {
     auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
         trade.timestamp.time_since_epoch()).count();
     
+    // Every trade feeds order-flow stats, regardless of which symbol is charted
+    m_orderFlowEngine->onTrade(trade);
+    if (m_icebergDetector->onTrade(trade) > 0) {
+        publishIcebergEvent(trade.product_id);
+    }
+    m_pullEngine->onTrade(trade);
+    
+    bool charted = false;
     {
         std::lock_guard<std::mutex> lock(m_dataMutex);
         
+        if (m_activeSymbol.empty() && (m_chartSymbol.empty() || trade.product_id == m_chartSymbol)) {
+            m_activeSymbol = trade.product_id;
+        }
+        charted = trade.product_id == (m_chartSymbol.empty() ? m_activeSymbol : m_chartSymbol);
+        
         if (m_viewState && !m_viewState->isTimeWindowValid()) {
             initializeViewportFromTrade(trade);
         }
@@ -107,6 +147,12 @@ void DataProcessor::onTradeReceived(const Trade& trade) {
         sLog_Data("DataProcessor TRADE UPDATE: Processing trade");
     }
     
+    // Footprint and density rings are tens of MB per symbol and only ever drawn for the chart
+    if (charted) {
+        m_footprintEngine->onTrade(trade);
+        m_tradeDensityEngine->onTrade(trade);
+    }
+    
     sLog_Data("DataProcessor TRADE: $" << trade.price 
                  << " vol:" << trade.size 
                  << " timestamp:" << timestamp);
@@ -146,6 +192,99 @@ const OrderBook& DataProcessor::getLatestOrderBook() const {
     return m_latestOrderBook ? *m_latestOrderBook : emptyBook;
 }
 
+void DataProcessor::setCheckpointPath(const QString& path, bool restoreBooks) {
+    m_checkpointPath = path.toStdString();
+    if (m_checkpointPath.empty()) {
+        m_checkpointTimer->stop();
+        return;
+    }
+    restoreCheckpoint(restoreBooks);
+    m_checkpointTimer->start(kCheckpointIntervalMs);
+}
+
+void DataProcessor::writeCheckpoint() {
+    if (m_checkpointPath.empty() || !m_dataCache) return;
+    if (m_checkpointWriting.exchange(true)) return;  // Previous write still on disk I/O
+    if (m_checkpointWriter.joinable()) m_checkpointWriter.join();
+
+    // Book/trade copies and slice handles only; the slices themselves are immutable once shared
+    auto snapshot = SessionCheckpoint::capture(*m_dataCache, m_liquidityEngine, SessionCheckpoint::Options{});
+    m_checkpointWriter = std::thread([this, path = m_checkpointPath, snapshot = std::move(snapshot)]() {
+        SessionCheckpoint::write(path, snapshot);
+        m_checkpointWriting.store(false);
+    });
+}
+
+void DataProcessor::writeFinalCheckpoint() {
+    if (m_checkpointWriter.joinable()) m_checkpointWriter.join();
+    m_checkpointWriting.store(false);
+    if (m_checkpointPath.empty() || !m_dataCache) return;
+    SessionCheckpoint::write(m_checkpointPath, *m_dataCache, m_liquidityEngine, SessionCheckpoint::Options{});
+}
+
+void DataProcessor::restoreCheckpoint(bool restoreBooks) {
+    if (!m_dataCache) return;
+    SessionCheckpoint::Options options;
+    options.restoreBooks = restoreBooks;
+    const auto result = SessionCheckpoint::restore(m_checkpointPath, *m_dataCache, m_liquidityEngine, options);
+    if (!result.ok) return;
+
+    // Frame the restored state so history is on screen before the first live snapshot arrives
+    std::string symbol;
+    {
+        std::lock_guard<std::mutex> lock(m_dataMutex);
+        symbol = !m_chartSymbol.empty() ? m_chartSymbol : m_activeSymbol;
+    }
+    if (symbol.empty()) {
+        for (const auto& candidate : m_dataCache->liveBookSymbols()) {
+            if (!m_dataCache->getDirectLiveOrderBook(candidate).isEmpty()) {
+                symbol = candidate;
+                break;
+            }
+        }
+    }
+    if (symbol.empty()) {
+        const auto symbols = m_dataCache->tradeSymbols();
+        if (!symbols.empty()) symbol = symbols.front();
+    }
+    if (symbol.empty()) return;
+
+    std::vector<std::pair<uint32_t, double>> bidBuf;
+    std::vector<std::pair<uint32_t, double>> askBuf;
+    const auto& book = m_dataCache->getDirectLiveOrderBook(symbol);
+    const auto view = book.captureDenseNonZero(bidBuf, askBuf, 1);
+    if (view.bidLevels.empty() && view.askLevels.empty()) {
+        // Books are not restored by default: frame on the newest restored trade instead
+        const auto trades = m_dataCache->recentTrades(symbol);
+        const auto newest = std::max_element(trades.begin(), trades.end(),
+            [](const Trade& a, const Trade& b) { return a.timestamp < b.timestamp; });
+        if (newest == trades.end()) return;
+        {
+            std::lock_guard<std::mutex> lock(m_dataMutex);
+            if (m_activeSymbol.empty()) m_activeSymbol = symbol;
+            if (m_viewState && !m_viewState->isTimeWindowValid()) {
+                initializeViewportFromTrade(*newest);
+            }
+        }
+        updateVisibleCells();
+        return;
+    }
+
+    OrderBook seed;
+    seed.product_id = symbol;
+    seed.timestamp = std::chrono::system_clock::now();
+    for (const auto& [idx, qty] : view.bidLevels) seed.bids.push_back({view.minPrice + idx * view.tickSize, qty});
+    for (const auto& [idx, qty] : view.askLevels) seed.asks.push_back({view.minPrice + idx * view.tickSize, qty});
+    {
+        std::lock_guard<std::mutex> lock(m_dataMutex);
+        if (m_activeSymbol.empty()) m_activeSymbol = symbol;
+        if (m_viewState && !m_viewState->isTimeWindowValid()) {
+            initializeViewportFromOrderBook(seed);
+        }
+    }
+    updateVisibleCells();
+}
+
 void DataProcessor::captureOrderBookSnapshot() {
     /*  
     This function captures the current state of an order book and aligns it to a 100ms time bucket.
@@ -259,7 +398,8 @@ void DataProcessor::initializeViewportFromOrderBook(const OrderBook& book) {
     emit viewportInitialized();
 }
 
-void DataProcessor::onLiveOrderBookUpdated(const QString& productId, const std::vector<BookDelta>& deltas) {
+void DataProcessor::onLiveOrderBookUpdated(const QString& productId, const std::vector<BookDelta>& deltas,
+                                           const BookGrid& grid) {
     // Early return if shutting down
     if (m_shuttingDown.load()) {
         return;
@@ -270,15 +410,96 @@ void DataProcessor::onLiveOrderBookUpdated(const QString& productId, const std::
         return;
     }
     
-    const auto& liveBook = m_dataCache->getDirectLiveOrderBook(productId.toStdString());
+    const std::string symbol = productId.toStdString();
+    const bool consolidated = m_useConsolidatedBook && m_feeds && m_useDenseIngestion;
+    if (consolidated && symbol.find('@') != std::string::npos) {
+        // SYMBOL@VENUE books reach the chart only through their symbol's consolidated book
+        const std::string base(feed::symbolOf(symbol));
+        {
+            std::lock_guard<std::mutex> lock(m_dataMutex);
+            if (base != (m_chartSymbol.empty() ? m_activeSymbol : m_chartSymbol)) return;
+        }
+        ingestConsolidated(base);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_dataMutex);
+        // Other subscribed books (e.g. multi-symbol grid tiles) must not bleed into this chart
+        if (!m_chartSymbol.empty() && symbol != m_chartSymbol) return;
+        m_activeSymbol = symbol;
+    }
+    const auto& liveBook = m_dataCache->getDirectLiveOrderBook(symbol);
+    // A checkpointed book is minutes old: sampling it would paint stale liquidity as "now"
+    if (liveBook.isStale()) return;
+
+    // The detectors map the batch through the grid it was stamped with: the book may have been
+    // regridded since, and configuring them from its current geometry would mis-map every delta
+    if (grid.tickSize > 0.0) {
+        // Iceberg detection runs on raw deltas so every refill is seen, independent of snapshot cadence
+        m_icebergDetector->configureBook(symbol, grid.minPrice, grid.tickSize);
+        const int64_t deltaTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+            grid.timestamp.time_since_epoch()).count();
+        if (m_icebergDetector->onBookDeltas(symbol, deltaTime, deltas) > 0) {
+            publishIcebergEvent(symbol);
+        }
+
+        // Pull attribution also runs per delta batch; finalized pulls feed the Pulled display mode
+        m_pullEngine->configureBook(symbol, grid.minPrice, grid.tickSize);
+        // Footprint rows sit on the book's own price grid
+        m_footprintEngine->setTickSize(symbol, grid.tickSize);
+        m_tradeDensityEngine->setTickSize(symbol, grid.tickSize);
+        auto toGridIndex = [](size_t idx) {
+            return idx == LiveOrderBook::kNoLevel ? LiquidityPullEngine::kNoLevel : static_cast<uint32_t>(idx);
+        };
+        static thread_local std::vector<PullEvent> pulls;
+        pulls.clear();
+        if (m_pullEngine->onBookDeltas(symbol, deltaTime, deltas,
+                                       toGridIndex(grid.bestBidIndex),
+                                       toGridIndex(grid.bestAskIndex), &pulls) > 0) {
+            for (const auto& pull : pulls) {
+                m_liquidityEngine->addPulledLiquidity(pull.timestamp_ms, pull.price, pull.isBid, pull.quantity);
+            }
+        }
+    }
 
     // Phase 1: Dense ingestion path (behind feature flag)
     if (m_useDenseIngestion) {
-        static thread_local std::vector<std::pair<uint32_t, double>> bidBuf;
-        static thread_local std::vector<std::pair<uint32_t, double>> askBuf;
+        if (consolidated && ingestConsolidated(symbol)) return;
+
         constexpr size_t kMaxPerSide = 4000; // bounded ingestion per side
 
+        // Preferred: the book's incrementally maintained bucket view at the engine's base tick
+        static thread_local std::vector<std::pair<double, double>> bidBucketBuf;
+        static thread_local std::vector<std::pair<double, double>> askBucketBuf;
+        LiveOrderBook::BucketSnapshotView buckets;
+        if (liveBook.captureBuckets(m_liquidityEngine->getBaseTickSize(), bidBucketBuf, askBucketBuf, kMaxPerSide, buckets)) {
+            if (buckets.bestBidQuantity > 0.0 && buckets.bestAskQuantity > 0.0) {
+                const int64_t bookTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    buckets.timestamp.time_since_epoch()).count();
+                m_orderFlowEngine->onTopOfBook(symbol, bookTime, buckets.bestBidQuantity, buckets.bestAskQuantity);
+            }
+            if (!buckets.bidBuckets.empty() || !buckets.askBuckets.empty()) {
+                m_liquidityEngine->addBucketedSnapshot(buckets);
+                {
+                    std::lock_guard<std::mutex> lock(m_dataMutex);
+                    m_hasValidOrderBook = true;
+                }
+                updateVisibleCells();
+                return;
+            }
+        }
+
+        // Fallback: raw levels quantized per snapshot (base tick is not a whole number of ticks on this grid)
+        static thread_local std::vector<std::pair<uint32_t, double>> bidBuf;
+        static thread_local std::vector<std::pair<uint32_t, double>> askBuf;
         auto view = liveBook.captureDenseNonZero(bidBuf, askBuf, kMaxPerSide);
+        if (!view.bidLevels.empty() && !view.askLevels.empty()) {
+            // Levels are collected best-first, so the front of each side is top of book
+            const int64_t bookTime = std::chrono::duration_cast<std::chrono::milliseconds>(
+                view.timestamp.time_since_epoch()).count();
+            m_orderFlowEngine->onTopOfBook(symbol, bookTime,
+                                           view.bidLevels.front().second, view.askLevels.front().second);
+        }
         if (!view.bidLevels.empty() || !view.askLevels.empty()) {
             m_liquidityEngine->addDenseSnapshot(view);
             {
@@ -294,26 +515,18 @@ void DataProcessor::onLiveOrderBookUpdated(const QString& productId, const std::
     sLog_Render("DataProcessor processing dense LiveOrderBook - bids:" << liveBook.getBidCount() << " asks:" << liveBook.getAskCount());
     // Build a mid-centered banded sparse snapshot from dense book
     OrderBook sparseBook;
-    sparseBook.product_id = productId.toStdString();
+    sparseBook.product_id = symbol;
     sparseBook.timestamp = std::chrono::system_clock::now();
 
-    const auto& denseBids = liveBook.getBids();
-    const auto& denseAsks = liveBook.getAsks();
-
-    // Determine best bid/ask
-    double bestBid = std::numeric_limits<double>::quiet_NaN();
-    double bestAsk = std::numeric_limits<double>::quiet_NaN();
-    size_t bestBidIdx = 0;
-    size_t bestAskIdx = 0;
-    for (size_t i = denseBids.size(); i > 0; --i) {
-        size_t idx = i - 1;
-        if (denseBids[idx] > 0.0) { bestBidIdx = idx; bestBid = liveBook.getMinPrice() + (static_cast<double>(idx) * liveBook.getTickSize()); break; }
-    }
-    for (size_t i = 0; i < denseAsks.size(); ++i) {
-        if (denseAsks[i] > 0.0) { bestAskIdx = i; bestAsk = liveBook.getMinPrice() + (static_cast<double>(i) * liveBook.getTickSize()); break; }
-    }
+    // Mid from a consistent grid read; the band itself is captured by price under the book lock, so a
+    // re-centre in between only shifts which indices back those prices
+    const BookGrid bandGrid = liveBook.grid();
+    const double bestBid = bandGrid.bestBidIndex == BookGrid::kNoLevel
+        ? std::numeric_limits<double>::quiet_NaN() : bandGrid.priceAt(bandGrid.bestBidIndex);
+    const double bestAsk = bandGrid.bestAskIndex == BookGrid::kNoLevel
+        ? std::numeric_limits<double>::quiet_NaN() : bandGrid.priceAt(bandGrid.bestAskIndex);
     double mid = (!std::isnan(bestBid) && !std::isnan(bestAsk)) ? (bestBid + bestAsk) * 0.5
-               : (!std::isnan(bestBid) ? bestBid : (!std::isnan(bestAsk) ? bestAsk : liveBook.getMinPrice() + 0.5 * (denseBids.size() * liveBook.getTickSize())));
+               : (!std::isnan(bestBid) ? bestBid : (!std::isnan(bestAsk) ? bestAsk : bandGrid.minPrice + 0.5 * (bandGrid.levels * bandGrid.tickSize)));
     
     // Compute band width according to mode
     // TODO: Make band width dynamic per-asset and user-configurable, and eventually
@@ -322,51 +535,31 @@ void DataProcessor::onLiveOrderBookUpdated(const QString& productId, const std::
     switch (m_bandMode) {
         case BandMode::FixedDollar: halfBand = std::max(1e-6, m_bandValue); break;
         case BandMode::PercentMid:  halfBand = std::max(1e-6, std::abs(mid) * m_bandValue); break;
-        case BandMode::Ticks:       halfBand = std::max(1.0, m_bandValue) * liveBook.getTickSize(); break;
+        case BandMode::Ticks:       halfBand = std::max(1.0, m_bandValue) * bandGrid.tickSize; break;
     }
     // Ensure a sensible default if unset
     if (halfBand <= 0.0) {
         halfBand = 100.0; // $100 default window for BTC testing; TODO: derive from asset volatility/profile
     }
     // Clamp band to available data range
-    const double maxHalfBand = (std::max(denseBids.size(), denseAsks.size()) * liveBook.getTickSize()) * 0.5;
+    const double maxHalfBand = (bandGrid.levels * bandGrid.tickSize) * 0.5;
     halfBand = std::min(halfBand, maxHalfBand);
     const double bandMinPrice = mid - halfBand;
     const double bandMaxPrice = mid + halfBand;
 
-    // Convert bids (scan from highest to lowest within band)
-    if (!denseBids.empty()) {
-        size_t maxIndex = static_cast<size_t>(std::min<double>(denseBids.size(), std::ceil((bandMaxPrice - liveBook.getMinPrice()) / liveBook.getTickSize()) + 1));
-        size_t minIndex = static_cast<size_t>(std::max<double>(0.0, std::floor((bandMinPrice - liveBook.getMinPrice()) / liveBook.getTickSize())));
-        for (size_t i = maxIndex; i > minIndex && i > 0; --i) {
-            size_t idx = i - 1;
-            double qty = denseBids[idx];
-            if (qty > 0.0) {
-                double price = liveBook.getMinPrice() + (static_cast<double>(idx) * liveBook.getTickSize());
-                sparseBook.bids.push_back({price, qty});
-            }
-        }
-    }
-    // Convert asks (scan from lowest to highest within band)
-    if (!denseAsks.empty()) {
-        size_t minIndex = static_cast<size_t>(std::max<double>(0.0, std::floor((bandMinPrice - liveBook.getMinPrice()) / liveBook.getTickSize())));
-        size_t maxIndex = static_cast<size_t>(
-            std::min<double>(denseAsks.size(), std::ceil((bandMaxPrice - liveBook.getMinPrice()) / liveBook.getTickSize()) + 1));
-        for (size_t i = minIndex; i < maxIndex; ++i) {
-            double qty = denseAsks[i];
-            if (qty > 0.0) {
-                double price = liveBook.getMinPrice() + (static_cast<double>(i) * liveBook.getTickSize());
-                sparseBook.asks.push_back({price, qty});
-            }
-        }
-    }
+    // Bids highest to lowest, asks lowest to highest, within the band
+    liveBook.captureLevels(bandMinPrice, bandMaxPrice, sparseBook.bids, sparseBook.asks);
 
     // Fallback: if band yielded no levels, inject top-of-book so LTSE advances time
+    static thread_local std::vector<OrderBookLevel> topBids;
+    static thread_local std::vector<OrderBookLevel> topAsks;
     if (sparseBook.bids.empty() && !std::isnan(bestBid)) {
-        sparseBook.bids.push_back({bestBid, denseBids[bestBidIdx]});
+        liveBook.captureLevels(bestBid, bestBid, topBids, topAsks);
+        if (!topBids.empty()) sparseBook.bids.push_back(topBids.front());
     }
     if (sparseBook.asks.empty() && !std::isnan(bestAsk)) {
-        sparseBook.asks.push_back({bestAsk, denseAsks[bestAskIdx]});
+        liveBook.captureLevels(bestAsk, bestAsk, topBids, topAsks);
+        if (!topAsks.empty()) sparseBook.asks.push_back(topAsks.front());
     }
 
     if (!sparseBook.bids.empty() || !sparseBook.asks.empty()) {
@@ -387,6 +580,21 @@ void DataProcessor::clearData() {
     
     m_latestOrderBook = nullptr;
     m_hasValidOrderBook = false;
+    if (m_orderFlowEngine) {
+        m_orderFlowEngine->clear();
+    }
+    if (m_footprintEngine) {
+        m_footprintEngine->clear();
+    }
+    if (m_tradeDensityEngine) {
+        m_tradeDensityEngine->clear();
+    }
+    if (m_icebergDetector) {
+        m_icebergDetector->clear();
+    }
+    if (m_pullEngine) {
+        m_pullEngine->clear();
+    }
     
     if (m_viewState) {
         m_viewState->resetZoom();
@@ -407,45 +615,58 @@ void DataProcessor::updateVisibleCells() {
 
     if (!m_viewState || !m_viewState->isTimeWindowValid()) return;
     
-    // Viewport version gating: full rebuild only when viewport changes
+    // Viewport version gating: full rebuild only when the viewport leaves the built coverage
     const uint64_t currentViewportVersion = m_viewState->getViewportVersion();
     const bool viewportChanged = (currentViewportVersion != m_lastViewportVersion);
-    if (viewportChanged) {
+    m_lastViewportVersion = currentViewportVersion;
+
+    // Level of detail: the hysteresis band keeps zooming around a boundary on one timeframe, and a
+    // manual pick holds until the viewport would need too many columns at it
+    if (m_liquidityEngine) {
+        const int64_t span = m_viewState->getVisibleTimeEnd() - m_viewState->getVisibleTimeStart();
+        const int64_t lodTimeframe = m_lod.update(span, m_liquidityEngine->getPopulatedTimeframes());
+        if (lodTimeframe > 0 && lodTimeframe != m_currentTimeframe_ms) {
+            sLog_Render("LOD TIMEFRAME: " << m_currentTimeframe_ms << "ms -> " << lodTimeframe << "ms"
+                        << (m_lod.isManual() ? " (manual)" : ""));
+            m_currentTimeframe_ms = lodTimeframe;
+        }
+    }
+    const int64_t activeTimeframe = m_currentTimeframe_ms;
+    
+    // Cells are world-space and renderers re-map them on the GPU, so zooming/panning inside the
+    // region they were built for keeps them; a new region or timeframe starts over
+    const CellCoverage viewportRegion{m_viewState->getVisibleTimeStart(), m_viewState->getVisibleTimeEnd(),
+                                      m_viewState->getMinPrice(), m_viewState->getMaxPrice()};
+    // A drag in progress asks for the region it is about to expose as well
+    CellCoverage requiredRegion = viewportRegion;
+    const bool prefetchRequested = m_pendingPrefetch.has_value();
+    if (prefetchRequested) {
+        requiredRegion = requiredRegion.united(*m_pendingPrefetch);
+        m_pendingPrefetch.reset();
+    }
+    const bool regionChanged = (viewportChanged || prefetchRequested) && !m_cellCoverage.contains(requiredRegion);
+    // A timeframe switch first looks for cells prefetched for it over a covering region
+    const bool adopted = activeTimeframe != m_cellTimeframe_ms && adoptPrefetchedLod(activeTimeframe, requiredRegion);
+    // Moving along time keeps what is built and only appends the newly covered slices
+    const bool extended = !adopted && activeTimeframe == m_cellTimeframe_ms && regionChanged &&
+                          extendCoverage(requiredRegion, viewportRegion);
+    const bool rebuild = !adopted && (activeTimeframe != m_cellTimeframe_ms || (regionChanged && !extended));
+    if (rebuild) {
         m_visibleCells.clear();
         m_processedTimeRanges.clear();
         m_lastProcessedTime = 0;
-        m_lastViewportVersion = currentViewportVersion;
+        m_cellCoverage = withMargin(requiredRegion, viewportRegion);
+        m_cellTimeframe_ms = activeTimeframe;
     }
-
-    int64_t activeTimeframe = m_currentTimeframe_ms;
     
-    // Use manual timeframe if set, otherwise auto-suggest
-    // TODO: Investigate dynamic zoom/timeframe: ensure viewportChanged triggers re-suggest and manual override timeout resets
-    if (!m_manualTimeframeSet || 
-        (m_manualTimeframeTimer.isValid() && m_manualTimeframeTimer.elapsed() > 10000)) {  // 10 second timeout
-        
-        // Auto-suggest timeframe when no manual override
-        if (m_liquidityEngine) {
-            int64_t optimalTimeframe = m_liquidityEngine->suggestTimeframe(
-                m_viewState->getVisibleTimeStart(), m_viewState->getVisibleTimeEnd(), 2000);
-            
-            if (optimalTimeframe != m_currentTimeframe_ms) {
-                m_currentTimeframe_ms = optimalTimeframe;
-                activeTimeframe = optimalTimeframe;
-                sLog_Render("AUTO-TIMEFRAME UPDATE: " << optimalTimeframe << "ms (viewport-optimized)");
-            }
-        }
-    } else {
-        sLog_Render("MANUAL TIMEFRAME: Using " << m_currentTimeframe_ms << "ms (user-selected)");
-    }
-    
-    // Get liquidity slices for active timeframe within viewport
+    // Get liquidity slices for active timeframe within the covered region
     if (m_liquidityEngine) {
-        qint64 timeStart = m_viewState->getVisibleTimeStart();
-        qint64 timeEnd = m_viewState->getVisibleTimeEnd();
+        qint64 timeStart = m_cellCoverage.timeStart_ms;
+        qint64 timeEnd = m_cellCoverage.timeEnd_ms;
         sLog_Render("LTSE QUERY: timeframe=" << activeTimeframe << "ms, window=[" << timeStart << "-" << timeEnd << "]");
         
-        auto visibleSlices = m_liquidityEngine->getVisibleSlices(activeTimeframe, timeStart, timeEnd);
+        // Finalized columns only, as shared handles; the still-building slice is published separately as the live column
+        auto visibleSlices = m_liquidityEngine->getFinalizedSlices(activeTimeframe, timeStart, timeEnd);
         sLog_Render("LTSE RESULT: Found " << visibleSlices.size() << " slices for rendering");
         
         // Auto-fix viewport only when auto-scroll is enabled; never fight user pan/zoom
@@ -455,7 +676,7 @@ void DataProcessor::updateVisibleCells() {
             if (!canAutoFix) {
                 sLog_Render("SKIP AUTO-ADJUST: auto-scroll disabled (user interaction in progress)");
             } else {
-                auto allSlices = m_liquidityEngine->getVisibleSlices(activeTimeframe, 0, LLONG_MAX);
+                auto allSlices = m_liquidityEngine->getFinalizedSlices(activeTimeframe, 0, LLONG_MAX);
                 if (!allSlices.empty()) {
                     qint64 oldestTime = allSlices.front()->startTime_ms;
                     qint64 newestTime = allSlices.back()->endTime_ms;
@@ -470,9 +691,12 @@ void DataProcessor::updateVisibleCells() {
                         sLog_Render("AUTO-ADJUSTING VIEWPORT: [" << newStart << "-" << newEnd << "] to match data");
                         
                         m_viewState->setViewport(newStart, newEnd, m_viewState->getMinPrice(), m_viewState->getMaxPrice());
+                        m_lastViewportVersion = m_viewState->getViewportVersion();
+                        m_cellCoverage.timeStart_ms = newStart;
+                        m_cellCoverage.timeEnd_ms = newEnd;
                         
                         // Retry query with corrected viewport
-                        visibleSlices = m_liquidityEngine->getVisibleSlices(activeTimeframe, newStart, newEnd);
+                        visibleSlices = m_liquidityEngine->getFinalizedSlices(activeTimeframe, newStart, newEnd);
                         sLog_Render("VIEWPORT FIX RESULT: Found " << visibleSlices.size() << " slices after adjustment");
                     }
                 }
@@ -481,77 +705,284 @@ void DataProcessor::updateVisibleCells() {
 
         // Track processed slices and append only new data when viewport is stable
         const size_t beforeSize = m_visibleCells.size();
-        int processedSlices = 0;
-
-        if (viewportChanged || m_lastProcessedTime == 0) {
+        if (rebuild || m_lastProcessedTime == 0) {
             // Full rebuild: clear processed time range tracking and process everything
             m_processedTimeRanges.clear();
-            for (const auto* slice : visibleSlices) {
-                ++processedSlices;
-                createCellsFromLiquiditySlice(*slice);
-                m_processedTimeRanges.insert({slice->startTime_ms, slice->endTime_ms});
-                if (slice && slice->endTime_ms > m_lastProcessedTime) {
-                    m_lastProcessedTime = slice->endTime_ms;
-                }
-            }
-        } else {
-            // Append mode: process only slices with NEW time ranges
-            // CRITICAL: LTSE reuses slice objects in memory, so we MUST track by time range, not pointer
-            for (const auto* slice : visibleSlices) {
-                if (!slice) continue;
-
-                SliceTimeRange range{slice->startTime_ms, slice->endTime_ms};
-
-                // Check if we've already processed a slice with this time range
-                if (m_processedTimeRanges.find(range) == m_processedTimeRanges.end()) {
-                    ++processedSlices;
-                    createCellsFromLiquiditySlice(*slice);
-                    m_processedTimeRanges.insert(range);
-                }
-
-                // Update last processed time to newest slice
-                if (slice->endTime_ms > m_lastProcessedTime) {
-                    m_lastProcessedTime = slice->endTime_ms;
-                }
-            }
+        }
+        // Append mode builds only new slices, plus any a late pull changed since its cells were built
+        const size_t processedSlices = appendSliceCells(visibleSlices, m_visibleCells, m_processedTimeRanges);
+        for (const auto& slice : visibleSlices) {
+            m_lastProcessedTime = std::max(m_lastProcessedTime, slice->endTime_ms);
         }
 
         // Do NOT prune off-viewport cells here; retain history so zoom-out can
         // immediately reveal older columns without requiring a recompute.
 
-        const bool changed = viewportChanged || (m_visibleCells.size() != beforeSize);
+        const bool changed = rebuild || adopted || extended || processedSlices > 0 || (m_visibleCells.size() != beforeSize);
 
         sLog_Render("SLICE PROCESSING: Processed " << processedSlices << "/" << visibleSlices.size() << " slices ("
-                    << (viewportChanged ? "rebuild" : "append") << ")");
+                    << (rebuild ? "rebuild" : adopted ? "prefetched" : extended ? "extend" : "append") << ")");
         sLog_Render("DATA PROCESSOR COVERAGE Slices:" << visibleSlices.size()
                     << " TotalCells:" << m_visibleCells.size()
                     << " ActiveTimeframe:" << activeTimeframe << "ms"
-                    << " (Manual:" << (m_manualTimeframeSet ? "YES" : "NO") << ")");
+                    << " (Manual:" << (m_lod.isManual() ? "YES" : "NO") << ")");
 
         // Publish snapshot only when something changed
         if (changed) {
-            {
-                std::lock_guard<std::mutex> snapLock(m_snapshotMutex);
-                m_publishedCells = std::make_shared<std::vector<CellInstance>>(m_visibleCells);
-            }
-            emit dataUpdated();
+            publishCells();
         }
+        updateLiveColumn(activeTimeframe);
+        scheduleLodPrefetch();
         return; // Avoid duplicate publish below
     }
     
     // Fallback: if no liquidity engine, publish current state (likely empty)
+    publishCells();
+}
+
+void DataProcessor::publishCells() {
     {
         std::lock_guard<std::mutex> snapLock(m_snapshotMutex);
         m_publishedCells = std::make_shared<std::vector<CellInstance>>(m_visibleCells);
+        m_publishedCoverage = Viewport{m_cellCoverage.timeStart_ms, m_cellCoverage.timeEnd_ms,
+                                       m_cellCoverage.priceMin, m_cellCoverage.priceMax, 0.0, 0.0};
     }
     emit dataUpdated();
 }
 
-void DataProcessor::createCellsFromLiquiditySlice(const LiquidityTimeSlice& slice) {
+void DataProcessor::prefetchRegion(qint64 timeStart, qint64 timeEnd, double priceMin, double priceMax) {
+    if (timeEnd <= timeStart || priceMax <= priceMin) return;
+    const CellCoverage region{timeStart, timeEnd, priceMin, priceMax};
+    if (m_cellCoverage.contains(region)) return;  // Already built, nothing to do
+    m_pendingPrefetch = m_pendingPrefetch ? m_pendingPrefetch->united(region) : region;
+    updateVisibleCells();
+}
+
+DataProcessor::CellCoverage DataProcessor::withMargin(const CellCoverage& region, const CellCoverage& viewport) const {
+    const auto timeMargin = static_cast<int64_t>((viewport.timeEnd_ms - viewport.timeStart_ms) * kCoverageTimeMargin);
+    const double priceMargin = (viewport.priceMax - viewport.priceMin) * kCoveragePriceMargin;
+    return {region.timeStart_ms - timeMargin, region.timeEnd_ms + timeMargin,
+            region.priceMin - priceMargin, region.priceMax + priceMargin};
+}
+
+bool DataProcessor::extendCoverage(const CellCoverage& region, const CellCoverage& viewport) {
+    // Slices are culled whole in time but per level in price, so only time can grow additively
+    if (region.priceMin < m_cellCoverage.priceMin || region.priceMax > m_cellCoverage.priceMax) return false;
+
+    const CellCoverage padded = withMargin(region, viewport);
+    CellCoverage grown = m_cellCoverage;
+    if (region.timeStart_ms < grown.timeStart_ms) grown.timeStart_ms = padded.timeStart_ms;
+    if (region.timeEnd_ms > grown.timeEnd_ms) grown.timeEnd_ms = padded.timeEnd_ms;
+
+    const double viewportSpan = static_cast<double>(viewport.timeEnd_ms - viewport.timeStart_ms);
+    if (static_cast<double>(grown.timeEnd_ms - grown.timeStart_ms) > viewportSpan * kMaxCoverageSpans) return false;
+
+    m_cellCoverage = grown;
+    return true;
+}
+
+bool DataProcessor::adoptPrefetchedLod(int64_t timeframe_ms, const CellCoverage& region) {
+    auto it = std::find_if(m_lodPrefetch.begin(), m_lodPrefetch.end(), [&](const LodCells& lod) {
+        return lod.timeframe_ms == timeframe_ms && lod.coverage.contains(region);
+    });
+    if (it == m_lodPrefetch.end()) return false;
+
+    LodCells previous{m_cellTimeframe_ms, m_cellCoverage, std::move(m_visibleCells),
+                      std::move(m_processedTimeRanges), m_lastProcessedTime};
+    m_cellTimeframe_ms = it->timeframe_ms;
+    m_cellCoverage = it->coverage;
+    m_visibleCells = std::move(it->cells);
+    m_processedTimeRanges = std::move(it->processedTimeRanges);
+    m_lastProcessedTime = it->lastProcessedTime;
+
+    // The level we just left is now a neighbour of the new one
+    if (previous.timeframe_ms > 0) {
+        *it = std::move(previous);
+    } else {
+        m_lodPrefetch.erase(it);
+    }
+    sLog_Render("LOD SWAP: adopted " << timeframe_ms << "ms cells (" << m_visibleCells.size() << " prefetched)");
+    return true;
+}
+
+void DataProcessor::scheduleLodPrefetch() {
+    if (m_lodPrefetchQueued) return;
+    m_lodPrefetchQueued = true;
+    // Queued behind the active publish and any pending ingestion on this thread
+    QMetaObject::invokeMethod(this, [this]() {
+        m_lodPrefetchQueued = false;
+        prefetchNeighbourLods();
+    }, Qt::QueuedConnection);
+}
+
+void DataProcessor::prefetchNeighbourLods() {
+    if (m_shuttingDown.load() || !m_liquidityEngine || m_cellTimeframe_ms <= 0) return;
+
+    const int64_t coarser = m_lod.coarser();
+    const int64_t finer = m_lod.finer();
+    m_lodPrefetch.erase(std::remove_if(m_lodPrefetch.begin(), m_lodPrefetch.end(), [&](const LodCells& lod) {
+        return lod.timeframe_ms != coarser && lod.timeframe_ms != finer;
+    }), m_lodPrefetch.end());
+
+    for (int64_t timeframe : {coarser, finer}) {
+        if (timeframe <= 0 || timeframe == m_cellTimeframe_ms) continue;
+        auto it = std::find_if(m_lodPrefetch.begin(), m_lodPrefetch.end(),
+                               [timeframe](const LodCells& lod) { return lod.timeframe_ms == timeframe; });
+        if (it == m_lodPrefetch.end()) {
+            it = m_lodPrefetch.emplace(m_lodPrefetch.end());
+            it->timeframe_ms = timeframe;
+        }
+        LodCells& lod = *it;
+
+        // Cells are culled against m_cellCoverage: time-only growth appends, anything else starts over
+        const bool samePrices = lod.coverage.priceMin == m_cellCoverage.priceMin &&
+                                lod.coverage.priceMax == m_cellCoverage.priceMax;
+        if (!samePrices || !m_cellCoverage.contains(lod.coverage)) {
+            lod.cells.clear();
+            lod.processedTimeRanges.clear();
+            lod.lastProcessedTime = 0;
+        }
+        lod.coverage = m_cellCoverage;
+
+        const auto slices = m_liquidityEngine->getFinalizedSlices(timeframe, lod.coverage.timeStart_ms,
+                                                                  lod.coverage.timeEnd_ms);
+        const size_t processedSlices = appendSliceCells(slices, lod.cells, lod.processedTimeRanges);
+        for (const auto& slice : slices) {
+            lod.lastProcessedTime = std::max(lod.lastProcessedTime, slice->endTime_ms);
+        }
+        if (processedSlices > 0) {
+            sLog_RenderN(20, "LOD PREFETCH: " << timeframe << "ms +" << processedSlices << " slices, "
+                             << lod.cells.size() << " cells");
+        }
+    }
+}
+
+LiveColumn& DataProcessor::liveBackBuffer() {
+    // The renderer may still hold the previous publish; only a buffer nobody else references is reused
+    if (!m_liveBack || m_liveBack.use_count() != 1) {
+        m_liveBack = std::make_shared<LiveColumn>();
+    } else {
+        std::atomic_thread_fence(std::memory_order_acquire);  // Pairs with the release of the reader's last reference
+    }
+    return *m_liveBack;
+}
+
+void DataProcessor::updateLiveColumn(int64_t timeframe_ms) {
+    const LiquidityTimeSlice* slice = m_liquidityEngine->getCurrentSlice(timeframe_ms);
+    if (!slice && (!m_liveFront || m_liveFront->cells.empty())) return;
+    static thread_local std::vector<std::pair<Tick, bool>> changes;
+    const bool incremental = m_liquidityEngine->takeCurrentSliceChanges(timeframe_ms, changes);
+
+    const double resolution = m_liquidityEngine->getPriceResolution();
+    const int displayMode = getDisplayMode();
+    const LiveLayout layout{timeframe_ms, slice ? slice->startTime_ms : 0, slice ? slice->tickSize : 0.0,
+                            resolution, displayMode, m_cellCoverage};
+    // Slots are keyed by the engine's own bucket numbering, so a level maps to the same slot however it is reached
+    const auto slotKey = [](int64_t bucketIndex, bool isBid) { return bucketIndex * 2 + (isBid ? 1 : 0); };
+
+    const LiveColumn* front = m_liveFront.get();
+    LiveColumn& back = liveBackBuffer();
+    back.changedSlots.clear();
+
+    if (!incremental || !front || !(layout == m_liveLayout)) {
+        // New slice, grid, resolution, mode or coverage: lay the slots out again from the whole slice
+        back.cells.clear();
+        if (slice) createCellsFromLiquiditySlice(*slice, back.cells);
+        back.layoutRevision = (front ? front->layoutRevision : 0) + 1;
+        m_liveLayout = layout;
+        m_liveSlotOf.clear();
+        for (size_t i = 0; i < back.cells.size(); ++i) {
+            // Cells sit on their bucket centre, which is a whole tick of the slice
+            const CellInstance& cell = back.cells[i];
+            const Tick centre = slice->priceToTick((cell.priceMin + cell.priceMax) * 0.5);
+            m_liveSlotOf.emplace(slotKey(slice->bucketIndex(centre, resolution), cell.isBid), static_cast<uint32_t>(i));
+        }
+        m_liveSlotRevision.assign(back.cells.size(), 0);
+    } else {
+        // Bring the back buffer level with the front: replay the front's own patch when the back is exactly
+        // one publish behind it, otherwise (first reuse, or the renderer held it) copy the cells
+        if (back.layoutRevision == front->layoutRevision && back.revision + 1 == front->revision) {
+            back.cells.resize(front->cells.size());
+            for (const uint32_t slot : front->changedSlots) back.cells[slot] = front->cells[slot];
+        } else if (back.layoutRevision != front->layoutRevision || back.revision != front->revision) {
+            back.cells = front->cells;
+        }
+        back.layoutRevision = front->layoutRevision;
+
+        const uint64_t revision = front->revision + 1;
+        const auto markChanged = [&](uint32_t slot) {
+            if (m_liveSlotRevision[slot] == revision) return;
+            m_liveSlotRevision[slot] = revision;
+            back.changedSlots.push_back(slot);
+        };
+        static thread_local std::vector<CellInstance> patched;
+        LiquidityBucket bucket;
+        for (const auto& [tick, isBid] : changes) {
+            patched.clear();
+            const bool present = slice->bucketAt(tick, isBid, resolution, displayMode, bucket);
+            if (present) createLiquidityCell(*slice, bucket, patched);
+            if (patched.empty()) {
+                // Vanished or culled: the level keeps its slot at zero liquidity
+                const auto it = m_liveSlotOf.find(slotKey(slice->bucketIndex(tick, resolution), isBid));
+                if (it == m_liveSlotOf.end() || back.cells[it->second].liquidity == 0.0) continue;
+                back.cells[it->second].liquidity = 0.0;
+                back.cells[it->second].intensity = 0.0;
+                markChanged(it->second);
+                continue;
+            }
+            const CellInstance& cell = patched.front();
+            const auto [it, added] = m_liveSlotOf.emplace(slotKey(bucket.index, isBid), static_cast<uint32_t>(back.cells.size()));
+            if (added) {
+                back.cells.push_back(cell);
+                m_liveSlotRevision.push_back(0);
+            } else if (back.cells[it->second].liquidity == cell.liquidity) {
+                continue;
+            } else {
+                back.cells[it->second] = cell;
+            }
+            markChanged(it->second);
+        }
+        if (back.changedSlots.empty()) return;
+    }
+    back.revision = (front ? front->revision : 0) + 1;
+
+    std::swap(m_liveFront, m_liveBack);
+    {
+        std::lock_guard<std::mutex> snapLock(m_snapshotMutex);
+        m_publishedLiveColumn = m_liveFront;
+    }
+    emit liveColumnUpdated();
+}
+
+size_t DataProcessor::appendSliceCells(const std::vector<LiquidityTimeSlicePtr>& slices, std::vector<CellInstance>& cells,
+                                       ProcessedSlices& processed) {
+    static thread_local std::vector<const LiquidityTimeSlice*> pending;
+    static thread_local std::unordered_set<int64_t> restated;  // Starts of slices whose cells are replaced
+    pending.clear();
+    restated.clear();
+    for (const auto& slice : slices) {
+        const auto [it, added] = processed.try_emplace({slice->startTime_ms, slice->endTime_ms}, slice->revision);
+        if (!added) {
+            if (it->second == slice->revision) continue;
+            it->second = slice->revision;
+            restated.insert(slice->startTime_ms);
+        }
+        pending.push_back(slice.get());
+    }
+    if (!restated.empty()) {
+        std::erase_if(cells, [](const CellInstance& cell) { return restated.count(cell.timeStart_ms) > 0; });
+    }
+    for (const LiquidityTimeSlice* slice : pending) {
+        createCellsFromLiquiditySlice(*slice, cells);
+    }
+    return pending.size();
+}
+
+void DataProcessor::createCellsFromLiquiditySlice(const LiquidityTimeSlice& slice, std::vector<CellInstance>& out) {
     if (!m_viewState) return;
     
-    double minPrice = m_viewState->getMinPrice();
-    double maxPrice = m_viewState->getMaxPrice();
+    double minPrice = m_cellCoverage.priceMin;
+    double maxPrice = m_cellCoverage.priceMax;
     
     // Log slice processing details
     static int sliceCounter = 0;
@@ -561,49 +992,40 @@ void DataProcessor::createCellsFromLiquiditySlice(const LiquidityTimeSlice& slic
                     << " priceRange=$" << minPrice << "-$" << maxPrice);
     }
     
-    // Create cells for bid levels (tick-based iteration)
-    for (size_t i = 0; i < slice.bidMetrics.size(); ++i) {
-        const auto& metrics = slice.bidMetrics[i];
-        if (metrics.snapshotCount > 0) {
-            double price = slice.minTick * slice.tickSize + (static_cast<double>(i) * slice.tickSize);
-            if (price >= minPrice && price <= maxPrice) {
-                createLiquidityCell(slice, price, slice.getDisplayValue(price, true, 0), true);
-            }
-        }
-    }
-    
-    // Create cells for ask levels (tick-based iteration)
-    for (size_t i = 0; i < slice.askMetrics.size(); ++i) {
-        const auto& metrics = slice.askMetrics[i];
-        if (metrics.snapshotCount > 0) {
-            double price = slice.minTick * slice.tickSize + (static_cast<double>(i) * slice.tickSize);
-            if (price >= minPrice && price <= maxPrice) {
-                createLiquidityCell(slice, price, slice.getDisplayValue(price, false, 0), false);
-            }
-        }
+    // Stored at the engine's base tick; re-bucketed to the display resolution for the covered prices only
+    static thread_local std::vector<LiquidityBucket> buckets;
+    buckets.clear();
+    slice.collectBuckets(m_liquidityEngine ? m_liquidityEngine->getPriceResolution() : slice.tickSize,
+                         minPrice, maxPrice, getDisplayMode(), buckets);
+    for (const LiquidityBucket& bucket : buckets) {
+        createLiquidityCell(slice, bucket, out);
     }
 }
 
-void DataProcessor::createLiquidityCell(const LiquidityTimeSlice& slice, double price, double liquidity, bool isBid) {
+void DataProcessor::createLiquidityCell(const LiquidityTimeSlice& slice, const LiquidityBucket& bucket,
+                                        std::vector<CellInstance>& out) {
+    const double price = bucket.price;
+    const double liquidity = bucket.value;
+    const bool isBid = bucket.isBid;
     if (liquidity <= 0.0 || !m_viewState) return;
     
-    // World-space culling
-    if (price < m_viewState->getMinPrice() || price > m_viewState->getMaxPrice()) return;
-    if (slice.endTime_ms < m_viewState->getVisibleTimeStart() || slice.startTime_ms > m_viewState->getVisibleTimeEnd()) return;
+    // World-space culling against the covered region (a superset of the current viewport)
+    if (price < m_cellCoverage.priceMin || price > m_cellCoverage.priceMax) return;
+    if (slice.endTime_ms < m_cellCoverage.timeStart_ms || slice.startTime_ms > m_cellCoverage.timeEnd_ms) return;
 
     CellInstance cell;
     cell.timeStart_ms = slice.startTime_ms;
     cell.timeEnd_ms = (slice.endTime_ms > slice.startTime_ms) ? slice.endTime_ms : (slice.startTime_ms + std::max<int64_t>(m_currentTimeframe_ms, 1));
-    const double halfTick = slice.tickSize * 0.5;
-    cell.priceMin = price - halfTick;
-    cell.priceMax = price + halfTick;
+    const double halfBucket = bucket.size * 0.5;
+    cell.priceMin = price - halfBucket;
+    cell.priceMax = price + halfBucket;
     cell.liquidity = liquidity;
     cell.isBid = isBid;
     cell.intensity = std::min(1.0, liquidity / 1000.0);
     cell.color = isBid ? QColor(0, 255, 0, 128) : QColor(255, 0, 0, 128);
     cell.snapshotCount = slice.duration_ms > 0 ? static_cast<int>(slice.duration_ms / std::max<int64_t>(m_currentTimeframe_ms, 1)) : 1;
 
-    m_visibleCells.push_back(cell);
+    out.push_back(cell);
     
     if constexpr (kTraceCellDebug) {
         static int cellCounter = 0;
@@ -656,11 +1078,93 @@ QRectF DataProcessor::timeSliceToScreenRect(const LiquidityTimeSlice& slice, dou
     return result;
 }
 
+// Keeps exactly one bucket view (the storage grid) on the cache's books and releases the one it replaces
+void DataProcessor::holdBookBucketView(double bucketSize) {
+    if (m_dataCache && bucketSize > 0.0) m_dataCache->addBookBucketView(bucketSize);
+    if (m_dataCache && m_bookBucketView > 0.0) m_dataCache->removeBookBucketView(m_bookBucketView);
+    m_bookBucketView = m_dataCache ? bucketSize : 0.0;
+}
+
+void DataProcessor::setConsolidatedBook(bool enabled) {
+    if (enabled == m_useConsolidatedBook) return;
+    m_useConsolidatedBook = enabled;
+    m_consolidatedSeen = nullptr;
+    // History keeps the source it was sampled from; only new slices switch
+    sLog_App("DataProcessor: heatmap source" << (enabled ? "consolidated book" : "symbol book"));
+}
+
+bool DataProcessor::ingestConsolidated(const std::string& symbol) {
+    const ConsolidatedBook* book = m_feeds ? m_feeds->consolidated(symbol) : nullptr;
+    if (!book) return false;
+    const uint64_t version = book->version();
+    if (book == m_consolidatedSeen && version == m_consolidatedVersion) return true;  // Nothing new merged
+    m_consolidatedSeen = book;
+    m_consolidatedVersion = version;
+
+    constexpr size_t kMaxPerSide = 4000;
+    static thread_local std::vector<std::pair<uint32_t, double>> bidBuf;
+    static thread_local std::vector<std::pair<uint32_t, double>> askBuf;
+    book->topLevels(true, kMaxPerSide, bidBuf);
+    book->topLevels(false, kMaxPerSide, askBuf);
+    if (bidBuf.empty() && askBuf.empty()) return true;
+
+    const auto now = std::chrono::system_clock::now();
+    if (!bidBuf.empty() && !askBuf.empty()) {
+        const int64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count();
+        m_orderFlowEngine->onTopOfBook(symbol, now_ms, bidBuf.front().second, askBuf.front().second);
+    }
+    LiveOrderBook::DenseBookSnapshotView view;
+    view.minPrice = book->minPrice();
+    view.tickSize = book->tickSize();
+    view.timestamp = now;
+    view.bidLevels = bidBuf;
+    view.askLevels = askBuf;
+    m_liquidityEngine->addDenseSnapshot(view);
+    m_footprintEngine->setTickSize(symbol, book->tickSize());
+    m_tradeDensityEngine->setTickSize(symbol, book->tickSize());
+    {
+        std::lock_guard<std::mutex> lock(m_dataMutex);
+        if (m_activeSymbol.empty()) m_activeSymbol = symbol;
+        m_hasValidOrderBook = true;
+    }
+    updateVisibleCells();
+    return true;
+}
+
+void DataProcessor::setDataCache(DataCache* cache) {
+    if (m_dataCache && m_bookBucketView > 0.0) m_dataCache->removeBookBucketView(m_bookBucketView);
+    m_bookBucketView = 0.0;
+    m_dataCache = cache;
+    if (m_liquidityEngine) holdBookBucketView(m_liquidityEngine->getBaseTickSize());
+    std::string chartSymbol;
+    {
+        std::lock_guard<std::mutex> lock(m_dataMutex);
+        chartSymbol = m_chartSymbol;
+    }
+    if (m_dataCache && !chartSymbol.empty()) {
+        m_dataCache->setPrimaryBookSymbol(chartSymbol);
+    }
+}
+
 void DataProcessor::setPriceResolution(double resolution) {
-    if (m_liquidityEngine && resolution > 0) {
-        m_liquidityEngine->setPriceResolution(resolution);
-        emit dataUpdated();
+    if (!m_liquidityEngine || resolution <= 0 || resolution == m_liquidityEngine->getPriceResolution()) return;
+
+    const double baseTick = m_liquidityEngine->getBaseTickSize();
+    m_liquidityEngine->setPriceResolution(resolution);
+    // Keep a bucket view at the storage grid on every book so ingestion skips per-level quantization
+    if (m_liquidityEngine->getBaseTickSize() != baseTick) {
+        holdBookBucketView(m_liquidityEngine->getBaseTickSize());
     }
+
+    // History is re-bucketed on read: rebuild the cached cells across the whole covered range now
+    m_visibleCells.clear();
+    m_processedTimeRanges.clear();
+    m_lastProcessedTime = 0;
+    m_lodPrefetch.clear();
+    m_previousModeCells = {};
+    m_previousDisplayMode = -1;
+    updateVisibleCells();
+    emit dataUpdated();
 }
 
 double DataProcessor::getPriceResolution() const {
@@ -677,28 +1181,154 @@ int64_t DataProcessor::suggestTimeframe(qint64 timeStart, qint64 timeEnd, int ma
     return m_liquidityEngine ? m_liquidityEngine->suggestTimeframe(timeStart, timeEnd, maxCells) : 100;
 }
 
-std::vector<LiquidityTimeSlice> DataProcessor::getVisibleSlices(qint64 timeStart, qint64 timeEnd, double minPrice, double maxPrice) const {
-    if (m_liquidityEngine) {
-        auto slicePtrs = m_liquidityEngine->getVisibleSlices(m_currentTimeframe_ms, timeStart, timeEnd);
-        std::vector<LiquidityTimeSlice> slices;
-        slices.reserve(slicePtrs.size());
-        for (const auto* ptr : slicePtrs) {
-            if (ptr) slices.push_back(*ptr);
+void DataProcessor::setChartSymbol(const QString& symbol) {
+    {
+        std::lock_guard<std::mutex> lock(m_dataMutex);
+        m_chartSymbol = symbol.toStdString();
+        if (!m_chartSymbol.empty()) {
+            m_activeSymbol = m_chartSymbol;
         }
-        return slices;
     }
-    return {};
+    // Only the charted book keeps full depth; grid tiles and venue books shrink to a window around the mid
+    if (m_dataCache) {
+        m_dataCache->setPrimaryBookSymbol(symbol.toStdString());
+    }
+    sLog_App("DataProcessor: chart symbol" << (symbol.isEmpty() ? QStringLiteral("<any>") : symbol));
 }
 
 int DataProcessor::getDisplayMode() const {
     return m_liquidityEngine ? static_cast<int>(m_liquidityEngine->getDisplayMode()) : 0;
 }
 
+void DataProcessor::setDisplayMode(int mode) {
+    if (!m_liquidityEngine || mode == getDisplayMode()) return;
+    const int previousMode = getDisplayMode();
+    m_liquidityEngine->setDisplayMode(static_cast<LiquidityTimeSeriesEngine::LiquidityDisplayMode>(mode));
+
+    // Cells hold one aggregation: take back the ones built for this mode if they still cover the
+    // active region, otherwise rebuild; the outgoing mode's cells are kept for the next toggle
+    LodCells outgoing{m_cellTimeframe_ms, m_cellCoverage, std::move(m_visibleCells),
+                      std::move(m_processedTimeRanges), m_lastProcessedTime};
+    if (m_previousDisplayMode == mode && m_previousModeCells.timeframe_ms == m_cellTimeframe_ms &&
+        m_previousModeCells.coverage.contains(m_cellCoverage)) {
+        m_cellCoverage = m_previousModeCells.coverage;
+        m_visibleCells = std::move(m_previousModeCells.cells);
+        m_processedTimeRanges = std::move(m_previousModeCells.processedTimeRanges);
+        m_lastProcessedTime = m_previousModeCells.lastProcessedTime;
+        sLog_Render("DISPLAY MODE: reused " << m_visibleCells.size() << " cells for mode " << mode);
+    } else {
+        m_visibleCells.clear();
+        m_processedTimeRanges.clear();
+        m_lastProcessedTime = 0;
+    }
+    m_previousModeCells = std::move(outgoing);
+    m_previousDisplayMode = previousMode;
+    m_lodPrefetch.clear();  // Neighbours were built for the previous mode
+    publishCells();         // Replace the old mode's cells even when nothing new gets appended below
+    updateVisibleCells();
+}
+
+void DataProcessor::copyOrderFlowBars(int64_t timeframe_ms, int64_t timeStart, int64_t timeEnd,
+                                      std::vector<OrderFlowBar>& out) const {
+    std::string symbol;
+    {
+        std::lock_guard<std::mutex> lock(m_dataMutex);
+        symbol = m_activeSymbol;
+    }
+    if (symbol.empty() || !m_orderFlowEngine) {
+        out.clear();
+        return;
+    }
+    m_orderFlowEngine->copyBars(symbol, m_orderFlowEngine->nearestTimeframe(timeframe_ms),
+                                timeStart, timeEnd, out);
+}
+
+std::string DataProcessor::getActiveSymbol() const {
+    std::lock_guard<std::mutex> lock(m_dataMutex);
+    return m_activeSymbol;
+}
+
+void DataProcessor::copyFootprintCells(const std::string& symbol, int64_t timeframe_ms, int64_t timeStart, int64_t timeEnd,
+                                       double minPrice, double maxPrice, int ticksPerRow,
+                                       std::vector<FootprintCell>& out) const {
+    if (symbol.empty() || !m_footprintEngine) {
+        out.clear();
+        return;
+    }
+    m_footprintEngine->copyCells(symbol, m_footprintEngine->nearestTimeframe(timeframe_ms),
+                                 timeStart, timeEnd, minPrice, maxPrice, ticksPerRow, out);
+}
+
+void DataProcessor::copyTradeDensityCells(const std::string& symbol, int64_t timeframe_ms, int64_t timeStart, int64_t timeEnd,
+                                          double minPrice, double maxPrice, int ticksPerRow,
+                                          std::vector<FootprintCell>& out) const {
+    if (symbol.empty() || !m_tradeDensityEngine) {
+        out.clear();
+        return;
+    }
+    m_tradeDensityEngine->copyCells(symbol, m_tradeDensityEngine->nearestTimeframe(timeframe_ms),
+                                    timeStart, timeEnd, minPrice, maxPrice, ticksPerRow, out);
+}
+
+void DataProcessor::copyIcebergEvents(int64_t timeStart, int64_t timeEnd,
+                                      std::vector<IcebergEvent>& out) const {
+    std::string symbol;
+    {
+        std::lock_guard<std::mutex> lock(m_dataMutex);
+        symbol = m_activeSymbol;
+    }
+    if (symbol.empty() || !m_icebergDetector) {
+        out.clear();
+        return;
+    }
+    m_icebergDetector->copyEvents(symbol, timeStart, timeEnd, out);
+}
+
+void DataProcessor::copyDepthCurve(double priceMin, double priceMax, int samples, DepthCurve& out) const {
+    std::string symbol;
+    {
+        std::lock_guard<std::mutex> lock(m_dataMutex);
+        symbol = m_activeSymbol;
+    }
+    out.priceMin = priceMin;
+    out.priceMax = priceMax;
+    if (symbol.empty() || !m_dataCache || samples <= 0 || priceMax <= priceMin) {
+        out.bidCumulative.clear();
+        out.askCumulative.clear();
+        return;
+    }
+    const LiveOrderBook& book = m_dataCache->getDirectLiveOrderBook(symbol);
+    if (book.isStale()) {
+        out.bidCumulative.clear();
+        out.askCumulative.clear();
+        return;
+    }
+    // O(samples · log ticks) through the book's Fenwick index, under one book lock
+    book.sampleCumulativeDepth(priceMin, priceMax, static_cast<size_t>(samples), out.bidCumulative, out.askCumulative);
+}
+
+bool DataProcessor::getPullStats(PullStats& out) const {
+    std::string symbol;
+    {
+        std::lock_guard<std::mutex> lock(m_dataMutex);
+        symbol = m_activeSymbol;
+    }
+    return !symbol.empty() && m_pullEngine && m_pullEngine->getStats(symbol, out);
+}
+
+void DataProcessor::publishIcebergEvent(const std::string& symbol) {
+    IcebergEvent ev;
+    if (!m_icebergDetector->lastEvent(symbol, ev)) return;
+    sLog_Data("DataProcessor ICEBERG:" << QString::fromStdString(symbol) << (ev.isBid ? "bid" : "ask")
+              << "$" << ev.price << "refills:" << ev.refillCount << "hidden:" << ev.hiddenEstimate);
+    emit icebergDetected(QString::fromStdString(symbol), ev.price, ev.isBid,
+                         ev.hiddenEstimate, static_cast<int>(ev.refillCount));
+}
+
 void DataProcessor::setTimeframe(int timeframe_ms) {
     if (timeframe_ms > 0) {
         m_currentTimeframe_ms = timeframe_ms;
-        m_manualTimeframeSet = true;
-        m_manualTimeframeTimer.restart();
+        m_lod.setManual(timeframe_ms);
         
         if (m_liquidityEngine) {
             m_liquidityEngine->addTimeframe(timeframe_ms);
@@ -710,5 +1340,5 @@ void DataProcessor::setTimeframe(int timeframe_ms) {
 }
 
 bool DataProcessor::isManualTimeframeSet() const {
-    return m_manualTimeframeSet;
+    return m_lod.isManual();
 }
@@ -3,7 +3,8 @@ Sentinel — DataProcessor
 Role: Decouples data processing from rendering by processing market data on a background thread.
 Inputs/Outputs: Takes Trade/OrderBook data via slots; emits dataUpdated() when processing is done.
 Threading: Lives and operates on a dedicated QThread; receives data from main and signals back.
-Performance: Uses a queue and a timer-driven loop to batch-process data efficiently.
+Performance: Uses a queue and a timer-driven loop to batch-process data efficiently; cells for the neighbouring
+             timeframes are prefetched so a LOD switch swaps them in instead of rebuilding.
 Integration: Owned by UnifiedGridRenderer; uses LiquidityTimeSeriesEngine for data aggregation.
 Observability: Logs thread status and processing batches via sLog_Render.
 Related: DataProcessor.cpp, UnifiedGridRenderer.h, LiquidityTimeSeriesEngine.h, GridViewState.hpp.
@@ -19,13 +20,23 @@ Assumptions: Dependencies (GridViewState, LiquidityTimeSeriesEngine) are set bef
 #include <memory>
 #include <vector>
 #include <chrono>
+#include <optional>
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
 #include "../../core/marketdata/model/TradeData.h"
 #include "../../core/LiquidityTimeSeriesEngine.h"
+#include "../../core/OrderFlowEngine.h"
+#include "../../core/FootprintEngine.h"
+#include "../../core/IcebergDetector.h"
+#include "../../core/LiquidityPullEngine.h"
+#include "../../core/TimeframeLodController.h"
 #include "GridTypes.hpp"
 
 class GridViewState;
 class DataCache;
+class FeedAggregator;
+class ConsolidatedBook;
 
 class DataProcessor : public QObject {
     Q_OBJECT
@@ -38,16 +49,35 @@ public slots:
     // Data ingestion (slots for cross-thread invocation)
     void onTradeReceived(const Trade& trade);
     void onOrderBookUpdated(std::shared_ptr<const OrderBook> orderBook);
-    void onLiveOrderBookUpdated(const QString& productId, const std::vector<BookDelta>& deltas);  // Dense LiveOrderBook signal handler
+    void onLiveOrderBookUpdated(const QString& productId, const std::vector<BookDelta>& deltas,
+                                const BookGrid& grid);  // Dense LiveOrderBook signal handler; grid = the batch's stamp
     
     // Move updateVisibleCells to slots for cross-thread calls
     void updateVisibleCells();
+    
+    // Pins the heatmap to one symbol when several books are streamed (empty = follow the latest book)
+    void setChartSymbol(const QString& symbol);
+    
+    // Region a pan is about to expose; grows the cell coverage ahead of the committed viewport
+    void prefetchRegion(qint64 timeStart, qint64 timeEnd, double priceMin, double priceMax);
 
 public:
     
     // Configuration
     void setGridViewState(GridViewState* viewState) { m_viewState = viewState; }
-    void setDataCache(DataCache* cache) { m_dataCache = cache; }
+    // Also registers a bucket view at the engine's base tick on the cache's books
+    void setDataCache(DataCache* cache);
+    // Heatmap source for the charted symbol: its own book (default) or the cross-venue ConsolidatedBook
+    // (FeedAggregator::consolidated), re-sampled whenever any venue's book for the symbol changes.
+    // Iceberg and pull detection stay on the symbol's own book either way.
+    void setFeedAggregator(const FeedAggregator* feeds) { m_feeds = feeds; }
+    void setConsolidatedBook(bool enabled);
+    // Warm restart: restores the checkpoint at path now, then rewrites it periodically and on stop (empty = off).
+    // Heatmap history and trades come back; books only with restoreBooks, and stay stale until their live snapshot.
+    // Call on the processor thread after setDataCache().
+    void setCheckpointPath(const QString& path, bool restoreBooks = false);
+    // Captures on the processor thread and encodes/writes on a worker; skipped while the previous write runs
+    void writeCheckpoint();
     
     // Trade batching configuration
     void setTradeBatchInterval(std::chrono::milliseconds interval) { m_tradeBatchConfig.batchInterval = interval; }
@@ -67,16 +97,50 @@ public:
     void startProcessing();
     void stopProcessing();
     
-    void createCellsFromLiquiditySlice(const struct LiquidityTimeSlice& slice);
-    void createLiquidityCell(const struct LiquidityTimeSlice& slice, double price, double liquidity, bool isBid);
+    void createCellsFromLiquiditySlice(const struct LiquidityTimeSlice& slice, std::vector<struct CellInstance>& out);
+    void createLiquidityCell(const struct LiquidityTimeSlice& slice, const struct LiquidityBucket& bucket,
+                             std::vector<struct CellInstance>& out);
+    // Patches the live column from the levels the current slice changed since the last call; publishes only on change
+    void updateLiveColumn(int64_t timeframe_ms);
     QRectF timeSliceToScreenRect(const struct LiquidityTimeSlice& slice, double price) const;
     
     void setPriceResolution(double resolution);
     double getPriceResolution() const;
     void addTimeframe(int timeframe_ms);
     int64_t suggestTimeframe(qint64 timeStart, qint64 timeEnd, int maxCells) const;
-    std::vector<struct LiquidityTimeSlice> getVisibleSlices(qint64 timeStart, qint64 timeEnd, double minPrice, double maxPrice) const;
     int getDisplayMode() const;
+    void setDisplayMode(int mode);
+    
+    // Order-flow analytics (CVD/imbalance) for the active symbol; safe from the render thread
+    OrderFlowEngine* getOrderFlowEngine() const { return m_orderFlowEngine.get(); }
+    void copyOrderFlowBars(int64_t timeframe_ms, int64_t timeStart, int64_t timeEnd,
+                           std::vector<OrderFlowBar>& out) const;
+    
+    // Symbol of the book driving the chart; the only one fed to the footprint and density engines
+    std::string getActiveSymbol() const;
+    
+    // Footprint (bid x ask per bar/price row) of `symbol`, which callers pair with its engine version; safe from the render thread
+    FootprintEngine* getFootprintEngine() const { return m_footprintEngine.get(); }
+    void copyFootprintCells(const std::string& symbol, int64_t timeframe_ms, int64_t timeStart, int64_t timeEnd,
+                            double minPrice, double maxPrice, int ticksPerRow,
+                            std::vector<FootprintCell>& out) const;
+    
+    // Session-length trade density bins (buy/sell volume per time bucket x price tick); safe from the render thread
+    FootprintEngine* getTradeDensityEngine() const { return m_tradeDensityEngine.get(); }
+    void copyTradeDensityCells(const std::string& symbol, int64_t timeframe_ms, int64_t timeStart, int64_t timeEnd,
+                               double minPrice, double maxPrice, int ticksPerRow,
+                               std::vector<FootprintCell>& out) const;
+    
+    // Suspected iceberg levels for the active symbol; safe from the render thread
+    IcebergDetector* getIcebergDetector() const { return m_icebergDetector.get(); }
+    void copyIcebergEvents(int64_t timeStart, int64_t timeEnd, std::vector<IcebergEvent>& out) const;
+    
+    // Cumulative depth of the active symbol's live book at `samples` prices; safe from the render thread
+    void copyDepthCurve(double priceMin, double priceMax, int samples, DepthCurve& out) const;
+    
+    // Add/cancel/fill attribution near the touch for the active symbol; safe from any thread
+    LiquidityPullEngine* getPullEngine() const { return m_pullEngine.get(); }
+    bool getPullStats(PullStats& out) const;
 
     // Band-based ingestion configuration
     enum class BandMode { FixedDollar, PercentMid, Ticks };
@@ -89,15 +153,25 @@ public:
     bool isManualTimeframeSet() const;
     
     const std::vector<struct CellInstance>& getVisibleCells() const { return m_visibleCells; }
-    // Thread-safe snapshot access for renderer (swap-only on render thread)
-    std::shared_ptr<const std::vector<struct CellInstance>> getPublishedCellsSnapshot() const {
+    // Thread-safe snapshot access for renderer (swap-only on render thread).
+    // coverage receives the world region the cells were generated for (width/height unset).
+    std::shared_ptr<const std::vector<struct CellInstance>> getPublishedCellsSnapshot(Viewport* coverage = nullptr) const {
         std::lock_guard<std::mutex> lock(m_snapshotMutex);
+        if (coverage) *coverage = m_publishedCoverage;
         return m_publishedCells;
     }
+    // Still-building column, republished on every snapshot that changes a level
+    std::shared_ptr<const LiveColumn> getPublishedLiveColumn() const {
+        std::lock_guard<std::mutex> lock(m_snapshotMutex);
+        return m_publishedLiveColumn;
+    }
 
 signals:
     void dataUpdated();
+    void liveColumnUpdated();
     void viewportInitialized();
+    void icebergDetected(const QString& productId, double price, bool isBid,
+                         double hiddenEstimate, int refillCount);
 
 private slots:
     void captureOrderBookSnapshot();
@@ -110,11 +184,29 @@ private:
     void processSignificantTrades();
     bool isSignificantTrade(const Trade& trade, double midPrice) const;
     double calculateMidPrice() const;
+    void publishIcebergEvent(const std::string& symbol);
+    void restoreCheckpoint(bool restoreBooks);
+    void writeFinalCheckpoint();
     
     // Components
     GridViewState* m_viewState = nullptr;
     LiquidityTimeSeriesEngine* m_liquidityEngine = nullptr;
+    std::unique_ptr<OrderFlowEngine> m_orderFlowEngine;
+    std::unique_ptr<FootprintEngine> m_footprintEngine;
+    std::unique_ptr<FootprintEngine> m_tradeDensityEngine;  // Coarse, long-retention rings for the TradeFlow layer
+    std::unique_ptr<IcebergDetector> m_icebergDetector;
+    std::unique_ptr<LiquidityPullEngine> m_pullEngine;
     DataCache* m_dataCache = nullptr;
+    const FeedAggregator* m_feeds = nullptr;
+    bool m_useConsolidatedBook = false;                    // Processor thread only
+    const ConsolidatedBook* m_consolidatedSeen = nullptr;  // Book and version last ingested
+    uint64_t m_consolidatedVersion = 0;
+    // False when the symbol has no consolidated book yet (the caller falls back to its own book)
+    bool ingestConsolidated(const std::string& symbol);
+    double m_bookBucketView = 0.0;  // Bucket size this processor holds on m_dataCache's books; 0 = none
+    void holdBookBucketView(double bucketSize);
+    std::string m_activeSymbol;  // Symbol of the book driving the heatmap (guarded by m_dataMutex)
+    std::string m_chartSymbol;   // Optional filter; other symbols' books are ignored (guarded by m_dataMutex)
     
     // Data state
     std::shared_ptr<const OrderBook> m_latestOrderBook;
@@ -124,9 +216,15 @@ private:
     QTimer* m_snapshotTimer = nullptr;
     mutable std::mutex m_dataMutex;
     
-    // Manual timeframe management
-    bool m_manualTimeframeSet = false;
-    QElapsedTimer m_manualTimeframeTimer;
+    // Session checkpoint (processor thread only)
+    static constexpr int kCheckpointIntervalMs = 30000;
+    QTimer* m_checkpointTimer = nullptr;
+    std::string m_checkpointPath;
+    std::thread m_checkpointWriter;              // Encodes and writes one captured Snapshot
+    std::atomic<bool> m_checkpointWriting{false};
+    
+    // Timeframe (level of detail) selection; also holds the manual override
+    TimeframeLodController m_lod;
     int64_t m_currentTimeframe_ms = 100;
     
     std::vector<struct CellInstance> m_visibleCells;
@@ -134,6 +232,12 @@ private:
     // Renderer handoff buffer: atomically swapped shared_ptr to avoid copies
     mutable std::mutex m_snapshotMutex;
     std::shared_ptr<const std::vector<struct CellInstance>> m_publishedCells;
+    Viewport m_publishedCoverage;  // Coverage m_publishedCells was built over
+    std::shared_ptr<const LiveColumn> m_publishedLiveColumn;
+    // Live column double buffer (processor thread): the front is the published column; the back is rewritten
+    // in place once the renderer has let go of it, so a publish copies only the slots that changed
+    std::shared_ptr<LiveColumn> m_liveFront;
+    std::shared_ptr<LiveColumn> m_liveBack;
     
     // Dynamic price resolution
     double m_priceResolution = 1.0;
@@ -152,7 +256,57 @@ private:
     int64_t m_lastProcessedTime = 0;
     uint64_t m_lastViewportVersion = 0;
 
-    // Track processed slices by time range (slices are reused in memory, so can't use pointers)
+    // World region (and timeframe) the current cells were generated for; viewports inside it reuse them
+    struct CellCoverage {
+        int64_t timeStart_ms = 0;
+        int64_t timeEnd_ms = 0;
+        double priceMin = 0.0;
+        double priceMax = 0.0;
+
+        bool contains(const CellCoverage& other) const {
+            return other.timeStart_ms >= timeStart_ms && other.timeEnd_ms <= timeEnd_ms &&
+                   other.priceMin >= priceMin && other.priceMax <= priceMax;
+        }
+        CellCoverage united(const CellCoverage& other) const {
+            return {std::min(timeStart_ms, other.timeStart_ms), std::max(timeEnd_ms, other.timeEnd_ms),
+                    std::min(priceMin, other.priceMin), std::max(priceMax, other.priceMax)};
+        }
+    };
+    // Cells are generated this far beyond the requested region so a pan reveals pre-built geometry
+    static constexpr double kCoverageTimeMargin = 0.5;   // Share of the viewport span, each side
+    static constexpr double kCoveragePriceMargin = 0.25;
+    // Time-only growth keeps existing cells until the coverage spans this many viewports
+    static constexpr double kMaxCoverageSpans = 6.0;
+    CellCoverage m_cellCoverage;
+    std::optional<CellCoverage> m_pendingPrefetch;  // Set by prefetchRegion(), consumed by updateVisibleCells()
+    CellCoverage withMargin(const CellCoverage& region, const CellCoverage& viewport) const;
+    // Grows m_cellCoverage in time to hold region; false when the price range or total span needs a rebuild
+    bool extendCoverage(const CellCoverage& region, const CellCoverage& viewport);
+    void publishCells();
+    int64_t m_cellTimeframe_ms = 0;
+
+    // What the live column's slots were laid out for; any difference re-reads the whole slice
+    struct LiveLayout {
+        int64_t timeframe_ms = 0;
+        int64_t sliceStart_ms = 0;
+        double tickSize = 0.0;
+        double resolution = 0.0;
+        int displayMode = 0;
+        CellCoverage coverage;
+        bool operator==(const LiveLayout& o) const {
+            return timeframe_ms == o.timeframe_ms && sliceStart_ms == o.sliceStart_ms && tickSize == o.tickSize &&
+                   resolution == o.resolution && displayMode == o.displayMode &&
+                   coverage.timeStart_ms == o.coverage.timeStart_ms && coverage.timeEnd_ms == o.coverage.timeEnd_ms &&
+                   coverage.priceMin == o.coverage.priceMin && coverage.priceMax == o.coverage.priceMax;
+        }
+    };
+    LiveLayout m_liveLayout;
+    std::unordered_map<int64_t, uint32_t> m_liveSlotOf;  // (bucket index, side) → slot in the live column
+    std::vector<uint64_t> m_liveSlotRevision;            // Revision that last listed each slot in changedSlots
+    LiveColumn& liveBackBuffer();
+
+    // Track processed slices by time range and the slice revision their cells were built from. Not by handle:
+    // a late pull may republish a slice as a new object or, when nobody holds it, change it in place.
     struct SliceTimeRange {
         int64_t startTime;
         int64_t endTime;
@@ -168,7 +322,30 @@ private:
         }
     };
 
-    std::unordered_set<SliceTimeRange, SliceTimeRangeHash> m_processedTimeRanges;
+    using ProcessedSlices = std::unordered_map<SliceTimeRange, uint64_t, SliceTimeRangeHash>;
+    ProcessedSlices m_processedTimeRanges;
+    // Appends cells for slices not yet in processed and replaces those of slices whose revision moved
+    // (cells of one timeframe are keyed by slice start). Returns the number of slices (re)built.
+    size_t appendSliceCells(const std::vector<LiquidityTimeSlicePtr>& slices, std::vector<struct CellInstance>& cells,
+                            ProcessedSlices& processed);
+
+    // Cells for a timeframe adjacent to the active one, built over the same coverage so a LOD switch is a swap
+    struct LodCells {
+        int64_t timeframe_ms = 0;
+        CellCoverage coverage;
+        std::vector<struct CellInstance> cells;
+        ProcessedSlices processedTimeRanges;
+        int64_t lastProcessedTime = 0;
+    };
+    std::vector<LodCells> m_lodPrefetch;  // At most the coarser and the finer neighbour
+    bool m_lodPrefetchQueued = false;
+    // Swaps in a prefetched neighbour covering region; the previous active cells become a neighbour
+    bool adoptPrefetchedLod(int64_t timeframe_ms, const CellCoverage& region);
+    // Active cells of the display mode last switched away from, so toggling back is a swap, not a rebuild
+    LodCells m_previousModeCells;
+    int m_previousDisplayMode = -1;
+    void scheduleLodPrefetch();
+    void prefetchNeighbourLods();
 
     // Trade batching configuration and state
     struct TradeBatchConfig {
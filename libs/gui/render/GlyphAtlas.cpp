@@ -0,0 +1,139 @@
+/*
+Sentinel — GlyphAtlas
+Role: Implements atlas rasterization via QPainter and textured-quad label geometry.
+Inputs/Outputs: QImage atlas → QSGTexture; queued labels → one QSGGeometryNode.
+Threading: buildTextNode()/texture() run on the Qt Quick render thread.
+Performance: Glyph lookup is a flat array indexed by ASCII code.
+Integration: See GlyphAtlas.hpp.
+Observability: No internal logging.
+Related: GlyphAtlas.hpp.
+Assumptions: Only ASCII characters from the charset are drawable; others are skipped.
+*/
+#include "GlyphAtlas.hpp"
+#include <QFont>
+#include <QFontMetricsF>
+#include <QPainter>
+#include <QQuickWindow>
+#include <QSGGeometry>
+#include <QSGGeometryNode>
+#include <QSGTexture>
+#include <QSGTextureMaterial>
+#include <cmath>
+
+GlyphAtlas::GlyphAtlas(const QString& charset, int pixelSize) {
+    QFont font(QStringLiteral("monospace"));
+    font.setStyleHint(QFont::Monospace);
+    font.setPixelSize(pixelSize);
+    QFontMetricsF metrics(font);
+    
+    m_glyphHeight = static_cast<float>(std::ceil(metrics.height()));
+    const int cellW = static_cast<int>(std::ceil(metrics.maxWidth())) + 2;  // 1px padding each side
+    const int cellH = static_cast<int>(m_glyphHeight) + 2;
+    const int atlasW = cellW * static_cast<int>(charset.size());
+    
+    m_image = QImage(std::max(1, atlasW), cellH, QImage::Format_ARGB32_Premultiplied);
+    m_image.fill(Qt::transparent);
+    
+    QPainter painter(&m_image);
+    painter.setFont(font);
+    painter.setPen(Qt::white);
+    for (int i = 0; i < charset.size(); ++i) {
+        const QChar c = charset.at(i);
+        const ushort code = c.unicode();
+        if (code >= m_glyphs.size()) continue;
+        
+        const int x = i * cellW + 1;
+        painter.drawText(QPointF(x, 1 + metrics.ascent()), QString(c));
+        
+        Glyph& g = m_glyphs[code];
+        g.width = static_cast<float>(metrics.horizontalAdvance(c));
+        g.uv = QRectF(static_cast<double>(x) / m_image.width(), 1.0 / m_image.height(),
+                      g.width / m_image.width(), m_glyphHeight / m_image.height());
+        g.valid = true;
+    }
+    painter.end();
+}
+
+GlyphAtlas::~GlyphAtlas() {
+    // Textures belong to the render thread; let Qt dispose of it there
+    if (m_texture) {
+        m_texture->deleteLater();
+    }
+}
+
+const GlyphAtlas::Glyph& GlyphAtlas::glyph(QChar c) const {
+    static const Glyph kInvalid{};
+    const ushort code = c.unicode();
+    return code < m_glyphs.size() ? m_glyphs[code] : kInvalid;
+}
+
+float GlyphAtlas::textWidth(const QString& text) const {
+    float width = 0.0f;
+    for (QChar c : text) {
+        const Glyph& g = glyph(c);
+        if (g.valid) width += g.width;
+    }
+    return width;
+}
+
+QSGTexture* GlyphAtlas::texture(QQuickWindow* window) {
+    if (!window) return nullptr;
+    if (m_texture && m_textureWindow == window) return m_texture;
+    
+    if (m_texture) {
+        m_texture->deleteLater();
+    }
+    m_texture = window->createTextureFromImage(m_image);
+    m_textureWindow = window;
+    if (m_texture) {
+        m_texture->setFiltering(QSGTexture::Nearest);
+    }
+    return m_texture;
+}
+
+void GlyphAtlas::addText(const QString& text, float x, float y) {
+    float penX = x;
+    for (QChar c : text) {
+        const Glyph& g = glyph(c);
+        if (!g.valid) continue;
+        m_pendingQuads.push_back({penX, y, g.width, m_glyphHeight, g.uv});
+        penX += g.width;
+    }
+}
+
+QSGGeometryNode* GlyphAtlas::buildTextNode(QQuickWindow* window) {
+    if (m_pendingQuads.empty()) return nullptr;
+    QSGTexture* tex = texture(window);
+    if (!tex) return nullptr;
+    
+    auto* node = new QSGGeometryNode;
+    auto* material = new QSGTextureMaterial;
+    material->setTexture(tex);
+    material->setFiltering(QSGTexture::Nearest);
+    node->setMaterial(material);
+    node->setFlag(QSGNode::OwnsMaterial);
+    
+    const int vertexCount = static_cast<int>(m_pendingQuads.size()) * 6;
+    auto* geometry = new QSGGeometry(QSGGeometry::defaultAttributes_TexturedPoint2D(), vertexCount);
+    geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+    node->setGeometry(geometry);
+    node->setFlag(QSGNode::OwnsGeometry);
+    
+    auto* v = static_cast<QSGGeometry::TexturedPoint2D*>(geometry->vertexData());
+    int i = 0;
+    for (const Quad& q : m_pendingQuads) {
+        const float l = q.x, t = q.y, r = q.x + q.w, b = q.y + q.h;
+        const float u0 = static_cast<float>(q.uv.left()), v0 = static_cast<float>(q.uv.top());
+        const float u1 = static_cast<float>(q.uv.right()), v1 = static_cast<float>(q.uv.bottom());
+        v[i++].set(l, t, u0, v0);
+        v[i++].set(r, t, u1, v0);
+        v[i++].set(l, b, u0, v1);
+        v[i++].set(r, t, u1, v0);
+        v[i++].set(r, b, u1, v1);
+        v[i++].set(l, b, u0, v1);
+    }
+    m_pendingQuads.clear();
+    
+    node->markDirty(QSGNode::DirtyGeometry | QSGNode::DirtyMaterial);
+    return node;
+}
@@ -0,0 +1,58 @@
+/*
+Sentinel — GlyphAtlas
+Role: Rasterizes a small fixed character set once and serves it as a scene-graph texture for numeric labels.
+Inputs/Outputs: Takes a charset + pixel size; provides per-glyph texture rects and advances, and a QSGTexture.
+Threading: The image is built on first use; the texture is created and used on the Qt Quick render thread.
+Performance: One texture upload per window; labels become textured quads in a single geometry node.
+Integration: Used by strategies that draw text (e.g. FootprintStrategy) without QQuickText items.
+Observability: No internal logging.
+Related: GlyphAtlas.cpp, FootprintStrategy.hpp.
+Assumptions: Glyphs are drawn white; tinting is left to the material/opacity.
+*/
+#pragma once
+#include <QImage>
+#include <QRectF>
+#include <QString>
+#include <array>
+#include <vector>
+
+class QQuickWindow;
+class QSGTexture;
+class QSGGeometryNode;
+
+class GlyphAtlas {
+public:
+    explicit GlyphAtlas(const QString& charset = QStringLiteral("0123456789.-kM"), int pixelSize = 10);
+    ~GlyphAtlas();
+    
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+    
+    struct Glyph {
+        QRectF uv;          // Normalized texture rect
+        float width = 0.0f; // Pixel advance
+        bool valid = false;
+    };
+    
+    const Glyph& glyph(QChar c) const;
+    float textWidth(const QString& text) const;
+    float glyphHeight() const { return m_glyphHeight; }
+    
+    // Lazily uploads the atlas for the given window (render thread only)
+    QSGTexture* texture(QQuickWindow* window);
+    
+    // Builds a textured-quad node for labels queued with addText(); nullptr when empty
+    void beginText() { m_pendingQuads.clear(); }
+    void addText(const QString& text, float x, float y);  // (x, y) = top-left
+    QSGGeometryNode* buildTextNode(QQuickWindow* window);
+    
+private:
+    struct Quad { float x, y, w, h; QRectF uv; };
+    
+    QImage m_image;
+    std::array<Glyph, 128> m_glyphs{};
+    float m_glyphHeight = 0.0f;
+    QSGTexture* m_texture = nullptr;
+    QQuickWindow* m_textureWindow = nullptr;
+    std::vector<Quad> m_pendingQuads;
+};
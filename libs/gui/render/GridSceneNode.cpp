@@ -18,60 +18,49 @@ Assumptions: The active render strategy returns a valid node to be added to the
 
 GridSceneNode::GridSceneNode() {
     setFlag(QSGNode::OwnedByParent);
+    // First child so it draws below every rebuilt layer
+    m_liveHeatmapNode = new QSGNode;
+    m_liveHeatmapNode->setFlag(QSGNode::OwnedByParent);
+    appendChildNode(m_liveHeatmapNode);
 }
 
 void GridSceneNode::updateLayeredContent(const GridSliceBatch& batch, 
                                         IRenderStrategy* heatmapStrategy, bool showHeatmap,
                                         IRenderStrategy* bubbleStrategy, bool showBubbles,
-                                        IRenderStrategy* flowStrategy, bool showFlow) {
-    
-    // Update heatmap layer
-    if (showHeatmap && heatmapStrategy) {
-        if (m_heatmapNode) {
-            removeChildNode(m_heatmapNode);
-            delete m_heatmapNode;
-        }
-        m_heatmapNode = heatmapStrategy->buildNode(batch);
-        if (m_heatmapNode) {
-            appendChildNode(m_heatmapNode);
-        }
-    } else if (m_heatmapNode) {
-        removeChildNode(m_heatmapNode);
-        delete m_heatmapNode;
-        m_heatmapNode = nullptr;
+                                        IRenderStrategy* flowStrategy, bool showFlow,
+                                        LayerRefresh refresh) {
+    // The heatmap colors on the GPU, so only new data forces new geometry
+    refreshLayer(m_heatmapNode, batch, heatmapStrategy, showHeatmap, refresh != LayerRefresh::Rebuild);
+    refreshLayer(m_bubbleNode, batch, bubbleStrategy, showBubbles, refresh == LayerRefresh::Viewport);
+    refreshLayer(m_flowNode, batch, flowStrategy, showFlow, refresh == LayerRefresh::Viewport);
+}
+
+void GridSceneNode::updateOverlayLayer(OverlayLayer layer, const GridSliceBatch& batch,
+                                       IRenderStrategy* strategy, bool show) {
+    replaceLayer(m_overlayNodes[static_cast<int>(layer)], batch, strategy, show);
+}
+
+void GridSceneNode::replaceLayer(QSGNode*& slot, const GridSliceBatch& batch,
+                                 IRenderStrategy* strategy, bool show) {
+    if (slot) {
+        removeChildNode(slot);
+        delete slot;
+        slot = nullptr;
     }
-    
-    // Update bubble layer
-    if (showBubbles && bubbleStrategy) {
-        if (m_bubbleNode) {
-            removeChildNode(m_bubbleNode);
-            delete m_bubbleNode;
-        }
-        m_bubbleNode = bubbleStrategy->buildNode(batch);
-        if (m_bubbleNode) {
-            appendChildNode(m_bubbleNode);
+    if (show && strategy) {
+        slot = strategy->buildNode(batch);
+        if (slot) {
+            appendChildNode(slot);
         }
-    } else if (m_bubbleNode) {
-        removeChildNode(m_bubbleNode);
-        delete m_bubbleNode;
-        m_bubbleNode = nullptr;
     }
-    
-    // Update flow layer  
-    if (showFlow && flowStrategy) {
-        if (m_flowNode) {
-            removeChildNode(m_flowNode);
-            delete m_flowNode;
-        }
-        m_flowNode = flowStrategy->buildNode(batch);
-        if (m_flowNode) {
-            appendChildNode(m_flowNode);
-        }
-    } else if (m_flowNode) {
-        removeChildNode(m_flowNode);
-        delete m_flowNode;
-        m_flowNode = nullptr;
+}
+
+void GridSceneNode::refreshLayer(QSGNode*& slot, const GridSliceBatch& batch,
+                                 IRenderStrategy* strategy, bool show, bool keepGeometry) {
+    if (keepGeometry && slot && show && strategy && strategy->applyViewport(slot, batch.viewport)) {
+        return;
     }
+    replaceLayer(slot, batch, strategy, show);
 }
 
 void GridSceneNode::updateTransform(const QMatrix4x4& transform) {
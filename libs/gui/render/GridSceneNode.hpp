@@ -20,13 +20,25 @@ struct GridSliceBatch;
 
 class GridSceneNode : public QSGTransformNode {
 public:
+    // Optional analytic overlays drawn above the base layers
+    enum class OverlayLayer { Iceberg, Footprint, OrderFlow, Depth, Count };
+    // Rebuild: data changed. Material: heatmap recolored in place, vertex-colored layers rebuilt.
+    // Viewport: world-space layers re-mapped in place where their strategy allows it.
+    enum class LayerRefresh { Rebuild, Material, Viewport };
+    
     GridSceneNode();
     
     void updateLayeredContent(const GridSliceBatch& batch, 
                              IRenderStrategy* heatmapStrategy, bool showHeatmap,
                              IRenderStrategy* bubbleStrategy, bool showBubbles,
-                             IRenderStrategy* flowStrategy, bool showFlow);
+                             IRenderStrategy* flowStrategy, bool showFlow,
+                             LayerRefresh refresh = LayerRefresh::Rebuild);
+    void updateOverlayLayer(OverlayLayer layer, const GridSliceBatch& batch,
+                            IRenderStrategy* strategy, bool show);
     void updateTransform(const QMatrix4x4& transform);
+    QSGNode* heatmapLayer() const { return m_heatmapNode; }
+    // Persistent container for the still-building column; its contents are patched, never swapped
+    QSGNode* liveHeatmapLayer() const { return m_liveHeatmapNode; }
     
     void setShowVolumeProfile(bool show);
     void updateVolumeProfile(const std::vector<std::pair<double, double>>& profile);
@@ -34,10 +46,14 @@ public:
 private:
     QSGNode* m_contentNode = nullptr;
     QSGNode* m_heatmapNode = nullptr;
+    QSGNode* m_liveHeatmapNode = nullptr;
     QSGNode* m_bubbleNode = nullptr;
     QSGNode* m_flowNode = nullptr;
     QSGNode* m_volumeProfileNode = nullptr;
+    QSGNode* m_overlayNodes[static_cast<int>(OverlayLayer::Count)] = {};
     bool m_showVolumeProfile = true;
     
+    void replaceLayer(QSGNode*& slot, const GridSliceBatch& batch, IRenderStrategy* strategy, bool show);
+    void refreshLayer(QSGNode*& slot, const GridSliceBatch& batch, IRenderStrategy* strategy, bool show, bool keepGeometry);
     QSGNode* createVolumeProfileNode(const std::vector<std::pair<double, double>>& profile);
 };
\ No newline at end of file
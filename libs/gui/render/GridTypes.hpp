@@ -2,9 +2,14 @@
 #include <QRectF>
 #include <QColor>
 #include <vector>
+#include <memory>
 #include <cstdint>
 #include "../CoordinateSystem.h"
 #include "../../core/marketdata/model/TradeData.h"
+#include "../../core/OrderFlowEngine.h"
+#include "../../core/FootprintEngine.h"
+#include "../../core/TradeHistoryStore.h"
+#include "../../core/IcebergDetector.h"
 
 // Shared grid rendering types to avoid circular dependencies
 // World-space cell; screen-space is derived in the renderer per-frame
@@ -25,11 +30,35 @@ struct CellInstance {
     int snapshotCount = 0;
 };
 
+// Cells of the still-building (current) slice column, republished by DataProcessor when a level changes.
+// Slots keep their position for the slice's lifetime: new levels append, a vanished level keeps its slot at
+// zero liquidity, so renderers can patch values in place.
+struct LiveColumn {
+    uint64_t revision = 0;               // Bumped on every publish
+    uint64_t layoutRevision = 0;         // Bumped when slots are laid out again (new slice, grid, bounds, mode)
+    std::vector<CellInstance> cells;     // One slot per (price level, side)
+    std::vector<uint32_t> changedSlots;  // Slots changed or appended since revision - 1
+};
+
+// Cumulative book depth at evenly spaced prices over [priceMin, priceMax], ascending (OrderBookDepth mode)
+struct DepthCurve {
+    double priceMin = 0.0;
+    double priceMax = 0.0;
+    std::vector<double> bidCumulative;  // Bid size resting at or above each sampled price
+    std::vector<double> askCumulative;  // Ask size resting at or below each sampled price
+};
+
 struct GridSliceBatch {
     std::vector<CellInstance> cells;
-    std::vector<Trade> recentTrades;  // Raw trade data for bubble rendering
+    std::shared_ptr<const TradeHistoryStore::Blocks> tradeBlocks;  // Published trade blocks, shared not copied (bubble rendering)
     double intensityScale = 1.0;
     double minVolumeFilter = 0.0;
     int maxCells = 100000;
     Viewport viewport;  // viewport snapshot for world→screen conversion
+    Viewport cellCoverage;  // World region `cells` were generated for (a margin around the viewport); width/height unused
+    std::vector<OrderFlowBar> orderFlowBars;  // Visible order-flow bars (overlay layers only)
+    std::shared_ptr<const std::vector<FootprintCell>> footprintCells;  // Visible footprint rows, shared not copied (overlay layers only)
+    std::shared_ptr<const std::vector<FootprintCell>> tradeDensityCells;  // Visible trade density bins, shared not copied (TradeFlow layer)
+    std::vector<IcebergEvent> icebergEvents;    // Suspected iceberg levels (overlay layers only)
+    DepthCurve depthCurve;                      // Live cumulative depth, one sample per pixel row (depth layer only)
 };
\ No newline at end of file
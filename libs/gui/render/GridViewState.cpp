@@ -15,6 +15,7 @@ Assumptions: Zoom logic correctly implements "zoom-to-cursor" functionality.
 #include <QSizeF>
 #include <QDebug>
 #include <algorithm>
+#include <cmath>
 
 namespace {
 constexpr bool kTraceZoomInteractions = false;
@@ -190,6 +191,9 @@ void GridViewState::handlePanStart(const QPointF& position) {
     m_lastMousePos = position;
     m_initialMousePos = position;
     m_panVisualOffset = QPointF(0, 0);
+    m_panVelocity = QPointF(0, 0);
+    m_lastPanMove_ms = m_interactionTimer.elapsed();
+    m_prefetchRequested = false;
     
     // Disable auto-scroll when user starts dragging
     if (m_autoScrollEnabled) {
@@ -205,7 +209,45 @@ void GridViewState::handlePanMove(const QPointF& position) {
     m_panVisualOffset += delta;
     m_lastMousePos = position;
     
+    const qint64 now = m_interactionTimer.elapsed();
+    if (now > m_lastPanMove_ms) {
+        const QPointF instantaneous = delta / static_cast<double>(now - m_lastPanMove_ms);
+        m_panVelocity = m_panVelocity * (1.0 - kPanVelocitySmoothing) + instantaneous * kPanVelocitySmoothing;
+        m_lastPanMove_ms = now;
+    }
+    
     emit panVisualOffsetChanged();
+    requestPanPrefetch();
+}
+
+void GridViewState::requestPanPrefetch() {
+    if (!m_timeWindowValid || m_viewportWidth <= 0 || m_viewportHeight <= 0) return;
+
+    // Throttle: one request per step of drag distance
+    const QPointF moved = m_panVisualOffset - m_lastPrefetchOffset;
+    if (m_prefetchRequested && std::abs(moved.x()) < m_viewportWidth * kPrefetchStepFraction &&
+        std::abs(moved.y()) < m_viewportHeight * kPrefetchStepFraction) {
+        return;
+    }
+    m_prefetchRequested = true;
+    m_lastPrefetchOffset = m_panVisualOffset;
+
+    // Same pixel → world conversion handlePanEnd commits with
+    const double msPerPixel = static_cast<double>(m_visibleTimeEnd_ms - m_visibleTimeStart_ms) / m_viewportWidth;
+    const double pricePerPixel = (m_maxPrice - m_minPrice) / m_viewportHeight;
+    const double timeShift = -m_panVisualOffset.x() * msPerPixel;
+    const double priceShift = m_panVisualOffset.y() * pricePerPixel;
+
+    // Content moving right exposes the past on the left, and so on
+    const QPointF lead = m_panVelocity * kPanLookahead_ms;
+    const double timeLead = -lead.x() * msPerPixel;
+    const double priceLead = lead.y() * pricePerPixel;
+
+    emit panPrefetchRequested(
+        m_visibleTimeStart_ms + static_cast<qint64>(timeShift + std::min(0.0, timeLead)),
+        m_visibleTimeEnd_ms + static_cast<qint64>(timeShift + std::max(0.0, timeLead)),
+        m_minPrice + priceShift + std::min(0.0, priceLead),
+        m_maxPrice + priceShift + std::max(0.0, priceLead));
 }
 
 void GridViewState::handlePanEnd() {
@@ -66,6 +66,8 @@ public:
 signals:
     void viewportChanged();
     void panVisualOffsetChanged();
+    // World region a drag is about to expose: the dragged viewport stretched along the pan velocity
+    void panPrefetchRequested(qint64 timeStart, qint64 timeEnd, double priceMin, double priceMax);
     void autoScrollEnabledChanged();
 
 private:
@@ -96,5 +98,15 @@ private:
     QPointF m_initialMousePos;
     QPointF m_panVisualOffset;
     QElapsedTimer m_interactionTimer;
+    
+    // Pan-velocity prefetch
+    static constexpr double kPanLookahead_ms = 750.0;     // How far ahead of the drag to request cells
+    static constexpr double kPanVelocitySmoothing = 0.3;  // EMA weight of the newest move
+    static constexpr double kPrefetchStepFraction = 0.1;  // Re-request after moving this share of the viewport
+    QPointF m_panVelocity;        // Smoothed drag velocity, px per ms
+    qint64 m_lastPanMove_ms = 0;  // m_interactionTimer time of the last move
+    QPointF m_lastPrefetchOffset;
+    bool m_prefetchRequested = false;
+    void requestPanPrefetch();
     uint64_t m_viewportVersion = 1; // incremented on viewport/size changes
 };
\ No newline at end of file
@@ -0,0 +1,86 @@
+/*
+Sentinel — HeatmapMaterial
+Role: Implements the heatmap material, its shader and the vertex attribute layout.
+Inputs/Outputs: Writes qt_Matrix, qt_Opacity, intensityScale and the grid mapping into the uniform block; binds the ramp at binding 1.
+Threading: Render thread only.
+Performance: Materials with the same ramp, scale and mapping compare equal; the shader does one multiply-add per axis.
+Integration: See HeatmapMaterial.hpp.
+Observability: No internal logging.
+Related: HeatmapMaterial.hpp, WorldSpaceMaterial.cpp, shaders/heatmap.vert, shaders/heatmap.frag.
+Assumptions: Uniform block layout (std140): mat4 at 0, opacity at 64, intensityScale at 68, vec4 grid at 80.
+*/
+#include "HeatmapMaterial.hpp"
+#include <QSGMaterialShader>
+#include <QSGTexture>
+#include <cstring>
+
+namespace {
+    class HeatmapMaterialShader : public QSGMaterialShader {
+    public:
+        HeatmapMaterialShader() {
+            setShaderFileName(VertexStage, QStringLiteral(":/sentinel/shaders/heatmap.vert.qsb"));
+            setShaderFileName(FragmentStage, QStringLiteral(":/sentinel/shaders/heatmap.frag.qsb"));
+        }
+
+        bool updateUniformData(RenderState& state, QSGMaterial* newMaterial, QSGMaterial* oldMaterial) override {
+            Q_UNUSED(oldMaterial)
+            QByteArray* buf = state.uniformData();
+            if (state.isMatrixDirty()) {
+                const QMatrix4x4 m = state.combinedMatrix();
+                std::memcpy(buf->data(), m.constData(), 64);
+            }
+            if (state.isOpacityDirty()) {
+                const float opacity = state.opacity();
+                std::memcpy(buf->data() + 64, &opacity, 4);
+            }
+            // The same material object may come back with a new scale or viewport, so always write them
+            const auto* material = static_cast<HeatmapMaterial*>(newMaterial);
+            const float scale = material->intensityScale();
+            std::memcpy(buf->data() + 68, &scale, 4);
+            const QVector4D& grid = material->screenMapping();
+            const float mapping[4] = {grid.x(), grid.y(), grid.z(), grid.w()};
+            std::memcpy(buf->data() + 80, mapping, 16);
+            return true;
+        }
+
+        void updateSampledImage(RenderState& state, int binding, QSGTexture** texture,
+                                QSGMaterial* newMaterial, QSGMaterial* oldMaterial) override {
+            Q_UNUSED(oldMaterial)
+            if (binding != 1) return;
+            QSGTexture* ramp = static_cast<HeatmapMaterial*>(newMaterial)->ramp();
+            if (ramp) ramp->commitTextureOperations(state.rhi(), state.resourceUpdateBatch());
+            *texture = ramp;
+        }
+    };
+}
+
+HeatmapMaterial::HeatmapMaterial() {
+    // Positions are not float vertex coordinates, so the renderer must not merge/pre-transform chunks
+    setFlag(Blending | RequiresFullMatrix);
+}
+
+const QSGGeometry::AttributeSet& HeatmapMaterial::attributes() {
+    static const QSGGeometry::Attribute attrs[] = {
+        QSGGeometry::Attribute::createWithAttributeType(0, 4, QSGGeometry::UnsignedByteType, QSGGeometry::UnknownAttribute),
+        QSGGeometry::Attribute::createWithAttributeType(1, 1, QSGGeometry::FloatType, QSGGeometry::UnknownAttribute),
+    };
+    static const QSGGeometry::AttributeSet set = {2, sizeof(Vertex), attrs};
+    return set;
+}
+
+QSGMaterialType* HeatmapMaterial::type() const {
+    static QSGMaterialType type;
+    return &type;
+}
+
+QSGMaterialShader* HeatmapMaterial::createShader(QSGRendererInterface::RenderMode renderMode) const {
+    Q_UNUSED(renderMode)
+    return new HeatmapMaterialShader;
+}
+
+int HeatmapMaterial::compare(const QSGMaterial* other) const {
+    const auto* rhs = static_cast<const HeatmapMaterial*>(other);
+    if (m_ramp != rhs->m_ramp) return m_ramp < rhs->m_ramp ? -1 : 1;
+    if (m_intensityScale != rhs->m_intensityScale) return m_intensityScale < rhs->m_intensityScale ? -1 : 1;
+    return compareMapping(rhs);
+}
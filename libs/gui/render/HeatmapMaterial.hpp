@@ -0,0 +1,57 @@
+/*
+Sentinel — HeatmapMaterial
+Role: Scene-graph material that places and colors heatmap cells on the GPU from packed grid indices, a viewport uniform and a theme ramp texture.
+Inputs/Outputs: Vertices carry a packed (time index, tick index) corner plus signed log-liquidity; the material adds the ramp texture and intensity scale to the world grid.
+Threading: Created, updated and rendered on the Qt Quick render thread.
+Performance: 8-byte vertices, 4 per cell with a 16-bit index buffer (44 bytes/cell vs 72 for six ColoredPoint2D-sized vertices); pan/zoom, intensity and theme changes only touch uniforms.
+Integration: Built by HeatmapStrategy; shaders are compiled by qt_add_shaders from render/shaders/heatmap.{vert,frag}.
+Observability: No internal logging.
+Related: HeatmapMaterial.cpp, WorldSpaceMaterial.hpp, HeatmapStrategy.hpp, ColorRamp.hpp, shaders/heatmap.vert, shaders/heatmap.frag.
+Assumptions: The ramp texture is owned by HeatmapStrategy and outlives every material that references it; grid indices stay within ±kMaxGridIndex of the chunk origin.
+*/
+#pragma once
+#include "WorldSpaceMaterial.hpp"
+#include <QSGGeometry>
+#include <cstdint>
+
+class QSGTexture;
+
+class HeatmapMaterial : public WorldSpaceMaterial {
+public:
+    // Grid indices are stored biased by kGridIndexBias in two unsigned 16-bit halves
+    static constexpr int kGridIndexBias = 32768;
+    static constexpr int kMaxGridIndex = 32767;
+
+    struct Vertex {
+        uint8_t cell[4];  // time index lo/hi, tick index lo/hi (biased); read as UNormByte4
+        float value;      // log1p(liquidity); negative for the ask side
+
+        void set(int timeIndex, int tickIndex, float nvalue) {
+            const auto t = static_cast<uint16_t>(timeIndex + kGridIndexBias);
+            const auto p = static_cast<uint16_t>(tickIndex + kGridIndexBias);
+            cell[0] = static_cast<uint8_t>(t & 0xFF);
+            cell[1] = static_cast<uint8_t>(t >> 8);
+            cell[2] = static_cast<uint8_t>(p & 0xFF);
+            cell[3] = static_cast<uint8_t>(p >> 8);
+            value = nvalue;
+        }
+    };
+    static_assert(sizeof(Vertex) == 8, "HeatmapMaterial::Vertex must stay tightly packed");
+
+    HeatmapMaterial();
+
+    static const QSGGeometry::AttributeSet& attributes();
+
+    QSGMaterialType* type() const override;
+    QSGMaterialShader* createShader(QSGRendererInterface::RenderMode renderMode) const override;
+    int compare(const QSGMaterial* other) const override;
+
+    void setRamp(QSGTexture* ramp) { m_ramp = ramp; }
+    QSGTexture* ramp() const { return m_ramp; }
+    void setIntensityScale(float scale) { m_intensityScale = scale; }
+    float intensityScale() const { return m_intensityScale; }
+
+private:
+    QSGTexture* m_ramp = nullptr;
+    float m_intensityScale = 1.0f;
+};
@@ -0,0 +1,250 @@
+/*
+Sentinel — HeatmapTileProcessor
+Role: Implements per-tile LOD selection, book sampling into atlas columns, and frame publication.
+Inputs/Outputs: LiveOrderBook snapshots → one texel column per tile; tile images + ring state → HeatmapAtlasFrame.
+Threading: All slots run on the shared tile thread; publishedFrame() is the only cross-thread entry point.
+Performance: Book capture starts at the best levels and stops once a side leaves the tile's price band.
+Integration: See HeatmapTileProcessor.hpp.
+Observability: sLog_Render on (re)configuration.
+Related: HeatmapTileProcessor.hpp, MultiSymbolHeatmapGrid.cpp.
+Assumptions: Rows aggregate every grid level inside them; a column keeps each row's peak over its period.
+*/
+#include "HeatmapTileProcessor.hpp"
+#include "../../core/marketdata/cache/DataCache.hpp"
+#include "SentinelLogging.hpp"
+#include <QDateTime>
+#include <QTimer>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr double kIntensityDecay = 0.995;   // Per sample; lets the color scale follow a quieter book
+    constexpr double kRecenterMargin = 0.2;     // Recenter when the mid is within 20% of the band edge
+
+    // Ramp entries hold straight alpha; the atlas is premultiplied
+    QRgb premultiplied(const ColorRamp::Rgba& c) {
+        return qRgba(c.r * c.a / 255, c.g * c.a / 255, c.b * c.a / 255, c.a);
+    }
+}
+
+HeatmapTileProcessor::HeatmapTileProcessor(QObject* parent)
+    : QObject(parent) {
+}
+
+HeatmapTileProcessor::~HeatmapTileProcessor() = default;
+
+std::shared_ptr<const HeatmapAtlasFrame> HeatmapTileProcessor::publishedFrame() const {
+    std::lock_guard<std::mutex> lock(m_frameMutex);
+    return m_published;
+}
+
+int64_t HeatmapTileProcessor::selectColumnPeriod(int tileWidthPx, int64_t history_ms) {
+    const int columns = std::max(1, tileWidthPx / kPixelsPerColumn);
+    const int64_t wanted = history_ms / columns;
+    for (int64_t period : kLodPeriods_ms) {
+        if (period >= wanted) return period;
+    }
+    return kLodPeriods_ms.back();
+}
+
+void HeatmapTileProcessor::configure(const QStringList& symbols, int gridColumns, int tileWidthPx,
+                                     int tileHeightPx, int historySeconds, double bandPercent) {
+    m_tiles.clear();
+    m_bandPercent = std::max(0.01, bandPercent);
+    gridColumns = std::max(1, gridColumns);
+    if (symbols.isEmpty() || tileWidthPx <= 0 || tileHeightPx <= 0) {
+        m_atlasSize = QSize();
+        publish();
+        return;
+    }
+
+    const int64_t history_ms = static_cast<int64_t>(std::max(1, historySeconds)) * 1000;
+    const int maxColumns = std::max(1, tileWidthPx / kPixelsPerColumn);
+    const int rows = std::max(1, tileHeightPx / kPixelsPerRow);
+
+    m_tiles.reserve(static_cast<size_t>(symbols.size()));
+    int atlasColumns = 1;
+    for (int i = 0; i < symbols.size(); ++i) {
+        TileState tile;
+        tile.symbol = symbols.at(i).toStdString();
+        tile.info.symbol = symbols.at(i);
+        tile.info.period_ms = selectColumnPeriod(tileWidthPx, history_ms);
+        tile.columns = static_cast<int>(std::clamp<int64_t>(history_ms / tile.info.period_ms, 1, maxColumns));
+        tile.rows = rows;
+        tile.bidRow.assign(static_cast<size_t>(rows), 0.0);
+        tile.askRow.assign(static_cast<size_t>(rows), 0.0);
+        tile.info.head = tile.columns - 1;
+        tile.image = QImage(tile.columns, rows, QImage::Format_ARGB32_Premultiplied);
+        tile.image.fill(Qt::transparent);
+        atlasColumns = std::max(atlasColumns, tile.columns);
+        m_tiles.push_back(std::move(tile));
+    }
+
+    // Atlas mirrors the on-screen grid: one cell of atlasColumns × rows texels per tile
+    const int gridRows = (static_cast<int>(m_tiles.size()) + gridColumns - 1) / gridColumns;
+    for (size_t i = 0; i < m_tiles.size(); ++i) {
+        const int cellX = static_cast<int>(i) % gridColumns;
+        const int cellY = static_cast<int>(i) / gridColumns;
+        m_tiles[i].info.atlasRect = QRect(cellX * atlasColumns, cellY * rows, m_tiles[i].columns, rows);
+    }
+    m_atlasSize = QSize(gridColumns * atlasColumns, gridRows * rows);
+
+    m_sampleBid.assign(static_cast<size_t>(rows), 0.0);
+    m_sampleAsk.assign(static_cast<size_t>(rows), 0.0);
+
+    sLog_Render("HeatmapTileProcessor: " << m_tiles.size() << "tiles, tile" << tileWidthPx << "x" << tileHeightPx
+                << "px, LOD" << m_tiles.front().info.period_ms << "ms x" << m_tiles.front().columns
+                << "columns, atlas" << m_atlasSize.width() << "x" << m_atlasSize.height());
+    publish();
+}
+
+void HeatmapTileProcessor::onLiveOrderBookUpdated(const QString& productId, const std::vector<BookDelta>& deltas) {
+    Q_UNUSED(deltas);
+    const std::string symbol = productId.toStdString();
+    for (TileState& tile : m_tiles) {
+        if (tile.symbol == symbol) tile.dirty = true;
+    }
+}
+
+void HeatmapTileProcessor::start() {
+    if (!m_timer) {
+        m_timer = new QTimer(this);
+        m_timer->setInterval(kSampleInterval_ms);
+        connect(m_timer, &QTimer::timeout, this, &HeatmapTileProcessor::sampleTick);
+    }
+    m_timer->start();
+}
+
+void HeatmapTileProcessor::stop() {
+    if (m_timer) m_timer->stop();
+}
+
+void HeatmapTileProcessor::sampleTick() {
+    if (!m_dataCache || m_tiles.empty()) return;
+
+    const int64_t now_ms = QDateTime::currentMSecsSinceEpoch();
+    bool changed = false;
+    for (TileState& tile : m_tiles) {
+        changed |= sampleTile(tile, now_ms);
+    }
+    if (changed) publish();
+}
+
+bool HeatmapTileProcessor::sampleTile(TileState& tile, int64_t now_ms) {
+    bool advanced = false;
+    if (now_ms - tile.columnStart_ms >= tile.info.period_ms) {
+        // Step the ring: the new column starts empty and collects this period's peaks
+        tile.info.head = (tile.info.head + 1) % tile.columns;
+        tile.columnStart_ms = now_ms - (now_ms % tile.info.period_ms);
+        std::fill(tile.bidRow.begin(), tile.bidRow.end(), 0.0);
+        std::fill(tile.askRow.begin(), tile.askRow.end(), 0.0);
+        clearTile(tile, tile.info.head, 1);
+        advanced = true;
+    }
+    // An unchanged book still has to be sampled into a fresh column
+    if (!tile.dirty && !advanced) return false;
+    tile.dirty = false;
+
+    const LiveOrderBook& book = m_dataCache->getDirectLiveOrderBook(tile.symbol);
+    if (book.isStale()) return advanced;  // Restored from a checkpoint; wait for the live snapshot
+    const auto view = book.captureDenseNonZero(m_bidBuf, m_askBuf, kMaxLevelsPerSide);
+    if (view.tickSize <= 0.0 || (view.bidLevels.empty() && view.askLevels.empty())) return advanced;
+
+    const auto levelPrice = [&view](uint32_t idx) {
+        return view.minPrice + static_cast<double>(idx) * view.tickSize;
+    };
+    double mid = 0.0;
+    if (!view.bidLevels.empty() && !view.askLevels.empty()) {
+        mid = 0.5 * (levelPrice(view.bidLevels.front().first) + levelPrice(view.askLevels.front().first));
+    } else {
+        mid = levelPrice(view.bidLevels.empty() ? view.askLevels.front().first : view.bidLevels.front().first);
+    }
+
+    // Recenter on a mid that drifted to the band edge; older columns used the old band, so drop them
+    const double range = tile.info.priceMax - tile.info.priceMin;
+    if (!tile.info.hasData || mid < tile.info.priceMin + range * kRecenterMargin ||
+        mid > tile.info.priceMax - range * kRecenterMargin) {
+        const double halfBand = std::max(view.tickSize * tile.rows * 0.5, mid * m_bandPercent / 100.0);
+        tile.info.priceMin = mid - halfBand;
+        tile.info.priceMax = mid + halfBand;
+        tile.info.hasData = true;
+        clearTile(tile, 0, tile.columns);
+    }
+
+    const double rowHeight = (tile.info.priceMax - tile.info.priceMin) / tile.rows;
+    const auto rowOf = [&](double price) {
+        return std::min(static_cast<size_t>((tile.info.priceMax - price) / rowHeight),
+                        static_cast<size_t>(tile.rows - 1));
+    };
+    std::fill(m_sampleBid.begin(), m_sampleBid.end(), 0.0);
+    std::fill(m_sampleAsk.begin(), m_sampleAsk.end(), 0.0);
+
+    // Levels arrive best-first, so each side stops at the first level outside the band
+    for (const auto& [idx, qty] : view.bidLevels) {
+        const double price = levelPrice(idx);
+        if (price < tile.info.priceMin) break;
+        if (price >= tile.info.priceMax) continue;
+        m_sampleBid[rowOf(price)] += qty;
+    }
+    for (const auto& [idx, qty] : view.askLevels) {
+        const double price = levelPrice(idx);
+        if (price >= tile.info.priceMax) break;
+        if (price < tile.info.priceMin) continue;
+        m_sampleAsk[rowOf(price)] += qty;
+    }
+
+    double columnMax = 0.0;
+    for (int r = 0; r < tile.rows; ++r) {
+        tile.bidRow[r] = std::max(tile.bidRow[r], m_sampleBid[r]);
+        tile.askRow[r] = std::max(tile.askRow[r], m_sampleAsk[r]);
+        columnMax = std::max({columnMax, tile.bidRow[r], tile.askRow[r]});
+    }
+    tile.runningMax = std::max(tile.runningMax * kIntensityDecay, columnMax);
+
+    writeColumn(tile);
+    return true;
+}
+
+void HeatmapTileProcessor::writeColumn(TileState& tile) {
+    if (tile.image.isNull() || tile.runningMax <= 0.0) return;
+
+    const ColorRamp& ramp = *m_colorRamp;
+    const int x = tile.info.head;
+    for (int r = 0; r < tile.rows; ++r) {
+        const double bid = tile.bidRow[r];
+        const double ask = tile.askRow[r];
+        QRgb texel = 0;
+        if (bid > 0.0 || ask > 0.0) {
+            // Square root keeps thin levels visible next to walls
+            const double intensity = std::sqrt(std::min(1.0, std::max(bid, ask) / tile.runningMax));
+            texel = premultiplied(ramp.sample(bid >= ask ? RampPalette::HeatmapBid : RampPalette::HeatmapAsk,
+                                              intensity));
+        }
+        reinterpret_cast<QRgb*>(tile.image.scanLine(r))[x] = texel;
+    }
+}
+
+void HeatmapTileProcessor::clearTile(TileState& tile, int fromColumn, int count) {
+    if (tile.image.isNull()) return;
+    for (int r = 0; r < tile.rows; ++r) {
+        QRgb* line = reinterpret_cast<QRgb*>(tile.image.scanLine(r));
+        std::fill(line + fromColumn, line + fromColumn + count, QRgb(0));
+    }
+}
+
+void HeatmapTileProcessor::publish() {
+    auto frame = std::make_shared<HeatmapAtlasFrame>();
+    frame->atlasSize = m_atlasSize;
+    frame->tiles.reserve(m_tiles.size());
+    frame->tileImages.reserve(m_tiles.size());
+    for (const TileState& tile : m_tiles) {
+        frame->tiles.push_back(tile.info);
+        frame->tileImages.push_back(tile.image);  // Shared; only a tile written again detaches
+    }
+    frame->version = ++m_version;
+    {
+        std::lock_guard<std::mutex> lock(m_frameMutex);
+        m_published = std::move(frame);
+    }
+    emit frameReady();
+}
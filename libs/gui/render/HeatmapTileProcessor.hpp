@@ -0,0 +1,124 @@
+/*
+Sentinel — HeatmapTileProcessor
+Role: Samples many symbols' live books into one shared heatmap atlas for the multi-symbol grid view.
+Inputs/Outputs: Takes LiveOrderBook updates (via DataCache) for N symbols; publishes immutable HeatmapAtlasFrames.
+Threading: Lives on one worker QThread shared by every tile; frames are published under a mutex for the render thread.
+Performance: One texel column per tile per LOD period; only tiles whose book changed are re-sampled between columns,
+             and a frame shares every tile image that was not written since the previous one (no atlas copy).
+Integration: Owned by MultiSymbolHeatmapGrid; fed from MarketDataCore::liveOrderBookUpdated (queued).
+Observability: Logs tile configuration and chosen LOD via sLog_Render.
+Related: HeatmapTileProcessor.cpp, MultiSymbolHeatmapGrid.h, DataCache.hpp (LiveOrderBook::captureDenseNonZero), ColorRamp.hpp.
+Assumptions: Tiles share one size; each tile's price band recenters (and clears) when the mid leaves its inner band.
+*/
+#pragma once
+#include <QImage>
+#include <QObject>
+#include <QRect>
+#include <QSize>
+#include <QString>
+#include <QStringList>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../../core/marketdata/model/TradeData.h"
+#include "ColorRamp.hpp"
+
+class DataCache;
+class QTimer;
+
+// Where a tile lives in the atlas and how to unwrap its column ring
+struct HeatmapTileInfo {
+    QString symbol;
+    QRect atlasRect;         // Texel region owned by this tile (columns × rows)
+    int head = 0;            // Ring column holding the newest sample; oldest is head + 1
+    int64_t period_ms = 0;   // LOD: time covered by one column
+    double priceMin = 0.0;
+    double priceMax = 0.0;
+    bool hasData = false;
+};
+
+// Immutable once published; the render thread blits changed tiles into one atlas texture
+struct HeatmapAtlasFrame {
+    QSize atlasSize;
+    std::vector<HeatmapTileInfo> tiles;
+    // One per tile (atlasRect size), implicitly shared with the processor: a tile untouched since the last
+    // frame keeps its QImage::cacheKey, so the render thread only re-blits tiles whose key changed
+    std::vector<QImage> tileImages;
+    uint64_t version = 0;
+};
+
+class HeatmapTileProcessor : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr int kPixelsPerColumn = 2;       // Screen px per time column at the tile's size
+    static constexpr int kPixelsPerRow = 2;          // Screen px per price row
+    static constexpr int kSampleInterval_ms = 100;
+    static constexpr size_t kMaxLevelsPerSide = 20000;
+    static constexpr std::array<int64_t, 7> kLodPeriods_ms = {100, 250, 500, 1000, 2000, 5000, 10000};
+
+    explicit HeatmapTileProcessor(QObject* parent = nullptr);
+    ~HeatmapTileProcessor() override;
+
+    // Must be set before start()
+    void setDataCache(DataCache* cache) { m_dataCache = cache; }
+    // Theme palettes (HeatmapBid/HeatmapAsk); columns written from now on use the new ramp. Tile thread only.
+    void setColorRamp(std::shared_ptr<const ColorRamp> ramp) { if (ramp) m_colorRamp = std::move(ramp); }
+
+    // Latest published frame (any thread)
+    std::shared_ptr<const HeatmapAtlasFrame> publishedFrame() const;
+
+    // Coarsest column period that still fills the tile's width with history_ms of data
+    static int64_t selectColumnPeriod(int tileWidthPx, int64_t history_ms);
+
+public slots:
+    void configure(const QStringList& symbols, int gridColumns, int tileWidthPx, int tileHeightPx,
+                   int historySeconds, double bandPercent);
+    void onLiveOrderBookUpdated(const QString& productId, const std::vector<BookDelta>& deltas);
+    void start();
+    void stop();
+
+signals:
+    void frameReady();
+
+private:
+    struct TileState {
+        std::string symbol;
+        HeatmapTileInfo info;
+        int columns = 1;
+        int rows = 1;
+        int64_t columnStart_ms = 0;
+        bool dirty = true;
+        double runningMax = 0.0;
+        std::vector<double> bidRow;   // Per-row peak within the current column
+        std::vector<double> askRow;
+        QImage image;                 // columns × rows texels; detaches (tile-sized copy) only while a frame shares it
+    };
+
+    void sampleTick();
+    bool sampleTile(TileState& tile, int64_t now_ms);
+    void writeColumn(TileState& tile);
+    void clearTile(TileState& tile, int fromColumn, int count);
+    void publish();
+
+    DataCache* m_dataCache = nullptr;
+    QTimer* m_timer = nullptr;
+    std::vector<TileState> m_tiles;
+    QSize m_atlasSize;
+    std::shared_ptr<const ColorRamp> m_colorRamp = ColorRamp::fromTheme(nullptr);
+    double m_bandPercent = 0.5;
+
+    // Per-sample scratch (worker thread only)
+    std::vector<std::pair<uint32_t, double>> m_bidBuf;
+    std::vector<std::pair<uint32_t, double>> m_askBuf;
+    std::vector<double> m_sampleBid;
+    std::vector<double> m_sampleAsk;
+
+    mutable std::mutex m_frameMutex;
+    std::shared_ptr<const HeatmapAtlasFrame> m_published;
+    uint64_t m_version = 0;
+};
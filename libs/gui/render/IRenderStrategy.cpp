@@ -1,7 +1,9 @@
 #include "IRenderStrategy.hpp"
+#include "../CoordinateSystem.h"
 #include <QSGGeometryNode>
 #include <QSGGeometry>
 #include <algorithm>
+#include <cmath>
 
 void IRenderStrategy::ensureGeometryCapacity(QSGGeometryNode* node, int vertexCount) {
     if (!node || !node->geometry()) return;
@@ -21,4 +23,15 @@ double IRenderStrategy::calculateIntensity(double liquidity, double intensitySca
     double intensity = logLiquidity * intensityScale; // drop arbitrary 0.1 reduction
     
     return std::min(1.0, intensity);
-}
\ No newline at end of file
+}
+
+bool IRenderStrategy::viewportWithin(const Viewport& inner, const Viewport& outer) {
+    return inner.timeStart_ms >= outer.timeStart_ms && inner.timeEnd_ms <= outer.timeEnd_ms &&
+           inner.priceMin >= outer.priceMin && inner.priceMax <= outer.priceMax;
+}
+
+const ColorRamp& IRenderStrategy::colorRamp() const {
+    if (m_colorRamp) return *m_colorRamp;
+    static const std::shared_ptr<const ColorRamp> kDefault = ColorRamp::fromTheme(nullptr);
+    return *kDefault;
+}
@@ -3,7 +3,7 @@ Sentinel — IRenderStrategy
 Role: Defines the abstract interface for all rendering strategies.
 Inputs/Outputs: Defines the contract for turning a GridSliceBatch into a renderable QSGNode.
 Threading: Methods are designed to be called on the Qt Quick render thread.
-Performance: Interface is designed for batch operations to optimize rendering performance.
+Performance: Interface is designed for batch operations; colors come from a shared precomputed ColorRamp; world-space layers re-map via applyViewport.
 Integration: Implemented by concrete strategies (e.g., HeatmapStrategy) and used by UnifiedGridRenderer.
 Observability: No diagnostics defined; responsibility of the concrete implementation.
 Related: UnifiedGridRenderer.h, GridTypes.hpp, HeatmapStrategy.hpp, TradeFlowStrategy.hpp.
@@ -11,12 +11,16 @@ Assumptions: Implementations will be managed and invoked by UnifiedGridRenderer.
 */
 #pragma once
 #include <QSGNode>
+#include <QSGGeometry>
+#include <memory>
+#include "ColorRamp.hpp"
 
 class QSGGeometryNode;
 
 // Forward declarations
 struct CellInstance;
 struct GridSliceBatch;
+struct Viewport;
 
 class IRenderStrategy {
 public:
@@ -26,7 +30,41 @@ public:
     virtual QColor calculateColor(double liquidity, bool isBid, double intensity) const = 0;
     virtual const char* getStrategyName() const = 0;
     
+    // Re-maps a layer previously returned by buildNode to a new viewport without touching its vertices.
+    // Returns false when the layer must be rebuilt instead (screen-space geometry, or data outside what was built).
+    virtual bool applyViewport(QSGNode* layer, const Viewport& viewport) { Q_UNUSED(layer) Q_UNUSED(viewport) return false; }
+    
+    // Theme palette lookup tables; set on the render thread when the theme changes
+    void setColorRamp(std::shared_ptr<const ColorRamp> ramp) { m_colorRamp = std::move(ramp); }
+    
 protected:
+    const ColorRamp& colorRamp() const;
+
+    // Screen-space rectangle as two triangles of vertex-colored points (QSGVertexColorMaterial, DrawTriangles)
+    static constexpr int kVerticesPerQuad = 6;
+    static void emitQuad(QSGGeometry::ColoredPoint2D* v, int& i, float left, float top, float right, float bottom,
+                         uchar r, uchar g, uchar b, uchar a) {
+        v[i++].set(left, top, r, g, b, a);
+        v[i++].set(right, top, r, g, b, a);
+        v[i++].set(left, bottom, r, g, b, a);
+        v[i++].set(right, top, r, g, b, a);
+        v[i++].set(right, bottom, r, g, b, a);
+        v[i++].set(left, bottom, r, g, b, a);
+    }
+    static void emitQuad(QSGGeometry::ColoredPoint2D* v, int& i,
+                         float left, float top, float right, float bottom, const QColor& c) {
+        emitQuad(v, i, left, top, right, bottom, static_cast<uchar>(c.red()), static_cast<uchar>(c.green()),
+                 static_cast<uchar>(c.blue()), static_cast<uchar>(c.alpha()));
+    }
+    static void emitQuad(QSGGeometry::ColoredPoint2D* v, int& i,
+                         float left, float top, float right, float bottom, const ColorRamp::Rgba& c) {
+        emitQuad(v, i, left, top, right, bottom, c.r, c.g, c.b, c.a);
+    }
+
     void ensureGeometryCapacity(QSGGeometryNode* node, int vertexCount);
     double calculateIntensity(double liquidity, double intensityScale) const;
+    // True when `inner` lies within the world rectangle of `outer`
+    static bool viewportWithin(const Viewport& inner, const Viewport& outer);
+    
+    std::shared_ptr<const ColorRamp> m_colorRamp;
 };
\ No newline at end of file
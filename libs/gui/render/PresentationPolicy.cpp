@@ -0,0 +1,58 @@
+/*
+Sentinel — PresentationPolicy
+Role: Implements config parsing and surface-format application for the presentation policy.
+Inputs/Outputs: QSettings (config.ini) in; QSurfaceFormat swap interval/samples and a repaint interval out.
+Threading: Main thread (startup).
+Performance: Not on any hot path.
+Integration: See PresentationPolicy.hpp.
+Observability: Unknown mode names fall back to vsync with a warning.
+Related: PresentationPolicy.hpp.
+Assumptions: QSettings with an explicit file works before QApplication exists.
+*/
+#include "PresentationPolicy.hpp"
+#include "SentinelLogging.hpp"
+#include <QSettings>
+#include <QSurfaceFormat>
+#include <algorithm>
+
+PresentationPolicy PresentationPolicy::fromConfig(const QString& configPath) {
+    QSettings config(configPath, QSettings::IniFormat);
+    PresentationPolicy policy;
+    policy.mode = modeFromString(config.value("render/present", "vsync").toString());
+    policy.maxFps = std::clamp(config.value("render/maxFps", policy.maxFps).toInt(), 1, 1000);
+    policy.msaaSamples = std::clamp(config.value("render/msaa", policy.msaaSamples).toInt(), 0, 16);
+    return policy;
+}
+
+PresentationPolicy::Mode PresentationPolicy::modeFromString(const QString& name) {
+    const QString key = name.trimmed().toLower();
+    if (key == "vsync") return Mode::VSync;
+    if (key == "uncapped") return Mode::Uncapped;
+    if (key == "adaptive") return Mode::Adaptive;
+    sLog_Warning("PresentationPolicy: unknown present mode" << name << "- using vsync");
+    return Mode::VSync;
+}
+
+const char* PresentationPolicy::modeName(Mode mode) {
+    switch (mode) {
+        case Mode::VSync: return "vsync";
+        case Mode::Uncapped: return "uncapped";
+        case Mode::Adaptive: return "adaptive";
+    }
+    return "vsync";
+}
+
+qint64 PresentationPolicy::minFrameInterval_ms() const {
+    return mode == Mode::Adaptive ? std::max<qint64>(1, 1000 / std::max(1, maxFps)) : 0;
+}
+
+void PresentationPolicy::applyTo(QSurfaceFormat& format) const {
+    format.setSwapInterval(swapInterval());
+    format.setSamples(msaaSamples);
+}
+
+QString PresentationPolicy::describe() const {
+    QString text = QString("present=%1 msaa=%2x").arg(modeName(mode)).arg(msaaSamples);
+    if (mode == Mode::Adaptive) text += QString(" cap=%1fps").arg(maxFps);
+    return text;
+}
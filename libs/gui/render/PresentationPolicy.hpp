@@ -0,0 +1,38 @@
+/*
+Sentinel — PresentationPolicy
+Role: Describes how frames are presented: vsync, uncapped, or adaptive (vsync plus a frame-rate cap on data repaints).
+Inputs/Outputs: Reads the [render] section of config.ini; configures QSurfaceFormat and the renderer's repaint cap.
+Threading: Plain value type; read at startup on the main thread and copied into UnifiedGridRenderer.
+Performance: VSync and Adaptive block in present instead of spinning frames the display never shows.
+Integration: Applied to the default surface format in main.cpp; UnifiedGridRenderer uses minFrameInterval_ms().
+Observability: describe() summarizes the active policy for startup logs.
+Related: PresentationPolicy.cpp, main.cpp, UnifiedGridRenderer.h, RenderDiagnostics.hpp.
+Assumptions: Backends honor QSurfaceFormat::swapInterval (0 = no vsync) for the threaded render loop's swap chain.
+*/
+#pragma once
+#include <QString>
+
+class QSurfaceFormat;
+
+struct PresentationPolicy {
+    enum class Mode {
+        VSync,      // Present on vertical blank; one frame per refresh at most
+        Uncapped,   // No vsync; frames as fast as data arrives (benchmarking)
+        Adaptive    // VSync, and data-driven repaints are coalesced to maxFps
+    };
+
+    Mode mode = Mode::VSync;
+    int maxFps = 60;        // Adaptive only
+    int msaaSamples = 4;
+
+    // [render] present=vsync|uncapped|adaptive, maxFps=60, msaa=4
+    static PresentationPolicy fromConfig(const QString& configPath = QStringLiteral("config.ini"));
+    static Mode modeFromString(const QString& name);
+    static const char* modeName(Mode mode);
+
+    int swapInterval() const { return mode == Mode::Uncapped ? 0 : 1; }
+    // Minimum spacing between data-driven repaints; 0 = no cap
+    qint64 minFrameInterval_ms() const;
+    void applyTo(QSurfaceFormat& format) const;
+    QString describe() const;
+};
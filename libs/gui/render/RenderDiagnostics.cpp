@@ -1,102 +1,155 @@
 /*
 Sentinel — RenderDiagnostics
-Role: Implements the logic for calculating performance metrics and building the overlay.
-Inputs/Outputs: Calculates FPS/frame times; creates/updates a QSGSimpleTextNode for the overlay.
-Threading: All code is executed on the Qt Quick render thread.
-Performance: FPS is smoothed over a sample count to provide a stable reading.
+Role: Implements the logic for calculating performance metrics and the per-stage frame breakdown.
+Inputs/Outputs: Turns stage marks into per-frame samples; averages them into FPS and sync/build/render/swap/GPU times.
+Threading: Marks run on the Qt Quick render thread; the sample ring is shared with readers under m_sampleMutex.
+Performance: Values are averaged over a 60-frame ring to provide a stable reading.
 Integration: The concrete implementation of the performance monitoring utility.
-Observability: The overlay provides direct, real-time visual feedback on performance.
+Observability: getPerformanceStats() feeds the QML performance overlay.
 Related: RenderDiagnostics.hpp.
-Assumptions: A default font is available for use by the QSGSimpleTextNode.
+Assumptions: A stage without a matching begin mark contributes zero for that frame.
 */
 #include "RenderDiagnostics.hpp"
-#include <QString>
 #include <algorithm>
 
 RenderDiagnostics::RenderDiagnostics() {
-    m_metrics.frameTimes.reserve(MAX_FRAME_SAMPLES);
-    m_metrics.frameTimer.start();
+    m_clock.start();
 }
 
 void RenderDiagnostics::startFrame() {
-    m_metrics.frameTimer.restart();
+    m_buildBegin_ns = now();
     m_bytesUploadedThisFrame = 0;
 }
 
 void RenderDiagnostics::endFrame() {
-    qint64 frameTime = m_metrics.frameTimer.nsecsElapsed() / 1000; // Convert to microseconds
-    m_metrics.lastFrameTime_us = frameTime;
-    
-    // Keep rolling window of frame times
-    m_metrics.frameTimes.push_back(frameTime);
-    if (m_metrics.frameTimes.size() > MAX_FRAME_SAMPLES) {
-        m_metrics.frameTimes.erase(m_metrics.frameTimes.begin());
+    if (m_buildBegin_ns > 0) m_pending.build_ns += now() - m_buildBegin_ns;
+    m_buildBegin_ns = 0;
+    m_totalBytesUploaded.fetch_add(m_bytesUploadedThisFrame, std::memory_order_relaxed);
+}
+
+void RenderDiagnostics::markSyncBegin() {
+    m_syncBegin_ns = now();
+}
+
+void RenderDiagnostics::markSyncEnd() {
+    if (m_syncBegin_ns > 0) m_pending.sync_ns = now() - m_syncBegin_ns;
+    m_syncBegin_ns = 0;
+}
+
+void RenderDiagnostics::markRenderBegin() {
+    m_renderBegin_ns = now();
+}
+
+void RenderDiagnostics::markRenderEnd() {
+    m_renderEnd_ns = now();
+    if (m_renderBegin_ns > 0) m_pending.render_ns = m_renderEnd_ns - m_renderBegin_ns;
+    m_renderBegin_ns = 0;
+}
+
+void RenderDiagnostics::markFrameEnd() {
+    const qint64 frameEnd = now();
+    if (m_renderEnd_ns > 0) m_pending.swap_ns = frameEnd - m_renderEnd_ns;
+    if (m_lastFrameEnd_ns > 0) m_pending.frame_ns = frameEnd - m_lastFrameEnd_ns;
+    m_lastFrameEnd_ns = frameEnd;
+    m_renderEnd_ns = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(m_sampleMutex);
+        m_samples[m_nextSample] = m_pending;
+        m_nextSample = (m_nextSample + 1) % m_samples.size();
+        m_sampleCount = std::min(m_sampleCount + 1, m_samples.size());
     }
-    
-    // Add this frame's bytes to total
-    m_totalBytesUploaded.fetch_add(m_bytesUploadedThisFrame);
+    m_pending = FrameSample{};
+}
+
+void RenderDiagnostics::recordGpuTime(double ms) {
+    m_pending.gpu_ms = ms;
 }
 
 void RenderDiagnostics::recordCacheHit() {
-    m_metrics.cacheHits++;
+    m_cacheHits.fetch_add(1, std::memory_order_relaxed);
 }
 
 void RenderDiagnostics::recordCacheMiss() {
-    m_metrics.cacheMisses++;
+    m_cacheMisses.fetch_add(1, std::memory_order_relaxed);
 }
 
 void RenderDiagnostics::recordGeometryRebuild() {
-    m_metrics.geometryRebuilds++;
+    m_geometryRebuilds.fetch_add(1, std::memory_order_relaxed);
 }
 
 void RenderDiagnostics::recordTransformApplied() {
-    m_metrics.transformsApplied++;
+    m_transformsApplied.fetch_add(1, std::memory_order_relaxed);
 }
 
 void RenderDiagnostics::recordBytesUploaded(size_t bytes) {
     m_bytesUploadedThisFrame += bytes;
 }
 
-double RenderDiagnostics::getCurrentFPS() const {
-    if (m_metrics.frameTimes.size() < 2) return 0.0;
-    
-    qint64 totalTime = 0;
-    for (qint64 time : m_metrics.frameTimes) {
-        totalTime += time;
+RenderDiagnostics::FrameBreakdown RenderDiagnostics::getFrameBreakdown() const {
+    FrameBreakdown result;
+    qint64 frame = 0, sync = 0, build = 0, render = 0, swap = 0;
+    size_t intervals = 0;
+    double gpu = 0.0;
+    size_t gpuSamples = 0;
+    size_t count = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_sampleMutex);
+        count = m_sampleCount;
+        for (size_t i = 0; i < count; ++i) {
+            const FrameSample& s = m_samples[i];
+            if (s.frame_ns > 0) { frame += s.frame_ns; ++intervals; }
+            sync += s.sync_ns;
+            build += s.build_ns;
+            render += s.render_ns;
+            swap += s.swap_ns;
+            if (s.gpu_ms >= 0.0) { gpu += s.gpu_ms; ++gpuSamples; }
+        }
     }
-    
-    return (m_metrics.frameTimes.size() - 1) * 1000000.0 / totalTime;  // Convert μs to FPS
+    if (count == 0) return result;
+
+    const double toMs = 1.0 / (1000000.0 * count);
+    result.sync_ms = sync * toMs;
+    result.build_ms = build * toMs;
+    result.render_ms = render * toMs;
+    result.swap_ms = swap * toMs;
+    if (intervals > 0) {
+        result.frame_ms = frame / (1000000.0 * intervals);
+        result.fps = result.frame_ms > 0.0 ? 1000.0 / result.frame_ms : 0.0;
+    }
+    if (gpuSamples > 0) result.gpu_ms = gpu / gpuSamples;
+    return result;
+}
+
+double RenderDiagnostics::getCurrentFPS() const {
+    return getFrameBreakdown().fps;
 }
 
 double RenderDiagnostics::getAverageRenderTime() const {
-    if (m_metrics.frameTimes.empty()) return 0.0;
-    
-    qint64 totalTime = 0;
-    for (qint64 time : m_metrics.frameTimes) {
-        totalTime += time;
-    }
-    
-    return totalTime / (m_metrics.frameTimes.size() * 1000.0);  // Convert μs to ms
+    const FrameBreakdown breakdown = getFrameBreakdown();
+    return breakdown.build_ms + breakdown.render_ms;
 }
 
 double RenderDiagnostics::getCacheHitRate() const {
-    qint64 total = m_metrics.cacheHits + m_metrics.cacheMisses;
-    return (total > 0) ? (m_metrics.cacheHits * 100.0 / total) : 0.0;
+    const qint64 hits = m_cacheHits.load(std::memory_order_relaxed);
+    const qint64 total = hits + m_cacheMisses.load(std::memory_order_relaxed);
+    return (total > 0) ? (hits * 100.0 / total) : 0.0;
 }
 
 size_t RenderDiagnostics::getTotalBytesUploaded() const {
-    return m_totalBytesUploaded.load();
+    return m_totalBytesUploaded.load(std::memory_order_relaxed);
 }
 
 QString RenderDiagnostics::getPerformanceStats() const {
-    double fps = getCurrentFPS();
-    double avgRenderTime = getAverageRenderTime();
-    double cacheHitRate = getCacheHitRate();
-    size_t totalBytes = getTotalBytesUploaded();
-    
-    return QString("FPS: %1 | Render: %2ms | Cache: %3% | Uploads: %4MB")
-        .arg(fps, 0, 'f', 1)
-        .arg(avgRenderTime, 0, 'f', 2)
-        .arg(cacheHitRate, 0, 'f', 1)
-        .arg(totalBytes / (1024.0 * 1024.0), 0, 'f', 2);
-}
\ No newline at end of file
+    const FrameBreakdown b = getFrameBreakdown();
+    const QString gpu = b.gpu_ms >= 0.0 ? QString("%1ms").arg(b.gpu_ms, 0, 'f', 2) : QStringLiteral("n/a");
+
+    return QString("FPS: %1 | Sync: %2ms | Build: %3ms | Render: %4ms | Swap: %5ms | GPU: %6 | Uploads: %7MB")
+        .arg(b.fps, 0, 'f', 1)
+        .arg(b.sync_ms, 0, 'f', 2)
+        .arg(b.build_ms, 0, 'f', 2)
+        .arg(b.render_ms, 0, 'f', 2)
+        .arg(b.swap_ms, 0, 'f', 2)
+        .arg(gpu)
+        .arg(getTotalBytesUploaded() / (1024.0 * 1024.0), 0, 'f', 2);
+}
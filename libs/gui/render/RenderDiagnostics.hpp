@@ -1,61 +1,97 @@
 /*
 Sentinel — RenderDiagnostics
 Role: Collects, calculates, and displays real-time rendering performance metrics.
-Inputs/Outputs: Takes frame event notifications; provides calculated stats and a visual overlay node.
-Threading: All methods are designed to be called only on the Qt Quick render thread.
-Performance: Calculations are lightweight to minimize impact on the render loop.
-Integration: Owned by UnifiedGridRenderer and driven by the updatePaintNode V2 implementation.
+Inputs/Outputs: Takes render-loop stage marks and frame events; provides a per-stage frame breakdown and a stats string.
+Threading: Marks and record* calls come from the Qt Quick render thread; getters may be called from any thread.
+Performance: Each mark is one clock read; samples are folded into a fixed ring under a short lock once per frame.
+Integration: Owned by UnifiedGridRenderer; fed by QQuickWindow signals (sync/render/frame end) and updatePaintNode.
 Observability: This class is the primary observability tool for the rendering pipeline.
-Related: RenderDiagnostics.cpp, UnifiedGridRenderer.h.
-Assumptions: Assumes startFrame() and endFrame() are called consistently for each frame.
+Related: RenderDiagnostics.cpp, UnifiedGridRenderer.h, PresentationPolicy.hpp.
+Assumptions: Stage marks arrive in render-loop order; a frame is closed by markFrameEnd().
 */
 #pragma once
 #include <QElapsedTimer>
-#include <vector>
+#include <QString>
+#include <array>
 #include <atomic>
+#include <mutex>
 
 class RenderDiagnostics {
 public:
+    // Averages over the sample window in milliseconds
+    struct FrameBreakdown {
+        double fps = 0.0;
+        double frame_ms = 0.0;   // Interval between frame ends
+        double sync_ms = 0.0;    // Scene graph sync (GUI thread blocked)
+        double build_ms = 0.0;   // updatePaintNode CPU time
+        double render_ms = 0.0;  // Render pass recording and submission
+        double swap_ms = 0.0;    // Present; includes the vsync wait
+        double gpu_ms = -1.0;    // GPU timestamps; negative when unavailable
+    };
+
     RenderDiagnostics();
-    
+
+    // Item-level CPU time (updatePaintNode)
     void startFrame();
     void endFrame();
-    
-    void recordCacheHit();  
+
+    // Render-loop stages, in order
+    void markSyncBegin();
+    void markSyncEnd();
+    void markRenderBegin();
+    void markRenderEnd();
+    void markFrameEnd();
+    void recordGpuTime(double ms);
+
+    void recordCacheHit();
     void recordCacheMiss();
     void recordGeometryRebuild();
     void recordTransformApplied();
     void recordBytesUploaded(size_t bytes);
-    
+
+    FrameBreakdown getFrameBreakdown() const;
     double getCurrentFPS() const;
     double getAverageRenderTime() const;
     double getCacheHitRate() const;
     size_t getTotalBytesUploaded() const;
-    
-    bool isOverlayEnabled() const { return m_showOverlay; }
-    void toggleOverlay() { m_showOverlay = !m_showOverlay; }
-    
+
+    bool isOverlayEnabled() const { return m_showOverlay.load(std::memory_order_relaxed); }
+    void toggleOverlay() { m_showOverlay.store(!m_showOverlay.load(std::memory_order_relaxed), std::memory_order_relaxed); }
+
     QString getPerformanceStats() const;
-    
+
 private:
-    struct PerformanceMetrics {
-        QElapsedTimer frameTimer;
-        std::vector<qint64> frameTimes;  // Last 60 frame times in microseconds
-        qint64 lastFrameTime_us = 0;
-        qint64 renderTime_us = 0;
-        qint64 cacheHits = 0;
-        qint64 cacheMisses = 0;
-        qint64 geometryRebuilds = 0;
-        qint64 transformsApplied = 0;
-        size_t cachedCellCount = 0;
-        bool showOverlay = false;
+    struct FrameSample {
+        qint64 frame_ns = 0;
+        qint64 sync_ns = 0;
+        qint64 build_ns = 0;
+        qint64 render_ns = 0;
+        qint64 swap_ns = 0;
+        double gpu_ms = -1.0;
     };
-    
-    mutable PerformanceMetrics m_metrics;
-    mutable size_t m_bytesUploadedThisFrame = 0;
-    mutable std::atomic<size_t> m_totalBytesUploaded{0};
-    bool m_showOverlay = false;
-    
-    static constexpr double PCIE_BUDGET_MB_PER_SECOND = 200.0;
-    static constexpr size_t MAX_FRAME_SAMPLES = 60;
-};
\ No newline at end of file
+
+    qint64 now() const { return m_clock.nsecsElapsed(); }
+
+    QElapsedTimer m_clock;
+
+    // Render thread only: marks for the frame in flight
+    qint64 m_syncBegin_ns = 0;
+    qint64 m_renderBegin_ns = 0;
+    qint64 m_renderEnd_ns = 0;
+    qint64 m_buildBegin_ns = 0;
+    qint64 m_lastFrameEnd_ns = 0;
+    FrameSample m_pending;
+    size_t m_bytesUploadedThisFrame = 0;
+
+    mutable std::mutex m_sampleMutex;
+    std::array<FrameSample, 60> m_samples;  // Ring of closed frames
+    size_t m_sampleCount = 0;
+    size_t m_nextSample = 0;
+
+    std::atomic<qint64> m_cacheHits{0};
+    std::atomic<qint64> m_cacheMisses{0};
+    std::atomic<qint64> m_geometryRebuilds{0};
+    std::atomic<qint64> m_transformsApplied{0};
+    std::atomic<size_t> m_totalBytesUploaded{0};
+    std::atomic<bool> m_showOverlay{false};
+};
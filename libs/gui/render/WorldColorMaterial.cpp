@@ -0,0 +1,71 @@
+/*
+Sentinel — WorldColorMaterial
+Role: Implements the world-space vertex-color material, its shader and the vertex attribute layout.
+Inputs/Outputs: Writes qt_Matrix, qt_Opacity and the grid mapping into the uniform block.
+Threading: Render thread only.
+Performance: Materials with the same mapping compare equal so layers sharing a viewport batch together.
+Integration: See WorldColorMaterial.hpp.
+Observability: No internal logging.
+Related: WorldColorMaterial.hpp, WorldSpaceMaterial.cpp, shaders/worldcolor.vert, shaders/worldcolor.frag.
+Assumptions: Uniform block layout (std140): mat4 at 0, opacity at 64, vec4 grid at 80.
+*/
+#include "WorldColorMaterial.hpp"
+#include <QSGMaterialShader>
+#include <cstring>
+
+namespace {
+    class WorldColorMaterialShader : public QSGMaterialShader {
+    public:
+        WorldColorMaterialShader() {
+            setShaderFileName(VertexStage, QStringLiteral(":/sentinel/shaders/worldcolor.vert.qsb"));
+            setShaderFileName(FragmentStage, QStringLiteral(":/sentinel/shaders/worldcolor.frag.qsb"));
+        }
+
+        bool updateUniformData(RenderState& state, QSGMaterial* newMaterial, QSGMaterial* oldMaterial) override {
+            Q_UNUSED(oldMaterial)
+            QByteArray* buf = state.uniformData();
+            if (state.isMatrixDirty()) {
+                const QMatrix4x4 m = state.combinedMatrix();
+                std::memcpy(buf->data(), m.constData(), 64);
+            }
+            if (state.isOpacityDirty()) {
+                const float opacity = state.opacity();
+                std::memcpy(buf->data() + 64, &opacity, 4);
+            }
+            // The same material object may come back with a new viewport, so always write the mapping
+            const QVector4D& grid = static_cast<WorldColorMaterial*>(newMaterial)->screenMapping();
+            const float mapping[4] = {grid.x(), grid.y(), grid.z(), grid.w()};
+            std::memcpy(buf->data() + 80, mapping, 16);
+            return true;
+        }
+    };
+}
+
+WorldColorMaterial::WorldColorMaterial() {
+    // Positions are grid offsets, not item coordinates the batch renderer could pre-transform
+    setFlag(Blending | RequiresFullMatrix);
+}
+
+const QSGGeometry::AttributeSet& WorldColorMaterial::attributes() {
+    static const QSGGeometry::Attribute attrs[] = {
+        QSGGeometry::Attribute::createWithAttributeType(0, 2, QSGGeometry::FloatType, QSGGeometry::UnknownAttribute),
+        QSGGeometry::Attribute::createWithAttributeType(1, 2, QSGGeometry::FloatType, QSGGeometry::UnknownAttribute),
+        QSGGeometry::Attribute::createWithAttributeType(2, 4, QSGGeometry::UnsignedByteType, QSGGeometry::ColorAttribute),
+    };
+    static const QSGGeometry::AttributeSet set = {3, sizeof(Vertex), attrs};
+    return set;
+}
+
+QSGMaterialType* WorldColorMaterial::type() const {
+    static QSGMaterialType type;
+    return &type;
+}
+
+QSGMaterialShader* WorldColorMaterial::createShader(QSGRendererInterface::RenderMode renderMode) const {
+    Q_UNUSED(renderMode)
+    return new WorldColorMaterialShader;
+}
+
+int WorldColorMaterial::compare(const QSGMaterial* other) const {
+    return compareMapping(static_cast<const WorldColorMaterial*>(other));
+}
@@ -0,0 +1,39 @@
+/*
+Sentinel — WorldColorMaterial
+Role: Vertex-colored scene-graph material whose positions are world offsets (plus an optional pixel offset) mapped on the GPU.
+Inputs/Outputs: Vertices carry a world offset from the node's grid origin, a screen-pixel offset and an RGBA8 color.
+Threading: Created, updated and rendered on the Qt Quick render thread.
+Performance: Pan/zoom updates one uniform per node; vertices are only written when the underlying data changes.
+Integration: Used by TradeFlowStrategy (world rectangles) and TradeBubbleStrategy (world centers with pixel-sized discs).
+Observability: No internal logging.
+Related: WorldColorMaterial.cpp, WorldSpaceMaterial.hpp, shaders/worldcolor.vert, shaders/worldcolor.frag.
+Assumptions: Colors follow QSGVertexColorMaterial semantics (passed through, multiplied by opacity).
+*/
+#pragma once
+#include "WorldSpaceMaterial.hpp"
+#include <QSGGeometry>
+#include <cstdint>
+
+class WorldColorMaterial : public WorldSpaceMaterial {
+public:
+    struct Vertex {
+        float wx, wy;        // World offset from the grid origin, in grid steps
+        float px, py;        // Screen-pixel offset added after mapping (bubble radius); 0 for world rectangles
+        uint8_t r, g, b, a;
+
+        void set(float nwx, float nwy, float npx, float npy, int nr, int ng, int nb, int na) {
+            wx = nwx; wy = nwy; px = npx; py = npy;
+            r = static_cast<uint8_t>(nr); g = static_cast<uint8_t>(ng);
+            b = static_cast<uint8_t>(nb); a = static_cast<uint8_t>(na);
+        }
+    };
+    static_assert(sizeof(Vertex) == 20, "WorldColorMaterial::Vertex must stay tightly packed");
+
+    WorldColorMaterial();
+
+    static const QSGGeometry::AttributeSet& attributes();
+
+    QSGMaterialType* type() const override;
+    QSGMaterialShader* createShader(QSGRendererInterface::RenderMode renderMode) const override;
+    int compare(const QSGMaterial* other) const override;
+};
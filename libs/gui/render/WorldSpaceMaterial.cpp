@@ -0,0 +1,50 @@
+/*
+Sentinel — WorldSpaceMaterial
+Role: Implements the grid → screen mapping shared by world-space materials.
+Inputs/Outputs: Viewport in; vec4 (origin x, origin y, step x, step y) in item pixels out.
+Threading: Render thread only.
+Performance: Mapping is computed in double precision once per node, so the shader needs one multiply-add per axis.
+Integration: See WorldSpaceMaterial.hpp.
+Observability: No internal logging.
+Related: WorldSpaceMaterial.hpp, CoordinateSystem.cpp.
+Assumptions: Layers only contain geometry nodes whose material derives from WorldSpaceMaterial.
+*/
+#include "WorldSpaceMaterial.hpp"
+#include "../CoordinateSystem.h"
+#include <QSGGeometryNode>
+
+void WorldSpaceMaterial::setViewport(const Viewport& viewport) {
+    const double timeSpan = static_cast<double>(viewport.timeEnd_ms - viewport.timeStart_ms);
+    const double priceSpan = viewport.priceMax - viewport.priceMin;
+    if (timeSpan <= 0.0 || priceSpan <= 0.0) return;
+
+    // Same mapping as CoordinateSystem::worldToScreen, expressed per grid step
+    const double sx = viewport.width / timeSpan;
+    const double sy = viewport.height / priceSpan;
+    m_screenMapping = QVector4D(
+        static_cast<float>(static_cast<double>(m_grid.originTime_ms - viewport.timeStart_ms) * sx),
+        static_cast<float>((viewport.priceMax - m_grid.originPrice) * sy),
+        static_cast<float>(static_cast<double>(m_grid.timeStep_ms) * sx),
+        static_cast<float>(-m_grid.priceStep * sy));
+}
+
+void WorldSpaceMaterial::applyViewport(QSGNode* layer, const Viewport& viewport) {
+    if (!layer) return;
+    auto remap = [&viewport](QSGNode* node) {
+        if (node->type() != QSGNode::GeometryNodeType) return;
+        auto* geometryNode = static_cast<QSGGeometryNode*>(node);
+        static_cast<WorldSpaceMaterial*>(geometryNode->material())->setViewport(viewport);
+        geometryNode->markDirty(QSGNode::DirtyMaterial);
+    };
+    remap(layer);
+    for (QSGNode* child = layer->firstChild(); child; child = child->nextSibling()) {
+        remap(child);
+    }
+}
+
+int WorldSpaceMaterial::compareMapping(const WorldSpaceMaterial* other) const {
+    for (int i = 0; i < 4; ++i) {
+        if (m_screenMapping[i] != other->m_screenMapping[i]) return m_screenMapping[i] < other->m_screenMapping[i] ? -1 : 1;
+    }
+    return 0;
+}
@@ -0,0 +1,46 @@
+/*
+Sentinel — WorldSpaceMaterial
+Role: Base for scene-graph materials whose vertices are stored in world units relative to a per-node grid origin.
+Inputs/Outputs: Holds the node's world grid (origin time/price and step sizes) and the grid → item-pixel mapping derived from a Viewport.
+Threading: Created, updated and rendered on the Qt Quick render thread.
+Performance: A viewport change rewrites one vec4 per node instead of every vertex.
+Integration: Derived by HeatmapMaterial and WorldColorMaterial; layers are re-mapped through applyViewport().
+Observability: No internal logging.
+Related: WorldSpaceMaterial.cpp, HeatmapMaterial.hpp, WorldColorMaterial.hpp, CoordinateSystem.h.
+Assumptions: Offsets from the grid origin stay small enough for float precision (epoch-relative time, base-relative price).
+*/
+#pragma once
+#include <QSGMaterial>
+#include <QVector4D>
+#include <cstdint>
+
+class QSGNode;
+struct Viewport;
+
+class WorldSpaceMaterial : public QSGMaterial {
+public:
+    // World placement of grid coordinate (0, 0) and the world size of one grid unit
+    struct Grid {
+        int64_t originTime_ms = 0;
+        int64_t timeStep_ms = 1;
+        double originPrice = 0.0;
+        double priceStep = 1.0;
+    };
+
+    void setGrid(const Grid& grid) { m_grid = grid; }
+    const Grid& grid() const { return m_grid; }
+
+    // Recomputes the grid → item-pixel mapping (origin x/y, step x/y) used by the vertex shader
+    void setViewport(const Viewport& viewport);
+    const QVector4D& screenMapping() const { return m_screenMapping; }
+
+    // Re-maps every world-space geometry node in a strategy layer (the node itself or its direct children)
+    static void applyViewport(QSGNode* layer, const Viewport& viewport);
+
+protected:
+    int compareMapping(const WorldSpaceMaterial* other) const;
+
+private:
+    Grid m_grid;
+    QVector4D m_screenMapping{0.0f, 0.0f, 1.0f, 1.0f};
+};
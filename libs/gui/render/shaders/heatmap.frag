@@ -0,0 +1,23 @@
+#version 440
+// Sentinel — heatmap cell fragment shader. Maps scaled intensity through the theme ramp (row 0 bid, row 1 ask).
+
+layout(location = 0) in float vValue;
+
+layout(location = 0) out vec4 fragColor;
+
+layout(std140, binding = 0) uniform buf {
+    mat4 qt_Matrix;
+    float qt_Opacity;
+    float intensityScale;
+    vec4 grid;
+};
+
+layout(binding = 1) uniform sampler2D ramp;
+
+void main()
+{
+    float intensity = clamp(abs(vValue) * intensityScale, 0.0, 1.0);
+    float u = (intensity * 1023.0 + 0.5) / 1024.0;  // Texel centers of the ColorRamp::kSize table
+    float row = vValue < 0.0 ? 0.75 : 0.25;
+    fragColor = texture(ramp, vec2(u, row)) * qt_Opacity;
+}
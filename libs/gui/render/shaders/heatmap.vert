@@ -0,0 +1,24 @@
+#version 440
+// Sentinel — heatmap cell vertex shader. Cell corners arrive as biased 16-bit grid indices split into
+// UNorm bytes; grid.xy is the item-pixel position of index (0, 0) and grid.zw the size of one step.
+// value = log1p(liquidity), signed by side (>= 0 bid, < 0 ask).
+
+layout(location = 0) in vec4 cellIndex;
+layout(location = 1) in float value;
+
+layout(location = 0) out float vValue;
+
+layout(std140, binding = 0) uniform buf {
+    mat4 qt_Matrix;
+    float qt_Opacity;
+    float intensityScale;
+    vec4 grid;
+};
+
+void main()
+{
+    vec4 bytes = floor(cellIndex * 255.0 + 0.5);
+    vec2 index = vec2(bytes.x + bytes.y * 256.0, bytes.z + bytes.w * 256.0) - 32768.0;
+    vValue = value;
+    gl_Position = qt_Matrix * vec4(grid.xy + index * grid.zw, 0.0, 1.0);
+}
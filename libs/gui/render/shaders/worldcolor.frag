@@ -0,0 +1,17 @@
+#version 440
+// Sentinel — world-space vertex-color fragment shader (same output as QSGVertexColorMaterial).
+
+layout(location = 0) in vec4 color;
+
+layout(location = 0) out vec4 fragColor;
+
+layout(std140, binding = 0) uniform buf {
+    mat4 qt_Matrix;
+    float qt_Opacity;
+    vec4 grid;
+};
+
+void main()
+{
+    fragColor = color;
+}
@@ -0,0 +1,22 @@
+#version 440
+// Sentinel — world-space vertex-color shader. worldPos is an offset from the node's grid origin in grid steps;
+// grid.xy is the item-pixel position of the origin and grid.zw the size of one step. pixelOffset is added after
+// mapping so screen-sized shapes (trade bubbles) keep their size under zoom.
+
+layout(location = 0) in vec2 worldPos;
+layout(location = 1) in vec2 pixelOffset;
+layout(location = 2) in vec4 vertexColor;
+
+layout(location = 0) out vec4 color;
+
+layout(std140, binding = 0) uniform buf {
+    mat4 qt_Matrix;
+    float qt_Opacity;
+    vec4 grid;
+};
+
+void main()
+{
+    color = vertexColor * qt_Opacity;
+    gl_Position = qt_Matrix * vec4(grid.xy + worldPos * grid.zw + pixelOffset, 0.0, 1.0);
+}
@@ -28,9 +28,9 @@ QSGNode* CandleStrategy::buildNode(const GridSliceBatch& batch) {
     node->setMaterial(material);
     node->setFlag(QSGNode::OwnsMaterial);
     
-    // Calculate required vertex count (6 vertices per candle for 2 triangles)
+    // One quad (two triangles) per candle
     int cellCount = std::min(static_cast<int>(batch.cells.size()), batch.maxCells);
-    int vertexCount = cellCount * 6;
+    int vertexCount = cellCount * kVerticesPerQuad;
     
     // Create geometry
     auto* geometry = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), vertexCount);
@@ -41,6 +41,7 @@ QSGNode* CandleStrategy::buildNode(const GridSliceBatch& batch) {
     // Fill vertex buffer
     auto* vertices = static_cast<QSGGeometry::ColoredPoint2D*>(geometry->vertexData());
     int vertexIndex = 0;
+    const ColorRamp& ramp = colorRamp();
     
     for (int i = 0; i < cellCount; ++i) {
         const auto& cell = batch.cells[i];
@@ -48,9 +49,10 @@ QSGNode* CandleStrategy::buildNode(const GridSliceBatch& batch) {
         // Skip cells with insufficient volume
         if (cell.liquidity < batch.minVolumeFilter) continue;
         
-        // Calculate color with intensity scaling
+        // Calculate color with intensity scaling (theme ramp lookup)
         double scaledIntensity = calculateIntensity(cell.liquidity, batch.intensityScale);
-        QColor color = calculateColor(cell.liquidity, cell.isBid, scaledIntensity);
+        const ColorRamp::Rgba& color = ramp.sample(cell.isBid ? RampPalette::CandleBull : RampPalette::CandleBear,
+                                                    scaledIntensity);
         
         // Convert world→screen to derive base rectangle
         QPointF topLeft = CoordinateSystem::worldToScreen(cell.timeStart_ms, cell.priceMax, batch.viewport);
@@ -65,15 +67,7 @@ QSGNode* CandleStrategy::buildNode(const GridSliceBatch& batch) {
         float top = baseTop;
         float bottom = baseBottom;
         
-        // Triangle 1: top-left, top-right, bottom-left
-        vertices[vertexIndex++].set(left, top, color.red(), color.green(), color.blue(), color.alpha());
-        vertices[vertexIndex++].set(right, top, color.red(), color.green(), color.blue(), color.alpha());
-        vertices[vertexIndex++].set(left, bottom, color.red(), color.green(), color.blue(), color.alpha());
-        
-        // Triangle 2: top-right, bottom-right, bottom-left
-        vertices[vertexIndex++].set(right, top, color.red(), color.green(), color.blue(), color.alpha());
-        vertices[vertexIndex++].set(right, bottom, color.red(), color.green(), color.blue(), color.alpha());
-        vertices[vertexIndex++].set(left, bottom, color.red(), color.green(), color.blue(), color.alpha());
+        emitQuad(vertices, vertexIndex, left, top, right, bottom, color);
     }
     
     // Update geometry with actual vertex count used
@@ -84,19 +78,8 @@ QSGNode* CandleStrategy::buildNode(const GridSliceBatch& batch) {
 }
 
 QColor CandleStrategy::calculateColor(double liquidity, bool isBid, double intensity) const {
-    double alpha = std::min(intensity * 0.85, 1.0);
-    
-    if (isBid) {
-        // Bullish candles: Green spectrum with yellow highlights
-        double green = std::min(255.0 * intensity, 255.0);
-        double yellow = std::min(100.0 * intensity, 100.0);
-        return QColor(static_cast<int>(yellow), static_cast<int>(green), 0, static_cast<int>(alpha * 255));
-    } else {
-        // Bearish candles: Red spectrum with orange highlights
-        double red = std::min(255.0 * intensity, 255.0);
-        double orange = std::min(80.0 * intensity, 80.0);
-        return QColor(static_cast<int>(red), static_cast<int>(orange), 0, static_cast<int>(alpha * 255));
-    }
+    Q_UNUSED(liquidity)
+    return colorRamp().color(isBid ? RampPalette::CandleBull : RampPalette::CandleBear, intensity);
 }
 
 QColor CandleStrategy::getBullishColor(double intensity) const {
@@ -0,0 +1,124 @@
+/*
+Sentinel — FootprintStrategy
+Role: Implements footprint rendering: split bid/ask quads per cell, POC marker, zoom-gated labels.
+Inputs/Outputs: Builds a QSGNode with a cell geometry child and (when zoomed in) a glyph child.
+Threading: All code is executed on the Qt Quick render thread.
+Performance: Cells arrive pre-aggregated to screen-sized rows, so vertex count tracks the viewport.
+Integration: The concrete implementation of the footprint visualization strategy.
+Observability: No internal logging.
+Related: FootprintStrategy.hpp, GlyphAtlas.hpp.
+Assumptions: Label text uses the atlas charset (digits, '.', 'k', 'M').
+*/
+#include "FootprintStrategy.hpp"
+#include "../GlyphAtlas.hpp"
+#include "../GridTypes.hpp"
+#include "../../CoordinateSystem.h"
+#include <QSGGeometryNode>
+#include <QSGVertexColorMaterial>
+#include <QSGGeometry>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr int kMaxLabelledCells = 4000;  // Keep glyph geometry bounded when zoomed in on busy bars
+}
+
+FootprintStrategy::FootprintStrategy() = default;
+FootprintStrategy::~FootprintStrategy() = default;
+
+QSGNode* FootprintStrategy::buildNode(const GridSliceBatch& batch) {
+    if (!batch.footprintCells) return nullptr;
+    const auto& cells = *batch.footprintCells;
+    const Viewport& vp = batch.viewport;
+    if (cells.empty() || vp.width <= 0.0 || vp.height <= 0.0) return nullptr;
+    
+    double maxSideVolume = 0.0;
+    for (const auto& cell : cells) {
+        maxSideVolume = std::max({maxSideVolume, cell.bidVolume, cell.askVolume});
+    }
+    if (maxSideVolume <= 0.0) return nullptr;
+    
+    // Bid half, ask half, and a POC marker per cell at most
+    int pocCount = 0;
+    for (const auto& cell : cells) pocCount += cell.isPoc ? 1 : 0;
+    const int quadCount = static_cast<int>(cells.size()) * 2 + pocCount;
+    
+    auto* root = new QSGNode;
+    auto* cellNode = new QSGGeometryNode;
+    auto* material = new QSGVertexColorMaterial;
+    material->setFlag(QSGMaterial::Blending);
+    cellNode->setMaterial(material);
+    cellNode->setFlag(QSGNode::OwnsMaterial);
+    
+    auto* geometry = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), quadCount * kVerticesPerQuad);
+    geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+    cellNode->setGeometry(geometry);
+    cellNode->setFlag(QSGNode::OwnsGeometry);
+    
+    auto* vertices = static_cast<QSGGeometry::ColoredPoint2D*>(geometry->vertexData());
+    int vertexIndex = 0;
+    
+    // All cells share the bar width and row height of this batch
+    const QPointF probeTL = CoordinateSystem::worldToScreen(cells.front().timeStart_ms, cells.front().priceMax, vp);
+    const QPointF probeBR = CoordinateSystem::worldToScreen(cells.front().timeEnd_ms, cells.front().priceMin, vp);
+    const double barPx = probeBR.x() - probeTL.x();
+    const double rowPx = probeBR.y() - probeTL.y();
+    const bool drawLabels = m_window && rowPx >= kMinLabelRowPx && barPx >= kMinLabelBarPx &&
+                            static_cast<int>(cells.size()) <= kMaxLabelledCells;
+    
+    if (drawLabels) {
+        if (!m_atlas) m_atlas = std::make_unique<GlyphAtlas>();
+        m_atlas->beginText();
+    }
+    
+    for (const auto& cell : cells) {
+        const QPointF tl = CoordinateSystem::worldToScreen(cell.timeStart_ms, cell.priceMax, vp);
+        const QPointF br = CoordinateSystem::worldToScreen(cell.timeEnd_ms, cell.priceMin, vp);
+        const float left = static_cast<float>(tl.x()) + 1.0f;
+        const float right = std::max(left + 1.0f, static_cast<float>(br.x()) - 1.0f);
+        const float top = static_cast<float>(tl.y());
+        const float bottom = std::max(top + 1.0f, static_cast<float>(br.y()) - (rowPx > 3.0 ? 1.0f : 0.0f));
+        const float mid = (left + right) * 0.5f;
+        
+        emitQuad(vertices, vertexIndex, left, top, mid, bottom,
+                 calculateColor(cell.bidVolume, true, cell.bidVolume / maxSideVolume));
+        emitQuad(vertices, vertexIndex, mid, top, right, bottom,
+                 calculateColor(cell.askVolume, false, cell.askVolume / maxSideVolume));
+        if (cell.isPoc) {
+            emitQuad(vertices, vertexIndex, left - 1.0f, top, left + 1.0f, bottom, QColor(255, 215, 0, 230));
+        }
+        
+        if (drawLabels) {
+            const float textY = top + (bottom - top - m_atlas->glyphHeight()) * 0.5f;
+            const QString bidText = formatVolume(cell.bidVolume);
+            const QString askText = formatVolume(cell.askVolume);
+            m_atlas->addText(bidText, mid - 3.0f - m_atlas->textWidth(bidText), textY);
+            m_atlas->addText(askText, mid + 3.0f, textY);
+        }
+    }
+    
+    cellNode->markDirty(QSGNode::DirtyGeometry);
+    root->appendChildNode(cellNode);
+    
+    if (drawLabels) {
+        if (QSGGeometryNode* textNode = m_atlas->buildTextNode(m_window)) {
+            root->appendChildNode(textNode);
+        }
+    }
+    return root;
+}
+
+QColor FootprintStrategy::calculateColor(double liquidity, bool isBid, double intensity) const {
+    if (liquidity <= 0.0) return QColor(40, 40, 40, 60);
+    // isBid: sell aggression into the bid (red); otherwise buy aggression into the ask (green)
+    return colorRamp().color(isBid ? RampPalette::FootprintSell : RampPalette::FootprintBuy, intensity);
+}
+
+QString FootprintStrategy::formatVolume(double volume) {
+    if (volume <= 0.0) return QStringLiteral("0");
+    if (volume < 10.0) return QString::number(volume, 'f', 2);
+    if (volume < 100.0) return QString::number(volume, 'f', 1);
+    if (volume < 1000.0) return QString::number(volume, 'f', 0);
+    if (volume < 1e6) return QString::number(volume / 1000.0, 'f', 1) + QLatin1Char('k');
+    return QString::number(volume / 1e6, 'f', 1) + QLatin1Char('M');
+}
@@ -0,0 +1,39 @@
+/*
+Sentinel — FootprintStrategy
+Role: A render strategy that draws footprint cells (bid x ask volume per bar/price row).
+Inputs/Outputs: Implements IRenderStrategy to turn GridSliceBatch::footprintCells into colored quads plus optional labels.
+Threading: Methods are called exclusively on the Qt Quick render thread.
+Performance: One vertex-color node for all cells and one textured node for all glyphs (GlyphAtlas).
+Integration: Owned by UnifiedGridRenderer and layered by GridSceneNode as an overlay.
+Observability: No internal logging.
+Related: FootprintStrategy.cpp, FootprintEngine.h, GlyphAtlas.hpp, IRenderStrategy.hpp.
+Assumptions: setWindow() is called before buildNode() when labels are wanted.
+*/
+#pragma once
+#include "../IRenderStrategy.hpp"
+#include <memory>
+
+class GlyphAtlas;
+class QQuickWindow;
+
+class FootprintStrategy : public IRenderStrategy {
+public:
+    FootprintStrategy();
+    ~FootprintStrategy() override;
+    
+    QSGNode* buildNode(const GridSliceBatch& batch) override;
+    QColor calculateColor(double liquidity, bool isBid, double intensity) const override;
+    const char* getStrategyName() const override { return "Footprint"; }
+    
+    void setWindow(QQuickWindow* window) { m_window = window; }
+    
+    // Labels are drawn only when a row/bar is at least this large on screen
+    static constexpr double kMinLabelRowPx = 11.0;
+    static constexpr double kMinLabelBarPx = 56.0;
+    
+private:
+    static QString formatVolume(double volume);
+    
+    QQuickWindow* m_window = nullptr;
+    std::unique_ptr<GlyphAtlas> m_atlas;  // Created on first labelled frame
+};
@@ -1,147 +1,235 @@
 /*
 Sentinel — HeatmapStrategy
 Role: Implements the logic for rendering a liquidity heatmap from grid cell data.
-Inputs/Outputs: Creates a QSGGeometryNode where each cell is a pair of colored triangles.
+Inputs/Outputs: Creates QSGGeometryNode chunks where each cell is an indexed quad of packed grid corners shaded by HeatmapMaterial.
 Threading: All code is executed on the Qt Quick render thread.
-Performance: Uses a QSGVertexColorMaterial for efficient rendering of per-vertex colored geometry.
+Performance: 44 bytes per cell (4 packed vertices + 6 16-bit indices); placement and coloring run in the shader, recoloring is a uniform update.
+             Live-column updates rewrite only the value field of the changed slots' vertices; new levels append a chunk.
 Integration: The concrete implementation of the heatmap visualization strategy.
 Observability: No internal logging.
 Related: HeatmapStrategy.hpp.
-Assumptions: Liquidity intensity is represented by the alpha channel of the vertex color.
+Assumptions: Cell edges within a chunk share a common time step and tick size; intensity is log1p(liquidity) * intensityScale, clamped in the shader.
 */
 #include "HeatmapStrategy.hpp"
 #include "../GridTypes.hpp"
-#include "../../CoordinateSystem.h"
+#include "../HeatmapMaterial.hpp"
 #include "../../../core/SentinelLogging.hpp"
 #include <QSGGeometryNode>
-#include <QSGVertexColorMaterial>
-#include <QSGFlatColorMaterial>
 #include <QSGGeometry>
+#include <QSGTexture>
+#include <QQuickWindow>
 #include <algorithm>
+#include <cmath>
+#include <numeric>
 #include <vector>
-// #include <iostream>
 
+HeatmapStrategy::~HeatmapStrategy() {
+    // Textures belong to the render thread; let Qt dispose of it there
+    if (m_rampTexture) {
+        m_rampTexture->deleteLater();
+    }
+}
 
-QSGNode* HeatmapStrategy::buildNode(const GridSliceBatch& batch) {
+QSGTexture* HeatmapStrategy::rampTexture() {
+    if (m_rampTexture && m_textureWindow == m_window && m_textureRamp == m_colorRamp) return m_rampTexture;
+    if (!m_window) return nullptr;
 
-    /*
-        Build a GPU scene graph node for rendering the heatmap. 
-        Take our CellInstance data and convert them to colored triangles in world space.
-    */
+    if (m_rampTexture) {
+        m_rampTexture->deleteLater();
+    }
+    m_rampTexture = m_window->createTextureFromImage(
+        colorRamp().pairImage(RampPalette::HeatmapBid, RampPalette::HeatmapAsk));
+    m_textureWindow = m_window;
+    m_textureRamp = m_colorRamp;
+    if (m_rampTexture) {
+        m_rampTexture->setFiltering(QSGTexture::Linear);
+        m_rampTexture->setHorizontalWrapMode(QSGTexture::ClampToEdge);
+        m_rampTexture->setVerticalWrapMode(QSGTexture::ClampToEdge);
+    }
+    return m_rampTexture;
+}
 
-    if (batch.cells.empty()) {
-        sLog_Render(" HEATMAP EXIT: Returning nullptr - batch is empty");
-        return nullptr;
+void HeatmapStrategy::applyMaterialState(QSGNode* layer, double intensityScale) {
+    if (!layer) return;
+    QSGTexture* ramp = rampTexture();
+    for (QSGNode* child = layer->firstChild(); child; child = child->nextSibling()) {
+        if (child->type() != QSGNode::GeometryNodeType) continue;
+        auto* node = static_cast<QSGGeometryNode*>(child);
+        auto* material = static_cast<HeatmapMaterial*>(node->material());
+        material->setRamp(ramp);
+        material->setIntensityScale(static_cast<float>(intensityScale));
+        node->markDirty(QSGNode::DirtyMaterial);
     }
+}
 
-    // Calculate required vertex count window (6 vertices per cell for 2 triangles)
-    int total = static_cast<int>(batch.cells.size());
-    int cellCount = std::min(total, batch.maxCells);
-    int startIndex = std::max(0, total - cellCount); // keep newest when clipping
+bool HeatmapStrategy::applyViewport(QSGNode* layer, const Viewport& viewport) {
+    if (!layer || !viewportWithin(viewport, m_builtViewport)) return false;
+    WorldSpaceMaterial::applyViewport(layer, viewport);
+    return true;
+}
 
-    // First pass: count how many cells pass the min volume filter
-    int keptCells = 0;
-    for (int i = 0; i < cellCount; ++i) {
-        const auto& cell = batch.cells[startIndex + i];
-        if (cell.liquidity >= batch.minVolumeFilter) {
-            ++keptCells;
-        }
+namespace {
+    bool keepCell(const CellInstance& cell, double minVolumeFilter) {
+        return cell.liquidity > 0.0 && cell.liquidity >= minVolumeFilter && cell.timeEnd_ms > cell.timeStart_ms && cell.priceMax > cell.priceMin;
     }
-    if (keptCells == 0) {
-        sLog_Render(" HEATMAP EXIT: No cells above minVolumeFilter");
-        return nullptr;
+
+    // Unscaled log liquidity; the side picks the ramp row (ask = negative)
+    float cellValue(const CellInstance& cell) {
+        const float logLiquidity = cell.liquidity > 0.0 ? static_cast<float>(std::log1p(cell.liquidity)) : 0.0f;
+        return cell.isBid ? logLiquidity : -logLiquidity;
     }
 
-    // Windows/ANGLE can enforce 16-bit index limits. Keep each geometry node under
-    // a safe vertex threshold to avoid wrapping/overpaint artifacts.
-    static constexpr int kMaxVerticesPerNode = 60000; // safety margin under 65535
-    static constexpr int kVertsPerCell = 6;
-    const int cellsPerChunk = std::max(1, kMaxVerticesPerNode / kVertsPerCell);
+    void clearChildren(QSGNode* container) {
+        while (QSGNode* child = container->firstChild()) {
+            container->removeChildNode(child);
+            delete child;
+        }
+    }
+}
 
-    // Root container holding one or more geometry chunks
-    auto* root = new QSGNode;
+int HeatmapStrategy::appendChunks(QSGNode* root, const std::vector<const CellInstance*>& cells, QSGTexture* ramp,
+                                  double intensityScale, const Viewport& viewport, std::vector<ChunkSlot>* slots) {
+    // 16-bit index buffers: keep each geometry node under 65535 vertices
+    static constexpr int kMaxVerticesPerNode = 60000; // safety margin under 65535
+    static constexpr int kIndicesPerCell = 6;
+    const size_t cellsPerChunk = kMaxVerticesPerNode / kVertsPerCell;
+    constexpr int64_t kMaxIndex = HeatmapMaterial::kMaxGridIndex;
 
-    int producedKeptCells = 0;
-    int streamPos = 0; // relative to startIndex
-    int totalVerticesDrawn = 0;
+    if (slots) slots->resize(cells.size());
 
-    while (producedKeptCells < keptCells) {
-        const int remaining = keptCells - producedKeptCells;
-        const int targetCells = std::min(cellsPerChunk, remaining);
+    size_t chunkStart = 0;
+    int totalVertices = 0;
 
-        // Collect up to targetCells that pass the filter for this chunk
-        std::vector<const CellInstance*> chunkCells;
-        chunkCells.reserve(targetCells);
+    while (chunkStart < cells.size()) {
+        // Grow the chunk while every corner stays within the packed grid around its first cell
+        const CellInstance& first = *cells[chunkStart];
+        WorldSpaceMaterial::Grid grid;
+        grid.originTime_ms = first.timeStart_ms;
+        grid.originPrice = first.priceMin;
+        grid.priceStep = first.priceMax - first.priceMin;
 
-        for (; streamPos < cellCount && static_cast<int>(chunkCells.size()) < targetCells; ++streamPos) {
-            const auto& c = batch.cells[startIndex + streamPos];
-            if (c.liquidity >= batch.minVolumeFilter) {
-                chunkCells.push_back(&c);
+        int64_t timeStep = 0;
+        int64_t maxTimeOffset = 0;
+        size_t chunkEnd = chunkStart;
+        for (; chunkEnd < cells.size() && chunkEnd - chunkStart < cellsPerChunk; ++chunkEnd) {
+            const CellInstance& c = *cells[chunkEnd];
+            const int64_t startOffset = c.timeStart_ms - grid.originTime_ms;
+            const int64_t endOffset = c.timeEnd_ms - grid.originTime_ms;
+            const int64_t step = std::gcd(std::gcd(timeStep, startOffset), endOffset);
+            const int64_t maxOffset = std::max({maxTimeOffset, std::abs(startOffset), std::abs(endOffset)});
+            const double rowLow = (c.priceMin - grid.originPrice) / grid.priceStep;
+            const double rowHigh = (c.priceMax - grid.originPrice) / grid.priceStep;
+            if (maxOffset / step > kMaxIndex || std::abs(rowLow) > kMaxIndex || std::abs(rowHigh) > kMaxIndex) {
+                break; // first cell of a chunk always fits (offsets 0 and one step)
             }
+            timeStep = step;
+            maxTimeOffset = maxOffset;
         }
+        grid.timeStep_ms = timeStep;
 
-        if (chunkCells.empty()) {
-            break; // safety; shouldn't happen given keptCells accounting
-        }
-
-        const int vertexCount = static_cast<int>(chunkCells.size()) * kVertsPerCell;
+        const int chunkCells = static_cast<int>(chunkEnd - chunkStart);
+        const int vertexCount = chunkCells * kVertsPerCell;
 
         auto* node = new QSGGeometryNode;
-        auto* material = new QSGVertexColorMaterial;
-        material->setFlag(QSGMaterial::Blending);
+        auto* material = new HeatmapMaterial;
+        material->setRamp(ramp);
+        material->setIntensityScale(static_cast<float>(intensityScale));
+        material->setGrid(grid);
+        material->setViewport(viewport);
         node->setMaterial(material);
         node->setFlag(QSGNode::OwnsMaterial);
 
-        auto* geometry = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), vertexCount);
+        auto* geometry = new QSGGeometry(HeatmapMaterial::attributes(), vertexCount,
+                                         chunkCells * kIndicesPerCell, QSGGeometry::UnsignedShortType);
         geometry->setDrawingMode(QSGGeometry::DrawTriangles);
         node->setGeometry(geometry);
         node->setFlag(QSGNode::OwnsGeometry);
 
-        auto* vertices = static_cast<QSGGeometry::ColoredPoint2D*>(geometry->vertexData());
-        int vertexIndex = 0;
-
-        for (const CellInstance* cellPtr : chunkCells) {
-            const auto& cell = *cellPtr;
-
-            // Color with intensity scaling
-            double scaledIntensity = calculateIntensity(cell.liquidity, batch.intensityScale);
-            QColor color = calculateColor(cell.liquidity, cell.isBid, scaledIntensity);
-            const int r = color.red();
-            const int g = color.green();
-            const int b = color.blue();
-            const int a = std::clamp(static_cast<int>(color.alpha()), 0, 255);
-
-            // Convert world→screen using batch.viewport
-            QPointF topLeft = CoordinateSystem::worldToScreen(cell.timeStart_ms, cell.priceMax, batch.viewport);
-            QPointF bottomRight = CoordinateSystem::worldToScreen(cell.timeEnd_ms, cell.priceMin, batch.viewport);
-
-            const float left = static_cast<float>(topLeft.x());
-            const float top = static_cast<float>(topLeft.y());
-            const float right = static_cast<float>(bottomRight.x());
-            const float bottom = static_cast<float>(bottomRight.y());
-
-            // Triangle 1: top-left, top-right, bottom-left
-            vertices[vertexIndex++].set(left,  top,    r, g, b, a);
-            vertices[vertexIndex++].set(right, top,    r, g, b, a);
-            vertices[vertexIndex++].set(left,  bottom, r, g, b, a);
-
-            // Triangle 2: top-right, bottom-right, bottom-left
-            vertices[vertexIndex++].set(right, top,    r, g, b, a);
-            vertices[vertexIndex++].set(right, bottom, r, g, b, a);
-            vertices[vertexIndex++].set(left,  bottom, r, g, b, a);
+        auto* vertices = static_cast<HeatmapMaterial::Vertex*>(geometry->vertexData());
+        quint16* indices = geometry->indexDataAsUShort();
+
+        for (int k = 0; k < chunkCells; ++k) {
+            const auto& cell = *cells[chunkStart + k];
+            const float v = cellValue(cell);
+
+            const int left = static_cast<int>((cell.timeStart_ms - grid.originTime_ms) / grid.timeStep_ms);
+            const int right = static_cast<int>((cell.timeEnd_ms - grid.originTime_ms) / grid.timeStep_ms);
+            const int bottom = static_cast<int>(std::lround((cell.priceMin - grid.originPrice) / grid.priceStep));
+            const int top = static_cast<int>(std::lround((cell.priceMax - grid.originPrice) / grid.priceStep));
+
+            const int base = k * kVertsPerCell;
+            vertices[base + 0].set(left,  top,    v);
+            vertices[base + 1].set(right, top,    v);
+            vertices[base + 2].set(left,  bottom, v);
+            vertices[base + 3].set(right, bottom, v);
+
+            // Triangle 1: top-left, top-right, bottom-left; Triangle 2: top-right, bottom-right, bottom-left
+            quint16* out = indices + k * kIndicesPerCell;
+            out[0] = static_cast<quint16>(base + 0);
+            out[1] = static_cast<quint16>(base + 1);
+            out[2] = static_cast<quint16>(base + 2);
+            out[3] = static_cast<quint16>(base + 1);
+            out[4] = static_cast<quint16>(base + 3);
+            out[5] = static_cast<quint16>(base + 2);
+
+            if (slots) (*slots)[chunkStart + k] = ChunkSlot{node, base};
         }
 
         node->markDirty(QSGNode::DirtyGeometry);
         root->appendChildNode(node);
 
-        producedKeptCells += static_cast<int>(chunkCells.size());
-        totalVerticesDrawn += vertexCount;
+        chunkStart = chunkEnd;
+        totalVertices += vertexCount;
     }
+    return totalVertices;
+}
+
+QSGNode* HeatmapStrategy::buildNode(const GridSliceBatch& batch) {
+
+    /*
+        Build a GPU scene graph node for rendering the heatmap. 
+        Each cell becomes an indexed quad whose corners are grid indices relative to
+        the chunk origin; HeatmapMaterial maps them to screen space in the vertex shader.
+    */
+
+    if (batch.cells.empty()) {
+        sLog_Render(" HEATMAP EXIT: Returning nullptr - batch is empty");
+        return nullptr;
+    }
+
+    int total = static_cast<int>(batch.cells.size());
+    int cellCount = std::min(total, batch.maxCells);
+    int startIndex = std::max(0, total - cellCount); // keep newest when clipping
+
+    std::vector<const CellInstance*> keptCells;
+    keptCells.reserve(cellCount);
+    for (int i = 0; i < cellCount; ++i) {
+        const auto& cell = batch.cells[startIndex + i];
+        if (keepCell(cell, batch.minVolumeFilter)) {
+            keptCells.push_back(&cell);
+        }
+    }
+    if (keptCells.empty()) {
+        sLog_Render(" HEATMAP EXIT: No cells above minVolumeFilter");
+        return nullptr;
+    }
+    QSGTexture* ramp = rampTexture();
+    if (!ramp) {
+        sLog_Render(" HEATMAP EXIT: No window for the ramp texture yet");
+        return nullptr;
+    }
+
+    // Root container holding one or more geometry chunks
+    auto* root = new QSGNode;
+    // Cells cover a margin around the viewport, so the geometry stays valid while the viewport moves inside it
+    const Viewport& coverage = batch.cellCoverage;
+    m_builtViewport = coverage.timeEnd_ms > coverage.timeStart_ms ? coverage : batch.viewport;
+    const int totalVerticesDrawn = appendChunks(root, keptCells, ramp, batch.intensityScale, batch.viewport, nullptr);
 
     // HEATMAP CHUNK LOGGING (throttled)
     static int frame = 0;
     if ((++frame % 30) == 0) {
-        sLog_RenderN(1, " HEATMAP CHUNKS: cells=" << keptCells
+        sLog_RenderN(1, " HEATMAP CHUNKS: cells=" << keptCells.size()
                          << " verts=" << totalVerticesDrawn
                          << " chunks=" << root->childCount());
     }
@@ -149,16 +237,88 @@ QSGNode* HeatmapStrategy::buildNode(const GridSliceBatch& batch) {
     return root;
 }
 
+void HeatmapStrategy::updateLiveLayer(QSGNode* container, std::shared_ptr<const LiveColumn> column,
+                                      const Viewport& viewport, double intensityScale, double minVolumeFilter) {
+    if (!container) return;
+
+    QSGTexture* ramp = rampTexture();
+    if (!column || column->cells.empty() || !ramp) {
+        clearChildren(container);
+        m_hasLiveColumn = false;
+        m_liveSlots.clear();
+        return;
+    }
+
+    // Same slot layout as the geometry already uploaded: rewrite the values of the changed slots in place.
+    // A slot that dropped out (vanished or under the filter) is written as 0, which the ramp keeps transparent;
+    // one that has no quad yet (appended level, or back over the filter) gets it in a new chunk.
+    bool patched = container == m_liveContainer && container->firstChild() && m_hasLiveColumn &&
+                   column->layoutRevision == m_liveLayoutRevision && minVolumeFilter == m_liveFilter;
+    if (patched && column->revision != m_liveRevision) {
+        m_liveSlots.resize(column->cells.size());
+        std::vector<const CellInstance*> addedCells;
+        std::vector<size_t> addedSlots;
+        auto patchSlot = [&](size_t i) {
+            const CellInstance& cell = column->cells[i];
+            const ChunkSlot& slot = m_liveSlots[i];
+            const bool kept = keepCell(cell, minVolumeFilter);
+            if (!slot.node) {
+                if (kept) {
+                    addedCells.push_back(&cell);
+                    addedSlots.push_back(i);
+                }
+                return;
+            }
+            auto* vertices = static_cast<HeatmapMaterial::Vertex*>(slot.node->geometry()->vertexData());
+            const float v = kept ? cellValue(cell) : 0.0f;
+            for (int k = 0; k < kVertsPerCell; ++k) vertices[slot.firstVertex + k].value = v;
+            slot.node->markDirty(QSGNode::DirtyGeometry);
+        };
+        if (column->revision == m_liveRevision + 1) {
+            for (uint32_t i : column->changedSlots) patchSlot(i);
+        } else {
+            // Missed a revision: any slot may have changed
+            for (size_t i = 0; i < column->cells.size(); ++i) patchSlot(i);
+        }
+        if (!addedCells.empty()) {
+            std::vector<ChunkSlot> chunkSlots;
+            appendChunks(container, addedCells, ramp, intensityScale, viewport, &chunkSlots);
+            for (size_t k = 0; k < addedSlots.size(); ++k) {
+                m_liveSlots[addedSlots[k]] = chunkSlots[k];
+            }
+        }
+    }
+
+    if (!patched) {
+        clearChildren(container);
+        std::vector<const CellInstance*> keptCells;
+        std::vector<size_t> keptSlots;
+        keptCells.reserve(column->cells.size());
+        keptSlots.reserve(column->cells.size());
+        for (size_t i = 0; i < column->cells.size(); ++i) {
+            if (keepCell(column->cells[i], minVolumeFilter)) {
+                keptCells.push_back(&column->cells[i]);
+                keptSlots.push_back(i);
+            }
+        }
+        std::vector<ChunkSlot> chunkSlots;
+        appendChunks(container, keptCells, ramp, intensityScale, viewport, &chunkSlots);
+        m_liveSlots.assign(column->cells.size(), ChunkSlot{});
+        for (size_t k = 0; k < keptSlots.size(); ++k) {
+            m_liveSlots[keptSlots[k]] = chunkSlots[k];
+        }
+    }
+
+    m_hasLiveColumn = true;
+    m_liveRevision = column->revision;
+    m_liveLayoutRevision = column->layoutRevision;
+    m_liveContainer = container;
+    m_liveFilter = minVolumeFilter;
+    applyMaterialState(container, intensityScale);
+    WorldSpaceMaterial::applyViewport(container, viewport);
+}
+
 QColor HeatmapStrategy::calculateColor(double liquidity, bool isBid, double intensity) const {
-    double alpha = std::min(intensity, 1.0); // LINUS FIX: let intensity speak
-    
-    if (isBid) {
-        // Bid-heavy: Green spectrum
-        double green = std::min(255.0 * intensity, 255.0);
-        return QColor(0, static_cast<int>(green), 0, static_cast<int>(alpha * 255));
-    } else {
-        // Ask-heavy: Red spectrum  
-        double red = std::min(255.0 * intensity, 255.0);
-        return QColor(static_cast<int>(red), 0, 0, static_cast<int>(alpha * 255));
-    }
-}
\ No newline at end of file
+    Q_UNUSED(liquidity)
+    return colorRamp().color(isBid ? RampPalette::HeatmapBid : RampPalette::HeatmapAsk, intensity);
+}
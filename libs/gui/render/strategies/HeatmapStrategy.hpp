@@ -3,28 +3,67 @@ Sentinel — HeatmapStrategy
 Role: A concrete render strategy that visualizes market liquidity as a heatmap.
 Inputs/Outputs: Implements IRenderStrategy to turn a GridSliceBatch into a colored QSGNode.
 Threading: Methods are called exclusively on the Qt Quick render thread.
-Performance: Stateless. Generates six vertices per grid cell in the provided batch.
+Performance: Four packed 8-byte vertices per cell plus an index buffer; placement and color mapping run in HeatmapMaterial.
 Integration: Instantiated and managed by UnifiedGridRenderer as a pluggable strategy.
 Observability: No internal logging.
 Related: HeatmapStrategy.cpp, IRenderStrategy.hpp, UnifiedGridRenderer.h, GridTypes.hpp.
-Assumptions: The input batch contains valid cell data with pre-calculated screen rectangles.
+Assumptions: The input batch contains world-space cells and the viewport they are shown in.
 */
 #pragma once
 #include "../IRenderStrategy.hpp"
+#include "../../CoordinateSystem.h"
+#include <vector>
+
+class QQuickWindow;
+class QSGGeometryNode;
+class QSGTexture;
+struct CellInstance;
+struct LiveColumn;
 
 class HeatmapStrategy : public IRenderStrategy {
 public:
     HeatmapStrategy() = default;
-    ~HeatmapStrategy() override = default;
+    ~HeatmapStrategy() override;
     
     QSGNode* buildNode(const GridSliceBatch& batch) override;
     QColor calculateColor(double liquidity, bool isBid, double intensity) const override;
     const char* getStrategyName() const override { return "LiquidityHeatmap"; }
+    bool applyViewport(QSGNode* layer, const Viewport& viewport) override;
+    
+    // The ramp texture is created per window on the render thread
+    void setWindow(QQuickWindow* window) { m_window = window; }
+    // Recolors an existing heatmap layer (intensity scale / theme) without touching its geometry
+    void applyMaterialState(QSGNode* layer, double intensityScale);
+    // Keeps the still-building column in container; same-layout revisions patch vertex values in place
+    void updateLiveLayer(QSGNode* container, std::shared_ptr<const LiveColumn> column,
+                         const Viewport& viewport, double intensityScale, double minVolumeFilter);
     
 private:
-    struct GridVertex {
-        float x, y;           // Position
-        float r, g, b, a;     // Color
-        float intensity;      // Volume/liquidity intensity
+    static constexpr int kVertsPerCell = 4;
+
+    // Where a cell's four vertices live once uploaded; node is null for cells dropped by the volume filter
+    struct ChunkSlot {
+        QSGGeometryNode* node = nullptr;
+        int firstVertex = 0;
     };
+
+    QSGTexture* rampTexture();
+    // Appends indexed-quad chunks for cells under root; returns the vertex count
+    int appendChunks(QSGNode* root, const std::vector<const CellInstance*>& cells, QSGTexture* ramp,
+                     double intensityScale, const Viewport& viewport, std::vector<ChunkSlot>* slots);
+    
+    QQuickWindow* m_window = nullptr;
+    QSGTexture* m_rampTexture = nullptr;
+    QQuickWindow* m_textureWindow = nullptr;
+    std::shared_ptr<const ColorRamp> m_textureRamp;  // Ramp the texture was built from
+    Viewport m_builtViewport;  // Region of the last buildNode's cells; outside it they were culled upstream
+
+    // Live column currently uploaded to m_liveContainer. Only its revisions are kept: holding the column
+    // would stop DataProcessor from reusing it as its next back buffer.
+    bool m_hasLiveColumn = false;
+    uint64_t m_liveRevision = 0;
+    uint64_t m_liveLayoutRevision = 0;
+    std::vector<ChunkSlot> m_liveSlots;  // Indexed like the live column's cells
+    QSGNode* m_liveContainer = nullptr;
+    double m_liveFilter = 0.0;
 };
\ No newline at end of file
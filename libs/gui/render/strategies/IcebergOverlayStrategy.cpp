@@ -0,0 +1,92 @@
+/*
+Sentinel — IcebergOverlayStrategy
+Role: Implements the iceberg overlay: a band over each level's refill span plus a marker at the latest refill.
+Inputs/Outputs: Builds one triangle-list QSGGeometryNode from GridSliceBatch::icebergEvents.
+Threading: All code is executed on the Qt Quick render thread.
+Performance: Single pass to find the hidden-size scale and visible count, single pass to emit quads.
+Integration: The concrete implementation of the iceberg overlay strategy.
+Observability: No internal logging.
+Related: IcebergOverlayStrategy.hpp, IcebergDetector.h.
+Assumptions: Opacity scales with hiddenEstimate relative to the largest visible event.
+*/
+#include "IcebergOverlayStrategy.hpp"
+#include "../GridTypes.hpp"
+#include "../../CoordinateSystem.h"
+#include <QSGGeometryNode>
+#include <QSGVertexColorMaterial>
+#include <QSGGeometry>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr int kQuadsPerEvent = 2;
+    constexpr float kBandHalfHeight = 1.5f;
+    constexpr float kMinBandWidth = 3.0f;
+    constexpr float kMarkerHalfSize = 4.0f;
+}
+
+QSGNode* IcebergOverlayStrategy::buildNode(const GridSliceBatch& batch) {
+    const auto& events = batch.icebergEvents;
+    const Viewport& vp = batch.viewport;
+    if (events.empty() || vp.width <= 0.0 || vp.height <= 0.0 ||
+        vp.timeEnd_ms <= vp.timeStart_ms || vp.priceMax <= vp.priceMin) {
+        return nullptr;
+    }
+    
+    auto isVisible = [&](const IcebergEvent& ev) {
+        return ev.price >= vp.priceMin && ev.price <= vp.priceMax;
+    };
+    
+    double maxHidden = 0.0;
+    int visibleCount = 0;
+    for (const auto& ev : events) {
+        if (!isVisible(ev)) continue;
+        maxHidden = std::max(maxHidden, ev.hiddenEstimate);
+        ++visibleCount;
+    }
+    if (visibleCount == 0) return nullptr;
+    if (maxHidden <= 0.0) maxHidden = 1.0;
+    
+    const double pxPerMs = vp.width / static_cast<double>(vp.timeEnd_ms - vp.timeStart_ms);
+    const double pxPerPrice = vp.height / (vp.priceMax - vp.priceMin);
+    
+    auto* node = new QSGGeometryNode;
+    auto* material = new QSGVertexColorMaterial;
+    material->setFlag(QSGMaterial::Blending);
+    node->setMaterial(material);
+    node->setFlag(QSGNode::OwnsMaterial);
+    
+    auto* geometry = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(),
+                                     visibleCount * kQuadsPerEvent * kVerticesPerQuad);
+    geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+    node->setGeometry(geometry);
+    node->setFlag(QSGNode::OwnsGeometry);
+    
+    auto* vertices = static_cast<QSGGeometry::ColoredPoint2D*>(geometry->vertexData());
+    int vertexIndex = 0;
+    
+    for (const auto& ev : events) {
+        if (!isVisible(ev)) continue;
+        const float y = static_cast<float>((vp.priceMax - ev.price) * pxPerPrice);
+        const float left = static_cast<float>((ev.firstSeen_ms - vp.timeStart_ms) * pxPerMs);
+        const float right = std::max(left + kMinBandWidth,
+                                     static_cast<float>((ev.lastRefill_ms - vp.timeStart_ms) * pxPerMs));
+        const double intensity = ev.hiddenEstimate / maxHidden;
+        const QColor color = calculateColor(ev.hiddenEstimate, ev.isBid, intensity);
+        
+        emitQuad(vertices, vertexIndex, left, y - kBandHalfHeight, right, y + kBandHalfHeight, color);
+        
+        QColor marker = color;
+        marker.setAlpha(240);
+        emitQuad(vertices, vertexIndex, right - kMarkerHalfSize, y - kMarkerHalfSize,
+                 right + kMarkerHalfSize, y + kMarkerHalfSize, marker);
+    }
+    
+    node->markDirty(QSGNode::DirtyGeometry);
+    return node;
+}
+
+QColor IcebergOverlayStrategy::calculateColor(double liquidity, bool isBid, double intensity) const {
+    Q_UNUSED(liquidity)
+    return colorRamp().color(isBid ? RampPalette::IcebergBid : RampPalette::IcebergAsk, intensity);
+}
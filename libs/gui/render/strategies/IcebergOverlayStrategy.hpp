@@ -0,0 +1,23 @@
+/*
+Sentinel — IcebergOverlayStrategy
+Role: A render strategy that marks suspected iceberg levels on top of the heatmap.
+Inputs/Outputs: Implements IRenderStrategy to turn GridSliceBatch::icebergEvents into a single QSGGeometryNode.
+Threading: Methods are called exclusively on the Qt Quick render thread.
+Performance: One geometry node, two quads per event; bounded by the detector's event ring.
+Integration: Owned by UnifiedGridRenderer and layered by GridSceneNode below the other overlays.
+Observability: No internal logging.
+Related: IcebergOverlayStrategy.cpp, IcebergDetector.h, IRenderStrategy.hpp, GridTypes.hpp.
+Assumptions: Events are in world coordinates (time, price); the viewport maps them to screen space.
+*/
+#pragma once
+#include "../IRenderStrategy.hpp"
+
+class IcebergOverlayStrategy : public IRenderStrategy {
+public:
+    IcebergOverlayStrategy() = default;
+    ~IcebergOverlayStrategy() override = default;
+    
+    QSGNode* buildNode(const GridSliceBatch& batch) override;
+    QColor calculateColor(double liquidity, bool isBid, double intensity) const override;
+    const char* getStrategyName() const override { return "IcebergOverlay"; }
+};
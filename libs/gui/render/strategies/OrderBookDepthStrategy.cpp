@@ -0,0 +1,135 @@
+/*
+Sentinel — OrderBookDepthStrategy
+Role: Implements the depth pane: a filled step profile per side with an opaque outline along its edge.
+Inputs/Outputs: Builds one triangle-list QSGGeometryNode from GridSliceBatch::depthCurve.
+Threading: All code is executed on the Qt Quick render thread.
+Performance: One pass merges equal samples into runs, one pass emits quads; no per-sample nodes.
+Integration: The concrete implementation of the order book depth strategy.
+Observability: No internal logging.
+Related: OrderBookDepthStrategy.hpp, TradeData.h.
+Assumptions: Width is linear in cumulative size, scaled to the largest visible depth on either side.
+*/
+#include "OrderBookDepthStrategy.hpp"
+#include "../GridTypes.hpp"
+#include "../../CoordinateSystem.h"
+#include <QSGGeometryNode>
+#include <QSGVertexColorMaterial>
+#include <QSGGeometry>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr float kOutlineThickness = 1.5f;
+    constexpr double kFillIntensity = 0.2;
+
+    // Consecutive samples [first, last] sharing one cumulative value
+    struct Run {
+        size_t first;
+        size_t last;
+        double value;
+    };
+
+    void collectRuns(const std::vector<double>& samples, std::vector<Run>& runs) {
+        runs.clear();
+        for (size_t i = 0; i < samples.size(); ++i) {
+            if (!runs.empty() && runs.back().value == samples[i]) {
+                runs.back().last = i;
+            } else {
+                runs.push_back({i, i, samples[i]});
+            }
+        }
+    }
+
+    // Fill + outline tip per populated run, plus one connector between neighbouring runs when either is populated
+    int quadsFor(const std::vector<Run>& runs) {
+        int quads = 0;
+        for (size_t r = 0; r < runs.size(); ++r) {
+            if (runs[r].value > 0.0) quads += 2;
+            if (r > 0 && (runs[r].value > 0.0 || runs[r - 1].value > 0.0)) ++quads;
+        }
+        return quads;
+    }
+}
+
+QSGNode* OrderBookDepthStrategy::buildNode(const GridSliceBatch& batch) {
+    const DepthCurve& curve = batch.depthCurve;
+    const Viewport& vp = batch.viewport;
+    const size_t samples = std::min(curve.bidCumulative.size(), curve.askCumulative.size());
+    if (samples == 0 || vp.width <= 0.0 || vp.height <= 0.0 || vp.priceMax <= vp.priceMin ||
+        curve.priceMax < curve.priceMin) {
+        return nullptr;
+    }
+
+    double maxDepth = 0.0;
+    for (size_t i = 0; i < samples; ++i) {
+        maxDepth = std::max({maxDepth, curve.bidCumulative[i], curve.askCumulative[i]});
+    }
+    if (maxDepth <= 0.0) return nullptr;
+
+    std::vector<Run> bidRuns;
+    std::vector<Run> askRuns;
+    collectRuns(curve.bidCumulative, bidRuns);
+    collectRuns(curve.askCumulative, askRuns);
+
+    const float right = static_cast<float>(vp.width);
+    const float paneWidth = static_cast<float>(vp.width * std::clamp(m_paneFraction, 0.05, 0.5));
+    const double pxPerPrice = vp.height / (vp.priceMax - vp.priceMin);
+    const double priceStep = samples > 1 ? (curve.priceMax - curve.priceMin) / static_cast<double>(samples - 1) : 0.0;
+    // Each sample owns half a step either side; y grows downward as price falls
+    auto edgeY = [&](double sampleEdge) {
+        const double price = curve.priceMin + (sampleEdge - 0.5) * priceStep;
+        return static_cast<float>((vp.priceMax - price) * pxPerPrice);
+    };
+    auto depthX = [&](double depth) {
+        return right - static_cast<float>(depth / maxDepth) * paneWidth;
+    };
+
+    const int quadCount = 1 + quadsFor(bidRuns) + quadsFor(askRuns);
+
+    auto* node = new QSGGeometryNode;
+    auto* material = new QSGVertexColorMaterial;
+    material->setFlag(QSGMaterial::Blending);
+    node->setMaterial(material);
+    node->setFlag(QSGNode::OwnsMaterial);
+
+    auto* geometry = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), quadCount * kVerticesPerQuad);
+    geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+    node->setGeometry(geometry);
+    node->setFlag(QSGNode::OwnsGeometry);
+
+    auto* vertices = static_cast<QSGGeometry::ColoredPoint2D*>(geometry->vertexData());
+    int vertexIndex = 0;
+
+    emitQuad(vertices, vertexIndex, right - paneWidth, 0.0f, right, static_cast<float>(vp.height), QColor(10, 10, 14, 110));
+
+    for (const bool isBid : {true, false}) {
+        const std::vector<Run>& runs = isBid ? bidRuns : askRuns;
+        const QColor fill = calculateColor(0.0, isBid, kFillIntensity);
+        const QColor outline = calculateColor(0.0, isBid, 1.0);
+        for (size_t r = 0; r < runs.size(); ++r) {
+            const Run& run = runs[r];
+            const float x = depthX(run.value);
+            // Higher sample index = higher price = smaller y
+            const float top = edgeY(static_cast<double>(run.last) + 1.0);
+            const float bottom = edgeY(static_cast<double>(run.first));
+            if (run.value > 0.0) {
+                emitQuad(vertices, vertexIndex, x, top, right, bottom, fill);
+                emitQuad(vertices, vertexIndex, x, top, std::min(right, x + kOutlineThickness), bottom, outline);
+            }
+            if (r > 0 && (run.value > 0.0 || runs[r - 1].value > 0.0)) {
+                const float prevX = depthX(runs[r - 1].value);
+                emitQuad(vertices, vertexIndex, std::min(x, prevX), bottom - kOutlineThickness * 0.5f,
+                         std::min(right, std::max(x, prevX) + kOutlineThickness),
+                         bottom + kOutlineThickness * 0.5f, outline);
+            }
+        }
+    }
+
+    node->markDirty(QSGNode::DirtyGeometry);
+    return node;
+}
+
+QColor OrderBookDepthStrategy::calculateColor(double liquidity, bool isBid, double intensity) const {
+    Q_UNUSED(liquidity)
+    return colorRamp().color(isBid ? RampPalette::DepthBid : RampPalette::DepthAsk, intensity);
+}
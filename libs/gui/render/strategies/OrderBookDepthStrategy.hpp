@@ -0,0 +1,30 @@
+/*
+Sentinel — OrderBookDepthStrategy
+Role: A render strategy that draws the live cumulative bid/ask depth profile as a right-edge pane in OrderBookDepth mode.
+Inputs/Outputs: Implements IRenderStrategy to turn GridSliceBatch::depthCurve into a single QSGGeometryNode.
+Threading: Methods are called exclusively on the Qt Quick render thread.
+Performance: One geometry node; equal adjacent samples merge into one step, so vertex count follows populated ticks, not pixel rows.
+Integration: Owned by UnifiedGridRenderer and layered by GridSceneNode as the Depth overlay.
+Observability: No internal logging.
+Related: OrderBookDepthStrategy.cpp, TradeData.h (LiveOrderBook::sampleCumulativeDepth), IRenderStrategy.hpp, GridTypes.hpp.
+Assumptions: Samples are evenly spaced in price and ascending; bids decrease and asks increase with price.
+*/
+#pragma once
+#include "../IRenderStrategy.hpp"
+
+class OrderBookDepthStrategy : public IRenderStrategy {
+public:
+    OrderBookDepthStrategy() = default;
+    ~OrderBookDepthStrategy() override = default;
+
+    QSGNode* buildNode(const GridSliceBatch& batch) override;
+    QColor calculateColor(double liquidity, bool isBid, double intensity) const override;
+    const char* getStrategyName() const override { return "OrderBookDepth"; }
+
+    // Fraction of the viewport width used by the depth pane (anchored at the right edge)
+    void setPaneFraction(double fraction) { m_paneFraction = fraction; }
+    double paneFraction() const { return m_paneFraction; }
+
+private:
+    double m_paneFraction = 0.25;
+};
@@ -0,0 +1,134 @@
+/*
+Sentinel — OrderFlowOverlayStrategy
+Role: Implements the lower-pane order-flow overlay: delta histogram, CVD line, book-imbalance line.
+Inputs/Outputs: Builds one triangle-list QSGGeometryNode from GridSliceBatch::orderFlowBars.
+Threading: All code is executed on the Qt Quick render thread.
+Performance: Single pass to find scales, single pass to emit quads; no per-bar nodes.
+Integration: The concrete implementation of the order-flow overlay strategy.
+Observability: No internal logging.
+Related: OrderFlowOverlayStrategy.hpp, OrderFlowEngine.h.
+Assumptions: Lines are drawn as thin quads since QSGVertexColorMaterial has no line width.
+*/
+#include "OrderFlowOverlayStrategy.hpp"
+#include "../GridTypes.hpp"
+#include "../../CoordinateSystem.h"
+#include <QSGGeometryNode>
+#include <QSGVertexColorMaterial>
+#include <QSGGeometry>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr float kLineThickness = 1.5f;
+
+    // Segment (x1,y1)→(x2,y2) as a quad offset along its normal
+    void emitSegment(QSGGeometry::ColoredPoint2D* v, int& i,
+                     float x1, float y1, float x2, float y2, const QColor& c) {
+        const float dx = x2 - x1, dy = y2 - y1;
+        const float len = std::sqrt(dx * dx + dy * dy);
+        const float nx = len > 0.0f ? -dy / len * kLineThickness * 0.5f : 0.0f;
+        const float ny = len > 0.0f ? dx / len * kLineThickness * 0.5f : kLineThickness * 0.5f;
+        const int r = c.red(), g = c.green(), b = c.blue(), a = c.alpha();
+        v[i++].set(x1 + nx, y1 + ny, r, g, b, a);
+        v[i++].set(x2 + nx, y2 + ny, r, g, b, a);
+        v[i++].set(x1 - nx, y1 - ny, r, g, b, a);
+        v[i++].set(x2 + nx, y2 + ny, r, g, b, a);
+        v[i++].set(x2 - nx, y2 - ny, r, g, b, a);
+        v[i++].set(x1 - nx, y1 - ny, r, g, b, a);
+    }
+}
+
+QSGNode* OrderFlowOverlayStrategy::buildNode(const GridSliceBatch& batch) {
+    const auto& bars = batch.orderFlowBars;
+    const Viewport& vp = batch.viewport;
+    if (bars.empty() || vp.width <= 0.0 || vp.height <= 0.0 || vp.timeEnd_ms <= vp.timeStart_ms) {
+        return nullptr;
+    }
+    
+    // Scales over the visible bars
+    double maxAbsDelta = 0.0;
+    double cvdMin = bars.front().cvdOpen;
+    double cvdMax = bars.front().cvdOpen;
+    for (const auto& bar : bars) {
+        maxAbsDelta = std::max(maxAbsDelta, std::abs(bar.delta()));
+        cvdMin = std::min({cvdMin, bar.cvdOpen, bar.cvdClose});
+        cvdMax = std::max({cvdMax, bar.cvdOpen, bar.cvdClose});
+    }
+    if (maxAbsDelta <= 0.0) maxAbsDelta = 1.0;
+    const double cvdRange = std::max(cvdMax - cvdMin, 1e-9);
+    
+    const float paneHeight = static_cast<float>(vp.height * std::clamp(m_paneFraction, 0.05, 0.5));
+    const float paneBottom = static_cast<float>(vp.height);
+    const float paneTop = paneBottom - paneHeight;
+    const float midY = paneTop + paneHeight * 0.5f;
+    const float halfPane = paneHeight * 0.5f - 2.0f;
+    
+    const double pxPerMs = vp.width / static_cast<double>(vp.timeEnd_ms - vp.timeStart_ms);
+    auto timeToX = [&](int64_t t) {
+        return static_cast<float>((t - vp.timeStart_ms) * pxPerMs);
+    };
+    auto cvdToY = [&](double cvd) {
+        return paneBottom - 2.0f - static_cast<float>((cvd - cvdMin) / cvdRange) * (paneHeight - 4.0f);
+    };
+    auto imbalanceToY = [&](double imbalance) {
+        return midY - static_cast<float>(std::clamp(imbalance, -1.0, 1.0)) * halfPane;
+    };
+    
+    // Background + zero line, one delta bar per bar, CVD and imbalance segments between bars
+    const int barCount = static_cast<int>(bars.size());
+    const int quadCount = 2 + barCount + 2 * std::max(0, barCount - 1);
+    
+    auto* node = new QSGGeometryNode;
+    auto* material = new QSGVertexColorMaterial;
+    material->setFlag(QSGMaterial::Blending);
+    node->setMaterial(material);
+    node->setFlag(QSGNode::OwnsMaterial);
+    
+    auto* geometry = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), quadCount * kVerticesPerQuad);
+    geometry->setDrawingMode(QSGGeometry::DrawTriangles);
+    node->setGeometry(geometry);
+    node->setFlag(QSGNode::OwnsGeometry);
+    
+    auto* vertices = static_cast<QSGGeometry::ColoredPoint2D*>(geometry->vertexData());
+    int vertexIndex = 0;
+    
+    const float width = static_cast<float>(vp.width);
+    emitQuad(vertices, vertexIndex, 0.0f, paneTop, width, paneBottom, QColor(10, 10, 14, 170));
+    emitQuad(vertices, vertexIndex, 0.0f, midY - 0.5f, width, midY + 0.5f, QColor(120, 120, 120, 120));
+    
+    for (const auto& bar : bars) {
+        const float left = timeToX(bar.startTime_ms);
+        const float right = std::max(left + 1.0f, timeToX(bar.startTime_ms + bar.duration_ms) - 1.0f);
+        const double delta = bar.delta();
+        const double intensity = std::abs(delta) / maxAbsDelta;
+        const float h = static_cast<float>(intensity) * halfPane;
+        const bool isBuy = delta >= 0.0;
+        QColor color = calculateColor(std::abs(delta), isBuy, intensity);
+        if (isBuy) {
+            emitQuad(vertices, vertexIndex, left, midY - h, right, midY, color);
+        } else {
+            emitQuad(vertices, vertexIndex, left, midY, right, midY + h, color);
+        }
+    }
+    
+    const QColor cvdColor(230, 230, 230, 230);
+    const QColor imbalanceColor(255, 200, 0, 200);
+    for (int i = 1; i < barCount; ++i) {
+        const auto& prev = bars[i - 1];
+        const auto& cur = bars[i];
+        const float x1 = timeToX(prev.startTime_ms + prev.duration_ms / 2);
+        const float x2 = timeToX(cur.startTime_ms + cur.duration_ms / 2);
+        emitSegment(vertices, vertexIndex, x1, cvdToY(prev.cvdClose), x2, cvdToY(cur.cvdClose), cvdColor);
+        emitSegment(vertices, vertexIndex, x1, imbalanceToY(prev.avgBookImbalance()),
+                    x2, imbalanceToY(cur.avgBookImbalance()), imbalanceColor);
+    }
+    
+    node->markDirty(QSGNode::DirtyGeometry);
+    return node;
+}
+
+QColor OrderFlowOverlayStrategy::calculateColor(double liquidity, bool isBid, double intensity) const {
+    Q_UNUSED(liquidity)
+    // isBid == buy-side aggression (positive delta)
+    return colorRamp().color(isBid ? RampPalette::OrderFlowBuy : RampPalette::OrderFlowSell, intensity);
+}
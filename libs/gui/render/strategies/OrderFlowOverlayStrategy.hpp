@@ -0,0 +1,30 @@
+/*
+Sentinel — OrderFlowOverlayStrategy
+Role: A render strategy that plots order-flow analytics (delta, CVD, book imbalance) as a lower-pane overlay.
+Inputs/Outputs: Implements IRenderStrategy to turn GridSliceBatch::orderFlowBars into a single QSGGeometryNode.
+Threading: Methods are called exclusively on the Qt Quick render thread.
+Performance: One geometry node, 6 vertices per primitive; vertex count is bounded by the visible bar count.
+Integration: Owned by UnifiedGridRenderer and layered by GridSceneNode above the heatmap.
+Observability: No internal logging.
+Related: OrderFlowOverlayStrategy.cpp, OrderFlowEngine.h, IRenderStrategy.hpp, GridTypes.hpp.
+Assumptions: Bars arrive oldest → newest and share one timeframe.
+*/
+#pragma once
+#include "../IRenderStrategy.hpp"
+
+class OrderFlowOverlayStrategy : public IRenderStrategy {
+public:
+    OrderFlowOverlayStrategy() = default;
+    ~OrderFlowOverlayStrategy() override = default;
+    
+    QSGNode* buildNode(const GridSliceBatch& batch) override;
+    QColor calculateColor(double liquidity, bool isBid, double intensity) const override;
+    const char* getStrategyName() const override { return "OrderFlowOverlay"; }
+    
+    // Fraction of the viewport height used by the overlay pane (anchored at the bottom)
+    void setPaneFraction(double fraction) { m_paneFraction = fraction; }
+    double paneFraction() const { return m_paneFraction; }
+    
+private:
+    double m_paneFraction = 0.22;
+};
@@ -3,7 +3,8 @@ Sentinel — TradeBubbleStrategy
 Role: Implements beautiful size-relative trade bubbles rendered on top of the heatmap.
 Inputs/Outputs: Creates QSGNode containing smooth, anti-aliased bubbles scaled by trade volume.
 Threading: All code is executed on the Qt Quick render thread.
-Performance: Optimized triangulated circles with proper depth sorting and transparency.
+Performance: Reads trade blocks in place from the shared TradeHistoryStore epoch; world-space centers with pixel-offset rims, so zooming inside the built range is a uniform update.
+             The top-N selection is cached per (epoch, viewport range, filter, maxCells); rebuilds for new prints scan only the tail.
 Integration: The concrete implementation of the trade bubble visualization strategy.
 Observability: No internal logging.
 Related: TradeBubbleStrategy.hpp.
@@ -11,41 +12,93 @@ Assumptions: The 'liquidity' field represents trade size for bubble scaling.
 */
 #include "TradeBubbleStrategy.hpp"
 #include "../GridTypes.hpp"
-#include "../../CoordinateSystem.h"
+#include "../WorldColorMaterial.hpp"
 #include <QSGGeometryNode>
-#include <QSGVertexColorMaterial>
 #include <QSGGeometry>
 #include <algorithm>
 #include <cmath>
 
-QSGNode* TradeBubbleStrategy::buildNode(const GridSliceBatch& batch) {
-    if (batch.recentTrades.empty()) return nullptr;
-    
-    // Create geometry node for bubble rendering
-    auto* node = new QSGGeometryNode;
-    auto* material = new QSGVertexColorMaterial;
-    material->setFlag(QSGMaterial::Blending);
-    node->setMaterial(material);
-    node->setFlag(QSGNode::OwnsMaterial);
-    
-    // Filter and sort trades by size for proper rendering order (largest first for depth)
-    std::vector<const Trade*> validTrades;
-    double maxTradeSize = 0.0;
-    
-    for (const auto& trade : batch.recentTrades) {
-        if (trade.size >= batch.minVolumeFilter) {
-            validTrades.push_back(&trade);
-            maxTradeSize = std::max(maxTradeSize, trade.size);
+bool TradeBubbleStrategy::applyViewport(QSGNode* layer, const Viewport& viewport) {
+    if (!layer || !viewportWithin(viewport, m_builtViewport)) return false;
+    WorldSpaceMaterial::applyViewport(layer, viewport);
+    return true;
+}
+
+void TradeBubbleStrategy::updateSelection(const GridSliceBatch& batch) {
+    const Viewport& vp = batch.viewport;
+    const auto& blocks = batch.tradeBlocks;
+    const bool sameKey = m_selection.blocks && blocks->epoch == m_selection.epoch &&
+                         blocks->blocks.size() == m_selection.blocks->blocks.size() &&
+                         (blocks->blocks.empty() || blocks->blocks.back() == m_selection.blocks->blocks.back()) &&
+                         vp.timeStart_ms == m_selection.viewport.timeStart_ms &&
+                         vp.timeEnd_ms == m_selection.viewport.timeEnd_ms &&
+                         vp.priceMin == m_selection.viewport.priceMin && vp.priceMax == m_selection.viewport.priceMax &&
+                         batch.minVolumeFilter == m_selection.minVolume && batch.maxCells == m_selection.maxCells;
+    const size_t tailCount = blocks->blocks.empty() ? 0 : blocks->blocks.back()->count();
+    if (sameKey && tailCount == m_selection.tailCount) return;  // Nothing appended
+
+    const size_t previous = sameKey ? m_selection.trades.size() : 0;
+    if (!sameKey) {
+        m_selection.trades.clear();
+        m_selection.maxTradeSize = 0.0;
+    }
+    auto consider = [&](int64_t time_ms, double price, double size, AggressorSide side) {
+        if (size < batch.minVolumeFilter || price < vp.priceMin || price > vp.priceMax) return;
+        m_selection.trades.push_back(TradePrint{time_ms, price, size, side});
+        m_selection.maxTradeSize = std::max(m_selection.maxTradeSize, size);
+    };
+    if (sameKey) {
+        // Same epoch: only the tail block grew
+        const TradeHistoryStore::Block& tail = *blocks->blocks.back();
+        for (size_t i = m_selection.tailCount; i < tailCount; ++i) {
+            if (tail.time(i) >= vp.timeStart_ms && tail.time(i) <= vp.timeEnd_ms) {
+                consider(tail.time(i), tail.price(i), tail.size(i), tail.side(i));
+            }
         }
+    } else {
+        // Walk the published blocks for the visible window
+        blocks->forEachInRange(vp.timeStart_ms, vp.timeEnd_ms, consider);
     }
+    m_selection.blocks = blocks;
+    m_selection.epoch = blocks->epoch;
+    m_selection.tailCount = tailCount;
+    m_selection.viewport = vp;
+    m_selection.minVolume = batch.minVolumeFilter;
+    m_selection.maxCells = batch.maxCells;
+    if (sameKey && m_selection.trades.size() == previous) return;  // Appended prints were all filtered out
+
+    // Keep the largest prints, sorted largest first for proper depth rendering
+    auto& trades = m_selection.trades;
+    const auto bySizeDesc = [](const TradePrint& a, const TradePrint& b) { return a.size > b.size; };
+    if (trades.size() > static_cast<size_t>(batch.maxCells)) {
+        std::nth_element(trades.begin(), trades.begin() + batch.maxCells, trades.end(), bySizeDesc);
+        trades.resize(static_cast<size_t>(batch.maxCells));
+    }
+    std::sort(trades.begin(), trades.end(), bySizeDesc);
+}
+
+QSGNode* TradeBubbleStrategy::buildNode(const GridSliceBatch& batch) {
+    if (!batch.tradeBlocks || batch.maxCells <= 0) return nullptr;
+    const Viewport& vp = batch.viewport;
+    if (vp.timeEnd_ms <= vp.timeStart_ms || vp.priceMax <= vp.priceMin) return nullptr;
     
+    updateSelection(batch);
+    const std::vector<TradePrint>& validTrades = m_selection.trades;
+    const double maxTradeSize = m_selection.maxTradeSize;
     if (validTrades.empty()) return nullptr;
     
-    // Sort by size (largest first for proper depth rendering)
-    std::sort(validTrades.begin(), validTrades.end(), 
-              [](const Trade* a, const Trade* b) {
-                  return a->size > b->size;
-              });
+    // Bubble centers are world offsets from the viewport's start/floor; radii stay in pixels
+    WorldSpaceMaterial::Grid grid;
+    grid.originTime_ms = vp.timeStart_ms;
+    grid.originPrice = vp.priceMin;
+
+    auto* node = new QSGGeometryNode;
+    auto* material = new WorldColorMaterial;
+    material->setGrid(grid);
+    material->setViewport(vp);
+    node->setMaterial(material);
+    node->setFlag(QSGNode::OwnsMaterial);
+    m_builtViewport = vp;
     
     // Limit trade count for performance
     int tradeCount = std::min(static_cast<int>(validTrades.size()), batch.maxCells);
@@ -54,17 +107,17 @@ QSGNode* TradeBubbleStrategy::buildNode(const GridSliceBatch& batch) {
     int vertexCount = tradeCount * 18;
     
     // Create geometry
-    auto* geometry = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), vertexCount);
+    auto* geometry = new QSGGeometry(WorldColorMaterial::attributes(), vertexCount);
     geometry->setDrawingMode(QSGGeometry::DrawTriangles);
     node->setGeometry(geometry);
     node->setFlag(QSGNode::OwnsGeometry);
     
     // Fill vertex buffer
-    auto* vertices = static_cast<QSGGeometry::ColoredPoint2D*>(geometry->vertexData());
+    auto* vertices = static_cast<WorldColorMaterial::Vertex*>(geometry->vertexData());
     int vertexIndex = 0;
     
     for (int i = 0; i < tradeCount; ++i) {
-        const auto& trade = *validTrades[i];
+        const auto& trade = validTrades[i];
         
         // Calculate bubble properties from trade data
         double scaledIntensity = calculateIntensity(trade.size, batch.intensityScale);
@@ -72,11 +125,9 @@ QSGNode* TradeBubbleStrategy::buildNode(const GridSliceBatch& batch) {
         bool isBid = (trade.side == AggressorSide::Buy);
         QColor bubbleColor = calculateBubbleColor(trade.size, isBid, scaledIntensity);
         
-        // Convert trade timestamp and price to screen coordinates
-        auto tradeTime = std::chrono::duration_cast<std::chrono::milliseconds>(trade.timestamp.time_since_epoch()).count();
-        QPointF tradePos = CoordinateSystem::worldToScreen(tradeTime, trade.price, batch.viewport);
-        float centerX = static_cast<float>(tradePos.x());
-        float centerY = static_cast<float>(tradePos.y());
+        // World offset of the trade from the grid origin; mapped to pixels on the GPU
+        float centerX = static_cast<float>(trade.time_ms - grid.originTime_ms);
+        float centerY = static_cast<float>(trade.price - grid.originPrice);
         
         // Create smooth bubble geometry
         createBubbleGeometry(vertices, vertexIndex, centerX, centerY, bubbleRadius, bubbleColor);
@@ -106,27 +157,14 @@ float TradeBubbleStrategy::calculateBubbleRadius(double tradeSize, double maxTra
 }
 
 QColor TradeBubbleStrategy::calculateBubbleColor(double liquidity, bool isBid, double intensity) const {
-    // Enhanced color scheme with better contrast and vibrancy
-    double alpha = std::min(intensity * m_bubbleOpacity, 1.0);
-    
-    if (isBid) {
-        // Bid trades: Beautiful blue-cyan gradient
-        double saturation = std::min(intensity * 1.2, 1.0);
-        int red = static_cast<int>(20 * saturation);
-        int green = static_cast<int>(150 + 105 * saturation);  // 150-255 range
-        int blue = static_cast<int>(200 + 55 * saturation);    // 200-255 range
-        return QColor(red, green, blue, static_cast<int>(alpha * 255));
-    } else {
-        // Ask trades: Beautiful orange-red gradient
-        double saturation = std::min(intensity * 1.2, 1.0);
-        int red = static_cast<int>(200 + 55 * saturation);     // 200-255 range  
-        int green = static_cast<int>(100 + 80 * saturation);   // 100-180 range
-        int blue = static_cast<int>(20 * saturation);
-        return QColor(red, green, blue, static_cast<int>(alpha * 255));
-    }
+    Q_UNUSED(liquidity)
+    // Theme ramp lookup; the ramp's alpha is scaled by the configured bubble opacity
+    const ColorRamp::Rgba& c = colorRamp().sample(isBid ? RampPalette::BubbleBuy : RampPalette::BubbleSell, intensity);
+    const int alpha = std::min(255, static_cast<int>(c.a * m_bubbleOpacity + 0.5f));
+    return QColor(c.r, c.g, c.b, alpha);
 }
 
-void TradeBubbleStrategy::createBubbleGeometry(QSGGeometry::ColoredPoint2D* vertices, int& vertexIndex,
+void TradeBubbleStrategy::createBubbleGeometry(WorldColorMaterial::Vertex* vertices, int& vertexIndex,
                                               float centerX, float centerY, float radius, const QColor& color) const {
     // Create 6 triangles for a smooth circle (18 vertices total)
     const int triangleCount = 6;
@@ -138,18 +176,18 @@ void TradeBubbleStrategy::createBubbleGeometry(QSGGeometry::ColoredPoint2D* vert
         float angle1 = tri * angleStep;
         float angle2 = (tri + 1) * angleStep;
         
-        // Calculate triangle vertices
-        float x1 = centerX + radius * std::cos(angle1);
-        float y1 = centerY + radius * std::sin(angle1);
-        float x2 = centerX + radius * std::cos(angle2);
-        float y2 = centerY + radius * std::sin(angle2);
+        // Rim offsets in pixels around the shared world-space center
+        float x1 = radius * std::cos(angle1);
+        float y1 = radius * std::sin(angle1);
+        float x2 = radius * std::cos(angle2);
+        float y2 = radius * std::sin(angle2);
         
         // Create filled triangle: center, point1, point2
-        vertices[vertexIndex++].set(centerX, centerY, 
+        vertices[vertexIndex++].set(centerX, centerY, 0.0f, 0.0f,
                                    color.red(), color.green(), color.blue(), color.alpha());
-        vertices[vertexIndex++].set(x1, y1, 
+        vertices[vertexIndex++].set(centerX, centerY, x1, y1,
                                    color.red(), color.green(), color.blue(), color.alpha());
-        vertices[vertexIndex++].set(x2, y2, 
+        vertices[vertexIndex++].set(centerX, centerY, x2, y2,
                                    color.red(), color.green(), color.blue(), color.alpha());
     }
 }
\ No newline at end of file
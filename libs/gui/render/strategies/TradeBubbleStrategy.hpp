@@ -7,10 +7,15 @@ Performance: Creates smooth, anti-aliased bubbles with size proportional to trad
 Integration: Instantiated and managed by UnifiedGridRenderer as a pluggable strategy.
 Observability: No internal logging.
 Related: TradeBubbleStrategy.cpp, IRenderStrategy.hpp, UnifiedGridRenderer.h, GridTypes.hpp.
-Assumptions: Each cell in the input batch represents a trade with size used for bubble scaling.
+Assumptions: Each print in the input batch (GridSliceBatch::trades) is one trade, with size used for bubble scaling.
 */
 #pragma once
 #include "../IRenderStrategy.hpp"
+#include "../GridTypes.hpp"
+#include "../WorldColorMaterial.hpp"
+#include "../../CoordinateSystem.h"
+#include <memory>
+#include <vector>
 
 class TradeBubbleStrategy : public IRenderStrategy {
 public:
@@ -20,6 +25,7 @@ public:
     QSGNode* buildNode(const GridSliceBatch& batch) override;
     QColor calculateColor(double liquidity, bool isBid, double intensity) const override;
     const char* getStrategyName() const override { return "TradeBubbles"; }
+    bool applyViewport(QSGNode* layer, const Viewport& viewport) override;
     
     // Configuration
     void setMinBubbleRadius(float radius) { m_minBubbleRadius = radius; }
@@ -45,10 +51,27 @@ private:
     float m_maxBubbleRadius = 20.0f;   // Maximum bubble size (pixels)
     float m_bubbleOpacity = 0.85f;     // Base opacity for bubbles
     float m_outlineWidth = 1.5f;       // Outline width for better visibility
+    Viewport m_builtViewport;          // Viewport the current bubble set was selected for
+
+    // Largest prints for one (block list, viewport range, filter, maxCells), largest first. Within one epoch
+    // the list only grows at its tail, and top-N(old + new) = top-N(top-N(old) + new), so a rebuild with the
+    // same key scans just the prints appended since the last one.
+    struct Selection {
+        std::shared_ptr<const TradeHistoryStore::Blocks> blocks;
+        uint64_t epoch = 0;
+        size_t tailCount = 0;          // Prints of the last block already scanned
+        Viewport viewport;
+        double minVolume = 0.0;
+        int maxCells = 0;
+        std::vector<TradePrint> trades;
+        double maxTradeSize = 0.0;     // Over every print that passed the filter, not just the kept ones
+    };
+    Selection m_selection;
+    void updateSelection(const GridSliceBatch& batch);
     
     // Helper methods
     float calculateBubbleRadius(double tradeSize, double maxTradeSize) const;
     QColor calculateBubbleColor(double liquidity, bool isBid, double intensity) const;
-    void createBubbleGeometry(QSGGeometry::ColoredPoint2D* vertices, int& vertexIndex,
+    void createBubbleGeometry(WorldColorMaterial::Vertex* vertices, int& vertexIndex,
                              float centerX, float centerY, float radius, const QColor& color) const;
 };
\ No newline at end of file
@@ -1,114 +1,122 @@
 /*
 Sentinel — TradeFlowStrategy
-Role: Implements the logic for rendering individual trades as vertical lines.
-Inputs/Outputs: Creates a QSGNode containing a child node for each trade line.
+Role: Implements trade density rendering: one quad per (time bucket, price row) bin, colored by buy/sell mix.
+Inputs/Outputs: Creates a single QSGGeometryNode of world-space quads from the batch's trade density bins.
 Threading: All code is executed on the Qt Quick render thread.
-Performance: Note: This implementation creates a large number of child nodes, which can be slow.
+Performance: Vertex count tracks visible non-empty bins (capped by maxCells); pan/zoom within 2x of the build scale is a uniform update.
 Integration: The concrete implementation of the trade flow visualization strategy.
 Observability: No internal logging.
-Related: TradeFlowStrategy.hpp.
-Assumptions: The 'liquidity' field of a cell is used to determine the rendered line's length.
+Related: TradeFlowStrategy.hpp, FootprintEngine.h.
+Assumptions: Bin volume is normalized against the busiest visible bin, so the ramp adapts as the view changes.
 */
 #include "TradeFlowStrategy.hpp"
 #include "../GridTypes.hpp"
-#include "../../CoordinateSystem.h"
+#include "../WorldColorMaterial.hpp"
 #include <QSGGeometryNode>
-#include <QSGVertexColorMaterial>
 #include <QSGGeometry>
 #include <algorithm>
 #include <cmath>
 
+namespace {
+    // Bins are sized for the build-time pixel scale; beyond this zoom change they are re-queried
+    constexpr double kMaxRemapZoom = 2.0;
+
+    double msPerPixel(const Viewport& vp) {
+        return static_cast<double>(vp.timeEnd_ms - vp.timeStart_ms) / vp.width;
+    }
+}
+
+bool TradeFlowStrategy::applyViewport(QSGNode* layer, const Viewport& viewport) {
+    if (!layer || viewport.width <= 0.0 || !viewportWithin(viewport, m_builtViewport)) return false;
+    const double zoom = msPerPixel(m_builtViewport) / std::max(1e-9, msPerPixel(viewport));
+    if (zoom > kMaxRemapZoom || zoom < 1.0 / kMaxRemapZoom) return false;
+    WorldSpaceMaterial::applyViewport(layer, viewport);
+    return true;
+}
 
 QSGNode* TradeFlowStrategy::buildNode(const GridSliceBatch& batch) {
-    if (batch.recentTrades.empty()) return nullptr;
-    
-    // Create geometry node for trade flow rendering
+    if (!batch.tradeDensityCells) return nullptr;
+    const auto& bins = *batch.tradeDensityCells;
+    const Viewport& vp = batch.viewport;
+    if (bins.empty() || vp.width <= 0.0 || vp.height <= 0.0 ||
+        vp.timeEnd_ms <= vp.timeStart_ms || vp.priceMax <= vp.priceMin) return nullptr;
+
+    double maxVolume = 0.0;
+    int binCount = 0;
+    for (const auto& bin : bins) {
+        if (bin.totalVolume() < batch.minVolumeFilter) continue;
+        maxVolume = std::max(maxVolume, bin.totalVolume());
+        ++binCount;
+    }
+    binCount = std::min(binCount, batch.maxCells);
+    if (binCount == 0 || maxVolume <= 0.0) return nullptr;
+
+    // World-space rectangles relative to the viewport's start/floor; the material maps them to pixels
+    WorldSpaceMaterial::Grid grid;
+    grid.originTime_ms = vp.timeStart_ms;
+    grid.originPrice = vp.priceMin;
+
     auto* node = new QSGGeometryNode;
-    auto* material = new QSGVertexColorMaterial;
-    material->setFlag(QSGMaterial::Blending);
+    auto* material = new WorldColorMaterial;
+    material->setGrid(grid);
+    material->setViewport(vp);
     node->setMaterial(material);
     node->setFlag(QSGNode::OwnsMaterial);
-    
-    // Use raw trade data like TradeBubbleStrategy
-    std::vector<const Trade*> validTrades;
-    for (const auto& trade : batch.recentTrades) {
-        if (trade.size >= batch.minVolumeFilter) {
-            validTrades.push_back(&trade);
-        }
-    }
-    
-    int tradeCount = std::min(static_cast<int>(validTrades.size()), batch.maxCells);
-    if (tradeCount == 0) return nullptr;
-    
-    int vertexCount = tradeCount * 6;
-    
-    // Create geometry
-    auto* geometry = new QSGGeometry(QSGGeometry::defaultAttributes_ColoredPoint2D(), vertexCount);
+    m_builtViewport = vp;
+
+    auto* geometry = new QSGGeometry(WorldColorMaterial::attributes(), binCount * kVerticesPerQuad);
     geometry->setDrawingMode(QSGGeometry::DrawTriangles);
     node->setGeometry(geometry);
     node->setFlag(QSGNode::OwnsGeometry);
-    
-    // Fill vertex buffer
-    auto* vertices = static_cast<QSGGeometry::ColoredPoint2D*>(geometry->vertexData());
+
+    auto* vertices = static_cast<WorldColorMaterial::Vertex*>(geometry->vertexData());
     int vertexIndex = 0;
-    
-    // TEMPORARY: Just return empty geometry to test if vertex processing is the crash
-    // TODO: Remove this and restore the vertex processing once we confirm it's not the issue
-    
-    for (int i = 0; i < tradeCount && i < 10; ++i) {  // Limit to 10 trades for safety
-        const auto& trade = *validTrades[i];
-        
-        // Add basic safety checks
-        if (!validTrades[i]) continue;  // Null pointer check
-        if (trade.size <= 0.0) continue;  // Invalid trade size
-        
-        // Calculate color and size based on trade intensity
-        double scaledIntensity = calculateIntensity(trade.size, batch.intensityScale);
-        bool isBid = (trade.side == AggressorSide::Buy);
-        QColor color = calculateColor(trade.size, isBid, scaledIntensity);
-        
-        // Trade dot size based on trade size (min 2px, max 8px)
-        float radius = std::max(2.0f, std::min(8.0f, static_cast<float>(scaledIntensity * 6.0)));
-        
-        // Convert trade timestamp and price to screen coordinates  
-        auto tradeTime = std::chrono::duration_cast<std::chrono::milliseconds>(trade.timestamp.time_since_epoch()).count();
-        QPointF tradePos = CoordinateSystem::worldToScreen(tradeTime, trade.price, batch.viewport);
-        float centerX = static_cast<float>(tradePos.x());
-        float centerY = static_cast<float>(tradePos.y());
-        
-        // Safety check for coordinates
-        if (!std::isfinite(centerX) || !std::isfinite(centerY)) continue;
-        
-        // Create triangulated circle approximation (6 triangles from center)
-        for (int tri = 0; tri < 6; ++tri) {
-            float angle1 = (tri * M_PI) / 3.0f;
-            float angle2 = ((tri + 1) * M_PI) / 3.0f;
-            
-            // Triangle: center, point1, point2
-            vertices[vertexIndex++].set(centerX, centerY, color.red(), color.green(), color.blue(), color.alpha());
-            vertices[vertexIndex++].set(centerX + radius * cos(angle1), centerY + radius * sin(angle1), color.red(), color.green(), color.blue(), color.alpha());
-            vertices[vertexIndex++].set(centerX + radius * cos(angle2), centerY + radius * sin(angle2), color.red(), color.green(), color.blue(), color.alpha());
-        }
+    const double logMax = std::log1p(maxVolume);
+    const ColorRamp& ramp = colorRamp();
+
+    // Keep every bin at least one build-time pixel wide/tall
+    const double minWidth = msPerPixel(vp);
+    const double minHeight = (vp.priceMax - vp.priceMin) / vp.height;
+
+    int emitted = 0;
+    for (const auto& bin : bins) {
+        if (emitted == binCount) break;
+        const double volume = bin.totalVolume();
+        if (volume < batch.minVolumeFilter) continue;
+
+        const double leftMs = static_cast<double>(bin.timeStart_ms - grid.originTime_ms);
+        const double rightMs = std::max(leftMs + minWidth, static_cast<double>(bin.timeEnd_ms - grid.originTime_ms));
+        const double topPrice = bin.priceMax - grid.originPrice;
+        const double bottomPrice = std::min(topPrice - minHeight, bin.priceMin - grid.originPrice);
+        const float left = static_cast<float>(leftMs);
+        const float right = static_cast<float>(rightMs);
+        const float top = static_cast<float>(topPrice);
+        const float bottom = static_cast<float>(bottomPrice);
+
+        // Log ramp against the busiest visible bin; hue follows the bin's buy share
+        const double intensity = std::clamp(std::log1p(volume) / logMax * batch.intensityScale, 0.0, 1.0);
+        const ColorRamp::Rgba& sell = ramp.sample(RampPalette::FlowSell, intensity);
+        const ColorRamp::Rgba& buy = ramp.sample(RampPalette::FlowBuy, intensity);
+        const double buyShare = bin.askVolume / volume;
+        const int r = static_cast<int>(sell.r + (buy.r - sell.r) * buyShare);
+        const int g = static_cast<int>(sell.g + (buy.g - sell.g) * buyShare);
+        const int b = static_cast<int>(sell.b + (buy.b - sell.b) * buyShare);
+        const int a = std::max(sell.a, buy.a);
+
+        vertices[vertexIndex++].set(left, top, 0.0f, 0.0f, r, g, b, a);
+        vertices[vertexIndex++].set(right, top, 0.0f, 0.0f, r, g, b, a);
+        vertices[vertexIndex++].set(left, bottom, 0.0f, 0.0f, r, g, b, a);
+        vertices[vertexIndex++].set(right, top, 0.0f, 0.0f, r, g, b, a);
+        vertices[vertexIndex++].set(right, bottom, 0.0f, 0.0f, r, g, b, a);
+        vertices[vertexIndex++].set(left, bottom, 0.0f, 0.0f, r, g, b, a);
+        ++emitted;
     }
-    
-    // Vertex count should match exactly now
+
     node->markDirty(QSGNode::DirtyGeometry);
-    
     return node;
 }
 
 QColor TradeFlowStrategy::calculateColor(double liquidity, bool isBid, double intensity) const {
-    double alpha = std::min(intensity * 0.9, 1.0);
-    
-    if (isBid) {
-        // Bid trades: Blue-green spectrum
-        double blue = std::min(255.0 * intensity, 255.0); 
-        double green = std::min(200.0 * intensity, 200.0);
-        return QColor(0, static_cast<int>(green), static_cast<int>(blue), static_cast<int>(alpha * 255));
-    } else {
-        // Ask trades: Orange-red spectrum
-        double red = std::min(255.0 * intensity, 255.0);
-        double green = std::min(150.0 * intensity, 150.0);
-        return QColor(static_cast<int>(red), static_cast<int>(green), 0, static_cast<int>(alpha * 255));
-    }
-}
\ No newline at end of file
+    Q_UNUSED(liquidity)
+    return colorRamp().color(isBid ? RampPalette::FlowBuy : RampPalette::FlowSell, intensity);
+}
@@ -1,30 +1,28 @@
 /*
 Sentinel — TradeFlowStrategy
-Role: A concrete render strategy that visualizes individual trades on the chart.
-Inputs/Outputs: Implements IRenderStrategy to turn a GridSliceBatch into a QSGNode tree.
+Role: A concrete render strategy that visualizes the session's trade tape as buy/sell density bins.
+Inputs/Outputs: Implements IRenderStrategy to turn GridSliceBatch::tradeDensityCells into a QSGNode.
 Threading: Methods are called exclusively on the Qt Quick render thread.
-Performance: Creates a new child QSGNode for each trade, potentially creating many nodes.
+Performance: One quad per non-empty bin in a single geometry node; cost is bounded by bins, not prints.
 Integration: Instantiated and managed by UnifiedGridRenderer as a pluggable strategy.
 Observability: No internal logging.
-Related: TradeFlowStrategy.cpp, IRenderStrategy.hpp, UnifiedGridRenderer.h, GridTypes.hpp.
-Assumptions: Each cell in the input batch represents an individual trade to be rendered.
+Related: TradeFlowStrategy.cpp, IRenderStrategy.hpp, UnifiedGridRenderer.h, GridTypes.hpp, FootprintEngine.h.
+Assumptions: Bins arrive pre-aggregated by DataProcessor's trade density engine at roughly pixel-sized resolution.
 */
 #pragma once
 #include "../IRenderStrategy.hpp"
+#include "../../CoordinateSystem.h"
 
 class TradeFlowStrategy : public IRenderStrategy {
 public:
     TradeFlowStrategy() = default;
     ~TradeFlowStrategy() override = default;
-    
+
     QSGNode* buildNode(const GridSliceBatch& batch) override;
     QColor calculateColor(double liquidity, bool isBid, double intensity) const override;
     const char* getStrategyName() const override { return "TradeFlow"; }
-    
+    bool applyViewport(QSGNode* layer, const Viewport& viewport) override;
+
 private:
-    struct TradeVertex {
-        float x, y;           // Position
-        float r, g, b, a;     // Color
-        float radius;         // Trade dot size
-    };
-};
\ No newline at end of file
+    Viewport m_builtViewport;  // Viewport the current bins were queried and built for
+};
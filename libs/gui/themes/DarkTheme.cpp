@@ -1,4 +1,5 @@
 #include "DarkTheme.hpp"
+#include <cmath>
 
 QString DarkTheme::stylesheet() const {
     return R"(
@@ -319,3 +320,63 @@ QString DarkTheme::stylesheet() const {
     )";
 }
 
+
+
+std::vector<RampStop> DarkTheme::rampStops(RampPalette palette) const {
+    switch (palette) {
+        case RampPalette::HeatmapBid:
+            // Bid liquidity: green spectrum, alpha follows intensity
+            return {{0.0, QColor(0, 0, 0, 0)}, {1.0, QColor(0, 255, 0, 255)}};
+        case RampPalette::HeatmapAsk:
+            // Ask liquidity: red spectrum
+            return {{0.0, QColor(0, 0, 0, 0)}, {1.0, QColor(255, 0, 0, 255)}};
+        case RampPalette::CandleBull:
+            // Bullish volume: green with yellow highlights
+            return {{0.0, QColor(0, 0, 0, 0)}, {1.0, QColor(100, 255, 0, 217)}};
+        case RampPalette::CandleBear:
+            // Bearish volume: red with orange highlights
+            return {{0.0, QColor(0, 0, 0, 0)}, {1.0, QColor(255, 80, 0, 217)}};
+        case RampPalette::BubbleBuy:
+            // Buy prints: blue-cyan, saturating at 5/6 intensity
+            return {{0.0, QColor(0, 150, 200, 0)}, {5.0 / 6.0, QColor(20, 255, 255, 212)}, {1.0, QColor(20, 255, 255, 255)}};
+        case RampPalette::BubbleSell:
+            // Sell prints: orange-red
+            return {{0.0, QColor(200, 100, 0, 0)}, {5.0 / 6.0, QColor(255, 180, 20, 212)}, {1.0, QColor(255, 180, 20, 255)}};
+        case RampPalette::FlowBuy:
+            // Buy aggression: blue-green with a visible floor
+            return {{0.0, QColor(0, 0, 0, 38)}, {1.0, QColor(0, 200, 255, 230)}};
+        case RampPalette::FlowSell:
+            // Sell aggression: orange-red
+            return {{0.0, QColor(0, 0, 0, 38)}, {1.0, QColor(255, 150, 0, 230)}};
+        case RampPalette::FootprintSell:
+        case RampPalette::FootprintBuy: {
+            // Square-root ramp keeps small prints visible next to the bar's largest cell
+            const bool sell = palette == RampPalette::FootprintSell;
+            std::vector<RampStop> stops;
+            for (int i = 0; i <= 16; ++i) {
+                const double position = i / 16.0;
+                const double t = std::sqrt(position);
+                const int alpha = static_cast<int>(60 + 180 * t);
+                stops.push_back({position, sell ? QColor(220, static_cast<int>(70 * (1.0 - t)), 60, alpha)
+                                                : QColor(static_cast<int>(60 * (1.0 - t)), 200, 110, alpha)});
+            }
+            return stops;
+        }
+        case RampPalette::IcebergBid:
+            return {{0.0, QColor(0, 220, 255, 80)}, {1.0, QColor(0, 220, 255, 240)}};
+        case RampPalette::IcebergAsk:
+            return {{0.0, QColor(255, 140, 0, 80)}, {1.0, QColor(255, 140, 0, 240)}};
+        case RampPalette::OrderFlowBuy:
+            return {{0.0, QColor(0, 200, 120, 90)}, {1.0, QColor(0, 200, 120, 240)}};
+        case RampPalette::OrderFlowSell:
+            return {{0.0, QColor(230, 60, 60, 90)}, {1.0, QColor(230, 60, 60, 240)}};
+        case RampPalette::DepthBid:
+            // Depth profile: translucent fill at low intensity, opaque outline at 1.0
+            return {{0.0, QColor(0, 200, 90, 40)}, {1.0, QColor(60, 255, 140, 255)}};
+        case RampPalette::DepthAsk:
+            return {{0.0, QColor(220, 40, 40, 40)}, {1.0, QColor(255, 100, 90, 255)}};
+        case RampPalette::Count:
+            break;
+    }
+    return {{0.0, QColor(0, 0, 0, 0)}, {1.0, QColor(255, 255, 255, 255)}};
+}
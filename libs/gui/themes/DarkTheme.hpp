@@ -13,5 +13,6 @@ public:
     QString id() const override { return "dark"; }
     QString description() const override { return "Professional dark theme optimized for trading"; }
     QString stylesheet() const override;
+    std::vector<RampStop> rampStops(RampPalette palette) const override;
 };
 
@@ -1,7 +1,38 @@
 #pragma once
 
+#include <QColor>
 #include <QString>
 #include <QStringList>
+#include <vector>
+
+/**
+ * Data-visualization palettes. Each is a ramp over normalized intensity [0, 1]
+ * that ColorRamp samples into a lookup table for the render strategies.
+ */
+enum class RampPalette {
+    HeatmapBid,
+    HeatmapAsk,
+    CandleBull,
+    CandleBear,
+    BubbleBuy,
+    BubbleSell,
+    FlowBuy,
+    FlowSell,
+    FootprintSell,
+    FootprintBuy,
+    IcebergBid,
+    IcebergAsk,
+    OrderFlowBuy,
+    OrderFlowSell,
+    DepthBid,
+    DepthAsk,
+    Count
+};
+
+struct RampStop {
+    double position;  // Normalized intensity [0, 1], ascending
+    QColor color;     // Straight (non-premultiplied) alpha
+};
 
 /**
  * Interface for theme implementations.
@@ -26,6 +57,11 @@ public:
      */
     virtual QString stylesheet() const = 0;
     
+    /**
+     * Get the color stops for a data-visualization palette.
+     */
+    virtual std::vector<RampStop> rampStops(RampPalette palette) const = 0;
+    
     /**
      * Optional: Get a description of the theme.
      */
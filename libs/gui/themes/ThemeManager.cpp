@@ -37,11 +37,17 @@ bool ThemeManager::applyTheme(const QString& themeId, QApplication* app) {
     QString stylesheet = it->second->stylesheet();
     app->setStyleSheet(stylesheet);
     m_currentTheme = themeId;
+    ++m_themeRevision;
     
     qDebug() << "ThemeManager: Applied theme" << themeId << "-" << it->second->name();
     return true;
 }
 
+const ITheme* ThemeManager::activeTheme() const {
+    auto it = m_themes.find(m_currentTheme);
+    return it == m_themes.end() ? nullptr : it->second.get();
+}
+
 QStringList ThemeManager::availableThemes() const {
     QStringList themes;
     for (const auto& pair : m_themes) {
@@ -43,6 +43,16 @@ public:
      */
     QString currentTheme() const { return m_currentTheme; }
     
+    /**
+     * Get the active theme object (nullptr before a theme is applied).
+     */
+    const ITheme* activeTheme() const;
+    
+    /**
+     * Incremented on every applyTheme(); renderers compare it to refresh palettes.
+     */
+    quint64 themeRevision() const { return m_themeRevision; }
+    
     /**
      * Initialize default themes.
      * Call this after QApplication is created.
@@ -57,5 +67,6 @@ private:
     
     std::map<QString, std::unique_ptr<ITheme>> m_themes;
     QString m_currentTheme;
+    quint64 m_themeRevision = 0;
 };
 
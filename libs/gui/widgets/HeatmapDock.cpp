@@ -3,6 +3,9 @@
 #include <QSurfaceFormat>
 #include <QSGRendererInterface>
 #include <QQuickWindow>
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+#include <QQuickGraphicsConfiguration>
+#endif
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QFrame>
@@ -28,6 +31,12 @@ void HeatmapDock::buildUi() {
     // Configure surface format for optimal GPU performance
     QSurfaceFormat format = QSurfaceFormat::defaultFormat();
     m_qquickView->setFormat(format);
+#if QT_VERSION >= QT_VERSION_CHECK(6, 6, 0)
+    // GPU timestamps for the performance overlay (must be set before the scene graph initializes)
+    QQuickGraphicsConfiguration graphicsConfig = m_qquickView->graphicsConfiguration();
+    graphicsConfig.setTimestamps(true);
+    m_qquickView->setGraphicsConfiguration(graphicsConfig);
+#endif
     
     // Create container widget for QML
     m_qmlContainer = QWidget::createWindowContainer(m_qquickView, m_contentWidget);
@@ -2,11 +2,30 @@
 #include "ServiceLocator.hpp"
 #include "../../core/marketdata/MarketDataCore.hpp"
 #include "../../core/marketdata/cache/DataCache.hpp"
+#include "../../core/marketdata/feeds/FeedAggregator.hpp"
 #include "../../../libs/core/SentinelLogging.hpp"
 #include <QGridLayout>
 #include <QFont>
+#include <QDateTime>
 #include <vector>
 
+namespace {
+    QString formatNotional(double notional) {
+        if (notional >= 1'000'000.0) return QString("$%1M").arg(notional / 1'000'000.0, 0, 'g', 3);
+        if (notional >= 1'000.0) return QString("$%1k").arg(notional / 1'000.0, 0, 'g', 3);
+        return QString("$%1").arg(notional, 0, 'f', 0);
+    }
+
+    QString formatFill(const MarketFill& fill) {
+        if (fill.quantity <= 0.0) return "---";
+        QString text = QString("%1 (%2bp)").arg(QString::number(fill.vwap, 'f', 2))
+                                            .arg(QString::number(fill.slippageBps, 'f', 1));
+        // Book ran out of depth before the full notional filled
+        if (fill.filledNotional < fill.requestedNotional * 0.999) text += " thin";
+        return text;
+    }
+}
+
 OrderBookDock::OrderBookDock(QWidget* parent)
     : DockablePanel("orderbook", "Order Book", parent)
 {
@@ -27,11 +46,21 @@ void OrderBookDock::buildUi()
     m_symbolLabel->setAlignment(Qt::AlignCenter);
     m_symbolLabel->setStyleSheet("QLabel { font-weight: bold; font-size: 14px; color: #ffffff; padding: 4px; }");
     mainLayout->addWidget(m_symbolLabel);
+
+    m_consolidatedCheck = new QCheckBox("All venues", m_contentWidget);
+    m_consolidatedCheck->setStyleSheet("QCheckBox { color: #cccccc; font-size: 10px; }");
+    m_consolidatedCheck->setToolTip("Top of book merged across every venue (the impact ladder stays on the symbol's own book)");
+    connect(m_consolidatedCheck, &QCheckBox::toggled, this, [this]() { m_bookDirty = true; });
+    mainLayout->addWidget(m_consolidatedCheck);
     
     // Spread frame container
     setupSpreadLayout();
     mainLayout->addWidget(m_spreadFrame);
     
+    // Cost to trade each notional size on either side
+    setupImpactLayout();
+    mainLayout->addWidget(m_impactFrame);
+    
     // Future: Order book table will go here
     // mainLayout->addWidget(m_orderBookTable, 1);  // Takes remaining space
     
@@ -39,6 +68,11 @@ void OrderBookDock::buildUi()
     
     // Connect to market data after UI is built
     connectToMarketData();
+    
+    m_refreshTimer = new QTimer(this);
+    m_refreshTimer->setInterval(static_cast<int>(m_impactEngine.publishInterval()));
+    connect(m_refreshTimer, &QTimer::timeout, this, &OrderBookDock::refreshFromBook);
+    m_refreshTimer->start();
 }
 
 void OrderBookDock::setupSpreadLayout()
@@ -119,17 +153,67 @@ void OrderBookDock::setupSpreadLayout()
     gridLayout->setColumnStretch(2, 1);
 }
 
+void OrderBookDock::setupImpactLayout()
+{
+    m_impactFrame = new QFrame(m_contentWidget);
+    m_impactFrame->setFrameStyle(QFrame::Box);
+    m_impactFrame->setStyleSheet("QFrame { border: 1px solid #444; background-color: #2a2a2a; }");
+    
+    auto* gridLayout = new QGridLayout(m_impactFrame);
+    gridLayout->setContentsMargins(8, 8, 8, 8);
+    gridLayout->setHorizontalSpacing(8);
+    gridLayout->setVerticalSpacing(2);
+    
+    const QString headerStyle = "QLabel { font-weight: bold; font-size: 10px; color: %1; border: none; }";
+    auto* sizeHeader = new QLabel("SIZE", m_impactFrame);
+    sizeHeader->setStyleSheet(headerStyle.arg("#ffffff"));
+    auto* buyHeader = new QLabel("BUY VWAP (slip)", m_impactFrame);
+    buyHeader->setStyleSheet(headerStyle.arg("#f44336"));
+    buyHeader->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    auto* sellHeader = new QLabel("SELL VWAP (slip)", m_impactFrame);
+    sellHeader->setStyleSheet(headerStyle.arg("#4caf50"));
+    sellHeader->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    gridLayout->addWidget(sizeHeader, 0, 0);
+    gridLayout->addWidget(buyHeader, 0, 1);
+    gridLayout->addWidget(sellHeader, 0, 2);
+    
+    // Buys lift asks (red), sells hit bids (green)
+    const QString cellStyle = "QLabel { font-size: 11px; color: %1; border: none; }";
+    int row = 1;
+    for (double notional : m_impactEngine.notionalLadder()) {
+        ImpactRow labels;
+        labels.size = new QLabel(formatNotional(notional), m_impactFrame);
+        labels.size->setStyleSheet(cellStyle.arg("#ffffff"));
+        labels.buy = new QLabel("---", m_impactFrame);
+        labels.buy->setStyleSheet(cellStyle.arg("#ef5350"));
+        labels.buy->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        labels.sell = new QLabel("---", m_impactFrame);
+        labels.sell->setStyleSheet(cellStyle.arg("#81c784"));
+        labels.sell->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
+        gridLayout->addWidget(labels.size, row, 0);
+        gridLayout->addWidget(labels.buy, row, 1);
+        gridLayout->addWidget(labels.sell, row, 2);
+        m_impactRows.push_back(labels);
+        ++row;
+    }
+}
+
 void OrderBookDock::onSymbolChanged(const QString& symbol)
 {
     sLog_App(QString("OrderBookDock: Symbol changed to %1").arg(symbol));
     
+    if (!m_currentSymbol.isEmpty()) {
+        m_impactEngine.forget(m_currentSymbol.toStdString());
+    }
     m_currentSymbol = symbol;
+    m_bookDirty = false;
     if (m_symbolLabel) {
         m_symbolLabel->setText(symbol.isEmpty() ? "No Symbol" : symbol);
     }
     
     // Reset display
     updateSpreadDisplay(0.0, 0.0, 0.0, 0.0);
+    updateImpactDisplay(nullptr);
     
     // TODO: Subscribe to order book updates for new symbol
     // For now, we'll wait for market data core to provide order book signals
@@ -155,26 +239,65 @@ void OrderBookDock::onOrderBookUpdated(const QString& symbol,
     Q_UNUSED(deltas);
 
     if (symbol != m_currentSymbol) {
+        // Venue books (SYMBOL@VENUE) move the consolidated top of book
+        if (m_consolidatedCheck && m_consolidatedCheck->isChecked() &&
+            feed::symbolOf(symbol.toStdString()) == m_currentSymbol.toStdString()) {
+            m_bookDirty = true;
+        }
         return;  // Not our symbol
     }
     
+    m_bookDirty = true;
+    m_impactEngine.onBookUpdated(symbol.toStdString());
+}
+
+void OrderBookDock::refreshFromBook()
+{
+    if (m_currentSymbol.isEmpty()) {
+        return;
+    }
+    
     auto* cache = ServiceLocator::dataCache();
     if (!cache) {
-        sLog_App("OrderBookDock: DataCache not available for order book updates");
+        if (m_bookDirty) {
+            sLog_App("OrderBookDock: DataCache not available for order book updates");
+            m_bookDirty = false;
+        }
         return;
     }
 
-    const LiveOrderBook& liveBook = cache->getDirectLiveOrderBook(symbol.toStdString());
-
-    std::vector<std::pair<uint32_t, double>> bidBuffer;
-    std::vector<std::pair<uint32_t, double>> askBuffer;
-
-    auto view = liveBook.captureDenseNonZero(bidBuffer, askBuffer, 1);
+    // The engine keeps its own dirty state and pacing, so it is polled on every tick
+    const std::string symbol = m_currentSymbol.toStdString();
+    const LiveOrderBook& liveBook = cache->getDirectLiveOrderBook(symbol);
+    if (m_impactEngine.poll(symbol, liveBook, QDateTime::currentMSecsSinceEpoch(), m_impactCurve)) {
+        updateImpactDisplay(&m_impactCurve);
+    }
+    
+    if (!m_bookDirty) {
+        return;
+    }
 
     double bidPrice = 0.0;
     double bidSize = 0.0;
     double askPrice = 0.0;
     double askSize = 0.0;
+    if (m_consolidatedCheck && m_consolidatedCheck->isChecked() &&
+        readConsolidatedTop(symbol, bidPrice, bidSize, askPrice, askSize)) {
+        m_bookDirty = false;
+        updateSpreadDisplay(bidPrice, bidSize, askPrice, askSize);
+        return;
+    }
+
+    // A book restored from a checkpoint stays dirty until its live snapshot replaces it
+    if (liveBook.isStale()) {
+        return;
+    }
+    m_bookDirty = false;
+
+    std::vector<std::pair<uint32_t, double>> bidBuffer;
+    std::vector<std::pair<uint32_t, double>> askBuffer;
+
+    auto view = liveBook.captureDenseNonZero(bidBuffer, askBuffer, 1);
 
     if (!view.bidLevels.empty()) {
         bidPrice = view.minPrice + static_cast<double>(view.bidLevels.front().first) * view.tickSize;
@@ -187,11 +310,33 @@ void OrderBookDock::onOrderBookUpdated(const QString& symbol,
     }
 
     sLog_Debug(QString("OrderBookDock: Top of book for %1 - Bid: %2@%3, Ask: %4@%5")
-               .arg(symbol).arg(bidPrice).arg(bidSize).arg(askPrice).arg(askSize));
+               .arg(m_currentSymbol).arg(bidPrice).arg(bidSize).arg(askPrice).arg(askSize));
     
     updateSpreadDisplay(bidPrice, bidSize, askPrice, askSize);
 }
 
+bool OrderBookDock::readConsolidatedTop(const std::string& symbol, double& bidPrice, double& bidSize,
+                                        double& askPrice, double& askSize) const
+{
+    auto* marketDataCore = ServiceLocator::marketDataCore();
+    const ConsolidatedBook* book = marketDataCore ? marketDataCore->feeds().consolidated(symbol) : nullptr;
+    if (!book) {
+        return false;
+    }
+    // Lock-free reads; a level can change between the index and the quantity, which the next tick corrects
+    const size_t bestBid = book->bestBidIndex();
+    const size_t bestAsk = book->bestAskIndex();
+    if (bestBid != ConsolidatedBook::kNoLevel) {
+        bidPrice = book->priceAt(bestBid);
+        bidSize = book->quantityAt(true, bestBid);
+    }
+    if (bestAsk != ConsolidatedBook::kNoLevel) {
+        askPrice = book->priceAt(bestAsk);
+        askSize = book->quantityAt(false, bestAsk);
+    }
+    return true;
+}
+
 void OrderBookDock::updateSpreadDisplay(double bidPrice, double bidSize, double askPrice, double askSize)
 {
     m_lastBidPrice = bidPrice;
@@ -226,4 +371,13 @@ void OrderBookDock::updateSpreadDisplay(double bidPrice, double bidSize, double
         m_spreadLabel->setText("Spread: ---.--");
         m_midLabel->setText("Mid: ---.--");
     }
-}
\ No newline at end of file
+}
+
+void OrderBookDock::updateImpactDisplay(const ImpactCurve* curve)
+{
+    for (size_t i = 0; i < m_impactRows.size(); ++i) {
+        const ImpactRow& row = m_impactRows[i];
+        row.buy->setText(curve && i < curve->buys.size() ? formatFill(curve->buys[i]) : "---");
+        row.sell->setText(curve && i < curve->sells.size() ? formatFill(curve->sells[i]) : "---");
+    }
+}
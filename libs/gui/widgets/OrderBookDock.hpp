@@ -2,11 +2,14 @@
 #define ORDERBOOKDOCK_HPP
 
 #include "DockablePanel.hpp"
+#include <QCheckBox>
 #include <QLabel>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QFrame>
+#include <QTimer>
 #include <vector>
+#include "../../core/MarketImpactEngine.h"
 
 class MarketDataCore;
 struct BookDelta;
@@ -14,7 +17,9 @@ struct BookDelta;
 /**
  * @brief Order book visualization dock starting with best bid/ask
  * 
- * Current: Shows best bid/ask spread with visual formatting
+ * Current: Shows best bid/ask spread and a market-impact ladder (VWAP / slippage per notional size).
+ * The spread reads either the symbol's own book or, with "All venues" checked, the cross-venue
+ * ConsolidatedBook; the impact ladder always sweeps the symbol's own book.
  * Future: Expandable to full order book with configurable tick aggregation
  * 
  * Design considerations:
@@ -40,18 +45,30 @@ private slots:
      * @param symbol Trading symbol
      * @param deltas Dense order book deltas (used as a trigger for refresh)
      * 
-     * Connected via Qt::QueuedConnection for thread safety
+     * Connected via Qt::QueuedConnection for thread safety. Only marks the book dirty;
+     * the display refreshes at most once per refresh tick.
      */
     void onOrderBookUpdated(const QString& symbol, const std::vector<BookDelta>& deltas);
 
+    /**
+     * @brief Display-rate tick: redraws top of book and publishes the impact ladder when the book changed
+     */
+    void refreshFromBook();
+
 private:
     void connectToMarketData();
     void updateSpreadDisplay(double bidPrice, double bidSize, double askPrice, double askSize);
+    // Top of book from FeedAggregator::consolidated(); false when the symbol has no consolidated book yet
+    bool readConsolidatedTop(const std::string& symbol, double& bidPrice, double& bidSize,
+                             double& askPrice, double& askSize) const;
     void setupSpreadLayout();
+    void setupImpactLayout();
+    void updateImpactDisplay(const ImpactCurve* curve);
     
     // UI Components - Bid/Ask Spread
     QFrame* m_spreadFrame = nullptr;
     QLabel* m_symbolLabel = nullptr;
+    QCheckBox* m_consolidatedCheck = nullptr;  // Venue book vs all venues merged
     
     // Bid side (left/green)
     QLabel* m_bidPriceLabel = nullptr;
@@ -67,6 +84,15 @@ private:
     QLabel* m_spreadLabel = nullptr;      // Price difference
     QLabel* m_midLabel = nullptr;         // Mid price
     
+    // Market impact ladder: one row per notional size
+    struct ImpactRow {
+        QLabel* size = nullptr;
+        QLabel* buy = nullptr;
+        QLabel* sell = nullptr;
+    };
+    QFrame* m_impactFrame = nullptr;
+    std::vector<ImpactRow> m_impactRows;
+    
     // Future expansion placeholders
     // TODO: QTableView* m_orderBookTable = nullptr;  // Full depth
     // TODO: Tick size configuration
@@ -78,6 +104,12 @@ private:
     double m_lastBidSize = 0.0;
     double m_lastAskPrice = 0.0;
     double m_lastAskSize = 0.0;
+    bool m_bookDirty = false;
+    
+    // Book updates arrive far faster than the dock can usefully repaint; both views conflate to this timer
+    QTimer* m_refreshTimer = nullptr;
+    MarketImpactEngine m_impactEngine;
+    ImpactCurve m_impactCurve;
 };
 
 #endif // ORDERBOOKDOCK_HPP
\ No newline at end of file
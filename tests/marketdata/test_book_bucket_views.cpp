@@ -0,0 +1,201 @@
+/*
+Sentinel — LiveOrderBook Bucket View Tests
+Role: Verify the incrementally maintained coarse price-bucket views against a brute-force re-aggregation
+Testing Strategy: Random level churn on a small grid; hand-placed levels around bucket edges; DataCache-wide view registration
+Coverage: Bucket sums and rounding, exact-zero emptying, best-first capture, late-added views, re-initialization, grid mismatch, reference-counted removal
+*/
+#include <gtest/gtest.h>
+#include "marketdata/cache/DataCache.hpp"
+#include <cmath>
+#include <map>
+#include <random>
+
+namespace {
+    // Reference aggregation: round each populated level's price to the bucket grid. Works in whole ticks,
+    // since price / bucketSize in floating point can land either side of a half-bucket edge.
+    std::map<long long, double> aggregate(const LiveOrderBook& book, const std::vector<double>& levels, double bucketSize) {
+        const double ticksPerBucket = std::round(bucketSize / book.getTickSize());
+        std::map<long long, double> buckets;
+        for (size_t i = 0; i < levels.size(); ++i) {
+            if (levels[i] > 0.0) {
+                const double ticks = std::round(book.index_to_price(i) / book.getTickSize());
+                buckets[std::llround(ticks / ticksPerBucket)] += levels[i];
+            }
+        }
+        return buckets;
+    }
+
+    std::map<long long, double> toMap(std::span<const std::pair<double, double>> buckets, double bucketSize) {
+        std::map<long long, double> out;
+        for (const auto& [price, qty] : buckets) out[std::llround(price / bucketSize)] = qty;
+        return out;
+    }
+}
+
+class BookBucketViewTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // 100.00 .. 200.00 at 0.01
+        book.initialize(100.0, 200.0, 0.01);
+        book.addBucketView(0.10);
+        book.addBucketView(1.0);
+        book.addBucketView(10.0);
+    }
+
+    void apply(std::vector<BookLevelUpdate> updates) {
+        book.applyUpdates(updates, std::chrono::system_clock::now(), nullptr);
+    }
+
+    LiveOrderBook book{"TEST-USD"};
+    std::vector<std::pair<double, double>> bidBuf;
+    std::vector<std::pair<double, double>> askBuf;
+};
+
+TEST_F(BookBucketViewTest, BucketsRoundToNearestMultiple) {
+    // 149.49 rounds to 149, 149.50 and 150.49 to 150, 150.50 to 151
+    apply({{true, 149.49, 1.0}, {true, 149.50, 2.0}, {true, 150.49, 4.0}, {true, 150.50, 8.0}});
+
+    LiveOrderBook::BucketSnapshotView view;
+    ASSERT_TRUE(book.captureBuckets(1.0, bidBuf, askBuf, 100, view));
+    ASSERT_EQ(view.bidBuckets.size(), 3u);
+    EXPECT_DOUBLE_EQ(view.bidBuckets[0].first, 151.0);  // Best first
+    EXPECT_DOUBLE_EQ(view.bidBuckets[0].second, 8.0);
+    EXPECT_DOUBLE_EQ(view.bidBuckets[1].first, 150.0);
+    EXPECT_DOUBLE_EQ(view.bidBuckets[1].second, 6.0);
+    EXPECT_DOUBLE_EQ(view.bidBuckets[2].first, 149.0);
+    EXPECT_DOUBLE_EQ(view.bidBuckets[2].second, 1.0);
+    EXPECT_TRUE(view.askBuckets.empty());
+    EXPECT_DOUBLE_EQ(view.bestBidQuantity, 8.0);
+    EXPECT_DOUBLE_EQ(view.bestAskQuantity, 0.0);
+    EXPECT_DOUBLE_EQ(view.bucketSize, 1.0);
+}
+
+TEST_F(BookBucketViewTest, RandomChurnMatchesReaggregation) {
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> tick(0, 4999);
+    std::uniform_real_distribution<double> size(0.0, 2.0);
+    for (int round = 0; round < 20; ++round) {
+        std::vector<BookLevelUpdate> updates;
+        for (int i = 0; i < 500; ++i) {
+            const int t = tick(rng);
+            updates.push_back({true, 149.99 - 0.01 * t, i % 3 == 0 ? 0.0 : size(rng)});
+            updates.push_back({false, 150.00 + 0.01 * t, i % 4 == 0 ? 0.0 : size(rng)});
+        }
+        apply(updates);
+    }
+
+    for (double bucketSize : {0.10, 1.0, 10.0}) {
+        LiveOrderBook::BucketSnapshotView view;
+        ASSERT_TRUE(book.captureBuckets(bucketSize, bidBuf, askBuf, 100000, view));
+        const auto expectedBids = aggregate(book, book.getBids(), bucketSize);
+        const auto expectedAsks = aggregate(book, book.getAsks(), bucketSize);
+        const auto bids = toMap(view.bidBuckets, bucketSize);
+        const auto asks = toMap(view.askBuckets, bucketSize);
+        ASSERT_EQ(bids.size(), expectedBids.size()) << bucketSize;
+        ASSERT_EQ(asks.size(), expectedAsks.size()) << bucketSize;
+        for (const auto& [key, qty] : expectedBids) EXPECT_NEAR(bids.at(key), qty, 1e-9) << bucketSize;
+        for (const auto& [key, qty] : expectedAsks) EXPECT_NEAR(asks.at(key), qty, 1e-9) << bucketSize;
+    }
+}
+
+TEST_F(BookBucketViewTest, EmptiedBucketIsExactlyZeroAndSkipped) {
+    apply({{false, 150.01, 0.1}, {false, 150.02, 0.2}, {false, 152.00, 1.0}});
+    apply({{false, 150.01, 0.0}, {false, 150.02, 0.0}});
+
+    LiveOrderBook::BucketSnapshotView view;
+    ASSERT_TRUE(book.captureBuckets(1.0, bidBuf, askBuf, 100, view));
+    ASSERT_EQ(view.askBuckets.size(), 1u);
+    EXPECT_DOUBLE_EQ(view.askBuckets[0].first, 152.0);
+    EXPECT_DOUBLE_EQ(view.askBuckets[0].second, 1.0);
+}
+
+TEST_F(BookBucketViewTest, CaptureStopsAtMaxPerSide) {
+    apply({{false, 150.0, 1.0}, {false, 151.0, 1.0}, {false, 152.0, 1.0}, {false, 153.0, 1.0}});
+    LiveOrderBook::BucketSnapshotView view;
+    ASSERT_TRUE(book.captureBuckets(1.0, bidBuf, askBuf, 2, view));
+    ASSERT_EQ(view.askBuckets.size(), 2u);
+    EXPECT_DOUBLE_EQ(view.askBuckets[0].first, 150.0);
+    EXPECT_DOUBLE_EQ(view.askBuckets[1].first, 151.0);
+}
+
+TEST_F(BookBucketViewTest, LateViewIsBuiltFromCurrentLevels) {
+    apply({{true, 120.00, 1.0}, {true, 130.00, 2.0}, {true, 160.00, 4.0}});
+    EXPECT_FALSE(book.hasBucketView(100.0));
+    ASSERT_TRUE(book.addBucketView(100.0));
+    EXPECT_TRUE(book.hasBucketView(100.0));
+
+    LiveOrderBook::BucketSnapshotView view;
+    ASSERT_TRUE(book.captureBuckets(100.0, bidBuf, askBuf, 10, view));
+    ASSERT_EQ(view.bidBuckets.size(), 2u);
+    EXPECT_DOUBLE_EQ(view.bidBuckets[0].first, 200.0);  // 160 rounds up
+    EXPECT_DOUBLE_EQ(view.bidBuckets[0].second, 4.0);
+    EXPECT_DOUBLE_EQ(view.bidBuckets[1].first, 100.0);
+    EXPECT_DOUBLE_EQ(view.bidBuckets[1].second, 3.0);
+
+    // And it tracks later changes
+    apply({{true, 160.00, 0.0}});
+    ASSERT_TRUE(book.captureBuckets(100.0, bidBuf, askBuf, 10, view));
+    ASSERT_EQ(view.bidBuckets.size(), 1u);
+    EXPECT_DOUBLE_EQ(view.bidBuckets[0].second, 3.0);
+}
+
+TEST_F(BookBucketViewTest, ReinitializeRebuildsOnNewGrid) {
+    apply({{true, 150.00, 1.0}});
+    book.initialize(1000.0, 1100.0, 0.05);
+
+    LiveOrderBook::BucketSnapshotView view;
+    ASSERT_TRUE(book.captureBuckets(1.0, bidBuf, askBuf, 10, view));
+    EXPECT_TRUE(view.bidBuckets.empty());
+    // 0.10 is two ticks of 0.05 and stays usable; 0.01 is not a whole number of ticks
+    EXPECT_TRUE(book.hasBucketView(0.10));
+    book.addBucketView(0.01);
+    EXPECT_FALSE(book.hasBucketView(0.01));
+    EXPECT_FALSE(book.captureBuckets(0.01, bidBuf, askBuf, 10, view));
+
+    apply({{false, 1050.45, 3.0}});
+    ASSERT_TRUE(book.captureBuckets(1.0, bidBuf, askBuf, 10, view));
+    ASSERT_EQ(view.askBuckets.size(), 1u);
+    EXPECT_DOUBLE_EQ(view.askBuckets[0].first, 1050.0);
+}
+
+TEST(DataCacheBucketViewTest, ViewsApplyToExistingAndNewBooks) {
+    DataCache cache;
+    cache.initializeLiveOrderBook("BTC-USD", {{99999.00, 1.5}}, {{100001.00, 2.5}}, std::chrono::system_clock::now());
+    EXPECT_FALSE(cache.getDirectLiveOrderBook("BTC-USD").hasBucketView(1.0));  // Nothing until someone asks
+    EXPECT_FALSE(cache.getDirectLiveOrderBook("BTC-USD").hasBucketView(2.5));
+
+    cache.addBookBucketView(2.5);
+    EXPECT_TRUE(cache.getDirectLiveOrderBook("BTC-USD").hasBucketView(2.5));
+
+    cache.initializeLiveOrderBook("ETH-USD", {{3000.00, 1.0}}, {{3000.50, 1.0}}, std::chrono::system_clock::now());
+    const LiveOrderBook& eth = cache.getDirectLiveOrderBook("ETH-USD");
+    EXPECT_TRUE(eth.hasBucketView(2.5));
+
+    std::vector<std::pair<double, double>> bids;
+    std::vector<std::pair<double, double>> asks;
+    LiveOrderBook::BucketSnapshotView view;
+    ASSERT_TRUE(eth.captureBuckets(2.5, bids, asks, 10, view));
+    ASSERT_EQ(view.bidBuckets.size(), 1u);
+    ASSERT_EQ(view.askBuckets.size(), 1u);
+    EXPECT_DOUBLE_EQ(view.bidBuckets[0].first, 3000.0);
+    EXPECT_DOUBLE_EQ(view.askBuckets[0].first, 3000.0);  // 3000.50 rounds to the same 2.5 bucket
+    EXPECT_DOUBLE_EQ(view.bestAskQuantity, 1.0);
+}
+
+TEST(DataCacheBucketViewTest, LastRemoveDropsTheView) {
+    DataCache cache;
+    cache.initializeLiveOrderBook("BTC-USD", {{99999.00, 1.5}}, {{100001.00, 2.5}}, std::chrono::system_clock::now());
+    cache.addBookBucketView(5.0);
+    cache.addBookBucketView(5.0);
+
+    cache.removeBookBucketView(5.0);
+    EXPECT_TRUE(cache.getDirectLiveOrderBook("BTC-USD").hasBucketView(5.0));  // One holder left
+    cache.removeBookBucketView(5.0);
+    EXPECT_FALSE(cache.getDirectLiveOrderBook("BTC-USD").hasBucketView(5.0));
+
+    cache.initializeLiveOrderBook("ETH-USD", {{3000.00, 1.0}}, {{3000.50, 1.0}}, std::chrono::system_clock::now());
+    EXPECT_FALSE(cache.getDirectLiveOrderBook("ETH-USD").hasBucketView(5.0));
+    cache.removeBookBucketView(5.0);  // Unbalanced remove is a no-op
+    cache.addBookBucketView(5.0);
+    EXPECT_TRUE(cache.getDirectLiveOrderBook("ETH-USD").hasBucketView(5.0));
+}
@@ -0,0 +1,266 @@
+/*
+Sentinel — ConsolidatedBook Tests
+Role: Verify the incremental cross-venue book against hand-built venue deltas and the aggregator's rescan merge
+Testing Strategy: Direct snapshot/delta calls on small grids; synthetic venues through FeedAggregator; concurrent reader/writers
+Coverage: Per-tick sums, venue contributions, cross-venue best bid/ask, snapshot replacement, grid offsets, finer venue ticks
+          snapping to one tick, re-centred venue grids, lock-free reads
+*/
+#include <gtest/gtest.h>
+#include "marketdata/feeds/ConsolidatedBook.hpp"
+#include "marketdata/feeds/FeedAggregator.hpp"
+#include "marketdata/feeds/SyntheticFeedHandler.hpp"
+#include "marketdata/cache/DataCache.hpp"
+#include <atomic>
+#include <thread>
+
+namespace {
+    constexpr size_t kNone = LiveOrderBook::kNoLevel;
+}
+
+// =============================================================================
+// Test Fixture
+// =============================================================================
+
+class ConsolidatedBookTest : public ::testing::Test {
+protected:
+    // 100.00 .. 109.99 at 0.01
+    ConsolidatedBook book{100.0, 0.01, 1000};
+};
+
+// =============================================================================
+// Sums and Contributions
+// =============================================================================
+
+TEST_F(ConsolidatedBookTest, SumsVenuesPerTick) {
+    const std::vector<BookDelta> a{{500, 1.0f, true}, {499, 2.0f, true}, {510, 3.0f, false}};
+    const std::vector<BookDelta> b{{500, 4.0f, true}, {505, 5.0f, false}};
+    book.applySnapshot("A", 100.0, 0.01, a, 500, 510);
+    book.applySnapshot("B", 100.0, 0.01, b, 500, 505);
+
+    EXPECT_EQ(book.venueCount(), 2u);
+    EXPECT_DOUBLE_EQ(book.quantityAt(true, 500), 5.0);
+    EXPECT_DOUBLE_EQ(book.quantityAt(true, 499), 2.0);
+    EXPECT_DOUBLE_EQ(book.quantityAt(false, 505), 5.0);
+    EXPECT_DOUBLE_EQ(book.quantityAt(false, 700), 0.0);  // Untouched page
+
+    const int slotB = book.venueSlot("B");
+    ASSERT_GE(slotB, 0);
+    EXPECT_DOUBLE_EQ(book.venueQuantityAt(slotB, true, 500), 4.0);
+    EXPECT_DOUBLE_EQ(book.venueQuantityAt(slotB, true, 499), 0.0);
+    EXPECT_EQ(book.venueSlot("C"), -1);
+
+    EXPECT_EQ(book.bestBidIndex(), 500u);
+    EXPECT_EQ(book.bestAskIndex(), 505u);
+    EXPECT_NEAR(book.priceAt(book.bestAskIndex()), 105.05, 1e-9);
+}
+
+TEST_F(ConsolidatedBookTest, DeltasUpdateSumsAndBest) {
+    book.applySnapshot("A", 100.0, 0.01, std::vector<BookDelta>{{500, 1.0f, true}, {510, 1.0f, false}}, 500, 510);
+    book.applySnapshot("B", 100.0, 0.01, std::vector<BookDelta>{{502, 2.0f, true}, {508, 2.0f, false}}, 502, 508);
+    EXPECT_EQ(book.bestBidIndex(), 502u);
+    EXPECT_EQ(book.bestAskIndex(), 508u);
+    const uint64_t version = book.version();
+
+    // B's touch is pulled on both sides; the consolidated best falls back to A without a rescan
+    book.applyDeltas("B", std::vector<BookDelta>{{502, 0.0f, true}, {508, 0.0f, false}}, kNone, kNone);
+    EXPECT_EQ(book.bestBidIndex(), 500u);
+    EXPECT_EQ(book.bestAskIndex(), 510u);
+    EXPECT_DOUBLE_EQ(book.quantityAt(true, 502), 0.0);
+    EXPECT_GT(book.version(), version);
+
+    // Joining an existing level adds to it
+    book.applyDeltas("B", std::vector<BookDelta>{{500, 0.5f, true}}, 500, kNone);
+    EXPECT_DOUBLE_EQ(book.quantityAt(true, 500), 1.5);
+}
+
+TEST_F(ConsolidatedBookTest, SnapshotReplacesVenueContribution) {
+    book.applySnapshot("A", 100.0, 0.01, std::vector<BookDelta>{{400, 1.0f, true}, {401, 1.0f, true}}, 401, kNone);
+    book.applySnapshot("B", 100.0, 0.01, std::vector<BookDelta>{{400, 2.0f, true}}, 400, kNone);
+    book.applySnapshot("A", 100.0, 0.01, std::vector<BookDelta>{{300, 7.0f, true}}, 300, kNone);
+
+    EXPECT_DOUBLE_EQ(book.quantityAt(true, 400), 2.0);
+    EXPECT_DOUBLE_EQ(book.quantityAt(true, 401), 0.0);
+    EXPECT_DOUBLE_EQ(book.quantityAt(true, 300), 7.0);
+    EXPECT_EQ(book.bestBidIndex(), 400u);
+    EXPECT_EQ(book.venueCount(), 2u);
+}
+
+TEST_F(ConsolidatedBookTest, MapsVenueGridOffsets) {
+    // Venue grid starts at 101.00 (index 0 → consolidated 100); a 0.05 grid maps through prices
+    book.applySnapshot("Offset", 101.0, 0.01, std::vector<BookDelta>{{5, 1.0f, true}}, 5, kNone);
+    book.applySnapshot("Coarse", 100.0, 0.05, std::vector<BookDelta>{{21, 2.0f, true}}, 21, kNone);
+    EXPECT_DOUBLE_EQ(book.quantityAt(true, 105), 3.0);
+    EXPECT_EQ(book.bestBidIndex(), 105u);
+
+    // Levels outside the consolidated grid are dropped
+    book.applyDeltas("Offset", std::vector<BookDelta>{{5000, 1.0f, false}}, 5000, kNone);
+    EXPECT_EQ(book.bestAskIndex(), kNone);
+}
+
+TEST_F(ConsolidatedBookTest, FinerVenueLevelsSumIntoSnappedTick) {
+    // Venue A quotes at 0.001: 105.000 and 105.004 both snap to consolidated 105.00 (index 500)
+    book.applySnapshot("A", 100.0, 0.001, std::vector<BookDelta>{{5000, 1.0f, true}, {5004, 2.0f, true}}, 5004, kNone);
+    book.applySnapshot("B", 100.0, 0.01, std::vector<BookDelta>{{500, 4.0f, true}}, 500, kNone);
+    const int slotA = book.venueSlot("A");
+    ASSERT_GE(slotA, 0);
+    EXPECT_DOUBLE_EQ(book.venueQuantityAt(slotA, true, 500), 3.0);
+    EXPECT_DOUBLE_EQ(book.quantityAt(true, 500), 7.0);
+
+    // Deleting one sibling leaves the other; resizing the survivor replaces only its own quantity
+    book.applyDeltas("A", std::vector<BookDelta>{{5004, 0.0f, true}}, 5000, kNone);
+    EXPECT_DOUBLE_EQ(book.venueQuantityAt(slotA, true, 500), 1.0);
+    EXPECT_DOUBLE_EQ(book.quantityAt(true, 500), 5.0);
+    book.applyDeltas("A", std::vector<BookDelta>{{5000, 0.25f, true}}, 5000, kNone);
+    EXPECT_DOUBLE_EQ(book.quantityAt(true, 500), 4.25);
+    book.applyDeltas("A", std::vector<BookDelta>{{5000, 0.0f, true}}, kNone, kNone);
+    EXPECT_DOUBLE_EQ(book.venueQuantityAt(slotA, true, 500), 0.0);
+    EXPECT_DOUBLE_EQ(book.quantityAt(true, 500), 4.0);
+}
+
+TEST_F(ConsolidatedBookTest, TopLevelsWalkAcrossPages) {
+    // Bids straddle the 4096-level page size only in a larger book
+    ConsolidatedBook wide{0.0, 1.0, 20000};
+    wide.applySnapshot("A", 0.0, 1.0,
+                       std::vector<BookDelta>{{15000, 1.0f, true}, {9000, 2.0f, true}, {100, 3.0f, true}}, 15000, kNone);
+    std::vector<std::pair<uint32_t, double>> levels;
+    ASSERT_EQ(wide.topLevels(true, 10, levels), 3u);
+    EXPECT_EQ(levels[0].first, 15000u);
+    EXPECT_EQ(levels[1].first, 9000u);
+    EXPECT_EQ(levels[2].first, 100u);
+    EXPECT_EQ(wide.topLevels(false, 10, levels), 0u);
+}
+
+// =============================================================================
+// FeedAggregator Integration
+// =============================================================================
+
+TEST(ConsolidatedAggregatorTest, MatchesRescanMerge) {
+    DataCache cache;
+    cache.setPrimaryBookSymbol("BTC-USD");  // Venue books stay windowed
+    FeedAggregator aggregator{cache};
+    std::vector<SyntheticFeedHandler*> sims;
+    for (uint32_t seed : {1u, 2u, 3u}) {
+        SyntheticFeedHandler::Config config;
+        config.venue = "V" + std::to_string(seed);
+        config.depthLevels = 30;
+        config.seed = seed;
+        auto handler = std::make_unique<SyntheticFeedHandler>(config);
+        sims.push_back(handler.get());
+        aggregator.addHandler(std::move(handler));
+    }
+    aggregator.subscribe({"BTC-USD"});
+    EXPECT_EQ(aggregator.consolidated("BTC-USD"), nullptr);
+
+    for (int i = 0; i < 100; ++i) {
+        for (auto* sim : sims) sim->step();
+    }
+    const ConsolidatedBook* con = aggregator.consolidated("BTC-USD");
+    ASSERT_NE(con, nullptr);
+    EXPECT_EQ(con->venueCount(), 3u);
+
+    std::vector<FeedAggregator::MergedLevel> bids, asks;
+    aggregator.mergeByPrice("BTC-USD", 20, bids, asks);
+    std::vector<std::pair<uint32_t, double>> top;
+    ASSERT_EQ(con->topLevels(true, 20, top), bids.size());
+    for (size_t i = 0; i < top.size(); ++i) {
+        EXPECT_NEAR(con->priceAt(top[i].first), bids[i].price, 1e-6);
+        EXPECT_NEAR(top[i].second, bids[i].quantity, 1e-3);  // Contributions are float
+    }
+    ASSERT_EQ(con->topLevels(false, 20, top), asks.size());
+    EXPECT_NEAR(con->priceAt(con->bestAskIndex()), asks.front().price, 1e-6);
+}
+
+TEST(ConsolidatedAggregatorTest, PrimaryBookJoinsAsVenue) {
+    DataCache cache;
+    FeedAggregator aggregator{cache};
+    cache.initializeLiveOrderBook("BTC-USD", {{99999.00, 1.5}}, {{100001.00, 2.5}},
+                                  std::chrono::system_clock::now());
+    aggregator.onPrimarySnapshot("BTC-USD");
+
+    const ConsolidatedBook* con = aggregator.consolidated("BTC-USD");
+    ASSERT_NE(con, nullptr);
+    EXPECT_NEAR(con->priceAt(con->bestBidIndex()), 99999.00, 1e-6);
+    EXPECT_EQ(con->venueSlot(FeedAggregator::kPrimaryVenue), 0);
+
+    const std::vector<BookLevelUpdate> updates{{true, 100000.00, 0.75}};
+    std::vector<BookDelta> deltas;
+    const BookGrid grid = cache.applyLiveOrderBookUpdates("BTC-USD", updates, std::chrono::system_clock::now(), deltas);
+    aggregator.onPrimaryDeltas("BTC-USD", deltas, grid);
+    EXPECT_NEAR(con->priceAt(con->bestBidIndex()), 100000.00, 1e-6);
+    EXPECT_NEAR(con->quantityAt(true, con->bestBidIndex()), 0.75, 1e-6);
+}
+
+TEST(ConsolidatedAggregatorTest, RecentredVenueBookIsResynced) {
+    DataCache cache;
+    FeedAggregator aggregator{cache};
+    cache.setPrimaryBookSymbol("ETH-USD");  // BTC-USD gets a window that follows its mid
+    cache.initializeLiveOrderBook("BTC-USD", {{99999.00, 1.5}}, {{100001.00, 2.5}},
+                                  std::chrono::system_clock::now());
+    aggregator.onPrimarySnapshot("BTC-USD");
+    const auto& book = cache.getDirectLiveOrderBook("BTC-USD");
+    const double initialMin = book.getMinPrice();
+
+    std::vector<BookDelta> deltas;
+    const std::vector<BookLevelUpdate> move{{true, 99999.00, 0.0}, {false, 100001.00, 0.0},
+                                            {true, 101200.00, 1.0}, {false, 101201.00, 1.0}};
+    BookGrid grid = cache.applyLiveOrderBookUpdates("BTC-USD", move, std::chrono::system_clock::now(), deltas);
+    aggregator.onPrimaryDeltas("BTC-USD", deltas, grid);
+    const std::vector<BookLevelUpdate> next{{true, 101200.50, 0.5}};
+    grid = cache.applyLiveOrderBookUpdates("BTC-USD", next, std::chrono::system_clock::now(), deltas);
+    ASSERT_NE(book.getMinPrice(), initialMin);
+    aggregator.onPrimaryDeltas("BTC-USD", deltas, grid);
+
+    const ConsolidatedBook* con = aggregator.consolidated("BTC-USD");
+    ASSERT_NE(con, nullptr);
+    EXPECT_NEAR(con->priceAt(con->bestBidIndex()), 101200.50, 1e-6);
+    EXPECT_NEAR(con->quantityAt(true, con->bestBidIndex()), 0.5, 1e-6);
+    EXPECT_NEAR(con->priceAt(con->bestAskIndex()), 101201.00, 1e-6);
+    EXPECT_NEAR(con->quantityAt(true, con->indexOf(101200.00)), 1.0, 1e-6);
+}
+
+// =============================================================================
+// Concurrency
+// =============================================================================
+
+TEST(ConsolidatedAggregatorTest, ReadersRunWhileVenuesWrite) {
+    DataCache cache;
+    cache.setPrimaryBookSymbol("BTC-USD");
+    FeedAggregator aggregator{cache};
+    for (const char* venue : {"A", "B"}) {
+        SyntheticFeedHandler::Config config;
+        config.venue = venue;
+        config.depthLevels = 50;
+        config.interval = std::chrono::milliseconds(1);
+        aggregator.addHandler(std::make_unique<SyntheticFeedHandler>(config));
+    }
+    aggregator.subscribe({"BTC-USD"});
+    aggregator.start();
+
+    const ConsolidatedBook* con = nullptr;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!(con = aggregator.consolidated("BTC-USD")) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_NE(con, nullptr);
+
+    std::atomic<bool> negative{false};
+    std::vector<std::pair<uint32_t, double>> levels;
+    uint64_t lastVersion = 0;
+    int versionsSeen = 0;
+    while (versionsSeen < 50 && std::chrono::steady_clock::now() < deadline) {
+        const uint64_t version = con->version();
+        if (version != lastVersion) {
+            lastVersion = version;
+            ++versionsSeen;
+            con->topLevels(true, 25, levels);
+            for (const auto& [idx, qty] : levels) {
+                if (qty < 0.0) negative = true;
+            }
+        }
+    }
+    aggregator.stop();
+
+    EXPECT_GE(versionsSeen, 50);
+    EXPECT_FALSE(negative.load());
+    EXPECT_EQ(con->venueCount(), 2u);
+}
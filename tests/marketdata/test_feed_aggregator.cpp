@@ -0,0 +1,372 @@
+/*
+Sentinel — FeedAggregator / SyntheticFeedHandler Tests
+Role: Verify per-venue book maintenance and the cross-venue price merge, fully offline
+Testing Strategy: Synthetic/replay venues → FeedAggregator → DataCache books + sinks → verify levels and merge
+Coverage: Venue keys, snapshot-then-update flow, trade tagging, merge sums across venues, replay grouping, threaded run,
+          book grid sizing (full depth vs windowed), window re-centring, widening a newly charted book,
+          delta batches stamped with their grid across a regrid, concurrent readers of a re-centring book
+*/
+#include <gtest/gtest.h>
+#include "marketdata/feeds/FeedAggregator.hpp"
+#include "marketdata/feeds/SyntheticFeedHandler.hpp"
+#include "marketdata/cache/DataCache.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+// =============================================================================
+// Test Fixture
+// =============================================================================
+
+class FeedAggregatorTest : public ::testing::Test {
+protected:
+    DataCache cache;
+    FeedAggregator aggregator{cache};
+
+    std::vector<std::string> deltaVenues;
+    std::vector<Trade> trades;
+
+    void SetUp() override {
+        // Venue books get the narrow window a non-charted book would, not full depth
+        cache.setPrimaryBookSymbol("BTC-USD");
+        aggregator.setSinks(
+            [this](const std::string& venue, const std::string&, const std::vector<BookDelta>&, const BookGrid&) {
+                deltaVenues.push_back(venue);
+            },
+            [this](const std::string&, const Trade& trade) { trades.push_back(trade); });
+    }
+
+    static SyntheticFeedHandler::Config simConfig(const std::string& venue, uint32_t seed = 7) {
+        SyntheticFeedHandler::Config c;
+        c.venue = venue;
+        c.startPrice = 100000.0;
+        c.tickSize = 0.01;
+        c.depthLevels = 20;
+        c.levelsPerUpdate = 4;
+        c.tradeProbability = 1.0;
+        c.seed = seed;
+        return c;
+    }
+
+    // Registers a handler and keeps a raw pointer so tests can drive step() synchronously
+    SyntheticFeedHandler* addSim(const std::string& venue, uint32_t seed = 7) {
+        auto handler = std::make_unique<SyntheticFeedHandler>(simConfig(venue, seed));
+        SyntheticFeedHandler* raw = handler.get();
+        aggregator.addHandler(std::move(handler));
+        return raw;
+    }
+};
+
+// =============================================================================
+// Venue Keys
+// =============================================================================
+
+TEST(FeedKeyTest, VenueKeyRoundTrip) {
+    EXPECT_EQ(feed::venueKey("BTC-USD", "SIM"), "BTC-USD@SIM");
+    EXPECT_EQ(feed::symbolOf("BTC-USD@SIM"), "BTC-USD");
+    EXPECT_EQ(feed::symbolOf("BTC-USD"), "BTC-USD");
+}
+
+// =============================================================================
+// Per-Venue Books
+// =============================================================================
+
+TEST_F(FeedAggregatorTest, SnapshotThenUpdatesBuildVenueBook) {
+    SyntheticFeedHandler* sim = addSim("SIM");
+    aggregator.subscribe({"BTC-USD"});
+
+    sim->step();  // Snapshot
+    const auto& book = cache.getDirectLiveOrderBook("BTC-USD@SIM");
+    EXPECT_EQ(book.getBidCount(), 20u);
+    EXPECT_EQ(book.getAskCount(), 20u);
+    EXPECT_TRUE(deltaVenues.empty());  // Snapshots publish no deltas
+    EXPECT_TRUE(cache.getDirectLiveOrderBook("BTC-USD").isEmpty());  // Primary book untouched
+
+    for (int i = 0; i < 10; ++i) sim->step();
+    ASSERT_EQ(deltaVenues.size(), 10u);
+    EXPECT_EQ(deltaVenues.front(), "SIM");
+    ASSERT_EQ(trades.size(), 10u);  // tradeProbability = 1
+    EXPECT_EQ(trades.front().product_id, "BTC-USD");
+    EXPECT_NE(trades.front().side, AggressorSide::Unknown);
+}
+
+TEST_F(FeedAggregatorTest, BestPricesStayUncrossed) {
+    SyntheticFeedHandler* sim = addSim("SIM");
+    aggregator.subscribe({"BTC-USD"});
+
+    std::vector<FeedAggregator::MergedLevel> bids, asks;
+    for (int i = 0; i < 200; ++i) {
+        sim->step();
+        aggregator.mergeByPrice("BTC-USD", 1, bids, asks);
+        if (!bids.empty() && !asks.empty()) {
+            ASSERT_LT(bids.front().price, asks.front().price) << "step " << i;
+        }
+    }
+}
+
+// =============================================================================
+// Cross-Venue Merge
+// =============================================================================
+
+TEST_F(FeedAggregatorTest, MergeSumsIdenticalVenues) {
+    // Same seed → identical books, so every merged level is exactly twice one venue's level
+    SyntheticFeedHandler* a = addSim("A", 11);
+    SyntheticFeedHandler* b = addSim("B", 11);
+    aggregator.subscribe({"BTC-USD"});
+    for (int i = 0; i < 5; ++i) {
+        a->step();
+        b->step();
+    }
+
+    std::vector<FeedAggregator::MergedLevel> bids, asks;
+    aggregator.mergeByPrice("BTC-USD", 10, bids, asks);
+    ASSERT_EQ(bids.size(), 10u);
+    ASSERT_EQ(asks.size(), 10u);
+
+    std::vector<std::pair<uint32_t, double>> bidBuf, askBuf;
+    const auto single = cache.getDirectLiveOrderBook("BTC-USD@A").captureDenseNonZero(bidBuf, askBuf, 10);
+    for (size_t i = 0; i < bids.size(); ++i) {
+        EXPECT_EQ(bids[i].venueCount, 2u);
+        EXPECT_NEAR(bids[i].price, single.minPrice + single.bidLevels[i].first * single.tickSize, 1e-6);
+        EXPECT_NEAR(bids[i].quantity, 2.0 * single.bidLevels[i].second, 1e-9);
+    }
+    for (size_t i = 1; i < asks.size(); ++i) {
+        EXPECT_GT(asks[i].price, asks[i - 1].price);
+    }
+}
+
+TEST_F(FeedAggregatorTest, MergeIncludesPrimaryBook) {
+    cache.initializeLiveOrderBook("BTC-USD", {{99999.00, 1.5}}, {{100001.00, 2.5}},
+                                  std::chrono::system_clock::now());
+    SyntheticFeedHandler* sim = addSim("SIM");
+    aggregator.subscribe({"BTC-USD"});
+    sim->step();
+
+    std::vector<FeedAggregator::MergedLevel> bids, asks;
+    aggregator.mergeByPrice("BTC-USD", 1000, bids, asks);
+    auto primaryBid = std::find_if(bids.begin(), bids.end(),
+                                   [](const auto& l) { return std::abs(l.price - 99999.00) < 1e-6; });
+    ASSERT_NE(primaryBid, bids.end());
+    EXPECT_GE(primaryBid->quantity, 1.5);
+}
+
+// =============================================================================
+// Replay
+// =============================================================================
+
+TEST_F(FeedAggregatorTest, ReplayGroupsLinesIntoMessages) {
+    const std::string path = ::testing::TempDir() + "sentinel_replay_test.csv";
+    {
+        std::ofstream out(path);
+        out << "ts_ms,product_id,kind,side,price,quantity\n";
+        out << "1000,ETH-USD,S,bid,3000.00,1.0\n";
+        out << "1000,ETH-USD,S,ask,3000.50,2.0\n";
+        out << "1100,ETH-USD,B,bid,3000.00,0\n";
+        out << "1100,ETH-USD,B,bid,2999.90,4.0\n";
+        out << "1200,ETH-USD,T,buy,3000.50,0.25\n";
+    }
+    auto config = simConfig("REPLAY");
+    config.replayPath = path;
+    auto handler = std::make_unique<SyntheticFeedHandler>(config);
+    SyntheticFeedHandler* replay = handler.get();
+    aggregator.addHandler(std::move(handler));
+
+    ASSERT_EQ(replay->loadReplay(), 5u);
+    EXPECT_TRUE(replay->replayUntil(1000));
+    const auto& book = cache.getDirectLiveOrderBook("ETH-USD@REPLAY");
+    EXPECT_EQ(book.getBidCount(), 1u);
+    EXPECT_EQ(book.getAskCount(), 1u);
+
+    EXPECT_FALSE(replay->replayUntil(2000));
+    ASSERT_EQ(deltaVenues.size(), 1u);  // Both 1100 lines arrive as one update
+    EXPECT_EQ(book.getBidCount(), 1u);
+    ASSERT_EQ(trades.size(), 1u);
+    EXPECT_EQ(trades[0].side, AggressorSide::Buy);
+    EXPECT_DOUBLE_EQ(trades[0].size, 0.25);
+
+    std::vector<FeedAggregator::MergedLevel> bids, asks;
+    aggregator.mergeByPrice("ETH-USD", 5, bids, asks);
+    ASSERT_EQ(bids.size(), 1u);
+    EXPECT_NEAR(bids[0].price, 2999.90, 1e-6);
+    EXPECT_DOUBLE_EQ(bids[0].quantity, 4.0);
+    std::remove(path.c_str());
+}
+
+// =============================================================================
+// Threaded Run
+// =============================================================================
+
+TEST_F(FeedAggregatorTest, VenuesRunOnTheirOwnThreads) {
+    std::atomic<int> deltaBatches{0};
+    aggregator.setSinks(
+        [&](const std::string&, const std::string&, const std::vector<BookDelta>&, const BookGrid&) {
+            ++deltaBatches;
+        },
+        nullptr);
+    for (const char* venue : {"A", "B", "C"}) {
+        auto config = simConfig(venue);
+        config.interval = std::chrono::milliseconds(1);
+        aggregator.addHandler(std::make_unique<SyntheticFeedHandler>(config));
+    }
+    aggregator.subscribe({"BTC-USD", "ETH-USD"});
+    aggregator.start();
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (deltaBatches.load() < 60 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    aggregator.stop();
+
+    EXPECT_GE(deltaBatches.load(), 60);
+    for (const char* venue : {"A", "B", "C"}) {
+        const auto& eth = cache.getDirectLiveOrderBook(feed::venueKey("ETH-USD", venue));
+        EXPECT_FALSE(eth.isEmpty()) << venue;
+        EXPECT_NEAR(0.5 * (eth.getMinPrice() + eth.getMaxPrice()), 3000.0, 10.0) << venue;  // Own start price
+    }
+}
+
+// =============================================================================
+// Book Grids
+// =============================================================================
+
+TEST(BookGridTest, ChartedBookFullDepthOthersWindowed) {
+    DataCache cache;
+    cache.setPrimaryBookSymbol("BTC-USD");
+    const auto now = std::chrono::system_clock::now();
+    cache.initializeLiveOrderBook("BTC-USD", {{99999.99, 1.0}}, {{100000.01, 1.0}}, now);
+    cache.initializeLiveOrderBook("BTC-USD@SIM", {{99999.99, 1.0}}, {{100000.01, 1.0}}, now);
+    cache.initializeLiveOrderBook("DOGE-USD", {{0.150001, 1.0}}, {{0.150003, 1.0}}, now);
+
+    const auto& primary = cache.getDirectLiveOrderBook("BTC-USD");
+    EXPECT_NEAR(primary.getMinPrice(), 75000.0, 0.01);
+    EXPECT_NEAR(primary.getMaxPrice(), 125000.0, 0.01);
+
+    const auto& venue = cache.getDirectLiveOrderBook("BTC-USD@SIM");
+    EXPECT_DOUBLE_EQ(venue.getTickSize(), 0.01);
+    EXPECT_LE(venue.getBids().size(), size_t{1} << 18);
+    EXPECT_LT(venue.getMinPrice(), 99999.99);
+    EXPECT_GT(venue.getMaxPrice(), 100000.01);
+
+    const auto& doge = cache.getDirectLiveOrderBook("DOGE-USD");
+    EXPECT_DOUBLE_EQ(doge.getTickSize(), 1e-6);  // Finer than the heuristic: the snapshot prices need it
+    EXPECT_NEAR(doge.index_to_price(doge.getBestAskIndex()), 0.150003, 1e-9);
+}
+
+TEST(BookGridTest, WindowedBookFollowsTheMid) {
+    DataCache cache;
+    cache.setPrimaryBookSymbol("ETH-USD");
+    cache.initializeLiveOrderBook("BTC-USD", {{99999.00, 1.0}, {99000.00, 3.0}}, {{100001.00, 2.0}},
+                                  std::chrono::system_clock::now());
+    const auto& book = cache.getDirectLiveOrderBook("BTC-USD");
+    const double width = book.getMaxPrice() - book.getMinPrice();
+    const double initialMin = book.getMinPrice();
+
+    // Walk the touch toward the top edge, then one more batch re-centres before it applies
+    std::vector<BookDelta> deltas;
+    const double high = std::round((initialMin + width * 0.9) * 100.0) / 100.0;
+    const std::vector<BookLevelUpdate> move{{true, 99999.00, 0.0}, {false, 100001.00, 0.0},
+                                            {true, high, 1.0}, {false, high + 1.0, 1.0}};
+    cache.applyLiveOrderBookUpdates("BTC-USD", move, std::chrono::system_clock::now(), deltas);
+    EXPECT_DOUBLE_EQ(book.getMinPrice(), initialMin);
+    const std::vector<BookLevelUpdate> next{{true, high - 1.0, 4.0}};
+    cache.applyLiveOrderBookUpdates("BTC-USD", next, std::chrono::system_clock::now(), deltas);
+
+    EXPECT_GT(book.getMinPrice(), initialMin);
+    EXPECT_NEAR(book.getMaxPrice() - book.getMinPrice(), width, 0.011);
+    EXPECT_NEAR(book.index_to_price(book.getBestBidIndex()), high, 1e-6);
+    ASSERT_EQ(deltas.size(), 1u);  // Indexed on the moved grid
+    EXPECT_NEAR(book.index_to_price(deltas[0].idx), high - 1.0, 1e-6);
+    EXPECT_EQ(book.getBidCount(), 2u);  // 99000 fell outside the moved window
+}
+
+TEST(BookGridTest, ChartingABookWidensIt) {
+    DataCache cache;
+    cache.setPrimaryBookSymbol("ETH-USD");
+    cache.initializeLiveOrderBook("BTC-USD", {{99999.00, 1.0}}, {{100001.00, 2.0}},
+                                  std::chrono::system_clock::now());
+    const auto& book = cache.getDirectLiveOrderBook("BTC-USD");
+    EXPECT_LE(book.getBids().size(), size_t{1} << 18);
+
+    cache.setPrimaryBookSymbol("BTC-USD");
+    EXPECT_NEAR(book.getMinPrice(), 75000.0, 0.01);
+    EXPECT_EQ(book.getBidCount(), 1u);
+    EXPECT_NEAR(book.index_to_price(book.getBestAskIndex()), 100001.00, 1e-6);
+}
+
+TEST(BookGridTest, DeltaBatchKeepsItsGridAcrossARegrid) {
+    DataCache cache;
+    cache.setPrimaryBookSymbol("ETH-USD");
+    cache.initializeLiveOrderBook("BTC-USD", {{99999.00, 1.0}}, {{100001.00, 2.0}},
+                                  std::chrono::system_clock::now());
+    std::vector<BookDelta> deltas;
+    const std::vector<BookLevelUpdate> updates{{true, 99998.00, 0.5}};
+    const BookGrid stamp = cache.applyLiveOrderBookUpdates("BTC-USD", updates, std::chrono::system_clock::now(), deltas);
+    ASSERT_EQ(deltas.size(), 1u);
+
+    // Charting the book regrids it before a queued consumer gets to the batch
+    cache.setPrimaryBookSymbol("BTC-USD");
+    const BookGrid current = cache.getDirectLiveOrderBook("BTC-USD").grid();
+    EXPECT_GT(current.epoch, stamp.epoch);
+    EXPECT_NE(current.minPrice, stamp.minPrice);
+    EXPECT_NEAR(stamp.priceAt(deltas[0].idx), 99998.00, 1e-6);
+    EXPECT_NEAR(stamp.priceAt(stamp.bestBidIndex), 99999.00, 1e-6);
+}
+
+// Run under TSan (-fsanitize=thread) to catch unlocked reads of a grid that a re-centre reallocates
+TEST(BookGridTest, ReadersRaceARecentringWindow) {
+    DataCache cache;
+    cache.setPrimaryBookSymbol("ETH-USD");  // BTC-USD gets a window that follows its mid
+    cache.initializeLiveOrderBook("BTC-USD", {{99999.50, 1.0}}, {{100000.50, 1.0}},
+                                  std::chrono::system_clock::now());
+    const auto& book = cache.getDirectLiveOrderBook("BTC-USD");
+    const uint64_t initialEpoch = book.grid().epoch;
+
+    std::atomic<bool> done{false};
+    std::atomic<int> inconsistent{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 2; ++r) {
+        readers.emplace_back([&] {
+            std::vector<std::pair<uint32_t, double>> bidBuf, askBuf;
+            while (!done.load()) {
+                const auto sparse = cache.getLiveOrderBook("BTC-USD");
+                if (sparse && !sparse->bids.empty() && !sparse->asks.empty() &&
+                    sparse->bids.front().price >= sparse->asks.front().price) {
+                    ++inconsistent;
+                }
+                const BookGrid grid = book.grid();
+                if (grid.bestBidIndex != BookGrid::kNoLevel &&
+                    (grid.bestBidIndex >= grid.levels || grid.priceAt(grid.bestBidIndex) > grid.maxPrice + 1e-6)) {
+                    ++inconsistent;
+                }
+                const auto view = book.captureDenseNonZero(bidBuf, askBuf, 4);
+                if (!view.bidLevels.empty() && !view.askLevels.empty() &&
+                    view.bidLevels.front().first >= view.askLevels.front().first) {
+                    ++inconsistent;
+                }
+                (void)book.getLastUpdate();
+                (void)book.getTickSize();
+            }
+        });
+    }
+
+    // Drift the touch upward in $50 steps: the window re-centres every few batches
+    std::vector<BookDelta> deltas;
+    double mid = 100000.0;
+    for (int i = 0; i < 400; ++i) {
+        const double next = mid + 50.0;
+        const std::vector<BookLevelUpdate> step{{true, mid - 0.5, 0.0}, {false, mid + 0.5, 0.0},
+                                                {true, next - 0.5, 1.0}, {false, next + 0.5, 1.0}};
+        cache.applyLiveOrderBookUpdates("BTC-USD", step, std::chrono::system_clock::now(), deltas);
+        mid = next;
+    }
+    done = true;
+    for (auto& reader : readers) reader.join();
+
+    EXPECT_EQ(inconsistent.load(), 0);
+    EXPECT_GT(book.grid().epoch, initialEpoch + 5);  // The window really moved
+    EXPECT_NEAR(book.index_to_price(book.getBestBidIndex()), mid - 0.5, 1e-6);
+}
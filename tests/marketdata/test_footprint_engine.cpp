@@ -0,0 +1,158 @@
+/*
+Sentinel — FootprintEngine Tests
+Role: Verify per-(bar, tick) bid/ask aggregation of the footprint engine
+Testing Strategy: Trades → copyCells → verify rows
+Coverage: Dense window, sparse overflow, row aggregation, POC, bar rollover, per-symbol tick and version
+*/
+#include <gtest/gtest.h>
+#include "FootprintEngine.h"
+#include "marketdata/model/TradeData.h"
+#include <chrono>
+#include <string>
+
+// =============================================================================
+// Test Fixture
+// =============================================================================
+
+class FootprintEngineTest : public ::testing::Test {
+protected:
+    FootprintEngine engine{{1000}, 8};
+
+    void SetUp() override { engine.setTickSize("BTC-USD", 1.0); }
+
+    Trade makeTrade(int64_t ts_ms, double price, double size, AggressorSide side,
+                    const std::string& symbol = "BTC-USD") {
+        Trade trade;
+        trade.product_id = symbol;
+        trade.price = price;
+        trade.size = size;
+        trade.side = side;
+        trade.timestamp = std::chrono::system_clock::time_point(std::chrono::milliseconds(ts_ms));
+        return trade;
+    }
+
+    std::vector<FootprintCell> cells(double priceMin, double priceMax, int ticksPerRow = 1) {
+        std::vector<FootprintCell> out;
+        engine.copyCells("BTC-USD", 1000, 0, 1'000'000, priceMin, priceMax, ticksPerRow, out);
+        return out;
+    }
+};
+
+// =============================================================================
+// Aggregation Tests
+// =============================================================================
+
+TEST_F(FootprintEngineTest, SplitsBidAndAskVolumePerTick) {
+    engine.onTrade(makeTrade(100, 95000.0, 1.0, AggressorSide::Buy));
+    engine.onTrade(makeTrade(200, 95000.0, 0.5, AggressorSide::Sell));
+    engine.onTrade(makeTrade(300, 95001.0, 2.0, AggressorSide::Sell));
+
+    auto result = cells(94990.0, 95010.0);
+    ASSERT_EQ(result.size(), 2u);
+    EXPECT_DOUBLE_EQ(result[0].askVolume, 1.0);
+    EXPECT_DOUBLE_EQ(result[0].bidVolume, 0.5);
+    EXPECT_DOUBLE_EQ(result[1].bidVolume, 2.0);
+    EXPECT_TRUE(result[1].isPoc);
+    EXPECT_FALSE(result[0].isPoc);
+}
+
+TEST_F(FootprintEngineTest, OverflowOutsideDenseWindow) {
+    engine.onTrade(makeTrade(100, 95000.0, 1.0, AggressorSide::Buy));
+    engine.onTrade(makeTrade(200, 95000.0 + FootprintEngine::kDenseWindowTicks, 3.0, AggressorSide::Buy));
+
+    auto result = cells(94000.0, 96000.0);
+    ASSERT_EQ(result.size(), 2u);
+    EXPECT_DOUBLE_EQ(result[1].askVolume, 3.0);
+    EXPECT_NEAR(result[1].priceMin, 95000.0 + FootprintEngine::kDenseWindowTicks - 0.5, 1e-9);
+}
+
+TEST_F(FootprintEngineTest, RowsAggregateTicks) {
+    engine.onTrade(makeTrade(100, 95000.0, 1.0, AggressorSide::Buy));
+    engine.onTrade(makeTrade(200, 95003.0, 1.0, AggressorSide::Buy));
+    engine.onTrade(makeTrade(300, 95012.0, 1.0, AggressorSide::Sell));
+
+    auto result = cells(94990.0, 95020.0, 10);
+    ASSERT_EQ(result.size(), 2u);
+    EXPECT_DOUBLE_EQ(result[0].askVolume, 2.0);
+    EXPECT_DOUBLE_EQ(result[1].bidVolume, 1.0);
+}
+
+TEST_F(FootprintEngineTest, NewBarPerTimeframe) {
+    engine.onTrade(makeTrade(100, 95000.0, 1.0, AggressorSide::Buy));
+    engine.onTrade(makeTrade(1100, 95000.0, 1.0, AggressorSide::Buy));
+
+    auto result = cells(94990.0, 95010.0);
+    ASSERT_EQ(result.size(), 2u);
+    EXPECT_EQ(result[0].timeStart_ms, 0);
+    EXPECT_EQ(result[1].timeStart_ms, 1000);
+    EXPECT_EQ(result[1].timeEnd_ms, 2000);
+}
+
+TEST_F(FootprintEngineTest, PriceFilterExcludesRows) {
+    engine.onTrade(makeTrade(100, 95000.0, 1.0, AggressorSide::Buy));
+    engine.onTrade(makeTrade(200, 96000.0, 1.0, AggressorSide::Buy));
+
+    auto result = cells(94990.0, 95010.0);
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_DOUBLE_EQ(result[0].askVolume, 1.0);
+}
+
+TEST_F(FootprintEngineTest, VersionAdvancesPerTrade) {
+    const uint64_t before = engine.getVersion("BTC-USD");
+    engine.onTrade(makeTrade(100, 95000.0, 1.0, AggressorSide::Buy));
+    EXPECT_GT(engine.getVersion("BTC-USD"), before);
+}
+
+// =============================================================================
+// Per-Symbol Tick and Version Tests
+// =============================================================================
+
+TEST_F(FootprintEngineTest, TradesWaitForTheBookTick) {
+    engine.onTrade(makeTrade(100, 3000.0, 1.0, AggressorSide::Buy, "ETH-USD"));
+    EXPECT_EQ(engine.getVersion("ETH-USD"), 0u);
+
+    engine.setTickSize("ETH-USD", 0.01);
+    engine.onTrade(makeTrade(200, 3000.02, 1.0, AggressorSide::Buy, "ETH-USD"));
+
+    std::vector<FootprintCell> out;
+    engine.copyCells("ETH-USD", 1000, 0, 1'000'000, 2999.0, 3001.0, 1, out);
+    ASSERT_EQ(out.size(), 1u);  // The print before the tick was known is not folded in
+    EXPECT_NEAR(out[0].priceMin, 3000.015, 1e-9);
+    EXPECT_NEAR(out[0].priceMax, 3000.025, 1e-9);
+    EXPECT_DOUBLE_EQ(engine.getTickSize("ETH-USD"), 0.01);
+}
+
+TEST_F(FootprintEngineTest, VersionIsPerSymbol) {
+    engine.setTickSize("ETH-USD", 0.01);
+    engine.onTrade(makeTrade(100, 95000.0, 1.0, AggressorSide::Buy));
+    const uint64_t btc = engine.getVersion("BTC-USD");
+
+    engine.onTrade(makeTrade(200, 3000.0, 1.0, AggressorSide::Sell, "ETH-USD"));
+    EXPECT_EQ(engine.getVersion("BTC-USD"), btc);
+    EXPECT_GT(engine.getVersion("ETH-USD"), btc);
+
+    const uint64_t eth = engine.getVersion("ETH-USD");
+    engine.clear();
+    EXPECT_EQ(engine.getVersion("ETH-USD"), 0u);
+    engine.setTickSize("ETH-USD", 0.01);
+    EXPECT_GT(engine.getVersion("ETH-USD"), eth);  // Never reissued after a clear
+}
+
+TEST_F(FootprintEngineTest, TickChangeRestartsBars) {
+    engine.onTrade(makeTrade(100, 95000.0, 1.0, AggressorSide::Buy));
+    const uint64_t before = engine.getVersion("BTC-USD");
+
+    engine.setTickSize("BTC-USD", 1.0);  // Same tick: nothing changes
+    EXPECT_EQ(engine.getVersion("BTC-USD"), before);
+    EXPECT_EQ(cells(94990.0, 95010.0).size(), 1u);
+
+    engine.setTickSize("BTC-USD", 0.5);
+    EXPECT_GT(engine.getVersion("BTC-USD"), before);
+    EXPECT_TRUE(cells(94990.0, 95010.0).empty());
+
+    engine.onTrade(makeTrade(200, 95000.5, 2.0, AggressorSide::Sell));
+    auto result = cells(94990.0, 95010.0);
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_NEAR(result[0].priceMin, 95000.25, 1e-9);
+    EXPECT_DOUBLE_EQ(result[0].bidVolume, 2.0);
+}
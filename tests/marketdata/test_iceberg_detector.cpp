@@ -0,0 +1,162 @@
+/*
+Sentinel — IcebergDetector Tests
+Role: Verify trade/refill correlation of the iceberg detector
+Testing Strategy: BookDeltas + trades at one tick → onBookDeltas/onTrade → verify events
+Coverage: Refill after consumption, overfill by trades, pulls, late prints, unrelated adds, window, range queries
+*/
+#include <gtest/gtest.h>
+#include "IcebergDetector.h"
+#include "marketdata/model/TradeData.h"
+#include <chrono>
+
+// =============================================================================
+// Test Fixture
+// =============================================================================
+
+class IcebergDetectorTest : public ::testing::Test {
+protected:
+    static constexpr double kMinPrice = 95000.0;
+    static constexpr uint32_t kLevel = 5;  // 95005 on a $1 grid
+
+    IcebergDetector detector;
+
+    void SetUp() override {
+        detector.configureBook("BTC-USD", kMinPrice, 1.0);
+    }
+
+    size_t book(int64_t ts_ms, float qty, bool isBid = true) {
+        return detector.onBookDeltas("BTC-USD", ts_ms, {BookDelta{kLevel, qty, isBid}});
+    }
+
+    size_t trade(int64_t ts_ms, double size, AggressorSide side = AggressorSide::Sell) {
+        Trade t;
+        t.product_id = "BTC-USD";
+        t.price = kMinPrice + kLevel;
+        t.size = size;
+        t.side = side;
+        t.timestamp = std::chrono::system_clock::time_point(std::chrono::milliseconds(ts_ms));
+        return detector.onTrade(t);
+    }
+
+    // Resting size traded away, then shown again
+    size_t consumeAndRefill(int64_t ts_ms, float displayed) {
+        trade(ts_ms, displayed);
+        book(ts_ms + 10, 0.0f);
+        return book(ts_ms + 20, displayed);
+    }
+};
+
+// =============================================================================
+// Detection Tests
+// =============================================================================
+
+TEST_F(IcebergDetectorTest, RepeatedRefillsAfterTradesReportEvent) {
+    book(0, 2.0f);
+    EXPECT_EQ(consumeAndRefill(100, 2.0f), 0u);  // First refill: below minRefills
+    EXPECT_EQ(consumeAndRefill(200, 2.0f), 1u);
+
+    IcebergEvent ev;
+    ASSERT_TRUE(detector.lastEvent("BTC-USD", ev));
+    EXPECT_DOUBLE_EQ(ev.price, kMinPrice + kLevel);
+    EXPECT_TRUE(ev.isBid);
+    EXPECT_EQ(ev.refillCount, 2u);
+    EXPECT_DOUBLE_EQ(ev.hiddenEstimate, 4.0);
+    EXPECT_EQ(ev.firstSeen_ms, 120);
+    EXPECT_EQ(ev.lastRefill_ms, 220);
+}
+
+TEST_F(IcebergDetectorTest, TradesBeyondDisplayedSizeCountAsHidden) {
+    book(0, 1.0f, false);
+    EXPECT_EQ(trade(100, 3.0, AggressorSide::Buy), 0u);  // 2.0 hidden, first refill
+    EXPECT_EQ(trade(200, 2.0, AggressorSide::Buy), 1u);  // 1.0 hidden, second refill
+
+    IcebergEvent ev;
+    ASSERT_TRUE(detector.lastEvent("BTC-USD", ev));
+    EXPECT_FALSE(ev.isBid);
+    EXPECT_DOUBLE_EQ(ev.hiddenEstimate, 3.0);
+}
+
+TEST_F(IcebergDetectorTest, EventUpdatedInPlace) {
+    book(0, 2.0f);
+    consumeAndRefill(100, 2.0f);
+    consumeAndRefill(200, 2.0f);
+    consumeAndRefill(300, 2.0f);
+
+    std::vector<IcebergEvent> events;
+    detector.copyEvents("BTC-USD", 0, 1000, events);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].refillCount, 3u);
+}
+
+TEST_F(IcebergDetectorTest, PulledLevelResetsRefills) {
+    book(0, 2.0f);
+    consumeAndRefill(100, 2.0f);
+    book(5000, 0.0f);  // Cancelled, no trade in window
+    book(5100, 2.0f);
+    EXPECT_EQ(consumeAndRefill(5200, 2.0f), 0u);
+
+    IcebergEvent ev;
+    EXPECT_FALSE(detector.lastEvent("BTC-USD", ev));
+}
+
+TEST_F(IcebergDetectorTest, DeltaBeforeTradeStillCountsAsFill) {
+    book(0, 2.0f);
+    for (int64_t ts : {100, 200}) {
+        book(ts, 0.0f);       // Book update lands before the print
+        trade(ts + 5, 2.0);
+        book(ts + 20, 2.0f);
+    }
+
+    IcebergEvent ev;
+    ASSERT_TRUE(detector.lastEvent("BTC-USD", ev));
+    EXPECT_EQ(ev.refillCount, 2u);
+}
+
+TEST_F(IcebergDetectorTest, EmptiedLevelWithoutPrintExpiresAsPull) {
+    book(0, 2.0f);
+    consumeAndRefill(100, 2.0f);
+    book(1000, 0.0f);
+    trade(1400, 2.0);  // Outside the fill window: the level was already pulled
+    EXPECT_EQ(book(1420, 2.0f), 0u);  // Counting starts over
+
+    IcebergEvent ev;
+    EXPECT_FALSE(detector.lastEvent("BTC-USD", ev));
+}
+
+TEST_F(IcebergDetectorTest, AddsWithoutTradesAreIgnored) {
+    book(0, 1.0f);
+    book(100, 3.0f);
+    book(200, 5.0f);
+    book(300, 1.0f);
+    EXPECT_EQ(book(400, 4.0f), 0u);
+    EXPECT_EQ(book(500, 6.0f), 0u);
+
+    IcebergEvent ev;
+    EXPECT_FALSE(detector.lastEvent("BTC-USD", ev));
+}
+
+TEST_F(IcebergDetectorTest, RefillOutsideCorrelationWindowIgnored) {
+    book(0, 2.0f);
+    for (int64_t t : {1000, 10000}) {
+        trade(t, 2.0);
+        book(t + 10, 0.0f);
+        EXPECT_EQ(book(t + 5000, 2.0f), 0u);
+    }
+
+    IcebergEvent ev;
+    EXPECT_FALSE(detector.lastEvent("BTC-USD", ev));
+}
+
+TEST_F(IcebergDetectorTest, CopyEventsFiltersByTime) {
+    book(0, 2.0f);
+    consumeAndRefill(100, 2.0f);
+    consumeAndRefill(200, 2.0f);
+
+    std::vector<IcebergEvent> events;
+    detector.copyEvents("BTC-USD", 500, 1000, events);
+    EXPECT_TRUE(events.empty());
+    detector.copyEvents("BTC-USD", 150, 160, events);
+    EXPECT_EQ(events.size(), 1u);
+    detector.copyEvents("ETH-USD", 0, 1000, events);
+    EXPECT_TRUE(events.empty());
+}
@@ -0,0 +1,131 @@
+/*
+Sentinel — LiquidityPullEngine Tests
+Role: Verify add/cancel/fill attribution of resting size near the touch
+Testing Strategy: BookDeltas + trades around a fixed BBO → onBookDeltas/onTrade → verify pulls and stats
+Coverage: Pulls after the fill window, fills in either arrival order, distance gating, lifetime buckets, baselines
+*/
+#include <gtest/gtest.h>
+#include "LiquidityPullEngine.h"
+#include "marketdata/model/TradeData.h"
+#include <chrono>
+
+// =============================================================================
+// Test Fixture
+// =============================================================================
+
+class LiquidityPullEngineTest : public ::testing::Test {
+protected:
+    static constexpr double kMinPrice = 95000.0;
+    static constexpr uint32_t kBestBid = 100;  // 95100 on a $1 grid
+    static constexpr uint32_t kBestAsk = 101;
+
+    LiquidityPullEngine engine{LiquidityPullEngine::Config{10, 250}};
+    std::vector<PullEvent> pulls;
+
+    void SetUp() override {
+        engine.configureBook("BTC-USD", kMinPrice, 1.0);
+    }
+
+    size_t bid(int64_t ts_ms, uint32_t idx, float qty) {
+        return engine.onBookDeltas("BTC-USD", ts_ms, {BookDelta{idx, qty, true}}, kBestBid, kBestAsk, &pulls);
+    }
+
+    size_t tick(int64_t ts_ms) {
+        return engine.onBookDeltas("BTC-USD", ts_ms, {}, kBestBid, kBestAsk, &pulls);
+    }
+
+    void sell(int64_t ts_ms, uint32_t idx, double size) {
+        Trade t;
+        t.product_id = "BTC-USD";
+        t.price = kMinPrice + idx;
+        t.size = size;
+        t.side = AggressorSide::Sell;
+        t.timestamp = std::chrono::system_clock::time_point(std::chrono::milliseconds(ts_ms));
+        engine.onTrade(t);
+    }
+
+    PullStats stats() {
+        PullStats out;
+        EXPECT_TRUE(engine.getStats("BTC-USD", out));
+        return out;
+    }
+};
+
+// =============================================================================
+// Attribution Tests
+// =============================================================================
+
+TEST_F(LiquidityPullEngineTest, CancelBecomesPullAfterFillWindow) {
+    bid(0, kBestBid - 2, 1.0f);      // Baseline
+    bid(1000, kBestBid - 2, 5.0f);   // +4 added
+    EXPECT_EQ(bid(1030, kBestBid - 2, 1.0f), 0u);  // Held for the fill window
+    EXPECT_EQ(tick(1300), 1u);
+
+    ASSERT_EQ(pulls.size(), 1u);
+    EXPECT_DOUBLE_EQ(pulls[0].quantity, 4.0);
+    EXPECT_EQ(pulls[0].timestamp_ms, 1030);
+    EXPECT_EQ(pulls[0].lifetime_ms, 30);
+    EXPECT_EQ(pulls[0].distanceTicks, 2u);
+    EXPECT_TRUE(pulls[0].isBid);
+    EXPECT_DOUBLE_EQ(pulls[0].price, kMinPrice + kBestBid - 2);
+
+    PullStats s = stats();
+    EXPECT_DOUBLE_EQ(s.bid.added[2], 4.0);
+    EXPECT_DOUBLE_EQ(s.bid.cancelled[2], 4.0);
+    EXPECT_DOUBLE_EQ(s.bid.cancelledByLifetime[PullStats::lifetimeBucket(30)], 4.0);
+    EXPECT_DOUBLE_EQ(s.bid.pullRatio(), 1.0);
+}
+
+TEST_F(LiquidityPullEngineTest, TradeAfterDecreaseIsFill) {
+    bid(0, kBestBid, 3.0f);
+    bid(100, kBestBid, 1.0f);
+    sell(150, kBestBid, 2.0);
+    EXPECT_EQ(tick(1000), 0u);
+
+    PullStats s = stats();
+    EXPECT_DOUBLE_EQ(s.bid.filled[0], 2.0);
+    EXPECT_DOUBLE_EQ(s.bid.totalCancelled(), 0.0);
+}
+
+TEST_F(LiquidityPullEngineTest, TradeBeforeDecreaseIsFill) {
+    bid(0, kBestBid, 3.0f);
+    sell(90, kBestBid, 1.5);
+    bid(100, kBestBid, 0.5f);  // 1.5 filled, 1.0 pulled
+    EXPECT_EQ(tick(1000), 1u);
+
+    PullStats s = stats();
+    EXPECT_DOUBLE_EQ(s.bid.filled[0], 1.5);
+    EXPECT_DOUBLE_EQ(s.bid.cancelled[0], 1.0);
+    EXPECT_DOUBLE_EQ(s.bid.pullRatio(), 1.0 / 2.5);
+}
+
+TEST_F(LiquidityPullEngineTest, LateTradeOutsideWindowDoesNotReclassify) {
+    bid(0, kBestBid, 3.0f);
+    bid(100, kBestBid, 0.0f);
+    sell(600, kBestBid, 3.0);
+    tick(700);
+
+    PullStats s = stats();
+    EXPECT_DOUBLE_EQ(s.bid.cancelled[0], 3.0);
+    EXPECT_DOUBLE_EQ(s.bid.totalFilled(), 0.0);
+}
+
+TEST_F(LiquidityPullEngineTest, LevelsBeyondNearTouchAreNotAttributed) {
+    bid(0, kBestBid - 50, 3.0f);
+    bid(100, kBestBid - 50, 0.0f);
+    EXPECT_EQ(tick(1000), 0u);
+    EXPECT_TRUE(pulls.empty());
+}
+
+TEST_F(LiquidityPullEngineTest, FirstDeltaOnlyEstablishesBaseline) {
+    bid(0, kBestBid, 3.0f);
+    PullStats s = stats();
+    EXPECT_DOUBLE_EQ(s.bid.added[0], 0.0);
+}
+
+TEST_F(LiquidityPullEngineTest, LifetimeBuckets) {
+    EXPECT_EQ(PullStats::lifetimeBucket(0), 0u);
+    EXPECT_EQ(PullStats::lifetimeBucket(10), 1u);
+    EXPECT_EQ(PullStats::lifetimeBucket(999), 5u);
+    EXPECT_EQ(PullStats::lifetimeBucket(60000), PullStats::kLifetimeBuckets - 1);
+}
@@ -0,0 +1,301 @@
+/*
+Sentinel — Liquidity Price Resolution Tests
+Role: Verify heatmap slices stored at the base tick re-bucket to any coarser resolution on read
+Testing Strategy: Dense snapshots on a $0.25 grid; buckets compared against a per-tick brute-force sum
+Coverage: Bucket rounding and numbering, history re-bucketing, building vs finalized slices, building-slice change lists,
+          late pulls (batched prefix folds), finer re-basing, timeframe rebuilds
+*/
+#include <gtest/gtest.h>
+#include "LiquidityTimeSeriesEngine.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <random>
+
+namespace {
+    using Clock = std::chrono::system_clock;
+    constexpr int64_t kStart = 1'700'000'000'000;  // Aligned to every default timeframe
+    constexpr int kTotal = static_cast<int>(LiquidityTimeSeriesEngine::LiquidityDisplayMode::Total);
+    constexpr int kPulled = static_cast<int>(LiquidityTimeSeriesEngine::LiquidityDisplayMode::Pulled);
+
+    // Levels as {index, qty} on a grid starting at $100 with $0.25 ticks
+    void addSnapshot(LiquidityTimeSeriesEngine& engine, int64_t ts_ms,
+                     std::vector<std::pair<uint32_t, double>> bids, std::vector<std::pair<uint32_t, double>> asks) {
+        LiveOrderBook::DenseBookSnapshotView view;
+        view.minPrice = 100.0;
+        view.tickSize = 0.25;
+        view.timestamp = Clock::time_point(std::chrono::milliseconds(ts_ms));
+        view.bidLevels = bids;
+        view.askLevels = asks;
+        engine.addDenseSnapshot(view);
+    }
+
+    // Reference: every stored tick rounded to the bucket grid in whole ticks, values added
+    std::map<long long, double> reference(const LiquidityTimeSlice& slice, bool isBid, double resolution, int mode) {
+        const long long ticksPerBucket = std::max(1LL, std::llround(resolution / slice.tickSize));
+        const auto& metrics = isBid ? slice.bidMetrics : slice.askMetrics;
+        std::map<long long, double> buckets;
+        for (size_t i = 0; i < metrics.size(); ++i) {
+            const long long tick = slice.minTick + static_cast<long long>(i);
+            const double value = slice.getDisplayValue(slice.tickToPrice(static_cast<Tick>(tick)), isBid, mode);
+            if (value > 0.0) {
+                const long long bucket = static_cast<long long>(
+                    std::floor((2.0 * tick + ticksPerBucket) / (2.0 * ticksPerBucket)));
+                buckets[bucket] += value;
+            }
+        }
+        return buckets;
+    }
+
+    std::map<long long, double> collected(const std::vector<LiquidityBucket>& buckets, bool isBid) {
+        std::map<long long, double> out;
+        for (const auto& bucket : buckets) {
+            if (bucket.isBid == isBid) out[std::llround(bucket.price / bucket.size)] = bucket.value;
+        }
+        return out;
+    }
+}
+
+TEST(LiquidityResolutionTest, BucketIndexFloorsNegativeTicks) {
+    // Same floor bucketing as collectBuckets on either side of zero, including ratios that are not whole ticks
+    LiquidityTimeSlice slice{};
+    slice.tickSize = 0.25;
+    for (const double resolution : {0.25, 0.6, 1.0, 2.5}) {
+        const long long ticksPerBucket = std::max(1LL, std::llround(resolution / slice.tickSize));
+        for (Tick tick = -9; tick <= 9; ++tick) {
+            const auto expected = static_cast<long long>(std::floor((2.0 * tick + ticksPerBucket) / (2.0 * ticksPerBucket)));
+            EXPECT_EQ(slice.bucketIndex(tick, resolution), expected) << "tick " << tick << " at $" << resolution;
+        }
+    }
+}
+
+TEST(LiquidityResolutionTest, BucketsRoundToNearestMultiple) {
+    LiquidityTimeSeriesEngine engine;
+    // 100.00 and 100.25 -> 100, 100.50 -> 101 (halves round up), 101.75 -> 102
+    addSnapshot(engine, kStart, {{0, 1.0}, {1, 2.0}, {2, 4.0}}, {{7, 8.0}});
+    addSnapshot(engine, kStart + 100, {}, {});
+    const LiquidityTimeSlice* slice = engine.getTimeSlice(100, kStart);
+    ASSERT_NE(slice, nullptr);
+
+    std::vector<LiquidityBucket> buckets;
+    slice->collectBuckets(1.0, 0.0, 1000.0, kTotal, buckets);
+    ASSERT_EQ(buckets.size(), 3u);
+    EXPECT_TRUE(buckets[0].isBid);
+    EXPECT_DOUBLE_EQ(buckets[0].price, 100.0);
+    EXPECT_DOUBLE_EQ(buckets[0].value, 3.0);
+    EXPECT_DOUBLE_EQ(buckets[0].size, 1.0);
+    EXPECT_DOUBLE_EQ(buckets[1].price, 101.0);
+    EXPECT_DOUBLE_EQ(buckets[1].value, 4.0);
+    EXPECT_FALSE(buckets[2].isBid);
+    EXPECT_DOUBLE_EQ(buckets[2].price, 102.0);
+    EXPECT_DOUBLE_EQ(buckets[2].value, 8.0);
+}
+
+TEST(LiquidityResolutionTest, HistoryRebucketsAtAnyResolution) {
+    LiquidityTimeSeriesEngine engine;
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<uint32_t> bidTick(0, 199);
+    std::uniform_int_distribution<uint32_t> askTick(200, 399);
+    std::uniform_real_distribution<double> size(0.1, 5.0);
+    // Four snapshots per 100ms slice
+    for (int s = 0; s < 40; ++s) {
+        std::vector<std::pair<uint32_t, double>> bids;
+        std::vector<std::pair<uint32_t, double>> asks;
+        for (int i = 0; i < 60; ++i) {
+            bids.push_back({bidTick(rng), size(rng)});
+            asks.push_back({askTick(rng), size(rng)});
+        }
+        addSnapshot(engine, kStart + s * 25, bids, asks);
+    }
+
+    const auto slices = engine.getFinalizedSlices(100, kStart, kStart + 1000);
+    ASSERT_GE(slices.size(), 3u);
+    for (const double resolution : {0.25, 1.0, 2.5, 5.0, 25.0}) {
+        engine.setPriceResolution(resolution);
+        for (const auto& slice : slices) {
+            for (int mode = 0; mode <= kPulled; ++mode) {
+                std::vector<LiquidityBucket> buckets;
+                slice->collectBuckets(engine.getPriceResolution(), 0.0, 1000.0, mode, buckets);
+                for (const bool isBid : {true, false}) {
+                    const auto expected = reference(*slice, isBid, resolution, mode);
+                    const auto actual = collected(buckets, isBid);
+                    ASSERT_EQ(actual.size(), expected.size()) << resolution << " mode " << mode;
+                    for (const auto& [key, value] : expected) {
+                        EXPECT_NEAR(actual.at(key), value, 1e-9 * std::max(1.0, value)) << resolution;
+                    }
+                }
+            }
+        }
+    }
+    EXPECT_DOUBLE_EQ(engine.getBaseTickSize(), 0.25);  // No re-basing for coarser resolutions
+}
+
+TEST(LiquidityResolutionTest, WindowLimitsOutputToOverlappingBuckets) {
+    LiquidityTimeSeriesEngine engine;
+    addSnapshot(engine, kStart, {{0, 1.0}, {40, 1.0}, {80, 1.0}}, {});
+    addSnapshot(engine, kStart + 100, {}, {});
+    const LiquidityTimeSlice* slice = engine.getTimeSlice(100, kStart);
+    ASSERT_NE(slice, nullptr);
+
+    // $100, $110, $120 stored; only $110 falls inside the window
+    std::vector<LiquidityBucket> buckets;
+    slice->collectBuckets(5.0, 107.0, 113.0, kTotal, buckets);
+    ASSERT_EQ(buckets.size(), 1u);
+    EXPECT_DOUBLE_EQ(buckets[0].price, 110.0);
+    EXPECT_DOUBLE_EQ(buckets[0].size, 5.0);
+}
+
+TEST(LiquidityResolutionTest, BuildingSliceMatchesFinalized) {
+    LiquidityTimeSeriesEngine engine;
+    for (int s = 0; s < 5; ++s) {
+        addSnapshot(engine, kStart + s * 10, {{10, 1.0 + s}, {13, 2.0}}, {{30, 3.0}});
+    }
+    const LiquidityTimeSlice* building = engine.getCurrentSlice(100);
+    ASSERT_NE(building, nullptr);
+    EXPECT_TRUE(building->bidPrefix.empty());
+    std::vector<LiquidityBucket> live;
+    building->collectBuckets(1.0, 0.0, 1000.0, kTotal, live);
+
+    addSnapshot(engine, kStart + 100, {}, {});
+    const LiquidityTimeSlice* finalized = engine.getTimeSlice(100, kStart);
+    ASSERT_NE(finalized, nullptr);
+    EXPECT_EQ(finalized->bidPrefix.size(), finalized->bidMetrics.size() + 1);
+    std::vector<LiquidityBucket> done;
+    finalized->collectBuckets(1.0, 0.0, 1000.0, kTotal, done);
+
+    ASSERT_EQ(live.size(), done.size());
+    for (size_t i = 0; i < live.size(); ++i) {
+        EXPECT_DOUBLE_EQ(live[i].price, done[i].price);
+        EXPECT_NEAR(live[i].value, done[i].value, 1e-9);
+    }
+}
+
+TEST(LiquidityResolutionTest, BuildingSliceListsChangedLevelsOnce) {
+    LiquidityTimeSeriesEngine engine;
+    std::vector<std::pair<Tick, bool>> changes;
+    addSnapshot(engine, kStart, {{10, 1.0}}, {{30, 3.0}});
+    EXPECT_FALSE(engine.takeCurrentSliceChanges(100, changes));  // New slice: re-read it whole
+    EXPECT_TRUE(changes.empty());
+
+    addSnapshot(engine, kStart + 10, {{10, 2.0}, {11, 1.0}}, {});
+    addSnapshot(engine, kStart + 20, {{10, 2.0}}, {});
+    engine.addPulledLiquidity(kStart + 25, 107.5, false, 1.5);
+    ASSERT_TRUE(engine.takeCurrentSliceChanges(100, changes));
+    std::sort(changes.begin(), changes.end());
+    const std::vector<std::pair<Tick, bool>> expected{{410, true}, {411, true}, {430, false}};
+    EXPECT_EQ(changes, expected);
+
+    ASSERT_TRUE(engine.takeCurrentSliceChanges(100, changes));
+    EXPECT_TRUE(changes.empty());
+
+    // Each changed tick maps to the bucket collectBuckets emits for it
+    const LiquidityTimeSlice* building = engine.getCurrentSlice(100);
+    ASSERT_NE(building, nullptr);
+    std::vector<LiquidityBucket> buckets;
+    building->collectBuckets(1.0, 0.0, 1000.0, kTotal, buckets);
+    for (const Tick tick : {Tick{410}, Tick{411}}) {
+        LiquidityBucket bucket;
+        ASSERT_TRUE(building->bucketAt(tick, true, 1.0, kTotal, bucket));
+        const auto match = std::find_if(buckets.begin(), buckets.end(), [&](const LiquidityBucket& b) {
+            return b.isBid && b.price == bucket.price;
+        });
+        ASSERT_NE(match, buckets.end());
+        EXPECT_DOUBLE_EQ(match->size, bucket.size);
+        EXPECT_DOUBLE_EQ(match->value, bucket.value);
+        EXPECT_EQ(match->index, bucket.index);
+        EXPECT_EQ(building->bucketIndex(tick, 1.0), bucket.index);
+    }
+    LiquidityBucket empty;
+    EXPECT_FALSE(building->bucketAt(500, true, 1.0, kTotal, empty));
+
+    engine.setPriceResolution(0.05);  // Re-bases the building slice: queued ticks no longer apply
+    addSnapshot(engine, kStart + 30, {{10, 1.0}}, {});
+    EXPECT_FALSE(engine.takeCurrentSliceChanges(100, changes));
+}
+
+TEST(LiquidityResolutionTest, PullsOnFinalizedSlicesReachBuckets) {
+    LiquidityTimeSeriesEngine engine;
+    addSnapshot(engine, kStart, {{4, 1.0}, {5, 1.0}}, {});
+    addSnapshot(engine, kStart + 100, {}, {});
+    engine.addPulledLiquidity(kStart + 50, 101.25, true, 2.5);
+
+    const LiquidityTimeSlice* slice = engine.getTimeSlice(100, kStart);
+    ASSERT_NE(slice, nullptr);
+    std::vector<LiquidityBucket> buckets;
+    slice->collectBuckets(1.0, 0.0, 1000.0, kPulled, buckets);
+    ASSERT_EQ(buckets.size(), 1u);
+    EXPECT_DOUBLE_EQ(buckets[0].price, 101.0);
+    EXPECT_DOUBLE_EQ(buckets[0].value, 2.5);
+}
+
+TEST(LiquidityResolutionTest, BatchedLatePullsMatchPerTickSums) {
+    LiquidityTimeSeriesEngine engine;
+    addSnapshot(engine, kStart, {{0, 1.0}, {40, 1.0}}, {{0, 1.0}, {40, 1.0}});
+    addSnapshot(engine, kStart + 100, {}, {});
+
+    // Enough pulls to fold the pending list more than once, with some still pending at the end
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> level(0, 40);
+    for (int i = 0; i < 75; ++i) {
+        engine.addPulledLiquidity(kStart + 50, 100.0 + 0.25 * level(rng), i % 3 != 0, 0.5 + i % 4);
+    }
+
+    const LiquidityTimeSlice* slice = engine.getTimeSlice(100, kStart);
+    ASSERT_NE(slice, nullptr);
+    for (const bool isBid : {true, false}) {
+        for (Tick first = slice->minTick; first <= slice->maxTick; first += 3) {
+            for (Tick last = first; last <= slice->maxTick; last += 7) {
+                double expected = 0.0;
+                for (Tick t = first; t <= last; ++t) {
+                    expected += slice->getDisplayValue(slice->tickToPrice(t), isBid, kPulled);
+                }
+                EXPECT_NEAR(slice->getRangeValue(first, last, isBid, kPulled), expected, 1e-9);
+            }
+        }
+    }
+}
+
+TEST(LiquidityResolutionTest, FinerResolutionRebasesOnlyNewData) {
+    LiquidityTimeSeriesEngine engine;
+    addSnapshot(engine, kStart, {{4, 1.0}}, {});
+    addSnapshot(engine, kStart + 100, {{4, 2.0}}, {});  // Finalizes the first 100ms slice
+
+    engine.setPriceResolution(0.05);
+    EXPECT_DOUBLE_EQ(engine.getBaseTickSize(), 0.05);
+
+    // Finalized history keeps its $0.25 grid and shows at its own tick
+    const LiquidityTimeSlice* old = engine.getTimeSlice(100, kStart);
+    ASSERT_NE(old, nullptr);
+    EXPECT_DOUBLE_EQ(old->tickSize, 0.25);
+    std::vector<LiquidityBucket> buckets;
+    old->collectBuckets(engine.getPriceResolution(), 0.0, 1000.0, kTotal, buckets);
+    ASSERT_EQ(buckets.size(), 1u);
+    EXPECT_DOUBLE_EQ(buckets[0].size, 0.25);
+
+    // The slice in progress moved onto the new grid with its values intact
+    const LiquidityTimeSlice* building = engine.getCurrentSlice(100);
+    ASSERT_NE(building, nullptr);
+    EXPECT_DOUBLE_EQ(building->tickSize, 0.05);
+    EXPECT_DOUBLE_EQ(building->getDisplayValue(101.0, true, kTotal), 2.0);
+
+    addSnapshot(engine, kStart + 150, {{4, 1.0}}, {});
+    EXPECT_DOUBLE_EQ(engine.getCurrentSlice(100)->getDisplayValue(101.0, true, kTotal), 3.0);
+}
+
+TEST(LiquidityResolutionTest, AddedTimeframeRebuildsFromSnapshots) {
+    LiquidityTimeSeriesEngine engine;
+    for (int s = 0; s < 70; ++s) {
+        addSnapshot(engine, kStart + s * 100, {{8, 1.0}}, {{12, 2.0}});
+    }
+    engine.addTimeframe(3000);
+
+    const auto slices = engine.getFinalizedSlices(3000, kStart, kStart + 7000);
+    ASSERT_EQ(slices.size(), 3u);  // kStart sits 2s into a 3s bucket: 10 + 30 + 30 snapshots
+    double bidTotal = 0.0;
+    for (const auto& slice : slices) {
+        EXPECT_EQ(slice->duration_ms, 3000);
+        EXPECT_EQ(slice->bidPrefix.size(), slice->bidMetrics.size() + 1);
+        bidTotal += slice->getRangeValue(slice->minTick, slice->maxTick, true, kTotal);
+    }
+    EXPECT_DOUBLE_EQ(bidTotal, 70.0);
+}
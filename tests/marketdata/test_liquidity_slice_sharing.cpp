@@ -0,0 +1,133 @@
+/*
+Sentinel — Liquidity Slice Sharing Tests
+Role: Verify finalized heatmap slices are published once as shared immutable objects
+Testing Strategy: Dense snapshots through LiquidityTimeSeriesEngine; handles compared by identity and content
+Coverage: Handle identity across queries, copy-on-write for late pulls, in-place pulls when unshared, trimming,
+          revisions for late pulls, pulls on restored history with no building slice, per-timeframe byte budget
+*/
+#include <gtest/gtest.h>
+#include "LiquidityTimeSeriesEngine.h"
+
+namespace {
+    using Clock = std::chrono::system_clock;
+    constexpr int64_t kStart = 1'700'000'000'000;
+    constexpr int kPulled = static_cast<int>(LiquidityTimeSeriesEngine::LiquidityDisplayMode::Pulled);
+
+    void addSnapshot(LiquidityTimeSeriesEngine& engine, int64_t ts_ms, double bidQty) {
+        const std::vector<std::pair<uint32_t, double>> bids{{4, bidQty}};
+        LiveOrderBook::DenseBookSnapshotView view;
+        view.minPrice = 100.0;
+        view.tickSize = 0.25;
+        view.timestamp = Clock::time_point(std::chrono::milliseconds(ts_ms));
+        view.bidLevels = bids;
+        engine.addDenseSnapshot(view);
+    }
+}
+
+TEST(LiquiditySliceSharingTest, QueriesHandOutTheSameObject) {
+    LiquidityTimeSeriesEngine engine;
+    for (int s = 0; s < 5; ++s) addSnapshot(engine, kStart + s * 100, 1.0);
+
+    const auto first = engine.getFinalizedSlices(100, kStart, kStart + 1000);
+    const auto second = engine.getFinalizedSlices(100, kStart, kStart + 1000);
+    ASSERT_EQ(first.size(), 4u);  // The fifth is still building
+    ASSERT_EQ(second.size(), first.size());
+    for (size_t i = 0; i < first.size(); ++i) {
+        EXPECT_EQ(first[i].get(), second[i].get());
+        EXPECT_EQ(first[i].get(), engine.getTimeSlice(100, first[i]->startTime_ms));
+    }
+}
+
+TEST(LiquiditySliceSharingTest, LatePullLeavesHeldSliceUntouched) {
+    LiquidityTimeSeriesEngine engine;
+    addSnapshot(engine, kStart, 1.0);
+    addSnapshot(engine, kStart + 100, 1.0);
+
+    const auto held = engine.getFinalizedSlices(100, kStart, kStart + 50);
+    ASSERT_EQ(held.size(), 1u);
+    engine.addPulledLiquidity(kStart + 50, 101.0, true, 2.0);
+
+    // The consumer's copy is frozen; the engine moved on to a fresh one carrying the pull
+    EXPECT_DOUBLE_EQ(held[0]->getDisplayValue(101.0, true, kPulled), 0.0);
+    const LiquidityTimeSlice* updated = engine.getTimeSlice(100, kStart);
+    ASSERT_NE(updated, nullptr);
+    EXPECT_NE(updated, held[0].get());
+    EXPECT_DOUBLE_EQ(updated->getDisplayValue(101.0, true, kPulled), 2.0);
+    EXPECT_DOUBLE_EQ(updated->getRangeValue(updated->minTick, updated->maxTick, true, kPulled), 2.0);
+}
+
+TEST(LiquiditySliceSharingTest, UnsharedSliceTakesPullInPlace) {
+    LiquidityTimeSeriesEngine engine;
+    addSnapshot(engine, kStart, 1.0);
+    addSnapshot(engine, kStart + 100, 1.0);
+
+    const LiquidityTimeSlice* before = engine.getTimeSlice(100, kStart);
+    engine.addPulledLiquidity(kStart + 50, 101.0, true, 2.0);
+    EXPECT_EQ(engine.getTimeSlice(100, kStart), before);
+    EXPECT_DOUBLE_EQ(before->getDisplayValue(101.0, true, kPulled), 2.0);
+}
+
+TEST(LiquiditySliceSharingTest, HandleOutlivesHistoryTrim) {
+    LiquidityTimeSeriesEngine engine;
+    addSnapshot(engine, kStart, 3.0);
+    addSnapshot(engine, kStart + 100, 1.0);
+    const auto held = engine.getFinalizedSlices(100, kStart, kStart + 50);
+    ASSERT_EQ(held.size(), 1u);
+
+    engine.removeTimeframe(100);
+    EXPECT_TRUE(engine.getFinalizedSlices(100, kStart, kStart + 50).empty());
+    EXPECT_DOUBLE_EQ(held[0]->getDisplayValue(101.0, true, 0), 3.0);
+}
+
+TEST(LiquiditySliceSharingTest, LatePullBumpsRevision) {
+    LiquidityTimeSeriesEngine engine;
+    addSnapshot(engine, kStart, 1.0);
+    addSnapshot(engine, kStart + 100, 1.0);
+    const uint64_t before = engine.getTimeSlice(100, kStart)->revision;
+
+    engine.addPulledLiquidity(kStart + 50, 101.0, true, 2.0);   // Finalized: consumers must re-read it
+    EXPECT_EQ(engine.getTimeSlice(100, kStart)->revision, before + 1);
+    engine.addPulledLiquidity(kStart + 150, 101.0, true, 2.0);  // Still building: tracked as a live change instead
+    EXPECT_EQ(engine.getCurrentSlice(100)->revision, 0u);
+}
+
+TEST(LiquiditySliceSharingTest, PullOnRestoredHistoryWithoutCurrentSlice) {
+    LiquidityTimeSeriesEngine source;
+    addSnapshot(source, kStart, 1.0);
+    addSnapshot(source, kStart + 100, 1.0);
+    const auto finalized = source.getFinalizedSlices(100, kStart, kStart + 50);
+    ASSERT_EQ(finalized.size(), 1u);
+
+    LiquidityTimeSeriesEngine engine;  // Restored history, no snapshot yet
+    ASSERT_TRUE(engine.restoreSlice(100, *finalized[0], false));
+    ASSERT_EQ(engine.getCurrentSlice(100), nullptr);
+    engine.addPulledLiquidity(kStart + 50, 101.0, true, 2.0);
+    const LiquidityTimeSlice* restored = engine.getTimeSlice(100, kStart);
+    ASSERT_NE(restored, nullptr);
+    EXPECT_DOUBLE_EQ(restored->getDisplayValue(101.0, true, kPulled), 2.0);
+}
+
+TEST(LiquiditySliceSharingTest, HistoryTrimmedToByteBudget) {
+    LiquidityTimeSeriesEngine engine;
+    for (int s = 0; s < 11; ++s) addSnapshot(engine, kStart + s * 100, 1.0);
+    const auto all = engine.getFinalizedSlices(100, kStart, kStart + 1100);
+    ASSERT_EQ(all.size(), 10u);
+    const size_t perSlice = all.back()->historyBytes();
+    ASSERT_GT(perSlice, 0u);
+    EXPECT_EQ(engine.getHistoryBytes(100), 10 * perSlice);
+
+    // Oldest slices go first; a held handle survives the trim
+    engine.setMaxHistoryBytes(3 * perSlice);
+    const auto kept = engine.getFinalizedSlices(100, kStart, kStart + 1100);
+    ASSERT_EQ(kept.size(), 3u);
+    EXPECT_EQ(kept.front()->startTime_ms, kStart + 700);
+    EXPECT_EQ(engine.getHistoryBytes(100), 3 * perSlice);
+    EXPECT_DOUBLE_EQ(all.front()->getDisplayValue(101.0, true, 0), 1.0);
+
+    // New slices stay within budget; the newest is kept even when it alone exceeds it
+    addSnapshot(engine, kStart + 1100, 1.0);
+    EXPECT_EQ(engine.getFinalizedSlices(100, kStart, kStart + 1200).size(), 3u);
+    engine.setMaxHistoryBytes(0);
+    EXPECT_EQ(engine.getFinalizedSlices(100, kStart, kStart + 1200).size(), 1u);
+    EXPECT_EQ(engine.getHistoryBytes(100), perSlice);
+}
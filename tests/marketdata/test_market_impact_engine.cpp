@@ -0,0 +1,257 @@
+/*
+Sentinel — MarketImpactEngine Tests
+Role: Verify market-order sweep estimates on LiveOrderBook and the engine's per-symbol conflation
+Testing Strategy: Small hand-built books with known VWAPs; random books checked against a linear level walk
+Coverage: Partial level fills, whole-book sweeps, empty sides, slippage sign, updates after removals, publish pacing,
+          stale (checkpoint-restored) books, touch and fills read together while the book moves, lazily built
+          notional index across updates and regrids
+*/
+#include <gtest/gtest.h>
+#include "MarketImpactEngine.h"
+#include "marketdata/cache/DataCache.hpp"
+#include <atomic>
+#include <random>
+#include <thread>
+
+namespace {
+    std::vector<double> notionals(std::initializer_list<double> values) { return values; }
+
+    // Linear reference: walk levels from the touch outward until the notional is spent
+    MarketFill linearSweep(const std::vector<std::pair<double, double>>& levelsFromTouch, double notional) {
+        MarketFill fill;
+        fill.requestedNotional = notional;
+        double remaining = notional;
+        for (const auto& [price, quantity] : levelsFromTouch) {
+            if (remaining <= 0.0) break;
+            const double take = std::min(remaining, price * quantity);
+            fill.quantity += take / price;
+            fill.filledNotional += take;
+            fill.worstPrice = price;
+            remaining -= take;
+        }
+        if (fill.quantity > 0.0) fill.vwap = fill.filledNotional / fill.quantity;
+        return fill;
+    }
+}
+
+// =============================================================================
+// LiveOrderBook Sweeps
+// =============================================================================
+
+class MarketImpactTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // 90.00 .. 110.00 at 0.01
+        book.initialize(90.0, 110.0, 0.01);
+        apply({{false, 100.00, 10.0}, {false, 100.10, 20.0}, {false, 101.00, 50.0},
+               {true, 99.90, 10.0}, {true, 99.50, 30.0}});
+    }
+
+    void apply(std::vector<BookLevelUpdate> updates) {
+        book.applyUpdates(updates, std::chrono::system_clock::now(), nullptr);
+    }
+
+    LiveOrderBook book{"TEST-USD"};
+};
+
+TEST_F(MarketImpactTest, BuyWithinTouchFillsAtBestAsk) {
+    std::vector<MarketFill> fills;
+    book.estimateMarketFills(true, notionals({500.0}), fills);
+    ASSERT_EQ(fills.size(), 1u);
+    EXPECT_DOUBLE_EQ(fills[0].filledNotional, 500.0);
+    EXPECT_NEAR(fills[0].quantity, 5.0, 1e-9);
+    EXPECT_NEAR(fills[0].vwap, 100.0, 1e-9);
+    EXPECT_NEAR(fills[0].worstPrice, 100.0, 1e-9);
+    EXPECT_NEAR(fills[0].slippageBps, 0.0, 1e-6);
+}
+
+TEST_F(MarketImpactTest, BuyAcrossLevelsAveragesPrices) {
+    // 1000 at 100.00 (10), then 1001 at 100.10 (10)
+    std::vector<MarketFill> fills;
+    book.estimateMarketFills(true, notionals({2001.0}), fills);
+    ASSERT_EQ(fills.size(), 1u);
+    EXPECT_NEAR(fills[0].quantity, 20.0, 1e-9);
+    EXPECT_NEAR(fills[0].vwap, 100.05, 1e-9);
+    EXPECT_NEAR(fills[0].worstPrice, 100.10, 1e-9);
+    EXPECT_NEAR(fills[0].slippageBps, 5.0, 1e-6);
+}
+
+TEST_F(MarketImpactTest, SellWalksBidsDownward) {
+    // 999 at 99.90 (10), then 995 at 99.50 (10)
+    std::vector<MarketFill> fills;
+    book.estimateMarketFills(false, notionals({1994.0}), fills);
+    ASSERT_EQ(fills.size(), 1u);
+    EXPECT_NEAR(fills[0].quantity, 20.0, 1e-9);
+    EXPECT_NEAR(fills[0].vwap, 99.70, 1e-9);
+    EXPECT_NEAR(fills[0].worstPrice, 99.50, 1e-9);
+    EXPECT_GT(fills[0].slippageBps, 0.0);
+    EXPECT_NEAR(fills[0].slippageBps, (99.90 - 99.70) / 99.90 * 10000.0, 1e-6);
+}
+
+TEST_F(MarketImpactTest, OversizedOrderFillsWholeSide) {
+    std::vector<MarketFill> fills;
+    book.estimateMarketFills(false, notionals({1e9}), fills);
+    ASSERT_EQ(fills.size(), 1u);
+    EXPECT_NEAR(fills[0].filledNotional, 999.0 + 2985.0, 1e-6);
+    EXPECT_NEAR(fills[0].quantity, 40.0, 1e-9);
+    EXPECT_NEAR(fills[0].worstPrice, 99.50, 1e-9);
+    EXPECT_DOUBLE_EQ(fills[0].requestedNotional, 1e9);
+}
+
+TEST_F(MarketImpactTest, EmptySideAndZeroNotionalFillNothing) {
+    apply({{true, 99.90, 0.0}, {true, 99.50, 0.0}});
+    std::vector<MarketFill> fills;
+    book.estimateMarketFills(false, notionals({0.0, 1000.0}), fills);
+    ASSERT_EQ(fills.size(), 2u);
+    for (const auto& fill : fills) {
+        EXPECT_DOUBLE_EQ(fill.filledNotional, 0.0);
+        EXPECT_DOUBLE_EQ(fill.quantity, 0.0);
+        EXPECT_DOUBLE_EQ(fill.vwap, 0.0);
+    }
+}
+
+TEST_F(MarketImpactTest, RemovedTouchMovesTheSweep) {
+    apply({{false, 100.00, 0.0}});
+    std::vector<MarketFill> fills;
+    book.estimateMarketFills(true, notionals({1001.0}), fills);
+    ASSERT_EQ(fills.size(), 1u);
+    EXPECT_NEAR(fills[0].vwap, 100.10, 1e-9);
+    EXPECT_NEAR(fills[0].slippageBps, 0.0, 1e-6);
+}
+
+TEST_F(MarketImpactTest, NotionalIndexFollowsUpdatesAndRegrids) {
+    // The first estimate builds the notional index; later updates and grid moves must keep it current
+    std::vector<MarketFill> fills;
+    book.estimateMarketFills(true, notionals({500.0}), fills);
+    apply({{false, 100.00, 0.0}, {false, 100.05, 10.0}});
+    book.estimateMarketFills(true, notionals({1000.5}), fills);
+    ASSERT_EQ(fills.size(), 1u);
+    EXPECT_NEAR(fills[0].vwap, 100.05, 1e-9);
+    EXPECT_NEAR(fills[0].worstPrice, 100.05, 1e-9);
+
+    book.regrid(95.0, 105.0);
+    apply({{true, 99.90, 20.0}});
+    std::vector<MarketFill> sells;
+    book.estimateMarketFills(false, notionals({1998.0}), sells);
+    ASSERT_EQ(sells.size(), 1u);
+    EXPECT_NEAR(sells[0].quantity, 20.0, 1e-9);
+    EXPECT_NEAR(sells[0].vwap, 99.90, 1e-9);
+    book.estimateMarketFills(true, notionals({1000.5}), fills);
+    EXPECT_NEAR(fills[0].vwap, 100.05, 1e-9);
+}
+
+TEST(MarketImpactRandomTest, MatchesLinearWalk) {
+    LiveOrderBook book("RAND-USD");
+    book.initialize(1000.0, 1100.0, 0.01);
+
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> tick(0, 4999);
+    std::uniform_real_distribution<double> size(0.0, 3.0);
+    std::vector<BookLevelUpdate> updates;
+    for (int i = 0; i < 4000; ++i) {
+        const int t = tick(rng);
+        // Zero sizes exercise removals; asks above 1050, bids below
+        updates.push_back({false, 1050.0 + 0.01 * t, i % 7 == 0 ? 0.0 : size(rng)});
+        updates.push_back({true, 1049.99 - 0.01 * t, i % 5 == 0 ? 0.0 : size(rng)});
+    }
+    book.applyUpdates(updates, std::chrono::system_clock::now(), nullptr);
+
+    std::vector<std::pair<double, double>> asks;
+    std::vector<std::pair<double, double>> bids;
+    const auto& askLevels = book.getAsks();
+    const auto& bidLevels = book.getBids();
+    for (size_t i = 0; i < askLevels.size(); ++i) {
+        if (askLevels[i] > 0.0) asks.push_back({book.index_to_price(i), askLevels[i]});
+    }
+    for (size_t i = bidLevels.size(); i-- > 0; ) {
+        if (bidLevels[i] > 0.0) bids.push_back({book.index_to_price(i), bidLevels[i]});
+    }
+
+    const std::vector<double> ladder = {500.0, 25'000.0, 250'000.0, 2'000'000.0, 1e12};
+    std::vector<MarketFill> buys;
+    std::vector<MarketFill> sells;
+    book.estimateMarketFills(true, ladder, buys);
+    book.estimateMarketFills(false, ladder, sells);
+    for (size_t i = 0; i < ladder.size(); ++i) {
+        const MarketFill buy = linearSweep(asks, ladder[i]);
+        const MarketFill sell = linearSweep(bids, ladder[i]);
+        EXPECT_NEAR(buys[i].filledNotional, buy.filledNotional, 1e-6 * buy.filledNotional) << "rung " << i;
+        EXPECT_NEAR(buys[i].vwap, buy.vwap, 1e-6) << "rung " << i;
+        EXPECT_NEAR(buys[i].worstPrice, buy.worstPrice, 1e-9) << "rung " << i;
+        EXPECT_NEAR(sells[i].filledNotional, sell.filledNotional, 1e-6 * sell.filledNotional) << "rung " << i;
+        EXPECT_NEAR(sells[i].vwap, sell.vwap, 1e-6) << "rung " << i;
+        EXPECT_NEAR(sells[i].worstPrice, sell.worstPrice, 1e-9) << "rung " << i;
+    }
+}
+
+// =============================================================================
+// Engine Conflation
+// =============================================================================
+
+TEST_F(MarketImpactTest, EnginePublishesOncePerIntervalWhileDirty) {
+    MarketImpactEngine engine{MarketImpactEngine::Config{{1000.0, 2001.0}, 100}};
+    ImpactCurve curve;
+
+    EXPECT_FALSE(engine.poll("TEST-USD", book, 0, curve));  // Never updated
+
+    engine.onBookUpdated("TEST-USD");
+    ASSERT_TRUE(engine.poll("TEST-USD", book, 1000, curve));
+    EXPECT_EQ(curve.revision, 1u);
+    EXPECT_NEAR(curve.bestBid, 99.90, 1e-9);
+    EXPECT_NEAR(curve.bestAsk, 100.00, 1e-9);
+    ASSERT_EQ(curve.buys.size(), 2u);
+    ASSERT_EQ(curve.sells.size(), 2u);
+    EXPECT_NEAR(curve.buys[1].vwap, 100.05, 1e-9);
+
+    // Clean: nothing to publish
+    EXPECT_FALSE(engine.poll("TEST-USD", book, 1020, curve));
+
+    // A burst of updates inside the interval conflates into one publish after it
+    engine.onBookUpdated("TEST-USD");
+    engine.onBookUpdated("TEST-USD");
+    EXPECT_FALSE(engine.poll("TEST-USD", book, 1050, curve));
+    ASSERT_TRUE(engine.poll("TEST-USD", book, 1100, curve));
+    EXPECT_EQ(curve.revision, 2u);
+    EXPECT_FALSE(engine.poll("TEST-USD", book, 1300, curve));
+
+    // Symbols conflate independently
+    engine.onBookUpdated("OTHER-USD");
+    EXPECT_FALSE(engine.poll("TEST-USD", book, 1400, curve));
+    EXPECT_TRUE(engine.poll("OTHER-USD", book, 1400, curve));
+    EXPECT_EQ(curve.revision, 1u);
+}
+
+TEST_F(MarketImpactTest, EngineWaitsOutStaleBook) {
+    MarketImpactEngine engine{MarketImpactEngine::Config{{1000.0}, 100}};
+    ImpactCurve curve;
+    book.markStale();  // As restored from a checkpoint
+    engine.onBookUpdated("TEST-USD");
+    EXPECT_FALSE(engine.poll("TEST-USD", book, 1000, curve));
+
+    // The live snapshot re-initializes the book; the pending update publishes then
+    book.initialize(90.0, 110.0, 0.01);
+    apply({{false, 100.00, 10.0}, {true, 99.90, 10.0}});
+    EXPECT_FALSE(book.isStale());
+    ASSERT_TRUE(engine.poll("TEST-USD", book, 1000, curve));
+    EXPECT_NEAR(curve.bestAsk, 100.00, 1e-9);
+}
+
+TEST_F(MarketImpactTest, TouchMatchesFillsWhileBookMoves) {
+    // A writer flips the best ask between 100.00 and 100.10; a small buy must always fill at the reported touch
+    MarketImpactEngine engine{MarketImpactEngine::Config{{1.0}, 0}};
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (int i = 0; !done.load(std::memory_order_relaxed); ++i) {
+            apply({{false, 100.00, (i % 2) ? 10.0 : 0.0}});
+        }
+    });
+    ImpactCurve curve;
+    for (int i = 0; i < 5000; ++i) {
+        engine.compute(book, curve);
+        ASSERT_EQ(curve.buys.size(), 1u);
+        ASSERT_NEAR(curve.buys[0].vwap, curve.bestAsk, 1e-9) << "iteration " << i;
+        ASSERT_NEAR(curve.buys[0].slippageBps, 0.0, 1e-6) << "iteration " << i;
+    }
+    done = true;
+    writer.join();
+}
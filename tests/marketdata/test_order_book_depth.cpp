@@ -0,0 +1,217 @@
+/*
+Sentinel — Order Book Depth Tests
+Role: Verify the Fenwick tree, the occupancy bitset and LiveOrderBook's depth and best-level tracking built on them
+Testing Strategy: Compare tree sums against brute-force sums over random updates; drive a small live book through snapshots and deltas
+Coverage: Prefix/range/total sums, prefix search, next/previous populated slot, depth at and between ticks, out-of-grid prices,
+          sampling, best level after the touch empties, re-initialization
+*/
+#include <gtest/gtest.h>
+#include "FenwickTree.h"
+#include "OccupancyBitset.h"
+#include "marketdata/cache/DataCache.hpp"
+#include <numeric>
+#include <random>
+
+// =============================================================================
+// FenwickTree
+// =============================================================================
+
+TEST(FenwickTreeTest, MatchesBruteForceSums) {
+    constexpr size_t kSize = 257;
+    FenwickTree<int64_t> tree(kSize);
+    std::vector<int64_t> values(kSize, 0);
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<size_t> slot(0, kSize - 1);
+    std::uniform_int_distribution<int> delta(-50, 100);
+    for (int i = 0; i < 2000; ++i) {
+        const size_t index = slot(rng);
+        const int64_t d = delta(rng);
+        tree.add(index, d);
+        values[index] += d;
+    }
+
+    for (size_t count = 0; count <= kSize; ++count) {
+        EXPECT_EQ(tree.prefix(count), std::accumulate(values.begin(), values.begin() + count, int64_t{0}));
+    }
+    EXPECT_EQ(tree.range(10, 200), std::accumulate(values.begin() + 10, values.begin() + 200, int64_t{0}));
+    EXPECT_EQ(tree.range(200, 10), 0);
+    EXPECT_EQ(tree.prefix(kSize + 10), tree.total());
+}
+
+TEST(FenwickTreeTest, LowerBoundFindsFirstCountReachingTarget) {
+    FenwickTree<double> tree(10);
+    tree.add(2, 1.0);
+    tree.add(5, 2.0);
+    tree.add(9, 4.0);
+
+    EXPECT_EQ(tree.lowerBound(0.0), 0u);
+    EXPECT_EQ(tree.lowerBound(0.5), 3u);   // Slot 2 reaches it
+    EXPECT_EQ(tree.lowerBound(1.0), 3u);
+    EXPECT_EQ(tree.lowerBound(1.5), 6u);   // Needs slot 5
+    EXPECT_EQ(tree.lowerBound(7.0), 10u);
+    EXPECT_EQ(tree.lowerBound(7.5), 11u);  // Total falls short
+}
+
+TEST(FenwickTreeTest, AssignClears) {
+    FenwickTree<double> tree(4);
+    tree.add(1, 3.0);
+    tree.assign(6);
+    EXPECT_EQ(tree.size(), 6u);
+    EXPECT_DOUBLE_EQ(tree.total(), 0.0);
+    EXPECT_EQ(FenwickTree<double>().size(), 0u);
+}
+
+// =============================================================================
+// OccupancyBitset
+// =============================================================================
+
+TEST(OccupancyBitsetTest, SearchesMatchBruteForce) {
+    constexpr size_t kSize = 70000;  // Spans several summary groups
+    OccupancyBitset bits(kSize);
+    std::vector<bool> reference(kSize, false);
+
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<size_t> slot(0, kSize - 1);
+    for (int i = 0; i < 300; ++i) {
+        const size_t index = slot(rng);
+        bits.set(index);
+        reference[index] = true;
+    }
+    for (int i = 0; i < 150; ++i) {
+        const size_t index = slot(rng);
+        bits.reset(index);
+        reference[index] = false;
+    }
+
+    for (size_t from = 0; from <= kSize; from += 37) {
+        size_t next = OccupancyBitset::npos;
+        for (size_t i = from; i < kSize; ++i) {
+            if (reference[i]) { next = i; break; }
+        }
+        size_t prev = OccupancyBitset::npos;
+        for (size_t i = std::min(from, kSize); i-- > 0; ) {
+            if (reference[i]) { prev = i; break; }
+        }
+        EXPECT_EQ(bits.nextSet(from), next) << from;
+        EXPECT_EQ(bits.prevSet(from), prev) << from;
+    }
+}
+
+TEST(OccupancyBitsetTest, EdgesAndEmpty) {
+    OccupancyBitset bits(130);
+    EXPECT_EQ(bits.nextSet(0), OccupancyBitset::npos);
+    EXPECT_EQ(bits.prevSet(130), OccupancyBitset::npos);
+
+    bits.set(0);
+    bits.set(63);
+    bits.set(129);
+    EXPECT_EQ(bits.nextSet(1), 63u);
+    EXPECT_EQ(bits.nextSet(64), 129u);
+    EXPECT_EQ(bits.prevSet(129), 63u);
+    EXPECT_EQ(bits.prevSet(63), 0u);
+    EXPECT_EQ(bits.prevSet(0), OccupancyBitset::npos);
+    EXPECT_EQ(bits.nextSet(130), OccupancyBitset::npos);
+
+    bits.reset(63);
+    EXPECT_FALSE(bits.test(63));
+    EXPECT_EQ(bits.prevSet(129), 0u);
+}
+
+// =============================================================================
+// LiveOrderBook Cumulative Depth
+// =============================================================================
+
+class OrderBookDepthTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // 100.00 .. 101.00 at 0.01
+        book.initialize(100.0, 101.0, 0.01);
+        apply({{true, 100.40, 1.0}, {true, 100.45, 2.0}, {true, 100.49, 3.0},
+               {false, 100.51, 4.0}, {false, 100.55, 5.0}, {false, 100.90, 6.0}});
+    }
+
+    void apply(std::vector<BookLevelUpdate> updates) {
+        book.applyUpdates(updates, std::chrono::system_clock::now(), nullptr);
+    }
+
+    LiveOrderBook book{"BTC-USD"};
+};
+
+TEST_F(OrderBookDepthTest, BidDepthCountsLevelsAtOrAbovePrice) {
+    EXPECT_DOUBLE_EQ(book.cumulativeBidDepth(100.49), 3.0);
+    EXPECT_DOUBLE_EQ(book.cumulativeBidDepth(100.45), 5.0);
+    EXPECT_DOUBLE_EQ(book.cumulativeBidDepth(100.44), 5.0);
+    EXPECT_DOUBLE_EQ(book.cumulativeBidDepth(100.405), 5.0);  // Between ticks
+    EXPECT_DOUBLE_EQ(book.cumulativeBidDepth(100.40), 6.0);
+    EXPECT_DOUBLE_EQ(book.cumulativeBidDepth(100.50), 0.0);
+    EXPECT_DOUBLE_EQ(book.cumulativeBidDepth(50.0), 6.0);     // Below the grid: whole side
+    EXPECT_DOUBLE_EQ(book.cumulativeBidDepth(200.0), 0.0);
+}
+
+TEST_F(OrderBookDepthTest, AskDepthCountsLevelsAtOrBelowPrice) {
+    EXPECT_DOUBLE_EQ(book.cumulativeAskDepth(100.51), 4.0);
+    EXPECT_DOUBLE_EQ(book.cumulativeAskDepth(100.54), 4.0);
+    EXPECT_DOUBLE_EQ(book.cumulativeAskDepth(100.55), 9.0);
+    EXPECT_DOUBLE_EQ(book.cumulativeAskDepth(100.895), 9.0);  // Between ticks
+    EXPECT_DOUBLE_EQ(book.cumulativeAskDepth(100.90), 15.0);
+    EXPECT_DOUBLE_EQ(book.cumulativeAskDepth(100.50), 0.0);
+    EXPECT_DOUBLE_EQ(book.cumulativeAskDepth(200.0), 15.0);   // Above the grid: whole side
+    EXPECT_DOUBLE_EQ(book.cumulativeAskDepth(50.0), 0.0);
+}
+
+TEST_F(OrderBookDepthTest, UpdatesAndRemovalsMoveDepth) {
+    apply({{true, 100.45, 0.5}, {true, 100.49, 0.0}, {false, 100.55, 0.0}, {false, 100.52, 1.5}});
+
+    EXPECT_DOUBLE_EQ(book.cumulativeBidDepth(100.40), 1.5);
+    EXPECT_DOUBLE_EQ(book.cumulativeBidDepth(100.46), 0.0);
+    EXPECT_DOUBLE_EQ(book.cumulativeAskDepth(100.60), 5.5);
+    EXPECT_DOUBLE_EQ(book.cumulativeAskDepth(101.00), 11.5);
+    EXPECT_DOUBLE_EQ(book.cumulativeBidDepth(0.0), book.getBidVolume());
+    EXPECT_DOUBLE_EQ(book.cumulativeAskDepth(1000.0), book.getAskVolume());
+}
+
+TEST_F(OrderBookDepthTest, SamplesMatchPointQueries) {
+    std::vector<double> bids;
+    std::vector<double> asks;
+    book.sampleCumulativeDepth(100.30, 100.70, 41, bids, asks);
+    ASSERT_EQ(bids.size(), 41u);
+    ASSERT_EQ(asks.size(), 41u);
+
+    for (size_t i = 0; i < bids.size(); ++i) {
+        const double price = 100.30 + 0.01 * static_cast<double>(i);
+        EXPECT_DOUBLE_EQ(bids[i], book.cumulativeBidDepth(price)) << "sample " << i;
+        EXPECT_DOUBLE_EQ(asks[i], book.cumulativeAskDepth(price)) << "sample " << i;
+    }
+    // Bids fall and asks rise toward higher prices
+    EXPECT_DOUBLE_EQ(bids.front(), 6.0);
+    EXPECT_DOUBLE_EQ(bids.back(), 0.0);
+    EXPECT_DOUBLE_EQ(asks.front(), 0.0);
+    EXPECT_DOUBLE_EQ(asks.back(), 9.0);
+
+    book.sampleCumulativeDepth(100.0, 101.0, 0, bids, asks);
+    EXPECT_TRUE(bids.empty());
+    EXPECT_TRUE(asks.empty());
+}
+
+TEST_F(OrderBookDepthTest, EmptiedTouchMovesBestToNextLevel) {
+    apply({{true, 100.49, 0.0}, {false, 100.51, 0.0}});
+    EXPECT_DOUBLE_EQ(book.index_to_price(book.getBestBidIndex()), 100.45);
+    EXPECT_DOUBLE_EQ(book.index_to_price(book.getBestAskIndex()), 100.55);
+
+    apply({{true, 100.45, 0.0}, {true, 100.40, 0.0}, {false, 100.55, 0.0}});
+    EXPECT_EQ(book.getBestBidIndex(), LiveOrderBook::kNoLevel);
+    EXPECT_DOUBLE_EQ(book.index_to_price(book.getBestAskIndex()), 100.90);
+
+    apply({{true, 100.01, 1.0}});  // Refilled far from the old touch
+    EXPECT_DOUBLE_EQ(book.index_to_price(book.getBestBidIndex()), 100.01);
+}
+
+TEST_F(OrderBookDepthTest, ReinitializeDropsDepth) {
+    book.initialize(100.0, 101.0, 0.01);
+    EXPECT_DOUBLE_EQ(book.cumulativeBidDepth(0.0), 0.0);
+    EXPECT_DOUBLE_EQ(book.cumulativeAskDepth(1000.0), 0.0);
+
+    apply({{false, 100.20, 2.0}});
+    EXPECT_DOUBLE_EQ(book.cumulativeAskDepth(100.20), 2.0);
+}
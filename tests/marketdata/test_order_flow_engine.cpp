@@ -0,0 +1,124 @@
+/*
+Sentinel — OrderFlowEngine Tests
+Role: Verify CVD, volume/count imbalance and ring behaviour of the order-flow engine
+Testing Strategy: Trade/top-of-book events → bars → verify aggregates
+Coverage: Bucketing, CVD continuity, book imbalance, ring wraparound, range queries
+*/
+#include <gtest/gtest.h>
+#include "OrderFlowEngine.h"
+#include "marketdata/model/TradeData.h"
+#include <chrono>
+
+// =============================================================================
+// Test Fixture
+// =============================================================================
+
+class OrderFlowEngineTest : public ::testing::Test {
+protected:
+    OrderFlowEngine engine{{1000}, 4};
+
+    Trade makeTrade(const std::string& product_id, int64_t ts_ms, double size, AggressorSide side) {
+        Trade trade;
+        trade.product_id = product_id;
+        trade.price = 95000.0;
+        trade.size = size;
+        trade.side = side;
+        trade.timestamp = std::chrono::system_clock::time_point(std::chrono::milliseconds(ts_ms));
+        return trade;
+    }
+
+    std::vector<OrderFlowBar> bars(const std::string& symbol, int64_t start = 0, int64_t end = 1'000'000) {
+        std::vector<OrderFlowBar> out;
+        engine.copyBars(symbol, 1000, start, end, out);
+        return out;
+    }
+};
+
+// =============================================================================
+// Aggregation Tests
+// =============================================================================
+
+TEST_F(OrderFlowEngineTest, AggregatesBuySellWithinBucket) {
+    engine.onTrade(makeTrade("BTC-USD", 10'100, 2.0, AggressorSide::Buy));
+    engine.onTrade(makeTrade("BTC-USD", 10'500, 0.5, AggressorSide::Sell));
+    engine.onTrade(makeTrade("BTC-USD", 10'900, 1.0, AggressorSide::Buy));
+
+    auto result = bars("BTC-USD");
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_EQ(result[0].startTime_ms, 10'000);
+    EXPECT_DOUBLE_EQ(result[0].buyVolume, 3.0);
+    EXPECT_DOUBLE_EQ(result[0].sellVolume, 0.5);
+    EXPECT_DOUBLE_EQ(result[0].delta(), 2.5);
+    EXPECT_DOUBLE_EQ(result[0].tradeCountImbalance(), 1.0 / 3.0);
+    EXPECT_DOUBLE_EQ(result[0].cvdOpen, 0.0);
+    EXPECT_DOUBLE_EQ(result[0].cvdClose, 2.5);
+}
+
+TEST_F(OrderFlowEngineTest, CvdCarriesAcrossBars) {
+    engine.onTrade(makeTrade("BTC-USD", 1'000, 1.0, AggressorSide::Buy));
+    engine.onTrade(makeTrade("BTC-USD", 2'000, 3.0, AggressorSide::Sell));
+
+    auto result = bars("BTC-USD");
+    ASSERT_EQ(result.size(), 2u);
+    EXPECT_DOUBLE_EQ(result[1].cvdOpen, 1.0);
+    EXPECT_DOUBLE_EQ(result[1].cvdClose, -2.0);
+    EXPECT_DOUBLE_EQ(engine.getCumulativeDelta("BTC-USD"), -2.0);
+}
+
+TEST_F(OrderFlowEngineTest, UnknownAggressorIgnored) {
+    engine.onTrade(makeTrade("BTC-USD", 1'000, 1.0, AggressorSide::Unknown));
+    EXPECT_TRUE(bars("BTC-USD").empty());
+}
+
+TEST_F(OrderFlowEngineTest, TopOfBookImbalance) {
+    engine.onTopOfBook("BTC-USD", 5'000, 3.0, 1.0);
+    engine.onTopOfBook("BTC-USD", 5'500, 1.0, 1.0);
+
+    auto result = bars("BTC-USD");
+    ASSERT_EQ(result.size(), 1u);
+    EXPECT_DOUBLE_EQ(result[0].bookImbalance, 0.0);
+    EXPECT_DOUBLE_EQ(result[0].avgBookImbalance(), 0.25);
+}
+
+TEST_F(OrderFlowEngineTest, SymbolsAreIndependent) {
+    engine.onTrade(makeTrade("BTC-USD", 1'000, 1.0, AggressorSide::Buy));
+    engine.onTrade(makeTrade("ETH-USD", 1'000, 4.0, AggressorSide::Sell));
+
+    EXPECT_DOUBLE_EQ(engine.getCumulativeDelta("BTC-USD"), 1.0);
+    EXPECT_DOUBLE_EQ(engine.getCumulativeDelta("ETH-USD"), -4.0);
+}
+
+// =============================================================================
+// Ring Tests
+// =============================================================================
+
+TEST_F(OrderFlowEngineTest, RingOverwritesOldestBars) {
+    for (int64_t i = 0; i < 6; ++i) {
+        engine.onTrade(makeTrade("BTC-USD", i * 1000, 1.0, AggressorSide::Buy));
+    }
+
+    auto result = bars("BTC-USD");
+    ASSERT_EQ(result.size(), engine.getCapacity());
+    EXPECT_EQ(result.front().startTime_ms, 2'000);
+    EXPECT_EQ(result.back().startTime_ms, 5'000);
+    EXPECT_DOUBLE_EQ(result.back().cvdClose, 6.0);
+}
+
+TEST_F(OrderFlowEngineTest, RangeQueryReturnsOverlappingBars) {
+    for (int64_t i = 0; i < 4; ++i) {
+        engine.onTrade(makeTrade("BTC-USD", i * 1000, 1.0, AggressorSide::Buy));
+    }
+
+    auto result = bars("BTC-USD", 1'500, 2'200);
+    ASSERT_EQ(result.size(), 2u);
+    EXPECT_EQ(result[0].startTime_ms, 1'000);
+    EXPECT_EQ(result[1].startTime_ms, 2'000);
+}
+
+TEST_F(OrderFlowEngineTest, NearestTimeframe) {
+    OrderFlowEngine multi{{100, 1000, 5000}, 8};
+    EXPECT_EQ(multi.nearestTimeframe(50), 100);
+    EXPECT_EQ(multi.nearestTimeframe(800), 1000);
+    EXPECT_EQ(multi.nearestTimeframe(4000), 5000);
+    EXPECT_EQ(multi.nearestTimeframe(60000), 5000);
+}
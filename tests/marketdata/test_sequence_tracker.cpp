@@ -0,0 +1,133 @@
+/*
+Sentinel — SequenceTracker Tests
+Role: Verify l2 gap/reorder detection and the per-product resync state machine
+Testing Strategy: Scripted sequence numbers and snapshot/update events → assert decisions, resync requests and replay sets
+Coverage: Connection gaps, reorders, buffering while resyncing, replay filtering, snapshot timeouts, reset on reconnect
+*/
+#include <gtest/gtest.h>
+#include "marketdata/ws/SequenceTracker.hpp"
+#include <algorithm>
+
+using Decision = SequenceTracker::Decision;
+
+namespace {
+    SequenceTracker::BufferedUpdate updateAt(uint64_t seq, double price) {
+        return SequenceTracker::BufferedUpdate{seq, std::chrono::system_clock::now(), {{true, price, 1.0}}};
+    }
+}
+
+// =============================================================================
+// Test Fixture
+// =============================================================================
+
+class SequenceTrackerTest : public ::testing::Test {
+protected:
+    SequenceTracker tracker;
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    static constexpr std::chrono::milliseconds kTimeout{5000};
+
+    void SetUp() override {
+        tracker.onSnapshot("BTC-USD", 10);
+        tracker.onSnapshot("ETH-USD", 11);
+    }
+};
+
+// =============================================================================
+// Detection
+// =============================================================================
+
+TEST_F(SequenceTrackerTest, ContiguousMessagesApply) {
+    for (uint64_t seq = 12; seq < 20; ++seq) {
+        EXPECT_FALSE(tracker.observeMessage(seq));
+        EXPECT_EQ(tracker.onUpdate(seq % 2 ? "ETH-USD" : "BTC-USD", seq), Decision::Apply);
+    }
+    EXPECT_TRUE(tracker.takeResyncRequests(t0, kTimeout).empty());
+    EXPECT_EQ(tracker.gapCount(), 0u);
+}
+
+TEST_F(SequenceTrackerTest, ConnectionGapResyncsEveryLiveBook) {
+    tracker.onUpdate("SOL-USD", 12);  // Never snapshotted: nothing to resync yet
+    EXPECT_FALSE(tracker.observeMessage(12));
+    EXPECT_TRUE(tracker.observeMessage(15));
+    tracker.markAllLiveForResync();
+
+    auto products = tracker.takeResyncRequests(t0, kTimeout);
+    std::sort(products.begin(), products.end());
+    EXPECT_EQ(products, (std::vector<std::string>{"BTC-USD", "ETH-USD"}));
+    EXPECT_TRUE(tracker.isResyncing("BTC-USD"));
+    EXPECT_FALSE(tracker.isResyncing("SOL-USD"));
+    EXPECT_EQ(tracker.gapCount(), 1u);
+
+    // Requests are taken once
+    EXPECT_TRUE(tracker.takeResyncRequests(t0, kTimeout).empty());
+}
+
+TEST_F(SequenceTrackerTest, ReorderedUpdateResyncsOnlyItsProduct) {
+    EXPECT_EQ(tracker.onUpdate("BTC-USD", 20), Decision::Apply);
+    EXPECT_EQ(tracker.onUpdate("BTC-USD", 18), Decision::Drop);
+    EXPECT_EQ(tracker.reorderCount(), 1u);
+
+    const auto products = tracker.takeResyncRequests(t0, kTimeout);
+    EXPECT_EQ(products, std::vector<std::string>{"BTC-USD"});
+    EXPECT_EQ(tracker.onUpdate("ETH-USD", 21), Decision::Apply);
+}
+
+// =============================================================================
+// Resync
+// =============================================================================
+
+TEST_F(SequenceTrackerTest, BuffersWhileResyncingAndReplaysNewerThanSnapshot) {
+    tracker.onUpdate("BTC-USD", 20);
+    tracker.onUpdate("BTC-USD", 19);
+    tracker.takeResyncRequests(t0, kTimeout);
+
+    for (uint64_t seq : {21u, 25u, 30u, 31u}) {
+        ASSERT_EQ(tracker.onUpdate("BTC-USD", seq), Decision::Buffer);
+        tracker.buffer("BTC-USD", updateAt(seq, 100.0 + seq));
+    }
+    EXPECT_EQ(tracker.pendingCount("BTC-USD"), 4u);
+
+    // Snapshot reflects everything up to 28: only 30 and 31 replay, in arrival order
+    const auto replay = tracker.onSnapshot("BTC-USD", 28);
+    ASSERT_EQ(replay.size(), 2u);
+    EXPECT_EQ(replay[0].seq, 30u);
+    EXPECT_EQ(replay[1].seq, 31u);
+    EXPECT_DOUBLE_EQ(replay[1].levels[0].price, 131.0);
+    EXPECT_FALSE(tracker.isResyncing("BTC-USD"));
+    EXPECT_EQ(tracker.pendingCount("BTC-USD"), 0u);
+
+    // Live again, continuing after the last replayed update
+    EXPECT_EQ(tracker.onUpdate("BTC-USD", 30), Decision::Drop);
+    EXPECT_EQ(tracker.onUpdate("BTC-USD", 32), Decision::Apply);
+}
+
+TEST_F(SequenceTrackerTest, OverdueSnapshotIsRequestedAgain) {
+    tracker.onUpdate("ETH-USD", 20);
+    tracker.onUpdate("ETH-USD", 12);
+    ASSERT_EQ(tracker.takeResyncRequests(t0, kTimeout).size(), 1u);
+    tracker.buffer("ETH-USD", updateAt(21, 3000.0));
+
+    EXPECT_TRUE(tracker.takeResyncRequests(t0 + std::chrono::seconds(1), kTimeout).empty());
+    EXPECT_EQ(tracker.takeResyncRequests(t0 + std::chrono::seconds(6), kTimeout),
+              std::vector<std::string>{"ETH-USD"});
+    EXPECT_EQ(tracker.pendingCount("ETH-USD"), 1u);  // Retries keep the buffer
+}
+
+TEST_F(SequenceTrackerTest, BufferIsBounded) {
+    tracker.onUpdate("BTC-USD", 20);
+    tracker.onUpdate("BTC-USD", 12);
+    tracker.takeResyncRequests(t0, kTimeout);
+    for (uint64_t i = 0; i < SequenceTracker::kMaxBufferedUpdates + 10; ++i) {
+        tracker.buffer("BTC-USD", updateAt(100 + i, 1.0));
+    }
+    EXPECT_EQ(tracker.pendingCount("BTC-USD"), SequenceTracker::kMaxBufferedUpdates);
+}
+
+TEST_F(SequenceTrackerTest, ResetForgetsConnectionAndProducts) {
+    tracker.observeMessage(50);
+    tracker.reset();
+    EXPECT_FALSE(tracker.observeMessage(0));  // New connection restarts numbering
+    EXPECT_EQ(tracker.onUpdate("BTC-USD", 1), Decision::Apply);
+    tracker.markAllLiveForResync();
+    EXPECT_TRUE(tracker.takeResyncRequests(t0, kTimeout).empty());
+}
@@ -0,0 +1,308 @@
+/*
+Sentinel — SessionCheckpoint Tests
+Role: Verify the warm-restart file round-trips books, trades and heatmap slices, and never clobbers live state
+Testing Strategy: Write from a populated DataCache/LiquidityTimeSeriesEngine, restore into fresh instances, compare
+Coverage: Book grid + levels, trade order, finalized/current slices, live-snapshot precedence, truncated/missing files,
+          books off by default, stale marking, oversized slice widths and level counts, corrupt book grids,
+          capture/write split across threads
+*/
+#include <gtest/gtest.h>
+#include "SessionCheckpoint.h"
+#include "LiquidityTimeSeriesEngine.h"
+#include "marketdata/cache/DataCache.hpp"
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <thread>
+
+namespace {
+    using Clock = std::chrono::system_clock;
+
+    int64_t nowMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    Trade makeTrade(const std::string& id, int64_t ts_ms, double price, AggressorSide side) {
+        Trade t;
+        t.timestamp = Clock::time_point(std::chrono::milliseconds(ts_ms));
+        t.product_id = "BTC-USD";
+        t.trade_id = id;
+        t.side = side;
+        t.price = price;
+        t.size = 0.25;
+        return t;
+    }
+}
+
+// =============================================================================
+// Test Fixture
+// =============================================================================
+
+class SessionCheckpointTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path = (std::filesystem::temp_directory_path() /
+                ("sentinel_ckpt_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + "_" +
+                 ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".ckpt")).string();
+        std::filesystem::remove(path);
+    }
+    void TearDown() override { std::filesystem::remove(path); }
+
+    void populateBook(DataCache& cache) {
+        cache.initializeLiveOrderBook("BTC-USD", {{99999.00, 1.5}, {99998.50, 2.0}},
+                                      {{100001.00, 2.5}, {100002.25, 0.5}}, Clock::now());
+    }
+
+    std::string path;
+    SessionCheckpoint::Options options;
+};
+
+// =============================================================================
+// Round Trip
+// =============================================================================
+
+TEST_F(SessionCheckpointTest, RestoresBookOnSameGrid) {
+    DataCache source;
+    populateBook(source);
+    const auto written = SessionCheckpoint::write(path, source, nullptr, options);
+    ASSERT_TRUE(written.ok);
+    EXPECT_EQ(written.books, 1u);
+
+    DataCache restored;
+    options.restoreBooks = true;
+    const auto result = SessionCheckpoint::restore(path, restored, nullptr, options);
+    ASSERT_TRUE(result.ok);
+    EXPECT_EQ(result.books, 1u);
+
+    const LiveOrderBook& a = source.getDirectLiveOrderBook("BTC-USD");
+    const LiveOrderBook& b = restored.getDirectLiveOrderBook("BTC-USD");
+    EXPECT_DOUBLE_EQ(b.getMinPrice(), a.getMinPrice());
+    EXPECT_DOUBLE_EQ(b.getTickSize(), a.getTickSize());
+    EXPECT_EQ(b.getBestBidIndex(), a.getBestBidIndex());
+    EXPECT_EQ(b.getBestAskIndex(), a.getBestAskIndex());
+    EXPECT_EQ(b.getBidCount(), 2u);
+    EXPECT_EQ(b.getAskCount(), 2u);
+    EXPECT_DOUBLE_EQ(b.getBidVolume(), a.getBidVolume());
+    EXPECT_DOUBLE_EQ(b.getAskVolume(), a.getAskVolume());
+    EXPECT_TRUE(b.isStale());
+    EXPECT_FALSE(a.isStale());
+
+    // The first live snapshot replaces the restored levels and clears the mark
+    restored.initializeLiveOrderBook("BTC-USD", {{100100.00, 1.0}}, {{100101.00, 1.0}}, Clock::now());
+    EXPECT_FALSE(b.isStale());
+    EXPECT_EQ(b.getBidCount(), 1u);
+}
+
+TEST_F(SessionCheckpointTest, BooksStayOutByDefault) {
+    DataCache source;
+    populateBook(source);
+    source.addTrade(makeTrade("1", nowMs(), 100000.0, AggressorSide::Buy));
+    ASSERT_TRUE(SessionCheckpoint::write(path, source, nullptr, options).ok);
+
+    DataCache restored;
+    const auto result = SessionCheckpoint::restore(path, restored, nullptr, SessionCheckpoint::Options{});
+    ASSERT_TRUE(result.ok);
+    EXPECT_EQ(result.books, 0u);
+    EXPECT_EQ(result.trades, 1u);
+    EXPECT_TRUE(restored.getDirectLiveOrderBook("BTC-USD").isEmpty());
+}
+
+TEST_F(SessionCheckpointTest, RestoresTradesInTimeOrder) {
+    DataCache source;
+    const int64_t t0 = nowMs();
+    source.addTrade(makeTrade("1", t0, 100000.0, AggressorSide::Buy));
+    source.addTrade(makeTrade("2", t0 + 5, 100001.0, AggressorSide::Sell));
+    source.addTrade(makeTrade("3", t0 + 9, 99999.5, AggressorSide::Unknown));
+    ASSERT_TRUE(SessionCheckpoint::write(path, source, nullptr, options).ok);
+
+    DataCache restored;
+    const auto result = SessionCheckpoint::restore(path, restored, nullptr, options);
+    ASSERT_TRUE(result.ok);
+    EXPECT_EQ(result.trades, 3u);
+
+    auto trades = restored.recentTrades("BTC-USD");
+    ASSERT_EQ(trades.size(), 3u);
+    std::sort(trades.begin(), trades.end(), [](const Trade& a, const Trade& b) { return a.timestamp < b.timestamp; });
+    EXPECT_EQ(trades[0].trade_id, "1");
+    EXPECT_EQ(trades[1].side, AggressorSide::Sell);
+    EXPECT_DOUBLE_EQ(trades[2].price, 99999.5);
+    EXPECT_EQ(trades[2].side, AggressorSide::Unknown);
+}
+
+TEST_F(SessionCheckpointTest, RestoresHeatmapSlices) {
+    DataCache cache;
+    LiquidityTimeSeriesEngine source;
+    const int64_t start = (nowMs() / 1000) * 1000 - 5000;
+    // Dense path: slices follow the snapshot timestamps rather than the wall clock
+    for (int i = 0; i < 30; ++i) {
+        const std::vector<std::pair<uint32_t, double>> bids{{100, 1.0 + i}, {99, 2.0}};
+        const std::vector<std::pair<uint32_t, double>> asks{{101, 3.0}};
+        LiveOrderBook::DenseBookSnapshotView view;
+        view.minPrice = 99900.0;
+        view.tickSize = 1.0;
+        view.timestamp = Clock::time_point(std::chrono::milliseconds(start + i * 100));
+        view.bidLevels = bids;
+        view.askLevels = asks;
+        source.addDenseSnapshot(view);
+    }
+    std::vector<std::pair<int64_t, LiquidityTimeSlice>> original;
+    source.visitSlices(options.maxSlicesPerTimeframe, [&](int64_t tf, const LiquidityTimeSlicePtr& slice, bool) {
+        original.emplace_back(tf, *slice);
+    });
+    ASSERT_FALSE(original.empty());
+
+    ASSERT_TRUE(SessionCheckpoint::write(path, cache, &source, options).ok);
+    LiquidityTimeSeriesEngine restored;
+    const auto result = SessionCheckpoint::restore(path, cache, &restored, options);
+    ASSERT_TRUE(result.ok);
+    EXPECT_EQ(result.slices, original.size());
+
+    // Finalized 100ms slices come back with their display values intact
+    const LiquidityTimeSlice* slice = restored.getTimeSlice(100, start + 1050);
+    ASSERT_NE(slice, nullptr);
+    const LiquidityTimeSlice* expected = source.getTimeSlice(100, start + 1050);
+    ASSERT_NE(expected, nullptr);
+    EXPECT_EQ(slice->startTime_ms, expected->startTime_ms);
+    EXPECT_EQ(slice->minTick, expected->minTick);
+    EXPECT_NEAR(slice->getDisplayValue(100000.0, true, 0), expected->getDisplayValue(100000.0, true, 0), 1e-4);
+    EXPECT_NEAR(slice->getDisplayValue(100001.0, false, 0), expected->getDisplayValue(100001.0, false, 0), 1e-4);
+}
+
+// =============================================================================
+// Reconciliation and Failure Handling
+// =============================================================================
+
+TEST_F(SessionCheckpointTest, LiveBookTakesPrecedence) {
+    DataCache source;
+    populateBook(source);
+    ASSERT_TRUE(SessionCheckpoint::write(path, source, nullptr, options).ok);
+
+    DataCache live;
+    options.restoreBooks = true;
+    live.initializeLiveOrderBook("BTC-USD", {{100500.00, 9.0}}, {{100501.00, 9.0}}, Clock::now());
+    const size_t liveBestBid = live.getDirectLiveOrderBook("BTC-USD").getBestBidIndex();
+    const auto result = SessionCheckpoint::restore(path, live, nullptr, options);
+    ASSERT_TRUE(result.ok);
+    EXPECT_EQ(result.books, 0u);
+    EXPECT_EQ(live.getDirectLiveOrderBook("BTC-USD").getBestBidIndex(), liveBestBid);
+    EXPECT_EQ(live.getDirectLiveOrderBook("BTC-USD").getBidCount(), 1u);
+}
+
+TEST_F(SessionCheckpointTest, SkipsStaleBooks) {
+    DataCache source;
+    populateBook(source);
+    ASSERT_TRUE(SessionCheckpoint::write(path, source, nullptr, options).ok);
+
+    DataCache restored;
+    options.restoreBooks = true;
+    options.maxBookAge_ms = -1;  // Everything is too old
+    const auto result = SessionCheckpoint::restore(path, restored, nullptr, options);
+    ASSERT_TRUE(result.ok);
+    EXPECT_EQ(result.books, 0u);
+    EXPECT_TRUE(restored.getDirectLiveOrderBook("BTC-USD").isEmpty());
+}
+
+TEST_F(SessionCheckpointTest, RejectsTruncatedAndMissingFiles) {
+    DataCache empty;
+    EXPECT_FALSE(SessionCheckpoint::restore(path, empty, nullptr, options).ok);
+
+    DataCache source;
+    populateBook(source);
+    source.addTrade(makeTrade("1", nowMs(), 100000.0, AggressorSide::Buy));
+    ASSERT_TRUE(SessionCheckpoint::write(path, source, nullptr, options).ok);
+
+    const auto size = std::filesystem::file_size(path);
+    std::filesystem::resize_file(path, size - 3);
+    DataCache restored;
+    EXPECT_FALSE(SessionCheckpoint::restore(path, restored, nullptr, options).ok);
+    EXPECT_TRUE(restored.getDirectLiveOrderBook("BTC-USD").isEmpty());  // Nothing applied from a bad file
+    EXPECT_TRUE(restored.recentTrades("BTC-USD").empty());
+
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "not a checkpoint";
+    EXPECT_FALSE(SessionCheckpoint::restore(path, restored, nullptr, options).ok);
+}
+
+TEST_F(SessionCheckpointTest, RejectsOversizedCounts) {
+    // Hand-built file: header + one record whose counts claim far more than the file holds
+    auto writeFile = [this](uint32_t kind, const std::string& payload) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        auto put = [&out](const auto& value) { out.write(reinterpret_cast<const char*>(&value), sizeof(value)); };
+        out.write("SNTLCKPT", 8);
+        put(SessionCheckpoint::kFormatVersion);
+        put(uint32_t{0});
+        put(nowMs());
+        put(kind);
+        put(static_cast<uint64_t>(payload.size()));
+        out.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+    };
+    auto bytes = [](const auto& value) { return std::string(reinterpret_cast<const char*>(&value), sizeof(value)); };
+
+    // Slice spanning 2^30 ticks: rejected before its dense metrics are allocated
+    const std::string slice = bytes(int64_t{100}) + bytes(uint8_t{0}) + bytes(int64_t{0}) + bytes(int64_t{100}) +
+                              bytes(int64_t{100}) + bytes(Tick{0}) + bytes(Tick{1 << 30}) + bytes(1.0) +
+                              bytes(uint32_t{1}) + bytes(uint32_t{0});
+    writeFile(3, slice);
+    LiquidityTimeSeriesEngine engine;
+    DataCache cache;
+    EXPECT_FALSE(SessionCheckpoint::restore(path, cache, &engine, options).ok);
+
+    // Book whose bid + ask counts wrap a 32-bit sum
+    const std::string symbol = "BTC-USD";
+    const std::string book = bytes(static_cast<uint32_t>(symbol.size())) + symbol + bytes(99000.0) + bytes(101000.0) +
+                             bytes(0.5) + bytes(nowMs()) + bytes(uint32_t{0xFFFFFFFF}) + bytes(uint32_t{1});
+    writeFile(1, book);
+    options.restoreBooks = true;
+    EXPECT_FALSE(SessionCheckpoint::restore(path, cache, &engine, options).ok);
+    EXPECT_TRUE(cache.getDirectLiveOrderBook("BTC-USD").isEmpty());
+
+    // Books whose grid is corrupt or whose levels fall off it: the record is dropped, the file still loads
+    auto bookRecord = [&](double minPrice, double maxPrice, double tickSize, uint32_t idx) {
+        return bytes(static_cast<uint32_t>(symbol.size())) + symbol + bytes(minPrice) + bytes(maxPrice) +
+               bytes(tickSize) + bytes(nowMs()) + bytes(uint32_t{1}) + bytes(uint32_t{0}) + bytes(idx) + bytes(2.0);
+    };
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    for (const std::string& corrupt : {bookRecord(99000.0, 101000.0, nan, 0), bookRecord(nan, 101000.0, 0.5, 0),
+                                       bookRecord(101000.0, 99000.0, 0.5, 0), bookRecord(0.0, 1e12, 1e-8, 0),
+                                       bookRecord(99000.0, 101000.0, 0.5, 4001)}) {
+        writeFile(1, corrupt);
+        const auto result = SessionCheckpoint::restore(path, cache, &engine, options);
+        EXPECT_TRUE(result.ok);
+        EXPECT_EQ(result.books, 0u);
+        EXPECT_TRUE(cache.getDirectLiveOrderBook("BTC-USD").isEmpty());
+    }
+    writeFile(1, bookRecord(99000.0, 101000.0, 0.5, 4000));
+    EXPECT_EQ(SessionCheckpoint::restore(path, cache, &engine, options).books, 1u);
+}
+
+TEST_F(SessionCheckpointTest, CapturedSnapshotWritesOnAnotherThread) {
+    DataCache cache;
+    LiquidityTimeSeriesEngine engine;
+    const int64_t start = (nowMs() / 1000) * 1000 - 5000;
+    auto addSnapshot = [&](int64_t ts_ms, double qty) {
+        const std::vector<std::pair<uint32_t, double>> bids{{100, qty}};
+        LiveOrderBook::DenseBookSnapshotView view;
+        view.minPrice = 99900.0;
+        view.tickSize = 1.0;
+        view.timestamp = Clock::time_point(std::chrono::milliseconds(ts_ms));
+        view.bidLevels = bids;
+        engine.addDenseSnapshot(view);
+    };
+    for (int i = 0; i < 10; ++i) addSnapshot(start + i * 100, 1.0);
+
+    const auto snapshot = SessionCheckpoint::capture(cache, &engine, options);
+    ASSERT_FALSE(snapshot.slices.empty());
+    // The engine moves on (new data, a late pull into a captured slice) while the worker encodes
+    std::thread writer([&]() { EXPECT_TRUE(SessionCheckpoint::write(path, snapshot).ok); });
+    for (int i = 10; i < 20; ++i) addSnapshot(start + i * 100, 5.0);
+    engine.addPulledLiquidity(start + 50, 100000.0, true, 3.0);
+    writer.join();
+
+    LiquidityTimeSeriesEngine restored;
+    const auto result = SessionCheckpoint::restore(path, cache, &restored, options);
+    ASSERT_TRUE(result.ok);
+    EXPECT_EQ(result.slices, snapshot.slices.size());
+    const LiquidityTimeSlice* slice = restored.getTimeSlice(100, start);
+    ASSERT_NE(slice, nullptr);
+    EXPECT_NEAR(slice->getDisplayValue(100000.0, true, 0), 1.0, 1e-6);
+    EXPECT_EQ(restored.getTimeSlice(100, start + 1500), nullptr);  // Captured before it existed
+}
@@ -315,3 +315,24 @@ TEST(SubscriptionManager, DesiredSetAccessor) {
     ASSERT_EQ(desired.size(), 3);
     EXPECT_EQ(desired, products);
 }
+
+TEST(SubscriptionManager, L2ResyncTargetsSingleProduct) {
+    SubscriptionManager mgr;
+    mgr.setDesiredProducts({"BTC-USD", "ETH-USD"});
+
+    auto frames = mgr.buildL2ResyncMsgs("ETH-USD", "jwt");
+    ASSERT_EQ(frames.size(), 2);
+
+    // Unsubscribe first so the fresh subscription delivers a new snapshot
+    auto unsub = nlohmann::json::parse(frames[0]);
+    auto sub = nlohmann::json::parse(frames[1]);
+    EXPECT_EQ(unsub["type"], "unsubscribe");
+    EXPECT_EQ(sub["type"], "subscribe");
+    for (const auto& json : {unsub, sub}) {
+        EXPECT_EQ(json["channel"], "level2");
+        ASSERT_EQ(json["product_ids"].size(), 1);
+        EXPECT_EQ(json["product_ids"][0], "ETH-USD");
+    }
+
+    EXPECT_TRUE(mgr.buildL2ResyncMsgs("", "jwt").empty());
+}
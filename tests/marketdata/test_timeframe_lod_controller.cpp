@@ -0,0 +1,105 @@
+/*
+Sentinel — TimeframeLodController Tests
+Role: Verify timeframe selection with hysteresis bands, manual overrides and prefetch neighbours
+Testing Strategy: Drive update() with spans around band edges over a fixed ladder; check the picked timeframe
+Coverage: Initial pick, no thrash inside the band, switching past either edge, manual hold/release, ladder changes
+*/
+#include <gtest/gtest.h>
+#include "TimeframeLodController.h"
+
+namespace {
+    // Target 10 columns: stay while columns <= 12.5, step finer once the finer one fits in 7.5
+    TimeframeLodController makeController() {
+        return TimeframeLodController{TimeframeLodController::Config{10, 0.25}};
+    }
+
+    const std::vector<int64_t> kLadder = {100, 250, 500, 1000};
+}
+
+TEST(TimeframeLodControllerTest, EmptyLadderPicksNothing) {
+    auto lod = makeController();
+    EXPECT_EQ(lod.update(1000, {}), 0);
+    EXPECT_EQ(lod.coarser(), 0);
+    EXPECT_EQ(lod.finer(), 0);
+}
+
+TEST(TimeframeLodControllerTest, InitialPickIsFinestThatFits) {
+    auto lod = makeController();
+    EXPECT_EQ(lod.update(1000, kLadder), 100);
+    EXPECT_EQ(lod.finer(), 0);
+    EXPECT_EQ(lod.coarser(), 250);
+
+    auto wide = makeController();
+    EXPECT_EQ(wide.update(4000, kLadder), 500);
+    EXPECT_EQ(wide.finer(), 250);
+    EXPECT_EQ(wide.coarser(), 1000);
+}
+
+TEST(TimeframeLodControllerTest, HoldsInsideBandAndSwitchesPastIt) {
+    auto lod = makeController();
+    ASSERT_EQ(lod.update(1000, kLadder), 100);
+
+    // 12 columns: over target but inside the band
+    EXPECT_EQ(lod.update(1200, kLadder), 100);
+    // 13 columns: past the upper edge
+    EXPECT_EQ(lod.update(1300, kLadder), 250);
+
+    // Back to the original span: 100ms would give 10 columns, not enough margin to step finer
+    EXPECT_EQ(lod.update(1000, kLadder), 250);
+    EXPECT_EQ(lod.update(800, kLadder), 250);
+    // 7 columns at 100ms: finer one fits with margin
+    EXPECT_EQ(lod.update(700, kLadder), 100);
+}
+
+TEST(TimeframeLodControllerTest, OscillatingAroundBoundaryDoesNotThrash) {
+    auto lod = makeController();
+    ASSERT_EQ(lod.update(1000, kLadder), 100);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(lod.update(i % 2 ? 950 : 1050, kLadder), 100);
+    }
+    ASSERT_EQ(lod.update(2500, kLadder), 250);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(lod.update(i % 2 ? 2450 : 2550, kLadder), 250);
+    }
+}
+
+TEST(TimeframeLodControllerTest, LargeZoomJumpsSeveralLevels) {
+    auto lod = makeController();
+    ASSERT_EQ(lod.update(1000, kLadder), 100);
+    EXPECT_EQ(lod.update(9000, kLadder), 1000);
+    EXPECT_EQ(lod.update(500, kLadder), 100);
+}
+
+TEST(TimeframeLodControllerTest, ManualHoldsUntilTooManyColumns) {
+    auto lod = makeController();
+    ASSERT_EQ(lod.update(1000, kLadder), 100);
+
+    lod.setManual(500);
+    EXPECT_TRUE(lod.isManual());
+    // Auto would pick 100ms here; the manual pick stands
+    EXPECT_EQ(lod.update(1000, kLadder), 500);
+    EXPECT_EQ(lod.update(6000, kLadder), 500);
+
+    // 14 columns at 500ms: the override gives way to auto selection
+    EXPECT_EQ(lod.update(7000, kLadder), 1000);
+    EXPECT_FALSE(lod.isManual());
+}
+
+TEST(TimeframeLodControllerTest, ManualTimeframeWithoutDataIsKept) {
+    auto lod = makeController();
+    lod.setManual(50);
+    EXPECT_EQ(lod.update(400, kLadder), 50);
+    EXPECT_EQ(lod.finer(), 0);
+    EXPECT_EQ(lod.coarser(), 100);
+
+    lod.clearManual();
+    EXPECT_EQ(lod.update(400, kLadder), 100);
+}
+
+TEST(TimeframeLodControllerTest, RepicksWhenCurrentLeavesLadder) {
+    auto lod = makeController();
+    ASSERT_EQ(lod.update(2500, kLadder), 250);
+    EXPECT_EQ(lod.update(2500, {100, 500, 1000}), 500);
+    EXPECT_EQ(lod.finer(), 100);
+    EXPECT_EQ(lod.coarser(), 1000);
+}
@@ -0,0 +1,200 @@
+/*
+Sentinel — TradeHistoryStore Tests
+Role: Verify columnar trade history ingestion, range queries, retention-based chunk eviction and snapshot publishing
+Testing Strategy: Feed synthetic trades with controlled timestamps; query ranges and inspect counts/bytes
+Coverage: Time/price/size filtering, chunk-boundary ranges, largest-N selection, late trades, age/byte eviction,
+          epoch-tagged block snapshots read concurrently with a writer
+*/
+#include <gtest/gtest.h>
+#include "TradeHistoryStore.h"
+#include <thread>
+
+namespace {
+    Trade makeTrade(int64_t ts_ms, double price, double size, AggressorSide side = AggressorSide::Buy,
+                    const std::string& symbol = "BTC-USD") {
+        Trade t;
+        t.timestamp = std::chrono::system_clock::time_point(std::chrono::milliseconds(ts_ms));
+        t.product_id = symbol;
+        t.trade_id = std::to_string(ts_ms);
+        t.side = side;
+        t.price = price;
+        t.size = size;
+        return t;
+    }
+
+    constexpr int64_t kT0 = 1700000000000;
+}
+
+// =============================================================================
+// Range Queries
+// =============================================================================
+
+TEST(TradeHistoryStoreTest, CopiesTimeAndPriceRange) {
+    TradeHistoryStore store;
+    for (int i = 0; i < 100; ++i) {
+        store.onTrade(makeTrade(kT0 + i * 10, 100000.0 + i, 0.5, i % 2 ? AggressorSide::Sell : AggressorSide::Buy));
+    }
+
+    std::vector<TradePrint> out;
+    EXPECT_EQ(store.copyRange("BTC-USD", kT0 + 100, kT0 + 190, 0.0, 1e9, 0.0, 1000, out), 10u);
+    ASSERT_EQ(out.size(), 10u);
+    EXPECT_EQ(out.front().time_ms, kT0 + 100);
+    EXPECT_EQ(out.back().time_ms, kT0 + 190);
+    EXPECT_EQ(out.front().side, AggressorSide::Buy);
+    EXPECT_EQ(out[1].side, AggressorSide::Sell);
+
+    store.copyRange("BTC-USD", kT0, kT0 + 1000, 100010.0, 100019.0, 0.0, 1000, out);
+    EXPECT_EQ(out.size(), 10u);
+
+    store.copyRange("ETH-USD", kT0, kT0 + 1000, 0.0, 1e9, 0.0, 1000, out);
+    EXPECT_TRUE(out.empty());
+}
+
+TEST(TradeHistoryStoreTest, RangesSpanChunkBoundaries) {
+    TradeHistoryStore store;
+    const size_t total = TradeHistoryStore::kChunkTrades * 3 + 17;
+    for (size_t i = 0; i < total; ++i) {
+        store.onTrade(makeTrade(kT0 + static_cast<int64_t>(i), 100000.0, 1.0));
+    }
+    EXPECT_EQ(store.tradeCount("BTC-USD"), total);
+
+    const int64_t start = kT0 + static_cast<int64_t>(TradeHistoryStore::kChunkTrades) - 5;
+    const int64_t end = kT0 + static_cast<int64_t>(TradeHistoryStore::kChunkTrades) * 2 + 5;
+    std::vector<TradePrint> out;
+    EXPECT_EQ(store.copyRange("BTC-USD", start, end, 0.0, 1e9, 0.0, 100000, out),
+              static_cast<size_t>(end - start + 1));
+    EXPECT_EQ(out.front().time_ms, start);
+    EXPECT_EQ(out.back().time_ms, end);
+}
+
+TEST(TradeHistoryStoreTest, KeepsLargestPrintsInTimeOrder) {
+    TradeHistoryStore store;
+    for (int i = 0; i < 50; ++i) {
+        store.onTrade(makeTrade(kT0 + i, 100000.0, i == 7 || i == 30 || i == 42 ? 10.0 + i : 0.1));
+    }
+    std::vector<TradePrint> out;
+    EXPECT_EQ(store.copyRange("BTC-USD", kT0, kT0 + 100, 0.0, 1e9, 0.0, 3, out), 50u);
+    ASSERT_EQ(out.size(), 3u);
+    EXPECT_EQ(out[0].time_ms, kT0 + 7);
+    EXPECT_EQ(out[1].time_ms, kT0 + 30);
+    EXPECT_EQ(out[2].time_ms, kT0 + 42);
+
+    store.copyRange("BTC-USD", kT0, kT0 + 100, 0.0, 1e9, 1.0, 100, out);  // Size filter
+    EXPECT_EQ(out.size(), 3u);
+}
+
+TEST(TradeHistoryStoreTest, LateTradesKeepColumnsSorted) {
+    TradeHistoryStore store;
+    store.onTrade(makeTrade(kT0 + 100, 100000.0, 1.0));
+    store.onTrade(makeTrade(kT0 + 50, 100001.0, 1.0));  // Arrives late
+    store.onTrade(makeTrade(kT0 + 200, 100002.0, 1.0));
+
+    std::vector<TradePrint> out;
+    store.copyRange("BTC-USD", kT0 + 100, kT0 + 100, 0.0, 1e9, 0.0, 10, out);
+    EXPECT_EQ(out.size(), 2u);  // The late print is stamped with the newest stored time
+}
+
+// =============================================================================
+// Retention
+// =============================================================================
+
+TEST(TradeHistoryStoreTest, EvictsWholeChunksByAge) {
+    TradeHistoryStore::Retention retention;
+    retention.maxAge_ms = 10000;
+    TradeHistoryStore store{retention};
+
+    // One chunk per second of trades
+    const int64_t perChunk = static_cast<int64_t>(TradeHistoryStore::kChunkTrades);
+    for (int64_t i = 0; i < perChunk * 20; ++i) {
+        store.onTrade(makeTrade(kT0 + (i / perChunk) * 1000 + (i % perChunk) / 8, 100000.0, 1.0));
+    }
+    const int64_t newest = kT0 + 19 * 1000 + (perChunk - 1) / 8;
+    EXPECT_GE(store.oldestTime("BTC-USD"), newest - retention.maxAge_ms - 1000);  // Chunk granularity
+    EXPECT_EQ(store.tradeCount("BTC-USD") % TradeHistoryStore::kChunkTrades, 0u);
+    EXPECT_LT(store.tradeCount("BTC-USD"), static_cast<size_t>(perChunk * 20));
+}
+
+TEST(TradeHistoryStoreTest, EvictsWholeChunksByBytes) {
+    TradeHistoryStore::Retention retention;
+    retention.maxBytesPerSymbol = TradeHistoryStore::kChunkBytes * 2;
+    TradeHistoryStore store{retention};
+
+    const size_t total = TradeHistoryStore::kChunkTrades * 5 + 1;
+    for (size_t i = 0; i < total; ++i) {
+        store.onTrade(makeTrade(kT0 + static_cast<int64_t>(i), 100000.0, 1.0));
+    }
+    EXPECT_LE(store.bytesUsed("BTC-USD"), retention.maxBytesPerSymbol);
+    EXPECT_EQ(store.tradeCount("BTC-USD"), TradeHistoryStore::kChunkTrades + 1);
+    EXPECT_EQ(store.oldestTime("BTC-USD"), kT0 + static_cast<int64_t>(TradeHistoryStore::kChunkTrades) * 4);
+
+    // Tightening retention applies immediately; the chunk being written is always kept
+    const uint64_t version = store.getVersion();
+    retention.maxBytesPerSymbol = 1;
+    store.setRetention(retention);
+    EXPECT_EQ(store.tradeCount("BTC-USD"), 1u);
+    EXPECT_GT(store.getVersion(), version);
+}
+
+// =============================================================================
+// Snapshot Publishing
+// =============================================================================
+
+TEST(TradeHistoryStoreTest, SnapshotsSurviveEvictionAndEpochTracksBlocks) {
+    TradeHistoryStore::Retention retention;
+    retention.maxBytesPerSymbol = TradeHistoryStore::kChunkBytes * 2;
+    TradeHistoryStore store{retention};
+    EXPECT_EQ(store.snapshot("BTC-USD"), nullptr);
+
+    store.onTrade(makeTrade(kT0, 100000.0, 1.0));
+    const auto first = store.snapshot("BTC-USD");
+    ASSERT_NE(first, nullptr);
+    ASSERT_EQ(first->blocks.size(), 1u);
+
+    // Appends inside the tail block become visible through the same snapshot without republishing
+    store.onTrade(makeTrade(kT0 + 1, 100000.0, 1.0));
+    EXPECT_EQ(store.snapshot("BTC-USD"), first);
+    EXPECT_EQ(first->tradeCount(), 2u);
+
+    for (size_t i = 2; i < TradeHistoryStore::kChunkTrades * 4; ++i) {
+        store.onTrade(makeTrade(kT0 + static_cast<int64_t>(i), 100000.0, 1.0));
+    }
+    const auto latest = store.snapshot("BTC-USD");
+    EXPECT_GT(latest->epoch, first->epoch);
+    EXPECT_LE(latest->blocks.size(), 2u);
+
+    // The old snapshot still owns its (now evicted) first block
+    size_t visited = 0;
+    first->forEachInRange(kT0, kT0 + 10, [&](int64_t, double, double, AggressorSide) { ++visited; });
+    EXPECT_EQ(visited, 11u);
+}
+
+TEST(TradeHistoryStoreTest, ReaderSeesConsistentPrefixWhileWriterAppends) {
+    TradeHistoryStore::Retention retention;
+    retention.maxBytesPerSymbol = TradeHistoryStore::kChunkBytes * 4;
+    TradeHistoryStore store{retention};
+    const int64_t total = static_cast<int64_t>(TradeHistoryStore::kChunkTrades) * 12;
+
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (int64_t i = 0; i < total; ++i) {
+            store.onTrade(makeTrade(kT0 + i, 100000.0 + static_cast<double>(i), 1.0));
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    // Prices encode the timestamp, so a torn or reordered slot shows up as a mismatch
+    bool consistent = true;
+    while (!done.load(std::memory_order_acquire)) {
+        const auto blocks = store.snapshot("BTC-USD");
+        if (!blocks) continue;
+        int64_t previous = -1;
+        blocks->forEachInRange(kT0, kT0 + total, [&](int64_t time, double price, double, AggressorSide) {
+            consistent &= time > previous && price == 100000.0 + static_cast<double>(time - kT0);
+            previous = time;
+        });
+    }
+    writer.join();
+
+    EXPECT_TRUE(consistent);
+    EXPECT_EQ(store.tradeCount("BTC-USD"), TradeHistoryStore::kChunkTrades * 4);
+}